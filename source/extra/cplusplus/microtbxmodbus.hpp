@@ -35,6 +35,7 @@
 ****************************************************************************************/
 #include "microtbxmodbus.h"                      /* MicroTBX-Modbus library            */
 #include "tbxmbserver.hpp"                       /* MicroTBX-Modbus C++ server         */
+#include "tbxmbservert.hpp"                      /* MicroTBX-Modbus C++ CRTP server    */
 #include "tbxmbclient.hpp"                       /* MicroTBX-Modbus C++ client         */
 #include "tbxmbevent.hpp"                        /* MicroTBX-Modbus C++ event handling */
 #include "tbxmbport.hpp"                         /* MicroTBX-Modbus C++ hardware port  */
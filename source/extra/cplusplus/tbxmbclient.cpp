@@ -239,6 +239,222 @@ uint8_t TbxMbClient::writeHoldingRegs(uint8_t         node,
 } /*** end of writeHoldingRegs ***/
 
 
+/************************************************************************************//**
+** \brief     Writes holding registers to and reads holding registers from the server
+**            with the specified node address, with a single request. The server
+**            performs the write operation before the read operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     readAddr Starting element address (0..65535) in the Modbus data table for
+**            the holding register read operation.
+** \param     readNum Number of elements to read from the holding registers data table.
+**            Range can be 1..125
+** \param     readRegs Array where the read holding register values will be written to.
+** \param     writeAddr Starting element address (0..65535) in the Modbus data table for
+**            the holding register write operation.
+** \param     writeNum Number of elements to write to the holding registers data table.
+**            Range can be 1..121
+** \param     writeRegs Array with the desired holding register values.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClient::readWriteHoldingRegs(uint8_t         node,
+                                          uint16_t        readAddr,
+                                          uint8_t         readNum,
+                                          uint16_t        readRegs[],
+                                          uint16_t        writeAddr,
+                                          uint8_t         writeNum,
+                                          uint16_t const  writeRegs[])
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Only continue with a valid client object. */
+  if (m_Channel != nullptr)
+  {
+    result = TbxMbClientReadWriteHoldingRegs(m_Channel, node, readAddr, readNum,
+                                             readRegs, writeAddr, writeNum, writeRegs);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of readWriteHoldingRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Modifies the contents of a holding register on the server with the specified
+**            node address, using a combination of an AND mask and an OR mask. The new
+**            register value is (current value AND andMask) OR (orMask AND (NOT andMask)).
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     addr Element address (0..65535) in the Modbus data table of the holding
+**            register to modify.
+** \param     andMask Bits to keep.
+** \param     orMask New values for the bits that are not kept.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClient::maskWriteHoldingReg(uint8_t  node,
+                                         uint16_t addr,
+                                         uint16_t andMask,
+                                         uint16_t orMask)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Only continue with a valid client object. */
+  if (m_Channel != nullptr)
+  {
+    result = TbxMbClientMaskWriteHoldingReg(m_Channel, node, addr, andMask, orMask);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of maskWriteHoldingReg ***/
+
+
+/************************************************************************************//**
+** \brief     Reads consecutive records from a file on the server with the specified node
+**            address.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     file File number (1..65535) of the file to read from.
+** \param     record Number (0..9999) of the first record to read.
+** \param     num Number of records to read. Range can be 1..124.
+** \param     values Array where the read record values will be written to.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClient::readFileRecord(uint8_t  node,
+                                    uint16_t file,
+                                    uint16_t record,
+                                    uint8_t  num,
+                                    uint16_t values[])
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Only continue with a valid client object. */
+  if (m_Channel != nullptr)
+  {
+    result = TbxMbClientReadFileRecord(m_Channel, node, file, record, num, values);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of readFileRecord ***/
+
+
+/************************************************************************************//**
+** \brief     Writes consecutive records to a file on the server with the specified node
+**            address.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     file File number (1..65535) of the file to write to.
+** \param     record Number (0..9999) of the first record to write.
+** \param     num Number of records to write. Range can be 1..122.
+** \param     values Array with the desired record values.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClient::writeFileRecord(uint8_t        node,
+                                     uint16_t       file,
+                                     uint16_t       record,
+                                     uint8_t        num,
+                                     uint16_t const values[])
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Only continue with a valid client object. */
+  if (m_Channel != nullptr)
+  {
+    result = TbxMbClientWriteFileRecord(m_Channel, node, file, record, num, values);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of writeFileRecord ***/
+
+
+/************************************************************************************//**
+** \brief     Reads the device identification objects from the server with the specified
+**            node address. The object() method of the "deviceId" object is called for
+**            each object that was read.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     code Read device id code (TBX_MB_DEVID_CODE_xxx).
+** \param     objectId Identifier of the object to start reading at, for stream access.
+**            Identifier of the object to read, for individual access.
+** \param     deviceId Reference to the object that receives the objects.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClient::readDeviceId(uint8_t              node,
+                                  uint8_t              code,
+                                  uint8_t              objectId,
+                                  TbxMbClientDeviceId& deviceId)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Only continue with a valid client object. */
+  if (m_Channel != nullptr)
+  {
+    result = TbxMbClientReadDeviceId(m_Channel, node, code, objectId,
+                                     callbackDeviceIdObject, &deviceId);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of readDeviceId ***/
+
+
+/************************************************************************************//**
+** \brief     Writes a batch of coils and holding registers, to one or more servers,
+**            with back-to-back requests. A write operation with node address 0 is
+**            broadcast. The turnaround delay after a broadcast write passes while the
+**            request of the next write operation is prepared. Each write operation's
+**            result element is updated with the outcome of just that write.
+** \param     writes Array with the write operations.
+** \param     count Number of write operations in the array.
+** \return    TBX_OK if all write operations were successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClient::writeBatch(tTbxMbClientBatchWrite writes[],
+                                uint8_t                count)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Only continue with a valid client object. */
+  if (m_Channel != nullptr)
+  {
+    result = TbxMbClientWriteBatch(m_Channel, writes, count);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of writeBatch ***/
+
+
+/************************************************************************************//**
+** \brief     Obtains the response time statistics of the server with the specified
+**            node address. The client tracks these, if the configuration macro
+**            TBX_MB_CLIENT_NODE_STATS_SIZE is set to a value > 0.
+** \param     node The address of the server.
+** \param     stats Reference to where the statistics are written to.
+** \return    TBX_OK if successful, TBX_ERROR if the node's statistics are not tracked.
+**
+****************************************************************************************/
+uint8_t TbxMbClient::getNodeStats(uint8_t                node,
+                                  tTbxMbClientNodeStats& stats)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Only continue with a valid client object. */
+  if (m_Channel != nullptr)
+  {
+    result = TbxMbClientGetNodeStats(m_Channel, node, &stats);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of getNodeStats ***/
+
+
 /************************************************************************************//**
 ** \brief     Perform diagnostic operation on the server for checking the communication
 **            system.
@@ -327,6 +543,625 @@ uint8_t TbxMbClient::customFunction(uint8_t       node,
 } /*** end of customFunction ***/
 
 
+/************************************************************************************//**
+** \brief     Send a custom function code PDU to the server and receive its response PDU,
+**            without intermediate buffers. The build() method of the "pdu" object builds
+**            the request PDU directly in the transport layer's request packet. Its
+**            parse() method parses the response PDU directly from the transport layer's
+**            response packet. Well suited for large vendor specific function codes.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     pdu Reference to the object that builds and parses the PDUs.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClient::customFunction(uint8_t         node,
+                                    TbxMbClientPdu& pdu)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Only continue with a valid client object. */
+  if (m_Channel != nullptr)
+  {
+    result = TbxMbClientCustomFunctionInPlace(m_Channel, node, callbackPduBuild,
+                                              callbackPduParse, &pdu);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of customFunction ***/
+
+
+#if (TBX_MB_CLIENT_AWAIT_SUPPORT > 0)
+/************************************************************************************//**
+** \brief     Awaitable version of readCoils(). Use it with co_await in a coroutine.
+** \param     node The address of the server.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            coil read operation.
+** \param     num Number of elements to read from the coils data table. Range can be
+**            1..2000
+** \param     coils Byte array with TBX_ON / TBX_OFF values where the coil state will be
+**            written to.
+** \return    Awaitable request that evaluates to TBX_OK if successful, TBX_ERROR
+**            otherwise.
+**
+****************************************************************************************/
+TbxMbClientAwait TbxMbClient::readCoilsAsync(uint8_t  node, 
+                                             uint16_t addr, 
+                                             uint16_t num, 
+                                             uint8_t  coils[])
+{
+  TbxMbClientAwait result(m_Channel, TBX_MB_FC01_READ_COILS, node);
+
+  /* Store the request parameters. */
+  result.m_Addr = addr;
+  result.m_Num = num;
+  result.m_Data = coils;
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of readCoilsAsync ***/
+
+
+/************************************************************************************//**
+** \brief     Awaitable version of readInputs(). Use it with co_await in a coroutine.
+** \param     node The address of the server.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            discrete input read operation.
+** \param     num Number of elements to read from the discrete inputs data table. Range
+**            can be 1..2000
+** \param     inputs Byte array with TBX_ON / TBX_OFF values where the discrete input
+**            state will be written to.
+** \return    Awaitable request that evaluates to TBX_OK if successful, TBX_ERROR
+**            otherwise.
+**
+****************************************************************************************/
+TbxMbClientAwait TbxMbClient::readInputsAsync(uint8_t  node, 
+                                              uint16_t addr, 
+                                              uint16_t num, 
+                                              uint8_t  inputs[])
+{
+  TbxMbClientAwait result(m_Channel, TBX_MB_FC02_READ_DISCRETE_INPUTS, node);
+
+  /* Store the request parameters. */
+  result.m_Addr = addr;
+  result.m_Num = num;
+  result.m_Data = inputs;
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of readInputsAsync ***/
+
+
+/************************************************************************************//**
+** \brief     Awaitable version of readInputRegs(). Use it with co_await in a coroutine.
+** \param     node The address of the server.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            input register read operation.
+** \param     num Number of elements to read from the input registers data table. Range
+**            can be 1..125
+** \param     inputRegs Array where the input register values will be written to.
+** \return    Awaitable request that evaluates to TBX_OK if successful, TBX_ERROR
+**            otherwise.
+**
+****************************************************************************************/
+TbxMbClientAwait TbxMbClient::readInputRegsAsync(uint8_t  node, 
+                                                 uint16_t addr, 
+                                                 uint8_t  num, 
+                                                 uint16_t inputRegs[])
+{
+  TbxMbClientAwait result(m_Channel, TBX_MB_FC04_READ_INPUT_REGISTERS, node);
+
+  /* Store the request parameters. */
+  result.m_Addr = addr;
+  result.m_Num = num;
+  result.m_Data = inputRegs;
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of readInputRegsAsync ***/
+
+
+/************************************************************************************//**
+** \brief     Awaitable version of readHoldingRegs(). Use it with co_await in a
+**            coroutine.
+** \param     node The address of the server.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            holding register read operation.
+** \param     num Number of elements to read from the holding registers data table.
+**            Range can be 1..125
+** \param     holdingRegs Array where the holding register values will be written to.
+** \return    Awaitable request that evaluates to TBX_OK if successful, TBX_ERROR
+**            otherwise.
+**
+****************************************************************************************/
+TbxMbClientAwait TbxMbClient::readHoldingRegsAsync(uint8_t  node, 
+                                                   uint16_t addr, 
+                                                   uint8_t  num, 
+                                                   uint16_t holdingRegs[])
+{
+  TbxMbClientAwait result(m_Channel, TBX_MB_FC03_READ_HOLDING_REGISTERS, node);
+
+  /* Store the request parameters. */
+  result.m_Addr = addr;
+  result.m_Num = num;
+  result.m_Data = holdingRegs;
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of readHoldingRegsAsync ***/
+
+
+/************************************************************************************//**
+** \brief     Awaitable version of writeCoils(). Use it with co_await in a coroutine.
+** \param     node The address of the server.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            coil write operation.
+** \param     num Number of elements to write to the coils data table. Range can be
+**            1..1968
+** \param     coils Byte array with the desired TBX_ON / TBX_OFF coil values.
+** \return    Awaitable request that evaluates to TBX_OK if successful, TBX_ERROR
+**            otherwise.
+**
+****************************************************************************************/
+TbxMbClientAwait TbxMbClient::writeCoilsAsync(uint8_t       node, 
+                                              uint16_t      addr, 
+                                              uint16_t      num, 
+                                              uint8_t const coils[])
+{
+  TbxMbClientAwait result(m_Channel, TBX_MB_FC15_WRITE_MULTIPLE_COILS, node);
+
+  /* Store the request parameters. */
+  result.m_Addr = addr;
+  result.m_Num = num;
+  result.m_WriteData = coils;
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of writeCoilsAsync ***/
+
+
+/************************************************************************************//**
+** \brief     Awaitable version of writeHoldingRegs(). Use it with co_await in a
+**            coroutine.
+** \param     node The address of the server.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            holding register write operation.
+** \param     num Number of elements to write to the holding registers data table.
+**            Range can be 1..123
+** \param     holdingRegs Array with the desired holding register values.
+** \return    Awaitable request that evaluates to TBX_OK if successful, TBX_ERROR
+**            otherwise.
+**
+****************************************************************************************/
+TbxMbClientAwait TbxMbClient::writeHoldingRegsAsync(uint8_t        node, 
+                                                    uint16_t       addr, 
+                                                    uint8_t        num, 
+                                                    uint16_t const holdingRegs[])
+{
+  TbxMbClientAwait result(m_Channel, TBX_MB_FC16_WRITE_MULTIPLE_REGISTERS, node);
+
+  /* Store the request parameters. */
+  result.m_Addr = addr;
+  result.m_Num = num;
+  result.m_WriteData = holdingRegs;
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of writeHoldingRegsAsync ***/
+
+
+/************************************************************************************//**
+** \brief     Awaitable version of readWriteHoldingRegs(). Use it with co_await in a
+**            coroutine.
+** \param     node The address of the server.
+** \param     readAddr Starting element address (0..65535) in the Modbus data table for
+**            the holding register read operation.
+** \param     readNum Number of elements to read from the holding registers data table.
+**            Range can be 1..125
+** \param     readRegs Array where the read holding register values will be written to.
+** \param     writeAddr Starting element address (0..65535) in the Modbus data table for
+**            the holding register write operation.
+** \param     writeNum Number of elements to write to the holding registers data table.
+**            Range can be 1..121
+** \param     writeRegs Array with the desired holding register values.
+** \return    Awaitable request that evaluates to TBX_OK if successful, TBX_ERROR
+**            otherwise.
+**
+****************************************************************************************/
+TbxMbClientAwait TbxMbClient::readWriteHoldingRegsAsync(uint8_t        node,
+                                                        uint16_t       readAddr,
+                                                        uint8_t        readNum,
+                                                        uint16_t       readRegs[],
+                                                        uint16_t       writeAddr,
+                                                        uint8_t        writeNum,
+                                                        uint16_t const writeRegs[])
+{
+  TbxMbClientAwait result(m_Channel, TBX_MB_FC23_READ_WRITE_MULTIPLE_REGISTERS, node);
+
+  /* Store the request parameters. */
+  result.m_Addr = readAddr;
+  result.m_Num = readNum;
+  result.m_Data = readRegs;
+  result.m_WriteAddr = writeAddr;
+  result.m_WriteNum = writeNum;
+  result.m_WriteData = writeRegs;
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of readWriteHoldingRegsAsync ***/
+
+
+/************************************************************************************//**
+** \brief     Awaitable version of maskWriteHoldingReg(). Use it with co_await in a
+**            coroutine.
+** \param     node The address of the server.
+** \param     addr Element address (0..65535) in the Modbus data table of the holding
+**            register to modify.
+** \param     andMask Bits to keep.
+** \param     orMask New values for the bits that are not kept.
+** \return    Awaitable request that evaluates to TBX_OK if successful, TBX_ERROR
+**            otherwise.
+**
+****************************************************************************************/
+TbxMbClientAwait TbxMbClient::maskWriteHoldingRegAsync(uint8_t  node,
+                                                       uint16_t addr,
+                                                       uint16_t andMask,
+                                                       uint16_t orMask)
+{
+  TbxMbClientAwait result(m_Channel, TBX_MB_FC22_MASK_WRITE_REGISTER, node);
+
+  /* Store the request parameters. */
+  result.m_Addr = addr;
+  result.m_AndMask = andMask;
+  result.m_OrMask = orMask;
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of maskWriteHoldingRegAsync ***/
+#endif
+
+
+/************************************************************************************//**
+** \brief     Wrapper to connect this callback to the build() method of the object that
+**            builds and parses the PDUs.
+** \param     channel Handle to the Modbus client channel object that triggered the 
+**            callback.
+** \param     pdu Pointer to the PDU of the transport layer's request packet.
+** \param     len Pointer to where the PDU length, including the function code, is
+**            written to.
+** \param     param Pointer to the TbxMbClientPdu object.
+** \return    TBX_OK if the request PDU was built, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClient::callbackPduBuild(tTbxMbClient   channel,
+                                      uint8_t      * pdu,
+                                      uint8_t      * len,
+                                      void         * param)
+{
+  uint8_t result = TBX_ERROR;
+
+  TBX_UNUSED_ARG(channel);
+
+  /* Verify parameters. */
+  TBX_ASSERT((pdu != nullptr) && (len != nullptr) && (param != nullptr));
+
+  /* Only continue with valid parameters. */
+  if ((pdu != nullptr) && (len != nullptr) && (param != nullptr))
+  {
+    TbxMbClientPdu * pduPtr = static_cast<TbxMbClientPdu *>(param);
+    if (pduPtr->build(pdu, *len))
+    {
+      result = TBX_OK;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of callbackPduBuild ***/
+
+
+/************************************************************************************//**
+** \brief     Wrapper to connect this callback to the parse() method of the object that
+**            builds and parses the PDUs.
+** \param     channel Handle to the Modbus client channel object that triggered the 
+**            callback.
+** \param     pdu Pointer to the PDU of the transport layer's response packet.
+** \param     len PDU length, including the function code.
+** \param     param Pointer to the TbxMbClientPdu object.
+** \return    TBX_OK if the response PDU is valid, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClient::callbackPduParse(tTbxMbClient         channel,
+                                      uint8_t      const * pdu,
+                                      uint8_t              len,
+                                      void               * param)
+{
+  uint8_t result = TBX_ERROR;
+
+  TBX_UNUSED_ARG(channel);
+
+  /* Verify parameters. */
+  TBX_ASSERT((pdu != nullptr) && (param != nullptr));
+
+  /* Only continue with valid parameters. */
+  if ((pdu != nullptr) && (param != nullptr))
+  {
+    TbxMbClientPdu * pduPtr = static_cast<TbxMbClientPdu *>(param);
+    if (pduPtr->parse(pdu, len))
+    {
+      result = TBX_OK;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of callbackPduParse ***/
+
+
+/************************************************************************************//**
+** \brief     Wrapper to connect this callback to the object() method of the object that
+**            receives the device identification objects.
+** \param     channel Handle to the Modbus client channel object that triggered the 
+**            callback.
+** \param     objectId Object identifier.
+** \param     data Pointer to the object's value in the transport layer's response packet.
+** \param     len Length of the object's value.
+** \param     param Pointer to the TbxMbClientDeviceId object.
+**
+****************************************************************************************/
+void TbxMbClient::callbackDeviceIdObject(tTbxMbClient         channel,
+                                         uint8_t              objectId,
+                                         uint8_t      const * data,
+                                         uint8_t              len,
+                                         void               * param)
+{
+  TBX_UNUSED_ARG(channel);
+
+  /* Verify parameters. */
+  TBX_ASSERT((data != nullptr) && (param != nullptr));
+
+  /* Only continue with valid parameters. */
+  if ((data != nullptr) && (param != nullptr))
+  {
+    TbxMbClientDeviceId * deviceIdPtr = static_cast<TbxMbClientDeviceId *>(param);
+    deviceIdPtr->object(objectId, data, len);
+  }
+} /*** end of callbackDeviceIdObject ***/
+
+
+#if (TBX_MB_CLIENT_AWAIT_SUPPORT > 0)
+/****************************************************************************************
+*                            T B X M B C L I E N T T A S K
+****************************************************************************************/
+/************************************************************************************//**
+** \brief     Allocates the frame of a coroutine from the memory pools of MicroTBX.
+** \param     size Size of the coroutine frame in bytes.
+** \return    Pointer to the allocated memory if successful, nullptr otherwise.
+**
+****************************************************************************************/
+void * TbxMbClientTask::promise_type::operator new(std::size_t size) noexcept
+{
+  /* Allocate memory for the coroutine frame. */
+  void * result = TbxMemPoolAllocate(size);
+  /* Automatically increase the memory pool, if it was too small. */
+  if (result == nullptr)
+  {
+    /* No need to check the return value, because we'll attempt to allocate again
+     * right afterwards. We can do the error handling at that point.
+     */
+    (void)TbxMemPoolCreate(1U, size);
+    result = TbxMemPoolAllocate(size);
+  }
+  /* Make sure the allocation was successful. */
+  TBX_ASSERT(result != nullptr);
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of operator new ***/
+
+
+/************************************************************************************//**
+** \brief     Gives the frame of a finished coroutine back to the memory pools.
+** \param     ptr Pointer to the coroutine frame.
+**
+****************************************************************************************/
+void TbxMbClientTask::promise_type::operator delete(void * ptr) noexcept
+{
+  /* Only continue with a valid pointer. */
+  if (ptr != nullptr)
+  {
+    TbxMemPoolRelease(ptr);
+  }
+} /*** end of operator delete ***/
+
+
+/****************************************************************************************
+*                            T B X M B C L I E N T A W A I T
+****************************************************************************************/
+/************************************************************************************//**
+** \brief     Awaitable Modbus client request constructor.
+** \param     channel Handle to the Modbus client channel for the request.
+** \param     code Function code of the request.
+** \param     node The address of the server.
+**
+****************************************************************************************/
+TbxMbClientAwait::TbxMbClientAwait(tTbxMbClient channel, 
+                                   uint8_t      code, 
+                                   uint8_t      node)
+  : m_Channel(channel), m_Code(code), m_Node(node), m_Addr(0U), m_Num(0U),
+    m_Data(nullptr), m_WriteAddr(0U), m_WriteNum(0U), m_WriteData(nullptr),
+    m_AndMask(0U), m_OrMask(0U), m_Handle(nullptr), m_Result(TBX_ERROR),
+    m_Handshake(false)
+{
+} /*** end of TbxMbClientAwait ***/
+
+
+/************************************************************************************//**
+** \brief     Awaitable Modbus client request copy constructor. Only used when the
+**            methods of TbxMbClient return the awaitable, so before its request is
+**            submitted. The copy therefore starts with a new completion handshake.
+** \param     other The awaitable Modbus client request to copy.
+**
+****************************************************************************************/
+TbxMbClientAwait::TbxMbClientAwait(TbxMbClientAwait const & other)
+  : m_Channel(other.m_Channel), m_Code(other.m_Code), m_Node(other.m_Node),
+    m_Addr(other.m_Addr), m_Num(other.m_Num), m_Data(other.m_Data),
+    m_WriteAddr(other.m_WriteAddr), m_WriteNum(other.m_WriteNum),
+    m_WriteData(other.m_WriteData), m_AndMask(other.m_AndMask),
+    m_OrMask(other.m_OrMask), m_Handle(nullptr), m_Result(TBX_ERROR),
+    m_Handshake(false)
+{
+} /*** end of TbxMbClientAwait ***/
+
+
+/************************************************************************************//**
+** \brief     Submits the request, when the coroutine awaits it.
+** \param     handle Handle of the awaiting coroutine, for resuming it once the request
+**            completed.
+** \return    True to suspend the coroutine. False to continue it right away, because
+**            the request could not be submitted or it already completed.
+**
+****************************************************************************************/
+bool TbxMbClientAwait::await_suspend(std::coroutine_handle<> handle) noexcept
+{
+  bool result = false;
+
+  /* Store the handle of the coroutine for resuming it. */
+  m_Handle = handle;
+  /* Submit the request. The done callback might run right away or from another task,
+   * before this function returns.
+   */
+  if (submit() == TBX_OK)
+  {
+    /* This function and the done callback both attempt to flip the handshake flag.
+     * The one that comes second continues the coroutine. If this function comes first,
+     * the coroutine suspends and the done callback resumes it later on. Otherwise the
+     * request already completed, so the coroutine continues right away, without
+     * suspending. Note that once this function came first, the coroutine might
+     * already be resumed and this object released, so do not access it anymore.
+     */
+    bool expected = false;
+    result = m_Handshake.compare_exchange_strong(expected, true,
+                                                 std::memory_order_acq_rel);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of await_suspend ***/
+
+
+/************************************************************************************//**
+** \brief     Submits the request to the asynchronous Modbus client.
+** \return    TBX_OK if the request was submitted, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientAwait::submit()
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Only continue with a valid client object. */
+  if (m_Channel != nullptr)
+  {
+    /* Submit the request with the asynchronous function that matches its function 
+     * code.
+     */
+    switch (m_Code)
+    {
+      case TBX_MB_FC01_READ_COILS:
+        result = TbxMbClientReadCoilsAsync(m_Channel, m_Node, m_Addr, m_Num,
+                                           static_cast<uint8_t *>(m_Data), 
+                                           callbackDone, this);
+        break;
+
+      case TBX_MB_FC02_READ_DISCRETE_INPUTS:
+        result = TbxMbClientReadInputsAsync(m_Channel, m_Node, m_Addr, m_Num,
+                                            static_cast<uint8_t *>(m_Data), 
+                                            callbackDone, this);
+        break;
+
+      case TBX_MB_FC03_READ_HOLDING_REGISTERS:
+        result = TbxMbClientReadHoldingRegsAsync(m_Channel, m_Node, m_Addr, 
+                                                 static_cast<uint8_t>(m_Num),
+                                                 static_cast<uint16_t *>(m_Data), 
+                                                 callbackDone, this);
+        break;
+
+      case TBX_MB_FC04_READ_INPUT_REGISTERS:
+        result = TbxMbClientReadInputRegsAsync(m_Channel, m_Node, m_Addr, 
+                                               static_cast<uint8_t>(m_Num),
+                                               static_cast<uint16_t *>(m_Data), 
+                                               callbackDone, this);
+        break;
+
+      case TBX_MB_FC15_WRITE_MULTIPLE_COILS:
+        result = TbxMbClientWriteCoilsAsync(m_Channel, m_Node, m_Addr, m_Num,
+                                            static_cast<uint8_t const *>(m_WriteData),
+                                            callbackDone, this);
+        break;
+
+      case TBX_MB_FC16_WRITE_MULTIPLE_REGISTERS:
+        result = TbxMbClientWriteHoldingRegsAsync(m_Channel, m_Node, m_Addr,
+                                          static_cast<uint8_t>(m_Num),
+                                          static_cast<uint16_t const *>(m_WriteData),
+                                          callbackDone, this);
+        break;
+
+      case TBX_MB_FC22_MASK_WRITE_REGISTER:
+        result = TbxMbClientMaskWriteHoldingRegAsync(m_Channel, m_Node, m_Addr,
+                                                     m_AndMask, m_OrMask,
+                                                     callbackDone, this);
+        break;
+
+      case TBX_MB_FC23_READ_WRITE_MULTIPLE_REGISTERS:
+        result = TbxMbClientReadWriteHoldingRegsAsync(m_Channel, m_Node, m_Addr,
+                                          static_cast<uint8_t>(m_Num),
+                                          static_cast<uint16_t *>(m_Data),
+                                          m_WriteAddr, m_WriteNum,
+                                          static_cast<uint16_t const *>(m_WriteData),
+                                          callbackDone, this);
+        break;
+
+      default:
+        /* Unsupported function code. Should not happen. */
+        TBX_ASSERT(TBX_FALSE);
+        break;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of submit ***/
+
+
+/************************************************************************************//**
+** \brief     Request completion callback. It stores the result of the request and
+**            resumes the awaiting coroutine.
+** \param     channel Handle to the Modbus client channel object that triggered the 
+**            callback.
+** \param     result TBX_OK if the request completed successfully, TBX_ERROR otherwise.
+** \param     param Pointer to the TbxMbClientAwait object.
+**
+****************************************************************************************/
+void TbxMbClientAwait::callbackDone(tTbxMbClient   channel,
+                                    uint8_t        result,
+                                    void         * param)
+{
+  TBX_UNUSED_ARG(channel);
+
+  /* Verify parameters. */
+  TBX_ASSERT(param != nullptr);
+
+  /* Only continue with valid parameters. */
+  if (param != nullptr)
+  {
+    TbxMbClientAwait * awaitPtr = static_cast<TbxMbClientAwait *>(param);
+    /* Store the result of the request. */
+    awaitPtr->m_Result = result;
+    /* Attempt to flip the handshake flag. Resume the coroutine if await_suspend()
+     * already flipped it, because the coroutine is suspended in this case. Otherwise
+     * await_suspend() sees that the request completed and does not suspend the
+     * coroutine. Note that the coroutine might finish and release the memory of this
+     * object, so do not access it after resuming.
+     */
+    bool expected = false;
+    if (!awaitPtr->m_Handshake.compare_exchange_strong(expected, true,
+                                                       std::memory_order_acq_rel))
+    {
+      awaitPtr->m_Handle.resume();
+    }
+  }
+} /*** end of callbackDone ***/
+#endif
+
+
 /****************************************************************************************
 *                            T B X M B C L I E N T R T U
 ****************************************************************************************/
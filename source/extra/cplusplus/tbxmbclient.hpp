@@ -30,9 +30,154 @@
 #ifndef TBXMBCLIENT_HPP
 #define TBXMBCLIENT_HPP
 
+/****************************************************************************************
+* Macro definitions
+****************************************************************************************/
+#if (__cplusplus >= 202002L) && defined(__cpp_impl_coroutine)
+/** \brief Set to 1 when the compiler supports C++20 coroutines. The client then offers
+ *         awaitable versions of its read and write methods.
+ */
+#define TBX_MB_CLIENT_AWAIT_SUPPORT              (1)
+#else
+#define TBX_MB_CLIENT_AWAIT_SUPPORT              (0)
+#endif
+
+
+/****************************************************************************************
+* Include files
+****************************************************************************************/
+#if (TBX_MB_CLIENT_AWAIT_SUPPORT > 0)
+#include <atomic>                                /* C++ atomic operations              */
+#include <cstddef>                               /* C++ standard definitions           */
+#include <coroutine>                             /* C++ coroutine support              */
+#endif
+
+
 /****************************************************************************************
 * Class definitions
 ****************************************************************************************/
+/****************************************************************************************
+*                            T B X M B C L I E N T P D U
+****************************************************************************************/
+/** \brief Abstract interface class for building a custom function code request PDU and
+ *         parsing its response PDU in place, directly in the transport layer's packets.
+ */
+class TbxMbClientPdu
+{
+public:
+  /* Constructors and destructor. */
+  virtual ~TbxMbClientPdu() { }
+  /* Methods. */
+  virtual bool build(uint8_t pdu[], uint8_t& len) = 0;
+  virtual bool parse(uint8_t const pdu[], uint8_t len) = 0;
+};
+
+
+/****************************************************************************************
+*                            T B X M B C L I E N T D E V I C E I D
+****************************************************************************************/
+/** \brief Abstract interface class for receiving the device identification objects,
+ *         while reading the device identification.
+ */
+class TbxMbClientDeviceId
+{
+public:
+  /* Constructors and destructor. */
+  virtual ~TbxMbClientDeviceId() { }
+  /* Methods. */
+  virtual void object(uint8_t objectId, uint8_t const data[], uint8_t len) = 0;
+};
+
+
+#if (TBX_MB_CLIENT_AWAIT_SUPPORT > 0)
+/****************************************************************************************
+*                            T B X M B C L I E N T T A S K
+****************************************************************************************/
+/** \brief   Return type for a coroutine that awaits Modbus client requests.
+ *  \details The coroutine starts right away and runs until its first co_await. The
+ *           completion of a request resumes it, from the context of the event task. Its
+ *           frame is released automatically, once the coroutine finishes. The frame is
+ *           allocated from the memory pools of MicroTBX. Note that a coroutine should
+ *           be started from the same task that runs the event task.
+ */
+class TbxMbClientTask
+{
+public:
+  /* Types. */
+  class promise_type
+  {
+  public:
+    /* Methods. */
+    static void * operator new(std::size_t size) noexcept;
+    static void   operator delete(void * ptr) noexcept;
+    static TbxMbClientTask get_return_object_on_allocation_failure() noexcept 
+    { 
+      return TbxMbClientTask(false);
+    }
+    TbxMbClientTask     get_return_object() noexcept { return TbxMbClientTask(true); }
+    std::suspend_never  initial_suspend() noexcept { return {}; }
+    std::suspend_never  final_suspend() noexcept { return {}; }
+    void                return_void() noexcept { }
+    void                unhandled_exception() noexcept { TBX_ASSERT(TBX_FALSE); }
+  };
+  /* Methods. */
+  bool started() const { return m_Started; }
+
+private:
+  /* Constructors and destructor. */
+  explicit TbxMbClientTask(bool started) : m_Started(started) { }
+  /* Members. */
+  bool m_Started;
+};
+
+
+/****************************************************************************************
+*                            T B X M B C L I E N T A W A I T
+****************************************************************************************/
+/** \brief   Awaitable Modbus client request. The methods of TbxMbClient that end with
+ *           "Async" return it. A co_await on it submits the request, suspends the
+ *           coroutine until the request completes and then evaluates to the result of
+ *           the request: TBX_OK if successful, TBX_ERROR otherwise.
+ *  \details Make sure the arrays that were passed to the method stay valid until the
+ *           request completes. Local variables of the coroutine meet this requirement.
+ */
+class TbxMbClientAwait
+{
+public:
+  /* Methods. */
+  bool    await_ready() const noexcept { return false; }
+  bool    await_suspend(std::coroutine_handle<> handle) noexcept;
+  uint8_t await_resume() const noexcept { return m_Result; }
+
+private:
+  /* Constructors and destructor. */
+  TbxMbClientAwait(tTbxMbClient channel, uint8_t code, uint8_t node);
+  TbxMbClientAwait(TbxMbClientAwait const & other);
+  /* Methods. */
+  uint8_t submit();
+  /* Callbacks. */
+  static  void    callbackDone(tTbxMbClient channel, uint8_t result, void * param);
+  /* Members. */
+  tTbxMbClient            m_Channel;
+  uint8_t                 m_Code;
+  uint8_t                 m_Node;
+  uint16_t                m_Addr;
+  uint16_t                m_Num;
+  void                  * m_Data;
+  uint16_t                m_WriteAddr;
+  uint8_t                 m_WriteNum;
+  void            const * m_WriteData;
+  uint16_t                m_AndMask;
+  uint16_t                m_OrMask;
+  std::coroutine_handle<> m_Handle;
+  uint8_t                 m_Result;
+  std::atomic<bool>       m_Handshake;
+  /* Friends. */
+  friend class TbxMbClient;
+};
+#endif
+
+
 /****************************************************************************************
 *                            T B X M B C L I E N T
 ****************************************************************************************/
@@ -52,14 +197,57 @@ public:
   uint8_t writeCoils(uint8_t node, uint16_t addr, uint16_t num, uint8_t const coils[]);
   uint8_t writeHoldingRegs(uint8_t node, uint16_t addr, uint8_t num, 
                            uint16_t const holdingRegs[]);
+  uint8_t readWriteHoldingRegs(uint8_t node, uint16_t readAddr, uint8_t readNum,
+                               uint16_t readRegs[], uint16_t writeAddr,
+                               uint8_t writeNum, uint16_t const writeRegs[]);
+  uint8_t maskWriteHoldingReg(uint8_t node, uint16_t addr, uint16_t andMask,
+                              uint16_t orMask);
+  uint8_t readFileRecord(uint8_t node, uint16_t file, uint16_t record, uint8_t num,
+                         uint16_t values[]);
+  uint8_t writeFileRecord(uint8_t node, uint16_t file, uint16_t record, uint8_t num,
+                          uint16_t const values[]);
+  uint8_t readDeviceId(uint8_t node, uint8_t code, uint8_t objectId,
+                       TbxMbClientDeviceId& deviceId);
+  uint8_t writeBatch(tTbxMbClientBatchWrite writes[], uint8_t count);
+  uint8_t getNodeStats(uint8_t node, tTbxMbClientNodeStats& stats);
   uint8_t diagnostics(uint8_t node, uint16_t subcode, uint16_t& count);
   uint8_t customFunction(uint8_t node, uint8_t const txPdu[], uint8_t rxPdu[],
                          uint8_t& len);
+  uint8_t customFunction(uint8_t node, TbxMbClientPdu& pdu);
+#if (TBX_MB_CLIENT_AWAIT_SUPPORT > 0)
+  TbxMbClientAwait readCoilsAsync(uint8_t node, uint16_t addr, uint16_t num, 
+                                  uint8_t coils[]);
+  TbxMbClientAwait readInputsAsync(uint8_t node, uint16_t addr, uint16_t num, 
+                                   uint8_t inputs[]);
+  TbxMbClientAwait readInputRegsAsync(uint8_t node, uint16_t addr, uint8_t num, 
+                                      uint16_t inputRegs[]);
+  TbxMbClientAwait readHoldingRegsAsync(uint8_t node, uint16_t addr, uint8_t num, 
+                                        uint16_t holdingRegs[]);
+  TbxMbClientAwait writeCoilsAsync(uint8_t node, uint16_t addr, uint16_t num, 
+                                   uint8_t const coils[]);
+  TbxMbClientAwait writeHoldingRegsAsync(uint8_t node, uint16_t addr, uint8_t num, 
+                                         uint16_t const holdingRegs[]);
+  TbxMbClientAwait readWriteHoldingRegsAsync(uint8_t node, uint16_t readAddr, 
+                                             uint8_t readNum, uint16_t readRegs[], 
+                                             uint16_t writeAddr, uint8_t writeNum,
+                                             uint16_t const writeRegs[]);
+  TbxMbClientAwait maskWriteHoldingRegAsync(uint8_t node, uint16_t addr, 
+                                            uint16_t andMask, uint16_t orMask);
+#endif
 
 protected:
   /* Members. */
   tTbxMbClient m_Channel;
 
+private:
+  /* Callbacks. */
+  static  uint8_t callbackPduBuild(tTbxMbClient channel, uint8_t * pdu, uint8_t * len,
+                                   void * param);
+  static  uint8_t callbackPduParse(tTbxMbClient channel, uint8_t const * pdu,
+                                   uint8_t len, void * param);
+  static  void    callbackDeviceIdObject(tTbxMbClient channel, uint8_t objectId,
+                                         uint8_t const * data, uint8_t len,
+                                         void * param);
 };
 
 
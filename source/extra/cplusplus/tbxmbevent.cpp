@@ -64,4 +64,42 @@ void TbxMbEvent::task()
   TbxMbEventTask();
 } /*** end of task ***/
 
+
+/************************************************************************************//**
+** \brief     Task method that drives the Modbus objects, which are assigned to the
+**            specified event task. Only needed when configuring more than one event
+**            task with TBX_MB_EVENT_TASK_NUM. Call this method from a separate RTOS
+**            task for each event task.
+** \param     taskIdx Zero based index of the event task.
+**
+****************************************************************************************/
+void TbxMbEvent::task(uint8_t taskIdx)
+{
+  TbxMbEventTaskIndexed(taskIdx);
+} /*** end of task ***/
+
+
+/************************************************************************************//**
+** \brief     Selects the event task that transport layer objects, which are created
+**            afterwards, are assigned to.
+** \param     taskIdx Zero based index of the event task.
+**
+****************************************************************************************/
+void TbxMbEvent::select(uint8_t taskIdx)
+{
+  TbxMbEventTaskSelect(taskIdx);
+} /*** end of select ***/
+
+
+/************************************************************************************//**
+** \brief     Pins an event task to a processor core, on a multi-core microcontroller.
+** \param     taskIdx Zero based index of the event task.
+** \param     core Zero based index of the processor core.
+**
+****************************************************************************************/
+void TbxMbEvent::pin(uint8_t taskIdx, uint8_t core)
+{
+  TbxMbEventTaskPin(taskIdx, core);
+} /*** end of pin ***/
+
 /*********************************** end of tbxmbevent.cpp ******************************/
@@ -42,6 +42,9 @@ class TbxMbEvent
 public:
   /* Methods. */
   static void task();
+  static void task(uint8_t taskIdx);
+  static void select(uint8_t taskIdx);
+  static void pin(uint8_t taskIdx, uint8_t core);
 };
 
 #endif /* TBXMBEVENT_HPP */
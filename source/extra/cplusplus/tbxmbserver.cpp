@@ -53,6 +53,18 @@ TbxMbServer::~TbxMbServer()
 } /*** end of ~TbxMbServer ***/
 
 
+/************************************************************************************//**
+** \brief     Discards the responses that this server cached, such that the next read
+**            requests are processed with the virtual methods again. Call this method
+**            after the data changed, other than through a write request from a client.
+**
+****************************************************************************************/
+void TbxMbServer::invalidateCache()
+{
+  TbxMbServerInvalidateCache(m_Channel);
+} /*** end of invalidateCache ***/
+
+
 /************************************************************************************//**
 ** \brief     Reads a data element from the discrete input registers data table.
 ** \details   Note that the element is specified by its zero-based address in the range
@@ -168,6 +180,173 @@ tTbxMbServerResult TbxMbServer::writeHoldingReg(uint16_t addr,
 } /*** end of writeHoldingReg ***/
 
 
+/************************************************************************************//**
+** \brief     Reads a range of data elements from the input registers data table.
+** \details   Note that the elements are specified by their zero-based address in the
+**            range 0 - 65535, not their element number (1 - 65536).
+**            The default implementation calls readInputReg() for each data element.
+**            Override this method to process all the data elements with just one call.
+** \attention Store the values of the input registers in your CPUs native endianess.
+**            The MicroTBX-Modbus stack will automatically convert these to the big
+**            endianess that the Modbus protocol requires.
+** \param     addr Start element address (0..65535).
+** \param     num Number of elements to read (1..125).
+** \param     values Array where to store the values of the input registers.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+**            or more of the data element addresses are not supported by this server,
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+tTbxMbServerResult TbxMbServer::readInputRegs(uint16_t addr,
+                                              uint8_t  num,
+                                              uint16_t values[])
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_OK;
+
+  /* Read the input registers one at a time, until all are read or an error occurred. */
+  for (uint8_t idx = 0U; (idx < num) && (result == TBX_MB_SERVER_OK); idx++)
+  {
+    result = readInputReg(addr + idx, values[idx]);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of readInputRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Reads a range of data elements from the holding registers data table.
+** \details   Note that the elements are specified by their zero-based address in the
+**            range 0 - 65535, not their element number (1 - 65536).
+**            The default implementation calls readHoldingReg() for each data element.
+**            Override this method to process all the data elements with just one call.
+** \attention Store the values of the holding registers in your CPUs native endianess.
+**            The MicroTBX-Modbus stack will automatically convert these to the big
+**            endianess that the Modbus protocol requires.
+** \param     addr Start element address (0..65535).
+** \param     num Number of elements to read (1..125).
+** \param     values Array where to store the values of the holding registers.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+**            or more of the data element addresses are not supported by this server,
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+tTbxMbServerResult TbxMbServer::readHoldingRegs(uint16_t addr,
+                                                uint8_t  num,
+                                                uint16_t values[])
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_OK;
+
+  /* Read the holding registers one at a time, until all are read or an error 
+   * occurred.
+   */
+  for (uint8_t idx = 0U; (idx < num) && (result == TBX_MB_SERVER_OK); idx++)
+  {
+    result = readHoldingReg(addr + idx, values[idx]);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of readHoldingRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Writes a range of data elements to the holding registers data table.
+** \details   Note that the elements are specified by their zero-based address in the
+**            range 0 - 65535, not their element number (1 - 65536).
+**            The default implementation calls writeHoldingReg() for each data element.
+**            Override this method to process all the data elements with just one call.
+** \attention The values of the holding registers are already in your CPUs native
+**            endianess.
+** \param     addr Start element address (0..65535).
+** \param     num Number of elements to write (1..123).
+** \param     values Array with the new values of the holding registers.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+**            or more of the data element addresses are not supported by this server,
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+tTbxMbServerResult TbxMbServer::writeHoldingRegs(uint16_t       addr,
+                                                 uint8_t        num,
+                                                 uint16_t const values[])
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_OK;
+
+  /* Write the holding registers one at a time, until all are written or an error 
+   * occurred.
+   */
+  for (uint8_t idx = 0U; (idx < num) && (result == TBX_MB_SERVER_OK); idx++)
+  {
+    result = writeHoldingReg(addr + idx, values[idx]);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of writeHoldingRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Reads consecutive records from a file.
+** \details   The default implementation reports that the file is not supported.
+**            Override this method to support the reading of file records.
+** \param     file File number (1..65535).
+** \param     record Number of the first record to read (0..9999).
+** \param     num Number of records to read (1..124).
+** \param     values Array where the record values should be written to.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if the
+**            file or one or more of the records are not supported by this server,
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+tTbxMbServerResult TbxMbServer::readFileRecord(uint16_t file,
+                                               uint16_t record,
+                                               uint8_t  num,
+                                               uint16_t values[])
+{
+  return TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+} /*** end of readFileRecord ***/
+
+
+/************************************************************************************//**
+** \brief     Writes consecutive records to a file.
+** \details   The default implementation reports that the file is not supported.
+**            Override this method to support the writing of file records.
+** \param     file File number (1..65535).
+** \param     record Number of the first record to write (0..9999).
+** \param     num Number of records to write (1..122).
+** \param     values Array with the new values of the records.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if the
+**            file or one or more of the records are not supported by this server,
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+tTbxMbServerResult TbxMbServer::writeFileRecord(uint16_t       file,
+                                                uint16_t       record,
+                                                uint8_t        num,
+                                                uint16_t const values[])
+{
+  return TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+} /*** end of writeFileRecord ***/
+
+
+/************************************************************************************//**
+** \brief     Provides a device identification object. Write at most "maxLen" bytes of
+**            the object's value to "data" and return its total length.
+** \details   The default implementation provides no objects. Override this method to
+**            support the reading of the device identification. It should provide at
+**            least the vendor name, product code and revision objects. Note that
+**            "maxLen" can be 0, in which case just the length of the object is needed.
+** \param     objectId Object identifier (0x00..0xFF).
+** \param     data Array where the object's value should be written to.
+** \param     maxLen Maximum number of bytes to write to "data".
+** \return    Total length of the object's value or 0 if the object is not available.
+**
+****************************************************************************************/
+uint8_t TbxMbServer::readDeviceId(uint8_t objectId,
+                                  uint8_t data[],
+                                  uint8_t maxLen)
+{
+  return 0U;
+} /*** end of readDeviceId ***/
+
+
 /************************************************************************************//**
 ** \brief     Implements custom function code handling for supporting Modbus function
 **            codes that are either currently not supported or user defined extensions.
@@ -453,6 +632,254 @@ tTbxMbServerResult TbxMbServer::callbackWriteHoldingReg(tTbxMbServer channel,
 } /*** end of callbackWriteHoldingReg ***/
 
 
+/************************************************************************************//**
+** \brief     Wrapper to connect this callback to the readInputRegs() method of a class
+**            instance.
+** \param     channel Handle to the Modbus server channel object that triggered the 
+**            callback.
+** \param     addr Start element address (0..65535).
+** \param     num Number of elements to read (1..125).
+** \param     values Array to write the values of the input registers to.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+**            or more of the data element addresses are not supported by this server,
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+tTbxMbServerResult TbxMbServer::callbackReadInputRegs(tTbxMbServer           channel, 
+                                                      uint16_t               addr, 
+                                                      uint8_t                num, 
+                                                      uint16_t       * values)
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+
+  /* Only continue with a valid opaque channel pointer and values pointer. */
+  if ( (channel != nullptr) && (values != nullptr) )
+  {
+    /* Convert the opaque pointer to the channel context structure pointer. */
+    ChannelCtx * channelCtx = reinterpret_cast<ChannelCtx *>(channel);
+    /* Only continue with a valid instance pointer. */
+    if (channelCtx->instancePtr != nullptr)
+    {
+      /* The channel's instance pointer points to an instance of this class. Cast it as
+       * such.
+       */
+      TbxMbServer * serverPtr = static_cast<TbxMbServer *>(channelCtx->instancePtr);
+      /* Call the related instance method. */
+      result = serverPtr->readInputRegs(addr, num, values);
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of callbackReadInputRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Wrapper to connect this callback to the readHoldingRegs() method of a class
+**            instance.
+** \param     channel Handle to the Modbus server channel object that triggered the 
+**            callback.
+** \param     addr Start element address (0..65535).
+** \param     num Number of elements to read (1..125).
+** \param     values Array to write the values of the holding registers to.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+**            or more of the data element addresses are not supported by this server,
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+tTbxMbServerResult TbxMbServer::callbackReadHoldingRegs(tTbxMbServer           channel, 
+                                                        uint16_t               addr, 
+                                                        uint8_t                num, 
+                                                        uint16_t       * values)
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+
+  /* Only continue with a valid opaque channel pointer and values pointer. */
+  if ( (channel != nullptr) && (values != nullptr) )
+  {
+    /* Convert the opaque pointer to the channel context structure pointer. */
+    ChannelCtx * channelCtx = reinterpret_cast<ChannelCtx *>(channel);
+    /* Only continue with a valid instance pointer. */
+    if (channelCtx->instancePtr != nullptr)
+    {
+      /* The channel's instance pointer points to an instance of this class. Cast it as
+       * such.
+       */
+      TbxMbServer * serverPtr = static_cast<TbxMbServer *>(channelCtx->instancePtr);
+      /* Call the related instance method. */
+      result = serverPtr->readHoldingRegs(addr, num, values);
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of callbackReadHoldingRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Wrapper to connect this callback to the writeHoldingRegs() method of a class
+**            instance.
+** \param     channel Handle to the Modbus server channel object that triggered the 
+**            callback.
+** \param     addr Start element address (0..65535).
+** \param     num Number of elements to write (1..123).
+** \param     values Array with the new values of the holding registers.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+**            or more of the data element addresses are not supported by this server,
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+tTbxMbServerResult TbxMbServer::callbackWriteHoldingRegs(tTbxMbServer           channel, 
+                                                         uint16_t               addr, 
+                                                         uint8_t                num, 
+                                                         uint16_t const * values)
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+
+  /* Only continue with a valid opaque channel pointer and values pointer. */
+  if ( (channel != nullptr) && (values != nullptr) )
+  {
+    /* Convert the opaque pointer to the channel context structure pointer. */
+    ChannelCtx * channelCtx = reinterpret_cast<ChannelCtx *>(channel);
+    /* Only continue with a valid instance pointer. */
+    if (channelCtx->instancePtr != nullptr)
+    {
+      /* The channel's instance pointer points to an instance of this class. Cast it as
+       * such.
+       */
+      TbxMbServer * serverPtr = static_cast<TbxMbServer *>(channelCtx->instancePtr);
+      /* Call the related instance method. */
+      result = serverPtr->writeHoldingRegs(addr, num, values);
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of callbackWriteHoldingRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Wrapper to connect this callback to the readFileRecord() method of a class
+**            instance.
+** \param     channel Handle to the Modbus server channel object that triggered the 
+**            callback.
+** \param     file File number (1..65535).
+** \param     record Number of the first record to read (0..9999).
+** \param     num Number of records to read (1..124).
+** \param     values Pointer to write the record values to.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if the
+**            file or one or more of the records are not supported by this server,
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+tTbxMbServerResult TbxMbServer::callbackReadFileRecord(tTbxMbServer   channel,
+                                                       uint16_t       file,
+                                                       uint16_t       record,
+                                                       uint8_t        num,
+                                                       uint16_t     * values)
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+
+  /* Only continue with a valid opaque channel pointer and values pointer. */
+  if ( (channel != nullptr) && (values != nullptr) )
+  {
+    /* Convert the opaque pointer to the channel context structure pointer. */
+    ChannelCtx * channelCtx = reinterpret_cast<ChannelCtx *>(channel);
+    /* Only continue with a valid instance pointer. */
+    if (channelCtx->instancePtr != nullptr)
+    {
+      /* The channel's instance pointer points to an instance of this class. Cast it as
+       * such.
+       */
+      TbxMbServer * serverPtr = static_cast<TbxMbServer *>(channelCtx->instancePtr);
+      /* Call the related instance method. */
+      result = serverPtr->readFileRecord(file, record, num, values);
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of callbackReadFileRecord ***/
+
+
+/************************************************************************************//**
+** \brief     Wrapper to connect this callback to the writeFileRecord() method of a class
+**            instance.
+** \param     channel Handle to the Modbus server channel object that triggered the 
+**            callback.
+** \param     file File number (1..65535).
+** \param     record Number of the first record to write (0..9999).
+** \param     num Number of records to write (1..122).
+** \param     values Array with the new values of the records.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if the
+**            file or one or more of the records are not supported by this server,
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+tTbxMbServerResult TbxMbServer::callbackWriteFileRecord(tTbxMbServer           channel,
+                                                        uint16_t               file,
+                                                        uint16_t               record,
+                                                        uint8_t                num,
+                                                        uint16_t       const * values)
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+
+  /* Only continue with a valid opaque channel pointer and values pointer. */
+  if ( (channel != nullptr) && (values != nullptr) )
+  {
+    /* Convert the opaque pointer to the channel context structure pointer. */
+    ChannelCtx * channelCtx = reinterpret_cast<ChannelCtx *>(channel);
+    /* Only continue with a valid instance pointer. */
+    if (channelCtx->instancePtr != nullptr)
+    {
+      /* The channel's instance pointer points to an instance of this class. Cast it as
+       * such.
+       */
+      TbxMbServer * serverPtr = static_cast<TbxMbServer *>(channelCtx->instancePtr);
+      /* Call the related instance method. */
+      result = serverPtr->writeFileRecord(file, record, num, values);
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of callbackWriteFileRecord ***/
+
+
+/************************************************************************************//**
+** \brief     Wrapper to connect this callback to the readDeviceId() method of a class
+**            instance.
+** \param     channel Handle to the Modbus server channel object that triggered the 
+**            callback.
+** \param     objectId Object identifier (0x00..0xFF).
+** \param     data Pointer to write the object's value to.
+** \param     maxLen Maximum number of bytes to write to "data".
+** \return    Total length of the object's value or 0 if the object is not available.
+**
+****************************************************************************************/
+uint8_t TbxMbServer::callbackReadDeviceId(tTbxMbServer   channel,
+                                          uint8_t        objectId,
+                                          uint8_t      * data,
+                                          uint8_t        maxLen)
+{
+  uint8_t result = 0U;
+
+  /* Only continue with a valid opaque channel pointer and data pointer. */
+  if ( (channel != nullptr) && (data != nullptr) )
+  {
+    /* Convert the opaque pointer to the channel context structure pointer. */
+    ChannelCtx * channelCtx = reinterpret_cast<ChannelCtx *>(channel);
+    /* Only continue with a valid instance pointer. */
+    if (channelCtx->instancePtr != nullptr)
+    {
+      /* The channel's instance pointer points to an instance of this class. Cast it as
+       * such.
+       */
+      TbxMbServer * serverPtr = static_cast<TbxMbServer *>(channelCtx->instancePtr);
+      /* Call the related instance method. */
+      result = serverPtr->readDeviceId(objectId, data, maxLen);
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of callbackReadDeviceId ***/
+
+
 /************************************************************************************//**
 ** \brief     Wrapper to connect this callback to the customFunction() method of a class
 **            instance.
@@ -549,6 +976,12 @@ TbxMbServerRtu::TbxMbServerRtu(uint8_t            nodeAddr,
       TbxMbServerSetCallbackReadInputReg(m_Channel, callbackReadInputReg);
       TbxMbServerSetCallbackReadHoldingReg(m_Channel, callbackReadHoldingReg);
       TbxMbServerSetCallbackWriteHoldingReg(m_Channel, callbackWriteHoldingReg);
+      TbxMbServerSetCallbackReadInputRegs(m_Channel, callbackReadInputRegs);
+      TbxMbServerSetCallbackReadHoldingRegs(m_Channel, callbackReadHoldingRegs);
+      TbxMbServerSetCallbackWriteHoldingRegs(m_Channel, callbackWriteHoldingRegs);
+      TbxMbServerSetCallbackReadFileRecord(m_Channel, callbackReadFileRecord);
+      TbxMbServerSetCallbackWriteFileRecord(m_Channel, callbackWriteFileRecord);
+      TbxMbServerSetCallbackReadDeviceId(m_Channel, callbackReadDeviceId);
       TbxMbServerSetCallbackCustomFunction(m_Channel, calbackCustomFunction);
     }
   }
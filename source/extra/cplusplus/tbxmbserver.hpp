@@ -43,6 +43,8 @@ public:
   /* Constructors and destructor. */
   TbxMbServer() : m_Channel(nullptr) { }
   virtual ~TbxMbServer() = 0;
+  /* Methods. */
+  void invalidateCache();
 
 private:
   /* Methods. */
@@ -52,6 +54,18 @@ private:
   virtual tTbxMbServerResult readInputReg(uint16_t addr, uint16_t& value);
   virtual tTbxMbServerResult readHoldingReg(uint16_t addr, uint16_t& value);
   virtual tTbxMbServerResult writeHoldingReg(uint16_t addr, uint16_t value);
+  virtual tTbxMbServerResult readInputRegs(uint16_t addr, uint8_t num, 
+                                           uint16_t values[]);
+  virtual tTbxMbServerResult readHoldingRegs(uint16_t addr, uint8_t num, 
+                                             uint16_t values[]);
+  virtual tTbxMbServerResult writeHoldingRegs(uint16_t addr, uint8_t num, 
+                                              uint16_t const values[]);
+  virtual tTbxMbServerResult readFileRecord(uint16_t file, uint16_t record, uint8_t num,
+                                            uint16_t values[]);
+  virtual tTbxMbServerResult writeFileRecord(uint16_t file, uint16_t record, uint8_t num,
+                                             uint16_t const values[]);
+  virtual uint8_t            readDeviceId(uint8_t objectId, uint8_t data[],
+                                          uint8_t maxLen);
   virtual bool               customFunction(uint8_t const rxPdu[], uint8_t txPdu[], 
                                             uint8_t& len);
 
@@ -76,6 +90,21 @@ protected:
                                                    uint16_t * value);
   static tTbxMbServerResult callbackWriteHoldingReg(tTbxMbServer channel, uint16_t addr, 
                                                     uint16_t value);
+  static tTbxMbServerResult callbackReadInputRegs(tTbxMbServer channel, uint16_t addr, 
+                                                  uint8_t num, uint16_t * values);
+  static tTbxMbServerResult callbackReadHoldingRegs(tTbxMbServer channel, uint16_t addr, 
+                                                    uint8_t num, uint16_t * values);
+  static tTbxMbServerResult callbackWriteHoldingRegs(tTbxMbServer channel, 
+                                                     uint16_t addr, uint8_t num, 
+                                                     uint16_t const * values);
+  static tTbxMbServerResult callbackReadFileRecord(tTbxMbServer channel, uint16_t file,
+                                                   uint16_t record, uint8_t num,
+                                                   uint16_t * values);
+  static tTbxMbServerResult callbackWriteFileRecord(tTbxMbServer channel, uint16_t file,
+                                                    uint16_t record, uint8_t num,
+                                                    uint16_t const * values);
+  static  uint8_t           callbackReadDeviceId(tTbxMbServer channel, uint8_t objectId,
+                                                 uint8_t * data, uint8_t maxLen);
   static  uint8_t           calbackCustomFunction(tTbxMbServer channel,
                                                   uint8_t const * rxPdu, uint8_t * txPdu,
                                                   uint8_t * len);
@@ -0,0 +1,1073 @@
+/************************************************************************************//**
+* \file         tbxmbservert.hpp
+* \brief        MicroTBX-Modbus server C++ template header file.
+* \internal
+*----------------------------------------------------------------------------------------
+*                          C O P Y R I G H T
+*----------------------------------------------------------------------------------------
+*   Copyright (c) 2023 by Feaser     www.feaser.com     All rights reserved
+*
+*----------------------------------------------------------------------------------------
+*                            L I C E N S E
+*----------------------------------------------------------------------------------------
+*
+* SPDX-License-Identifier: GPL-3.0-or-later
+*
+* This file is part of MicroTBX-Modbus. MicroTBX-Modbus is free software: you can
+* redistribute it and/or modify it under the terms of the GNU General Public License as
+* published by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* MicroTBX-Modbus is distributed in the hope that it will be useful, but WITHOUT ANY
+* WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+* PARTICULAR PURPOSE. See the GNU General Public License for more details.
+*
+* You have received a copy of the GNU General Public License along with MicroTBX-Modbus.
+* If not, see www.gnu.org/licenses/.
+*
+* \endinternal
+****************************************************************************************/
+#ifndef TBXMBSERVERT_HPP
+#define TBXMBSERVERT_HPP
+
+/****************************************************************************************
+* Class definitions
+****************************************************************************************/
+/****************************************************************************************
+*                            T B X M B S E R V E R T
+****************************************************************************************/
+/** \brief   Modbus server base class template that resolves the data access methods at
+ *           compile time, instead of with virtual methods.
+ *  \details Derive your class from it with the curiously recurring template pattern,
+ *           e.g. "class AppServer : public TbxMbServerRtuT<AppServer>", and implement
+ *           just the methods that your server needs, with the same signature. The
+ *           callbacks call them directly, so the compiler can inline them. In case you
+ *           make these methods private, declare "friend class TbxMbServerT<AppServer>".
+ *           The default implementation of the bulk methods, such as readHoldingRegs(),
+ *           calls the method for one data element, such as readHoldingReg(), in a loop.
+ *           Implement the bulk method instead, to process all elements with one call.
+ */
+template <typename Derived>
+class TbxMbServerT
+{
+public:
+  /* Methods. */
+  void invalidateCache();
+
+protected:
+  /* Constructors and destructor. */
+  TbxMbServerT() : m_Channel(nullptr) { }
+  ~TbxMbServerT() { }
+  /* Methods. */
+  void               registerCallbacks();
+  tTbxMbServerResult readInput(uint16_t addr, bool& value);
+  tTbxMbServerResult readCoil(uint16_t addr, bool& value);
+  tTbxMbServerResult writeCoil(uint16_t addr, bool value);
+  tTbxMbServerResult readInputReg(uint16_t addr, uint16_t& value);
+  tTbxMbServerResult readHoldingReg(uint16_t addr, uint16_t& value);
+  tTbxMbServerResult writeHoldingReg(uint16_t addr, uint16_t value);
+  tTbxMbServerResult readInputs(uint16_t addr, uint16_t num, uint8_t values[]);
+  tTbxMbServerResult readCoils(uint16_t addr, uint16_t num, uint8_t values[]);
+  tTbxMbServerResult writeCoils(uint16_t addr, uint16_t num, uint8_t const values[]);
+  tTbxMbServerResult readInputRegs(uint16_t addr, uint8_t num, uint16_t values[]);
+  tTbxMbServerResult readHoldingRegs(uint16_t addr, uint8_t num, uint16_t values[]);
+  tTbxMbServerResult writeHoldingRegs(uint16_t addr, uint8_t num, 
+                                      uint16_t const values[]);
+  tTbxMbServerResult readFileRecord(uint16_t file, uint16_t record, uint8_t num,
+                                    uint16_t values[]);
+  tTbxMbServerResult writeFileRecord(uint16_t file, uint16_t record, uint8_t num,
+                                     uint16_t const values[]);
+  uint8_t            readDeviceId(uint8_t objectId, uint8_t data[], uint8_t maxLen);
+  bool               customFunction(uint8_t const rxPdu[], uint8_t txPdu[], 
+                                    uint8_t& len);
+  /* Members. */
+  tTbxMbServer m_Channel;
+
+private:
+  /* Types. */
+  using ChannelCtx = struct
+  {
+    void * instancePtr;
+  };
+  /* Methods. */
+  static Derived * instance(tTbxMbServer channel);
+  /* Callbacks. */
+  static tTbxMbServerResult callbackReadInputs(tTbxMbServer channel, uint16_t addr,
+                                               uint16_t num, uint8_t * values);
+  static tTbxMbServerResult callbackReadCoils(tTbxMbServer channel, uint16_t addr,
+                                              uint16_t num, uint8_t * values);
+  static tTbxMbServerResult callbackWriteCoils(tTbxMbServer channel, uint16_t addr,
+                                               uint16_t num, uint8_t const * values);
+  static tTbxMbServerResult callbackReadInputRegs(tTbxMbServer channel, uint16_t addr, 
+                                                  uint8_t num, uint16_t * values);
+  static tTbxMbServerResult callbackReadHoldingRegs(tTbxMbServer channel, uint16_t addr, 
+                                                    uint8_t num, uint16_t * values);
+  static tTbxMbServerResult callbackWriteHoldingRegs(tTbxMbServer channel, 
+                                                     uint16_t addr, uint8_t num, 
+                                                     uint16_t const * values);
+  static tTbxMbServerResult callbackReadFileRecord(tTbxMbServer channel, uint16_t file,
+                                                   uint16_t record, uint8_t num,
+                                                   uint16_t * values);
+  static tTbxMbServerResult callbackWriteFileRecord(tTbxMbServer channel, uint16_t file,
+                                                    uint16_t record, uint8_t num,
+                                                    uint16_t const * values);
+  static  uint8_t           callbackReadDeviceId(tTbxMbServer channel, uint8_t objectId,
+                                                 uint8_t * data, uint8_t maxLen);
+  static  uint8_t           callbackCustomFunction(tTbxMbServer channel,
+                                                   uint8_t const * rxPdu, uint8_t * txPdu,
+                                                   uint8_t * len);
+};
+
+
+/****************************************************************************************
+*                            T B X M B S E R V E R R T U T
+****************************************************************************************/
+/** \brief Modbus server class template that uses RTU as the transport layer. */
+template <typename Derived>
+class TbxMbServerRtuT : public TbxMbServerT<Derived>
+{
+public:
+  /* Constructors and destructor. */
+  TbxMbServerRtuT(uint8_t nodeAddr, tTbxMbUartPort serialPort, 
+                  tTbxMbUartBaudrate baudrate, tTbxMbUartStopbits stopbits,
+                  tTbxMbUartParity parity);
+
+protected:
+  ~TbxMbServerRtuT();
+
+private:
+  /* Members.*/
+  tTbxMbTp m_Transport;
+};
+
+
+/****************************************************************************************
+* Template implementation
+****************************************************************************************/
+/****************************************************************************************
+*                            T B X M B S E R V E R T
+****************************************************************************************/
+/************************************************************************************//**
+** \brief     Discards the responses that this server cached, such that the next read
+**            requests are processed with the data access methods again. Call this
+**            method after the data changed, other than through a write request from a
+**            client.
+**
+****************************************************************************************/
+template <typename Derived>
+void TbxMbServerT<Derived>::invalidateCache()
+{
+  TbxMbServerInvalidateCache(m_Channel);
+} /*** end of invalidateCache ***/
+
+
+/************************************************************************************//**
+** \brief     Links this instance to the server channel object and registers the
+**            callback functions. Call it right after creating the server channel object.
+**
+****************************************************************************************/
+template <typename Derived>
+void TbxMbServerT<Derived>::registerCallbacks()
+{
+  /* Only continue with a valid server channel object. */
+  if (m_Channel != nullptr)
+  {
+    /* Convert the opaque pointer to the channel context structure pointer. */
+    ChannelCtx * channelCtx = reinterpret_cast<ChannelCtx *>(m_Channel);
+    /* Store our instance pointer in the channel context. Needed for binding the 
+     * callback functions to instance methods.
+     */
+    channelCtx->instancePtr = this;
+    /* Register the callback functions. Only the bulk versions, because the default
+     * implementation of those calls the methods for one data element.
+     */
+    TbxMbServerSetCallbackReadInputs(m_Channel, callbackReadInputs);
+    TbxMbServerSetCallbackReadCoils(m_Channel, callbackReadCoils);
+    TbxMbServerSetCallbackWriteCoils(m_Channel, callbackWriteCoils);
+    TbxMbServerSetCallbackReadInputRegs(m_Channel, callbackReadInputRegs);
+    TbxMbServerSetCallbackReadHoldingRegs(m_Channel, callbackReadHoldingRegs);
+    TbxMbServerSetCallbackWriteHoldingRegs(m_Channel, callbackWriteHoldingRegs);
+    TbxMbServerSetCallbackReadFileRecord(m_Channel, callbackReadFileRecord);
+    TbxMbServerSetCallbackWriteFileRecord(m_Channel, callbackWriteFileRecord);
+    TbxMbServerSetCallbackReadDeviceId(m_Channel, callbackReadDeviceId);
+    TbxMbServerSetCallbackCustomFunction(m_Channel, callbackCustomFunction);
+  }
+} /*** end of registerCallbacks ***/
+
+
+/************************************************************************************//**
+** \brief     Reads a data element from the discrete input registers data table.
+** \details   Note that the element is specified by its zero-based address in the range
+**            0 - 65535, not its element number (1 - 65536).
+** \param     addr Element address (0..65535).
+** \param     value Reference where to store the value of the discrete input.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if the
+**            specific data element address is not supported by this server, 
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+template <typename Derived>
+tTbxMbServerResult TbxMbServerT<Derived>::readInput(uint16_t addr, 
+                                                    bool&    value)
+{
+  TBX_UNUSED_ARG(addr);
+  TBX_UNUSED_ARG(value);
+  return TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+} /*** end of readInput ***/
+
+
+/************************************************************************************//**
+** \brief     Reads a data element from the coils data table.
+** \details   Note that the element is specified by its zero-based address in the range
+**            0 - 65535, not its element number (1 - 65536).
+** \param     addr Element address (0..65535).
+** \param     value Reference where to store the value of the coil.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if the
+**            specific data element address is not supported by this server, 
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+template <typename Derived>
+tTbxMbServerResult TbxMbServerT<Derived>::readCoil(uint16_t addr,
+                                                   bool&    value)
+{
+  TBX_UNUSED_ARG(addr);
+  TBX_UNUSED_ARG(value);
+  return TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+} /*** end of readCoil ***/
+
+
+/************************************************************************************//**
+** \brief     Writes a data element to the coils data table.
+** \details   Note that the element is specified by its zero-based address in the range
+**            0 - 65535, not its element number (1 - 65536).
+** \param     addr Element address (0..65535).
+** \param     value Coil value.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if the
+**            specific data element address is not supported by this server, 
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+template <typename Derived>
+tTbxMbServerResult TbxMbServerT<Derived>::writeCoil(uint16_t addr, 
+                                                    bool     value)
+{
+  TBX_UNUSED_ARG(addr);
+  TBX_UNUSED_ARG(value);
+  return TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+} /*** end of writeCoil ***/
+
+
+/************************************************************************************//**
+** \brief     Reads a data element from the input registers data table.
+** \details   Note that the element is specified by its zero-based address in the range
+**            0 - 65535, not its element number (1 - 65536).
+** \attention Store the value of the input register in your CPUs native endianess. The
+**            MicroTBX-Modbus stack will automatically convert this to the big endianess
+**            that the Modbus protocol requires.
+** \param     addr Element address (0..65535).
+** \param     value Reference where to store the value of the input register.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if the
+**            specific data element address is not supported by this server, 
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+template <typename Derived>
+tTbxMbServerResult TbxMbServerT<Derived>::readInputReg(uint16_t  addr, 
+                                                       uint16_t& value)
+{
+  TBX_UNUSED_ARG(addr);
+  TBX_UNUSED_ARG(value);
+  return TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+} /*** end of readInputReg ***/
+
+
+/************************************************************************************//**
+** \brief     Reads a data element from the holding registers data table.
+** \details   Note that the element is specified by its zero-based address in the range
+**            0 - 65535, not its element number (1 - 65536).
+** \attention Store the value of the holding register in your CPUs native endianess. The
+**            MicroTBX-Modbus stack will automatically convert this to the big endianess
+**            that the Modbus protocol requires.
+** \param     addr Element address (0..65535).
+** \param     value Reference where to store the value of the holding register.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if the
+**            specific data element address is not supported by this server, 
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+template <typename Derived>
+tTbxMbServerResult TbxMbServerT<Derived>::readHoldingReg(uint16_t  addr, 
+                                                         uint16_t& value)
+{
+  TBX_UNUSED_ARG(addr);
+  TBX_UNUSED_ARG(value);
+  return TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+} /*** end of readHoldingReg ***/
+
+
+/************************************************************************************//**
+** \brief     Writes a data element to the holding registers data table.
+** \details   Note that the element is specified by its zero-based address in the range
+**            0 - 65535, not its element number (1 - 65536).
+** \attention The value of the holding register in already in your CPUs native endianess.
+** \param     addr Element address (0..65535).
+** \param     value Value of the holding register.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if the
+**            specific data element address is not supported by this server, 
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+template <typename Derived>
+tTbxMbServerResult TbxMbServerT<Derived>::writeHoldingReg(uint16_t addr,
+                                                          uint16_t value)
+{
+  TBX_UNUSED_ARG(addr);
+  TBX_UNUSED_ARG(value);
+  return TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+} /*** end of writeHoldingReg ***/
+
+
+/************************************************************************************//**
+** \brief     Reads a range of data elements from the discrete inputs data table.
+** \details   The default implementation calls readInput() of the derived class for each
+**            data element. Implement this method to process all the data elements with
+**            just one call.
+** \param     addr Start element address (0..65535).
+** \param     num Number of elements to read (1..2000).
+** \param     values Byte array where to write the packed input bits to. The bit in the
+**            LSB of the first byte is for the input at the start address.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+**            or more of the data element addresses are not supported by this server,
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+template <typename Derived>
+tTbxMbServerResult TbxMbServerT<Derived>::readInputs(uint16_t addr,
+                                                     uint16_t num,
+                                                     uint8_t  values[])
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_OK;
+
+  /* Read the inputs one at a time, until all are read or an error occurred. */
+  for (uint16_t idx = 0U; (idx < num) && (result == TBX_MB_SERVER_OK); idx++)
+  {
+    bool inputValue = false;
+    result = static_cast<Derived *>(this)->readInput(addr + idx, inputValue);
+    /* Store the input bit. */
+    uint8_t bitMask = static_cast<uint8_t>(1U << (idx % 8U));
+    if (inputValue)
+    {
+      values[idx / 8U] |= bitMask;
+    }
+    else
+    {
+      values[idx / 8U] &= static_cast<uint8_t>(~bitMask);
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of readInputs ***/
+
+
+/************************************************************************************//**
+** \brief     Reads a range of data elements from the coils data table.
+** \details   The default implementation calls readCoil() of the derived class for each
+**            data element. Implement this method to process all the data elements with
+**            just one call.
+** \param     addr Start element address (0..65535).
+** \param     num Number of elements to read (1..2000).
+** \param     values Byte array where to write the packed coil bits to. The bit in the
+**            LSB of the first byte is for the coil at the start address.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+**            or more of the data element addresses are not supported by this server,
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+template <typename Derived>
+tTbxMbServerResult TbxMbServerT<Derived>::readCoils(uint16_t addr,
+                                                    uint16_t num,
+                                                    uint8_t  values[])
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_OK;
+
+  /* Read the coils one at a time, until all are read or an error occurred. */
+  for (uint16_t idx = 0U; (idx < num) && (result == TBX_MB_SERVER_OK); idx++)
+  {
+    bool coilValue = false;
+    result = static_cast<Derived *>(this)->readCoil(addr + idx, coilValue);
+    /* Store the coil bit. */
+    uint8_t bitMask = static_cast<uint8_t>(1U << (idx % 8U));
+    if (coilValue)
+    {
+      values[idx / 8U] |= bitMask;
+    }
+    else
+    {
+      values[idx / 8U] &= static_cast<uint8_t>(~bitMask);
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of readCoils ***/
+
+
+/************************************************************************************//**
+** \brief     Writes a range of data elements to the coils data table.
+** \details   The default implementation calls writeCoil() of the derived class for each
+**            data element. Implement this method to process all the data elements with
+**            just one call.
+** \param     addr Start element address (0..65535).
+** \param     num Number of elements to write (1..1968).
+** \param     values Byte array with the packed coil bits. The bit in the LSB of the
+**            first byte is for the coil at the start address.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+**            or more of the data element addresses are not supported by this server,
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+template <typename Derived>
+tTbxMbServerResult TbxMbServerT<Derived>::writeCoils(uint16_t      addr,
+                                                     uint16_t      num,
+                                                     uint8_t const values[])
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_OK;
+
+  /* Write the coils one at a time, until all are written or an error occurred. */
+  for (uint16_t idx = 0U; (idx < num) && (result == TBX_MB_SERVER_OK); idx++)
+  {
+    bool coilValue = ((values[idx / 8U] & (1U << (idx % 8U))) != 0U);
+    result = static_cast<Derived *>(this)->writeCoil(addr + idx, coilValue);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of writeCoils ***/
+
+
+/************************************************************************************//**
+** \brief     Reads a range of data elements from the input registers data table.
+** \details   The default implementation calls readInputReg() of the derived class for
+**            each data element. Implement this method to process all the data elements
+**            with just one call.
+** \attention Store the values of the input registers in your CPUs native endianess.
+**            The MicroTBX-Modbus stack will automatically convert these to the big
+**            endianess that the Modbus protocol requires.
+** \param     addr Start element address (0..65535).
+** \param     num Number of elements to read (1..125).
+** \param     values Array where to store the values of the input registers.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+**            or more of the data element addresses are not supported by this server,
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+template <typename Derived>
+tTbxMbServerResult TbxMbServerT<Derived>::readInputRegs(uint16_t addr,
+                                                        uint8_t  num,
+                                                        uint16_t values[])
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_OK;
+
+  /* Read the input registers one at a time, until all are read or an error occurred. */
+  for (uint8_t idx = 0U; (idx < num) && (result == TBX_MB_SERVER_OK); idx++)
+  {
+    result = static_cast<Derived *>(this)->readInputReg(addr + idx, values[idx]);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of readInputRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Reads a range of data elements from the holding registers data table.
+** \details   The default implementation calls readHoldingReg() of the derived class for
+**            each data element. Implement this method to process all the data elements
+**            with just one call.
+** \attention Store the values of the holding registers in your CPUs native endianess.
+**            The MicroTBX-Modbus stack will automatically convert these to the big
+**            endianess that the Modbus protocol requires.
+** \param     addr Start element address (0..65535).
+** \param     num Number of elements to read (1..125).
+** \param     values Array where to store the values of the holding registers.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+**            or more of the data element addresses are not supported by this server,
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+template <typename Derived>
+tTbxMbServerResult TbxMbServerT<Derived>::readHoldingRegs(uint16_t addr,
+                                                          uint8_t  num,
+                                                          uint16_t values[])
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_OK;
+
+  /* Read the holding registers one at a time, until all are read or an error 
+   * occurred.
+   */
+  for (uint8_t idx = 0U; (idx < num) && (result == TBX_MB_SERVER_OK); idx++)
+  {
+    result = static_cast<Derived *>(this)->readHoldingReg(addr + idx, values[idx]);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of readHoldingRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Writes a range of data elements to the holding registers data table.
+** \details   The default implementation calls writeHoldingReg() of the derived class for
+**            each data element. Implement this method to process all the data elements
+**            with just one call.
+** \attention The values of the holding registers are already in your CPUs native
+**            endianess.
+** \param     addr Start element address (0..65535).
+** \param     num Number of elements to write (1..123).
+** \param     values Array with the new values of the holding registers.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+**            or more of the data element addresses are not supported by this server,
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+template <typename Derived>
+tTbxMbServerResult TbxMbServerT<Derived>::writeHoldingRegs(uint16_t       addr,
+                                                           uint8_t        num,
+                                                           uint16_t const values[])
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_OK;
+
+  /* Write the holding registers one at a time, until all are written or an error 
+   * occurred.
+   */
+  for (uint8_t idx = 0U; (idx < num) && (result == TBX_MB_SERVER_OK); idx++)
+  {
+    result = static_cast<Derived *>(this)->writeHoldingReg(addr + idx, values[idx]);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of writeHoldingRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Reads one or more records from a file.
+** \param     file File number (1..65535).
+** \param     record Number of the first record to read (0..9999).
+** \param     num Number of records to read (1..124).
+** \param     values Array where to store the values of the records.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if the
+**            file or one or more of the records are not supported by this server,
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+template <typename Derived>
+tTbxMbServerResult TbxMbServerT<Derived>::readFileRecord(uint16_t file,
+                                                         uint16_t record,
+                                                         uint8_t  num,
+                                                         uint16_t values[])
+{
+  TBX_UNUSED_ARG(file);
+  TBX_UNUSED_ARG(record);
+  TBX_UNUSED_ARG(num);
+  TBX_UNUSED_ARG(values);
+  return TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+} /*** end of readFileRecord ***/
+
+
+/************************************************************************************//**
+** \brief     Writes one or more records to a file.
+** \param     file File number (1..65535).
+** \param     record Number of the first record to write (0..9999).
+** \param     num Number of records to write (1..122).
+** \param     values Array with the new values of the records.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if the
+**            file or one or more of the records are not supported by this server,
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+template <typename Derived>
+tTbxMbServerResult TbxMbServerT<Derived>::writeFileRecord(uint16_t       file,
+                                                          uint16_t       record,
+                                                          uint8_t        num,
+                                                          uint16_t const values[])
+{
+  TBX_UNUSED_ARG(file);
+  TBX_UNUSED_ARG(record);
+  TBX_UNUSED_ARG(num);
+  TBX_UNUSED_ARG(values);
+  return TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+} /*** end of writeFileRecord ***/
+
+
+/************************************************************************************//**
+** \brief     Reads the value of a device identification object.
+** \param     objectId Object identifier (0x00..0xFF).
+** \param     data Array where to write the object's value to.
+** \param     maxLen Maximum number of bytes to write to "data".
+** \return    Total length of the object's value or 0 if the object is not available.
+**
+****************************************************************************************/
+template <typename Derived>
+uint8_t TbxMbServerT<Derived>::readDeviceId(uint8_t objectId,
+                                            uint8_t data[],
+                                            uint8_t maxLen)
+{
+  TBX_UNUSED_ARG(objectId);
+  TBX_UNUSED_ARG(data);
+  TBX_UNUSED_ARG(maxLen);
+  return 0U;
+} /*** end of readDeviceId ***/
+
+
+/************************************************************************************//**
+** \brief     Implements the processing of a custom function code.
+** \param     rxPdu Array with the received PDU.
+** \param     txPdu Array for writing the response PDU.
+** \param     len Reference to the PDU length, including the function code.
+** \return    True if the function code was handled and a response PDU was prepared.
+**            False otherwise.
+**
+****************************************************************************************/
+template <typename Derived>
+bool TbxMbServerT<Derived>::customFunction(uint8_t  const rxPdu[], 
+                                           uint8_t        txPdu[],
+                                           uint8_t&       len)
+{
+  TBX_UNUSED_ARG(rxPdu);
+  TBX_UNUSED_ARG(txPdu);
+  TBX_UNUSED_ARG(len);
+  return false;
+} /*** end of customFunction ***/
+
+
+/************************************************************************************//**
+** \brief     Obtains the instance of the derived class that is linked to the server
+**            channel object.
+** \param     channel Handle to the Modbus server channel object.
+** \return    Pointer to the instance if successful, nullptr otherwise.
+**
+****************************************************************************************/
+template <typename Derived>
+Derived * TbxMbServerT<Derived>::instance(tTbxMbServer channel)
+{
+  Derived * result = nullptr;
+
+  /* Only continue with a valid opaque channel pointer. */
+  if (channel != nullptr)
+  {
+    /* Convert the opaque pointer to the channel context structure pointer. */
+    ChannelCtx * channelCtx = reinterpret_cast<ChannelCtx *>(channel);
+    /* Only continue with a valid instance pointer. */
+    if (channelCtx->instancePtr != nullptr)
+    {
+      /* The channel's instance pointer points to an instance of this class, which is
+       * the base of the derived class. Cast it as such.
+       */
+      TbxMbServerT<Derived> * basePtr = 
+        static_cast<TbxMbServerT<Derived> *>(channelCtx->instancePtr);
+      result = static_cast<Derived *>(basePtr);
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of instance ***/
+
+
+/************************************************************************************//**
+** \brief     Wrapper to connect this callback to the readInputs() method of the derived
+**            class instance.
+** \param     channel Handle to the Modbus server channel object that triggered the 
+**            callback.
+** \param     addr Start element address (0..65535).
+** \param     num Number of elements to read (1..2000).
+** \param     values Byte array where to write the packed input bits to.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+**            or more of the data element addresses are not supported by this server,
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+template <typename Derived>
+tTbxMbServerResult TbxMbServerT<Derived>::callbackReadInputs(tTbxMbServer   channel,
+                                                             uint16_t       addr,
+                                                             uint16_t       num,
+                                                             uint8_t      * values)
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+  Derived          * serverPtr = instance(channel);
+
+  /* Only continue with a valid instance pointer and values pointer. */
+  if ( (serverPtr != nullptr) && (values != nullptr) )
+  {
+    /* Call the related instance method. */
+    result = serverPtr->readInputs(addr, num, values);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of callbackReadInputs ***/
+
+
+/************************************************************************************//**
+** \brief     Wrapper to connect this callback to the readCoils() method of the derived
+**            class instance.
+** \param     channel Handle to the Modbus server channel object that triggered the 
+**            callback.
+** \param     addr Start element address (0..65535).
+** \param     num Number of elements to read (1..2000).
+** \param     values Byte array where to write the packed coil bits to.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+**            or more of the data element addresses are not supported by this server,
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+template <typename Derived>
+tTbxMbServerResult TbxMbServerT<Derived>::callbackReadCoils(tTbxMbServer   channel,
+                                                            uint16_t       addr,
+                                                            uint16_t       num,
+                                                            uint8_t      * values)
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+  Derived          * serverPtr = instance(channel);
+
+  /* Only continue with a valid instance pointer and values pointer. */
+  if ( (serverPtr != nullptr) && (values != nullptr) )
+  {
+    /* Call the related instance method. */
+    result = serverPtr->readCoils(addr, num, values);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of callbackReadCoils ***/
+
+
+/************************************************************************************//**
+** \brief     Wrapper to connect this callback to the writeCoils() method of the derived
+**            class instance.
+** \param     channel Handle to the Modbus server channel object that triggered the 
+**            callback.
+** \param     addr Start element address (0..65535).
+** \param     num Number of elements to write (1..1968).
+** \param     values Byte array with the packed coil bits.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+**            or more of the data element addresses are not supported by this server,
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+template <typename Derived>
+tTbxMbServerResult TbxMbServerT<Derived>::callbackWriteCoils(tTbxMbServer         channel,
+                                                             uint16_t             addr,
+                                                             uint16_t             num,
+                                                             uint8_t      const * values)
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+  Derived          * serverPtr = instance(channel);
+
+  /* Only continue with a valid instance pointer and values pointer. */
+  if ( (serverPtr != nullptr) && (values != nullptr) )
+  {
+    /* Call the related instance method. */
+    result = serverPtr->writeCoils(addr, num, values);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of callbackWriteCoils ***/
+
+
+/************************************************************************************//**
+** \brief     Wrapper to connect this callback to the readInputRegs() method of the
+**            derived class instance.
+** \param     channel Handle to the Modbus server channel object that triggered the 
+**            callback.
+** \param     addr Start element address (0..65535).
+** \param     num Number of elements to read (1..125).
+** \param     values Array where to store the values of the input registers.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+**            or more of the data element addresses are not supported by this server,
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+template <typename Derived>
+tTbxMbServerResult TbxMbServerT<Derived>::callbackReadInputRegs(tTbxMbServer   channel,
+                                                                uint16_t       addr,
+                                                                uint8_t        num,
+                                                                uint16_t     * values)
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+  Derived          * serverPtr = instance(channel);
+
+  /* Only continue with a valid instance pointer and values pointer. */
+  if ( (serverPtr != nullptr) && (values != nullptr) )
+  {
+    /* Call the related instance method. */
+    result = serverPtr->readInputRegs(addr, num, values);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of callbackReadInputRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Wrapper to connect this callback to the readHoldingRegs() method of the
+**            derived class instance.
+** \param     channel Handle to the Modbus server channel object that triggered the 
+**            callback.
+** \param     addr Start element address (0..65535).
+** \param     num Number of elements to read (1..125).
+** \param     values Array where to store the values of the holding registers.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+**            or more of the data element addresses are not supported by this server,
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+template <typename Derived>
+tTbxMbServerResult TbxMbServerT<Derived>::callbackReadHoldingRegs(tTbxMbServer   channel,
+                                                                  uint16_t       addr,
+                                                                  uint8_t        num,
+                                                                  uint16_t     * values)
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+  Derived          * serverPtr = instance(channel);
+
+  /* Only continue with a valid instance pointer and values pointer. */
+  if ( (serverPtr != nullptr) && (values != nullptr) )
+  {
+    /* Call the related instance method. */
+    result = serverPtr->readHoldingRegs(addr, num, values);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of callbackReadHoldingRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Wrapper to connect this callback to the writeHoldingRegs() method of the
+**            derived class instance.
+** \param     channel Handle to the Modbus server channel object that triggered the 
+**            callback.
+** \param     addr Start element address (0..65535).
+** \param     num Number of elements to write (1..123).
+** \param     values Array with the new values of the holding registers.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+**            or more of the data element addresses are not supported by this server,
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+template <typename Derived>
+tTbxMbServerResult TbxMbServerT<Derived>::callbackWriteHoldingRegs(
+                                                           tTbxMbServer         channel,
+                                                           uint16_t             addr,
+                                                           uint8_t              num,
+                                                           uint16_t     const * values)
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+  Derived          * serverPtr = instance(channel);
+
+  /* Only continue with a valid instance pointer and values pointer. */
+  if ( (serverPtr != nullptr) && (values != nullptr) )
+  {
+    /* Call the related instance method. */
+    result = serverPtr->writeHoldingRegs(addr, num, values);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of callbackWriteHoldingRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Wrapper to connect this callback to the readFileRecord() method of the
+**            derived class instance.
+** \param     channel Handle to the Modbus server channel object that triggered the 
+**            callback.
+** \param     file File number (1..65535).
+** \param     record Number of the first record to read (0..9999).
+** \param     num Number of records to read (1..124).
+** \param     values Array where to store the values of the records.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if the
+**            file or one or more of the records are not supported by this server,
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+template <typename Derived>
+tTbxMbServerResult TbxMbServerT<Derived>::callbackReadFileRecord(tTbxMbServer   channel,
+                                                                 uint16_t       file,
+                                                                 uint16_t       record,
+                                                                 uint8_t        num,
+                                                                 uint16_t     * values)
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+  Derived          * serverPtr = instance(channel);
+
+  /* Only continue with a valid instance pointer and values pointer. */
+  if ( (serverPtr != nullptr) && (values != nullptr) )
+  {
+    /* Call the related instance method. */
+    result = serverPtr->readFileRecord(file, record, num, values);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of callbackReadFileRecord ***/
+
+
+/************************************************************************************//**
+** \brief     Wrapper to connect this callback to the writeFileRecord() method of the
+**            derived class instance.
+** \param     channel Handle to the Modbus server channel object that triggered the 
+**            callback.
+** \param     file File number (1..65535).
+** \param     record Number of the first record to write (0..9999).
+** \param     num Number of records to write (1..122).
+** \param     values Array with the new values of the records.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if the
+**            file or one or more of the records are not supported by this server,
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+template <typename Derived>
+tTbxMbServerResult TbxMbServerT<Derived>::callbackWriteFileRecord(
+                                                             tTbxMbServer         channel,
+                                                             uint16_t             file,
+                                                             uint16_t             record,
+                                                             uint8_t              num,
+                                                             uint16_t     const * values)
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+  Derived          * serverPtr = instance(channel);
+
+  /* Only continue with a valid instance pointer and values pointer. */
+  if ( (serverPtr != nullptr) && (values != nullptr) )
+  {
+    /* Call the related instance method. */
+    result = serverPtr->writeFileRecord(file, record, num, values);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of callbackWriteFileRecord ***/
+
+
+/************************************************************************************//**
+** \brief     Wrapper to connect this callback to the readDeviceId() method of the
+**            derived class instance.
+** \param     channel Handle to the Modbus server channel object that triggered the 
+**            callback.
+** \param     objectId Object identifier (0x00..0xFF).
+** \param     data Pointer to write the object's value to.
+** \param     maxLen Maximum number of bytes to write to "data".
+** \return    Total length of the object's value or 0 if the object is not available.
+**
+****************************************************************************************/
+template <typename Derived>
+uint8_t TbxMbServerT<Derived>::callbackReadDeviceId(tTbxMbServer   channel,
+                                                    uint8_t        objectId,
+                                                    uint8_t      * data,
+                                                    uint8_t        maxLen)
+{
+  uint8_t   result = 0U;
+  Derived * serverPtr = instance(channel);
+
+  /* Only continue with a valid instance pointer and data pointer. */
+  if ( (serverPtr != nullptr) && (data != nullptr) )
+  {
+    /* Call the related instance method. */
+    result = serverPtr->readDeviceId(objectId, data, maxLen);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of callbackReadDeviceId ***/
+
+
+/************************************************************************************//**
+** \brief     Wrapper to connect this callback to the customFunction() method of the
+**            derived class instance.
+** \param     channel Handle to the Modbus server channel object that triggered the 
+**            callback.
+** \param     rxPdu Pointer to a byte array for reading the received PDU.
+** \param     txPdu Pointer to a byte array for writing the response PDU.
+** \param     len Pointer to the PDU length, including the function code.
+** \return    TBX_TRUE if the callback function handled the received function code and 
+**            prepared a response PDU. TBX_FALSE otherwise.
+**
+****************************************************************************************/
+template <typename Derived>
+uint8_t TbxMbServerT<Derived>::callbackCustomFunction(tTbxMbServer         channel, 
+                                                      uint8_t      const * rxPdu,
+                                                      uint8_t            * txPdu,
+                                                      uint8_t            * len)
+{
+  uint8_t   result = TBX_FALSE;
+  Derived * serverPtr = instance(channel);
+
+  /* Only continue with a valid instance pointer and PDU and len pointers. */
+  if ( (serverPtr != nullptr) && (rxPdu != nullptr) && (txPdu != nullptr) && 
+       (len != nullptr)) 
+  {
+    /* Call the related instance method. */
+    if (serverPtr->customFunction(rxPdu, txPdu, *len))
+    {
+      /* Update the result. */
+      result = TBX_TRUE;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of callbackCustomFunction ***/
+
+
+/****************************************************************************************
+*                            T B X M B S E R V E R R T U T
+****************************************************************************************/
+/************************************************************************************//**
+** \brief     Modbus RTU server constructor.
+** \param     nodeAddr The address of the node. Can be in the range 1..247.
+** \param     serialPort The serial port to use. The actual meaning of the serial port is
+**            hardware dependent. It typically maps to the UART peripheral number. E.g. 
+**            TBX_MB_UART_PORT1 = USART1 on an STM32.
+** \param     baudrate The desired communication speed.
+** \param     stopbits Number of stop bits at the end of a character.
+** \param     parity Parity bit type to use.
+**
+****************************************************************************************/
+template <typename Derived>
+TbxMbServerRtuT<Derived>::TbxMbServerRtuT(uint8_t            nodeAddr, 
+                                          tTbxMbUartPort     serialPort, 
+                                          tTbxMbUartBaudrate baudrate,
+                                          tTbxMbUartStopbits stopbits,
+                                          tTbxMbUartParity   parity)
+  : TbxMbServerT<Derived>(), m_Transport(nullptr)
+{
+  /* Create the Modbus RTU transport layer object. */
+  m_Transport = TbxMbRtuCreate(nodeAddr, serialPort, baudrate, stopbits, parity);
+  /* Make sure the transport layer object could be created. */
+  TBX_ASSERT(m_Transport != nullptr);
+
+  /* Only continue with a valid transport layer object. */
+  if (m_Transport != nullptr)
+  {
+    /* Create a Modbus server channel object and link the RTU transport layer object. */
+    this->m_Channel = TbxMbServerCreate(m_Transport);
+    /* Make sure the server channel object could be created. */
+    TBX_ASSERT(this->m_Channel != nullptr);
+    /* Link this instance to the server channel object. */
+    this->registerCallbacks();
+  }
+} /*** end of TbxMbServerRtuT ***/
+
+
+/************************************************************************************//**
+** \brief     Modbus RTU server destructor.
+**
+****************************************************************************************/
+template <typename Derived>
+TbxMbServerRtuT<Derived>::~TbxMbServerRtuT()
+{
+  /* Server object valid? */
+  if (this->m_Channel != nullptr)
+  {
+    /* Release the server object. */
+    TbxMbServerFree(this->m_Channel);
+  }
+  /* Transport layer object valid? */
+  if (m_Transport != nullptr)
+  {
+    /* Release the transport layer object. */
+    TbxMbRtuFree(m_Transport);
+  }
+} /*** end of ~TbxMbServerRtuT ***/
+
+#endif /* TBXMBSERVERT_HPP */
+/*********************************** end of tbxmbservert.hpp ***************************/
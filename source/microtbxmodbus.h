@@ -37,11 +37,17 @@
 #include <stddef.h>                              /* Standard definitions               */
 #include "tbxmb_common.h"                        /* MicroTBX-Modbus common definitions */
 #include "tbxmb_tp.h"                            /* MicroTBX-Modbus transport layer    */
+#include "tbxmb_trace.h"                         /* MicroTBX-Modbus latency tracing    */
 #include "tbxmb_uart.h"                          /* MicroTBX-Modbus UART               */
 #include "tbxmb_rtu.h"                           /* MicroTBX-Modbus RTU                */
+#include "tbxmb_ascii.h"                         /* MicroTBX-Modbus ASCII              */
+#include "tbxmb_tcp.h"                           /* MicroTBX-Modbus TCP                */
 #include "tbxmb_event.h"                         /* MicroTBX-Modbus event handling     */
 #include "tbxmb_server.h"                        /* MicroTBX-Modbus server             */
 #include "tbxmb_client.h"                        /* MicroTBX-Modbus client             */
+#include "tbxmb_cyclic.h"                        /* MicroTBX-Modbus cyclic polling     */
+#include "tbxmb_monitor.h"                       /* MicroTBX-Modbus RTU bus monitor    */
+#include "tbxmb_gateway.h"                       /* MicroTBX-Modbus TCP to RTU gateway */
 #include "tbxmb_port.h"                          /* MicroTBX-Modbus hardware port      */
 
 
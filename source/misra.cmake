@@ -23,6 +23,8 @@ if (CMAKE_CXX_CPPCHECK)
 
     # Collect MicroTBX-Modbus sources.
     get_target_property(microtbx_modbus_srcs microtbx-modbus INTERFACE_SOURCES)
+    # Collect MicroTBX-Modbus TCP sources.
+    get_target_property(microtbx_modbus_tcp_srcs microtbx-modbus-tcp INTERFACE_SOURCES)
     # Collect MicroTBX-Modbus template sources.
     get_target_property(microtbx_modbus_template_srcs microtbx-modbus-template INTERFACE_SOURCES)
     # Collect MicroTBX-Modbus OSAL superloop sources.
@@ -33,6 +35,7 @@ if (CMAKE_CXX_CPPCHECK)
     # Build list with MicroTBX-Modbus sources to check.
     set(check_srcs)
     list(APPEND check_srcs ${microtbx_modbus_srcs})
+    list(APPEND check_srcs ${microtbx_modbus_tcp_srcs})
     list(APPEND check_srcs ${microtbx_modbus_template_srcs})
     list(APPEND check_srcs ${microtbx_modbus_superloop_srcs})
     list(APPEND check_srcs ${microtbx_modbus_freertos_srcs})
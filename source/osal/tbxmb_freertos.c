@@ -41,11 +41,69 @@
 #include <semphr.h>                              /* FreeRTOS semaphores                */
 
 
+/****************************************************************************************
+* Macro definitions
+****************************************************************************************/
+#ifndef TBX_MB_FREERTOS_SEM_NOTIFY_ENABLE
+/** \brief By default, the semaphores are FreeRTOS binary semaphores. When this
+ *         configuration macro is > 0, they are built on direct to task notifications
+ *         instead. These are faster and need less RAM. The semaphores operate on the
+ *         task notification with index TBX_MB_FREERTOS_NOTIFY_INDEX, of the task that
+ *         waits for the semaphore. For example the task that calls a blocking client
+ *         function. The application should therefore not use this task notification for
+ *         other purposes. To override this default configuration, you can add a macro
+ *         with the same name, but with a value of 1 (enable), to "tbx_conf.h".
+ */
+#define TBX_MB_FREERTOS_SEM_NOTIFY_ENABLE (0U)
+#endif
+
+#ifndef TBX_MB_FREERTOS_NOTIFY_INDEX
+/** \brief Index of the task notification that the semaphores operate on, when
+ *         TBX_MB_FREERTOS_SEM_NOTIFY_ENABLE is > 0. Must be smaller than the
+ *         configTASK_NOTIFICATION_ARRAY_ENTRIES setting of FreeRTOS. To override this
+ *         default configuration, you can add a macro with the same name, but a
+ *         different value, to "tbx_conf.h".
+ */
+#define TBX_MB_FREERTOS_NOTIFY_INDEX      (0U)
+#endif
+
+/** \brief Unique context type to identify a context as being a semaphore. */
+#define TBX_MB_OSAL_SEM_CONTEXT_TYPE      (76U)
+
+
+/****************************************************************************************
+* Configuration check
+****************************************************************************************/
+#if (TBX_MB_FREERTOS_SEM_NOTIFY_ENABLE > 0U)
+#if (TBX_MB_FREERTOS_NOTIFY_INDEX >= configTASK_NOTIFICATION_ARRAY_ENTRIES)
+#error "TBX_MB_FREERTOS_NOTIFY_INDEX must be < configTASK_NOTIFICATION_ARRAY_ENTRIES."
+#endif
+#endif
+
+
+#if (TBX_MB_FREERTOS_SEM_NOTIFY_ENABLE > 0U)
+/****************************************************************************************
+* Type definitions
+****************************************************************************************/
+/** \brief Data type that groups semaphore related information, when the semaphores are
+ *         built on direct to task notifications. It's what the tTbxMbOsalSem opaque
+ *         pointer points to. Only one task at a time can wait for the semaphore, which
+ *         is the case for all semaphores in the Modbus stack.
+ */
+typedef struct
+{
+  uint8_t               type;          /**< Context type.                              */
+  uint8_t      volatile count;         /**< Semaphore count. 0 = taken, 1 = available. */
+  TaskHandle_t volatile waitingTask;   /**< Task that waits for the semaphore, if any. */
+} tTbxMbOsalSemCtx;
+#endif
+
+
 /****************************************************************************************
 * Local data declarations
 ****************************************************************************************/
-/** \brief Queue handle for storing events. */
-static QueueHandle_t eventQueue;
+/** \brief Queue handles for storing events. Each event task has its own event queue. */
+static QueueHandle_t eventQueue[TBX_MB_EVENT_TASK_NUM];
 
 
 /************************************************************************************//**
@@ -61,12 +119,15 @@ void TbxMbOsalEventInit(void)
   if (osalInitialized == TBX_FALSE)
   {
     osalInitialized = TBX_TRUE;
-    /* Create the event queue. */
-    eventQueue = xQueueCreate(TBX_MB_EVENT_QUEUE_SIZE, sizeof(tTbxMbEvent));
-    /* Check that the queue creation was successful. If this assertion fails, increase
-     * the FreeRTOS heap size.
-     */
-    TBX_ASSERT(eventQueue != NULL);
+    /* Create the event queue for each event task. */
+    for (uint8_t taskIdx = 0U; taskIdx < TBX_MB_EVENT_TASK_NUM; taskIdx++)
+    {
+      eventQueue[taskIdx] = xQueueCreate(TBX_MB_EVENT_QUEUE_SIZE, sizeof(tTbxMbEvent));
+      /* Check that the queue creation was successful. If this assertion fails, increase
+       * the FreeRTOS heap size.
+       */
+      TBX_ASSERT(eventQueue[taskIdx] != NULL);
+    }
   }
 } /*** end of TbxMbOsalEventInit ***/
 
@@ -87,13 +148,17 @@ void TbxMbOsalEventPost(tTbxMbEvent const * event,
   /* Only continue with valid parameters. */
   if (event != NULL)
   {
+    /* Select the event queue of the event task that the event's context is assigned
+     * to.
+     */
+    QueueHandle_t queue = eventQueue[TbxMbEventTaskIdx(event->context)];
     /* Not calling from an ISR? */
     if (fromIsr == TBX_FALSE)
     {
       /* Add the event to the queue. There should be space in the queue so no need to
        * wait for a spot to become available in the queue.
        */
-      BaseType_t queueResult = xQueueSend(eventQueue, (void const *)event, 0U);
+      BaseType_t queueResult = xQueueSend(queue, (void const *)event, 0U);
       /* Make sure the event could be added. If not, then the event queue size is set
        * too small. In this case increase the event queue size using configuration
        * macro TBX_MB_EVENT_QUEUE_SIZE.
@@ -108,7 +173,7 @@ void TbxMbOsalEventPost(tTbxMbEvent const * event,
       /* Add the event to the queue. There should be space in the queue, so this should
        * always succeed.
        */
-      BaseType_t queueResult = xQueueSendFromISR(eventQueue, event, 
+      BaseType_t queueResult = xQueueSendFromISR(queue, event, 
                                                  &xHigherPriorityTaskWoken);
       /* Make sure the event could be added. If not, then the event queue size is set
        * too small. In this case increase the event queue size using configuration
@@ -132,24 +197,26 @@ void TbxMbOsalEventPost(tTbxMbEvent const * event,
 /************************************************************************************//**
 ** \brief     Wait for an event to occur.
 ** \param     event Pointer where the occurred event is written to.
+** \param     taskIdx Zero based index of the event task that waits for the event.
 ** \param     timeoutMs Maximum time in milliseconds to block while waiting for an
 **            event.
 ** \return    TBX_TRUE if an event occurred, TBX_FALSE otherwise (typically a timeout).
 **
 ****************************************************************************************/
 uint8_t TbxMbOsalEventWait(tTbxMbEvent * event,
+                           uint8_t       taskIdx,
                            uint16_t      timeoutMs)
 {
   uint8_t result = TBX_FALSE;
 
   /* Verify parameters. */
-  TBX_ASSERT(event != NULL);
+  TBX_ASSERT((event != NULL) && (taskIdx < TBX_MB_EVENT_TASK_NUM));
 
   /* Only continue with valid parameters. */
-  if (event != NULL)
+  if ((event != NULL) && (taskIdx < TBX_MB_EVENT_TASK_NUM))
   {
     /* Wait for a new event to arrive in the queue. */
-    if (xQueueReceive(eventQueue, event, pdMS_TO_TICKS(timeoutMs)) == pdTRUE)
+    if (xQueueReceive(eventQueue[taskIdx], event, pdMS_TO_TICKS(timeoutMs)) == pdTRUE)
     {
       result = TBX_TRUE;
     }
@@ -159,6 +226,35 @@ uint8_t TbxMbOsalEventWait(tTbxMbEvent * event,
 } /*** end of TbxMbOsalEventWait ***/
 
 
+/************************************************************************************//**
+** \brief     Pins the calling task to a processor core.
+** \param     core Zero based index of the processor core.
+**
+****************************************************************************************/
+void TbxMbOsalTaskPin(uint8_t core)
+{
+#if defined(configNUMBER_OF_CORES) && defined(configUSE_CORE_AFFINITY)
+#if (configNUMBER_OF_CORES > 1) && (configUSE_CORE_AFFINITY == 1)
+  /* Verify parameters. */
+  TBX_ASSERT(core < configNUMBER_OF_CORES);
+
+  /* Only continue with valid parameters. */
+  if (core < configNUMBER_OF_CORES)
+  {
+    /* Only allow the scheduler to run the calling task on the specified core. */
+    vTaskCoreAffinitySet(NULL, ((UBaseType_t)1U) << core);
+  }
+#else
+  /* Single core configuration or core affinity not enabled. Nothing to pin. */
+  TBX_UNUSED_ARG(core);
+#endif
+#else
+  /* FreeRTOS version without SMP support. Nothing to pin. */
+  TBX_UNUSED_ARG(core);
+#endif
+} /*** end of TbxMbOsalTaskPin ***/
+
+
 /************************************************************************************//**
 ** \brief     Creates a new binary semaphore object with an initial count of 0, meaning
 **            that it's taken.
@@ -170,12 +266,39 @@ tTbxMbOsalSem TbxMbOsalSemCreate(void)
 {
   tTbxMbOsalSem result;
 
+#if (TBX_MB_FREERTOS_SEM_NOTIFY_ENABLE > 0U)
+  result = NULL;
+  /* Allocate memory for the new semaphore context. */
+  tTbxMbOsalSemCtx * newSemCtx = TbxMemPoolAllocate(sizeof(tTbxMbOsalSemCtx));
+  /* Automatically increase the memory pool, if it was too small. */
+  if (newSemCtx == NULL)
+  {
+    /* No need to check the return value, because if it failed, the following
+     * allocation fails too, which is verified later on.
+     */
+    (void)TbxMemPoolCreate(1U, sizeof(tTbxMbOsalSemCtx));
+    newSemCtx = TbxMemPoolAllocate(sizeof(tTbxMbOsalSemCtx));      
+  }
+  /* Verify memory allocation of the semaphore context. */
+  TBX_ASSERT(newSemCtx != NULL);
+  /* Only continue if the memory allocation succeeded. */
+  if (newSemCtx != NULL)
+  {
+    /* Initialize the semaphore in a taken state. */
+    newSemCtx->type = TBX_MB_OSAL_SEM_CONTEXT_TYPE;
+    newSemCtx->count = 0U;
+    newSemCtx->waitingTask = NULL;
+    /* Update the result. */
+    result = newSemCtx;
+  }
+#else
   /* Create the binary semaphore, which is initially taken (count = 0). */
   result = xSemaphoreCreateBinary();
   /* Check that the semaphore creation was successful. If this assertion fails, increase
    * the FreeRTOS heap size.
    */
   TBX_ASSERT(result != NULL);
+#endif
   /* Give the result back to the caller. */
   return result;
 } /*** end of TbxMbOsalSemCreate ***/
@@ -195,8 +318,18 @@ void TbxMbOsalSemFree(tTbxMbOsalSem sem)
   /* Only continue with valid parameters. */
   if (sem != NULL)
   {
+#if (TBX_MB_FREERTOS_SEM_NOTIFY_ENABLE > 0U)
+    /* Convert the semaphore pointer to the context structure. */
+    tTbxMbOsalSemCtx * semCtx = (tTbxMbOsalSemCtx *)sem;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(semCtx->type == TBX_MB_OSAL_SEM_CONTEXT_TYPE);
+    /* Invalidate the context and give it back to the memory pool. */
+    semCtx->type = 0U;
+    TbxMemPoolRelease(semCtx);
+#else
     /* Delete the binary semaphore. */
     vSemaphoreDelete(sem);
+#endif
   }
 } /*** end of TbxMbOsalSemFree ***/
 
@@ -217,6 +350,47 @@ void TbxMbOsalSemGive(tTbxMbOsalSem sem,
   /* Only continue with valid parameters. */
   if (sem != NULL)
   {
+#if (TBX_MB_FREERTOS_SEM_NOTIFY_ENABLE > 0U)
+    /* Convert the semaphore pointer to the context structure. */
+    tTbxMbOsalSemCtx * semCtx = (tTbxMbOsalSemCtx *)sem;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(semCtx->type == TBX_MB_OSAL_SEM_CONTEXT_TYPE);
+    /* Give the semaphore by setting its count to 1 and determine which task, if any,
+     * waits for it.
+     */
+    TbxCriticalSectionEnter();
+    semCtx->count = 1U;
+    TaskHandle_t waitingTask = semCtx->waitingTask;
+    TbxCriticalSectionExit();
+    /* Only notify the waiting task, if there is one. Otherwise the next take operation
+     * finds the semaphore available right away.
+     */
+    if (waitingTask != NULL)
+    {
+      /* Not calling from an ISR? */
+      if (fromIsr == TBX_FALSE)
+      {
+        (void)xTaskNotifyGiveIndexed(waitingTask, TBX_MB_FREERTOS_NOTIFY_INDEX);
+      }
+      /* Calling from an ISR. */
+      else
+      {
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+        vTaskNotifyGiveIndexedFromISR(waitingTask, TBX_MB_FREERTOS_NOTIFY_INDEX,
+                                      &xHigherPriorityTaskWoken);
+        /* Request scheduler to switch to the higher priority task, if is was woken.
+         * Note that this part is FreeRTOS port specific. The following works on all
+         * Cortex-M ports. Might need to add conditional compilation switches to
+         * support other ports in the future.
+         */
+        if (xHigherPriorityTaskWoken != pdFALSE)
+        {
+          portYIELD();
+        }
+      }
+    }
+#else
     /* Not calling from an ISR? */
     if (fromIsr == TBX_FALSE)
     {
@@ -246,6 +420,7 @@ void TbxMbOsalSemGive(tTbxMbOsalSem sem,
         portYIELD();
       }
     }
+#endif
   }
 } /*** end of TbxMbOsalSemGive ***/
 
@@ -271,11 +446,66 @@ uint8_t TbxMbOsalSemTake(tTbxMbOsalSem sem,
   /* Only continue with valid parameters. */
   if (sem != NULL)
   {
+#if (TBX_MB_FREERTOS_SEM_NOTIFY_ENABLE > 0U)
+    /* Convert the semaphore pointer to the context structure. */
+    tTbxMbOsalSemCtx * semCtx = (tTbxMbOsalSemCtx *)sem;
+    TickType_t         ticksToWait = pdMS_TO_TICKS(timeoutMs);
+    uint8_t            waitDone = TBX_FALSE;
+    TimeOut_t          timeOut;
+
+    /* Sanity check on the context type. */
+    TBX_ASSERT(semCtx->type == TBX_MB_OSAL_SEM_CONTEXT_TYPE);
+    /* Start the timeout time measurement. */
+    vTaskSetTimeOutState(&timeOut);
+    /* Enter wait loop. Note that a task notification does not guarantee that the
+     * semaphore is available. It could be a late notification from a give operation,
+     * for which the previous take operation already timed out. That's why the loop
+     * always checks the semaphore count.
+     */
+    while (waitDone == TBX_FALSE)
+    {
+      /* Is the semaphore currently available? */
+      TbxCriticalSectionEnter();
+      if (semCtx->count > 0U)
+      {
+        /* Take the semaphore and update the result for success. */
+        semCtx->count = 0U;
+        semCtx->waitingTask = NULL;
+        result = TBX_TRUE;
+        waitDone = TBX_TRUE;
+      }
+      /* Register this task as the one that waits for the semaphore. */
+      else
+      {
+        semCtx->waitingTask = xTaskGetCurrentTaskHandle();
+      }
+      TbxCriticalSectionExit();
+      /* Semaphore not yet available? */
+      if (waitDone == TBX_FALSE)
+      {
+        /* Wait for the task notification, if the timeout did not yet expire. */
+        if (xTaskCheckForTimeOut(&timeOut, &ticksToWait) == pdFALSE)
+        {
+          (void)ulTaskNotifyTakeIndexed(TBX_MB_FREERTOS_NOTIFY_INDEX, pdTRUE,
+                                        ticksToWait);
+        }
+        /* Timeout expired, so stop waiting. */
+        else
+        {
+          TbxCriticalSectionEnter();
+          semCtx->waitingTask = NULL;
+          TbxCriticalSectionExit();
+          waitDone = TBX_TRUE;
+        }
+      }
+    }
+#else
     /* Wait for the semaphore to become available. */
     if (xSemaphoreTake(sem, pdMS_TO_TICKS(timeoutMs)) == pdTRUE)
     {
       result = TBX_TRUE;
     }
+#endif
   }
   /* Give the result back to the caller. */
   return result;
@@ -40,10 +40,36 @@
 /****************************************************************************************
 * Macro definitions
 ****************************************************************************************/
+#ifndef TBX_MB_SUPERLOOP_LOCK_FREE_ENABLE
+/** \brief By default, the event queue is protected with a critical section. This makes
+ *         it safe to post events from any interrupt, but it also briefly disables the
+ *         interrupts each time an event is posted or retrieved. When this configuration
+ *         macro is > 0, events posted from an interrupt and events posted from the
+ *         superloop are stored in separate queues. Each queue then has just one producer
+ *         and one consumer (the event task), such that no critical section is needed.
+ *         Only enable this if the interrupts that post Modbus events, such as the UART
+ *         interrupts, cannot interrupt each other. For example because they are all
+ *         configured with the same interrupt priority. It also assumes that the CPU
+ *         reads and writes a 16-bit value in one go, as is the case on 16-bit and 32-bit
+ *         single core microcontrollers. To override this default configuration, you can
+ *         add a macro with the same name, but with a value of 1 (enable), to
+ *         "tbx_conf.h".
+ */
+#define TBX_MB_SUPERLOOP_LOCK_FREE_ENABLE (0U)
+#endif
+
 /** \brief Unique context type to identify a context as being a semaphore. */
 #define TBX_MB_OSAL_SEM_CONTEXT_TYPE   (76U)
 
 
+/****************************************************************************************
+* Configuration check
+****************************************************************************************/
+#if (TBX_MB_EVENT_TASK_NUM != 1U)
+#error "The superloop OSAL supports just one event task. Set TBX_MB_EVENT_TASK_NUM to 1."
+#endif
+
+
 /****************************************************************************************
 * Type definitions
 ****************************************************************************************/
@@ -57,17 +83,41 @@ typedef struct
 } tTbxMbOsalSemCtx;
 
 
+/** \brief Ring buffer based First-In-First-Out (FIFO) queue for storing events. It holds
+ *         one more entry than the configured event queue size. This one is always kept
+ *         free, to distinguish between a full and an empty queue without a separate
+ *         count. Only the producer writes writeIdx and only the consumer writes readIdx.
+ */
+typedef struct 
+{
+  tTbxMbEvent entries[TBX_MB_EVENT_QUEUE_SIZE + 1U]; /**< Preallocated event storage.  */
+  uint16_t    readIdx;                               /**< Read index into entries[].   */
+  uint16_t    writeIdx;                              /**< Write index into entries[].  */
+} tTbxMbOsalEventQueue;
+
+
+/****************************************************************************************
+* Function prototypes
+****************************************************************************************/
+static uint8_t TbxMbOsalEventQueueStore   (tTbxMbOsalEventQueue volatile * queue,
+                                           tTbxMbEvent          const    * event);
+
+static uint8_t TbxMbOsalEventQueueRetrieve(tTbxMbOsalEventQueue volatile * queue,
+                                           tTbxMbEvent                   * event);
+
+
 /****************************************************************************************
 * Local data declarations
 ****************************************************************************************/
-/** \brief Ring buffer based First-In-First-Out (FIFO) queue for storing events. */
-static struct 
-{
-  tTbxMbEvent entries[TBX_MB_EVENT_QUEUE_SIZE];       /**< Preallocated event storage. */
-  uint16_t    count;                                  /**< Number of stored entries.   */
-  uint16_t    readIdx;                                /**< Read index into entries[].  */
-  uint16_t    writeIdx;                               /**< Write index into entries[]. */
-} eventQueue;
+/** \brief Queue for storing events. When TBX_MB_SUPERLOOP_LOCK_FREE_ENABLE is > 0, it
+ *         only holds the events that were posted from the superloop.
+ */
+static volatile tTbxMbOsalEventQueue eventQueue;
+
+#if (TBX_MB_SUPERLOOP_LOCK_FREE_ENABLE > 0U)
+/** \brief Queue for storing the events that were posted from an interrupt. */
+static volatile tTbxMbOsalEventQueue isrEventQueue;
+#endif
 
 
 /************************************************************************************//**
@@ -84,9 +134,12 @@ void TbxMbOsalEventInit(void)
   {
     osalInitialized = TBX_TRUE;
     /* Initialize the queue. */
-    eventQueue.count = 0U;
     eventQueue.readIdx = 0U;
     eventQueue.writeIdx = 0U;
+    #if (TBX_MB_SUPERLOOP_LOCK_FREE_ENABLE > 0U)
+    isrEventQueue.readIdx = 0U;
+    isrEventQueue.writeIdx = 0U;
+    #endif
   }
 } /*** end of TbxMbOsalEventInit ***/
 
@@ -101,7 +154,7 @@ void TbxMbOsalEventInit(void)
 void TbxMbOsalEventPost(tTbxMbEvent const * event, 
                         uint8_t             fromIsr)
 {
-  TBX_UNUSED_ARG(fromIsr);
+  uint8_t stored;
 
   /* Verify parameters. */
   TBX_ASSERT(event != NULL);
@@ -109,29 +162,29 @@ void TbxMbOsalEventPost(tTbxMbEvent const * event,
   /* Only continue with valid parameters. */
   if (event != NULL)
   {
-    TbxCriticalSectionEnter();
-    /* Make sure there is still space in the queue. If not, then the event queue size is
-     * set too small. In this case increase the event queue size using configuration
-     * macro TBX_MB_EVENT_QUEUE_SIZE.
+    #if (TBX_MB_SUPERLOOP_LOCK_FREE_ENABLE > 0U)
+    /* Store the event in the queue that belongs to the caller. There is just one 
+     * producer per queue, so no critical section is needed.
      */
-    TBX_ASSERT(eventQueue.count < TBX_MB_EVENT_QUEUE_SIZE);
-
-    /* Only continue with enough space. */
-    if (eventQueue.count < TBX_MB_EVENT_QUEUE_SIZE)
+    if (fromIsr == TBX_TRUE)
     {
-      /* Store the new event in the queue at the current write index. */
-      eventQueue.entries[eventQueue.writeIdx] = *event;
-      /* Update the total count. */
-      eventQueue.count++;
-      /* Increment the write index to point to the next entry. */
-      eventQueue.writeIdx++;
-      /* Time to wrap around to the start? */
-      if (eventQueue.writeIdx == TBX_MB_EVENT_QUEUE_SIZE)
-      {
-        eventQueue.writeIdx = 0U;
-      }
+      stored = TbxMbOsalEventQueueStore(&isrEventQueue, event);
+    }
+    else
+    {
+      stored = TbxMbOsalEventQueueStore(&eventQueue, event);
     }
+    #else
+    TBX_UNUSED_ARG(fromIsr);
+    TbxCriticalSectionEnter();
+    stored = TbxMbOsalEventQueueStore(&eventQueue, event);
     TbxCriticalSectionExit();
+    #endif
+    /* Make sure there was still space in the queue. If not, then the event queue size
+     * is set too small. In this case increase the event queue size using configuration
+     * macro TBX_MB_EVENT_QUEUE_SIZE.
+     */
+    TBX_ASSERT(stored == TBX_TRUE);
   }
 } /*** end of TbxMbOsalEventPost ***/
 
@@ -139,16 +192,19 @@ void TbxMbOsalEventPost(tTbxMbEvent const * event,
 /************************************************************************************//**
 ** \brief     Wait for an event to occur.
 ** \param     event Pointer where the occurred event is written to.
+** \param     taskIdx Zero based index of the event task that waits for the event.
 ** \param     timeoutMs Maximum time in milliseconds to block while waiting for an
 **            event.
 ** \return    TBX_TRUE if an event occurred, TBX_FALSE otherwise (typically a timeout).
 **
 ****************************************************************************************/
 uint8_t TbxMbOsalEventWait(tTbxMbEvent * event,
+                           uint8_t       taskIdx,
                            uint16_t      timeoutMs)
 {
   uint8_t result = TBX_FALSE;
 
+  TBX_UNUSED_ARG(taskIdx);
   TBX_UNUSED_ARG(timeoutMs);
 
   /* Verify parameters. */
@@ -157,31 +213,113 @@ uint8_t TbxMbOsalEventWait(tTbxMbEvent * event,
   /* Only continue with valid parameters. */
   if (event != NULL)
   {
-    TbxCriticalSectionEnter();
-    /* Is there an event available in the queue? */
-    if (eventQueue.count > 0U)
+    #if (TBX_MB_SUPERLOOP_LOCK_FREE_ENABLE > 0U)
+    /* Retrieve the events posted from an interrupt first. This makes sure that an 
+     * interrupt's request to start polling, is always processed before the superloop's
+     * request to stop polling that follows it.
+     */
+    result = TbxMbOsalEventQueueRetrieve(&isrEventQueue, event);
+    if (result == TBX_FALSE)
     {
-      /* Retrieve the event from the queue at the read index (oldest).  */
-      *event = eventQueue.entries[eventQueue.readIdx];
-      /* Update the total count. */
-      eventQueue.count--;
-      /* Increment the read index to point to the next entry. */
-      eventQueue.readIdx++;
-      /* Time to wrap around to the start? */
-      if (eventQueue.readIdx == TBX_MB_EVENT_QUEUE_SIZE)
-      {
-        eventQueue.readIdx = 0U;
-      }
-      /* Update the result. */
-      result = TBX_TRUE;
+      result = TbxMbOsalEventQueueRetrieve(&eventQueue, event);
     }
+    #else
+    TbxCriticalSectionEnter();
+    result = TbxMbOsalEventQueueRetrieve(&eventQueue, event);
     TbxCriticalSectionExit();
+    #endif
   }
   /* Give the result back to the caller. */
   return result;
 } /*** end of TbxMbOsalEventWait ***/
 
 
+/************************************************************************************//**
+** \brief     Stores an event in the queue, if there is still space.
+** \details   The event is written before the write index is updated. This way a
+**            consumer that interrupts the producer, never reads an incomplete event.
+** \param     queue Pointer to the queue.
+** \param     event Pointer to the event to store.
+** \return    TBX_TRUE if the event was stored, TBX_FALSE if the queue was full.
+**
+****************************************************************************************/
+static uint8_t TbxMbOsalEventQueueStore(tTbxMbOsalEventQueue volatile * queue,
+                                        tTbxMbEvent          const    * event)
+{
+  uint8_t  result = TBX_FALSE;
+  uint16_t writeIdx = queue->writeIdx;
+  uint16_t nextIdx = writeIdx + 1U;
+
+  /* Time to wrap around to the start? */
+  if (nextIdx > TBX_MB_EVENT_QUEUE_SIZE)
+  {
+    nextIdx = 0U;
+  }
+  /* Only continue with enough space. */
+  if (nextIdx != queue->readIdx)
+  {
+    /* Store the new event in the queue at the current write index. */
+    queue->entries[writeIdx] = *event;
+    /* Publish the event by updating the write index to point to the next entry. */
+    queue->writeIdx = nextIdx;
+    /* Update the result. */
+    result = TBX_TRUE;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbOsalEventQueueStore ***/
+
+
+/************************************************************************************//**
+** \brief     Retrieves the oldest event from the queue, if one is available.
+** \details   The event is read before the read index is updated. This way a producer
+**            that interrupts the consumer, never overwrites an event that is still
+**            being read.
+** \param     queue Pointer to the queue.
+** \param     event Pointer where the retrieved event is written to.
+** \return    TBX_TRUE if an event was retrieved, TBX_FALSE if the queue was empty.
+**
+****************************************************************************************/
+static uint8_t TbxMbOsalEventQueueRetrieve(tTbxMbOsalEventQueue volatile * queue,
+                                           tTbxMbEvent                   * event)
+{
+  uint8_t  result = TBX_FALSE;
+  uint16_t readIdx = queue->readIdx;
+
+  /* Is there an event available in the queue? */
+  if (readIdx != queue->writeIdx)
+  {
+    /* Retrieve the event from the queue at the read index (oldest). */
+    *event = queue->entries[readIdx];
+    /* Increment the read index to point to the next entry. */
+    readIdx++;
+    /* Time to wrap around to the start? */
+    if (readIdx > TBX_MB_EVENT_QUEUE_SIZE)
+    {
+      readIdx = 0U;
+    }
+    /* Release the entry by updating the read index. */
+    queue->readIdx = readIdx;
+    /* Update the result. */
+    result = TBX_TRUE;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbOsalEventQueueRetrieve ***/
+
+
+/************************************************************************************//**
+** \brief     Pins the calling task to a processor core.
+** \param     core Zero based index of the processor core.
+**
+****************************************************************************************/
+void TbxMbOsalTaskPin(uint8_t core)
+{
+  /* A superloop application has just one task, so there is nothing to pin. */
+  TBX_UNUSED_ARG(core);
+} /*** end of TbxMbOsalTaskPin ***/
+
+
 /************************************************************************************//**
 ** \brief     Creates a new binary semaphore object with an initial count of 0, meaning
 **            that it's taken.
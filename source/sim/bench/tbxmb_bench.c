@@ -0,0 +1,494 @@
+/************************************************************************************//**
+* \file         tbxmb_bench.c
+* \brief        Modbus benchmark program for the host simulation port.
+* \internal
+*----------------------------------------------------------------------------------------
+*                          C O P Y R I G H T
+*----------------------------------------------------------------------------------------
+*   Copyright (c) 2023 by Feaser     www.feaser.com     All rights reserved
+*
+*----------------------------------------------------------------------------------------
+*                            L I C E N S E
+*----------------------------------------------------------------------------------------
+*
+* SPDX-License-Identifier: MIT
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* \endinternal
+****************************************************************************************/
+
+/****************************************************************************************
+* Include files
+****************************************************************************************/
+/* Needed for clock_gettime(), which is not part of the C99 standard library. */
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>                               /* Standard I/O functions             */
+#include <time.h>                                /* Time functions                     */
+#include "microtbx.h"                            /* MicroTBX library                   */
+#include "microtbxmodbus.h"                      /* MicroTBX-Modbus library            */
+#include "tbxmb_event_private.h"                 /* MicroTBX-Modbus event private      */
+#include "tbxmb_osal_private.h"                  /* MicroTBX-Modbus OSAL private       */
+#include "tbxmb_tp_private.h"                    /* MicroTBX-Modbus TP private         */
+#include "tbxmb_sim.h"                           /* MicroTBX-Modbus host simulation    */
+#if (TBX_MB_BENCH_FREERTOS > 0U)
+#include "FreeRTOS.h"                            /* FreeRTOS                           */
+#include "task.h"                                /* FreeRTOS tasks                     */
+#endif
+
+
+/****************************************************************************************
+* Macro definitions
+****************************************************************************************/
+#ifndef TBX_MB_BENCH_FREERTOS
+/** \brief Configure the OSAL that the benchmark runs on. Set it to 0 for the superloop
+ *         OSAL and to 1 for the FreeRTOS OSAL, for example with the FreeRTOS POSIX
+ *         port. The CMake benchmark targets set it automatically.
+ */
+#define TBX_MB_BENCH_FREERTOS          (0U)
+#endif
+
+#ifndef TBX_MB_BENCH_REQUESTS
+/** \brief Configure the number of requests that the client sends, for each of the
+ *         server throughput and client round-trip measurements. With FreeRTOS, the
+ *         event task blocks for up to one RTOS tick between its runs, while it waits
+ *         for the simulated serial ports. Each run only advances the simulated time by
+ *         TBX_MB_SIM_STEP_US, so a request takes much longer on the host. That's why
+ *         fewer requests are sent in this case.
+ */
+#if (TBX_MB_BENCH_FREERTOS > 0U)
+#define TBX_MB_BENCH_REQUESTS          (20U)
+#else
+#define TBX_MB_BENCH_REQUESTS          (200U)
+#endif
+#endif
+
+#ifndef TBX_MB_BENCH_CRC_LOOPS
+/** \brief Configure the number of times that the CRC16 checksum is calculated over a
+ *         maximum sized RTU packet, for the CRC throughput measurement.
+ */
+#define TBX_MB_BENCH_CRC_LOOPS         (20000U)
+#endif
+
+#ifndef TBX_MB_BENCH_EVENTS
+/** \brief Configure the number of events to post and process, for the event queue
+ *         overhead measurement.
+ */
+#define TBX_MB_BENCH_EVENTS            (100000U)
+#endif
+
+/** \brief Response timeout of the client in milliseconds. Generous, because with
+ *         FreeRTOS the timeout runs in host time, instead of in simulated time.
+ */
+#define TBX_MB_BENCH_TIMEOUT_MS        (5000U)
+
+/** \brief Node address of the server. */
+#define TBX_MB_BENCH_NODE_ADDR         (10U)
+
+/** \brief Number of holding registers in the data table of the server. */
+#define TBX_MB_BENCH_NUM_REGS          (125U)
+
+/** \brief Number of events to post at once, for the event queue overhead measurement.
+ *         Leaves room in the queue for the events of the simulated serial ports.
+ */
+#define TBX_MB_BENCH_EVENT_BATCH       (TBX_MB_EVENT_QUEUE_SIZE / 2U)
+
+#if (TBX_MB_BENCH_FREERTOS > 0U)
+/** \brief Stack size of the FreeRTOS tasks in words. */
+#define TBX_MB_BENCH_TASK_STACK        (configMINIMAL_STACK_SIZE * 8U)
+#endif
+
+
+/****************************************************************************************
+* Type definitions
+****************************************************************************************/
+/** \brief Event context for measuring the event queue overhead. */
+typedef struct
+{
+  /* Event interface methods. The following four entries must always be at the start
+   * and exactly match those in tTbxMbEventCtx. Think of it as the base that this struct
+   * derives from.
+   */
+  void               * instancePtr;              /**< Reserved for C++ wrapper.        */
+  void              (* pollFcn)(void * context); /**< Event poll function.             */
+  void              (* processFcn)(tTbxMbEvent * event); /**< Event process function.  */
+  tTbxMbEventPoller    pollInfo;                 /**< Event poller information.        */
+  /* Private members. */
+  uint32_t volatile    processed;                /**< Number of processed events.      */
+} tTbxMbBenchCtx;
+
+
+/****************************************************************************************
+* Function prototypes
+****************************************************************************************/
+static uint8_t  TbxMbBenchRun(void);
+
+static void     TbxMbBenchCrc(void);
+
+static void     TbxMbBenchEvents(void);
+
+static uint8_t  TbxMbBenchServer(tTbxMbClient client);
+
+static uint8_t  TbxMbBenchRoundTrip(tTbxMbClient client);
+
+static void     TbxMbBenchProcessEvent(tTbxMbEvent * event);
+
+static double   TbxMbBenchHostTimeUs(void);
+
+#if (TBX_MB_BENCH_FREERTOS > 0U)
+static void     TbxMbBenchEventTask(void * pvParameters);
+
+static void     TbxMbBenchMainTask(void * pvParameters);
+#endif
+
+
+/****************************************************************************************
+* Local data declarations
+****************************************************************************************/
+/** \brief Data table with the holding registers of the server. */
+static uint16_t benchHoldingRegs[TBX_MB_BENCH_NUM_REGS];
+
+/** \brief Event context for measuring the event queue overhead. */
+static tTbxMbBenchCtx benchEventCtx;
+
+/** \brief Overall benchmark result. */
+static uint8_t benchResult = TBX_ERROR;
+
+
+/************************************************************************************//**
+** \brief     This is the entry point for the benchmark program.
+** \return    Program exit code. 0 if all measurements completed, 1 otherwise.
+**
+****************************************************************************************/
+int main(void)
+{
+#if (TBX_MB_BENCH_FREERTOS > 0U)
+  /* Create the task that runs the MicroTBX-Modbus event task. It gets the higher
+   * priority, just like it typically would in firmware.
+   */
+  (void)xTaskCreate(TbxMbBenchEventTask, "MbEvent", TBX_MB_BENCH_TASK_STACK, NULL,
+                    tskIDLE_PRIORITY + 2U, NULL);
+  /* Create the task that runs the measurements. */
+  (void)xTaskCreate(TbxMbBenchMainTask, "MbBench", TBX_MB_BENCH_TASK_STACK, NULL,
+                    tskIDLE_PRIORITY + 1U, NULL);
+  /* Start the scheduler. It returns after the measurements ended the scheduler. */
+  vTaskStartScheduler();
+#else
+  /* Run the measurements. Blocking client functions run the event task themselves. */
+  benchResult = TbxMbBenchRun();
+#endif
+  /* Give the result back to the caller. */
+  return (benchResult == TBX_OK) ? 0 : 1;
+} /*** end of main ***/
+
+
+/************************************************************************************//**
+** \brief     Runs all the measurements and prints their results.
+** \return    TBX_OK if all measurements completed, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbBenchRun(void)
+{
+  uint8_t      result = TBX_ERROR;
+  tTbxMbTp     serverTp;
+  tTbxMbTp     clientTp;
+  tTbxMbServer server;
+  tTbxMbClient client;
+
+#if (TBX_MB_BENCH_FREERTOS > 0U)
+  printf("MicroTBX-Modbus benchmark (FreeRTOS OSAL)\n");
+#else
+  printf("MicroTBX-Modbus benchmark (superloop OSAL)\n");
+#endif
+  /* Measurements that don't need a channel. */
+  TbxMbBenchCrc();
+  TbxMbBenchEvents();
+  /* Create a server and a client that communicate over simulated serial ports 1 and
+   * 2, which are connected with a virtual null modem cable.
+   */
+  serverTp = TbxMbRtuCreate(TBX_MB_BENCH_NODE_ADDR, TBX_MB_UART_PORT1,
+                            TBX_MB_UART_115200BPS, TBX_MB_UART_1_STOPBITS,
+                            TBX_MB_EVEN_PARITY);
+  clientTp = TbxMbRtuCreate(0U, TBX_MB_UART_PORT2, TBX_MB_UART_115200BPS,
+                            TBX_MB_UART_1_STOPBITS, TBX_MB_EVEN_PARITY);
+  server = TbxMbServerCreate(serverTp);
+  client = TbxMbClientCreate(clientTp, TBX_MB_BENCH_TIMEOUT_MS, 100U);
+  /* Only continue if all objects could be created. */
+  if ((serverTp != NULL) && (clientTp != NULL) && (server != NULL) && (client != NULL))
+  {
+    TbxMbServerSetTableHoldingRegs(server, 0U, TBX_MB_BENCH_NUM_REGS, benchHoldingRegs);
+    /* Measurements that need a server and a client. */
+    if ((TbxMbBenchServer(client) == TBX_OK) && (TbxMbBenchRoundTrip(client) == TBX_OK))
+    {
+      result = TBX_OK;
+    }
+  }
+  /* Release the objects. */
+  if (client != NULL)
+  {
+    TbxMbClientFree(client);
+  }
+  if (server != NULL)
+  {
+    TbxMbServerFree(server);
+  }
+  if (clientTp != NULL)
+  {
+    TbxMbRtuFree(clientTp);
+  }
+  if (serverTp != NULL)
+  {
+    TbxMbRtuFree(serverTp);
+  }
+  printf("%s\n", (result == TBX_OK) ? "Benchmark completed" : "Benchmark FAILED");
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbBenchRun ***/
+
+
+/************************************************************************************//**
+** \brief     Measures the throughput of the CRC16 checksum calculation of the RTU
+**            transport layer, with the configured TBX_MB_RTU_CRC_METHOD.
+**
+****************************************************************************************/
+static void TbxMbBenchCrc(void)
+{
+  static uint8_t     data[TBX_MB_TP_ADU_MAX_LEN];
+  uint16_t volatile  crc = 0U;
+  double             startUs;
+  double             elapsedUs;
+
+  /* Fill the packet with some data. */
+  for (uint16_t idx = 0U; idx < TBX_MB_TP_ADU_MAX_LEN; idx++)
+  {
+    data[idx] = (uint8_t)(idx * 7U);
+  }
+  startUs = TbxMbBenchHostTimeUs();
+  for (uint32_t loop = 0U; loop < TBX_MB_BENCH_CRC_LOOPS; loop++)
+  {
+    /* The initial value of the RTU CRC16 checksum is 0xFFFF. */
+    crc = TbxMbRtuCrcUpdate(0xFFFFU, data, TBX_MB_TP_ADU_MAX_LEN);
+  }
+  elapsedUs = TbxMbBenchHostTimeUs() - startUs;
+  (void)crc;
+  printf("CRC throughput:          %10.2f MB/s\n",
+         ((double)TBX_MB_BENCH_CRC_LOOPS * TBX_MB_TP_ADU_MAX_LEN) / elapsedUs);
+} /*** end of TbxMbBenchCrc ***/
+
+
+/************************************************************************************//**
+** \brief     Measures the overhead of posting an event and having the event task
+**            process it.
+**
+****************************************************************************************/
+static void TbxMbBenchEvents(void)
+{
+  tTbxMbEvent event;
+  uint32_t    posted = 0U;
+  double      startUs;
+  double      elapsedUs;
+
+  /* The event task dispatches the events to the process function of the context. Its
+   * zero initialized poller information assigns it to the first event task.
+   */
+  benchEventCtx.processFcn = TbxMbBenchProcessEvent;
+  event.id = TBX_MB_EVENT_ID_PDU_RECEIVED;
+  event.context = &benchEventCtx;
+  startUs = TbxMbBenchHostTimeUs();
+  while (posted < TBX_MB_BENCH_EVENTS)
+  {
+    /* Post a batch of events. */
+    for (uint8_t idx = 0U; idx < TBX_MB_BENCH_EVENT_BATCH; idx++)
+    {
+      TbxMbOsalEventPost(&event, TBX_FALSE);
+    }
+    posted += TBX_MB_BENCH_EVENT_BATCH;
+    /* Wait for the event task to process them. */
+    while (benchEventCtx.processed < posted)
+    {
+#if (TBX_MB_BENCH_FREERTOS > 0U)
+      vTaskDelay(1U);
+#else
+      TbxMbEventTask();
+#endif
+    }
+  }
+  elapsedUs = TbxMbBenchHostTimeUs() - startUs;
+  printf("Event queue overhead:    %10.3f us/event\n", elapsedUs / (double)posted);
+} /*** end of TbxMbBenchEvents ***/
+
+
+/************************************************************************************//**
+** \brief     Measures the server request throughput, with requests that read the
+**            maximum number of holding registers from the data table.
+** \param     client Handle to the client channel that sends the requests.
+** \return    TBX_OK if all requests succeeded, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbBenchServer(tTbxMbClient client)
+{
+  uint8_t  result = TBX_OK;
+  uint16_t regs[TBX_MB_BENCH_NUM_REGS];
+  uint64_t startSimUs;
+  double   startUs;
+  double   elapsedUs;
+  uint64_t elapsedSimUs;
+
+  startSimUs = TbxMbSimTimeUs();
+  startUs = TbxMbBenchHostTimeUs();
+  for (uint32_t idx = 0U; idx < TBX_MB_BENCH_REQUESTS; idx++)
+  {
+    if (TbxMbClientReadHoldingRegs(client, TBX_MB_BENCH_NODE_ADDR, 0U,
+                                   TBX_MB_BENCH_NUM_REGS, regs) != TBX_OK)
+    {
+      result = TBX_ERROR;
+      break;
+    }
+  }
+  elapsedUs = TbxMbBenchHostTimeUs() - startUs;
+  elapsedSimUs = TbxMbSimTimeUs() - startSimUs;
+  if (result == TBX_OK)
+  {
+    printf("Server throughput:       %10.1f requests/s on the bus, "
+           "%.2f us host time per request\n",
+           ((double)TBX_MB_BENCH_REQUESTS * 1000000.0) / (double)elapsedSimUs,
+           elapsedUs / (double)TBX_MB_BENCH_REQUESTS);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbBenchServer ***/
+
+
+/************************************************************************************//**
+** \brief     Measures the round-trip latency of client requests that read a single
+**            holding register.
+** \param     client Handle to the client channel that sends the requests.
+** \return    TBX_OK if all requests succeeded, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbBenchRoundTrip(tTbxMbClient client)
+{
+  uint8_t  result = TBX_OK;
+  uint16_t reg;
+  uint64_t minSimUs = UINT64_MAX;
+  uint64_t maxSimUs = 0U;
+  uint64_t totalSimUs = 0U;
+  double   startUs;
+  double   elapsedUs;
+
+  startUs = TbxMbBenchHostTimeUs();
+  for (uint32_t idx = 0U; idx < TBX_MB_BENCH_REQUESTS; idx++)
+  {
+    uint64_t startSimUs = TbxMbSimTimeUs();
+    uint64_t deltaSimUs;
+
+    if (TbxMbClientReadHoldingRegs(client, TBX_MB_BENCH_NODE_ADDR, 0U, 1U,
+                                   &reg) != TBX_OK)
+    {
+      result = TBX_ERROR;
+      break;
+    }
+    /* Update the statistics. */
+    deltaSimUs = TbxMbSimTimeUs() - startSimUs;
+    totalSimUs += deltaSimUs;
+    minSimUs = (deltaSimUs < minSimUs) ? deltaSimUs : minSimUs;
+    maxSimUs = (deltaSimUs > maxSimUs) ? deltaSimUs : maxSimUs;
+  }
+  elapsedUs = TbxMbBenchHostTimeUs() - startUs;
+  if (result == TBX_OK)
+  {
+    printf("Client round-trip:       %10.1f us avg (min %llu, max %llu) on the bus, "
+           "%.2f us host time per request\n",
+           (double)totalSimUs / (double)TBX_MB_BENCH_REQUESTS,
+           (unsigned long long)minSimUs, (unsigned long long)maxSimUs,
+           elapsedUs / (double)TBX_MB_BENCH_REQUESTS);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbBenchRoundTrip ***/
+
+
+/************************************************************************************//**
+** \brief     Event processing function of the event queue overhead measurement.
+** \param     event Pointer to the event to process.
+**
+****************************************************************************************/
+static void TbxMbBenchProcessEvent(tTbxMbEvent * event)
+{
+  TBX_UNUSED_ARG(event);
+  /* Count the processed event. */
+  benchEventCtx.processed++;
+} /*** end of TbxMbBenchProcessEvent ***/
+
+
+/************************************************************************************//**
+** \brief     Obtains the time of the host in microseconds.
+** \return    Host time in microseconds.
+**
+****************************************************************************************/
+static double TbxMbBenchHostTimeUs(void)
+{
+  struct timespec now;
+
+  (void)clock_gettime(CLOCK_MONOTONIC, &now);
+  /* Give the result back to the caller. */
+  return ((double)now.tv_sec * 1000000.0) + ((double)now.tv_nsec / 1000.0);
+} /*** end of TbxMbBenchHostTimeUs ***/
+
+
+#if (TBX_MB_BENCH_FREERTOS > 0U)
+/************************************************************************************//**
+** \brief     FreeRTOS task that runs the MicroTBX-Modbus event task.
+** \param     pvParameters Pointer to optional task parameters.
+**
+****************************************************************************************/
+static void TbxMbBenchEventTask(void * pvParameters)
+{
+  TBX_UNUSED_ARG(pvParameters);
+  /* Enter infinite task loop. */
+  for (;;)
+  {
+    /* The FreeRTOS OSAL blocks this task, while no events are pending. */
+    TbxMbEventTask();
+  }
+} /*** end of TbxMbBenchEventTask ***/
+
+
+/************************************************************************************//**
+** \brief     FreeRTOS task that runs the measurements and ends the scheduler afterwards.
+** \param     pvParameters Pointer to optional task parameters.
+**
+****************************************************************************************/
+static void TbxMbBenchMainTask(void * pvParameters)
+{
+  TBX_UNUSED_ARG(pvParameters);
+  /* Run the measurements. */
+  benchResult = TbxMbBenchRun();
+  /* Return from vTaskStartScheduler() in main(). */
+  vTaskEndScheduler();
+  /* Should not get here, but a FreeRTOS task must never return. */
+  for (;;)
+  {
+    vTaskDelay(1000U);
+  }
+} /*** end of TbxMbBenchMainTask ***/
+#endif
+
+
+/*********************************** end of tbxmb_bench.c ******************************/
@@ -0,0 +1,719 @@
+/************************************************************************************//**
+* \file         tbxmb_port.c
+* \brief        Modbus host simulation port source file.
+* \internal
+*----------------------------------------------------------------------------------------
+*                          C O P Y R I G H T
+*----------------------------------------------------------------------------------------
+*   Copyright (c) 2023 by Feaser     www.feaser.com     All rights reserved
+*
+*----------------------------------------------------------------------------------------
+*                            L I C E N S E
+*----------------------------------------------------------------------------------------
+*
+* SPDX-License-Identifier: MIT
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* \endinternal
+****************************************************************************************/
+
+/****************************************************************************************
+* Include files
+****************************************************************************************/
+#include "microtbx.h"                            /* MicroTBX library                   */
+#include "microtbxmodbus.h"                      /* MicroTBX-Modbus library            */
+#include "tbxmb_event_private.h"                 /* MicroTBX-Modbus event private      */
+#include "tbxmb_osal_private.h"                  /* MicroTBX-Modbus OSAL private       */
+#include "tbxmb_uart_private.h"                  /* MicroTBX-Modbus UART private       */
+#include "tbxmb_sim.h"                           /* MicroTBX-Modbus host simulation    */
+
+
+/****************************************************************************************
+* Macro definitions
+****************************************************************************************/
+#ifndef TBX_MB_SIM_STEP_US
+/** \brief Configure the number of microseconds that the simulated time automatically
+ *         advances with, each time TbxMbEventTask() runs. This way the simulated time
+ *         also advances while a blocking client function waits for its response. Set
+ *         it to 0 to only advance the simulated time with TbxMbSimAdvance(). To override
+ *         this default configuration, you can add a macro with the same name, but with
+ *         a different value, to "tbx_conf.h".
+ */
+#define TBX_MB_SIM_STEP_US             (50U)
+#endif
+
+/** \brief Number of microseconds per tick of the 20 kHz free running counter. */
+#define TBX_MB_SIM_TICK_US             (50U)
+
+/** \brief Simulated event of a serial port: the transmission of a byte completed. */
+#define TBX_MB_SIM_EVENT_TX            (0U)
+
+/** \brief Simulated event of a serial port: idle line detected after a reception. */
+#define TBX_MB_SIM_EVENT_IDLE          (1U)
+
+/** \brief Simulated event of a serial port: the one-shot timer expired. */
+#define TBX_MB_SIM_EVENT_TIMER         (2U)
+
+/** \brief Number of simulated events per serial port. */
+#define TBX_MB_SIM_NUM_EVENT           (3U)
+
+
+/****************************************************************************************
+* Type definitions
+****************************************************************************************/
+/** \brief Data type for grouping together the information of a simulated serial port. */
+typedef struct
+{
+  uint8_t          initialized;          /**< Port initialized flag.                   */
+  uint32_t         charUs;               /**< Time to transfer one character (us).     */
+  uint8_t  const * txData;               /**< Pointer of the transmit data byte array. */
+  uint16_t         txIdx;                /**< Index of the byte being transmitted.     */
+  uint16_t         txLen;                /**< Total number of bytes to transmit.       */
+  uint32_t         txBytes;              /**< Total number of transmitted bytes.       */
+  uint8_t        * rxData;               /**< Pointer of the reception byte array.     */
+  uint16_t         rxIdx;                /**< Number of bytes received so far.         */
+  uint16_t         rxLen;                /**< Size of the reception byte array.        */
+  uint8_t          pending[TBX_MB_SIM_NUM_EVENT]; /**< Event pending flags.            */
+  uint64_t         dueUs[TBX_MB_SIM_NUM_EVENT];   /**< Event due times (us).           */
+} tTbxMbSimPort;
+
+
+/** \brief Simulation context for automatically advancing the simulated time from the
+ *         event task.
+ */
+typedef struct
+{
+  /* Event interface methods. The following four entries must always be at the start
+   * and exactly match those in tTbxMbEventCtx. Think of it as the base that this struct
+   * derives from.
+   */
+  void               * instancePtr;              /**< Reserved for C++ wrapper.        */
+  void              (* pollFcn)(void * context); /**< Event poll function.             */
+  void              (* processFcn)(tTbxMbEvent * event); /**< Event process function.  */
+  tTbxMbEventPoller    pollInfo;                 /**< Event poller information.        */
+  /* Private members. */
+  uint8_t              polling;                  /**< Polling activated flag.          */
+} tTbxMbSimCtx;
+
+
+/****************************************************************************************
+* Function prototypes
+****************************************************************************************/
+static void TbxMbSimEventTx(tTbxMbUartPort port);
+
+static void TbxMbSimEventIdle(tTbxMbUartPort port);
+
+#if (TBX_MB_SIM_STEP_US > 0U)
+static void TbxMbSimPoll(void * context);
+#endif
+
+
+/****************************************************************************************
+* Local data declarations
+****************************************************************************************/
+/** \brief Array with the information of each simulated serial port. */
+static tTbxMbSimPort tbxMbSimPort[TBX_MB_UART_NUM_PORT];
+
+/** \brief Simulated time in microseconds. */
+static uint64_t tbxMbSimTimeUs = 0U;
+
+#if (TBX_MB_SIM_STEP_US > 0U)
+/** \brief Simulation context for automatically advancing the simulated time. */
+static tTbxMbSimCtx tbxMbSimCtx;
+#endif
+
+
+/************************************************************************************//**
+** \brief     Advances the simulated time by the specified number of microseconds. It
+**            processes the simulated events of all serial ports, such as the completed
+**            transmission of a byte, in the order that they are due. This calls the
+**            callbacks of the Modbus UART module, just like an interrupt handler would.
+** \details   The serial ports are connected in pairs with a virtual null modem cable.
+**            TBX_MB_UART_PORT1 with TBX_MB_UART_PORT2, TBX_MB_UART_PORT3 with
+**            TBX_MB_UART_PORT4, etc. Each byte transmitted on a serial port is received
+**            by the other serial port of its pair, once the time to transfer one
+**            character at the configured baudrate passed.
+**
+**            The event task automatically calls this function with TBX_MB_SIM_STEP_US.
+**            When configured to 0, call it yourself between calls to TbxMbEventTask().
+**            A step of 50 microseconds matches the resolution of the free running
+**            counter.
+** \param     us Number of microseconds to advance the simulated time with.
+**
+****************************************************************************************/
+void TbxMbSimAdvance(uint32_t us)
+{
+  uint64_t targetUs;
+
+  TbxCriticalSectionEnter();
+  targetUs = tbxMbSimTimeUs + us;
+  TbxCriticalSectionExit();
+  /* Process the events that are due before the target time, one at a time. Processing
+   * an event can schedule new events, so look for the next one afterwards.
+   */
+  for (;;)
+  {
+    uint8_t  found = TBX_FALSE;
+    uint8_t  nextPort = 0U;
+    uint8_t  nextEvent = 0U;
+    uint64_t nextUs = targetUs;
+
+    /* Find the event that is due first. */
+    TbxCriticalSectionEnter();
+    for (uint8_t portIdx = 0U; portIdx < (uint8_t)TBX_MB_UART_NUM_PORT; portIdx++)
+    {
+      for (uint8_t eventIdx = 0U; eventIdx < TBX_MB_SIM_NUM_EVENT; eventIdx++)
+      {
+        if ((tbxMbSimPort[portIdx].pending[eventIdx] == TBX_TRUE) &&
+            (tbxMbSimPort[portIdx].dueUs[eventIdx] <= nextUs))
+        {
+          /* Only replace an already found event, if this one is due earlier. */
+          if ((found == TBX_FALSE) || (tbxMbSimPort[portIdx].dueUs[eventIdx] < nextUs))
+          {
+            found = TBX_TRUE;
+            nextPort = portIdx;
+            nextEvent = eventIdx;
+            nextUs = tbxMbSimPort[portIdx].dueUs[eventIdx];
+          }
+        }
+      }
+    }
+    /* Advance the simulated time to when the found event is due. */
+    if (found == TBX_TRUE)
+    {
+      tbxMbSimPort[nextPort].pending[nextEvent] = TBX_FALSE;
+      tbxMbSimTimeUs = nextUs;
+    }
+    TbxCriticalSectionExit();
+    /* All events before the target time processed? */
+    if (found == TBX_FALSE)
+    {
+      break;
+    }
+    /* Process the event. */
+    if (nextEvent == TBX_MB_SIM_EVENT_TX)
+    {
+      TbxMbSimEventTx((tTbxMbUartPort)nextPort);
+    }
+    else if (nextEvent == TBX_MB_SIM_EVENT_IDLE)
+    {
+      TbxMbSimEventIdle((tTbxMbUartPort)nextPort);
+    }
+    else
+    {
+      TbxMbUartTimerExpired((tTbxMbUartPort)nextPort);
+    }
+  }
+  /* Advance the simulated time to the target time. */
+  TbxCriticalSectionEnter();
+  tbxMbSimTimeUs = targetUs;
+  TbxCriticalSectionExit();
+} /*** end of TbxMbSimAdvance ***/
+
+
+/************************************************************************************//**
+** \brief     Obtains the simulated time.
+** \return    Simulated time in microseconds.
+**
+****************************************************************************************/
+uint64_t TbxMbSimTimeUs(void)
+{
+  uint64_t result;
+
+  TbxCriticalSectionEnter();
+  result = tbxMbSimTimeUs;
+  TbxCriticalSectionExit();
+
+  return result;
+} /*** end of TbxMbSimTimeUs ***/
+
+
+/************************************************************************************//**
+** \brief     Obtains the total number of bytes that were transmitted on the specified
+**            serial port. Handy for determining the bus load or throughput.
+** \param     port The serial port.
+** \return    Total number of transmitted bytes.
+**
+****************************************************************************************/
+uint32_t TbxMbSimTxBytes(tTbxMbUartPort port)
+{
+  uint32_t result = 0U;
+
+  /* Verify parameters. */
+  TBX_ASSERT(port < TBX_MB_UART_NUM_PORT);
+
+  /* Only continue with valid parameters. */
+  if (port < TBX_MB_UART_NUM_PORT)
+  {
+    TbxCriticalSectionEnter();
+    result = tbxMbSimPort[port].txBytes;
+    TbxCriticalSectionExit();
+  }
+
+  return result;
+} /*** end of TbxMbSimTxBytes ***/
+
+
+/************************************************************************************//**
+** \brief     Initializes the UART channel.
+** \param     port The serial port to use. The actual meaning of the serial port is
+**            hardware dependent. It typically maps to the UART peripheral number. E.g. 
+**            TBX_MB_UART_PORT1 = USART1 on an STM32.
+** \param     baudrate The desired communication speed.
+** \param     databits Number of databits for a character.
+** \param     stopbits Number of stop bits at the end of a character.
+** \param     parity Parity bit type to use.
+**
+****************************************************************************************/
+void TbxMbPortUartInit(tTbxMbUartPort     port, 
+                       tTbxMbUartBaudrate baudrate,
+                       tTbxMbUartDatabits databits, 
+                       tTbxMbUartStopbits stopbits,
+                       tTbxMbUartParity   parity)
+{
+  /* Determine the number of bits per character, including the start bit. */
+  uint32_t charBits = (databits == TBX_MB_UART_7_DATABITS) ? 8U : 9U;
+  charBits += (stopbits == TBX_MB_UART_2_STOPBITS) ? 2U : 1U;
+  charBits += (parity == TBX_MB_NO_PARITY) ? 0U : 1U;
+
+  TbxCriticalSectionEnter();
+  /* Determine the time to transfer one character, rounded up to the next microsecond. */
+  uint32_t baudBps = TbxMbUartBaudrateBps(baudrate);
+  tbxMbSimPort[port].charUs = ((charBits * 1000000U) + baudBps - 1U) / baudBps;
+  /* Reset the transfer state of the serial port. */
+  tbxMbSimPort[port].txLen = 0U;
+  tbxMbSimPort[port].rxData = NULL;
+  for (uint8_t eventIdx = 0U; eventIdx < TBX_MB_SIM_NUM_EVENT; eventIdx++)
+  {
+    tbxMbSimPort[port].pending[eventIdx] = TBX_FALSE;
+  }
+  tbxMbSimPort[port].initialized = TBX_TRUE;
+  TbxCriticalSectionExit();
+
+#if (TBX_MB_SIM_STEP_US > 0U)
+  /* Instruct the event task to start calling our polling function, for automatically
+   * advancing the simulated time. Only needed once for all serial ports.
+   */
+  if (tbxMbSimCtx.polling == TBX_FALSE)
+  {
+    tbxMbSimCtx.polling = TBX_TRUE;
+    tbxMbSimCtx.instancePtr = NULL;
+    tbxMbSimCtx.pollFcn = TbxMbSimPoll;
+    tbxMbSimCtx.processFcn = NULL;
+    tbxMbSimCtx.pollInfo.count = 0U;
+    tbxMbSimCtx.pollInfo.task = TbxMbEventTaskSelected();
+    tTbxMbEvent newEvent;
+    newEvent.context = &tbxMbSimCtx;
+    newEvent.id = TBX_MB_EVENT_ID_START_POLLING;
+    TbxMbOsalEventPost(&newEvent, TBX_FALSE);
+  }
+#endif
+} /*** end of TbxMbPortUartInit ***/
+
+
+/************************************************************************************//**
+** \brief     Starts the transfer of len bytes from the data array on the specified 
+**            serial port.
+** \attention This function has mutual exclusive access to the bytes in the data[] array,
+**            until this port module calls TbxMbUartTransmitComplete(). This means that
+**            you do not need to copy the data bytes to a local buffer. This approach 
+**            keeps RAM requirements low and benefits the run-time performance. Just make
+**            sure to call TbxMbUartTransmitComplete() once all bytes are transmitted or
+**            an error was detected, to release access to the data[] array.
+** \param     port The serial port to start the data transfer on.
+** \param     data Byte array with data to transmit.
+** \param     len Number of bytes to transmit.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.  
+**
+****************************************************************************************/
+uint8_t TbxMbPortUartTransmit(tTbxMbUartPort         port, 
+                              uint8_t        const * data, 
+                              uint16_t               len)
+{
+  uint8_t result = TBX_ERROR;
+
+  TbxCriticalSectionEnter();
+  /* Only start the transfer if the port is initialized and not already transmitting. */
+  if ((tbxMbSimPort[port].initialized == TBX_TRUE) && (len > 0U) &&
+      (tbxMbSimPort[port].pending[TBX_MB_SIM_EVENT_TX] == TBX_FALSE))
+  {
+    tbxMbSimPort[port].txData = data;
+    tbxMbSimPort[port].txIdx = 0U;
+    tbxMbSimPort[port].txLen = len;
+    /* Schedule the completed transmission of the first byte. */
+    tbxMbSimPort[port].dueUs[TBX_MB_SIM_EVENT_TX] = tbxMbSimTimeUs +
+                                                    tbxMbSimPort[port].charUs;
+    tbxMbSimPort[port].pending[TBX_MB_SIM_EVENT_TX] = TBX_TRUE;
+    result = TBX_OK;
+  }
+  TbxCriticalSectionExit();
+
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbPortUartTransmit ***/
+
+
+/************************************************************************************//**
+** \brief     Starts the reception of up to len bytes into the data array on the
+**            specified serial port, typically with the help of a DMA peripheral. Only
+**            called when TBX_MB_UART_RX_DMA_ENABLE is configured to a value > 0 in
+**            "tbx_conf.h". Any reception that is still in progress should be aborted,
+**            such that the reception restarts at the beginning of the data array.
+** \param     port The serial port to start the data reception on.
+** \param     data Byte array to store the received data in.
+** \param     len Maximum number of bytes to receive.
+**
+****************************************************************************************/
+void TbxMbPortUartReceiveStart(tTbxMbUartPort   port,
+                               uint8_t        * data,
+                               uint16_t         len)
+{
+  TbxCriticalSectionEnter();
+  tbxMbSimPort[port].rxData = data;
+  tbxMbSimPort[port].rxIdx = 0U;
+  tbxMbSimPort[port].rxLen = len;
+  tbxMbSimPort[port].pending[TBX_MB_SIM_EVENT_IDLE] = TBX_FALSE;
+  TbxCriticalSectionExit();
+} /*** end of TbxMbPortUartReceiveStart ***/
+
+
+/************************************************************************************//**
+** \brief     Stops the reception that was started with TbxMbPortUartReceiveStart(), such
+**            that the data array is no longer written to. Only called when 
+**            TBX_MB_UART_RX_DMA_ENABLE is configured to a value > 0 in "tbx_conf.h".
+** \param     port The serial port to stop the data reception on.
+**
+****************************************************************************************/
+void TbxMbPortUartReceiveStop(tTbxMbUartPort port)
+{
+  TbxCriticalSectionEnter();
+  tbxMbSimPort[port].rxData = NULL;
+  tbxMbSimPort[port].pending[TBX_MB_SIM_EVENT_IDLE] = TBX_FALSE;
+  TbxCriticalSectionExit();
+} /*** end of TbxMbPortUartReceiveStop ***/
+
+
+/************************************************************************************//**
+** \brief     Starts the one-shot timer of the specified serial port, such that it
+**            expires after the specified number of ticks. Only called when
+**            TBX_MB_UART_TIMER_ENABLE is configured to a value > 0 in "tbx_conf.h".
+**            In case the timer is already running, it should be restarted.
+** \param     port The serial port to start the timer for.
+** \param     ticks Timer expiration time in ticks of the TBX_MB_UART_TIMER_FREQ
+**            frequency. By default, a tick is 50 microseconds.
+**
+****************************************************************************************/
+void TbxMbPortUartTimerStart(tTbxMbUartPort port,
+                             uint16_t       ticks)
+{
+  /* Convert the ticks of the TBX_MB_UART_TIMER_FREQ frequency to microseconds, rounded
+   * up to the next microsecond.
+   */
+  uint64_t timeoutUs = (((uint64_t)ticks * 1000000U) + (TBX_MB_UART_TIMER_FREQ - 1U)) /
+                       TBX_MB_UART_TIMER_FREQ;
+
+  TbxCriticalSectionEnter();
+  tbxMbSimPort[port].dueUs[TBX_MB_SIM_EVENT_TIMER] = tbxMbSimTimeUs + timeoutUs;
+  tbxMbSimPort[port].pending[TBX_MB_SIM_EVENT_TIMER] = TBX_TRUE;
+  TbxCriticalSectionExit();
+} /*** end of TbxMbPortUartTimerStart ***/
+
+
+/************************************************************************************//**
+** \brief     Stops the one-shot timer of the specified serial port, such that its
+**            expiration is no longer signalled. Only called when 
+**            TBX_MB_UART_TIMER_ENABLE is configured to a value > 0 in "tbx_conf.h".
+** \param     port The serial port to stop the timer for.
+**
+****************************************************************************************/
+void TbxMbPortUartTimerStop(tTbxMbUartPort port)
+{
+  TbxCriticalSectionEnter();
+  tbxMbSimPort[port].pending[TBX_MB_SIM_EVENT_TIMER] = TBX_FALSE;
+  TbxCriticalSectionExit();
+} /*** end of TbxMbPortUartTimerStop ***/
+
+
+/************************************************************************************//**
+** \brief     Obtains the free running counter value of a timer that runs at 20 kHz. It's
+**            derived from the simulated time, so it only advances while calling
+**            TbxMbSimAdvance().
+** \return    Free running counter value.
+**
+****************************************************************************************/
+uint16_t TbxMbPortTimerCount(void)
+{
+  uint16_t result;
+
+  TbxCriticalSectionEnter();
+  result = (uint16_t)(tbxMbSimTimeUs / TBX_MB_SIM_TICK_US);
+  TbxCriticalSectionExit();
+
+  return result;
+} /*** end of TbxMbPortTimerCount ***/
+
+
+/************************************************************************************//**
+** \brief     Updates the Modbus RTU CRC16 checksum with the bytes in the specified data
+**            array. Only called when TBX_MB_RTU_CRC_METHOD is configured to
+**            TBX_MB_RTU_CRC_METHOD_PORT in "tbx_conf.h". The simulation has no CRC
+**            peripheral, so it uses a bitwise software implementation.
+** \param     crc Current CRC16 checksum value.
+** \param     data Pointer to the byte array with data.
+** \param     len Number of data bytes to include in the CRC16 calculation.
+** \return    The updated CRC16 checksum value.
+**
+****************************************************************************************/
+uint16_t TbxMbPortCrcUpdate(uint16_t         crc,
+                            uint8_t  const * data,
+                            uint16_t         len)
+{
+  uint16_t result = crc;
+
+  for (uint16_t byteIdx = 0U; byteIdx < len; byteIdx++)
+  {
+    result ^= data[byteIdx];
+    for (uint8_t bitIdx = 0U; bitIdx < 8U; bitIdx++)
+    {
+      if ((result & 0x0001U) != 0U)
+      {
+        result = (result >> 1U) ^ 0xA001U;
+      }
+      else
+      {
+        result >>= 1U;
+      }
+    }
+  }
+
+  return result;
+} /*** end of TbxMbPortCrcUpdate ***/
+
+
+/************************************************************************************//**
+** \brief     Opens a TCP/IP socket that listens for connection requests from Modbus TCP
+**            clients on the specified TCP port. TCP/IP is not simulated, so this always
+**            fails.
+** \param     port The TCP port number to listen on. Typically 502 for Modbus TCP.
+** \return    Handle to the listen socket if successful, NULL otherwise.
+**
+****************************************************************************************/
+tTbxMbTcpSock TbxMbPortTcpServerOpen(uint16_t port)
+{
+  TBX_UNUSED_ARG(port);
+
+  return NULL;
+} /*** end of TbxMbPortTcpServerOpen ***/
+
+
+/************************************************************************************//**
+** \brief     Accepts a pending connection request on the listen socket. TCP/IP is not
+**            simulated, so no connection request is ever pending.
+** \param     serverSock Handle to the listen socket, as obtained with
+**            TbxMbPortTcpServerOpen().
+** \return    Handle to the socket of the new connection if one was accepted, NULL if no
+**            connection request is pending.
+**
+****************************************************************************************/
+tTbxMbTcpSock TbxMbPortTcpServerAccept(tTbxMbTcpSock serverSock)
+{
+  TBX_UNUSED_ARG(serverSock);
+
+  return NULL;
+} /*** end of TbxMbPortTcpServerAccept ***/
+
+
+/************************************************************************************//**
+** \brief     Connects to a Modbus TCP server. TCP/IP is not simulated, so this always
+**            fails.
+** \param     ipAddress The IP address of the server.
+** \param     port The TCP port number of the server.
+** \return    Handle to the socket of the connection if successful, NULL otherwise.
+**
+****************************************************************************************/
+tTbxMbTcpSock TbxMbPortTcpConnect(char     const * ipAddress,
+                                  uint16_t         port)
+{
+  TBX_UNUSED_ARG(ipAddress);
+  TBX_UNUSED_ARG(port);
+
+  return NULL;
+} /*** end of TbxMbPortTcpConnect ***/
+
+
+/************************************************************************************//**
+** \brief     Transmits len bytes from the data array on the specified socket. TCP/IP is
+**            not simulated, so this always fails.
+** \param     sock Handle to the socket.
+** \param     data Byte array with data to transmit.
+** \param     len Number of bytes to transmit.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbPortTcpTransmit(tTbxMbTcpSock         sock,
+                             uint8_t       const * data,
+                             uint16_t              len)
+{
+  TBX_UNUSED_ARG(sock);
+  TBX_UNUSED_ARG(data);
+  TBX_UNUSED_ARG(len);
+
+  return TBX_ERROR;
+} /*** end of TbxMbPortTcpTransmit ***/
+
+
+/************************************************************************************//**
+** \brief     Reads the data that was received on the specified socket. TCP/IP is not
+**            simulated, so this always fails.
+** \param     sock Handle to the socket.
+** \param     data Byte array to store the received data in.
+** \param     len Pointer to the maximum number of bytes to read. Updated to the number of
+**            bytes that were actually read.
+** \return    TBX_OK if successful, TBX_ERROR if the connection is closed or broken.
+**
+****************************************************************************************/
+uint8_t TbxMbPortTcpReceive(tTbxMbTcpSock   sock,
+                            uint8_t       * data,
+                            uint16_t      * len)
+{
+  TBX_UNUSED_ARG(sock);
+  TBX_UNUSED_ARG(data);
+
+  *len = 0U;
+
+  return TBX_ERROR;
+} /*** end of TbxMbPortTcpReceive ***/
+
+
+/************************************************************************************//**
+** \brief     Closes the specified socket.
+** \param     sock Handle to the socket to close.
+**
+****************************************************************************************/
+void TbxMbPortTcpClose(tTbxMbTcpSock sock)
+{
+  TBX_UNUSED_ARG(sock);
+} /*** end of TbxMbPortTcpClose ***/
+
+
+/************************************************************************************//**
+** \brief     Processes the completed transmission of a byte on the specified serial
+**            port. The other serial port of its pair receives the byte. This is the
+**            simulated counterpart of a UART transmit interrupt handler.
+** \param     port The serial port that transmitted the byte.
+**
+****************************************************************************************/
+static void TbxMbSimEventTx(tTbxMbUartPort port)
+{
+  tTbxMbSimPort * txPort = &tbxMbSimPort[port];
+  tTbxMbSimPort * rxPort = &tbxMbSimPort[(uint8_t)port ^ 1U];
+  uint8_t         txDone = TBX_FALSE;
+  uint8_t         rxByte;
+
+  TbxCriticalSectionEnter();
+  rxByte = txPort->txData[txPort->txIdx];
+  txPort->txIdx++;
+  txPort->txBytes++;
+  /* Last byte of the entire transfer transmitted? */
+  if (txPort->txIdx >= txPort->txLen)
+  {
+    txDone = TBX_TRUE;
+  }
+  /* Schedule the completed transmission of the next byte. */
+  else
+  {
+    txPort->dueUs[TBX_MB_SIM_EVENT_TX] = tbxMbSimTimeUs + txPort->charUs;
+    txPort->pending[TBX_MB_SIM_EVENT_TX] = TBX_TRUE;
+  }
+#if (TBX_MB_UART_RX_DMA_ENABLE > 0U)
+  /* Store the byte in the reception byte array of the other serial port, if it is
+   * receiving, and restart its idle line detection. It detects an idle line after one
+   * character time.
+   */
+  if ((rxPort->initialized == TBX_TRUE) && (rxPort->rxData != NULL))
+  {
+    if (rxPort->rxIdx < rxPort->rxLen)
+    {
+      rxPort->rxData[rxPort->rxIdx] = rxByte;
+      rxPort->rxIdx++;
+    }
+    rxPort->dueUs[TBX_MB_SIM_EVENT_IDLE] = tbxMbSimTimeUs + rxPort->charUs;
+    rxPort->pending[TBX_MB_SIM_EVENT_IDLE] = TBX_TRUE;
+  }
+#endif
+  TbxCriticalSectionExit();
+
+#if (TBX_MB_UART_RX_DMA_ENABLE == 0U)
+  /* Inform the Modbus UART module of the other serial port about the received byte. */
+  if (rxPort->initialized == TBX_TRUE)
+  {
+    TbxMbUartDataReceived((tTbxMbUartPort)((uint8_t)port ^ 1U), &rxByte, 1U);
+  }
+#endif
+  /* Inform the Modbus UART module about the completed transfer. */
+  if (txDone == TBX_TRUE)
+  {
+    TbxMbUartTransmitComplete(port);
+  }
+} /*** end of TbxMbSimEventTx ***/
+
+
+/************************************************************************************//**
+** \brief     Processes the idle line detection on the specified serial port. This is
+**            the simulated counterpart of a UART idle line interrupt handler.
+** \param     port The serial port that detected the idle line.
+**
+****************************************************************************************/
+static void TbxMbSimEventIdle(tTbxMbUartPort port)
+{
+  uint16_t rxCount;
+
+  TbxCriticalSectionEnter();
+  rxCount = tbxMbSimPort[port].rxIdx;
+  TbxCriticalSectionExit();
+  /* Only inform the Modbus UART module if data was actually received. */
+  if (rxCount > 0U)
+  {
+    /* Inform the Modbus UART module about the total number of bytes received so far,
+     * since the reception was started.
+     */
+    TbxMbUartReceiveProgress(port, rxCount);
+  }
+} /*** end of TbxMbSimEventIdle ***/
+
+
+#if (TBX_MB_SIM_STEP_US > 0U)
+/************************************************************************************//**
+** \brief     Event polling function that is automatically called during each call of
+**            TbxMbEventTask(). It advances the simulated time by TBX_MB_SIM_STEP_US
+**            microseconds.
+** \param     context Pointer to the simulation context.
+**
+****************************************************************************************/
+static void TbxMbSimPoll(void * context)
+{
+  TBX_UNUSED_ARG(context);
+
+  TbxMbSimAdvance(TBX_MB_SIM_STEP_US);
+} /*** end of TbxMbSimPoll ***/
+#endif
+
+
+/*********************************** end of tbxmb_port.c *******************************/
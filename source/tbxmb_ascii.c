@@ -0,0 +1,1022 @@
+/************************************************************************************//**
+* \file         tbxmb_ascii.c
+* \brief        Modbus ASCII transport layer source file.
+* \internal
+*----------------------------------------------------------------------------------------
+*                          C O P Y R I G H T
+*----------------------------------------------------------------------------------------
+*   Copyright (c) 2023 by Feaser     www.feaser.com     All rights reserved
+*
+*----------------------------------------------------------------------------------------
+*                            L I C E N S E
+*----------------------------------------------------------------------------------------
+*
+* SPDX-License-Identifier: GPL-3.0-or-later
+*
+* This file is part of MicroTBX-Modbus. MicroTBX-Modbus is free software: you can
+* redistribute it and/or modify it under the terms of the GNU General Public License as
+* published by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* MicroTBX-Modbus is distributed in the hope that it will be useful, but WITHOUT ANY
+* WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+* PARTICULAR PURPOSE. See the GNU General Public License for more details.
+*
+* You have received a copy of the GNU General Public License along with MicroTBX-Modbus.
+* If not, see www.gnu.org/licenses/.
+*
+* \endinternal
+****************************************************************************************/
+
+/****************************************************************************************
+* Include files
+****************************************************************************************/
+#include "microtbx.h"                            /* MicroTBX module                    */
+#include "microtbxmodbus.h"                      /* MicroTBX-Modbus module             */
+#include "tbxmb_event_private.h"                 /* MicroTBX-Modbus event private      */
+#include "tbxmb_osal_private.h"                  /* MicroTBX-Modbus OSAL private       */
+#include "tbxmb_tp_private.h"                    /* MicroTBX-Modbus TP private         */
+#include "tbxmb_uart_private.h"                  /* MicroTBX-Modbus UART private       */
+
+
+/****************************************************************************************
+* Macro definitions
+****************************************************************************************/
+/** \brief Character that marks the start of a packet. */
+#define TBX_MB_ASCII_CHAR_START             ((uint8_t)':')
+
+/** \brief First character of the pair that marks the end of a packet. */
+#define TBX_MB_ASCII_CHAR_CR                ((uint8_t)'\r')
+
+/** \brief Second character of the pair that marks the end of a packet. */
+#define TBX_MB_ASCII_CHAR_LF                ((uint8_t)'\n')
+
+/** \brief Value that hex character decoding returns for invalid characters. */
+#define TBX_MB_ASCII_HEX_INVALID            (0xFFU)
+
+/** \brief Maximum number of ADU bytes. Note that an ADU on ASCII can have max 255 bytes:
+ *         - Node address (1 byte)
+ *         - Function code (1 byte)
+ *         - Packet data (max 252 bytes)
+ *         - LRC (1 byte)
+ */
+#define TBX_MB_ASCII_ADU_LEN_MAX            (255U)
+
+/** \brief Minimum number of ADU bytes: node address, function code and LRC. */
+#define TBX_MB_ASCII_ADU_LEN_MIN            (3U)
+
+/** \brief Unique context type to identify a context as being an ASCII transport layer. */
+#define TBX_MB_ASCII_CONTEXT_TYPE           (57U)
+
+/** \brief Idle state. Ready to receive or transmit. */
+#define TBX_MB_ASCII_STATE_IDLE             (1U)
+
+/** \brief Transmitting a PDU state. */
+#define TBX_MB_ASCII_STATE_TRANSMISSION     (2U)
+
+/** \brief Receiving a PDU state. */
+#define TBX_MB_ASCII_STATE_RECEPTION        (3U)
+
+/** \brief Validating a newly received PDU state. */
+#define TBX_MB_ASCII_STATE_VALIDATION       (4U)
+
+
+/****************************************************************************************
+* Function prototypes
+****************************************************************************************/
+static void             TbxMbAsciiProcessEvent    (tTbxMbEvent          * event);
+
+static uint8_t          TbxMbAsciiTransmit        (tTbxMbTp               transport);
+
+static void             TbxMbAsciiReceptionDone   (tTbxMbTp               transport);
+
+static tTbxMbTpPacket * TbxMbAsciiGetRxPacket     (tTbxMbTp               transport);
+
+static tTbxMbTpPacket * TbxMbAsciiGetTxPacket     (tTbxMbTp               transport);
+
+static void             TbxMbAsciiTransmitComplete(tTbxMbUartPort         port);
+
+static void             TbxMbAsciiDataReceived    (tTbxMbUartPort         port, 
+                                                   uint8_t        const * data, 
+                                                   uint8_t                len);
+
+static void             TbxMbAsciiRxChar          (tTbxMbTpCtx volatile * tpCtx,
+                                                   uint8_t                rxChar);
+
+static void             TbxMbAsciiRxFrameEnd      (tTbxMbTpCtx volatile * tpCtx);
+
+static uint16_t         TbxMbAsciiTxBufFill       (tTbxMbTpCtx volatile * tpCtx);
+
+static uint8_t          TbxMbAsciiHexDecode       (uint8_t                hexChar);
+
+
+/****************************************************************************************
+* Local data declarations
+****************************************************************************************/
+/** \brief ASCII transport layer handle lookup table by UART port. Uses for finding the
+ *         transport layer handle that uses a specific serial port, in a run-time
+ *         efficient way.
+ */
+static volatile tTbxMbTpCtx * tbxMbAsciiCtx[TBX_MB_UART_NUM_PORT] = { 0 };
+
+
+/************************************************************************************//**
+** \brief     Creates a Modbus ASCII transport layer object. In contrast to RTU, the
+**            ASCII transport layer marks the start and end of a packet with special
+**            characters. It therefore doesn't need to monitor the time between the
+**            received bytes, which means that the event task never needs to poll it.
+** \attention The ASCII transport layer processes the received characters one by one.
+**            It can therefore not be used with the UART DMA reception, as enabled with
+**            TBX_MB_UART_RX_DMA_ENABLE.
+** \param     nodeAddr The address of the node. Can be in the range 1..247 for a server
+**            node. Set it to 0 for the client.
+** \param     port The serial port to use. The actual meaning of the serial port is
+**            hardware dependent. It typically maps to the UART peripheral number. E.g. 
+**            TBX_MB_UART_PORT1 = USART1 on an STM32.
+** \param     baudrate The desired communication speed.
+** \param     databits Number of databits for a character. The Modbus protocol specifies
+**            7 databits for ASCII, yet some devices use 8 databits.
+** \param     stopbits Number of stop bits at the end of a character.
+** \param     parity Parity bit type to use.
+** \return    Handle to the newly created ASCII transport layer object if successful,
+**            NULL otherwise.
+**
+****************************************************************************************/
+tTbxMbTp TbxMbAsciiCreate(uint8_t            nodeAddr, 
+                          tTbxMbUartPort     port, 
+                          tTbxMbUartBaudrate baudrate,
+                          tTbxMbUartDatabits databits,
+                          tTbxMbUartStopbits stopbits,
+                          tTbxMbUartParity   parity)
+{
+  tTbxMbTp result = NULL;
+
+  /* Make sure the OSAL event module is initialized. The application will always first
+   * create a transport layer object before a channel object. Consequently, this is the
+   * best place to do the OSAL module initialization.
+   */
+  TbxMbOsalEventInit();
+
+  /* With the UART DMA reception, the port no longer reports the received characters
+   * one by one. This ASCII transport layer cannot work without it.
+   */
+  TBX_ASSERT(TBX_MB_UART_RX_DMA_ENABLE == 0U);
+
+  /* Verify parameters. */
+  TBX_ASSERT((nodeAddr <= TBX_MB_TP_NODE_ADDR_MAX) &&
+             (port < TBX_MB_UART_NUM_PORT) && 
+             (baudrate < TBX_MB_UART_NUM_BAUDRATE) &&
+             (TbxMbUartBaudrateBps(baudrate) > 0U) &&
+             (databits < TBX_MB_UART_NUM_DATABITS) &&
+             (stopbits < TBX_MB_UART_NUM_STOPBITS) &&
+             (parity < TBX_MB_UART_NUM_PARITY));
+
+  /* Only continue with valid parameters and if supported by the UART configuration. */
+  if ((nodeAddr <= TBX_MB_TP_NODE_ADDR_MAX) &&
+      (port < TBX_MB_UART_NUM_PORT) && 
+      (baudrate < TBX_MB_UART_NUM_BAUDRATE) &&
+      (TbxMbUartBaudrateBps(baudrate) > 0U) &&
+      (databits < TBX_MB_UART_NUM_DATABITS) &&
+      (stopbits < TBX_MB_UART_NUM_STOPBITS) &&
+      (parity < TBX_MB_UART_NUM_PARITY) &&
+      (TBX_MB_UART_RX_DMA_ENABLE == 0U))
+  {
+    /* Allocate memory for the new transport layer storage. */
+    tTbxMbTpStorage * newStorage = TbxMemPoolAllocate(sizeof(tTbxMbTpStorage));
+    /* Automatically increase the memory pool, if it was too small. */
+    if (newStorage == NULL)
+    {
+      /* No need to check the return value, because if it failed, the following
+       * allocation fails too, which is verified later on.
+       */
+      (void)TbxMemPoolCreate(1U, sizeof(tTbxMbTpStorage));
+      newStorage = TbxMemPoolAllocate(sizeof(tTbxMbTpStorage));      
+    }
+    /* Verify memory allocation of the transport layer storage. */
+    TBX_ASSERT(newStorage != NULL);
+    /* Only continue if the memory allocation succeeded. */
+    if (newStorage != NULL)
+    {
+      /* The transport context is located at the start of the storage. */
+      tTbxMbTpCtx * newTpCtx = &newStorage->ctx;
+      /* Initialize the transport context. Note that there is no need for a polling
+       * function, because the end of a packet is marked by its characters.
+       */
+      newTpCtx->type = TBX_MB_ASCII_CONTEXT_TYPE;
+      newTpCtx->instancePtr = NULL;
+      newTpCtx->pollFcn = NULL;
+      newTpCtx->processFcn = TbxMbAsciiProcessEvent;
+      newTpCtx->pollInfo.count = 0U;
+      newTpCtx->pollInfo.task = TbxMbEventTaskSelected();
+      newTpCtx->transmitFcn = TbxMbAsciiTransmit;
+      newTpCtx->receptionDoneFcn = TbxMbAsciiReceptionDone;
+      newTpCtx->getRxPacketFcn = TbxMbAsciiGetRxPacket;
+      newTpCtx->getTxPacketFcn = TbxMbAsciiGetTxPacket;
+      newTpCtx->nodeAddr = nodeAddr;
+      newTpCtx->port = port;
+      newTpCtx->state = TBX_MB_ASCII_STATE_IDLE;
+      newTpCtx->rxAduWrIdx = 0U;
+      newTpCtx->rxAduDone = TBX_FALSE;
+      newTpCtx->rxCrc = 0U;
+      newTpCtx->asciiTxIdx = 0U;
+      newTpCtx->diagInfo.busMsgCnt = 0U;
+      newTpCtx->diagInfo.busCommErrCnt = 0U;
+      newTpCtx->diagInfo.busExcpErrCnt = 0U;
+      newTpCtx->diagInfo.srvMsgCnt = 0U;
+      newTpCtx->diagInfo.srvNoRespCnt = 0U;
+      newTpCtx->isMonitor = TBX_FALSE;
+      newTpCtx->isStatic = TBX_FALSE;
+      newTpCtx->txPacket = &newStorage->txPacket;
+      newTpCtx->rxPacket = &newStorage->rxPacket;
+      TbxMbTraceReset(newTpCtx);
+      /* Store the transport context in the lookup table. */
+      tbxMbAsciiCtx[port] = newTpCtx;
+      /* Initialize the port. The ASCII transport layer doesn't need the reception
+       * progress and timer expired events.
+       */
+      TbxMbUartInit(port, baudrate, databits, stopbits, parity,
+                    TbxMbAsciiTransmitComplete, TbxMbAsciiDataReceived, NULL, NULL);
+      /* Update the result. */
+      result = newTpCtx;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbAsciiCreate ***/  
+
+
+/************************************************************************************//**
+** \brief     Releases a Modbus ASCII transport layer object, previously created with 
+**            TbxMbAsciiCreate().
+** \param     transport Handle to ASCII transport layer object to release.
+**
+****************************************************************************************/
+void TbxMbAsciiFree(tTbxMbTp transport)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(transport != NULL);
+
+  /* Only continue with valid parameters. */
+  if (transport != NULL)
+  {
+    /* Convert the TP channel pointer to the context structure. */
+    tTbxMbTpCtx * tpCtx = (tTbxMbTpCtx *)transport;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(tpCtx->type == TBX_MB_ASCII_CONTEXT_TYPE);
+    TbxCriticalSectionEnter();
+    /* Remove the channel from the lookup table. */
+    tbxMbAsciiCtx[tpCtx->port] = NULL;
+    /* Invalidate the context to protect it from accidentally being used afterwards. */
+    tpCtx->type = 0U;
+    tpCtx->pollFcn = NULL;
+    tpCtx->processFcn = NULL;
+    TbxCriticalSectionExit();
+    /* Remove the context from the poller array of its event task right away, such
+     * that its poll function is no longer called after releasing it.
+     */
+    TbxMbEventPollerRelease(tpCtx);
+    /* Give the transport layer context back to the memory pool. */
+    TbxMemPoolRelease(tpCtx);
+  }
+} /*** end of TbxMbAsciiFree ***/
+
+
+/************************************************************************************//**
+** \brief     Event processing function that is automatically called when an event for
+**            this transport layer object was received in TbxMbEventTask().
+** \param     event Pointer to the event to process. Note that the event->context points
+**            to the handle of the ASCII transport layer object.
+**
+****************************************************************************************/
+static void TbxMbAsciiProcessEvent(tTbxMbEvent * event)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(event != NULL);
+
+  /* Only continue with valid parameters. */
+  if (event != NULL)
+  {
+    /* The ASCII transport layer handles the start and end of a packet directly on the
+     * reception and transmission paths. It does not post events to itself, so an event
+     * for this transport layer should not happen.
+     */
+    TBX_ASSERT(TBX_FALSE);
+  }
+} /*** end of TbxMbAsciiProcessEvent ***/
+
+
+/************************************************************************************//**
+** \brief     Starts the transmission of a communication packet, stored in the transport
+**            layer object.
+** \param     transport Handle to ASCII transport layer object.
+** \return    TBX_OK if successful, TBX_ERROR otherwise. 
+**
+****************************************************************************************/
+static uint8_t TbxMbAsciiTransmit(tTbxMbTp transport)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify parameters. */
+  TBX_ASSERT(transport != NULL);
+
+  /* Only continue with valid parameters. */
+  if (transport != NULL)
+  {
+    /* Convert the TP channel pointer to the context structure. */
+    tTbxMbTpCtx * tpCtx = (tTbxMbTpCtx *)transport;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(tpCtx->type == TBX_MB_ASCII_CONTEXT_TYPE);
+    /* Are we requested to transmit an exception response? */
+    TbxCriticalSectionEnter();
+    uint8_t codeCopy = tpCtx->txPacket->pdu.code;
+    TbxCriticalSectionExit();
+    if ((codeCopy & TBX_MB_FC_EXCEPTION_MASK) == TBX_MB_FC_EXCEPTION_MASK)
+    {
+      /* Increment the total number of exception responses. */
+      tpCtx->diagInfo.busExcpErrCnt++;
+    }
+    /* New transmissions are only possible from the IDLE state. */
+    uint8_t okayToTransmit = TBX_FALSE;
+    TbxCriticalSectionEnter();
+    if (tpCtx->state == TBX_MB_ASCII_STATE_IDLE)
+    {
+      /* Should a response actually be transmitted? If we are a server, then upon
+       * reception packet validation, txPacket.node was already set to 
+       * TBX_MB_TP_NODE_ADDR_BROADCAST for us, in case of a broadcast request, which
+       * does not require a response.
+       */
+      if ( (tpCtx->isClient == TBX_FALSE) && 
+           (tpCtx->txPacket->node == TBX_MB_TP_NODE_ADDR_BROADCAST) )
+      {
+        /* To bypass the actual response transmission, simply update the result to
+         * indicate success and keep the okayToTransmit set to its default TBX_FALSE.
+         */
+        result = TBX_OK;
+      }
+      /* Okay to transmit the response. */
+      else
+      {
+        okayToTransmit = TBX_TRUE;
+        /* Transition to the TRANSMISSION state to lock access to the txPacket for the
+         * duration of the transmission. Note that the unlock happens once the state 
+         * transitions back to IDLE. This happens once all characters are transmitted.
+         */
+        tpCtx->state = TBX_MB_ASCII_STATE_TRANSMISSION;
+      }
+    }
+    TbxCriticalSectionExit();
+    /* Only continue if no other packet transmission is already in progress. */
+    if (okayToTransmit == TBX_TRUE)
+    {
+      /* Determine ADU specific properties. The ADU starts at one byte before the PDU, 
+       * which is the last byte of head[]. The ADU's length, before encoding each byte
+       * as two hexadecimal characters, is:
+       * - Node address (1 byte)
+       * - Function code (1 byte)
+       * - Packet data (dataLen bytes)
+       * - LRC (1 byte)
+       */
+      uint8_t * aduPtr = &tpCtx->txPacket->head[TBX_MB_TP_ADU_HEAD_LEN_MAX-1U];
+      uint16_t  aduLen = tpCtx->txPacket->dataLen + 3U;
+      /* Populate the ADU head. For client->server transfers the address field is the
+       * servers's node address (unicast) or 0 (broadcast) and the client channel will
+       * have stored it in the txPacket.node element. For server-client transfers it
+       * always the servers's node address as stored when creating the ASCII transport
+       * layer context.
+       */
+      aduPtr[0] = (tpCtx->isClient == TBX_TRUE) ? tpCtx->txPacket->node : tpCtx->nodeAddr;
+      /* Populate the ADU tail. For ASCII it is the LRC right after the PDU's data. It is
+       * the two's complement of the sum of all other ADU bytes, without carry.
+       */
+      uint8_t lrc = 0U;
+      for (uint16_t idx = 0U; idx < (aduLen - 1U); idx++)
+      {
+        lrc += aduPtr[idx];
+      }
+      aduPtr[aduLen - 1U] = (uint8_t)(0U - lrc);
+      /* The encoded packet needs about twice as many characters than the ADU has bytes.
+       * The ADU is therefore encoded and transmitted in smaller parts, through the
+       * asciiTxBuf[] buffer. The transmit complete event continues with the next part.
+       * Start with the first part.
+       */
+      tpCtx->asciiTxIdx = 0U;
+      uint16_t txLen = TbxMbAsciiTxBufFill(tpCtx);
+#if (TBX_MB_TRACE_ENABLE > 0U)
+      /* Timestamp the transmission start of the packet. */
+      TbxMbTraceMark(tpCtx, TBX_MB_TRACE_POINT_TX_START);
+#endif
+      /* Pass the first part of the transmit request on to the UART module. */
+      result = TbxMbUartTransmit(tpCtx->port, (uint8_t const *)tpCtx->asciiTxBuf, txLen);
+      /* Transition back to the IDLE state, because the transmission could not be
+       * started. The unlocks access to txPacket for a possible future transmission.
+       */
+      if (result != TBX_OK)
+      {
+        TbxCriticalSectionEnter();
+        tpCtx->state = TBX_MB_ASCII_STATE_IDLE;
+        TbxCriticalSectionExit();
+      }
+    }
+    /* Problem detected that prevented the response from being sent? */
+    if (result == TBX_ERROR)
+    {
+      /* Increment the total number of not sent responses. */
+      tpCtx->diagInfo.srvNoRespCnt++;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbAsciiTransmit ***/
+
+
+/************************************************************************************//**
+** \brief     Signals that the caller is done with processing a reception PDU. Should be
+**            called by a channel after receiving the TBX_MB_EVENT_ID_PDU_RECEIVED event
+**            and no longer needing access to the PDU stored in the transport layer
+**            context.
+** \param     transport Handle to ASCII transport layer object.
+**
+****************************************************************************************/
+static void TbxMbAsciiReceptionDone(tTbxMbTp transport)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(transport != NULL);
+
+  /* Only continue with valid parameters. */
+  if (transport != NULL)
+  {
+    /* Convert the TP channel pointer to the context structure. */
+    tTbxMbTpCtx * tpCtx = (tTbxMbTpCtx *)transport;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(tpCtx->type == TBX_MB_ASCII_CONTEXT_TYPE);
+    /* This function should only be called in the VALIDATION state. Verify this. */
+    TbxCriticalSectionEnter();
+    uint8_t currentState = tpCtx->state;
+    TbxCriticalSectionExit();
+    TBX_ASSERT(currentState == TBX_MB_ASCII_STATE_VALIDATION);
+    /* Only continue in the VALIDATION state. */
+    if (currentState == TBX_MB_ASCII_STATE_VALIDATION)
+    {
+      /* Transistion back to the IDLE state to unlock the data reception path, allowing
+       * the reception of new packets.
+       */
+      TbxCriticalSectionEnter();
+      tpCtx->state = TBX_MB_ASCII_STATE_IDLE;
+      TbxCriticalSectionExit();
+    }
+  }
+} /*** end of TbxMbAsciiReceptionDone ****/
+
+
+/************************************************************************************//**
+** \brief     Interface function to be called by a channel to obtain read access to the 
+**            reception packet. Returns NULL is the packet is currently not accessible.
+**            Can be called when processing the TBX_MB_EVENT_ID_PDU_RECEIVED event.
+** \param     transport Handle to ASCII transport layer object.
+** \return    Pointer to the packet or NULL if currently not accessible.
+**
+****************************************************************************************/
+static tTbxMbTpPacket * TbxMbAsciiGetRxPacket(tTbxMbTp transport)
+{
+  tTbxMbTpPacket * result = NULL;
+
+  /* Verify parameters. */
+  TBX_ASSERT(transport != NULL);
+
+  /* Only continue with valid parameters. */
+  if (transport != NULL)
+  {
+    /* Convert the TP channel pointer to the context structure. */
+    tTbxMbTpCtx * tpCtx = (tTbxMbTpCtx *)transport;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(tpCtx->type == TBX_MB_ASCII_CONTEXT_TYPE);
+    /* Access to the reception packet by a channel is only allowed in the VALIDATION
+     * state. In this state the reception path is locked until a transition back to IDLE
+     * state is made. This happens once the channel called receptionDoneFcn().
+     */
+    TbxCriticalSectionEnter();
+    uint8_t currentState = tpCtx->state;
+    TbxCriticalSectionExit();
+    if (currentState == TBX_MB_ASCII_STATE_VALIDATION)
+    {
+      /* Update the result. */
+      result = tpCtx->rxPacket;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbAsciiGetRxPacket ***/
+
+
+/************************************************************************************//**
+** \brief     Interface function to be called by a channel to obtain write access to the
+**            transmission packet. Returns NULL is the packet is currently not
+**            accessible. Can by called to prepare the transmit packet before calling the
+**            transport layer's transmitFcn().
+** \param     transport Handle to ASCII transport layer object.
+** \return    Pointer to the packet or NULL if currently not accessible.
+**
+****************************************************************************************/
+static tTbxMbTpPacket * TbxMbAsciiGetTxPacket(tTbxMbTp transport)
+{
+  tTbxMbTpPacket * result = NULL;
+
+  /* Verify parameters. */
+  TBX_ASSERT(transport != NULL);
+
+  /* Only continue with valid parameters. */
+  if (transport != NULL)
+  {
+    /* Convert the TP channel pointer to the context structure. */
+    tTbxMbTpCtx * tpCtx = (tTbxMbTpCtx *)transport;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(tpCtx->type == TBX_MB_ASCII_CONTEXT_TYPE);
+    /* Access to the transmission packet by a channel is only allowed outside the 
+     * TRANSMISSION state. In this state the transmission path is locked until a
+     * transition back to IDLE state is made. This happens once the transport layer
+     * completed the packet transmission.
+     */
+    TbxCriticalSectionEnter();
+    uint8_t currentState = tpCtx->state;
+    TbxCriticalSectionExit();
+    if (currentState != TBX_MB_ASCII_STATE_TRANSMISSION)
+    {
+      /* Update the result. */
+      result = tpCtx->txPacket;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbAsciiGetTxPacket ***/
+
+
+/************************************************************************************//**
+** \brief     Event function to signal to this module that the entire transfer completed.
+**            Continues with the transmission of the next part of the packet, if any.
+** \attention This function should be called by the UART module.
+** \details   This function accesses the transport layer context, which is a shared
+**            resource. Even though this function is called at UART Tx interrupt level,
+**            it is still necessary to access the transport layer context through a
+**            critical section. On a multicore target, the event thread might run on
+**            one core, while this interrupt runs on another core. A critical section
+**            for such a target manages a spin lock, needed to have mutual exclusive
+**            access to the shared resource.
+** \param     port The serial port that the transfer completed on.
+**
+****************************************************************************************/
+static void TbxMbAsciiTransmitComplete(tTbxMbUartPort port)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(port < TBX_MB_UART_NUM_PORT);
+
+  /* Only continue with valid parameters. */
+  if (port < TBX_MB_UART_NUM_PORT)
+  {
+    /* Obtain transport layer context linked to UART port of this event. */
+    tTbxMbTpCtx volatile * tpCtx = tbxMbAsciiCtx[port];
+    /* Verify transport layer context. */
+    TBX_ASSERT(tpCtx != NULL)
+    /* Only continue with a valid transport layer context. Note that there is no need
+     * to also check the transport layer type, because only ASCII types are stored in
+     * the tbxMbAsciiCtx[] array.
+     */
+    if (tpCtx != NULL)
+    {
+      TbxCriticalSectionEnter();
+      uint8_t stateCopy = tpCtx->state;
+      TbxCriticalSectionExit();
+      /* This function should only be called when in the TRANSMISSION state. Verify
+       * this. 
+       */
+      TBX_ASSERT(stateCopy == TBX_MB_ASCII_STATE_TRANSMISSION);
+      /* Only continue in the TRANSMISSION state. Note that in the TRANSMISSION state,
+       * the transmission path is locked until a transition back to IDLE state is made.
+       * Consequently, there is no need for critical sections when accessing the
+       * txPacket and .asciiTxXyz elements of the TP context.
+       */
+      if (stateCopy == TBX_MB_ASCII_STATE_TRANSMISSION)
+      {
+        uint8_t txDone = TBX_TRUE;
+        /* Encode the next part of the packet. */
+        uint16_t txLen = TbxMbAsciiTxBufFill(tpCtx);
+        /* Still characters left to transmit? */
+        if (txLen > 0U)
+        {
+          /* Pass the next part of the transmit request on to the UART module. The cast
+           * removes the volatile qualifier. This is okay, because the buffer is not
+           * modified until the transfer completed.
+           */
+          if (TbxMbUartTransmit(tpCtx->port, (uint8_t const *)tpCtx->asciiTxBuf, 
+                                txLen) == TBX_OK)
+          {
+            txDone = TBX_FALSE;
+          }
+        }
+        /* All characters transmitted or the transmission could not be continued? */
+        if (txDone == TBX_TRUE)
+        {
+#if (TBX_MB_TRACE_ENABLE > 0U)
+          /* Timestamp the transmission completion of the packet. */
+          TbxMbTraceMark(tpCtx, TBX_MB_TRACE_POINT_TX_DONE);
+#endif
+          /* Transition back to the IDLE state. There is no minimum idle time between
+           * packets on ASCII, so this can be done right away.
+           */
+          TbxCriticalSectionEnter();
+          tpCtx->state = TBX_MB_ASCII_STATE_IDLE;
+          TbxCriticalSectionExit();
+          /* Post an event to the linked channel for inform them that the PDU
+           * transmission completed. In case the transmission could not be continued,
+           * a client detects this with its response timeout.
+           */
+          tTbxMbEvent newEvent;
+          newEvent.context = tpCtx->channelCtx;
+          newEvent.id = TBX_MB_EVENT_ID_PDU_TRANSMITTED;
+          TbxMbOsalEventPost(&newEvent, TBX_TRUE);
+        }
+      }
+    }
+  }
+} /*** end of TbxMbAsciiTransmitComplete ***/
+
+
+/************************************************************************************//**
+** \brief     Event function to signal the reception of new data to this module.
+** \attention This function should be called by the UART module. 
+** \details   This function accesses the transport layer context, which is a shared
+**            resource. Even though this function is called at UART Rx interrupt level,
+**            it is still necessary to access the transport layer context through a
+**            critical section. On a multicore target, the event thread might run on
+**            one core, while this interrupt runs on another core. A critical section
+**            for such a target manages a spin lock, needed to have mutual exclusive
+**            access to the shared resource.
+** \param     port The serial port that the transfer completed on.
+** \param     data Byte array with newly received data.
+** \param     len Number of newly received bytes.
+**
+****************************************************************************************/
+static void TbxMbAsciiDataReceived(tTbxMbUartPort         port, 
+                                   uint8_t        const * data, 
+                                   uint8_t                len)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((port < TBX_MB_UART_NUM_PORT) && 
+             (data != NULL) &&
+             (len > 0U));
+
+  /* Only continue with valid parameters. */
+  if ((port < TBX_MB_UART_NUM_PORT) && 
+      (data != NULL) &&
+      (len > 0U))
+  {
+    /* Obtain transport layer context linked to UART port of this event. */
+    tTbxMbTpCtx volatile * tpCtx = tbxMbAsciiCtx[port];
+    /* Verify transport layer context. */
+    TBX_ASSERT(tpCtx != NULL)
+    /* Only continue with a valid transport layer context. Note that there is no need
+     * to also check the transport layer type, because only ASCII types are stored in
+     * the tbxMbAsciiCtx[] array.
+     */
+    if (tpCtx != NULL)
+    {
+      TbxCriticalSectionEnter();
+      /* Process the newly received characters one by one. */
+      for (uint8_t idx = 0U; idx < len; idx++)
+      {
+        TbxMbAsciiRxChar(tpCtx, data[idx]);
+      }
+      TbxCriticalSectionExit();
+    }
+  }
+} /*** end of TbxMbAsciiDataReceived ***/
+
+
+/************************************************************************************//**
+** \brief     Processes a newly received character. The two hexadecimal characters of
+**            each ADU byte are decoded directly into the ADU of the reception packet,
+**            while the LRC is updated along the way. This way the packet is ready for
+**            processing as soon as its end is detected.
+** \attention This function should be called from TbxMbAsciiDataReceived() and from
+**            within a critical section.
+** \details   During the reception, rxAduWrIdx holds the number of hexadecimal characters
+**            received so far, rxAduDone flags the reception of the CR character and rxCrc
+**            holds the sum of all decoded ADU bytes.
+** \param     tpCtx Pointer to the ASCII transport layer context.
+** \param     rxChar The newly received character.
+**
+****************************************************************************************/
+static void TbxMbAsciiRxChar(tTbxMbTpCtx volatile * tpCtx,
+                             uint8_t                rxChar)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(tpCtx != NULL);
+
+  /* Only continue with valid parameters. */
+  if (tpCtx != NULL)
+  {
+    /* The start character starts a new packet. Even if one was still being received.
+     * This way the reception synchronizes with the start of the next packet, in case
+     * the end of the current packet got lost.
+     */
+    if (rxChar == TBX_MB_ASCII_CHAR_START)
+    {
+      /* Only possible in the IDLE or RECEPTION states. In the VALIDATION state, the
+       * reception path is locked until a transition back to IDLE state is made. In
+       * the TRANSMISSION state, it's just the echo of our own packet, if any.
+       */
+      if ((tpCtx->state == TBX_MB_ASCII_STATE_IDLE) ||
+          (tpCtx->state == TBX_MB_ASCII_STATE_RECEPTION))
+      {
+        /* Transition to the RECEPTION state and start at the beginning of the ADU. */
+        tpCtx->state = TBX_MB_ASCII_STATE_RECEPTION;
+        tpCtx->rxAduWrIdx = 0U;
+        tpCtx->rxAduDone = TBX_FALSE;
+        tpCtx->rxCrc = 0U;
+#if (TBX_MB_TRACE_ENABLE > 0U)
+        /* Timestamp the reception start of the packet. */
+        TbxMbTraceMark(tpCtx, TBX_MB_TRACE_POINT_RX_START);
+#endif
+      }
+    }
+    /* All other characters are only relevant while receiving a packet. */
+    else if (tpCtx->state == TBX_MB_ASCII_STATE_RECEPTION)
+    {
+      /* Was the CR character already received? */
+      if (tpCtx->rxAduDone == TBX_TRUE)
+      {
+        /* The LF character should follow it, to complete the packet. */
+        if (rxChar == TBX_MB_ASCII_CHAR_LF)
+        {
+          TbxMbAsciiRxFrameEnd(tpCtx);
+        }
+        /* Invalid end of the packet. */
+        else
+        {
+          /* Discard the packet by transitioning back to IDLE. */
+          tpCtx->state = TBX_MB_ASCII_STATE_IDLE;
+        }
+      }
+      /* Is this the CR character, which marks the start of the end of the packet? */
+      else if (rxChar == TBX_MB_ASCII_CHAR_CR)
+      {
+        tpCtx->rxAduDone = TBX_TRUE;
+      }
+      /* Must be a hexadecimal character. */
+      else
+      {
+        uint8_t nibble = TbxMbAsciiHexDecode(rxChar);
+        /* Not a hexadecimal character or the ADU reception buffer is full? */
+        if ((nibble == TBX_MB_ASCII_HEX_INVALID) ||
+            (tpCtx->rxAduWrIdx >= (TBX_MB_ASCII_ADU_LEN_MAX * 2U)))
+        {
+          /* Discard the packet by transitioning back to IDLE. */
+          tpCtx->state = TBX_MB_ASCII_STATE_IDLE;
+        }
+        else
+        {
+          /* The ADU for an ASCII packet starts at one byte before the PDU, which is the
+           * last byte of head[]. Get the pointer of where the ADU starts in the
+           * rxPacket.
+           */
+          uint8_t volatile * aduPtr = 
+            &tpCtx->rxPacket->head[TBX_MB_TP_ADU_HEAD_LEN_MAX-1U];
+          uint16_t aduIdx = tpCtx->rxAduWrIdx / 2U;
+          /* First character of the ADU byte? It holds the high nibble. */
+          if ((tpCtx->rxAduWrIdx % 2U) == 0U)
+          {
+            aduPtr[aduIdx] = (uint8_t)(nibble << 4U);
+          }
+          /* Second character of the ADU byte. It holds the low nibble. */
+          else
+          {
+            aduPtr[aduIdx] |= nibble;
+            /* Add the completed ADU byte to the sum for the LRC check. */
+            tpCtx->rxCrc = (uint8_t)(tpCtx->rxCrc + aduPtr[aduIdx]);
+          }
+          tpCtx->rxAduWrIdx++;
+        }
+      }
+    }
+    else
+    {
+      /* Nothing left to do, but MISRA requires this terminating else statement. */
+    }
+  }
+} /*** end of TbxMbAsciiRxChar ***/
+
+
+/************************************************************************************//**
+** \brief     Validates the newly received packet, once its end was detected. Only
+**            involves a few checks, because the LRC was updated during the reception.
+**            For a valid packet, it informs the linked channel right away. Otherwise it
+**            discards it.
+** \attention This function should be called from TbxMbAsciiRxChar() and from within a
+**            critical section.
+** \param     tpCtx Pointer to the ASCII transport layer context.
+**
+****************************************************************************************/
+static void TbxMbAsciiRxFrameEnd(tTbxMbTpCtx volatile * tpCtx)
+{
+  uint8_t valid = TBX_FALSE;
+
+  /* Verify parameters. */
+  TBX_ASSERT(tpCtx != NULL);
+
+  /* Only continue with valid parameters. */
+  if (tpCtx != NULL)
+  {
+    /* Increment the total number of received packets, regardless of addressing or
+     * LRC.
+     */
+    tpCtx->diagInfo.busMsgCnt++;
+    /* Determine the number of ADU bytes, which is half the number of hexadecimal
+     * characters.
+     */
+    uint16_t aduLen = tpCtx->rxAduWrIdx / 2U;
+    /* Check the ADU length. Each ADU byte consists of two characters. And it must at
+     * least have a node address, function code and LRC. Next, check the LRC. The sum of
+     * all ADU bytes, including the LRC itself, is zero for a packet that is not
+     * corrupted.
+     */
+    if (((tpCtx->rxAduWrIdx % 2U) != 0U) || (aduLen < TBX_MB_ASCII_ADU_LEN_MIN) ||
+        (tpCtx->rxCrc != 0U))
+    {
+      /* Increment the total number of received packets with an incorrect LRC. */
+      tpCtx->diagInfo.busCommErrCnt++;
+    }
+    /* Packet checks passed. */
+    else
+    {
+      /* Set the PDU data length field. It's the ADU length, minus:
+       * - Node address (1 byte)
+       * - Function code (1 byte)
+       * - LRC (1 byte)
+       */
+      tpCtx->rxPacket->dataLen = (uint8_t)(aduLen - 3U);
+      /* Also store the node address in the packet's node element. That's were 
+       * channels expect it. It's in the first byte of the ADU and the ADU starts
+       * at one byte before the PDU, which is the last byte of head[].
+       */
+      tpCtx->rxPacket->node = tpCtx->rxPacket->head[TBX_MB_TP_ADU_HEAD_LEN_MAX-1U];
+      /* Continue checking if the ADU is addressed to us. This check is different for a
+       * server and a client. Start with the server case.
+       */
+      if (tpCtx->isClient == TBX_FALSE)
+      {
+        /* Only process frames that are addressed to us (unicast or broadcast). */
+        if ((tpCtx->rxPacket->node == tpCtx->nodeAddr) ||
+            (tpCtx->rxPacket->node == TBX_MB_TP_NODE_ADDR_BROADCAST))
+        {
+          /* Increment the total number of received packets with a correct LRC, that
+           * were addressed to us. Either via unicast of broadcast.
+           */
+          tpCtx->diagInfo.srvMsgCnt++;
+          /* Set the node address in the txPacket node element. It is used during
+           * transmission to decide if the actual sending of the response should be
+           * suppressed, which is the case for TBX_MB_TP_NODE_ADDR_BROADCAST. 
+           */
+          tpCtx->txPacket->node = tpCtx->rxPacket->node;
+          /* Packet is valid. */
+          valid = TBX_TRUE;
+        }
+      }
+      /* Linked to a client channel. */
+      else
+      {
+        /* Only process frames that are send from a valid server. */
+        if ( (tpCtx->rxPacket->node >= TBX_MB_TP_NODE_ADDR_MIN) &&
+             (tpCtx->rxPacket->node <= TBX_MB_TP_NODE_ADDR_MAX) )
+        {
+          /* Packet is valid. */
+          valid = TBX_TRUE;
+        }
+      }
+    }
+    /* Newly received packet is valid? */
+    if (valid == TBX_TRUE)
+    {
+      /* Transition to the VALIDATION state. This locks the reception path, until the
+       * channel is done with the packet.
+       */
+      tpCtx->state = TBX_MB_ASCII_STATE_VALIDATION;
+#if (TBX_MB_TRACE_ENABLE > 0U)
+      /* Timestamp the reception end of the packet. */
+      TbxMbTraceMark(tpCtx, TBX_MB_TRACE_POINT_RX_END);
+#endif
+      /* Post an event to the linked channel for further processing of the PDU. */
+      tTbxMbEvent pduRxEvent;
+      pduRxEvent.context = tpCtx->channelCtx;
+      pduRxEvent.id = TBX_MB_EVENT_ID_PDU_RECEIVED;
+      TbxMbOsalEventPost(&pduRxEvent, TBX_TRUE);
+    }
+    else
+    {
+      /* Discard the newly received packet by transitioning back to IDLE. */
+      tpCtx->state = TBX_MB_ASCII_STATE_IDLE;
+    }
+  }
+} /*** end of TbxMbAsciiRxFrameEnd ***/
+
+
+/************************************************************************************//**
+** \brief     Encodes the next part of the ADU in the transmission packet into the
+**            asciiTxBuf[] buffer. The first part starts with the start character and the
+**            last part ends with the CR and LF characters.
+** \attention Should only be called in the TRANSMISSION state, after preparing the ADU
+**            and resetting asciiTxIdx to zero for the first part.
+** \param     tpCtx Pointer to the ASCII transport layer context.
+** \return    Number of characters stored in the asciiTxBuf[] buffer. Zero if all
+**            characters of the packet were already encoded.
+**
+****************************************************************************************/
+static uint16_t TbxMbAsciiTxBufFill(tTbxMbTpCtx volatile * tpCtx)
+{
+  uint16_t result = 0U;
+  /* Lookup table for encoding a nibble as a hexadecimal character. */
+  static const uint8_t hexChars[] =
+  {
+    (uint8_t)'0', (uint8_t)'1', (uint8_t)'2', (uint8_t)'3',
+    (uint8_t)'4', (uint8_t)'5', (uint8_t)'6', (uint8_t)'7',
+    (uint8_t)'8', (uint8_t)'9', (uint8_t)'A', (uint8_t)'B',
+    (uint8_t)'C', (uint8_t)'D', (uint8_t)'E', (uint8_t)'F'
+  };
+
+  /* Verify parameters. */
+  TBX_ASSERT(tpCtx != NULL);
+
+  /* Only continue with valid parameters. */
+  if (tpCtx != NULL)
+  {
+    /* The ADU starts at one byte before the PDU, which is the last byte of head[]. It
+     * consists of the node address, function code, packet data and LRC.
+     */
+    uint8_t const volatile * aduPtr =
+      &tpCtx->txPacket->head[TBX_MB_TP_ADU_HEAD_LEN_MAX-1U];
+    uint16_t aduLen = tpCtx->txPacket->dataLen + 3U;
+    /* Add the start character at the start of the first part. */
+    if (tpCtx->asciiTxIdx == 0U)
+    {
+      tpCtx->asciiTxBuf[result] = TBX_MB_ASCII_CHAR_START;
+      result++;
+    }
+    /* Encode as many ADU bytes as still fit, each as two hexadecimal characters. */
+    while ((tpCtx->asciiTxIdx < aduLen) && 
+           ((result + 2U) <= TBX_MB_TP_ASCII_TX_BUF_LEN))
+    {
+      uint8_t aduByte = aduPtr[tpCtx->asciiTxIdx];
+      tpCtx->asciiTxBuf[result] = hexChars[aduByte >> 4U];
+      tpCtx->asciiTxBuf[result + 1U] = hexChars[aduByte & 0x0FU];
+      result += 2U;
+      tpCtx->asciiTxIdx++;
+    }
+    /* Add the CR and LF characters after the last ADU byte, if they still fit. The
+     * index then moves past the end of the ADU, to mark that all characters are encoded.
+     */
+    if ((tpCtx->asciiTxIdx == aduLen) && ((result + 2U) <= TBX_MB_TP_ASCII_TX_BUF_LEN))
+    {
+      tpCtx->asciiTxBuf[result] = TBX_MB_ASCII_CHAR_CR;
+      tpCtx->asciiTxBuf[result + 1U] = TBX_MB_ASCII_CHAR_LF;
+      result += 2U;
+      tpCtx->asciiTxIdx++;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbAsciiTxBufFill ***/
+
+
+/************************************************************************************//**
+** \brief     Decodes a hexadecimal character to the value of its nibble. The Modbus
+**            protocol specifies upper case characters, yet lower case characters are
+**            accepted as well.
+** \param     hexChar The hexadecimal character to decode.
+** \return    Value of the nibble (0..15) or TBX_MB_ASCII_HEX_INVALID if the character is
+**            not a hexadecimal character.
+**
+****************************************************************************************/
+static uint8_t TbxMbAsciiHexDecode(uint8_t hexChar)
+{
+  uint8_t result = TBX_MB_ASCII_HEX_INVALID;
+
+  if ((hexChar >= (uint8_t)'0') && (hexChar <= (uint8_t)'9'))
+  {
+    result = hexChar - (uint8_t)'0';
+  }
+  else if ((hexChar >= (uint8_t)'A') && (hexChar <= (uint8_t)'F'))
+  {
+    result = (hexChar - (uint8_t)'A') + 10U;
+  }
+  else if ((hexChar >= (uint8_t)'a') && (hexChar <= (uint8_t)'f'))
+  {
+    result = (hexChar - (uint8_t)'a') + 10U;
+  }
+  else
+  {
+    /* Not a hexadecimal character. Keep the result at its invalid value. */
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbAsciiHexDecode ***/
+
+
+/*********************************** end of tbxmb_ascii.c ******************************/
@@ -45,11 +45,140 @@
 /** \brief Unique context type to identify a context as being a client channel. */
 #define TBX_MB_CLIENT_CONTEXT_TYPE     (23U)
 
+/** \brief Request code for a custom function request. Function code 0 is not valid in
+ *         Modbus, meaning that it cannot conflict with a supported function code.
+ */
+#define TBX_MB_CLIENT_CODE_CUSTOM      (0U)
+
+/** \brief Request code for a custom function request, of which the PDUs are built and
+ *         parsed in place. Value 0x80 would be the exception response to function code
+ *         0, which means that it cannot conflict with a supported function code either.
+ */
+#define TBX_MB_CLIENT_CODE_CUSTOM_IN_PLACE (0x80U)
+
+/* Asynchronous request states. */
+/** \brief No asynchronous request in progress. */
+#define TBX_MB_CLIENT_ASYNC_STATE_IDLE            (0U)
+
+/** \brief Waiting for the asynchronous request packet transmission to complete. */
+#define TBX_MB_CLIENT_ASYNC_STATE_TRANSMISSION    (1U)
+
+/** \brief Waiting for the response to the asynchronous request packet. */
+#define TBX_MB_CLIENT_ASYNC_STATE_RECEPTION       (2U)
+
+
+/****************************************************************************************
+* Configuration check
+****************************************************************************************/
+#if (TBX_MB_CLIENT_QUEUE_SIZE > 255U)
+#error "TBX_MB_CLIENT_QUEUE_SIZE must be in the range 0..255"
+#endif
+
+#if (TBX_MB_CLIENT_NODE_STATS_SIZE > 247U)
+#error "TBX_MB_CLIENT_NODE_STATS_SIZE must be in the range 0..247"
+#endif
+
+#if ((TBX_MB_CLIENT_TIMEOUT_MIN_MS < 1U) || (TBX_MB_CLIENT_TIMEOUT_MIN_MS > 65535U))
+#error "TBX_MB_CLIENT_TIMEOUT_MIN_MS must be in the range 1..65535"
+#endif
+
+#if (TBX_MB_CLIENT_BACKOFF_TIMEOUTS > 255U)
+#error "TBX_MB_CLIENT_BACKOFF_TIMEOUTS must be in the range 0..255"
+#endif
+
+#if ((TBX_MB_CLIENT_BACKOFF_PROBE < 1U) || (TBX_MB_CLIENT_BACKOFF_PROBE > 255U))
+#error "TBX_MB_CLIENT_BACKOFF_PROBE must be in the range 1..255"
+#endif
+
 
 /****************************************************************************************
 * Function prototypes
 ****************************************************************************************/
-static void TbxMbClientProcessEvent(tTbxMbEvent * event);
+static void    TbxMbClientInit        (tTbxMbClientCtx   * newClientCtx,
+                                       tTbxMbTp            transport,
+                                       uint8_t             isStatic,
+                                       uint16_t            responseTimeout,
+                                       uint16_t            turnaroundDelay);
+
+static void    TbxMbClientProcessEvent(tTbxMbEvent       * event);
+
+static void    TbxMbClientPoll        (tTbxMbClient        channel);
+
+static uint8_t TbxMbClientReqExecute  (tTbxMbClientCtx   * clientCtx,
+                                       tTbxMbClientReq   * request);
+
+static uint8_t TbxMbClientBatchExecute(tTbxMbClientCtx   * clientCtx,
+                                       tTbxMbClientReq   * request,
+                                       uint8_t           * turnaroundPending,
+                                       uint16_t          * turnaroundTicks);
+
+static void    TbxMbClientTurnaroundWait(tTbxMbClientCtx * clientCtx,
+                                       uint16_t            turnaroundTicks);
+
+static uint8_t TbxMbClientReqSubmit   (tTbxMbClientCtx   * clientCtx,
+                                       tTbxMbClientReq   * request);
+
+static uint8_t TbxMbClientReqStart    (tTbxMbClientCtx   * clientCtx);
+
+static void    TbxMbClientRxFlush     (tTbxMbClientCtx   * clientCtx);
+
+static uint8_t TbxMbClientReqNext     (tTbxMbClientCtx   * clientCtx);
+
+static void    TbxMbClientReqDone     (tTbxMbClientCtx   * clientCtx,
+                                       uint8_t             result);
+
+#if (TBX_MB_CLIENT_QUEUE_SIZE > 0U)
+static void    TbxMbClientQueueInsert (tTbxMbClientCtx   * clientCtx,
+                                       tTbxMbClientReq   * request);
+
+#if (TBX_MB_CLIENT_QUEUE_WRITES_FIRST > 0U)
+static uint8_t TbxMbClientReqIsWrite  (uint8_t             code);
+#endif
+#endif
+
+static uint8_t TbxMbClientReqBuild    (tTbxMbClientCtx   * clientCtx,
+                                       tTbxMbClientReq   * request);
+
+static uint8_t TbxMbClientRespProcess (tTbxMbClientCtx   * clientCtx,
+                                       tTbxMbClientReq   * request);
+
+static uint8_t TbxMbClientDevIdBuild  (tTbxMbClient        channel,
+                                       uint8_t           * pdu,
+                                       uint8_t           * len,
+                                       void              * param);
+
+static uint8_t TbxMbClientDevIdParse  (tTbxMbClient        channel,
+                                       uint8_t     const * pdu,
+                                       uint8_t             len,
+                                       void              * param);
+
+static uint8_t  TbxMbClientNodeAllowed(tTbxMbClientCtx   * clientCtx,
+                                       uint8_t             node);
+
+static uint16_t TbxMbClientNodeTimeout(tTbxMbClientCtx   * clientCtx,
+                                       uint8_t             node);
+
+static void     TbxMbClientNodeRxStart(tTbxMbClientCtx   * clientCtx);
+
+static void     TbxMbClientNodeUpdate (tTbxMbClientCtx   * clientCtx,
+                                       uint8_t             node,
+                                       uint8_t             responded);
+
+#if (TBX_MB_CLIENT_NODE_STATS_SIZE > 0U)
+static tTbxMbClientNodeInfo * TbxMbClientNodeFind(tTbxMbClientCtx * clientCtx,
+                                                  uint8_t           node,
+                                                  uint8_t           create);
+#endif
+
+
+/****************************************************************************************
+* Local constant declarations
+****************************************************************************************/
+/** \brief Data for the loopback test of diagnostics subcode TBX_MB_DIAG_SC_QUERY_DATA. */
+static const uint16_t tbxMbClientDiagQueryData[] =
+{
+  0xFFFFU, 0x0000U, 0xAA55U, 0x55AAU, 0x3723U
+};
 
 
 /************************************************************************************//**
@@ -86,33 +215,16 @@ tTbxMbClient TbxMbClientCreate(tTbxMbTp transport,
        * allocation fails too, which is verified later on.
        */
       (void)TbxMemPoolCreate(1U, sizeof(tTbxMbClientCtx));
-      newClientCtx = TbxMemPoolAllocate(sizeof(tTbxMbClientCtx));      
+      newClientCtx = TbxMemPoolAllocate(sizeof(tTbxMbClientCtx));
     }
     /* Verify memory allocation of the channel context. */
     TBX_ASSERT(newClientCtx != NULL);
     /* Only continue if the memory allocation succeeded. */
     if (newClientCtx != NULL)
     {
-      /* Convert the TP channel pointer to the context structure. */
-      tTbxMbTpCtx * tpCtx = (tTbxMbTpCtx *)transport;
-      /* Sanity check on the transport layer's interface function. That way there is 
-       * no need to do it later on, making it more run-time efficient. Also check that
-       * it's not already linked to another channel.
-       */
-      TBX_ASSERT((tpCtx->transmitFcn != NULL) && (tpCtx->receptionDoneFcn != NULL) &&
-                 (tpCtx->getRxPacketFcn != NULL) && (tpCtx->getTxPacketFcn != NULL) &&
-                 (tpCtx->channelCtx == NULL));
-      /* Initialize the channel context. Start by crosslinking the transport layer. */
-      newClientCtx->type = TBX_MB_CLIENT_CONTEXT_TYPE;
-      newClientCtx->instancePtr = NULL;
-      newClientCtx->pollFcn = NULL;
-      newClientCtx->processFcn = TbxMbClientProcessEvent;
-      newClientCtx->responseTimeout = responseTimeout;
-      newClientCtx->turnaroundDelay = turnaroundDelay;
-      newClientCtx->transceiveSem = TbxMbOsalSemCreate();
-      newClientCtx->tpCtx = tpCtx;
-      newClientCtx->tpCtx->channelCtx = newClientCtx;
-      newClientCtx->tpCtx->isClient = TBX_TRUE;
+      /* Initialize the channel context. */
+      TbxMbClientInit(newClientCtx, transport, TBX_FALSE, responseTimeout,
+                      turnaroundDelay);
       /* Update the result. */
       result = newClientCtx;
     }
@@ -122,9 +234,50 @@ tTbxMbClient TbxMbClientCreate(tTbxMbTp transport,
 } /*** end of TbxMbClientCreate ****/
 
 
+/************************************************************************************//**
+** \brief     Creates a Modbus client channel object in storage that the caller
+**            provides, instead of allocating it from a memory pool. Afterwards, it
+**            assigns the specified Modbus transport layer to the channel for packet
+**            transmission and reception. The storage must remain valid until the
+**            object is released with TbxMbClientFree().
+** \param     storage Pointer to the storage for the client channel object.
+** \param     transport Handle to a previously created Modbus transport layer object to
+**            assign to the channel.
+** \param     responseTimeout Maximum time in milliseconds to wait for a response from
+**            the Modbus server, after sending a PDU.
+** \param     turnaroundDelay Delay time in milliseconds after sending a broadcast PDU
+**            to give all recipients sufficient time to process the PDU.
+** \return    Handle to the newly created Modbus client channel object if successful,
+**            NULL otherwise.
+**
+****************************************************************************************/
+tTbxMbClient TbxMbClientCreateStatic(tTbxMbClientStorage * storage,
+                                     tTbxMbTp              transport,
+                                     uint16_t              responseTimeout,
+                                     uint16_t              turnaroundDelay)
+{
+  tTbxMbClient result = NULL;
+
+  /* Verify parameters. */
+  TBX_ASSERT((storage != NULL) && (transport != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((storage != NULL) && (transport != NULL))
+  {
+    /* Initialize the channel context. */
+    TbxMbClientInit(&storage->ctx, transport, TBX_TRUE, responseTimeout,
+                    turnaroundDelay);
+    /* Update the result. */
+    result = &storage->ctx;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientCreateStatic ****/
+
+
 /************************************************************************************//**
 ** \brief     Releases a Modbus client channel object, previously created with
-**            TbxMbClientCreate().
+**            TbxMbClientCreate() or TbxMbClientCreateStatic().
 ** \param     channel Handle to the Modbus client channel object to release.
 **
 ****************************************************************************************/
@@ -151,13 +304,96 @@ void TbxMbClientFree(tTbxMbClient channel)
     clientCtx->pollFcn = NULL;
     clientCtx->processFcn = NULL;
     clientCtx->transceiveSem = NULL;
+    clientCtx->asyncState = TBX_MB_CLIENT_ASYNC_STATE_IDLE;
+#if (TBX_MB_CLIENT_QUEUE_SIZE > 0U)
+    /* Discard the queued asynchronous requests. */
+    clientCtx->asyncQueueCount = 0U;
+#endif
     TbxCriticalSectionExit();
-    /* Give the channel context back to the memory pool. */
-    TbxMemPoolRelease(clientCtx);
+    /* Remove the context from the poller array of its event task right away, such
+     * that its poll function is no longer called after releasing it.
+     */
+    TbxMbEventPollerRelease(clientCtx);
+    /* Give the channel context back to the memory pool, unless it is located in
+     * storage that the caller provided.
+     */
+    if (clientCtx->isStatic == TBX_FALSE)
+    {
+      TbxMemPoolRelease(clientCtx);
+    }
   }
 } /*** end of TbxMbClientFree ***/
 
 
+/************************************************************************************//**
+** \brief     Initializes a Modbus client channel object in the specified context and
+**            assigns the specified Modbus transport layer to the channel.
+** \param     newClientCtx Pointer to the client channel context to initialize.
+** \param     transport Handle to a previously created Modbus transport layer object to
+**            assign to the channel.
+** \param     isStatic TBX_TRUE if the caller provided the storage, TBX_FALSE if it was
+**            allocated from a memory pool.
+** \param     responseTimeout Maximum time in milliseconds to wait for a response from
+**            the Modbus server, after sending a PDU.
+** \param     turnaroundDelay Delay time in milliseconds after sending a broadcast PDU
+**            to give all recipients sufficient time to process the PDU.
+**
+****************************************************************************************/
+static void TbxMbClientInit(tTbxMbClientCtx * newClientCtx,
+                            tTbxMbTp          transport,
+                            uint8_t           isStatic,
+                            uint16_t          responseTimeout,
+                            uint16_t          turnaroundDelay)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((newClientCtx != NULL) && (transport != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((newClientCtx != NULL) && (transport != NULL))
+  {
+    /* Convert the TP channel pointer to the context structure. */
+    tTbxMbTpCtx * tpCtx = (tTbxMbTpCtx *)transport;
+    /* Sanity check on the transport layer's interface function. That way there is
+     * no need to do it later on, making it more run-time efficient. Also check that
+     * it's not already linked to another channel.
+     */
+    TBX_ASSERT((tpCtx->transmitFcn != NULL) && (tpCtx->receptionDoneFcn != NULL) &&
+               (tpCtx->getRxPacketFcn != NULL) && (tpCtx->getTxPacketFcn != NULL) &&
+               (tpCtx->channelCtx == NULL));
+    /* A client receives its response while it might still need the request. It can
+     * therefore not work with a compact transport layer that shares one packet buffer
+     * for reception and transmission.
+     */
+    TBX_ASSERT(tpCtx->rxPacket != tpCtx->txPacket);
+    /* Initialize the channel context. Start by crosslinking the transport layer. */
+    newClientCtx->type = TBX_MB_CLIENT_CONTEXT_TYPE;
+    newClientCtx->instancePtr = NULL;
+    newClientCtx->pollFcn = TbxMbClientPoll;
+    newClientCtx->processFcn = TbxMbClientProcessEvent;
+    newClientCtx->pollInfo.count = 0U;
+    newClientCtx->pollInfo.task = tpCtx->pollInfo.task;
+    newClientCtx->responseTimeout = responseTimeout;
+    newClientCtx->turnaroundDelay = turnaroundDelay;
+    newClientCtx->isStatic = isStatic;
+    newClientCtx->transceiveSem = TbxMbOsalSemCreate();
+    newClientCtx->asyncState = TBX_MB_CLIENT_ASYNC_STATE_IDLE;
+    newClientCtx->asyncWaitMs = 0U;
+    newClientCtx->asyncMsTime = 0U;
+#if (TBX_MB_CLIENT_QUEUE_SIZE > 0U)
+    newClientCtx->asyncQueueCount = 0U;
+#endif
+#if (TBX_MB_CLIENT_NODE_STATS_SIZE > 0U)
+    newClientCtx->nodeInfoCount = 0U;
+    newClientCtx->nodeInfoNext = 0U;
+    newClientCtx->rxTicks = 0U;
+#endif
+    newClientCtx->tpCtx = tpCtx;
+    newClientCtx->tpCtx->channelCtx = newClientCtx;
+    newClientCtx->tpCtx->isClient = TBX_TRUE;
+  }
+} /*** end of TbxMbClientInit ***/
+
+
 /************************************************************************************//**
 ** \brief     Event processing function that is automatically called when an event for
 **            this client channel object was received in TbxMbEventTask().
@@ -184,24 +420,76 @@ static void TbxMbClientProcessEvent(tTbxMbEvent * event)
     {
       /* Sanity check on the context type. */
       TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+      /* Get a copy of the asynchronous request state. */
+      TbxCriticalSectionEnter();
+      uint8_t asyncStateCopy = clientCtx->asyncState;
+      TbxCriticalSectionExit();
       /* Filter on the event identifier. */
       switch (event->id)
       {
         case TBX_MB_EVENT_ID_PDU_RECEIVED:
         {
-          /* Give the PDU received semaphore to synchronize whatever task is waiting
-           * for this event.
-           */
-          TbxMbOsalSemGive(clientCtx->transceiveSem, TBX_FALSE);
+          /* Waiting for the response to an asynchronous request? */
+          if (asyncStateCopy == TBX_MB_CLIENT_ASYNC_STATE_RECEPTION)
+          {
+            /* Only unicast requests expect a response. */
+            if (clientCtx->asyncReq.node != TBX_MB_TP_NODE_ADDR_BROADCAST)
+            {
+              /* Update the response time statistics of the node. */
+              TbxMbClientNodeUpdate(clientCtx, clientCtx->asyncReq.node, TBX_TRUE);
+              /* Process the response and complete the request. */
+              uint8_t result = TbxMbClientRespProcess(clientCtx, &clientCtx->asyncReq);
+              TbxMbClientReqDone(clientCtx, result);
+            }
+            /* Packet received during the turnaround delay of a broadcast request. */
+            else
+            {
+              /* Not expected, so inform the transport layer that we no longer need
+               * access to the rx packet.
+               */
+              clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
+            }
+          }
+          /* Response to a blocking request. */
+          else
+          {
+            /* Give the PDU received semaphore to synchronize whatever task is waiting
+             * for this event.
+             */
+            TbxMbOsalSemGive(clientCtx->transceiveSem, TBX_FALSE);
+          }
         }
         break;
 
         case TBX_MB_EVENT_ID_PDU_TRANSMITTED:
         {
-          /* Give the PDU transmitted semaphore to synchronize whatever task is waiting
-           * for this event.
-           */
-          TbxMbOsalSemGive(clientCtx->transceiveSem, TBX_FALSE);
+          /* Transmission of an asynchronous request completed? */
+          if (asyncStateCopy == TBX_MB_CLIENT_ASYNC_STATE_TRANSMISSION)
+          {
+            /* Restart the wait timer. For a unicast request, this is for the response
+             * reception. For a broadcast request, this is the turnaround delay.
+             */
+            clientCtx->asyncWaitMs = TbxMbClientNodeTimeout(clientCtx,
+                                                            clientCtx->asyncReq.node);
+            if (clientCtx->asyncReq.node == TBX_MB_TP_NODE_ADDR_BROADCAST)
+            {
+              clientCtx->asyncWaitMs = clientCtx->turnaroundDelay;
+            }
+            clientCtx->asyncMsTime = TbxMbPortTimerCount();
+            TbxMbClientNodeRxStart(clientCtx);
+            /* Transition to the asynchronous request reception state. */
+            TbxCriticalSectionEnter();
+            clientCtx->asyncState = TBX_MB_CLIENT_ASYNC_STATE_RECEPTION;
+            TbxCriticalSectionExit();
+          }
+          /* Transmission of a blocking request completed. */
+          else
+          {
+            /* Give the PDU transmitted semaphore to synchronize whatever task is
+             * waiting for this event.
+             */
+            TbxMbOsalSemGive(clientCtx->transceiveSem, TBX_FALSE);
+          }
         }
         break;
 
@@ -217,26 +505,109 @@ static void TbxMbClientProcessEvent(tTbxMbEvent * event)
 } /*** end of TbxMbClientProcessEvent ***/
 
 
+/************************************************************************************//**
+** \brief     Event polling function that is automatically called during each call of
+**            TbxMbEventTask(), if activated. Use the TBX_MB_EVENT_ID_START_POLLING and
+**            TBX_MB_EVENT_ID_STOP_POLLING events to activate and deactivate. Activated
+**            while an asynchronous request is in progress, to detect its timeout.
+** \param     channel Handle to the Modbus client channel object.
+**
+****************************************************************************************/
+static void TbxMbClientPoll(tTbxMbClient channel)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(channel != NULL);
+
+  /* Only continue with valid parameters. */
+  if (channel != NULL)
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    /* Get a copy of the asynchronous request state. */
+    TbxCriticalSectionEnter();
+    uint8_t asyncStateCopy = clientCtx->asyncState;
+    TbxCriticalSectionExit();
+    /* Only continue if an asynchronous request is in progress. */
+    if (asyncStateCopy != TBX_MB_CLIENT_ASYNC_STATE_IDLE)
+    {
+      /* Get the number of ticks that elapsed since the last millisecond detection. Note
+       * that this calculation works, even if the 20 kHz timer counter overflowed.
+       */
+      uint16_t deltaTicks = TbxMbPortTimerCount() - clientCtx->asyncMsTime;
+      /* Determine how many milliseconds passed since the last one was detected. */
+      uint16_t deltaMs = deltaTicks / 20U;
+      /* Did one or more milliseconds pass? */
+      if (deltaMs > 0U)
+      {
+        /* Update the last millisecond detection tick time. Needed for the detection of
+         * the next millisecond. Note that this calculation works, even if the
+         * asyncMsTime element overflows.
+         */
+        clientCtx->asyncMsTime += (deltaMs * 20U);
+        /* Subtract the elapsed milliseconds from the remaining wait time, with
+         * underflow protection.
+         */
+        if (clientCtx->asyncWaitMs > deltaMs)
+        {
+          clientCtx->asyncWaitMs -= deltaMs;
+        }
+        else
+        {
+          clientCtx->asyncWaitMs = 0U;
+        }
+        /* Wait time passed? */
+        if (clientCtx->asyncWaitMs == 0U)
+        {
+          /* Either no response was received or the packet transmission did not
+           * complete, which are errors. Or the turnaround time after the broadcast
+           * request passed, which is okay.
+           */
+          uint8_t result = TBX_ERROR;
+          if (asyncStateCopy == TBX_MB_CLIENT_ASYNC_STATE_RECEPTION)
+          {
+            if (clientCtx->asyncReq.node == TBX_MB_TP_NODE_ADDR_BROADCAST)
+            {
+              result = TBX_OK;
+            }
+            /* Response timeout, so update the statistics of the node. */
+            else
+            {
+              TbxMbClientNodeUpdate(clientCtx, clientCtx->asyncReq.node, TBX_FALSE);
+            }
+          }
+          /* Complete the request. */
+          TbxMbClientReqDone(clientCtx, result);
+        }
+      }
+    }
+  }
+} /*** end of TbxMbClientPoll ***/
+
+
 /************************************************************************************//**
 ** \brief     Helper function to both transmit a request packet and receive the reponse
 **            packet, if applicable (unicast).
 ** \param     clientCtx Pointer to the Modbus client channel for the requested operation.
-** \param     isBroadcast TBX_TRUE for sending a broadcast request, TBX_FALSE for
-**            unicast.
+** \param     node The address of the server. TBX_MB_TP_NODE_ADDR_BROADCAST for sending
+**            a broadcast request.
 ** \return    TBX_OK if the request packet could be transmitted and (a) a response for
 **            the unicast request was received or (b) the turnaround timeout passed after
 **            sending the broadcast request. TBX_ERROR otherwise.
 **
 ****************************************************************************************/
 static uint8_t TbxMbClientTransceive(tTbxMbClientCtx * clientCtx,
-                                     uint8_t           isBroadcast)
+                                     uint8_t           node)
 {
   uint8_t  result      = TBX_ERROR;
-  uint16_t waitTimeout = clientCtx->responseTimeout;
+  uint8_t  isBroadcast = TBX_FALSE;
+  uint16_t waitTimeout = TbxMbClientNodeTimeout(clientCtx, node);
 
   /* Update the wait time in case it is a broadcast request. */
-  if (isBroadcast == TBX_TRUE)
+  if (node == TBX_MB_TP_NODE_ADDR_BROADCAST)
   {
+    isBroadcast = TBX_TRUE;
     waitTimeout = clientCtx->turnaroundDelay;
   }
 
@@ -264,6 +635,7 @@ static uint8_t TbxMbClientTransceive(tTbxMbClientCtx * clientCtx,
     if (result == TBX_OK)
     {
       /* Wait for the reception of the response from the server, with a timeout. */
+      TbxMbClientNodeRxStart(clientCtx);
       if (TbxMbOsalSemTake(clientCtx->transceiveSem, waitTimeout) == TBX_FALSE)
       {
         /* Semaphore timeout occured. Either because no response was received, which
@@ -276,6 +648,12 @@ static uint8_t TbxMbClientTransceive(tTbxMbClientCtx * clientCtx,
           result = TBX_ERROR;
         }
       }
+      /* Update the response time statistics of the node, if unicast. */
+      if (isBroadcast == TBX_FALSE)
+      {
+        uint8_t responded = (result == TBX_OK) ? TBX_TRUE : TBX_FALSE;
+        TbxMbClientNodeUpdate(clientCtx, node, responded);
+      }
     }
   }
   /* Give the result back to the caller. */
@@ -284,880 +662,3148 @@ static uint8_t TbxMbClientTransceive(tTbxMbClientCtx * clientCtx,
 
 
 /************************************************************************************//**
-** \brief     Reads the coil(s) from the server with the specified node address.
-** \param     channel Handle to the Modbus client channel for the requested operation.
-** \param     node The address of the server. This parameter is transport layer
-**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
-**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
-** \param     addr Starting element address (0..65535) in the Modbus data table for the
-**            coil read operation.
-** \param     num Number of elements to read from the coils data table. Range can be
-**            1..2000.
-** \param     coils Pointer to array with TBX_ON / TBX_OFF values where the coil state
-**            will be written to.
+** \brief     Helper function to execute a request in a blocking manner. It transmits
+**            the request packet and waits for the response to a unicast request to come
+**            in or the turnaround time to pass for a broadcast request.
+** \param     clientCtx Pointer to the Modbus client channel for the requested operation.
+** \param     request Pointer to the request to execute.
 ** \return    TBX_OK if successful, TBX_ERROR otherwise.
 **
 ****************************************************************************************/
-uint8_t TbxMbClientReadCoils(tTbxMbClient   channel,
-                             uint8_t        node,
-                             uint16_t       addr,
-                             uint16_t       num,
-                             uint8_t      * coils)
+static uint8_t TbxMbClientReqExecute(tTbxMbClientCtx * clientCtx,
+                                     tTbxMbClientReq * request)
 {
   uint8_t result = TBX_ERROR;
 
-  /* Verify the parameters. */
-  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
-             (num <= 2000U) && (coils != NULL));
-
-  /* Only continue with valid parameters. */
-  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
-      (num <= 2000U) && (coils != NULL))
+  /* A blocking request cannot be executed while an asynchronous request is in
+   * progress, because they share the same transport layer packets.
+   */
+  TbxCriticalSectionEnter();
+  uint8_t asyncStateCopy = clientCtx->asyncState;
+  TbxCriticalSectionExit();
+  if (asyncStateCopy == TBX_MB_CLIENT_ASYNC_STATE_IDLE)
   {
-    /* Convert the client channel pointer to the context structure. */
-    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
-    /* Sanity check on the context type. */
-    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
-
-    /* Obtain write access to the request packet. */
-    tTbxMbTpPacket * txPacket = clientCtx->tpCtx->getTxPacketFcn(clientCtx->tpCtx);
-    /* Should always work, unless this function is being called recursively. Only
-     * continue with access for preparing the request packet.
-     */
-    if (txPacket != NULL)
+    /* Release a late response to an earlier request, if any. */
+    TbxMbClientRxFlush(clientCtx);
+    /* Requests to a backed off node fail right away, unless it's time to probe it. */
+    if (TbxMbClientNodeAllowed(clientCtx, request->node) == TBX_TRUE)
     {
       /* Prepare the request packet. */
-      txPacket->node = node;
-      txPacket->pdu.code = TBX_MB_FC01_READ_COILS;
-      txPacket->dataLen = 4U;
-      /* Starting address. */
-      TbxMbCommonStoreUInt16BE(addr, &txPacket->pdu.data[0]);
-      /* Number of coils. */
-      TbxMbCommonStoreUInt16BE(num, &txPacket->pdu.data[2]);
-
+      result = TbxMbClientReqBuild(clientCtx, request);
+    }
+    /* Only continue if the request packet could be prepared. */
+    if (result == TBX_OK)
+    {
       /* Determine the request type (broadcast / unicast). */
       uint8_t isBroadcast = TBX_FALSE;
-      if (node == TBX_MB_TP_NODE_ADDR_BROADCAST)
+      if (request->node == TBX_MB_TP_NODE_ADDR_BROADCAST)
       {
         isBroadcast = TBX_TRUE;
       }
       /* Transmit the request and wait for the response to a unicast request to come in
        * or the turnaround time to pass for a broadcast request.
        */
-      result = TbxMbClientTransceive(clientCtx, isBroadcast);
-
-      /* Only continue with processing the response if all is okay so far and the request
-       * was unicast.
+      result = TbxMbClientTransceive(clientCtx, request->node);
+      /* Only continue with processing the response if all is okay so far and the
+       * request was unicast.
        */
       if ((result == TBX_OK) && (isBroadcast == TBX_FALSE))
       {
-        /* Obtain read access to the response packet. */
-        tTbxMbTpPacket * rxPacket = clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx);
-        /* Since we just received a response packet, the packet access should always 
-         * succeed. Sanity check anyways, just in case.
+        result = TbxMbClientRespProcess(clientCtx, request);
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReqExecute ***/
+
+
+/************************************************************************************//**
+** \brief     Helper function to execute a request of a batch in a blocking manner.
+**            Different from TbxMbClientReqExecute(), it does not wait for the
+**            turnaround delay to pass after transmitting a broadcast request. Instead,
+**            it flags the turnaround delay as pending and stores the time at which it
+**            started. The next request of the batch is then prepared while the
+**            turnaround delay passes. Afterwards, only the remaining part of it is
+**            waited for, right before transmitting the next request.
+** \param     clientCtx Pointer to the Modbus client channel for the requested operation.
+** \param     request Pointer to the request to execute.
+** \param     turnaroundPending Pointer to the flag that is TBX_TRUE while the turnaround
+**            delay of the previous broadcast request did not yet pass.
+** \param     turnaroundTicks Pointer to the 20 kHz timer tick count at which the
+**            pending turnaround delay started.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbClientBatchExecute(tTbxMbClientCtx * clientCtx,
+                                       tTbxMbClientReq * request,
+                                       uint8_t         * turnaroundPending,
+                                       uint16_t        * turnaroundTicks)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* A blocking request cannot be executed while an asynchronous request is in
+   * progress, because they share the same transport layer packets.
+   */
+  TbxCriticalSectionEnter();
+  uint8_t asyncStateCopy = clientCtx->asyncState;
+  TbxCriticalSectionExit();
+  if (asyncStateCopy == TBX_MB_CLIENT_ASYNC_STATE_IDLE)
+  {
+    /* Release a late response to an earlier request, if any. */
+    TbxMbClientRxFlush(clientCtx);
+    /* Requests to a backed off node fail right away, unless it's time to probe it. */
+    if (TbxMbClientNodeAllowed(clientCtx, request->node) == TBX_TRUE)
+    {
+      /* Prepare the request packet. This happens while the turnaround delay of the
+       * previous broadcast request passes, if any.
+       */
+      result = TbxMbClientReqBuild(clientCtx, request);
+    }
+    /* Only continue if the request packet could be prepared. */
+    if (result == TBX_OK)
+    {
+      /* Wait for the remaining part of the turnaround delay of the previous broadcast
+       * request to pass, if any.
+       */
+      if (*turnaroundPending == TBX_TRUE)
+      {
+        TbxMbClientTurnaroundWait(clientCtx, *turnaroundTicks);
+        *turnaroundPending = TBX_FALSE;
+      }
+      /* Unicast request? */
+      if (request->node != TBX_MB_TP_NODE_ADDR_BROADCAST)
+      {
+        /* Transmit the request and wait for the response to come in. */
+        result = TbxMbClientTransceive(clientCtx, request->node);
+        /* Only continue with processing the response if all is okay so far. */
+        if (result == TBX_OK)
+        {
+          result = TbxMbClientRespProcess(clientCtx, request);
+        }
+      }
+      /* Broadcast request. */
+      else
+      {
+        /* Request the transport layer to transmit the request packet and update the
+         * result accordingly.
          */
-        TBX_ASSERT(rxPacket != NULL);
-        /* Only continue with packet access. */
-        if (rxPacket != NULL)
+        result = clientCtx->tpCtx->transmitFcn(clientCtx->tpCtx);
+        /* Only continue if the request was successfully submitted for transmission. */
+        if (result == TBX_OK)
         {
-          /* Determine the number of bytes needed to hold all the coil bits. The cast to
-           * U8 is okay, because we know that num is <= 2000.
-           */
-          uint8_t numBytes = (uint8_t)(num / 8U);
-          if ((num % 8U) != 0U)
-          {
-            numBytes++;
-          }
-          /* Check that the response came from the expected node, that it's a response
-           * with the same function code (not an exception response) and that the data
-           * length and the byte count are as expected.
-           */
-          uint8_t byteCount = rxPacket->pdu.data[0];
-          if ((rxPacket->node != node) ||
-              (rxPacket->pdu.code != TBX_MB_FC01_READ_COILS) ||
-              (byteCount != numBytes) ||
-              (rxPacket->dataLen != (byteCount + 1U)) )
+          /* Wait for the request packet transmit completion. */
+          if (TbxMbOsalSemTake(clientCtx->transceiveSem, clientCtx->responseTimeout)
+              == TBX_FALSE)
           {
+            /* For some reason the packet transmission did not complete within the
+             * expected time. Flag the error.
+             */
             result = TBX_ERROR;
           }
-          /* Response content valid. Process its data. */
+          /* The turnaround delay starts once the transmission completed. */
           else
           {
-            /* Prepare loop indices that aid with reading the coils. */
-            uint8_t   bitIdx  = 0U;
-            uint8_t   byteIdx = 0U;
-            /* Initialize byte array pointer for reading the coils. */
-            uint8_t const * coilData = &rxPacket->pdu.data[1];
-            /* Loop through all the coils. */
-            for (uint16_t idx = 0U; idx < num; idx++)
-            {
-              /* Extract and store the state of the coil. */
-              if ((coilData[byteIdx] & (1U << bitIdx)) != 0U)
-              {
-                coils[idx] = TBX_ON;
-              }
-              else
-              {
-                coils[idx] = TBX_OFF;
-              }
-              /* Update the bit index. */
-              bitIdx++;
-              /* Time to move to the next byte? */
-              if (bitIdx == 8U)
-              {
-                /* Reset the bit index and increment the byte index. */
-                bitIdx = 0U;
-                byteIdx++;
-              }
-            }
+            *turnaroundTicks = TbxMbPortTimerCount();
+            *turnaroundPending = TBX_TRUE;
           }
         }
-        /* Could not access the response packet. */
-        else
-        {
-          result = TBX_ERROR;
-        }
-        /* Inform the transport layer that were done with the rx packet and no longer
-         * need access to it.
-         */
-        clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
       }
     }
-  }      
+  }
   /* Give the result back to the caller. */
   return result;
-} /*** end of TbxMbClientReadCoils ***/
+} /*** end of TbxMbClientBatchExecute ***/
 
 
 /************************************************************************************//**
-** \brief     Reads the discrete input(s) from the server with the specified node
-**            address.
-** \param     channel Handle to the Modbus client channel for the requested operation.
-** \param     node The address of the server. This parameter is transport layer
-**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
-**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
-** \param     addr Starting element address (0..65535) in the Modbus data table for the
-**            discrete input read operation.
-** \param     num Number of elements to read from the discrete inputs data table. Range
-**            can be 1..2000
-** \param     inputs Pointer to array with TBX_ON / TBX_OFF values where the discrete
-**            input state will be written to.
-** \return    TBX_OK if successful, TBX_ERROR otherwise.
+** \brief     Helper function to wait for the remaining part of the turnaround delay,
+**            after transmitting a broadcast request.
+** \param     clientCtx Pointer to the Modbus client channel for the requested operation.
+** \param     turnaroundTicks The 20 kHz timer tick count at which the turnaround delay
+**            started.
 **
 ****************************************************************************************/
-uint8_t TbxMbClientReadInputs(tTbxMbClient   channel,
-                              uint8_t        node,
-                              uint16_t       addr,
-                              uint16_t       num,
-                              uint8_t      * inputs)
+static void TbxMbClientTurnaroundWait(tTbxMbClientCtx * clientCtx,
+                                      uint16_t          turnaroundTicks)
 {
-  uint8_t result = TBX_ERROR;
+  uint8_t waitDone = TBX_FALSE;
 
-  /* Verify the parameters. */
-  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
-             (num <= 2000U) && (inputs != NULL));
+  /* Keep waiting until the turnaround delay passed. */
+  while (waitDone == TBX_FALSE)
+  {
+    /* Determine how many milliseconds passed since the start of the turnaround delay.
+     * Note that this calculation works, even if the 20 kHz timer counter overflowed.
+     */
+    uint16_t deltaTicks = TbxMbPortTimerCount() - turnaroundTicks;
+    uint16_t deltaMs = deltaTicks / 20U;
+    /* Turnaround delay already passed? */
+    if (deltaMs >= clientCtx->turnaroundDelay)
+    {
+      waitDone = TBX_TRUE;
+    }
+    /* Wait for the remaining time. A semaphore timeout means it passed. */
+    else if (TbxMbOsalSemTake(clientCtx->transceiveSem,
+                              clientCtx->turnaroundDelay - deltaMs) == TBX_FALSE)
+    {
+      waitDone = TBX_TRUE;
+    }
+    /* A packet was received during the turnaround delay. */
+    else
+    {
+      /* Not expected, so inform the transport layer that we no longer need access to
+       * the rx packet, before waiting for the remaining time.
+       */
+      if (clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx) != NULL)
+      {
+        clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
+      }
+    }
+  }
+} /*** end of TbxMbClientTurnaroundWait ***/
 
-  /* Only continue with valid parameters. */
-  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
-      (num <= 2000U) && (inputs != NULL))
+
+/************************************************************************************//**
+** \brief     Helper function to submit a request in a non-blocking manner. It starts
+**            the transmission of the request packet and returns right away. The event
+**            task completes the request later on and then calls the request's
+**            completion callback function. In case another asynchronous request is
+**            already in progress, the request is queued, if enabled.
+** \param     clientCtx Pointer to the Modbus client channel for the requested operation.
+** \param     request Pointer to the request to submit. Its contents are copied.
+** \return    TBX_OK if the request was submitted, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbClientReqSubmit(tTbxMbClientCtx * clientCtx,
+                                    tTbxMbClientReq * request)
+{
+  uint8_t result  = TBX_ERROR;
+  uint8_t claimed = TBX_FALSE;
+
+  /* Only one asynchronous request can be in progress at a time. If none is in
+   * progress, claim the asynchronous request state and store the request. It's needed
+   * again for processing its response.
+   */
+  TbxCriticalSectionEnter();
+  if (clientCtx->asyncState == TBX_MB_CLIENT_ASYNC_STATE_IDLE)
   {
-    /* Convert the client channel pointer to the context structure. */
-    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
-    /* Sanity check on the context type. */
-    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    clientCtx->asyncState = TBX_MB_CLIENT_ASYNC_STATE_TRANSMISSION;
+    clientCtx->asyncReq = *request;
+    claimed = TBX_TRUE;
+  }
+#if (TBX_MB_CLIENT_QUEUE_SIZE > 0U)
+  /* Another asynchronous request is in progress. Queue this one, if there is still
+   * space in the queue.
+   */
+  else
+  {
+    if (clientCtx->asyncQueueCount < TBX_MB_CLIENT_QUEUE_SIZE)
+    {
+      TbxMbClientQueueInsert(clientCtx, request);
+      result = TBX_OK;
+    }
+  }
+#endif
+  TbxCriticalSectionExit();
+  /* Only continue if the asynchronous request state could be claimed. */
+  if (claimed == TBX_TRUE)
+  {
+    /* Instruct the event task to start calling our polling function, for detecting
+     * a timeout.
+     */
+    tTbxMbEvent newEvent;
+    newEvent.context = clientCtx;
+    newEvent.id = TBX_MB_EVENT_ID_START_POLLING;
+    TbxMbOsalEventPost(&newEvent, TBX_FALSE);
+    /* Start the request and update the result accordingly. */
+    result = TbxMbClientReqStart(clientCtx);
+    /* Could the request not be started? */
+    if (result != TBX_OK)
+    {
+      /* Continue with the next queued request, if any. Otherwise instruct the event
+       * task to stop calling our polling function.
+       */
+      if (TbxMbClientReqNext(clientCtx) == TBX_FALSE)
+      {
+        newEvent.id = TBX_MB_EVENT_ID_STOP_POLLING;
+        TbxMbOsalEventPost(&newEvent, TBX_FALSE);
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReqSubmit ***/
+
+
+/************************************************************************************//**
+** \brief     Helper function to start the asynchronous request, stored in the channel's
+**            asyncReq element. It prepares and transmits the request packet. The caller
+**            should already have claimed the asynchronous request state.
+** \param     clientCtx Pointer to the Modbus client channel for the requested operation.
+** \return    TBX_OK if the request packet transmission started, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbClientReqStart(tTbxMbClientCtx * clientCtx)
+{
+  uint8_t result = TBX_ERROR;
 
-    /* Obtain write access to the request packet. */
-    tTbxMbTpPacket * txPacket = clientCtx->tpCtx->getTxPacketFcn(clientCtx->tpCtx);
-    /* Should always work, unless this function is being called recursively. Only
-     * continue with access for preparing the request packet.
+  /* Release a late response to an earlier request, if any. */
+  TbxMbClientRxFlush(clientCtx);
+  /* Requests to a backed off node fail right away, unless it's time to probe it. */
+  if (TbxMbClientNodeAllowed(clientCtx, clientCtx->asyncReq.node) == TBX_TRUE)
+  {
+    /* Prepare the request packet. */
+    result = TbxMbClientReqBuild(clientCtx, &clientCtx->asyncReq);
+  }
+  /* Only continue if the request packet could be prepared. */
+  if (result == TBX_OK)
+  {
+    /* Start the wait timer for the request packet transmit completion. The packet
+     * response reception timeout can be re-used for this because a packet
+     * transmission won't take longer than a packet reception, since it uses the same
+     * communication interface.
+     */
+    clientCtx->asyncWaitMs = clientCtx->responseTimeout;
+    clientCtx->asyncMsTime = TbxMbPortTimerCount();
+    /* Request the transport layer to transmit the request packet and update the
+     * result accordingly.
      */
-    if (txPacket != NULL)
+    result = clientCtx->tpCtx->transmitFcn(clientCtx->tpCtx);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReqStart ***/
+
+
+/************************************************************************************//**
+** \brief     Helper function to release a response to an earlier request that timed
+**            out, but came in after all. In this case the transport layer still holds
+**            on to it, which would block the transmission of the next request. For a
+**            blocking request, the reception of such a late response also gave the
+**            transceive semaphore, which would end the wait for the transmit
+**            completion of the next request too early. Call it before preparing the
+**            next request packet, because a compact transport layer uses the same
+**            packet buffer for reception and transmission.
+** \param     clientCtx Pointer to the Modbus client channel for the requested operation.
+**
+****************************************************************************************/
+static void TbxMbClientRxFlush(tTbxMbClientCtx * clientCtx)
+{
+  /* Does the transport layer still hold on to a received packet? */
+  if (clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx) != NULL)
+  {
+    /* Inform the transport layer that we no longer need access to the rx packet. */
+    clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
+  }
+  /* Take the transceive semaphore without waiting, in case a late response gave it. */
+  (void)TbxMbOsalSemTake(clientCtx->transceiveSem, 0U);
+} /*** end of TbxMbClientRxFlush ***/
+
+
+/************************************************************************************//**
+** \brief     Helper function to continue with the next queued asynchronous request,
+**            if any, after the one in progress completed or could not be started. It
+**            releases the asynchronous request state if no more requests are queued.
+** \param     clientCtx Pointer to the Modbus client channel for the requested operation.
+** \return    TBX_TRUE if the next asynchronous request is now in progress, TBX_FALSE if
+**            no more asynchronous requests are pending.
+**
+****************************************************************************************/
+static uint8_t TbxMbClientReqNext(tTbxMbClientCtx * clientCtx)
+{
+  uint8_t result = TBX_FALSE;
+
+  /* Release the asynchronous request state. */
+  TbxCriticalSectionEnter();
+  clientCtx->asyncState = TBX_MB_CLIENT_ASYNC_STATE_IDLE;
+#if (TBX_MB_CLIENT_QUEUE_SIZE > 0U)
+  /* Is another asynchronous request queued? */
+  if (clientCtx->asyncQueueCount > 0U)
+  {
+    /* Take the request from the front of the queue and move the others up. */
+    clientCtx->asyncReq = clientCtx->asyncQueue[0];
+    clientCtx->asyncQueueCount--;
+    for (uint8_t idx = 0U; idx < clientCtx->asyncQueueCount; idx++)
     {
-      /* Prepare the request packet. */
-      txPacket->node = node;
-      txPacket->pdu.code = TBX_MB_FC02_READ_DISCRETE_INPUTS;
-      txPacket->dataLen = 4U;
-      /* Starting address. */
-      TbxMbCommonStoreUInt16BE(addr, &txPacket->pdu.data[0]);
-      /* Number of discrete inputs. */
-      TbxMbCommonStoreUInt16BE(num, &txPacket->pdu.data[2]);
+      clientCtx->asyncQueue[idx] = clientCtx->asyncQueue[idx + 1U];
+    }
+    /* Claim the asynchronous request state again, for this request. */
+    clientCtx->asyncState = TBX_MB_CLIENT_ASYNC_STATE_TRANSMISSION;
+    result = TBX_TRUE;
+  }
+#endif
+  TbxCriticalSectionExit();
 
-      /* Determine the request type (broadcast / unicast). */
-      uint8_t isBroadcast = TBX_FALSE;
-      if (node == TBX_MB_TP_NODE_ADDR_BROADCAST)
+#if (TBX_MB_CLIENT_QUEUE_SIZE > 0U)
+  /* Start the next request right away, if there is one. This keeps the time that the
+   * bus sits idle between requests as short as possible.
+   */
+  if (result == TBX_TRUE)
+  {
+    /* Could the request not be started? */
+    if (TbxMbClientReqStart(clientCtx) != TBX_OK)
+    {
+      /* Have the polling function complete it with an error, by clearing its
+       * remaining wait time.
+       */
+      clientCtx->asyncWaitMs = 0U;
+      clientCtx->asyncMsTime = TbxMbPortTimerCount();
+    }
+  }
+#endif
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReqNext ***/
+
+
+/************************************************************************************//**
+** \brief     Helper function to complete the asynchronous request that is in progress.
+**            It calls the request's completion callback function, if configured.
+** \param     clientCtx Pointer to the Modbus client channel for the requested operation.
+** \param     result TBX_OK if the request completed successfully, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static void TbxMbClientReqDone(tTbxMbClientCtx * clientCtx,
+                               uint8_t           result)
+{
+  /* Copy the completion callback info. This makes it possible for the callback function
+   * to already submit a new asynchronous request.
+   */
+  tTbxMbClientDone   doneFcn   = clientCtx->asyncReq.doneFcn;
+  void             * doneParam = clientCtx->asyncReq.doneParam;
+  /* Continue with the next queued request, if any. Otherwise instruct the event task to
+   * stop calling our polling function.
+   */
+  if (TbxMbClientReqNext(clientCtx) == TBX_FALSE)
+  {
+    tTbxMbEvent newEvent;
+    newEvent.context = clientCtx;
+    newEvent.id = TBX_MB_EVENT_ID_STOP_POLLING;
+    TbxMbOsalEventPost(&newEvent, TBX_FALSE);
+  }
+  /* Inform the application about the request completion. */
+  if (doneFcn != NULL)
+  {
+    doneFcn(clientCtx, result, doneParam);
+  }
+} /*** end of TbxMbClientReqDone ***/
+
+
+#if (TBX_MB_CLIENT_QUEUE_SIZE > 0U)
+/************************************************************************************//**
+** \brief     Helper function to add a request to the channel's asynchronous request
+**            queue. Should be called from a critical section and only if the queue is
+**            not yet full.
+** \param     clientCtx Pointer to the Modbus client channel for the requested operation.
+** \param     request Pointer to the request to queue. Its contents are copied.
+**
+****************************************************************************************/
+static void TbxMbClientQueueInsert(tTbxMbClientCtx * clientCtx,
+                                   tTbxMbClientReq * request)
+{
+  /* By default, add the request at the end of the queue. */
+  uint8_t insertIdx = clientCtx->asyncQueueCount;
+
+#if (TBX_MB_CLIENT_QUEUE_WRITES_FIRST > 0U)
+  /* Write requests go ahead of the other requests, yet after the write requests that
+   * are already queued. The queue keeps the write requests at its front.
+   */
+  if (TbxMbClientReqIsWrite(request->code) == TBX_TRUE)
+  {
+    insertIdx = 0U;
+    while ((insertIdx < clientCtx->asyncQueueCount) &&
+           (TbxMbClientReqIsWrite(clientCtx->asyncQueue[insertIdx].code) == TBX_TRUE))
+    {
+      insertIdx++;
+    }
+  }
+#endif
+  /* Move the requests, starting at the insert position, back by one. */
+  for (uint8_t idx = clientCtx->asyncQueueCount; idx > insertIdx; idx--)
+  {
+    clientCtx->asyncQueue[idx] = clientCtx->asyncQueue[idx - 1U];
+  }
+  /* Store the request. */
+  clientCtx->asyncQueue[insertIdx] = *request;
+  clientCtx->asyncQueueCount++;
+} /*** end of TbxMbClientQueueInsert ***/
+
+
+#if (TBX_MB_CLIENT_QUEUE_WRITES_FIRST > 0U)
+/************************************************************************************//**
+** \brief     Helper function to determine if a request writes data to the server.
+** \param     code Request code.
+** \return    TBX_TRUE if it is a write request, TBX_FALSE otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbClientReqIsWrite(uint8_t code)
+{
+  uint8_t result = TBX_FALSE;
+
+  if ((code == TBX_MB_FC05_WRITE_SINGLE_COIL) ||
+      (code == TBX_MB_FC06_WRITE_SINGLE_REGISTER) ||
+      (code == TBX_MB_FC15_WRITE_MULTIPLE_COILS) ||
+      (code == TBX_MB_FC16_WRITE_MULTIPLE_REGISTERS) ||
+      (code == TBX_MB_FC21_WRITE_FILE_RECORD) ||
+      (code == TBX_MB_FC22_MASK_WRITE_REGISTER) ||
+      (code == TBX_MB_FC23_READ_WRITE_MULTIPLE_REGISTERS))
+  {
+    result = TBX_TRUE;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReqIsWrite ***/
+#endif
+#endif
+
+
+/************************************************************************************//**
+** \brief     Helper function to prepare the transport layer's transmit packet, based on
+**            the request.
+** \param     clientCtx Pointer to the Modbus client channel for the requested operation.
+** \param     request Pointer to the request. For single element write requests, the
+**            written value is stored in its value element, for validating the response.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbClientReqBuild(tTbxMbClientCtx * clientCtx,
+                                   tTbxMbClientReq * request)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Obtain write access to the request packet. */
+  tTbxMbTpPacket * txPacket = clientCtx->tpCtx->getTxPacketFcn(clientCtx->tpCtx);
+  /* Should always work, unless this function is being called recursively. Only
+   * continue with access for preparing the request packet.
+   */
+  if (txPacket != NULL)
+  {
+    /* Update the result. */
+    result = TBX_OK;
+    /* Prepare the request packet. */
+    txPacket->node = request->node;
+    txPacket->pdu.code = request->code;
+    /* Filter on the request code. */
+    switch (request->code)
+    {
+      case TBX_MB_FC01_READ_COILS:
+      case TBX_MB_FC02_READ_DISCRETE_INPUTS:
+      case TBX_MB_FC03_READ_HOLDING_REGISTERS:
+      case TBX_MB_FC04_READ_INPUT_REGISTERS:
       {
-        isBroadcast = TBX_TRUE;
+        txPacket->dataLen = 4U;
+        /* Starting address. */
+        TbxMbCommonStoreUInt16BE(request->addr, &txPacket->pdu.data[0]);
+        /* Number of elements. */
+        TbxMbCommonStoreUInt16BE(request->num, &txPacket->pdu.data[2]);
       }
-      /* Transmit the request and wait for the response to a unicast request to come in
-       * or the turnaround time to pass for a broadcast request.
-       */
-      result = TbxMbClientTransceive(clientCtx, isBroadcast);
+      break;
 
-      /* Only continue with processing the response if all is okay so far and the request
-       * was unicast.
-       */
-      if ((result == TBX_OK) && (isBroadcast == TBX_FALSE))
+      case TBX_MB_FC05_WRITE_SINGLE_COIL:
+      {
+        uint8_t const * coils = (uint8_t const *)request->txData;
+        txPacket->dataLen = 4U;
+        /* Coil address. */
+        TbxMbCommonStoreUInt16BE(request->addr, &txPacket->pdu.data[0]);
+        /* Coil value. */
+        request->value = (coils[0] == TBX_OFF) ? 0x0000U : 0xFF00U;
+        TbxMbCommonStoreUInt16BE(request->value, &txPacket->pdu.data[2]);
+      }
+      break;
+
+      case TBX_MB_FC06_WRITE_SINGLE_REGISTER:
+      {
+        uint16_t const * holdingRegs = (uint16_t const *)request->txData;
+        txPacket->dataLen = 4U;
+        /* Holding register address. */
+        TbxMbCommonStoreUInt16BE(request->addr, &txPacket->pdu.data[0]);
+        /* Holding register value. */
+        request->value = holdingRegs[0];
+        TbxMbCommonStoreUInt16BE(request->value, &txPacket->pdu.data[2]);
+      }
+      break;
+
+      case TBX_MB_FC15_WRITE_MULTIPLE_COILS:
       {
-        /* Obtain read access to the response packet. */
-        tTbxMbTpPacket * rxPacket = clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx);
-        /* Since we just received a response packet, the packet access should always 
-         * succeed. Sanity check anyways, just in case.
+        uint8_t const * coils = (uint8_t const *)request->txData;
+        /* Determine the number of bytes needed to hold all the coil bits. The cast to
+         * U8 is okay, because we know that num is <= 1968.
          */
-        TBX_ASSERT(rxPacket != NULL);
-        /* Only continue with packet access. */
-        if (rxPacket != NULL)
+        uint8_t numBytes = (uint8_t)(request->num / 8U);
+        if ((request->num % 8U) != 0U)
         {
-          /* Determine the number of bytes needed to hold all the input bits. The cast to
-           * U8 is okay, because we know that num is <= 2000.
-           */
-          uint8_t numBytes = (uint8_t)(num / 8U);
-          if ((num % 8U) != 0U)
+          numBytes++;
+        }
+        txPacket->dataLen = numBytes + 5U;
+        /* Start address. */
+        TbxMbCommonStoreUInt16BE(request->addr, &txPacket->pdu.data[0]);
+        /* Number of coils. */
+        TbxMbCommonStoreUInt16BE(request->num, &txPacket->pdu.data[2]);
+        /* Byte count. */
+        txPacket->pdu.data[4] = numBytes;
+        /* Prepare loop indices that aid with reading the input bits. */
+        uint8_t   bitIdx  = 0U;
+        uint8_t   byteIdx = 0U;
+        /* Set pointer to where the coils start in the request and already initialize the
+         * first byte to all zero (coil OFF) bits.
+        */
+        uint8_t * coilData = &txPacket->pdu.data[5];
+        coilData[0] = 0U;
+        /* Store the coil values. */
+        for (uint16_t idx = 0U; idx < request->num; idx++)
+        {
+          /* Should the coil be ON? */
+          if (coils[idx] != TBX_OFF)
           {
-            numBytes++;
+            coilData[byteIdx] |= (1U << bitIdx);
           }
-          /* Check that the response came from the expected node, that it's a response
-           * with the same function code (not an exception response) and that the data
-           * length and the byte count are as expected.
-           */
-          uint8_t byteCount = rxPacket->pdu.data[0];
-          if ((rxPacket->node != node) ||
-              (rxPacket->pdu.code != TBX_MB_FC02_READ_DISCRETE_INPUTS) ||
-              (byteCount != numBytes) ||
-              (rxPacket->dataLen != (byteCount + 1U)) )
+          /* Update the bit index. */
+          bitIdx++;
+          /* Time to move to the next byte? */
+          if (bitIdx == 8U)
           {
-            result = TBX_ERROR;
+            /* Reset the bit index, increment the byte index and initialize the byte to
+             * all zero (coil OFF) bits.
+             */
+            bitIdx = 0U;
+            byteIdx++;
+            coilData[byteIdx] = 0U;
           }
-          /* Response content valid. Process its data. */
-          else
+        }
+      }
+      break;
+
+      case TBX_MB_FC16_WRITE_MULTIPLE_REGISTERS:
+      {
+        uint16_t const * holdingRegs = (uint16_t const *)request->txData;
+        /* Determine byte count needed for storing the holding register values. */
+        uint8_t byteCount = (uint8_t)(request->num * 2U);
+        txPacket->dataLen = byteCount + 5U;
+        /* Start address. */
+        TbxMbCommonStoreUInt16BE(request->addr, &txPacket->pdu.data[0]);
+        /* Number of holding registers. */
+        TbxMbCommonStoreUInt16BE(request->num, &txPacket->pdu.data[2]);
+        /* Byte count. */
+        txPacket->pdu.data[4] = byteCount;
+        /* Set pointer to where the holding registers start in the request. */
+        uint8_t * regValPtr = &txPacket->pdu.data[5];
+        /* Store the holding register values. */
+        for (uint8_t idx = 0U; idx < request->num; idx++)
+        {
+          TbxMbCommonStoreUInt16BE(holdingRegs[idx], &regValPtr[idx * 2U]);
+        }
+      }
+      break;
+
+      case TBX_MB_FC20_READ_FILE_RECORD:
+      {
+        txPacket->dataLen = 8U;
+        /* Byte count of the one sub-request and its reference type. */
+        txPacket->pdu.data[0] = 7U;
+        txPacket->pdu.data[1] = TBX_MB_FILE_REF_TYPE;
+        /* File number, stored in the request's writeAddr element. */
+        TbxMbCommonStoreUInt16BE(request->writeAddr, &txPacket->pdu.data[2]);
+        /* Record number. */
+        TbxMbCommonStoreUInt16BE(request->addr, &txPacket->pdu.data[4]);
+        /* Number of records. */
+        TbxMbCommonStoreUInt16BE(request->num, &txPacket->pdu.data[6]);
+      }
+      break;
+
+      case TBX_MB_FC21_WRITE_FILE_RECORD:
+      {
+        uint16_t const * records = (uint16_t const *)request->txData;
+        /* Determine byte count of the one sub-request with its record values. The cast
+         * to U8 is okay, because we know that num is <= 122.
+         */
+        uint8_t byteCount = (uint8_t)(7U + (request->num * 2U));
+        txPacket->dataLen = byteCount + 1U;
+        /* Byte count and the sub-request's reference type. */
+        txPacket->pdu.data[0] = byteCount;
+        txPacket->pdu.data[1] = TBX_MB_FILE_REF_TYPE;
+        /* File number, stored in the request's writeAddr element. */
+        TbxMbCommonStoreUInt16BE(request->writeAddr, &txPacket->pdu.data[2]);
+        /* Record number. */
+        TbxMbCommonStoreUInt16BE(request->addr, &txPacket->pdu.data[4]);
+        /* Number of records. */
+        TbxMbCommonStoreUInt16BE(request->num, &txPacket->pdu.data[6]);
+        /* Set pointer to where the record values start in the request. */
+        uint8_t * recValPtr = &txPacket->pdu.data[8];
+        /* Store the record values. */
+        for (uint8_t idx = 0U; idx < request->num; idx++)
+        {
+          TbxMbCommonStoreUInt16BE(records[idx], &recValPtr[idx * 2U]);
+        }
+      }
+      break;
+
+      case TBX_MB_FC22_MASK_WRITE_REGISTER:
+      {
+        txPacket->dataLen = 6U;
+        /* Holding register address. */
+        TbxMbCommonStoreUInt16BE(request->addr, &txPacket->pdu.data[0]);
+        /* AND mask, stored in the request's value element. */
+        TbxMbCommonStoreUInt16BE(request->value, &txPacket->pdu.data[2]);
+        /* OR mask, stored in the request's num element. */
+        TbxMbCommonStoreUInt16BE(request->num, &txPacket->pdu.data[4]);
+      }
+      break;
+
+      case TBX_MB_FC23_READ_WRITE_MULTIPLE_REGISTERS:
+      {
+        uint16_t const * holdingRegs = (uint16_t const *)request->txData;
+        /* Determine byte count needed for storing the written holding register values.*/
+        uint8_t byteCount = (uint8_t)(request->writeNum * 2U);
+        txPacket->dataLen = byteCount + 9U;
+        /* Read start address. */
+        TbxMbCommonStoreUInt16BE(request->addr, &txPacket->pdu.data[0]);
+        /* Number of holding registers to read. */
+        TbxMbCommonStoreUInt16BE(request->num, &txPacket->pdu.data[2]);
+        /* Write start address. */
+        TbxMbCommonStoreUInt16BE(request->writeAddr, &txPacket->pdu.data[4]);
+        /* Number of holding registers to write. */
+        TbxMbCommonStoreUInt16BE(request->writeNum, &txPacket->pdu.data[6]);
+        /* Byte count. */
+        txPacket->pdu.data[8] = byteCount;
+        /* Set pointer to where the written holding registers start in the request. */
+        uint8_t * regValPtr = &txPacket->pdu.data[9];
+        /* Store the holding register values. */
+        for (uint8_t idx = 0U; idx < request->writeNum; idx++)
+        {
+          TbxMbCommonStoreUInt16BE(holdingRegs[idx], &regValPtr[idx * 2U]);
+        }
+      }
+      break;
+
+      case TBX_MB_FC08_DIAGNOSTICS:
+      {
+        /* The request's address element holds the diagnostics subcode. */
+        TbxMbCommonStoreUInt16BE(request->addr, &txPacket->pdu.data[0]);
+        /* Requested to perform a query data diagnostic operation? */
+        if (request->addr == TBX_MB_DIAG_SC_QUERY_DATA)
+        {
+          const uint8_t queryDataLen = sizeof(tbxMbClientDiagQueryData) /
+                                       sizeof(tbxMbClientDiagQueryData[0]);
+          /* Write the query data for loopback testing. */
+          for (uint8_t idx = 0U; idx < queryDataLen; idx++)
           {
-            /* Prepare loop indices that aid with reading the input bits. */
-            uint8_t   bitIdx  = 0U;
-            uint8_t   byteIdx = 0U;
-            /* Initialize byte array pointer for reading the input bits. */
-            uint8_t const * inputData = &rxPacket->pdu.data[1];
-            /* Loop through all the inputs. */
-            for (uint16_t idx = 0U; idx < num; idx++)
-            {
-              /* Extract and store the state of the discrete input. */
-              if ((inputData[byteIdx] & (1U << bitIdx)) != 0U)
-              {
-                inputs[idx] = TBX_ON;
-              }
-              else
-              {
-                inputs[idx] = TBX_OFF;
-              }
-              /* Update the bit index. */
-              bitIdx++;
-              /* Time to move to the next byte? */
-              if (bitIdx == 8U)
-              {
-                /* Reset the bit index and increment the byte index. */
-                bitIdx = 0U;
-                byteIdx++;
-              }
-            }
+            TbxMbCommonStoreUInt16BE(tbxMbClientDiagQueryData[idx],
+                                     &txPacket->pdu.data[2U + (idx * 2U)]);
           }
+          txPacket->dataLen = (queryDataLen * 2U) + 2U;
         }
-        /* Could not access the response packet. */
+        /* All other supported subcodes require a 16-bit zero value data field. */
         else
         {
-          result = TBX_ERROR;
+          /* Store the data field as per the protocol. */
+          TbxMbCommonStoreUInt16BE(0x0000U, &txPacket->pdu.data[2U]);
+          txPacket->dataLen = 4U;
         }
-        /* Inform the transport layer that were done with the rx packet and no longer
-         * need access to it.
-         */
-        clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
       }
-    }
-  }      
+      break;
+
+      case TBX_MB_CLIENT_CODE_CUSTOM:
+      {
+        uint8_t const * txPdu = (uint8_t const *)request->txData;
+        /* Only continue with a valid packet length. It should at least have a PDU
+         * function code.
+         */
+        if (*request->len > 0U)
+        {
+          /* Copy the PDU, starting with its function code. */
+          txPacket->pdu.code = txPdu[0];
+          txPacket->dataLen = *request->len - 1U;
+          for (uint8_t idx = 0U; idx < txPacket->dataLen; idx++)
+          {
+            txPacket->pdu.data[idx] = txPdu[idx + 1U];
+          }
+          /* Initialize the length of the response PDU to zero. This default indicates
+           * that no response was received. This is the case in the request was a
+           * broadcast one or it the response was not valid. If will be updated later
+           * on, if a valid response was received.
+           */
+          *request->len = 0U;
+        }
+        else
+        {
+          result = TBX_ERROR;
+        }
+      }
+      break;
+
+      case TBX_MB_CLIENT_CODE_CUSTOM_IN_PLACE:
+      {
+        uint8_t pduLen = 0U;
+        /* Have the application build the PDU directly in the request packet, starting
+         * with its function code.
+         */
+        result = request->buildFcn(clientCtx, &txPacket->pdu.code, &pduLen,
+                                   request->rxData);
+        /* Only continue with a valid packet length. It should at least have a PDU
+         * function code and it should fit in the packet.
+         */
+        if ((result == TBX_OK) && (pduLen > 0U) && (pduLen <= TBX_MB_TP_PDU_MAX_LEN))
+        {
+          txPacket->dataLen = pduLen - 1U;
+        }
+        else
+        {
+          result = TBX_ERROR;
+        }
+      }
+      break;
+
+      default:
+      {
+        /* An unsupported request code. Should not happen. */
+        TBX_ASSERT(TBX_FALSE);
+        result = TBX_ERROR;
+      }
+      break;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReqBuild ***/
+
+
+/************************************************************************************//**
+** \brief     Helper function to validate and process the response packet, received by
+**            the transport layer for the request.
+** \param     clientCtx Pointer to the Modbus client channel for the requested operation.
+** \param     request Pointer to the request, for which the response was received.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbClientRespProcess(tTbxMbClientCtx * clientCtx,
+                                      tTbxMbClientReq * request)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Obtain read access to the response packet. */
+  tTbxMbTpPacket * rxPacket = clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx);
+  /* Since we just received a response packet, the packet access should always
+   * succeed. Sanity check anyways, just in case.
+   */
+  TBX_ASSERT(rxPacket != NULL);
+  /* Only continue with packet access and if the response came from the expected
+   * node.
+   */
+  if ((rxPacket != NULL) && (rxPacket->node == request->node))
+  {
+    /* Update the result. */
+    result = TBX_OK;
+    /* Filter on the request code. */
+    switch (request->code)
+    {
+      case TBX_MB_FC01_READ_COILS:
+      case TBX_MB_FC02_READ_DISCRETE_INPUTS:
+      {
+        /* Determine the number of bytes needed to hold all the coil or input bits. The
+         * cast to U8 is okay, because we know that num is <= 2000.
+         */
+        uint8_t numBytes = (uint8_t)(request->num / 8U);
+        if ((request->num % 8U) != 0U)
+        {
+          numBytes++;
+        }
+        /* Check that it's a response with the same function code (not an exception
+         * response) and that the data length and the byte count are as expected.
+         */
+        uint8_t byteCount = rxPacket->pdu.data[0];
+        if ((rxPacket->pdu.code != request->code) ||
+            (byteCount != numBytes) ||
+            (rxPacket->dataLen != (byteCount + 1U)) )
+        {
+          result = TBX_ERROR;
+        }
+        /* Response content valid. Process its data. */
+        else
+        {
+          uint8_t * bits = (uint8_t *)request->rxData;
+          /* Prepare loop indices that aid with reading the bits. */
+          uint8_t   bitIdx  = 0U;
+          uint8_t   byteIdx = 0U;
+          /* Initialize byte array pointer for reading the bits. */
+          uint8_t const * bitData = &rxPacket->pdu.data[1];
+          /* Loop through all the bits. */
+          for (uint16_t idx = 0U; idx < request->num; idx++)
+          {
+            /* Extract and store the state of the coil or discrete input. */
+            if ((bitData[byteIdx] & (1U << bitIdx)) != 0U)
+            {
+              bits[idx] = TBX_ON;
+            }
+            else
+            {
+              bits[idx] = TBX_OFF;
+            }
+            /* Update the bit index. */
+            bitIdx++;
+            /* Time to move to the next byte? */
+            if (bitIdx == 8U)
+            {
+              /* Reset the bit index and increment the byte index. */
+              bitIdx = 0U;
+              byteIdx++;
+            }
+          }
+        }
+      }
+      break;
+
+      case TBX_MB_FC03_READ_HOLDING_REGISTERS:
+      case TBX_MB_FC04_READ_INPUT_REGISTERS:
+      case TBX_MB_FC23_READ_WRITE_MULTIPLE_REGISTERS:
+      {
+        /* Check that it's a response with the same function code (not an exception
+         * response) and that the data length and the byte count are as expected.
+         */
+        uint8_t byteCount = rxPacket->pdu.data[0];
+        if ((rxPacket->pdu.code != request->code) ||
+            (byteCount != (request->num * 2U)) ||
+            (rxPacket->dataLen != (byteCount + 1U)) )
+        {
+          result = TBX_ERROR;
+        }
+        /* Response content valid. Process its data. */
+        else
+        {
+          uint16_t * regs = (uint16_t *)request->rxData;
+          /* Set pointer to where the registers start in the response. */
+          uint8_t const * regValPtr = &rxPacket->pdu.data[1];
+          /* Read out and store the register values. */
+          for (uint8_t idx = 0U; idx < request->num; idx++)
+          {
+            regs[idx] = TbxMbCommonExtractUInt16BE(&regValPtr[idx * 2U]);
+          }
+        }
+      }
+      break;
+
+      case TBX_MB_FC05_WRITE_SINGLE_COIL:
+      case TBX_MB_FC06_WRITE_SINGLE_REGISTER:
+      {
+        /* Check that it's a response with the same function code (not an exception
+         * response), that the element address and value are as expected and that the
+         * data length is as expected.
+         */
+        if ((rxPacket->pdu.code != request->code) ||
+            (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]) != request->addr) ||
+            (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]) != request->value) ||
+            (rxPacket->dataLen != 4U))
+        {
+          result = TBX_ERROR;
+        }
+      }
+      break;
+
+      case TBX_MB_FC15_WRITE_MULTIPLE_COILS:
+      case TBX_MB_FC16_WRITE_MULTIPLE_REGISTERS:
+      {
+        /* Check that it's a response with the same function code (not an exception
+         * response), that the element start address and quantity are as expected and
+         * that the data length is as expected.
+         */
+        if ((rxPacket->pdu.code != request->code) ||
+            (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]) != request->addr) ||
+            (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]) != request->num) ||
+            (rxPacket->dataLen != 4U))
+        {
+          result = TBX_ERROR;
+        }
+      }
+      break;
+
+      case TBX_MB_FC20_READ_FILE_RECORD:
+      {
+        /* Check that it's a response with the same function code (not an exception
+         * response), that the data length and the byte counts are as expected and that
+         * the one sub-response has the correct reference type.
+         */
+        uint8_t byteCount = rxPacket->pdu.data[0];
+        if ((rxPacket->pdu.code != request->code) ||
+            (byteCount != ((request->num * 2U) + 2U)) ||
+            (rxPacket->dataLen != (byteCount + 1U)) ||
+            (rxPacket->pdu.data[1] != (byteCount - 1U)) ||
+            (rxPacket->pdu.data[2] != TBX_MB_FILE_REF_TYPE))
+        {
+          result = TBX_ERROR;
+        }
+        /* Response content valid. Process its data. */
+        else
+        {
+          uint16_t * records = (uint16_t *)request->rxData;
+          /* Set pointer to where the record values start in the response. */
+          uint8_t const * recValPtr = &rxPacket->pdu.data[3];
+          /* Read out and store the record values. */
+          for (uint8_t idx = 0U; idx < request->num; idx++)
+          {
+            records[idx] = TbxMbCommonExtractUInt16BE(&recValPtr[idx * 2U]);
+          }
+        }
+      }
+      break;
+
+      case TBX_MB_FC21_WRITE_FILE_RECORD:
+      {
+        /* Check that it's a response with the same function code (not an exception
+         * response), that it echoes the sub-request header and that the data length is
+         * as expected.
+         */
+        if ((rxPacket->pdu.code != request->code) ||
+            (rxPacket->dataLen != (8U + (request->num * 2U))) ||
+            (rxPacket->pdu.data[0] != (rxPacket->dataLen - 1U)) ||
+            (rxPacket->pdu.data[1] != TBX_MB_FILE_REF_TYPE) ||
+            (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]) != request->writeAddr) ||
+            (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[4]) != request->addr) ||
+            (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[6]) != request->num))
+        {
+          result = TBX_ERROR;
+        }
+      }
+      break;
+
+      case TBX_MB_FC22_MASK_WRITE_REGISTER:
+      {
+        /* Check that it's a response with the same function code (not an exception
+         * response), that it echoes the address and masks of the request and that the
+         * data length is as expected.
+         */
+        if ((rxPacket->pdu.code != request->code) ||
+            (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]) != request->addr) ||
+            (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]) != request->value) ||
+            (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[4]) != request->num) ||
+            (rxPacket->dataLen != 6U))
+        {
+          result = TBX_ERROR;
+        }
+      }
+      break;
+
+      case TBX_MB_FC08_DIAGNOSTICS:
+      {
+        /* The request's address element holds the diagnostics subcode. */
+        uint16_t subcode = request->addr;
+        /* Check that it's a response with the same function code (not an exception
+         * response) and that it's a response with the same function sub-code.
+         */
+        if ((rxPacket->pdu.code != TBX_MB_FC08_DIAGNOSTICS) ||
+            (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]) != subcode))
+        {
+          result = TBX_ERROR;
+        }
+        /* Response looks valid so far. Continue with processing its data.*/
+        else
+        {
+          if (subcode == TBX_MB_DIAG_SC_QUERY_DATA)
+          {
+            const uint8_t queryDataLen = sizeof(tbxMbClientDiagQueryData) /
+                                         sizeof(tbxMbClientDiagQueryData[0]);
+            /* Check the data length. */
+            if (rxPacket->dataLen != ((queryDataLen * 2U) + 2U))
+            {
+              result = TBX_ERROR;
+            }
+            /* Data length okay, continue with checking its content. */
+            else
+            {
+              /* Loop through the received query data. */
+              for (uint8_t idx = 0U; idx < queryDataLen; idx++)
+              {
+                uint8_t const * entryPtr = &rxPacket->pdu.data[2];
+                uint16_t entry = TbxMbCommonExtractUInt16BE(&entryPtr[idx * 2U]);
+                /* Check that its value is the same as what was sent in the request. */
+                if (entry != tbxMbClientDiagQueryData[idx])
+                {
+                  /* Flag the error and stop the loop. */
+                  result = TBX_ERROR;
+                  break;
+                }
+              }
+            }
+          }
+          else if (subcode == TBX_MB_DIAG_SC_CLEAR_COUNTERS)
+          {
+            /* Check the data length. */
+            if (rxPacket->dataLen != 4U)
+            {
+              result = TBX_ERROR;
+            }
+            /* Data length okay, continue with checking its content. */
+            else
+            {
+              uint8_t const * dataValPtr = &rxPacket->pdu.data[2];
+              uint16_t dataVal = TbxMbCommonExtractUInt16BE(dataValPtr);
+              /* Check that the value is as expected. */
+              if (dataVal != 0x0000U)
+              {
+                result = TBX_ERROR;
+              }
+            }
+          }
+          /* subcode for reading a count. */
+          else
+          {
+            /* Check the data length. */
+            if (rxPacket->dataLen != 4U)
+            {
+              result = TBX_ERROR;
+            }
+            /* Data length okay, continue with extracting the count value. */
+            else
+            {
+              uint8_t const * countValPtr = &rxPacket->pdu.data[2];
+              uint16_t countVal = TbxMbCommonExtractUInt16BE(countValPtr);
+              uint16_t * count = (uint16_t *)request->rxData;
+              /* Verify that count parameter. */
+              TBX_ASSERT(count != NULL);
+              /* Only continue with a valid count parameter. */
+              if (count != NULL)
+              {
+                /* Store the count value. */
+                *count = countVal;
+              }
+              else
+              {
+                /* The an error due to an invalid count parameter. */
+                result = TBX_ERROR;
+              }
+            }
+          }
+        }
+      }
+      break;
+
+      case TBX_MB_CLIENT_CODE_CUSTOM:
+      {
+        uint8_t * rxPdu = (uint8_t *)request->rxData;
+        /* Set the length, including the function code. */
+        *request->len = rxPacket->dataLen + 1U;
+        /* Set the function code. */
+        rxPdu[0] = rxPacket->pdu.code;
+        /* Copy the packet data. */
+        for (uint8_t idx = 0U; idx < rxPacket->dataLen; idx++)
+        {
+          rxPdu[idx + 1U] = rxPacket->pdu.data[idx];
+        }
+      }
+      break;
+
+      case TBX_MB_CLIENT_CODE_CUSTOM_IN_PLACE:
+      {
+        /* Have the application parse the PDU directly in the response packet, if it
+         * is interested in the response.
+         */
+        if (request->parseFcn != NULL)
+        {
+          result = request->parseFcn(clientCtx, &rxPacket->pdu.code,
+                                     rxPacket->dataLen + 1U, request->rxData);
+        }
+      }
+      break;
+
+      default:
+      {
+        /* An unsupported request code. Should not happen. */
+        TBX_ASSERT(TBX_FALSE);
+        result = TBX_ERROR;
+      }
+      break;
+    }
+  }
+  /* Inform the transport layer that were done with the rx packet and no longer need
+   * access to it.
+   */
+  clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientRespProcess ***/
+
+
+/************************************************************************************//**
+** \brief     In place request build callback function for reading the device
+**            identification. It builds the request for the next object(s).
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     pdu Pointer to the PDU of the request packet.
+** \param     len Location where the length of the PDU, including function code, is
+**            written to.
+** \param     param Pointer to the read device identification request state.
+** \return    TBX_OK if the request PDU was built, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbClientDevIdBuild(tTbxMbClient   channel,
+                                     uint8_t      * pdu,
+                                     uint8_t      * len,
+                                     void         * param)
+{
+  uint8_t result = TBX_ERROR;
+
+  TBX_UNUSED_ARG(channel);
+
+  /* Verify parameters. */
+  TBX_ASSERT((pdu != NULL) && (len != NULL) && (param != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((pdu != NULL) && (len != NULL) && (param != NULL))
+  {
+    tTbxMbClientDevIdReq * devIdReq = (tTbxMbClientDevIdReq *)param;
+    /* Function code, MEI type, read device id code and the object id. */
+    pdu[0] = TBX_MB_FC43_ENCAPSULATED_INTERFACE;
+    pdu[1] = TBX_MB_MEI_READ_DEVICE_ID;
+    pdu[2] = devIdReq->code;
+    pdu[3] = devIdReq->objectId;
+    *len = 4U;
+    /* Update the result. */
+    result = TBX_OK;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientDevIdBuild ***/
+
+
+/************************************************************************************//**
+** \brief     In place response parse callback function for reading the device
+**            identification. It validates the entire response, before passing its
+**            objects on to the application, straight from the response packet. It
+**            also determines if more objects follow.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     pdu Pointer to the PDU of the response packet.
+** \param     len Length of the PDU, including function code.
+** \param     param Pointer to the read device identification request state.
+** \return    TBX_OK if the response PDU is valid, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbClientDevIdParse(tTbxMbClient         channel,
+                                     uint8_t      const * pdu,
+                                     uint8_t              len,
+                                     void               * param)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify parameters. */
+  TBX_ASSERT((pdu != NULL) && (param != NULL));
+
+  /* Only continue with valid parameters. Also check that it's a response with the same
+   * function code (not an exception response), MEI type and read device id code and
+   * that it at least has the response header.
+   */
+  if ((pdu != NULL) && (param != NULL) && (len >= 7U) &&
+      (pdu[0] == TBX_MB_FC43_ENCAPSULATED_INTERFACE) &&
+      (pdu[1] == TBX_MB_MEI_READ_DEVICE_ID) &&
+      (pdu[2] == ((tTbxMbClientDevIdReq *)param)->code))
+  {
+    tTbxMbClientDevIdReq * devIdReq = (tTbxMbClientDevIdReq *)param;
+    uint8_t                numObjects = pdu[6];
+    uint16_t               offset = 7U;
+
+    /* Update the result. */
+    result = TBX_OK;
+    /* Check that all objects are completely present and that nothing else follows. */
+    for (uint8_t idx = 0U; idx < numObjects; idx++)
+    {
+      /* Object's identifier and length present? */
+      if ((offset + 2U) > len)
+      {
+        result = TBX_ERROR;
+        /* Stop looping. */
+        break;
+      }
+      /* Skip the object. */
+      offset += 2U + pdu[offset + 1U];
+    }
+    if (offset != len)
+    {
+      result = TBX_ERROR;
+    }
+    /* Determine if more objects follow. This is only applicable for stream access.
+     * The next object must come after the first one in this response. Otherwise
+     * reading the objects might never end.
+     */
+    devIdReq->moreFollows = TBX_FALSE;
+    if ((result == TBX_OK) && (pdu[4] == 0xFFU) &&
+        (devIdReq->code != TBX_MB_DEVID_CODE_INDIVIDUAL))
+    {
+      if ((numObjects == 0U) || (pdu[5] <= pdu[7]))
+      {
+        result = TBX_ERROR;
+      }
+      else
+      {
+        devIdReq->moreFollows = TBX_TRUE;
+        devIdReq->objectId = pdu[5];
+      }
+    }
+    /* Response content valid. Pass the objects on to the application. */
+    if ((result == TBX_OK) && (devIdReq->objectFcn != NULL))
+    {
+      offset = 7U;
+      for (uint8_t idx = 0U; idx < numObjects; idx++)
+      {
+        devIdReq->objectFcn(channel, pdu[offset], &pdu[offset + 2U], pdu[offset + 1U],
+                            devIdReq->param);
+        offset += 2U + pdu[offset + 1U];
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientDevIdParse ***/
+
+
+/************************************************************************************//**
+** \brief     Helper function to determine if a request to the specified node is allowed
+**            to be transmitted. A request to a node that is backed off is not allowed,
+**            unless it's time to probe the node.
+** \param     clientCtx Pointer to the Modbus client channel for the requested operation.
+** \param     node The address of the server.
+** \return    TBX_TRUE if the request is allowed, TBX_FALSE otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbClientNodeAllowed(tTbxMbClientCtx * clientCtx,
+                                      uint8_t           node)
+{
+  uint8_t result = TBX_TRUE;
+
+#if (TBX_MB_CLIENT_NODE_STATS_SIZE > 0U) && (TBX_MB_CLIENT_BACKOFF_TIMEOUTS > 0U)
+  TbxCriticalSectionEnter();
+  /* Look up the statistics of the node. */
+  tTbxMbClientNodeInfo * nodeInfo = TbxMbClientNodeFind(clientCtx, node, TBX_FALSE);
+  /* Is the node backed off? */
+  if ((nodeInfo != NULL) && (nodeInfo->timeouts >= TBX_MB_CLIENT_BACKOFF_TIMEOUTS))
+  {
+    /* Only allow the request, if it's time to probe the node. */
+    nodeInfo->skipCount++;
+    if (nodeInfo->skipCount < TBX_MB_CLIENT_BACKOFF_PROBE)
+    {
+      result = TBX_FALSE;
+    }
+    else
+    {
+      nodeInfo->skipCount = 0U;
+    }
+  }
+  TbxCriticalSectionExit();
+#else
+  TBX_UNUSED_ARG(clientCtx);
+  TBX_UNUSED_ARG(node);
+#endif
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientNodeAllowed ***/
+
+
+/************************************************************************************//**
+** \brief     Helper function to obtain the response timeout for a unicast request to the
+**            specified node. It's the average response time of the node plus four times
+**            its average deviation, limited to the range
+**            TBX_MB_CLIENT_TIMEOUT_MIN_MS..responseTimeout. The full response timeout
+**            applies to a node without measured response times and to a node that did
+**            not respond to its last request. This gives a node that got slower the
+**            chance to update its statistics.
+** \param     clientCtx Pointer to the Modbus client channel for the requested operation.
+** \param     node The address of the server.
+** \return    Response timeout in milliseconds.
+**
+****************************************************************************************/
+static uint16_t TbxMbClientNodeTimeout(tTbxMbClientCtx * clientCtx,
+                                       uint8_t           node)
+{
+  uint16_t result = clientCtx->responseTimeout;
+
+#if (TBX_MB_CLIENT_NODE_STATS_SIZE > 0U)
+  TbxCriticalSectionEnter();
+  /* Look up the statistics of the node. */
+  tTbxMbClientNodeInfo * nodeInfo = TbxMbClientNodeFind(clientCtx, node, TBX_FALSE);
+  /* Only adapt the timeout for a node that responded to its last request. */
+  if ((nodeInfo != NULL) && (nodeInfo->learned == TBX_TRUE) && (nodeInfo->timeouts == 0U))
+  {
+    uint32_t timeout = (nodeInfo->avgMsX8 / 8U) + nodeInfo->devMsX4;
+    if (timeout < TBX_MB_CLIENT_TIMEOUT_MIN_MS)
+    {
+      timeout = TBX_MB_CLIENT_TIMEOUT_MIN_MS;
+    }
+    if (timeout < result)
+    {
+      result = (uint16_t)timeout;
+    }
+  }
+  TbxCriticalSectionExit();
+#else
+  TBX_UNUSED_ARG(node);
+#endif
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientNodeTimeout ***/
+
+
+/************************************************************************************//**
+** \brief     Helper function to store the start time for measuring the response time,
+**            right after the transmission of the request packet completed.
+** \param     clientCtx Pointer to the Modbus client channel for the requested operation.
+**
+****************************************************************************************/
+static void TbxMbClientNodeRxStart(tTbxMbClientCtx * clientCtx)
+{
+#if (TBX_MB_CLIENT_NODE_STATS_SIZE > 0U)
+  clientCtx->rxTicks = TbxMbPortTimerCount();
+#else
+  TBX_UNUSED_ARG(clientCtx);
+#endif
+} /*** end of TbxMbClientNodeRxStart ***/
+
+
+/************************************************************************************//**
+** \brief     Helper function to update the response time statistics of the specified
+**            node, once a response came in or the response timeout passed. Note that
+**            the response time is measured with the 16-bit 20 kHz timer counter, so
+**            a response time above 3276 ms cannot be measured correctly.
+** \param     clientCtx Pointer to the Modbus client channel for the requested operation.
+** \param     node The address of the server.
+** \param     responded TBX_TRUE if a response came in, TBX_FALSE in case of a response
+**            timeout.
+**
+****************************************************************************************/
+static void TbxMbClientNodeUpdate(tTbxMbClientCtx * clientCtx,
+                                  uint8_t           node,
+                                  uint8_t           responded)
+{
+#if (TBX_MB_CLIENT_NODE_STATS_SIZE > 0U)
+  /* Determine the response time. Note that this calculation works, even if the 20 kHz
+   * timer counter overflowed.
+   */
+  uint16_t deltaTicks = TbxMbPortTimerCount() - clientCtx->rxTicks;
+  uint16_t respMs = deltaTicks / 20U;
+
+  TbxCriticalSectionEnter();
+  /* Look up the statistics of the node, or start tracking it. */
+  tTbxMbClientNodeInfo * nodeInfo = TbxMbClientNodeFind(clientCtx, node, TBX_TRUE);
+  /* Only continue if the node's statistics are tracked. */
+  if (nodeInfo != NULL)
+  {
+    /* Did the node respond? */
+    if (responded == TBX_TRUE)
+    {
+      /* Update the exponentially weighted moving averages of the response time and
+       * its deviation, with a weight of 1/8 and 1/4, respectively, for the new sample.
+       * The first response time initializes them, with half of it as the deviation.
+       */
+      if (nodeInfo->learned == TBX_FALSE)
+      {
+        nodeInfo->avgMsX8 = (uint32_t)respMs * 8U;
+        nodeInfo->devMsX4 = (uint16_t)(respMs * 2U);
+        nodeInfo->learned = TBX_TRUE;
+      }
+      else
+      {
+        /* Determine the deviation from the current average. */
+        uint16_t avgMs = (uint16_t)(nodeInfo->avgMsX8 / 8U);
+        uint16_t errMs = (respMs > avgMs) ? (uint16_t)(respMs - avgMs) :
+                                            (uint16_t)(avgMs - respMs);
+        nodeInfo->devMsX4 = (uint16_t)((nodeInfo->devMsX4 - (nodeInfo->devMsX4 / 4U)) +
+                                       errMs);
+        nodeInfo->avgMsX8 = (nodeInfo->avgMsX8 - (nodeInfo->avgMsX8 / 8U)) + respMs;
+      }
+      /* Update the maximum response time. */
+      if (respMs > nodeInfo->maxMs)
+      {
+        nodeInfo->maxMs = respMs;
+      }
+      /* The node no longer needs to be backed off. */
+      nodeInfo->timeouts = 0U;
+      nodeInfo->skipCount = 0U;
+    }
+    /* Response timeout. */
+    else
+    {
+      /* Update the consecutive response timeouts, with overflow protection. */
+      if (nodeInfo->timeouts < 255U)
+      {
+        nodeInfo->timeouts++;
+      }
+    }
+  }
+  TbxCriticalSectionExit();
+#else
+  TBX_UNUSED_ARG(clientCtx);
+  TBX_UNUSED_ARG(node);
+  TBX_UNUSED_ARG(responded);
+#endif
+} /*** end of TbxMbClientNodeUpdate ***/
+
+
+#if (TBX_MB_CLIENT_NODE_STATS_SIZE > 0U)
+/************************************************************************************//**
+** \brief     Helper function to look up the response time statistics of the specified
+**            node. Should be called from a critical section.
+** \param     clientCtx Pointer to the Modbus client channel for the requested operation.
+** \param     node The address of the server.
+** \param     create TBX_TRUE to start tracking the node's statistics, if not yet
+**            tracked. Once all entries are in use, the one that was added first is
+**            replaced.
+** \return    Pointer to the node's statistics, or NULL if not tracked.
+**
+****************************************************************************************/
+static tTbxMbClientNodeInfo * TbxMbClientNodeFind(tTbxMbClientCtx * clientCtx,
+                                                  uint8_t           node,
+                                                  uint8_t           create)
+{
+  tTbxMbClientNodeInfo * result = NULL;
+
+  /* Broadcast requests never get a response, so there is nothing to track for it. */
+  if (node != TBX_MB_TP_NODE_ADDR_BROADCAST)
+  {
+    /* Loop through the tracked nodes to find the one with a matching address. */
+    for (uint8_t idx = 0U; idx < clientCtx->nodeInfoCount; idx++)
+    {
+      if (clientCtx->nodeInfo[idx].node == node)
+      {
+        result = &clientCtx->nodeInfo[idx];
+        break;
+      }
+    }
+    /* Start tracking the node, if requested and not yet tracked. */
+    if ((result == NULL) && (create == TBX_TRUE))
+    {
+      /* Use the next unused entry. If none, replace the one that was added first. */
+      if (clientCtx->nodeInfoCount < TBX_MB_CLIENT_NODE_STATS_SIZE)
+      {
+        result = &clientCtx->nodeInfo[clientCtx->nodeInfoCount];
+        clientCtx->nodeInfoCount++;
+      }
+      else
+      {
+        result = &clientCtx->nodeInfo[clientCtx->nodeInfoNext];
+        clientCtx->nodeInfoNext++;
+        if (clientCtx->nodeInfoNext >= TBX_MB_CLIENT_NODE_STATS_SIZE)
+        {
+          clientCtx->nodeInfoNext = 0U;
+        }
+      }
+      /* Initialize the entry. */
+      result->node = node;
+      result->learned = TBX_FALSE;
+      result->timeouts = 0U;
+      result->skipCount = 0U;
+      result->avgMsX8 = 0U;
+      result->maxMs = 0U;
+      result->devMsX4 = 0U;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientNodeFind ***/
+#endif
+
+
+/************************************************************************************//**
+** \brief     Reads the coil(s) from the server with the specified node address.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            coil read operation.
+** \param     num Number of elements to read from the coils data table. Range can be
+**            1..2000.
+** \param     coils Pointer to array with TBX_ON / TBX_OFF values where the coil state
+**            will be written to.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientReadCoils(tTbxMbClient   channel,
+                             uint8_t        node,
+                             uint16_t       addr,
+                             uint16_t       num,
+                             uint8_t      * coils)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+             (num <= 2000U) && (coils != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+      (num <= 2000U) && (coils != NULL))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    /* Prepare the request. */
+    tTbxMbClientReq request = { 0 };
+    request.node = node;
+    request.code = TBX_MB_FC01_READ_COILS;
+    request.addr = addr;
+    request.num = num;
+    request.rxData = coils;
+    /* Execute the request and update the result accordingly. */
+    result = TbxMbClientReqExecute(clientCtx, &request);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReadCoils ***/
+
+
+/************************************************************************************//**
+** \brief     Reads the discrete input(s) from the server with the specified node
+**            address.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            discrete input read operation.
+** \param     num Number of elements to read from the discrete inputs data table. Range
+**            can be 1..2000
+** \param     inputs Pointer to array with TBX_ON / TBX_OFF values where the discrete
+**            input state will be written to.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientReadInputs(tTbxMbClient   channel,
+                              uint8_t        node,
+                              uint16_t       addr,
+                              uint16_t       num,
+                              uint8_t      * inputs)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+             (num <= 2000U) && (inputs != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+      (num <= 2000U) && (inputs != NULL))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    /* Prepare the request. */
+    tTbxMbClientReq request = { 0 };
+    request.node = node;
+    request.code = TBX_MB_FC02_READ_DISCRETE_INPUTS;
+    request.addr = addr;
+    request.num = num;
+    request.rxData = inputs;
+    /* Execute the request and update the result accordingly. */
+    result = TbxMbClientReqExecute(clientCtx, &request);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReadInputs ***/
+
+
+/************************************************************************************//**
+** \brief     Reads the input register(s) from the server with the specified node
+**            address.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            input register read operation.
+** \param     num Number of elements to read from the input registers data table. Range
+**            can be 1..125
+** \param     inputRegs Pointer to array where the input register values will be written
+**            to.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientReadInputRegs(tTbxMbClient   channel,
+                                 uint8_t        node,
+                                 uint16_t       addr,
+                                 uint8_t        num,
+                                 uint16_t     * inputRegs)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+             (num <= 125U) && (inputRegs != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+      (num <= 125U) && (inputRegs != NULL))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    /* Prepare the request. */
+    tTbxMbClientReq request = { 0 };
+    request.node = node;
+    request.code = TBX_MB_FC04_READ_INPUT_REGISTERS;
+    request.addr = addr;
+    request.num = num;
+    request.rxData = inputRegs;
+    /* Execute the request and update the result accordingly. */
+    result = TbxMbClientReqExecute(clientCtx, &request);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReadInputRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Reads the holding register(s) from the server with the specified node
+**            address.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            holding register read operation.
+** \param     num Number of elements to read from the holding registers data table. Range
+**            can be 1..125
+** \param     holdingRegs Pointer to array where the holding register values will be
+**            written to.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientReadHoldingRegs(tTbxMbClient   channel,
+                                   uint8_t        node,
+                                   uint16_t       addr,
+                                   uint8_t        num,
+                                   uint16_t     * holdingRegs)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+             (num <= 125U) && (holdingRegs != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+      (num <= 125U) && (holdingRegs != NULL))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    /* Prepare the request. */
+    tTbxMbClientReq request = { 0 };
+    request.node = node;
+    request.code = TBX_MB_FC03_READ_HOLDING_REGISTERS;
+    request.addr = addr;
+    request.num = num;
+    request.rxData = holdingRegs;
+    /* Execute the request and update the result accordingly. */
+    result = TbxMbClientReqExecute(clientCtx, &request);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReadHoldingRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Writes the coil(s) to the server with the specified node address.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            coil write operation.
+** \param     num Number of elements to write to the coils data table. Range can be
+**            1..1968
+** \param     coils Pointer to array with the desired TBX_ON / TBX_OFF coil values.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientWriteCoils(tTbxMbClient         channel,
+                              uint8_t              node,
+                              uint16_t             addr,
+                              uint16_t             num,
+                              uint8_t      const * coils)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+             (num <= 1968U) && (coils != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+      (num <= 1968U) && (coils != NULL))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    /* Prepare the request. Writing just a single coil has its own function code. */
+    tTbxMbClientReq request = { 0 };
+    request.node = node;
+    request.code = (num == 1U) ? TBX_MB_FC05_WRITE_SINGLE_COIL :
+                                 TBX_MB_FC15_WRITE_MULTIPLE_COILS;
+    request.addr = addr;
+    request.num = num;
+    request.txData = coils;
+    /* Execute the request and update the result accordingly. */
+    result = TbxMbClientReqExecute(clientCtx, &request);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientWriteCoils ***/
+
+
+/************************************************************************************//**
+** \brief     Writes the holding register(s) to the server with the specified node
+**            address.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            holding register write operation.
+** \param     num Number of elements to write to the holding registers data table. Range
+**            can be 1..123
+** \param     holdingRegs Pointer to array with the desired holding register values.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientWriteHoldingRegs(tTbxMbClient         channel,
+                                    uint8_t              node,
+                                    uint16_t             addr,
+                                    uint8_t              num,
+                                    uint16_t     const * holdingRegs)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+             (num <= 123U) && (holdingRegs != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+      (num <= 123U) && (holdingRegs != NULL))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    /* Prepare the request. Writing just a single holding register has its own function
+     * code.
+     */
+    tTbxMbClientReq request = { 0 };
+    request.node = node;
+    request.code = (num == 1U) ? TBX_MB_FC06_WRITE_SINGLE_REGISTER :
+                                 TBX_MB_FC16_WRITE_MULTIPLE_REGISTERS;
+    request.addr = addr;
+    request.num = num;
+    request.txData = holdingRegs;
+    /* Execute the request and update the result accordingly. */
+    result = TbxMbClientReqExecute(clientCtx, &request);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientWriteHoldingRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Writes holding registers to and reads holding registers from the server
+**            with the specified node address, with a single request. The server
+**            performs the write operation before the read operation.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     readAddr Starting element address (0..65535) in the Modbus data table for
+**            the holding register read operation.
+** \param     readNum Number of elements to read from the holding registers data table.
+**            Range can be 1..125
+** \param     readRegs Pointer to array where the read holding register values will be
+**            written to.
+** \param     writeAddr Starting element address (0..65535) in the Modbus data table for
+**            the holding register write operation.
+** \param     writeNum Number of elements to write to the holding registers data table.
+**            Range can be 1..121
+** \param     writeRegs Pointer to array with the desired holding register values.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientReadWriteHoldingRegs(tTbxMbClient         channel,
+                                        uint8_t              node,
+                                        uint16_t             readAddr,
+                                        uint8_t              readNum,
+                                        uint16_t           * readRegs,
+                                        uint16_t             writeAddr,
+                                        uint8_t              writeNum,
+                                        uint16_t     const * writeRegs)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) &&
+             (readNum >= 1U) && (readNum <= 125U) && (readRegs != NULL) &&
+             (writeNum >= 1U) && (writeNum <= 121U) && (writeRegs != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) &&
+      (readNum >= 1U) && (readNum <= 125U) && (readRegs != NULL) &&
+      (writeNum >= 1U) && (writeNum <= 121U) && (writeRegs != NULL))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    /* Prepare the request. */
+    tTbxMbClientReq request = { 0 };
+    request.node = node;
+    request.code = TBX_MB_FC23_READ_WRITE_MULTIPLE_REGISTERS;
+    request.addr = readAddr;
+    request.num = readNum;
+    request.rxData = readRegs;
+    request.writeAddr = writeAddr;
+    request.writeNum = writeNum;
+    request.txData = writeRegs;
+    /* Execute the request and update the result accordingly. */
+    result = TbxMbClientReqExecute(clientCtx, &request);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReadWriteHoldingRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Modifies the contents of a holding register on the server with the specified
+**            node address, using a combination of an AND mask and an OR mask. The server
+**            calculates the new register value as follows:
+**              (current value AND andMask) OR (orMask AND (NOT andMask))
+**            This makes it possible to set or clear individual bits of the holding
+**            register, without having to read out its current value first.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     addr Element address (0..65535) in the Modbus data table of the holding
+**            register to modify.
+** \param     andMask Bits to keep. A bit value of 0 changes the bit to the value of the
+**            same bit in the OR mask.
+** \param     orMask New values for the bits that are not kept.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientMaskWriteHoldingReg(tTbxMbClient   channel,
+                                       uint8_t        node,
+                                       uint16_t       addr,
+                                       uint16_t       andMask,
+                                       uint16_t       orMask)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    /* Prepare the request. The request's value and num elements hold the masks. */
+    tTbxMbClientReq request = { 0 };
+    request.node = node;
+    request.code = TBX_MB_FC22_MASK_WRITE_REGISTER;
+    request.addr = addr;
+    request.value = andMask;
+    request.num = orMask;
+    /* Execute the request and update the result accordingly. */
+    result = TbxMbClientReqExecute(clientCtx, &request);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientMaskWriteHoldingReg ***/
+
+
+/************************************************************************************//**
+** \brief     Reads consecutive records from a file on the server with the specified node
+**            address.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     file File number (1..65535) of the file to read from.
+** \param     record Number (0..9999) of the first record to read.
+** \param     num Number of records to read. Range can be 1..124.
+** \param     values Pointer to array where the read record values will be written to.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientReadFileRecord(tTbxMbClient   channel,
+                                  uint8_t        node,
+                                  uint16_t       file,
+                                  uint16_t       record,
+                                  uint8_t        num,
+                                  uint16_t     * values)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (file >= 1U) &&
+             (record <= 9999U) && (num >= 1U) && (num <= 124U) && (values != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (file >= 1U) &&
+      (record <= 9999U) && (num >= 1U) && (num <= 124U) && (values != NULL))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    /* Prepare the request. The request's writeAddr element holds the file number. */
+    tTbxMbClientReq request = { 0 };
+    request.node = node;
+    request.code = TBX_MB_FC20_READ_FILE_RECORD;
+    request.addr = record;
+    request.num = num;
+    request.writeAddr = file;
+    request.rxData = values;
+    /* Execute the request and update the result accordingly. */
+    result = TbxMbClientReqExecute(clientCtx, &request);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReadFileRecord ***/
+
+
+/************************************************************************************//**
+** \brief     Writes consecutive records to a file on the server with the specified node
+**            address.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     file File number (1..65535) of the file to write to.
+** \param     record Number (0..9999) of the first record to write.
+** \param     num Number of records to write. Range can be 1..122.
+** \param     values Pointer to array with the desired record values.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientWriteFileRecord(tTbxMbClient   channel,
+                                   uint8_t        node,
+                                   uint16_t       file,
+                                   uint16_t       record,
+                                   uint8_t        num,
+                                   uint16_t const * values)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (file >= 1U) &&
+             (record <= 9999U) && (num >= 1U) && (num <= 122U) && (values != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (file >= 1U) &&
+      (record <= 9999U) && (num >= 1U) && (num <= 122U) && (values != NULL))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    /* Prepare the request. The request's writeAddr element holds the file number. */
+    tTbxMbClientReq request = { 0 };
+    request.node = node;
+    request.code = TBX_MB_FC21_WRITE_FILE_RECORD;
+    request.addr = record;
+    request.num = num;
+    request.writeAddr = file;
+    request.txData = values;
+    /* Execute the request and update the result accordingly. */
+    result = TbxMbClientReqExecute(clientCtx, &request);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientWriteFileRecord ***/
+
+
+/************************************************************************************//**
+** \brief     Perform diagnostic operation on the server for checking the communication
+**            system.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     subcode Sub-function code for specifying the diagnostic operation to
+**            perform. Currently supported values:
+**              - TBX_MB_DIAG_SC_QUERY_DATA
+**              - TBX_MB_DIAG_SC_CLEAR_COUNTERS
+**              - TBX_MB_DIAG_SC_BUS_MESSAGE_COUNT
+**              - TBX_MB_DIAG_SC_BUS_COMM_ERROR_COUNT
+**              - TBX_MB_DIAG_SC_BUS_EXCEPTION_ERROR_COUNT
+**              - TBX_MB_DIAG_SC_SERVER_MESSAGE_COUNT
+**              - TBX_MB_DIAG_SC_SERVER_NO_RESPONSE_COUNT
+** \param     count Location where the retrieved count value will be written to. Only
+**            applicable for the subcodes that end with _COUNT.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientDiagnostics(tTbxMbClient   channel,
+                               uint8_t        node,
+                               uint16_t       subcode,
+                               uint16_t     * count)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) &&
+             ((subcode == TBX_MB_DIAG_SC_QUERY_DATA) ||
+              (subcode == TBX_MB_DIAG_SC_CLEAR_COUNTERS) ||
+              (subcode == TBX_MB_DIAG_SC_BUS_MESSAGE_COUNT) ||
+              (subcode == TBX_MB_DIAG_SC_BUS_COMM_ERROR_COUNT) ||
+              (subcode == TBX_MB_DIAG_SC_BUS_EXCEPTION_ERROR_COUNT) ||
+              (subcode == TBX_MB_DIAG_SC_SERVER_MESSAGE_COUNT) ||
+              (subcode == TBX_MB_DIAG_SC_SERVER_NO_RESPONSE_COUNT)));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) &&
+      ((subcode == TBX_MB_DIAG_SC_QUERY_DATA) ||
+       (subcode == TBX_MB_DIAG_SC_CLEAR_COUNTERS) ||
+       (subcode == TBX_MB_DIAG_SC_BUS_MESSAGE_COUNT) ||
+       (subcode == TBX_MB_DIAG_SC_BUS_COMM_ERROR_COUNT) ||
+       (subcode == TBX_MB_DIAG_SC_BUS_EXCEPTION_ERROR_COUNT) ||
+       (subcode == TBX_MB_DIAG_SC_SERVER_MESSAGE_COUNT) ||
+       (subcode == TBX_MB_DIAG_SC_SERVER_NO_RESPONSE_COUNT)))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    /* Prepare the request. Its address element holds the diagnostics subcode. */
+    tTbxMbClientReq request = { 0 };
+    request.node = node;
+    request.code = TBX_MB_FC08_DIAGNOSTICS;
+    request.addr = subcode;
+    request.rxData = count;
+    /* Execute the request and update the result accordingly. */
+    result = TbxMbClientReqExecute(clientCtx, &request);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientDiagnostics ***/
+
+
+/************************************************************************************//**
+** \brief     Send a custom function code PDU to the server and receive its response PDU.
+**            Thanks to this functionality, the user can support Modbus function codes
+**            that are either currently not supported or user defined extensions.
+** \details   The "txPdu" and "rxPdu" parameters are pointers to the byte array of the
+**            PDU. The first byte (i.e. txPdu[0]) contains the function code, followed by
+**            its data bytes. When calling this function, set the "len" parameter to the
+**            length of the "txPdu". This function updates the "len" parameter with the
+**            length of the received PDU, which it stores in "rxPdu".
+** \example   Example of manually sending the "Write Single Register 0x06" function code
+**            to a node with address 10 (0x0A) for setting the holding register at
+**            address 40000 to a value of 127:
+**
+**              uint8_t  requestPdu[TBX_MB_TP_PDU_MAX_LEN];
+**              uint8_t  responsePdu[TBX_MB_TP_PDU_MAX_LEN];
+**              uint8_t  pduLen;
+**              uint16_t holdingRegAddr = 40000U;
+**              uint16_t holdingRegValue = 127U;
+**
+**              requestPdu[0] = TBX_MB_FC06_WRITE_SINGLE_REGISTER;
+**              requestPdu[1] = (uint8_t)(holdingRegAddr >> 8U);
+**              requestPdu[2] = (uint8_t) holdingRegAddr;
+**              requestPdu[3] = (uint8_t)(holdingRegValue >> 8U);
+**              requestPdu[4] = (uint8_t) holdingRegValue;
+**              pduLen = 5U;
+**
+**              TbxMbClientCustomFunction(modbusClient, 0x0A, requestPdu, responsePdu,
+**                                        &pduLen);
+**
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     txPdu Pointer to a byte array with the PDU to transmit.
+** \param     rxPdu Pointer to a byte array with the received response PDU.
+** \param     len Pointer to the PDU length, including the function code.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientCustomFunction (tTbxMbClient         channel,
+                                   uint8_t              node,
+                                   uint8_t      const * txPdu,
+                                   uint8_t            * rxPdu,
+                                   uint8_t            * len)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (txPdu != NULL) &&
+             (rxPdu != NULL) && (len != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (txPdu != NULL) &&
+      (rxPdu != NULL) && (len != NULL))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    /* Prepare the request. */
+    tTbxMbClientReq request = { 0 };
+    request.node = node;
+    request.code = TBX_MB_CLIENT_CODE_CUSTOM;
+    request.txData = txPdu;
+    request.rxData = rxPdu;
+    request.len = len;
+    /* Execute the request and update the result accordingly. */
+    result = TbxMbClientReqExecute(clientCtx, &request);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientCustomFunction ***/
+
+
+/************************************************************************************//**
+** \brief     Send a custom function code PDU to the server and receive its response PDU,
+**            without intermediate buffers. Same as TbxMbClientCustomFunction(), except
+**            that the request PDU is built directly in the transport layer's request
+**            packet and the response PDU is parsed directly from its response packet.
+**            This avoids copying the PDU, which makes it well suited for large vendor
+**            specific function codes.
+** \details   The "buildFcn" callback function is called when the request is started.
+**            The "parseFcn" callback function is called upon reception of a valid
+**            response. Both run before this function returns.
+** \example   Example of a callback function that builds a "Write Single Register 0x06"
+**            request PDU, for setting the holding register at address 40000 to a value
+**            of 127:
+**
+**              uint8_t BuildWriteReg(tTbxMbClient channel, uint8_t * pdu,
+**                                    uint8_t * len, void * param)
+**              {
+**                pdu[0] = TBX_MB_FC06_WRITE_SINGLE_REGISTER;
+**                TbxMbCommonStoreUInt16BE(40000U, &pdu[1]);
+**                TbxMbCommonStoreUInt16BE(127U, &pdu[3]);
+**                *len = 5U;
+**                return TBX_OK;
+**              }
+**
+**              TbxMbClientCustomFunctionInPlace(modbusClient, 0x0A, BuildWriteReg, NULL,
+**                                               NULL);
+**
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     buildFcn Callback function that builds the request PDU.
+** \param     parseFcn Callback function that parses the response PDU. Can be NULL if
+**            the contents of the response PDU are not needed.
+** \param     param Parameter that is passed on to the callback functions.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientCustomFunctionInPlace(tTbxMbClient         channel,
+                                         uint8_t              node,
+                                         tTbxMbClientPduBuild buildFcn,
+                                         tTbxMbClientPduParse parseFcn,
+                                         void               * param)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) &&
+             (buildFcn != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (buildFcn != NULL))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    /* Prepare the request. */
+    tTbxMbClientReq request = { 0 };
+    request.node = node;
+    request.code = TBX_MB_CLIENT_CODE_CUSTOM_IN_PLACE;
+    request.buildFcn = buildFcn;
+    request.parseFcn = parseFcn;
+    request.rxData = param;
+    /* Execute the request and update the result accordingly. */
+    result = TbxMbClientReqExecute(clientCtx, &request);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientCustomFunctionInPlace ***/
+
+
+/************************************************************************************//**
+** \brief     Reads the device identification objects from the server with the specified
+**            node address. For stream access, the objects of the requested category
+**            might not fit in one response. In this case this function automatically
+**            continues with follow up requests, until all objects are read. Each
+**            object is passed on to the "objectFcn" callback function, straight from
+**            the response packet.
+** \details   Only a blocking version of this function is available, because reading
+**            all the objects can take multiple requests.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     code Read device id code. Supported values:
+**              - TBX_MB_DEVID_CODE_BASIC (stream access to the basic objects)
+**              - TBX_MB_DEVID_CODE_REGULAR (stream access to the regular objects)
+**              - TBX_MB_DEVID_CODE_EXTENDED (stream access to the extended objects)
+**              - TBX_MB_DEVID_CODE_INDIVIDUAL (access to one specific object)
+** \param     objectId Identifier of the object to start reading at, for stream access.
+**            Identifier of the object to read, for individual access. For example
+**            TBX_MB_DEVID_OBJ_VENDOR_NAME.
+** \param     objectFcn Callback function that is called for each object.
+** \param     param Parameter that is passed on to the callback function.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientReadDeviceId(tTbxMbClient               channel,
+                                uint8_t                    node,
+                                uint8_t                    code,
+                                uint8_t                    objectId,
+                                tTbxMbClientDeviceIdObject objectFcn,
+                                void                     * param)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) &&
+             (code >= TBX_MB_DEVID_CODE_BASIC) &&
+             (code <= TBX_MB_DEVID_CODE_INDIVIDUAL) && (objectFcn != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) &&
+      (code >= TBX_MB_DEVID_CODE_BASIC) &&
+      (code <= TBX_MB_DEVID_CODE_INDIVIDUAL) && (objectFcn != NULL))
+  {
+    /* Prepare the read device identification request state. */
+    tTbxMbClientDevIdReq devIdReq;
+    devIdReq.code = code;
+    devIdReq.objectId = objectId;
+    devIdReq.moreFollows = TBX_FALSE;
+    devIdReq.objectFcn = objectFcn;
+    devIdReq.param = param;
+    /* Keep requesting objects, until the server reports that no more objects follow. */
+    do
+    {
+      result = TbxMbClientCustomFunctionInPlace(channel, node, TbxMbClientDevIdBuild,
+                                                TbxMbClientDevIdParse, &devIdReq);
+    }
+    while ((result == TBX_OK) && (devIdReq.moreFollows == TBX_TRUE));
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReadDeviceId ***/
+
+
+/************************************************************************************//**
+** \brief     Writes a batch of coils and holding registers, to one or more servers,
+**            with back-to-back requests. A write operation with node address 0 is
+**            broadcast. Different from the individual write functions, the turnaround
+**            delay after a broadcast write is not waited for in full. It passes while
+**            the request of the next write operation is prepared, and only the
+**            remaining part of it is waited for. This makes it well suited for
+**            synchronously pushing setpoints to many servers. A failed write operation
+**            does not stop the batch. Each write operation's result element is updated
+**            with the outcome of just that write.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     writes Pointer to array with the write operations.
+** \param     count Number of write operations in the array.
+** \return    TBX_OK if all write operations were successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientWriteBatch(tTbxMbClient             channel,
+                              tTbxMbClientBatchWrite * writes,
+                              uint8_t                  count)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (writes != NULL) && (count >= 1U));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (writes != NULL) && (count >= 1U))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    /* Initialize the turnaround delay info and the result. */
+    uint8_t  turnaroundPending = TBX_FALSE;
+    uint16_t turnaroundTicks   = 0U;
+    result = TBX_OK;
+    /* Loop through all the write operations. */
+    for (uint8_t idx = 0U; idx < count; idx++)
+    {
+      tTbxMbClientBatchWrite * write = &writes[idx];
+      /* Determine the maximum number of elements for the data table. */
+      uint16_t numMax = (write->table == TBX_MB_CLIENT_BATCH_COILS) ? 1968U : 123U;
+      /* Verify the write operation. */
+      TBX_ASSERT((write->node <= TBX_MB_TP_NODE_ADDR_MAX) &&
+                 (write->table < TBX_MB_CLIENT_BATCH_NUM_TABLE) && (write->num >= 1U) &&
+                 (write->num <= numMax) && (write->data != NULL));
+      write->result = TBX_ERROR;
+      /* Only execute a valid write operation. */
+      if ((write->node <= TBX_MB_TP_NODE_ADDR_MAX) &&
+          (write->table < TBX_MB_CLIENT_BATCH_NUM_TABLE) && (write->num >= 1U) &&
+          (write->num <= numMax) && (write->data != NULL))
+      {
+        /* Prepare the request. Writing just a single element has its own function
+         * code.
+         */
+        tTbxMbClientReq request = { 0 };
+        request.node = write->node;
+        if (write->table == TBX_MB_CLIENT_BATCH_COILS)
+        {
+          request.code = (write->num == 1U) ? TBX_MB_FC05_WRITE_SINGLE_COIL :
+                                              TBX_MB_FC15_WRITE_MULTIPLE_COILS;
+        }
+        else
+        {
+          request.code = (write->num == 1U) ? TBX_MB_FC06_WRITE_SINGLE_REGISTER :
+                                              TBX_MB_FC16_WRITE_MULTIPLE_REGISTERS;
+        }
+        request.addr = write->addr;
+        request.num = write->num;
+        request.txData = write->data;
+        /* Execute the request and store its result. */
+        write->result = TbxMbClientBatchExecute(clientCtx, &request, &turnaroundPending,
+                                                &turnaroundTicks);
+      }
+      /* Update the aggregated result. */
+      if (write->result != TBX_OK)
+      {
+        result = TBX_ERROR;
+      }
+    }
+    /* Wait for the turnaround delay of the last broadcast write to pass, if still
+     * pending. Needed before the caller can start another request.
+     */
+    if (turnaroundPending == TBX_TRUE)
+    {
+      TbxMbClientTurnaroundWait(clientCtx, turnaroundTicks);
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientWriteBatch ***/
+
+
+/************************************************************************************//**
+** \brief     Obtains the response time statistics of the server with the specified
+**            node address. The client channel tracks these, if the configuration macro
+**            TBX_MB_CLIENT_NODE_STATS_SIZE is set to a value > 0.
+** \param     channel Handle to the Modbus client channel.
+** \param     node The address of the server.
+** \param     stats Pointer to where the statistics are written to.
+** \return    TBX_OK if successful, TBX_ERROR if the node's statistics are not tracked.
+**
+****************************************************************************************/
+uint8_t TbxMbClientGetNodeStats(tTbxMbClient            channel,
+                                uint8_t                 node,
+                                tTbxMbClientNodeStats * stats)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (stats != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (stats != NULL))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+#if (TBX_MB_CLIENT_NODE_STATS_SIZE > 0U)
+    /* Obtain the adaptive response timeout of the node. */
+    uint16_t timeoutMs = TbxMbClientNodeTimeout(clientCtx, node);
+    /* Copy the statistics of the node, if tracked. */
+    TbxCriticalSectionEnter();
+    tTbxMbClientNodeInfo * nodeInfo = TbxMbClientNodeFind(clientCtx, node, TBX_FALSE);
+    if (nodeInfo != NULL)
+    {
+      stats->avgMs = (uint16_t)(nodeInfo->avgMsX8 / 8U);
+      stats->maxMs = nodeInfo->maxMs;
+      stats->timeoutMs = timeoutMs;
+      stats->timeouts = nodeInfo->timeouts;
+      stats->backedOff = TBX_FALSE;
+#if (TBX_MB_CLIENT_BACKOFF_TIMEOUTS > 0U)
+      if (nodeInfo->timeouts >= TBX_MB_CLIENT_BACKOFF_TIMEOUTS)
+      {
+        stats->backedOff = TBX_TRUE;
+      }
+#endif
+      result = TBX_OK;
+    }
+    TbxCriticalSectionExit();
+#endif
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientGetNodeStats ***/
+
+
+/************************************************************************************//**
+** \brief     Reads the coil(s) from the server with the specified node address.
+** \details   Non-blocking version of TbxMbClientReadCoils(). It submits the request and
+**            returns right away. Once the request completes, the event task calls the
+**            "doneFcn" callback function. Only one asynchronous request can be in
+**            progress at a time, per channel. Additional requests are queued, if enabled
+**            with TBX_MB_CLIENT_QUEUE_SIZE. Make sure the memory that the pointer
+**            parameters point to, stays valid until the request completes.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            coil read operation.
+** \param     num Number of elements to read from the coils data table. Range can be
+**            1..2000.
+** \param     coils Pointer to array with TBX_ON / TBX_OFF values where the coil state
+**            will be written to.
+** \param     doneFcn Callback function to call when the request completed. Can be
+**            NULL if no completion notification is needed.
+** \param     doneParam Parameter that is passed on to the callback function.
+** \return    TBX_OK if the request was submitted, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientReadCoilsAsync(tTbxMbClient       channel,
+                                  uint8_t            node,
+                                  uint16_t           addr,
+                                  uint16_t           num,
+                                  uint8_t          * coils,
+                                  tTbxMbClientDone   doneFcn,
+                                  void             * doneParam)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+             (num <= 2000U) && (coils != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+      (num <= 2000U) && (coils != NULL))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    /* Prepare the request. */
+    tTbxMbClientReq request = { 0 };
+    request.node = node;
+    request.code = TBX_MB_FC01_READ_COILS;
+    request.addr = addr;
+    request.num = num;
+    request.rxData = coils;
+    request.doneFcn = doneFcn;
+    request.doneParam = doneParam;
+    /* Submit the request and update the result accordingly. */
+    result = TbxMbClientReqSubmit(clientCtx, &request);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReadCoilsAsync ***/
+
+
+/************************************************************************************//**
+** \brief     Reads the discrete input(s) from the server with the specified node
+**            address.
+** \details   Non-blocking version of TbxMbClientReadInputs(). It submits the request and
+**            returns right away. Once the request completes, the event task calls the
+**            "doneFcn" callback function. Only one asynchronous request can be in
+**            progress at a time, per channel. Additional requests are queued, if enabled
+**            with TBX_MB_CLIENT_QUEUE_SIZE. Make sure the memory that the pointer
+**            parameters point to, stays valid until the request completes.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            discrete input read operation.
+** \param     num Number of elements to read from the discrete inputs data table. Range
+**            can be 1..2000
+** \param     inputs Pointer to array with TBX_ON / TBX_OFF values where the discrete
+**            input state will be written to.
+** \param     doneFcn Callback function to call when the request completed. Can be
+**            NULL if no completion notification is needed.
+** \param     doneParam Parameter that is passed on to the callback function.
+** \return    TBX_OK if the request was submitted, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientReadInputsAsync(tTbxMbClient       channel,
+                                   uint8_t            node,
+                                   uint16_t           addr,
+                                   uint16_t           num,
+                                   uint8_t          * inputs,
+                                   tTbxMbClientDone   doneFcn,
+                                   void             * doneParam)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+             (num <= 2000U) && (inputs != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+      (num <= 2000U) && (inputs != NULL))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    /* Prepare the request. */
+    tTbxMbClientReq request = { 0 };
+    request.node = node;
+    request.code = TBX_MB_FC02_READ_DISCRETE_INPUTS;
+    request.addr = addr;
+    request.num = num;
+    request.rxData = inputs;
+    request.doneFcn = doneFcn;
+    request.doneParam = doneParam;
+    /* Submit the request and update the result accordingly. */
+    result = TbxMbClientReqSubmit(clientCtx, &request);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReadInputsAsync ***/
+
+
+/************************************************************************************//**
+** \brief     Reads the input register(s) from the server with the specified node
+**            address.
+** \details   Non-blocking version of TbxMbClientReadInputRegs(). It submits the request
+**            and returns right away. Once the request completes, the event task calls the
+**            "doneFcn" callback function. Only one asynchronous request can be in
+**            progress at a time, per channel. Additional requests are queued, if enabled
+**            with TBX_MB_CLIENT_QUEUE_SIZE. Make sure the memory that the pointer
+**            parameters point to, stays valid until the request completes.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            input register read operation.
+** \param     num Number of elements to read from the input registers data table. Range
+**            can be 1..125
+** \param     inputRegs Pointer to array where the input register values will be written
+**            to.
+** \param     doneFcn Callback function to call when the request completed. Can be
+**            NULL if no completion notification is needed.
+** \param     doneParam Parameter that is passed on to the callback function.
+** \return    TBX_OK if the request was submitted, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientReadInputRegsAsync(tTbxMbClient       channel,
+                                      uint8_t            node,
+                                      uint16_t           addr,
+                                      uint8_t            num,
+                                      uint16_t         * inputRegs,
+                                      tTbxMbClientDone   doneFcn,
+                                      void             * doneParam)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+             (num <= 125U) && (inputRegs != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+      (num <= 125U) && (inputRegs != NULL))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    /* Prepare the request. */
+    tTbxMbClientReq request = { 0 };
+    request.node = node;
+    request.code = TBX_MB_FC04_READ_INPUT_REGISTERS;
+    request.addr = addr;
+    request.num = num;
+    request.rxData = inputRegs;
+    request.doneFcn = doneFcn;
+    request.doneParam = doneParam;
+    /* Submit the request and update the result accordingly. */
+    result = TbxMbClientReqSubmit(clientCtx, &request);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReadInputRegsAsync ***/
+
+
+/************************************************************************************//**
+** \brief     Reads the holding register(s) from the server with the specified node
+**            address.
+** \details   Non-blocking version of TbxMbClientReadHoldingRegs(). It submits the request
+**            and returns right away. Once the request completes, the event task calls the
+**            "doneFcn" callback function. Only one asynchronous request can be in
+**            progress at a time, per channel. Additional requests are queued, if enabled
+**            with TBX_MB_CLIENT_QUEUE_SIZE. Make sure the memory that the pointer
+**            parameters point to, stays valid until the request completes.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            holding register read operation.
+** \param     num Number of elements to read from the holding registers data table. Range
+**            can be 1..125
+** \param     holdingRegs Pointer to array where the holding register values will be
+**            written to.
+** \param     doneFcn Callback function to call when the request completed. Can be
+**            NULL if no completion notification is needed.
+** \param     doneParam Parameter that is passed on to the callback function.
+** \return    TBX_OK if the request was submitted, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientReadHoldingRegsAsync(tTbxMbClient       channel,
+                                        uint8_t            node,
+                                        uint16_t           addr,
+                                        uint8_t            num,
+                                        uint16_t         * holdingRegs,
+                                        tTbxMbClientDone   doneFcn,
+                                        void             * doneParam)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+             (num <= 125U) && (holdingRegs != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+      (num <= 125U) && (holdingRegs != NULL))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    /* Prepare the request. */
+    tTbxMbClientReq request = { 0 };
+    request.node = node;
+    request.code = TBX_MB_FC03_READ_HOLDING_REGISTERS;
+    request.addr = addr;
+    request.num = num;
+    request.rxData = holdingRegs;
+    request.doneFcn = doneFcn;
+    request.doneParam = doneParam;
+    /* Submit the request and update the result accordingly. */
+    result = TbxMbClientReqSubmit(clientCtx, &request);
+  }
   /* Give the result back to the caller. */
   return result;
-} /*** end of TbxMbClientReadInputs ***/
+} /*** end of TbxMbClientReadHoldingRegsAsync ***/
 
 
 /************************************************************************************//**
-** \brief     Reads the input register(s) from the server with the specified node
-**            address.
+** \brief     Writes the coil(s) to the server with the specified node address.
+** \details   Non-blocking version of TbxMbClientWriteCoils(). It submits the request and
+**            returns right away. Once the request completes, the event task calls the
+**            "doneFcn" callback function. Only one asynchronous request can be in
+**            progress at a time, per channel. Additional requests are queued, if enabled
+**            with TBX_MB_CLIENT_QUEUE_SIZE. Make sure the memory that the pointer
+**            parameters point to, stays valid until the request completes.
 ** \param     channel Handle to the Modbus client channel for the requested operation.
 ** \param     node The address of the server. This parameter is transport layer
 **            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
 **            a gateway to an RTU network. If it's don't care, set it to a value of 1.
 ** \param     addr Starting element address (0..65535) in the Modbus data table for the
-**            input register read operation.
-** \param     num Number of elements to read from the input registers data table. Range
-**            can be 1..125
-** \param     inputRegs Pointer to array where the input register values will be written
-**            to.
-** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**            coil write operation.
+** \param     num Number of elements to write to the coils data table. Range can be
+**            1..1968
+** \param     coils Pointer to array with the desired TBX_ON / TBX_OFF coil values.
+** \param     doneFcn Callback function to call when the request completed. Can be
+**            NULL if no completion notification is needed.
+** \param     doneParam Parameter that is passed on to the callback function.
+** \return    TBX_OK if the request was submitted, TBX_ERROR otherwise.
 **
 ****************************************************************************************/
-uint8_t TbxMbClientReadInputRegs(tTbxMbClient   channel,
-                                 uint8_t        node,
-                                 uint16_t       addr,
-                                 uint8_t        num,
-                                 uint16_t     * inputRegs)
+uint8_t TbxMbClientWriteCoilsAsync(tTbxMbClient       channel,
+                                   uint8_t            node,
+                                   uint16_t           addr,
+                                   uint16_t           num,
+                                   uint8_t    const * coils,
+                                   tTbxMbClientDone   doneFcn,
+                                   void             * doneParam)
 {
   uint8_t result = TBX_ERROR;
 
   /* Verify the parameters. */
   TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
-             (num <= 125U) && (inputRegs != NULL));
+             (num <= 1968U) && (coils != NULL));
 
   /* Only continue with valid parameters. */
   if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
-      (num <= 125U) && (inputRegs != NULL))
+      (num <= 1968U) && (coils != NULL))
   {
     /* Convert the client channel pointer to the context structure. */
     tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
     /* Sanity check on the context type. */
     TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
-
-    /* Obtain write access to the request packet. */
-    tTbxMbTpPacket * txPacket = clientCtx->tpCtx->getTxPacketFcn(clientCtx->tpCtx);
-    /* Should always work, unless this function is being called recursively. Only
-     * continue with access for preparing the request packet.
-     */
-    if (txPacket != NULL)
-    {
-      /* Prepare the request packet. */
-      txPacket->node = node;
-      txPacket->pdu.code = TBX_MB_FC04_READ_INPUT_REGISTERS;
-      txPacket->dataLen = 4U;
-      /* Starting address. */
-      TbxMbCommonStoreUInt16BE(addr, &txPacket->pdu.data[0]);
-      /* Number of registers. */
-      TbxMbCommonStoreUInt16BE(num, &txPacket->pdu.data[2]);
-
-      /* Determine the request type (broadcast / unicast). */
-      uint8_t isBroadcast = TBX_FALSE;
-      if (node == TBX_MB_TP_NODE_ADDR_BROADCAST)
-      {
-        isBroadcast = TBX_TRUE;
-      }
-      /* Transmit the request and wait for the response to a unicast request to come in
-       * or the turnaround time to pass for a broadcast request.
-       */
-      result = TbxMbClientTransceive(clientCtx, isBroadcast);
-
-      /* Only continue with processing the response if all is okay so far and the request
-       * was unicast.
-       */
-      if ((result == TBX_OK) && (isBroadcast == TBX_FALSE))
-      {
-        /* Obtain read access to the response packet. */
-        tTbxMbTpPacket * rxPacket = clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx);
-        /* Since we just received a response packet, the packet access should always 
-         * succeed. Sanity check anyways, just in case.
-         */
-        TBX_ASSERT(rxPacket != NULL);
-        /* Only continue with packet access. */
-        if (rxPacket != NULL)
-        {
-          /* Check that the response came from the expected node, that it's a response
-           * with the same function code (not an exception response) and that the data
-           * length and the byte count are as expected.
-           */
-          uint8_t byteCount = rxPacket->pdu.data[0];
-          if ((rxPacket->node != node) ||
-              (rxPacket->pdu.code != TBX_MB_FC04_READ_INPUT_REGISTERS) ||
-              (byteCount != (num * 2U)) ||
-              (rxPacket->dataLen != (byteCount + 1U)) )
-          {
-            result = TBX_ERROR;
-          }
-          /* Response content valid. Process its data. */
-          else
-          {
-            /* Set pointer to where the input registers start in the response. */
-            uint8_t const * regValPtr = &rxPacket->pdu.data[1];
-            /* Read out and store the input register values. */
-            for (uint8_t idx = 0U; idx < num; idx++)
-            {
-              inputRegs[idx] = TbxMbCommonExtractUInt16BE(&regValPtr[idx * 2U]);
-            }
-          }
-        }
-        /* Could not access the response packet. */
-        else
-        {
-          result = TBX_ERROR;
-        }
-        /* Inform the transport layer that were done with the rx packet and no longer
-         * need access to it.
-         */
-        clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
-      }
-    }
+    /* Prepare the request. Writing just a single coil has its own function code. */
+    tTbxMbClientReq request = { 0 };
+    request.node = node;
+    request.code = (num == 1U) ? TBX_MB_FC05_WRITE_SINGLE_COIL :
+                                 TBX_MB_FC15_WRITE_MULTIPLE_COILS;
+    request.addr = addr;
+    request.num = num;
+    request.txData = coils;
+    request.doneFcn = doneFcn;
+    request.doneParam = doneParam;
+    /* Submit the request and update the result accordingly. */
+    result = TbxMbClientReqSubmit(clientCtx, &request);
   }
   /* Give the result back to the caller. */
   return result;
-} /*** end of TbxMbClientReadInputRegs ***/
+} /*** end of TbxMbClientWriteCoilsAsync ***/
 
 
 /************************************************************************************//**
-** \brief     Reads the holding register(s) from the server with the specified node
+** \brief     Writes the holding register(s) to the server with the specified node
 **            address.
+** \details   Non-blocking version of TbxMbClientWriteHoldingRegs(). It submits the
+**            request and returns right away. Once the request completes, the event task
+**            calls the "doneFcn" callback function. Only one asynchronous request can be
+**            in progress at a time, per channel. Additional requests are queued, if
+**            enabled with TBX_MB_CLIENT_QUEUE_SIZE. Make sure the memory that the pointer
+**            parameters point to, stays valid until the request completes.
 ** \param     channel Handle to the Modbus client channel for the requested operation.
 ** \param     node The address of the server. This parameter is transport layer
 **            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
 **            a gateway to an RTU network. If it's don't care, set it to a value of 1.
 ** \param     addr Starting element address (0..65535) in the Modbus data table for the
-**            holding register read operation.
-** \param     num Number of elements to read from the holding registers data table. Range
-**            can be 1..125
-** \param     holdingRegs Pointer to array where the holding register values will be
-**            written to.
-** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**            holding register write operation.
+** \param     num Number of elements to write to the holding registers data table. Range
+**            can be 1..123
+** \param     holdingRegs Pointer to array with the desired holding register values.
+** \param     doneFcn Callback function to call when the request completed. Can be
+**            NULL if no completion notification is needed.
+** \param     doneParam Parameter that is passed on to the callback function.
+** \return    TBX_OK if the request was submitted, TBX_ERROR otherwise.
 **
 ****************************************************************************************/
-uint8_t TbxMbClientReadHoldingRegs(tTbxMbClient   channel,
-                                   uint8_t        node,
-                                   uint16_t       addr,
-                                   uint8_t        num,
-                                   uint16_t     * holdingRegs)
+uint8_t TbxMbClientWriteHoldingRegsAsync(tTbxMbClient       channel,
+                                         uint8_t            node,
+                                         uint16_t           addr,
+                                         uint8_t            num,
+                                         uint16_t   const * holdingRegs,
+                                         tTbxMbClientDone   doneFcn,
+                                         void             * doneParam)
 {
   uint8_t result = TBX_ERROR;
 
   /* Verify the parameters. */
   TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
-             (num <= 125U) && (holdingRegs != NULL));
+             (num <= 123U) && (holdingRegs != NULL));
 
   /* Only continue with valid parameters. */
   if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
-      (num <= 125U) && (holdingRegs != NULL))
+      (num <= 123U) && (holdingRegs != NULL))
   {
     /* Convert the client channel pointer to the context structure. */
     tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
     /* Sanity check on the context type. */
     TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
-
-    /* Obtain write access to the request packet. */
-    tTbxMbTpPacket * txPacket = clientCtx->tpCtx->getTxPacketFcn(clientCtx->tpCtx);
-    /* Should always work, unless this function is being called recursively. Only
-     * continue with access for preparing the request packet.
+    /* Prepare the request. Writing just a single holding register has its own function
+     * code.
      */
-    if (txPacket != NULL)
-    {
-      /* Prepare the request packet. */
-      txPacket->node = node;
-      txPacket->pdu.code = TBX_MB_FC03_READ_HOLDING_REGISTERS;
-      txPacket->dataLen = 4U;
-      /* Starting address. */
-      TbxMbCommonStoreUInt16BE(addr, &txPacket->pdu.data[0]);
-      /* Number of registers. */
-      TbxMbCommonStoreUInt16BE(num, &txPacket->pdu.data[2]);
+    tTbxMbClientReq request = { 0 };
+    request.node = node;
+    request.code = (num == 1U) ? TBX_MB_FC06_WRITE_SINGLE_REGISTER :
+                                 TBX_MB_FC16_WRITE_MULTIPLE_REGISTERS;
+    request.addr = addr;
+    request.num = num;
+    request.txData = holdingRegs;
+    request.doneFcn = doneFcn;
+    request.doneParam = doneParam;
+    /* Submit the request and update the result accordingly. */
+    result = TbxMbClientReqSubmit(clientCtx, &request);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientWriteHoldingRegsAsync ***/
 
-      /* Determine the request type (broadcast / unicast). */
-      uint8_t isBroadcast = TBX_FALSE;
-      if (node == TBX_MB_TP_NODE_ADDR_BROADCAST)
-      {
-        isBroadcast = TBX_TRUE;
-      }
-      /* Transmit the request and wait for the response to a unicast request to come in
-       * or the turnaround time to pass for a broadcast request.
-       */
-      result = TbxMbClientTransceive(clientCtx, isBroadcast);
 
-      /* Only continue with processing the response if all is okay so far and the request
-       * was unicast.
-       */
-      if ((result == TBX_OK) && (isBroadcast == TBX_FALSE))
-      {
-        /* Obtain read access to the response packet. */
-        tTbxMbTpPacket * rxPacket = clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx);
-        /* Since we just received a response packet, the packet access should always 
-         * succeed. Sanity check anyways, just in case.
-         */
-        TBX_ASSERT(rxPacket != NULL);
-        /* Only continue with packet access. */
-        if (rxPacket != NULL)
-        {
-          /* Check that the response came from the expected node, that it's a response
-           * with the same function code (not an exception response) and that the data
-           * length and the byte count are as expected.
-           */
-          uint8_t byteCount = rxPacket->pdu.data[0];
-          if ((rxPacket->node != node) ||
-              (rxPacket->pdu.code != TBX_MB_FC03_READ_HOLDING_REGISTERS) ||
-              (byteCount != (num * 2U)) ||
-              (rxPacket->dataLen != (byteCount + 1U)) )
-          {
-            result = TBX_ERROR;
-          }
-          /* Response content valid. Process its data. */
-          else
-          {
-            /* Set pointer to where the holding registers start in the response. */
-            uint8_t const * regValPtr = &rxPacket->pdu.data[1];
-            /* Read out and store the holding register values. */
-            for (uint8_t idx = 0U; idx < num; idx++)
-            {
-              holdingRegs[idx] = TbxMbCommonExtractUInt16BE(&regValPtr[idx * 2U]);
-            }
-          }
-        }
-        /* Could not access the response packet. */
-        else
-        {
-          result = TBX_ERROR;
-        }
-        /* Inform the transport layer that were done with the rx packet and no longer
-         * need access to it.
-         */
-        clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
-      }
-    }
+/************************************************************************************//**
+** \brief     Writes holding registers to and reads holding registers from the server
+**            with the specified node address, with a single request.
+** \details   Non-blocking version of TbxMbClientReadWriteHoldingRegs(). It submits the
+**            request and returns right away. Once the request completes, the event task
+**            calls the "doneFcn" callback function. Only one asynchronous request can be
+**            in progress at a time, per channel. Additional requests are queued, if
+**            enabled with TBX_MB_CLIENT_QUEUE_SIZE. Make sure the memory that the
+**            pointer parameters point to, stays valid until the request completes.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     readAddr Starting element address (0..65535) in the Modbus data table for
+**            the holding register read operation.
+** \param     readNum Number of elements to read from the holding registers data table.
+**            Range can be 1..125
+** \param     readRegs Pointer to array where the read holding register values will be
+**            written to.
+** \param     writeAddr Starting element address (0..65535) in the Modbus data table for
+**            the holding register write operation.
+** \param     writeNum Number of elements to write to the holding registers data table.
+**            Range can be 1..121
+** \param     writeRegs Pointer to array with the desired holding register values.
+** \param     doneFcn Callback function to call when the request completed. Can be
+**            NULL if no completion notification is needed.
+** \param     doneParam Parameter that is passed on to the callback function.
+** \return    TBX_OK if the request was submitted, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientReadWriteHoldingRegsAsync(tTbxMbClient       channel,
+                                             uint8_t            node,
+                                             uint16_t           readAddr,
+                                             uint8_t            readNum,
+                                             uint16_t         * readRegs,
+                                             uint16_t           writeAddr,
+                                             uint8_t            writeNum,
+                                             uint16_t   const * writeRegs,
+                                             tTbxMbClientDone   doneFcn,
+                                             void             * doneParam)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) &&
+             (readNum >= 1U) && (readNum <= 125U) && (readRegs != NULL) &&
+             (writeNum >= 1U) && (writeNum <= 121U) && (writeRegs != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) &&
+      (readNum >= 1U) && (readNum <= 125U) && (readRegs != NULL) &&
+      (writeNum >= 1U) && (writeNum <= 121U) && (writeRegs != NULL))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    /* Prepare the request. */
+    tTbxMbClientReq request = { 0 };
+    request.node = node;
+    request.code = TBX_MB_FC23_READ_WRITE_MULTIPLE_REGISTERS;
+    request.addr = readAddr;
+    request.num = readNum;
+    request.rxData = readRegs;
+    request.writeAddr = writeAddr;
+    request.writeNum = writeNum;
+    request.txData = writeRegs;
+    request.doneFcn = doneFcn;
+    request.doneParam = doneParam;
+    /* Submit the request and update the result accordingly. */
+    result = TbxMbClientReqSubmit(clientCtx, &request);
   }
   /* Give the result back to the caller. */
   return result;
-} /*** end of TbxMbClientReadHoldingRegs ***/
+} /*** end of TbxMbClientReadWriteHoldingRegsAsync ***/
 
 
 /************************************************************************************//**
-** \brief     Writes the coil(s) to the server with the specified node address.
+** \brief     Modifies the contents of a holding register on the server with the specified
+**            node address, using a combination of an AND mask and an OR mask.
+** \details   Non-blocking version of TbxMbClientMaskWriteHoldingReg(). It submits the
+**            request and returns right away. Once the request completes, the event task
+**            calls the "doneFcn" callback function. Only one asynchronous request can be
+**            in progress at a time, per channel. Additional requests are queued, if
+**            enabled with TBX_MB_CLIENT_QUEUE_SIZE.
 ** \param     channel Handle to the Modbus client channel for the requested operation.
 ** \param     node The address of the server. This parameter is transport layer
 **            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
 **            a gateway to an RTU network. If it's don't care, set it to a value of 1.
-** \param     addr Starting element address (0..65535) in the Modbus data table for the
-**            coil write operation.
-** \param     num Number of elements to write to the coils data table. Range can be
-**            1..1968
-** \param     coils Pointer to array with the desired TBX_ON / TBX_OFF coil values.
-** \return    TBX_OK if successful, TBX_ERROR otherwise.
+** \param     addr Element address (0..65535) in the Modbus data table of the holding
+**            register to modify.
+** \param     andMask Bits to keep. A bit value of 0 changes the bit to the value of the
+**            same bit in the OR mask.
+** \param     orMask New values for the bits that are not kept.
+** \param     doneFcn Callback function to call when the request completed. Can be
+**            NULL if no completion notification is needed.
+** \param     doneParam Parameter that is passed on to the callback function.
+** \return    TBX_OK if the request was submitted, TBX_ERROR otherwise.
 **
 ****************************************************************************************/
-uint8_t TbxMbClientWriteCoils(tTbxMbClient         channel,
-                              uint8_t              node,
-                              uint16_t             addr,
-                              uint16_t             num,
-                              uint8_t      const * coils)
+uint8_t TbxMbClientMaskWriteHoldingRegAsync(tTbxMbClient       channel,
+                                            uint8_t            node,
+                                            uint16_t           addr,
+                                            uint16_t           andMask,
+                                            uint16_t           orMask,
+                                            tTbxMbClientDone   doneFcn,
+                                            void             * doneParam)
 {
   uint8_t result = TBX_ERROR;
 
   /* Verify the parameters. */
-  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
-             (num <= 1968U) && (coils != NULL));
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX));
 
   /* Only continue with valid parameters. */
-  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
-      (num <= 1968U) && (coils != NULL))
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX))
   {
     /* Convert the client channel pointer to the context structure. */
     tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
     /* Sanity check on the context type. */
     TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    /* Prepare the request. The request's value and num elements hold the masks. */
+    tTbxMbClientReq request = { 0 };
+    request.node = node;
+    request.code = TBX_MB_FC22_MASK_WRITE_REGISTER;
+    request.addr = addr;
+    request.value = andMask;
+    request.num = orMask;
+    request.doneFcn = doneFcn;
+    request.doneParam = doneParam;
+    /* Submit the request and update the result accordingly. */
+    result = TbxMbClientReqSubmit(clientCtx, &request);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientMaskWriteHoldingRegAsync ***/
 
-    /* Obtain write access to the request packet. */
-    tTbxMbTpPacket * txPacket = clientCtx->tpCtx->getTxPacketFcn(clientCtx->tpCtx);
-    /* Should always work, unless this function is being called recursively. Only
-     * continue with access for preparing the request packet.
-     */
-    if (txPacket != NULL)
-    {
-      /* Writing just a single coil? */
-      if (num == 1U)
-      {
-        /* Prepare the request packet. */
-        txPacket->node = node;
-        txPacket->pdu.code = TBX_MB_FC05_WRITE_SINGLE_COIL;
-        txPacket->dataLen = 4U;
-        /* Coil address. */
-        TbxMbCommonStoreUInt16BE(addr, &txPacket->pdu.data[0]);
-        /* Coil value. */
-        uint16_t coilValue = (coils[0] == TBX_OFF) ? 0x0000U : 0xFF00U;
-        TbxMbCommonStoreUInt16BE(coilValue, &txPacket->pdu.data[2]);
-      }
-      /* Writing multiple coils. */
-      else
-      {
-        /* Determine the number of bytes needed to hold all the coil bits. The cast to
-         * U8 is okay, because we know that num is <= 1968.
-         */
-        uint8_t numBytes = (uint8_t)(num / 8U);
-        if ((num % 8U) != 0U)
-        {
-          numBytes++;
-        }
-        /* Prepare the request packet. */
-        txPacket->node = node;
-        txPacket->pdu.code = TBX_MB_FC15_WRITE_MULTIPLE_COILS;
-        txPacket->dataLen = numBytes + 5U;
-        /* Start address. */
-        TbxMbCommonStoreUInt16BE(addr, &txPacket->pdu.data[0]);
-        /* Number of holding registers. */
-        TbxMbCommonStoreUInt16BE(num, &txPacket->pdu.data[2]);
-        /* Byte count. */
-        txPacket->pdu.data[4] = numBytes;
-        /* Prepare loop indices that aid with reading the input bits. */
-        uint8_t   bitIdx  = 0U;
-        uint8_t   byteIdx = 0U;
-        /* Set pointer to where the coils start in the request and already initialize the
-         * first byte to all zero (coil OFF) bits.
-        */
-        uint8_t * coilData = &txPacket->pdu.data[5];
-        coilData[0] = 0U;
-        /* Store the coil values. */
-        for (uint16_t idx = 0U; idx < num; idx++)
-        {
-          /* Should the coil be ON? */
-          if (coils[idx] != TBX_OFF)
-          {
-            coilData[byteIdx] |= (1U << bitIdx);
-          }
-          /* Update the bit index. */
-          bitIdx++;
-          /* Time to move to the next byte? */
-          if (bitIdx == 8U)
-          {
-            /* Reset the bit index, increment the byte index and initialize the byte to
-             * all zero (coil OFF) bits.
-             */
-            bitIdx = 0U;
-            byteIdx++;
-            coilData[byteIdx] = 0U;
-          }
-        }
-      }
-      /* Determine the request type (broadcast / unicast). */
-      uint8_t isBroadcast = TBX_FALSE;
-      if (node == TBX_MB_TP_NODE_ADDR_BROADCAST)
-      {
-        isBroadcast = TBX_TRUE;
-      }
-      /* Transmit the request and wait for the response to a unicast request to come in
-       * or the turnaround time to pass for a broadcast request.
-       */
-      result = TbxMbClientTransceive(clientCtx, isBroadcast);
 
-      /* Only continue with processing the response if all is okay so far and the request
-       * was unicast.
-       */
-      if ((result == TBX_OK) && (isBroadcast == TBX_FALSE))
-      {
-        /* Obtain read access to the response packet. */
-        tTbxMbTpPacket * rxPacket = clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx);
-        /* Since we just received a response packet, the packet access should always 
-         * succeed. Sanity check anyways, just in case.
-         */
-        TBX_ASSERT(rxPacket != NULL);
-        /* Only continue with packet access. */
-        if (rxPacket != NULL)
-        {
-          /* Wrote just a single coil? */
-          if (num == 1U)
-          {
-            /* Coil value. */
-            uint16_t coilValue = (coils[0] == TBX_OFF) ? 0x0000U : 0xFF00U;
-            /* Check that the response came from the expected node, that it's a response
-             * with the same function code (not an exception response), that the coil
-             * address and value are as expected and that the data length is as
-             * expected.
-             */
-            if ((rxPacket->node != node) ||
-                (rxPacket->pdu.code != TBX_MB_FC05_WRITE_SINGLE_COIL) ||
-                (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]) != addr) ||
-                (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]) != coilValue) ||
-                (rxPacket->dataLen != 4U))
-            {
-              result = TBX_ERROR;
-            }
-          }
-          /* Wrote multiple holding registers. */
-          else
-          {
-            /* Check that the response came from the expected node, that it's a response
-             * with the same function code (not an exception response), that the coil
-             * start address and quantity are as expected and that the data length is as
-             * expected.
-             */
-            if ((rxPacket->node != node) ||
-                (rxPacket->pdu.code != TBX_MB_FC15_WRITE_MULTIPLE_COILS) ||
-                (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]) != addr) ||
-                (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]) != num) ||
-                (rxPacket->dataLen != 4U))
-            {
-              result = TBX_ERROR;
-            }
-          }
-        }
-        /* Could not access the response packet. */
-        else
-        {
-          result = TBX_ERROR;
-        }
-        /* Inform the transport layer that were done with the rx packet and no longer
-         * need access to it.
-         */
-        clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
-      }
-    }
-  }  
+/************************************************************************************//**
+** \brief     Reads consecutive records from a file on the server with the specified node
+**            address.
+** \details   Non-blocking version of TbxMbClientReadFileRecord(). It submits the
+**            request and returns right away. Once the request completes, the event task
+**            calls the "doneFcn" callback function. Only one asynchronous request can be
+**            in progress at a time, per channel. Additional requests are queued, if
+**            enabled with TBX_MB_CLIENT_QUEUE_SIZE. Make sure the memory that the pointer
+**            parameters point to, stays valid until the request completes.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     file File number (1..65535) of the file to read from.
+** \param     record Number (0..9999) of the first record to read.
+** \param     num Number of records to read. Range can be 1..124.
+** \param     values Pointer to array where the read record values will be written to.
+** \param     doneFcn Callback function to call when the request completed. Can be
+**            NULL if no completion notification is needed.
+** \param     doneParam Parameter that is passed on to the callback function.
+** \return    TBX_OK if the request was submitted, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientReadFileRecordAsync(tTbxMbClient       channel,
+                                       uint8_t            node,
+                                       uint16_t           file,
+                                       uint16_t           record,
+                                       uint8_t            num,
+                                       uint16_t         * values,
+                                       tTbxMbClientDone   doneFcn,
+                                       void             * doneParam)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (file >= 1U) &&
+             (record <= 9999U) && (num >= 1U) && (num <= 124U) && (values != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (file >= 1U) &&
+      (record <= 9999U) && (num >= 1U) && (num <= 124U) && (values != NULL))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    /* Prepare the request. The request's writeAddr element holds the file number. */
+    tTbxMbClientReq request = { 0 };
+    request.node = node;
+    request.code = TBX_MB_FC20_READ_FILE_RECORD;
+    request.addr = record;
+    request.num = num;
+    request.writeAddr = file;
+    request.rxData = values;
+    request.doneFcn = doneFcn;
+    request.doneParam = doneParam;
+    /* Submit the request and update the result accordingly. */
+    result = TbxMbClientReqSubmit(clientCtx, &request);
+  }
   /* Give the result back to the caller. */
   return result;
-} /*** end of TbxMbClientWriteCoils ***/
+} /*** end of TbxMbClientReadFileRecordAsync ***/
 
 
 /************************************************************************************//**
-** \brief     Writes the holding register(s) to the server with the specified node
+** \brief     Writes consecutive records to a file on the server with the specified node
 **            address.
+** \details   Non-blocking version of TbxMbClientWriteFileRecord(). It submits the
+**            request and returns right away. Once the request completes, the event task
+**            calls the "doneFcn" callback function. Only one asynchronous request can be
+**            in progress at a time, per channel. Additional requests are queued, if
+**            enabled with TBX_MB_CLIENT_QUEUE_SIZE. Make sure the memory that the pointer
+**            parameters point to, stays valid until the request completes.
 ** \param     channel Handle to the Modbus client channel for the requested operation.
 ** \param     node The address of the server. This parameter is transport layer
 **            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
 **            a gateway to an RTU network. If it's don't care, set it to a value of 1.
-** \param     addr Starting element address (0..65535) in the Modbus data table for the
-**            holding register write operation.
-** \param     num Number of elements to write to the holding registers data table. Range
-**            can be 1..123
-** \param     holdingRegs Pointer to array with the desired holding register values.
-** \return    TBX_OK if successful, TBX_ERROR otherwise.
+** \param     file File number (1..65535) of the file to write to.
+** \param     record Number (0..9999) of the first record to write.
+** \param     num Number of records to write. Range can be 1..122.
+** \param     values Pointer to array with the desired record values.
+** \param     doneFcn Callback function to call when the request completed. Can be
+**            NULL if no completion notification is needed.
+** \param     doneParam Parameter that is passed on to the callback function.
+** \return    TBX_OK if the request was submitted, TBX_ERROR otherwise.
 **
 ****************************************************************************************/
-uint8_t TbxMbClientWriteHoldingRegs(tTbxMbClient         channel,
-                                    uint8_t              node,
-                                    uint16_t             addr,
-                                    uint8_t              num,
-                                    uint16_t     const * holdingRegs)
+uint8_t TbxMbClientWriteFileRecordAsync(tTbxMbClient       channel,
+                                        uint8_t            node,
+                                        uint16_t           file,
+                                        uint16_t           record,
+                                        uint8_t            num,
+                                        uint16_t const   * values,
+                                        tTbxMbClientDone   doneFcn,
+                                        void             * doneParam)
 {
   uint8_t result = TBX_ERROR;
 
   /* Verify the parameters. */
-  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
-             (num <= 123U) && (holdingRegs != NULL));
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (file >= 1U) &&
+             (record <= 9999U) && (num >= 1U) && (num <= 122U) && (values != NULL));
 
   /* Only continue with valid parameters. */
-  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
-      (num <= 123U) && (holdingRegs != NULL))
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (file >= 1U) &&
+      (record <= 9999U) && (num >= 1U) && (num <= 122U) && (values != NULL))
   {
     /* Convert the client channel pointer to the context structure. */
     tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
     /* Sanity check on the context type. */
     TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
-
-    /* Obtain write access to the request packet. */
-    tTbxMbTpPacket * txPacket = clientCtx->tpCtx->getTxPacketFcn(clientCtx->tpCtx);
-    /* Should always work, unless this function is being called recursively. Only
-     * continue with access for preparing the request packet.
-     */
-    if (txPacket != NULL)
-    {
-      /* Writing just a single holding register? */
-      if (num == 1U)
-      {
-        /* Prepare the request packet. */
-        txPacket->node = node;
-        txPacket->pdu.code = TBX_MB_FC06_WRITE_SINGLE_REGISTER;
-        txPacket->dataLen = 4U;
-        /* Holding register address. */
-        TbxMbCommonStoreUInt16BE(addr, &txPacket->pdu.data[0]);
-        /* Holding register value. */
-        TbxMbCommonStoreUInt16BE(holdingRegs[0], &txPacket->pdu.data[2]);
-      }
-      /* Writing multiple holding registers. */
-      else
-      {
-        /* Determine byte count needed for storing the holding register values. */
-        uint8_t byteCount = num * 2U;
-        /* Prepare the request packet. */
-        txPacket->node = node;
-        txPacket->pdu.code = TBX_MB_FC16_WRITE_MULTIPLE_REGISTERS;
-        txPacket->dataLen = byteCount + 5U;
-        /* Start address. */
-        TbxMbCommonStoreUInt16BE(addr, &txPacket->pdu.data[0]);
-        /* Number of holding registers. */
-        TbxMbCommonStoreUInt16BE(num, &txPacket->pdu.data[2]);
-        /* Byte count. */
-        txPacket->pdu.data[4] = byteCount;
-        /* Set pointer to where the holding registers start in the request. */
-        uint8_t * regValPtr = &txPacket->pdu.data[5];
-        /* Store the holding register values. */
-        for (uint8_t idx = 0U; idx < num; idx++)
-        {
-          TbxMbCommonStoreUInt16BE(holdingRegs[idx], &regValPtr[idx * 2U]);
-        }
-      }
-      /* Determine the request type (broadcast / unicast). */
-      uint8_t isBroadcast = TBX_FALSE;
-      if (node == TBX_MB_TP_NODE_ADDR_BROADCAST)
-      {
-        isBroadcast = TBX_TRUE;
-      }
-      /* Transmit the request and wait for the response to a unicast request to come in
-       * or the turnaround time to pass for a broadcast request.
-       */
-      result = TbxMbClientTransceive(clientCtx, isBroadcast);
-
-      /* Only continue with processing the response if all is okay so far and the request
-       * was unicast.
-       */
-      if ((result == TBX_OK) && (isBroadcast == TBX_FALSE))
-      {
-        /* Obtain read access to the response packet. */
-        tTbxMbTpPacket * rxPacket = clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx);
-        /* Since we just received a response packet, the packet access should always 
-         * succeed. Sanity check anyways, just in case.
-         */
-        TBX_ASSERT(rxPacket != NULL);
-        /* Only continue with packet access. */
-        if (rxPacket != NULL)
-        {
-          /* Wrote just a single holding register? */
-          if (num == 1U)
-          {
-            /* Check that the response came from the expected node, that it's a response
-             * with the same function code (not an exception response), that the register
-             * address and values are as expected and that the data length is as
-             * expected.
-             */
-            if ((rxPacket->node != node) ||
-                (rxPacket->pdu.code != TBX_MB_FC06_WRITE_SINGLE_REGISTER) ||
-                (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]) != addr) ||
-                (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]) != holdingRegs[0]) ||
-                (rxPacket->dataLen != 4U))
-            {
-              result = TBX_ERROR;
-            }
-          }
-          /* Wrote multiple holding registers. */
-          else
-          {
-            /* Check that the response came from the expected node, that it's a response
-             * with the same function code (not an exception response), that the register
-             * start address and quantity are as expected and that the data length is as
-             * expected.
-             */
-            if ((rxPacket->node != node) ||
-                (rxPacket->pdu.code != TBX_MB_FC16_WRITE_MULTIPLE_REGISTERS) ||
-                (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]) != addr) ||
-                (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]) != num) ||
-                (rxPacket->dataLen != 4U))
-            {
-              result = TBX_ERROR;
-            }
-          }
-        }
-        /* Could not access the response packet. */
-        else
-        {
-          result = TBX_ERROR;
-        }
-        /* Inform the transport layer that were done with the rx packet and no longer
-         * need access to it.
-         */
-        clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
-      }
-    }
-
-  }      
+    /* Prepare the request. The request's writeAddr element holds the file number. */
+    tTbxMbClientReq request = { 0 };
+    request.node = node;
+    request.code = TBX_MB_FC21_WRITE_FILE_RECORD;
+    request.addr = record;
+    request.num = num;
+    request.writeAddr = file;
+    request.txData = values;
+    request.doneFcn = doneFcn;
+    request.doneParam = doneParam;
+    /* Submit the request and update the result accordingly. */
+    result = TbxMbClientReqSubmit(clientCtx, &request);
+  }
   /* Give the result back to the caller. */
   return result;
-} /*** end of TbxMbClientWriteHoldingRegs ***/
+} /*** end of TbxMbClientWriteFileRecordAsync ***/
 
 
 /************************************************************************************//**
 ** \brief     Perform diagnostic operation on the server for checking the communication
 **            system.
+** \details   Non-blocking version of TbxMbClientDiagnostics(). It submits the request and
+**            returns right away. Once the request completes, the event task calls the
+**            "doneFcn" callback function. Only one asynchronous request can be in
+**            progress at a time, per channel. Additional requests are queued, if enabled
+**            with TBX_MB_CLIENT_QUEUE_SIZE. Make sure the memory that the pointer
+**            parameters point to, stays valid until the request completes.
 ** \param     channel Handle to the Modbus client channel for the requested operation.
 ** \param     node The address of the server. This parameter is transport layer
 **            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
@@ -1173,20 +3819,24 @@ uint8_t TbxMbClientWriteHoldingRegs(tTbxMbClient         channel,
 **              - TBX_MB_DIAG_SC_SERVER_NO_RESPONSE_COUNT
 ** \param     count Location where the retrieved count value will be written to. Only
 **            applicable for the subcodes that end with _COUNT.
-** \return    TBX_OK if successful, TBX_ERROR otherwise.
+** \param     doneFcn Callback function to call when the request completed. Can be
+**            NULL if no completion notification is needed.
+** \param     doneParam Parameter that is passed on to the callback function.
+** \return    TBX_OK if the request was submitted, TBX_ERROR otherwise.
 **
 ****************************************************************************************/
-uint8_t TbxMbClientDiagnostics(tTbxMbClient   channel,
-                               uint8_t        node,
-                               uint16_t       subcode,
-                               uint16_t     * count)
+uint8_t TbxMbClientDiagnosticsAsync(tTbxMbClient       channel,
+                                    uint8_t            node,
+                                    uint16_t           subcode,
+                                    uint16_t         * count,
+                                    tTbxMbClientDone   doneFcn,
+                                    void             * doneParam)
 {
-  uint8_t        result      = TBX_ERROR;
-  uint16_t const queryData[] = { 0xFFFFU, 0x0000U, 0xAA55U, 0x55AAU, 0x3723U };
+  uint8_t result = TBX_ERROR;
 
   /* Verify the parameters. */
-  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && 
-             ((subcode == TBX_MB_DIAG_SC_QUERY_DATA) || 
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) &&
+             ((subcode == TBX_MB_DIAG_SC_QUERY_DATA) ||
               (subcode == TBX_MB_DIAG_SC_CLEAR_COUNTERS) ||
               (subcode == TBX_MB_DIAG_SC_BUS_MESSAGE_COUNT) ||
               (subcode == TBX_MB_DIAG_SC_BUS_COMM_ERROR_COUNT) ||
@@ -1195,8 +3845,8 @@ uint8_t TbxMbClientDiagnostics(tTbxMbClient   channel,
               (subcode == TBX_MB_DIAG_SC_SERVER_NO_RESPONSE_COUNT)));
 
   /* Only continue with valid parameters. */
-  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && 
-      ((subcode == TBX_MB_DIAG_SC_QUERY_DATA) || 
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) &&
+      ((subcode == TBX_MB_DIAG_SC_QUERY_DATA) ||
        (subcode == TBX_MB_DIAG_SC_CLEAR_COUNTERS) ||
        (subcode == TBX_MB_DIAG_SC_BUS_MESSAGE_COUNT) ||
        (subcode == TBX_MB_DIAG_SC_BUS_COMM_ERROR_COUNT) ||
@@ -1208,164 +3858,20 @@ uint8_t TbxMbClientDiagnostics(tTbxMbClient   channel,
     tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
     /* Sanity check on the context type. */
     TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
-
-    /* Obtain write access to the request packet. */
-    tTbxMbTpPacket * txPacket = clientCtx->tpCtx->getTxPacketFcn(clientCtx->tpCtx);
-    /* Should always work, unless this function is being called recursively. Only
-     * continue with access for preparing the request packet.
-     */
-    if (txPacket != NULL)
-    {
-      /* Prepare the request packet. */
-      txPacket->node = node;
-      txPacket->pdu.code = TBX_MB_FC08_DIAGNOSTICS;
-      TbxMbCommonStoreUInt16BE(subcode, &txPacket->pdu.data[0]);
-      /* Requested to perform a query data diagnostic operation? */
-      if (subcode == TBX_MB_DIAG_SC_QUERY_DATA)
-      {
-        /* Write the query data for loopback testing. */
-        for (uint8_t idx = 0U; idx < (sizeof(queryData)/sizeof(queryData[0])); idx++)
-        {
-          TbxMbCommonStoreUInt16BE(queryData[idx], &txPacket->pdu.data[2U + (idx * 2U)]);
-        }
-        txPacket->dataLen = ((sizeof(queryData) / sizeof(queryData[0])) * 2U) + 2U;
-      }
-      /* All other supported subcodes require a 16-bit zero value data field. */
-      else
-      {
-        /* Store the data field as per the protocol. */
-        TbxMbCommonStoreUInt16BE(0x0000U, &txPacket->pdu.data[2U]);
-        txPacket->dataLen = 4U;
-      }
-
-      /* Determine the request type (broadcast / unicast). */
-      uint8_t isBroadcast = TBX_FALSE;
-      if (node == TBX_MB_TP_NODE_ADDR_BROADCAST)
-      {
-        isBroadcast = TBX_TRUE;
-      }
-      /* Transmit the request and wait for the response to a unicast request to come in
-       * or the turnaround time to pass for a broadcast request.
-       */
-      result = TbxMbClientTransceive(clientCtx, isBroadcast);
-
-      /* Only continue with processing the response if all is okay so far and the request
-       * was unicast.
-       */
-      if ((result == TBX_OK) && (isBroadcast == TBX_FALSE))
-      {
-        /* Obtain read access to the response packet. */
-        tTbxMbTpPacket * rxPacket = clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx);
-        /* Since we just received a response packet, the packet access should always 
-         * succeed. Sanity check anyways, just in case.
-         */
-        TBX_ASSERT(rxPacket != NULL);
-        /* Only continue with packet access. */
-        if (rxPacket != NULL)
-        {
-          /* Check that the response came from the expected node, that it's a response
-           * with the same function code (not an exception response) and that it's a
-           * response with the same function sub-code.
-           */
-          if ((rxPacket->node != node) ||
-              (rxPacket->pdu.code != TBX_MB_FC08_DIAGNOSTICS) ||
-              (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]) != subcode))
-          {
-            result = TBX_ERROR;
-          }
-          /* Response looks valid so far. Continue with processing its data.*/
-          else
-          {
-            if (subcode == TBX_MB_DIAG_SC_QUERY_DATA)
-            {
-              const uint8_t queryDataLen = sizeof(queryData) / sizeof(queryData[0]);
-              /* Check the data length. */
-              if (rxPacket->dataLen != ((queryDataLen * 2U) + 2U))
-              {
-                result = TBX_ERROR;
-              }
-              /* Data length okay, continue with checking its content. */
-              else
-              {
-                /* Loop through the received query data. */
-                for (uint8_t idx = 0U; idx < queryDataLen; idx++)
-                {
-                  uint8_t const * entryPtr = &rxPacket->pdu.data[2];
-                  uint16_t entry = TbxMbCommonExtractUInt16BE(&entryPtr[idx * 2U]);
-                  /* Check that its value is the same as what was sent in the request. */
-                  if (entry != queryData[idx])
-                  {
-                    /* Flag the error and stop the loop. */
-                    result = TBX_ERROR;
-                    break;
-                  }
-                }
-              }
-            }
-            else if (subcode == TBX_MB_DIAG_SC_CLEAR_COUNTERS)
-            {
-              /* Check the data length. */
-              if (rxPacket->dataLen != 4U)
-              {
-                result = TBX_ERROR;
-              }
-              /* Data length okay, continue with checking its content. */
-              else
-              {
-                uint8_t const * dataValPtr = &rxPacket->pdu.data[2];
-                uint16_t dataVal = TbxMbCommonExtractUInt16BE(dataValPtr);
-                /* Check that the value is as expected. */
-                if (dataVal != 0x0000U)
-                {
-                  result = TBX_ERROR;
-                }
-              }
-            }
-            /* subcode for reading a count. */
-            else
-            {
-              /* Check the data length. */
-              if (rxPacket->dataLen != 4U)
-              {
-                result = TBX_ERROR;
-              }
-              /* Data length okay, continue with extracting the count value. */
-              else
-              {
-                uint8_t const * countValPtr = &rxPacket->pdu.data[2];
-                uint16_t countVal = TbxMbCommonExtractUInt16BE(countValPtr);
-                /* Verify that count parameter. */
-                TBX_ASSERT(count != NULL);
-                /* Only continue with a valid count parameter. */
-                if (count != NULL)
-                {
-                  /* Store the count value. */
-                  *count = countVal;
-                }
-                else
-                {
-                  /* The an error due to an invalid count parameter. */
-                  result = TBX_ERROR;
-                }
-              }
-            }
-          }
-        }
-        /* Could not access the response packet. */
-        else
-        {
-          result = TBX_ERROR;
-        }
-        /* Inform the transport layer that were done with the rx packet and no longer
-         * need access to it.
-         */
-        clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
-      }
-    }
+    /* Prepare the request. Its address element holds the diagnostics subcode. */
+    tTbxMbClientReq request = { 0 };
+    request.node = node;
+    request.code = TBX_MB_FC08_DIAGNOSTICS;
+    request.addr = subcode;
+    request.rxData = count;
+    request.doneFcn = doneFcn;
+    request.doneParam = doneParam;
+    /* Submit the request and update the result accordingly. */
+    result = TbxMbClientReqSubmit(clientCtx, &request);
   }
   /* Give the result back to the caller. */
   return result;
-} /*** end of TbxMbClientDiagnostics ***/
+} /*** end of TbxMbClientDiagnosticsAsync ***/
 
 
 /************************************************************************************//**
@@ -1377,26 +3883,12 @@ uint8_t TbxMbClientDiagnostics(tTbxMbClient   channel,
 **            its data bytes. When calling this function, set the "len" parameter to the
 **            length of the "txPdu". This function updates the "len" parameter with the
 **            length of the received PDU, which it stores in "rxPdu".
-** \example   Example of manually sending the "Write Single Register 0x06" function code
-**            to a node with address 10 (0x0A) for setting the holding register at
-**            address 40000 to a value of 127:
-**
-**              uint8_t  requestPdu[TBX_MB_TP_PDU_MAX_LEN];
-**              uint8_t  responsePdu[TBX_MB_TP_PDU_MAX_LEN];
-**              uint8_t  pduLen;
-**              uint16_t holdingRegAddr = 40000U;
-**              uint16_t holdingRegValue = 127U;
-**
-**              requestPdu[0] = TBX_MB_FC06_WRITE_SINGLE_REGISTER;
-**              requestPdu[1] = (uint8_t)(holdingRegAddr >> 8U);
-**              requestPdu[2] = (uint8_t) holdingRegAddr;
-**              requestPdu[3] = (uint8_t)(holdingRegValue >> 8U);
-**              requestPdu[4] = (uint8_t) holdingRegValue;
-**              pduLen = 5U;
-**
-**              TbxMbClientCustomFunction(modbusClient, 0x0A, requestPdu, responsePdu, 
-**                                        &pduLen);
-**
+**            Non-blocking version of TbxMbClientCustomFunction(). It submits the request
+**            and returns right away. Once the request completes, the event task calls the
+**            "doneFcn" callback function. Only one asynchronous request can be in
+**            progress at a time, per channel. Additional requests are queued, if enabled
+**            with TBX_MB_CLIENT_QUEUE_SIZE. Make sure the memory that the pointer
+**            parameters point to, stays valid until the request completes.
 ** \param     channel Handle to the Modbus client channel for the requested operation.
 ** \param     node The address of the server. This parameter is transport layer
 **            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
@@ -1404,14 +3896,19 @@ uint8_t TbxMbClientDiagnostics(tTbxMbClient   channel,
 ** \param     txPdu Pointer to a byte array with the PDU to transmit.
 ** \param     rxPdu Pointer to a byte array with the received response PDU.
 ** \param     len Pointer to the PDU length, including the function code.
-** \return    TBX_OK if successful, TBX_ERROR otherwise.
+** \param     doneFcn Callback function to call when the request completed. Can be
+**            NULL if no completion notification is needed.
+** \param     doneParam Parameter that is passed on to the callback function.
+** \return    TBX_OK if the request was submitted, TBX_ERROR otherwise.
 **
 ****************************************************************************************/
-uint8_t TbxMbClientCustomFunction (tTbxMbClient         channel,
-                                   uint8_t              node,
-                                   uint8_t      const * txPdu,
-                                   uint8_t            * rxPdu,
-                                   uint8_t            * len)
+uint8_t TbxMbClientCustomFunctionAsync(tTbxMbClient       channel,
+                                       uint8_t            node,
+                                       uint8_t    const * txPdu,
+                                       uint8_t          * rxPdu,
+                                       uint8_t          * len,
+                                       tTbxMbClientDone   doneFcn,
+                                       void             * doneParam)
 {
   uint8_t result = TBX_ERROR;
 
@@ -1427,91 +3924,85 @@ uint8_t TbxMbClientCustomFunction (tTbxMbClient         channel,
     tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
     /* Sanity check on the context type. */
     TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    /* Prepare the request. */
+    tTbxMbClientReq request = { 0 };
+    request.node = node;
+    request.code = TBX_MB_CLIENT_CODE_CUSTOM;
+    request.txData = txPdu;
+    request.rxData = rxPdu;
+    request.len = len;
+    request.doneFcn = doneFcn;
+    request.doneParam = doneParam;
+    /* Submit the request and update the result accordingly. */
+    result = TbxMbClientReqSubmit(clientCtx, &request);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientCustomFunctionAsync ***/
 
-    /* Obtain write access to the request packet. */
-    tTbxMbTpPacket * txPacket = clientCtx->tpCtx->getTxPacketFcn(clientCtx->tpCtx);
-    /* Should always work, unless this function is being called recursively. Only
-     * continue with access for preparing the request packet and with a valid packet
-     * length. It should at least have a PDU function code.
-     */
-    if ((txPacket != NULL) && (*len > 0U))
-    {
-      /* Prepare the request packet. */
-      txPacket->node = node;
-      txPacket->pdu.code = txPdu[0];
-      txPacket->dataLen = *len - 1U;
-      for (uint8_t idx = 0U; idx < txPacket->dataLen; idx++)
-      {
-        txPacket->pdu.data[idx] = txPdu[idx + 1U];
-      }
 
-      /* Determine the request type (broadcast / unicast). */
-      uint8_t isBroadcast = TBX_FALSE;
-      if (node == TBX_MB_TP_NODE_ADDR_BROADCAST)
-      {
-        isBroadcast = TBX_TRUE;
-      }
-      
-      /* Transmit the request and wait for the response to a unicast request to come in
-       * or the turnaround time to pass for a broadcast request.
-       */
-      result = TbxMbClientTransceive(clientCtx, isBroadcast);
+/************************************************************************************//**
+** \brief     Send a custom function code PDU to the server and receive its response PDU,
+**            without intermediate buffers.
+** \details   Non-blocking version of TbxMbClientCustomFunctionInPlace(). It submits the
+**            request and returns right away. The "buildFcn" callback function is called
+**            when the request is started. This is right away or, for a queued request,
+**            from the event task. The event task calls the "parseFcn" callback function
+**            upon reception of a valid response, followed by the "doneFcn" callback
+**            function once the request completes. Only one asynchronous request can be
+**            in progress at a time, per channel. Additional requests are queued, if
+**            enabled with TBX_MB_CLIENT_QUEUE_SIZE. Make sure the memory that the
+**            "param" parameter points to, stays valid until the request completes.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     buildFcn Callback function that builds the request PDU.
+** \param     parseFcn Callback function that parses the response PDU. Can be NULL if
+**            the contents of the response PDU are not needed.
+** \param     param Parameter that is passed on to the build and parse callback
+**            functions.
+** \param     doneFcn Callback function to call when the request completed. Can be
+**            NULL if no completion notification is needed.
+** \param     doneParam Parameter that is passed on to the "doneFcn" callback function.
+** \return    TBX_OK if the request was submitted, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientCustomFunctionInPlaceAsync(tTbxMbClient         channel,
+                                              uint8_t              node,
+                                              tTbxMbClientPduBuild buildFcn,
+                                              tTbxMbClientPduParse parseFcn,
+                                              void               * param,
+                                              tTbxMbClientDone     doneFcn,
+                                              void               * doneParam)
+{
+  uint8_t result = TBX_ERROR;
 
-      /* Initialize the length of the response PDU to zero. This default indicates that
-       * no response was received. This is the case in the request was a broadcast one or
-       * it the response was not valid. If will be updated later on, if a valid response
-       * was received.
-       */
-      *len = 0U;
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) &&
+             (buildFcn != NULL));
 
-      /* Only continue with processing the response if all is okay so far and the request
-       * was unicast.
-       */
-      if ((result == TBX_OK) && (isBroadcast == TBX_FALSE))
-      {
-        /* Obtain read access to the response packet. */
-        tTbxMbTpPacket * rxPacket = clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx);
-        /* Since we just received a response packet, the packet access should always 
-         * succeed. Sanity check anyways, just in case.
-         */
-        TBX_ASSERT(rxPacket != NULL);
-        /* Only continue with packet access. */
-        if (rxPacket != NULL)
-        {
-          /* Check that the response came from the expected node. */
-          if (rxPacket->node != node)
-          {
-            result = TBX_ERROR;
-          }
-          /* Response content valid. Copy its data. */
-          else
-          {
-            /* Set the length, including the function code. */
-            *len = rxPacket->dataLen + 1U;
-            /* Set the function code. */
-            rxPdu[0] = rxPacket->pdu.code;
-            /* Copy the packet data. */
-            for (uint8_t idx = 0U; idx < rxPacket->dataLen; idx++)
-            {
-              rxPdu[idx + 1U] = rxPacket->pdu.data[idx];
-            }
-          }
-        }
-        /* Could not access the response packet. */
-        else
-        {
-          result = TBX_ERROR;
-        }
-        /* Inform the transport layer that were done with the rx packet and no longer
-         * need access to it.
-         */
-        clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
-      }
-    }
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (buildFcn != NULL))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    /* Prepare the request. */
+    tTbxMbClientReq request = { 0 };
+    request.node = node;
+    request.code = TBX_MB_CLIENT_CODE_CUSTOM_IN_PLACE;
+    request.buildFcn = buildFcn;
+    request.parseFcn = parseFcn;
+    request.rxData = param;
+    request.doneFcn = doneFcn;
+    request.doneParam = doneParam;
+    /* Submit the request and update the result accordingly. */
+    result = TbxMbClientReqSubmit(clientCtx, &request);
   }
   /* Give the result back to the caller. */
   return result;
-} /*** end of TbxMbClientCustomFunction ***/
-
+} /*** end of TbxMbClientCustomFunctionInPlaceAsync ***/
 
 /*********************************** end of tbxmb_client.c *****************************/
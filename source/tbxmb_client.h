@@ -43,6 +43,111 @@ extern "C" {
 typedef void * tTbxMbClient;
 
 
+/** \brief Caller provided storage for a Modbus client channel object. Include
+ *         tbxmb_storage.h to be able to allocate it.
+ */
+typedef struct tTbxMbClientStorageTag tTbxMbClientStorage;
+
+
+/** \brief Modbus client callback function for signaling the completion of an
+ *         asynchronous request. The result parameter is TBX_OK if the request completed
+ *         successfully, TBX_ERROR otherwise. The param parameter is the doneParam that
+ *         was specified when submitting the request.
+ */
+typedef void (* tTbxMbClientDone)(tTbxMbClient         channel,
+                                  uint8_t              result,
+                                  void               * param);
+
+
+/** \brief   Modbus client callback function for building a custom function code request
+ *           PDU in place. 
+ *  \details The "pdu" parameter points directly to the PDU of the transport layer's
+ *           request packet. The first byte (i.e. pdu[0]) is for the function code,
+ *           followed by its data bytes. Write the length of the PDU, including the
+ *           function code, to "len". It can be up to TBX_MB_TP_PDU_MAX_LEN bytes. The
+ *           param parameter is the param that was specified when submitting the
+ *           request.
+ *  \return  TBX_OK if the request PDU was built, TBX_ERROR otherwise.
+ */
+typedef uint8_t (* tTbxMbClientPduBuild)(tTbxMbClient         channel,
+                                         uint8_t            * pdu,
+                                         uint8_t            * len,
+                                         void               * param);
+
+
+/** \brief   Modbus client callback function for parsing a custom function code response
+ *           PDU in place.
+ *  \details The "pdu" parameter points directly to the PDU of the transport layer's
+ *           response packet. The first byte (i.e. pdu[0]) contains the function code,
+ *           followed by its data bytes. The "len" parameter holds the length of the
+ *           PDU, including the function code. The PDU is only accessible while the
+ *           callback runs. The param parameter is the param that was specified when
+ *           submitting the request.
+ *  \return  TBX_OK if the response PDU is valid, TBX_ERROR otherwise.
+ */
+typedef uint8_t (* tTbxMbClientPduParse)(tTbxMbClient         channel,
+                                         uint8_t      const * pdu,
+                                         uint8_t              len,
+                                         void               * param);
+
+
+/** \brief   Modbus client callback function for receiving a device identification
+ *           object, while reading the device identification.
+ *  \details The "data" parameter points directly to the object's value in the
+ *           transport layer's response packet. Note that it is not zero terminated.
+ *           The "len" parameter holds its length. The value is only accessible while
+ *           the callback runs. The param parameter is the param that was specified
+ *           when reading the device identification.
+ */
+typedef void (* tTbxMbClientDeviceIdObject)(tTbxMbClient         channel,
+                                            uint8_t              objectId,
+                                            uint8_t      const * data,
+                                            uint8_t              len,
+                                            void               * param);
+
+
+/** \brief Enumerated type with the Modbus data tables that a batch write can write to. */
+typedef enum
+{
+  /* Coils data table. Written with function code 5 or 15. */
+  TBX_MB_CLIENT_BATCH_COILS = 0U,
+  /* Holding registers data table. Written with function code 6 or 16. */
+  TBX_MB_CLIENT_BATCH_HOLDING_REGS,
+  /* Extra entry to obtain the number of elements. */
+  TBX_MB_CLIENT_BATCH_NUM_TABLE
+} tTbxMbClientBatchTable;
+
+
+/** \brief   Modbus client write operation, as part of a batch of writes.
+ *  \details Set the node to TBX_MB_TP_NODE_ADDR_BROADCAST (0) for a broadcast write.
+ *           The "data" element points to the TBX_ON / TBX_OFF coil values or the holding
+ *           register values. Once the batch completes, the "result" element holds
+ *           TBX_OK if this write was successful, TBX_ERROR otherwise.
+ */
+typedef struct
+{
+  uint8_t                node;                   /**< Server node address.             */
+  tTbxMbClientBatchTable table;                  /**< Data table to write to.          */
+  uint16_t               addr;                   /**< Start element address.           */
+  uint16_t               num;                    /**< Number of elements.              */
+  void           const * data;                   /**< Element values to write.         */
+  uint8_t                result;                 /**< Result of this write operation.  */
+} tTbxMbClientBatchWrite;
+
+
+/** \brief Response time statistics of a server node, as tracked by a client channel.
+ *         Only available if TBX_MB_CLIENT_NODE_STATS_SIZE is configured > 0.
+ */
+typedef struct
+{
+  uint16_t               avgMs;                  /**< Average response time (ms).      */
+  uint16_t               maxMs;                  /**< Maximum response time (ms).      */
+  uint16_t               timeoutMs;              /**< Adaptive response timeout (ms).  */
+  uint8_t                timeouts;               /**< Consecutive response timeouts.   */
+  uint8_t                backedOff;              /**< TBX_TRUE if backed off.          */
+} tTbxMbClientNodeStats;
+
+
 /****************************************************************************************
 * Function prototypes
 ****************************************************************************************/
@@ -50,6 +155,11 @@ tTbxMbClient TbxMbClientCreate          (tTbxMbTp             transport,
                                          uint16_t             responseTimeout,
                                          uint16_t             turnaroundDelay);
 
+tTbxMbClient TbxMbClientCreateStatic    (tTbxMbClientStorage * storage,
+                                         tTbxMbTp             transport,
+                                         uint16_t             responseTimeout,
+                                         uint16_t             turnaroundDelay);
+
 void         TbxMbClientFree            (tTbxMbClient         channel);
 
 uint8_t      TbxMbClientReadCoils       (tTbxMbClient         channel,
@@ -88,6 +198,35 @@ uint8_t      TbxMbClientWriteHoldingRegs(tTbxMbClient         channel,
                                          uint8_t              num,
                                          uint16_t     const * holdingRegs);
 
+uint8_t      TbxMbClientReadWriteHoldingRegs(tTbxMbClient     channel,
+                                         uint8_t              node,
+                                         uint16_t             readAddr,
+                                         uint8_t              readNum,
+                                         uint16_t           * readRegs,
+                                         uint16_t             writeAddr,
+                                         uint8_t              writeNum,
+                                         uint16_t     const * writeRegs);
+
+uint8_t      TbxMbClientMaskWriteHoldingReg(tTbxMbClient      channel,
+                                         uint8_t              node,
+                                         uint16_t             addr,
+                                         uint16_t             andMask,
+                                         uint16_t             orMask);
+
+uint8_t      TbxMbClientReadFileRecord  (tTbxMbClient         channel,
+                                         uint8_t              node,
+                                         uint16_t             file,
+                                         uint16_t             record,
+                                         uint8_t              num,
+                                         uint16_t           * values);
+
+uint8_t      TbxMbClientWriteFileRecord (tTbxMbClient         channel,
+                                         uint8_t              node,
+                                         uint16_t             file,
+                                         uint16_t             record,
+                                         uint8_t              num,
+                                         uint16_t     const * values);
+
 uint8_t      TbxMbClientDiagnostics     (tTbxMbClient         channel,
                                          uint8_t              node,
                                          uint16_t             subcode,
@@ -99,6 +238,135 @@ uint8_t      TbxMbClientCustomFunction  (tTbxMbClient         channel,
                                          uint8_t            * rxPdu,
                                          uint8_t            * len);
 
+uint8_t      TbxMbClientCustomFunctionInPlace(tTbxMbClient    channel,
+                                         uint8_t              node,
+                                         tTbxMbClientPduBuild buildFcn,
+                                         tTbxMbClientPduParse parseFcn,
+                                         void               * param);
+
+uint8_t      TbxMbClientReadDeviceId    (tTbxMbClient         channel,
+                                         uint8_t              node,
+                                         uint8_t              code,
+                                         uint8_t              objectId,
+                                         tTbxMbClientDeviceIdObject objectFcn,
+                                         void               * param);
+
+uint8_t      TbxMbClientWriteBatch      (tTbxMbClient         channel,
+                                         tTbxMbClientBatchWrite * writes,
+                                         uint8_t              count);
+
+uint8_t      TbxMbClientGetNodeStats    (tTbxMbClient         channel,
+                                         uint8_t              node,
+                                         tTbxMbClientNodeStats * stats);
+
+uint8_t      TbxMbClientReadCoilsAsync  (tTbxMbClient         channel,
+                                         uint8_t              node,
+                                         uint16_t             addr,
+                                         uint16_t             num,
+                                         uint8_t            * coils,
+                                         tTbxMbClientDone     doneFcn,
+                                         void               * doneParam);
+
+uint8_t      TbxMbClientReadInputsAsync (tTbxMbClient         channel,
+                                         uint8_t              node,
+                                         uint16_t             addr,
+                                         uint16_t             num,
+                                         uint8_t            * inputs,
+                                         tTbxMbClientDone     doneFcn,
+                                         void               * doneParam);
+
+uint8_t      TbxMbClientReadInputRegsAsync(tTbxMbClient       channel,
+                                         uint8_t              node,
+                                         uint16_t             addr,
+                                         uint8_t              num,
+                                         uint16_t           * inputRegs,
+                                         tTbxMbClientDone     doneFcn,
+                                         void               * doneParam);
+
+uint8_t      TbxMbClientReadHoldingRegsAsync(tTbxMbClient     channel,
+                                         uint8_t              node,
+                                         uint16_t             addr,
+                                         uint8_t              num,
+                                         uint16_t           * holdingRegs,
+                                         tTbxMbClientDone     doneFcn,
+                                         void               * doneParam);
+
+uint8_t      TbxMbClientWriteCoilsAsync (tTbxMbClient         channel,
+                                         uint8_t              node,
+                                         uint16_t             addr,
+                                         uint16_t             num,
+                                         uint8_t      const * coils,
+                                         tTbxMbClientDone     doneFcn,
+                                         void               * doneParam);
+
+uint8_t      TbxMbClientWriteHoldingRegsAsync(tTbxMbClient    channel,
+                                         uint8_t              node,
+                                         uint16_t             addr,
+                                         uint8_t              num,
+                                         uint16_t     const * holdingRegs,
+                                         tTbxMbClientDone     doneFcn,
+                                         void               * doneParam);
+
+uint8_t      TbxMbClientReadWriteHoldingRegsAsync(tTbxMbClient channel,
+                                         uint8_t              node,
+                                         uint16_t             readAddr,
+                                         uint8_t              readNum,
+                                         uint16_t           * readRegs,
+                                         uint16_t             writeAddr,
+                                         uint8_t              writeNum,
+                                         uint16_t     const * writeRegs,
+                                         tTbxMbClientDone     doneFcn,
+                                         void               * doneParam);
+
+uint8_t      TbxMbClientMaskWriteHoldingRegAsync(tTbxMbClient channel,
+                                         uint8_t              node,
+                                         uint16_t             addr,
+                                         uint16_t             andMask,
+                                         uint16_t             orMask,
+                                         tTbxMbClientDone     doneFcn,
+                                         void               * doneParam);
+
+uint8_t      TbxMbClientReadFileRecordAsync(tTbxMbClient      channel,
+                                         uint8_t              node,
+                                         uint16_t             file,
+                                         uint16_t             record,
+                                         uint8_t              num,
+                                         uint16_t           * values,
+                                         tTbxMbClientDone     doneFcn,
+                                         void               * doneParam);
+
+uint8_t      TbxMbClientWriteFileRecordAsync(tTbxMbClient     channel,
+                                         uint8_t              node,
+                                         uint16_t             file,
+                                         uint16_t             record,
+                                         uint8_t              num,
+                                         uint16_t     const * values,
+                                         tTbxMbClientDone     doneFcn,
+                                         void               * doneParam);
+
+uint8_t      TbxMbClientDiagnosticsAsync(tTbxMbClient         channel,
+                                         uint8_t              node,
+                                         uint16_t             subcode,
+                                         uint16_t           * count,
+                                         tTbxMbClientDone     doneFcn,
+                                         void               * doneParam);
+
+uint8_t      TbxMbClientCustomFunctionAsync(tTbxMbClient      channel,
+                                         uint8_t              node,
+                                         uint8_t      const * txPdu,
+                                         uint8_t            * rxPdu,
+                                         uint8_t            * len,
+                                         tTbxMbClientDone     doneFcn,
+                                         void               * doneParam);
+
+uint8_t      TbxMbClientCustomFunctionInPlaceAsync(tTbxMbClient channel,
+                                         uint8_t              node,
+                                         tTbxMbClientPduBuild buildFcn,
+                                         tTbxMbClientPduParse parseFcn,
+                                         void               * param,
+                                         tTbxMbClientDone     doneFcn,
+                                         void               * doneParam);
+
 
 #ifdef __cplusplus
 }
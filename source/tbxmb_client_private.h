@@ -34,6 +34,77 @@
 extern "C" {
 #endif
 
+/****************************************************************************************
+* Macro definitions
+****************************************************************************************/
+#ifndef TBX_MB_CLIENT_QUEUE_SIZE
+/** \brief Configure the maximum number of asynchronous requests that can be queued per
+ *         client channel, while another asynchronous request is in progress. A queued
+ *         request is transmitted right after the one in progress completes. The default
+ *         value of 0 disables the queue. You can override this configuration by adding
+ *         a macro with the same name, but a different value, to "tbx_conf.h".
+ */
+#define TBX_MB_CLIENT_QUEUE_SIZE           (0U)
+#endif
+
+#ifndef TBX_MB_CLIENT_QUEUE_WRITES_FIRST
+/** \brief Configure if queued write requests (function codes 5, 6, 15, 16, 21, 22 and
+ *         23) go ahead of the other queued requests, such as the reading of data.
+ *         Requests of the same kind are always processed in the order in which they
+ *         were queued. Set it to a value of 0 to process all queued requests in order.
+ *         You can override this configuration by adding a macro with the same name, but
+ *         a different value, to "tbx_conf.h".
+ */
+#define TBX_MB_CLIENT_QUEUE_WRITES_FIRST   (1U)
+#endif
+
+#ifndef TBX_MB_CLIENT_NODE_STATS_SIZE
+/** \brief Configure the number of server nodes per client channel, for which response
+ *         time statistics are tracked. From these statistics, the client derives an
+ *         adaptive response timeout per node and it backs off requests to nodes that
+ *         repeatedly did not respond. The adaptive response timeout is the moving
+ *         average of the node's response time, plus four times the moving average of
+ *         its deviation, similar to the retransmission timeout of TCP. That way the
+ *         timeout follows a node that got faster or slower, instead of sticking to the
+ *         slowest response ever measured. Once more nodes are addressed, the statistics
+ *         of the node that was added first are replaced. The default value of 0 disables
+ *         this feature. You can override this configuration by adding a macro with the
+ *         same name, but a different value, to "tbx_conf.h".
+ */
+#define TBX_MB_CLIENT_NODE_STATS_SIZE      (0U)
+#endif
+
+#ifndef TBX_MB_CLIENT_TIMEOUT_MIN_MS
+/** \brief Configure the lower limit of the adaptive response timeout in milliseconds.
+ *         The adaptive response timeout is the node's average response time plus four
+ *         times its average deviation, yet no longer than the response timeout of the
+ *         client channel. You can override this configuration by adding a macro with
+ *         the same name, but a different value, to "tbx_conf.h".
+ */
+#define TBX_MB_CLIENT_TIMEOUT_MIN_MS       (50U)
+#endif
+
+#ifndef TBX_MB_CLIENT_BACKOFF_TIMEOUTS
+/** \brief Configure the number of consecutive response timeouts, after which the
+ *         requests to a node are backed off. Such requests then fail right away,
+ *         without being transmitted. Set it to a value of 0 to never back off. You can
+ *         override this configuration by adding a macro with the same name, but a
+ *         different value, to "tbx_conf.h".
+ */
+#define TBX_MB_CLIENT_BACKOFF_TIMEOUTS     (3U)
+#endif
+
+#ifndef TBX_MB_CLIENT_BACKOFF_PROBE
+/** \brief Configure how often a request to a backed off node is still transmitted, to
+ *         probe if it responds again. A value of 10 means that every 10th request is
+ *         transmitted. The node is no longer backed off, once it responds. You can
+ *         override this configuration by adding a macro with the same name, but a
+ *         different value, to "tbx_conf.h".
+ */
+#define TBX_MB_CLIENT_BACKOFF_PROBE        (10U)
+#endif
+
+
 /****************************************************************************************
 * Type definitions
 ****************************************************************************************/
@@ -47,27 +118,96 @@ typedef void (* tTbxMbClientPoll)   (void        * context);
 typedef void (* tTbxMbClientProcess)(tTbxMbEvent * event);
 
 
+/** \brief Modbus client request that groups all information needed for preparing the
+ *         request packet and for processing its response packet.
+ */
+typedef struct
+{
+  uint8_t              node;                     /**< Server node address.             */
+  uint8_t              code;                     /**< Request function code.           */
+  uint16_t             addr;                     /**< Element address or subcode.      */
+  uint16_t             num;                      /**< Number of elements or OR mask.   */
+  uint16_t             value;                    /**< Single write value or AND mask.  */
+  uint16_t             writeAddr;                /**< Write address or file number.    */
+  uint16_t             writeNum;                 /**< Write number (read/write regs).  */
+  void         const * txData;                   /**< Request data source.             */
+  void               * rxData;                   /**< Response data destination.       */
+  uint8_t            * len;                      /**< PDU length (custom function).    */
+  tTbxMbClientPduBuild buildFcn;                 /**< In place request build function. */
+  tTbxMbClientPduParse parseFcn;                 /**< In place response parse function.*/
+  tTbxMbClientDone     doneFcn;                  /**< Async request completion fcn.    */
+  void               * doneParam;                /**< Async request completion param.  */
+} tTbxMbClientReq;
+
+
+/** \brief Response time statistics of a server node. */
+typedef struct
+{
+  uint8_t              node;                     /**< Server node address.             */
+  uint8_t              learned;                  /**< Response time measured flag.     */
+  uint8_t              timeouts;                 /**< Consecutive response timeouts.   */
+  uint8_t              skipCount;                /**< Requests skipped while backed off*/
+  uint32_t             avgMsX8;                  /**< Response time (ms) EWMA, times 8.*/
+  uint16_t             maxMs;                    /**< Maximum response time (ms).      */
+  uint16_t             devMsX4;                  /**< Resp. time deviation EWMA, x 4.  */
+} tTbxMbClientNodeInfo;
+
+
+/** \brief Read device identification request state, for the in place callbacks. */
+typedef struct
+{
+  uint8_t              code;                     /**< Read device id code.             */
+  uint8_t              objectId;                 /**< Object id to request.            */
+  uint8_t              moreFollows;              /**< More objects follow flag.        */
+  tTbxMbClientDeviceIdObject objectFcn;          /**< Object callback function.        */
+  void               * param;                    /**< Object callback parameter.       */
+} tTbxMbClientDevIdReq;
+
+
 /** \brief Modbus client channel layer context that groups all channel specific data. 
  *         It's what the tTbxMbClient opaque pointer points to.
  */
 typedef struct
 {
-  /* Event interface methods. The following three entries must always be at the start
+  /* Event interface methods. The following four entries must always be at the start
    * and exactly match those in tTbxMbEventCtx. Think of it as the base that this struct
    * derives from. 
    */
   void               * instancePtr;              /**< Reserved for C++ wrapper.        */
   tTbxMbClientPoll     pollFcn;                  /**< Event poll function.             */
   tTbxMbClientProcess  processFcn;               /**< Event process function.          */
+  tTbxMbEventPoller    pollInfo;                 /**< Event poller information.        */
   /* Private members. */
   uint8_t              type;                     /**< Context type.                    */
   tTbxMbTpCtx        * tpCtx;                    /**< Assigned transport layer context.*/
   uint16_t             responseTimeout;          /**< Maximum response wait time (ms). */
   uint16_t             turnaroundDelay;          /**< Delay (ms) after broadcast PDU.  */
+  uint8_t              isStatic;                 /**< Caller provided storage flag.    */
   tTbxMbOsalSem        transceiveSem;            /**< PDU transmit/receive semaphore.  */
+  tTbxMbClientReq      asyncReq;                 /**< Async request in progress.       */
+  uint8_t              asyncState;               /**< Async request state.             */
+  uint16_t             asyncWaitMs;              /**< Async request remaining wait time*/
+  uint16_t             asyncMsTime;              /**< Async last millisecond tick time.*/
+#if (TBX_MB_CLIENT_QUEUE_SIZE > 0U)
+  tTbxMbClientReq      asyncQueue[TBX_MB_CLIENT_QUEUE_SIZE]; /**< Async request queue. */
+  uint8_t              asyncQueueCount;          /**< Number of queued async requests. */
+#endif
+#if (TBX_MB_CLIENT_NODE_STATS_SIZE > 0U)
+  tTbxMbClientNodeInfo nodeInfo[TBX_MB_CLIENT_NODE_STATS_SIZE]; /**< Node statistics.  */
+  uint8_t              nodeInfoCount;            /**< Number of tracked nodes.         */
+  uint8_t              nodeInfoNext;             /**< Next node statistics to replace. */
+  uint16_t             rxTicks;                  /**< Response wait start tick time.   */
+#endif
 } tTbxMbClientCtx;
 
 
+/** \brief Caller provided storage for a Modbus client channel object. */
+struct tTbxMbClientStorageTag
+{
+  tTbxMbClientCtx      ctx;                      /**< Client channel context.          */
+};
+
+
 #ifdef __cplusplus
 }
 #endif
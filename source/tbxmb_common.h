@@ -65,6 +65,21 @@ extern "C" {
 /** \brief Modbus function code 16 - Write Multiple Registers. */
 #define TBX_MB_FC16_WRITE_MULTIPLE_REGISTERS          (16U)
 
+/** \brief Modbus function code 20 - Read File Record. */
+#define TBX_MB_FC20_READ_FILE_RECORD                  (20U)
+
+/** \brief Modbus function code 21 - Write File Record. */
+#define TBX_MB_FC21_WRITE_FILE_RECORD                 (21U)
+
+/** \brief Modbus function code 22 - Mask Write Register. */
+#define TBX_MB_FC22_MASK_WRITE_REGISTER               (22U)
+
+/** \brief Modbus function code 23 - Read/Write Multiple Registers. */
+#define TBX_MB_FC23_READ_WRITE_MULTIPLE_REGISTERS     (23U)
+
+/** \brief Modbus function code 43 - Encapsulated Interface Transport. */
+#define TBX_MB_FC43_ENCAPSULATED_INTERFACE            (43U)
+
 
 /* ------------------------- Exception codes ----------------------------------------- */
 /** \brief Modbus exception code 01 - Illegal function. */
@@ -79,6 +94,15 @@ extern "C" {
 /** \brief Modbus exception code 04 - Server device failure. */
 #define TBX_MB_EC04_SERVER_DEVICE_FAILURE             (4U)
 
+/** \brief Modbus exception code 06 - Server device busy. */
+#define TBX_MB_EC06_SERVER_DEVICE_BUSY                (6U)
+
+/** \brief Modbus exception code 10 - Gateway path unavailable. */
+#define TBX_MB_EC0A_GATEWAY_PATH_UNAVAILABLE          (10U)
+
+/** \brief Modbus exception code 11 - Gateway target device failed to respond. */
+#define TBX_MB_EC0B_GATEWAY_TARGET_FAILED             (11U)
+
 
 /* ------------------------- Diagnostics sub-function codes -------------------------- */
 /** \brief Diagnostics sub-function code - Return Query Data. */
@@ -103,6 +127,62 @@ extern "C" {
 #define TBX_MB_DIAG_SC_SERVER_NO_RESPONSE_COUNT       (15U)
 
 
+/* ------------------------- File record access -------------------------------------- */
+/** \brief Reference type of a file record sub-request. Always 6. */
+#define TBX_MB_FILE_REF_TYPE                          (6U)
+
+
+/* ------------------------- Encapsulated interface MEI types ------------------------ */
+/** \brief Encapsulated interface MEI type 14 - Read Device Identification. */
+#define TBX_MB_MEI_READ_DEVICE_ID                     (14U)
+
+
+/* ------------------------- Read device identification codes ------------------------ */
+/** \brief Read device identification code - Basic device identification (stream). */
+#define TBX_MB_DEVID_CODE_BASIC                       (1U)
+
+/** \brief Read device identification code - Regular device identification (stream). */
+#define TBX_MB_DEVID_CODE_REGULAR                     (2U)
+
+/** \brief Read device identification code - Extended device identification (stream). */
+#define TBX_MB_DEVID_CODE_EXTENDED                    (3U)
+
+/** \brief Read device identification code - One specific identification object. */
+#define TBX_MB_DEVID_CODE_INDIVIDUAL                  (4U)
+
+
+/* ------------------------- Read device identification object identifiers ----------- */
+/** \brief Device identification object 0x00 - Vendor name. Basic and mandatory. */
+#define TBX_MB_DEVID_OBJ_VENDOR_NAME                  (0x00U)
+
+/** \brief Device identification object 0x01 - Product code. Basic and mandatory. */
+#define TBX_MB_DEVID_OBJ_PRODUCT_CODE                 (0x01U)
+
+/** \brief Device identification object 0x02 - Major minor revision. Basic and
+ *         mandatory.
+ */
+#define TBX_MB_DEVID_OBJ_REVISION                     (0x02U)
+
+/** \brief Device identification object 0x03 - Vendor URL. Regular and optional. */
+#define TBX_MB_DEVID_OBJ_VENDOR_URL                   (0x03U)
+
+/** \brief Device identification object 0x04 - Product name. Regular and optional. */
+#define TBX_MB_DEVID_OBJ_PRODUCT_NAME                 (0x04U)
+
+/** \brief Device identification object 0x05 - Model name. Regular and optional. */
+#define TBX_MB_DEVID_OBJ_MODEL_NAME                   (0x05U)
+
+/** \brief Device identification object 0x06 - User application name. Regular and
+ *         optional.
+ */
+#define TBX_MB_DEVID_OBJ_USER_APP_NAME                (0x06U)
+
+/** \brief First device identification object of the extended category. Objects
+ *         0x80..0xFF are device dependent and optional.
+ */
+#define TBX_MB_DEVID_OBJ_EXTENDED_FIRST               (0x80U)
+
+
 /* ------------------------- Bit masks ----------------------------------------------- */
 /** \brief Bit mask to OR to the function code to flag it as an exception response. */
 #define TBX_MB_FC_EXCEPTION_MASK                      (0x80U)
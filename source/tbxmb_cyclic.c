@@ -0,0 +1,761 @@
+/************************************************************************************//**
+* \file         tbxmb_cyclic.c
+* \brief        Modbus client cyclic polling source file.
+* \internal
+*----------------------------------------------------------------------------------------
+*                          C O P Y R I G H T
+*----------------------------------------------------------------------------------------
+*   Copyright (c) 2023 by Feaser     www.feaser.com     All rights reserved
+*
+*----------------------------------------------------------------------------------------
+*                            L I C E N S E
+*----------------------------------------------------------------------------------------
+*
+* SPDX-License-Identifier: GPL-3.0-or-later
+*
+* This file is part of MicroTBX-Modbus. MicroTBX-Modbus is free software: you can
+* redistribute it and/or modify it under the terms of the GNU General Public License as
+* published by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* MicroTBX-Modbus is distributed in the hope that it will be useful, but WITHOUT ANY
+* WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+* PARTICULAR PURPOSE. See the GNU General Public License for more details.
+*
+* You have received a copy of the GNU General Public License along with MicroTBX-Modbus.
+* If not, see www.gnu.org/licenses/.
+*
+* \endinternal
+****************************************************************************************/
+
+/****************************************************************************************
+* Include files
+****************************************************************************************/
+#include "microtbx.h"                            /* MicroTBX module                    */
+#include "microtbxmodbus.h"                      /* MicroTBX-Modbus module             */
+#include "tbxmb_event_private.h"                 /* MicroTBX-Modbus event private      */
+#include "tbxmb_osal_private.h"                  /* MicroTBX-Modbus OSAL private       */
+#include "tbxmb_cyclic_private.h"                /* MicroTBX-Modbus cyclic private     */
+
+
+/****************************************************************************************
+* Macro definitions
+****************************************************************************************/
+/** \brief Unique context type to identify a context as being a cyclic polling object. */
+#define TBX_MB_CYCLIC_CONTEXT_TYPE     (61U)
+
+
+/****************************************************************************************
+* Function prototypes
+****************************************************************************************/
+static void    TbxMbCyclicPoll        (tTbxMbCyclic              cyclic);
+
+static void    TbxMbCyclicBuild       (tTbxMbCyclicCtx         * cyclicCtx);
+
+static void    TbxMbCyclicReadNext    (tTbxMbCyclicCtx         * cyclicCtx);
+
+static void    TbxMbCyclicReadDone    (tTbxMbClient              channel,
+                                       uint8_t                   result,
+                                       void                    * param);
+
+static uint8_t TbxMbCyclicRespCheck   (tTbxMbCyclicCtx   const * cyclicCtx,
+                                       tTbxMbCyclicBlock const * block);
+
+static void    TbxMbCyclicTagUpdate   (tTbxMbCyclicCtx   const * cyclicCtx,
+                                       tTbxMbCyclicTag         * tag);
+
+static uint8_t TbxMbCyclicTagIsBefore (tTbxMbCyclicTag   const * tag,
+                                       tTbxMbCyclicTag   const * other);
+
+
+/****************************************************************************************
+* Local constant declarations
+****************************************************************************************/
+/** \brief Function code for reading the elements of each data table. */
+static const uint8_t tbxMbCyclicReadCode[TBX_MB_CYCLIC_NUM_TABLE] =
+{
+  TBX_MB_FC01_READ_COILS,
+  TBX_MB_FC02_READ_DISCRETE_INPUTS,
+  TBX_MB_FC03_READ_HOLDING_REGISTERS,
+  TBX_MB_FC04_READ_INPUT_REGISTERS
+};
+
+
+/** \brief Maximum number of elements of each data table to read with one request. */
+static const uint16_t tbxMbCyclicReadNumMax[TBX_MB_CYCLIC_NUM_TABLE] =
+{
+  2000U, 2000U, 125U, 125U
+};
+
+
+/************************************************************************************//**
+** \brief     Creates a Modbus client cyclic polling object. It reads the tags, which
+**            you add with TbxMbCyclicAddTag(), with their configured period. For this
+**            it merges tags with adjacent element addresses into blocks, such that the
+**            least amount of read requests is needed. The blocks are read with the
+**            asynchronous client functions, so make sure the event task runs.
+** \param     channel Handle to a previously created Modbus client channel object, to
+**            use for reading the tags.
+** \param     maxGap Maximum number of unused elements between two tags, to still merge
+**            them into one block. Reading a few unused elements is typically faster
+**            than transmitting an extra request. A value of 0 only merges tags that
+**            directly follow each other or overlap.
+** \return    Handle to the newly created Modbus client cyclic polling object if
+**            successful, NULL otherwise.
+**
+****************************************************************************************/
+tTbxMbCyclic TbxMbCyclicCreate(tTbxMbClient channel,
+                               uint16_t     maxGap)
+{
+  tTbxMbCyclic result = NULL;
+
+  /* Verify parameters. */
+  TBX_ASSERT(channel != NULL);
+
+  /* Only continue with valid parameters. */
+  if (channel != NULL)
+  {
+    /* Allocate memory for the new cyclic polling context. */
+    tTbxMbCyclicCtx * newCyclicCtx = TbxMemPoolAllocate(sizeof(tTbxMbCyclicCtx));
+    /* Automatically increase the memory pool, if it was too small. */
+    if (newCyclicCtx == NULL)
+    {
+      /* No need to check the return value, because if it failed, the following
+       * allocation fails too, which is verified later on.
+       */
+      (void)TbxMemPoolCreate(1U, sizeof(tTbxMbCyclicCtx));
+      newCyclicCtx = TbxMemPoolAllocate(sizeof(tTbxMbCyclicCtx));
+    }
+    /* Verify memory allocation of the cyclic polling context. */
+    TBX_ASSERT(newCyclicCtx != NULL);
+    /* Only continue if the memory allocation succeeded. */
+    if (newCyclicCtx != NULL)
+    {
+      /* Create the lists for storing the tags and the blocks. */
+      newCyclicCtx->tagList = TbxListCreate();
+      newCyclicCtx->blockList = TbxListCreate();
+      /* Verify that the list creation succeeded. If this assertion fails, increase the
+       * heap size using configuration macro TBX_CONF_HEAP_SIZE.
+       */
+      TBX_ASSERT((newCyclicCtx->tagList != NULL) && (newCyclicCtx->blockList != NULL));
+      /* Initialize the cyclic polling context. */
+      newCyclicCtx->type = TBX_MB_CYCLIC_CONTEXT_TYPE;
+      newCyclicCtx->instancePtr = NULL;
+      newCyclicCtx->pollFcn = TbxMbCyclicPoll;
+      newCyclicCtx->processFcn = NULL;
+      newCyclicCtx->pollInfo.count = 0U;
+      newCyclicCtx->pollInfo.task = TbxMbEventTaskIdx(channel);
+      newCyclicCtx->channel = channel;
+      newCyclicCtx->maxGap = maxGap;
+      newCyclicCtx->rebuild = TBX_FALSE;
+      newCyclicCtx->released = TBX_FALSE;
+      newCyclicCtx->readBlock = NULL;
+      newCyclicCtx->msCounter = 0U;
+      newCyclicCtx->msTime = TbxMbPortTimerCount();
+      newCyclicCtx->pduLen = 0U;
+      /* Instruct the event task to start calling our polling function. */
+      tTbxMbEvent newEvent;
+      newEvent.context = newCyclicCtx;
+      newEvent.id = TBX_MB_EVENT_ID_START_POLLING;
+      TbxMbOsalEventPost(&newEvent, TBX_FALSE);
+      /* Update the result. */
+      result = newCyclicCtx;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbCyclicCreate ****/
+
+
+/************************************************************************************//**
+** \brief     Releases a Modbus client cyclic polling object, previously created with
+**            TbxMbCyclicCreate().
+** \param     cyclic Handle to the Modbus client cyclic polling object to release.
+**
+****************************************************************************************/
+void TbxMbCyclicFree(tTbxMbCyclic cyclic)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(cyclic != NULL);
+
+  /* Only continue with valid parameters. */
+  if (cyclic != NULL)
+  {
+    /* Convert the cyclic polling pointer to the context structure. */
+    tTbxMbCyclicCtx * cyclicCtx = (tTbxMbCyclicCtx *)cyclic;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(cyclicCtx->type == TBX_MB_CYCLIC_CONTEXT_TYPE);
+    TbxCriticalSectionEnter();
+    /* Invalidate the context to protect it from accidentally being used afterwards. */
+    cyclicCtx->type = 0U;
+    cyclicCtx->pollFcn = NULL;
+    TbxCriticalSectionExit();
+    /* Remove the context from the poller array of its event task right away, such
+     * that its poll function is no longer called after releasing it.
+     */
+    TbxMbEventPollerRelease(cyclicCtx);
+    TbxCriticalSectionEnter();
+    /* Give the tags and blocks back to their memory pools and delete the lists. */
+    void * listItem = TbxListGetFirstItem(cyclicCtx->tagList);
+    while (listItem != NULL)
+    {
+      TbxMemPoolRelease(listItem);
+      listItem = TbxListGetNextItem(cyclicCtx->tagList, listItem);
+    }
+    listItem = TbxListGetFirstItem(cyclicCtx->blockList);
+    while (listItem != NULL)
+    {
+      TbxMemPoolRelease(listItem);
+      listItem = TbxListGetNextItem(cyclicCtx->blockList, listItem);
+    }
+    TbxListDelete(cyclicCtx->tagList);
+    TbxListDelete(cyclicCtx->blockList);
+    cyclicCtx->tagList = NULL;
+    cyclicCtx->blockList = NULL;
+    /* Still waiting for a block read to complete? In this case the completion callback
+     * still needs access to the context. It then releases the context instead.
+     */
+    uint8_t releaseNow = TBX_TRUE;
+    if (cyclicCtx->readBlock != NULL)
+    {
+      cyclicCtx->readBlock = NULL;
+      cyclicCtx->released = TBX_TRUE;
+      releaseNow = TBX_FALSE;
+    }
+    TbxCriticalSectionExit();
+    /* Give the cyclic polling context back to the memory pool, if possible. */
+    if (releaseNow == TBX_TRUE)
+    {
+      TbxMemPoolRelease(cyclicCtx);
+    }
+  }
+} /*** end of TbxMbCyclicFree ***/
+
+
+/************************************************************************************//**
+** \brief     Adds a tag for cyclic polling. A tag is a range of elements in a data
+**            table of a server. Once read, their values are written to the tag's
+**            shadow buffer.
+** \details   The shadow buffer is updated from the event task. For multi-element tags
+**            on an RTOS, read it from a critical section, to get a consistent set of
+**            values. A failed read leaves the shadow buffer unchanged. Make sure the
+**            shadow buffer stays valid, until the cyclic polling object is released.
+** \param     cyclic Handle to the Modbus client cyclic polling object.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     table The data table to read the elements from.
+** \param     addr Starting element address (0..65535) in the Modbus data table.
+** \param     num Number of elements to read. Range can be 1..2000 for coils and
+**            discrete inputs and 1..125 for registers.
+** \param     period Read period in milliseconds. If the tag ends up in a block together
+**            with faster tags, it is read more often.
+** \param     data Pointer to the tag's shadow buffer. For coils and discrete inputs, it
+**            is a uint8_t array with TBX_ON / TBX_OFF values. For registers, it is a
+**            uint16_t array.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbCyclicAddTag(tTbxMbCyclic         cyclic,
+                          uint8_t              node,
+                          tTbxMbCyclicTable    table,
+                          uint16_t             addr,
+                          uint16_t             num,
+                          uint16_t             period,
+                          void               * data)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify parameters. */
+  TBX_ASSERT((cyclic != NULL) && (node >= TBX_MB_TP_NODE_ADDR_MIN) &&
+             (node <= TBX_MB_TP_NODE_ADDR_MAX) && (table < TBX_MB_CYCLIC_NUM_TABLE) &&
+             (num >= 1U) && (period > 0U) && (data != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((cyclic != NULL) && (node >= TBX_MB_TP_NODE_ADDR_MIN) &&
+      (node <= TBX_MB_TP_NODE_ADDR_MAX) && (table < TBX_MB_CYCLIC_NUM_TABLE) &&
+      (num >= 1U) && (period > 0U) && (data != NULL))
+  {
+    /* Verify the number of elements and that the tag doesn't go past the last element
+     * address.
+     */
+    TBX_ASSERT((num <= tbxMbCyclicReadNumMax[table]) &&
+               (((uint32_t)addr + num) <= 65536UL));
+    /* Only continue with a valid number of elements. */
+    if ((num <= tbxMbCyclicReadNumMax[table]) && (((uint32_t)addr + num) <= 65536UL))
+    {
+      /* Convert the cyclic polling pointer to the context structure. */
+      tTbxMbCyclicCtx * cyclicCtx = (tTbxMbCyclicCtx *)cyclic;
+      /* Sanity check on the context type. */
+      TBX_ASSERT(cyclicCtx->type == TBX_MB_CYCLIC_CONTEXT_TYPE);
+      /* Allocate memory for the new tag. */
+      tTbxMbCyclicTag * newTag = TbxMemPoolAllocate(sizeof(tTbxMbCyclicTag));
+      /* Automatically increase the memory pool, if it was too small. */
+      if (newTag == NULL)
+      {
+        /* No need to check the return value, because if it failed, the following
+         * allocation fails too, which is verified later on.
+         */
+        (void)TbxMemPoolCreate(1U, sizeof(tTbxMbCyclicTag));
+        newTag = TbxMemPoolAllocate(sizeof(tTbxMbCyclicTag));
+      }
+      /* Verify memory allocation of the tag. */
+      TBX_ASSERT(newTag != NULL);
+      /* Only continue if the memory allocation succeeded. */
+      if (newTag != NULL)
+      {
+        /* Initialize the tag. It's not part of a block until the next blocks rebuild. */
+        newTag->node = node;
+        newTag->table = (uint8_t)table;
+        newTag->addr = addr;
+        newTag->num = num;
+        newTag->period = period;
+        newTag->data = data;
+        newTag->block = NULL;
+        /* The tag list is kept sorted by node, table and element address. This makes
+         * it possible to merge the tags into blocks with just one pass over the list.
+         * Start by locating the first tag, which should come after the new one.
+         */
+        TbxCriticalSectionEnter();
+        tTbxMbCyclicTag * listTag = TbxListGetFirstItem(cyclicCtx->tagList);
+        while (listTag != NULL)
+        {
+          if (TbxMbCyclicTagIsBefore(newTag, listTag) == TBX_TRUE)
+          {
+            break;
+          }
+          listTag = TbxListGetNextItem(cyclicCtx->tagList, listTag);
+        }
+        /* Insert the new tag at the located position. */
+        if (listTag != NULL)
+        {
+          result = TbxListInsertItemBefore(cyclicCtx->tagList, newTag, listTag);
+        }
+        else
+        {
+          result = TbxListInsertItemBack(cyclicCtx->tagList, newTag);
+        }
+        /* Request a rebuild of the blocks, now that the tags changed. */
+        if (result == TBX_OK)
+        {
+          cyclicCtx->rebuild = TBX_TRUE;
+        }
+        TbxCriticalSectionExit();
+        /* Verify that the tag could be added to the list. If not, then the heap size is
+         * configured too small. In this case increase the heap size using configuration
+         * macro TBX_CONF_HEAP_SIZE.
+         */
+        TBX_ASSERT(result == TBX_OK);
+        /* Give the tag back to the memory pool, if it could not be added. */
+        if (result != TBX_OK)
+        {
+          TbxMemPoolRelease(newTag);
+        }
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbCyclicAddTag ***/
+
+
+/************************************************************************************//**
+** \brief     Event polling function that is automatically called during each call of
+**            TbxMbEventTask(), if activated. Use the TBX_MB_EVENT_ID_START_POLLING and
+**            TBX_MB_EVENT_ID_STOP_POLLING events to activate and deactivate. It keeps
+**            track of time and starts reading the next block, once it's due.
+** \param     cyclic Handle to the Modbus client cyclic polling object.
+**
+****************************************************************************************/
+static void TbxMbCyclicPoll(tTbxMbCyclic cyclic)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(cyclic != NULL);
+
+  /* Only continue with valid parameters. */
+  if (cyclic != NULL)
+  {
+    /* Convert the cyclic polling pointer to the context structure. */
+    tTbxMbCyclicCtx * cyclicCtx = (tTbxMbCyclicCtx *)cyclic;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(cyclicCtx->type == TBX_MB_CYCLIC_CONTEXT_TYPE);
+    /* Get the number of ticks that elapsed since the last millisecond detection. Note
+     * that this calculation works, even if the 20 kHz timer counter overflowed.
+     */
+    uint16_t deltaTicks = TbxMbPortTimerCount() - cyclicCtx->msTime;
+    /* Determine how many milliseconds passed since the last one was detected. */
+    uint16_t deltaMs = deltaTicks / 20U;
+    /* Update the last millisecond detection tick time and the millisecond counter. Note
+     * that these calculations work, even if the elements overflow.
+     */
+    cyclicCtx->msTime += (deltaMs * 20U);
+    cyclicCtx->msCounter += deltaMs;
+    /* Only one block is read at a time. Is no block read in progress? */
+    TbxCriticalSectionEnter();
+    tTbxMbCyclicBlock * readBlockCopy = cyclicCtx->readBlock;
+    uint8_t             rebuildCopy = cyclicCtx->rebuild;
+    TbxCriticalSectionExit();
+    if (readBlockCopy == NULL)
+    {
+      /* Rebuild the blocks first, if the tags changed. */
+      if (rebuildCopy == TBX_TRUE)
+      {
+        TbxMbCyclicBuild(cyclicCtx);
+      }
+      /* Start reading the next block, if one is due. */
+      TbxMbCyclicReadNext(cyclicCtx);
+    }
+  }
+} /*** end of TbxMbCyclicPoll ***/
+
+
+/************************************************************************************//**
+** \brief     Merges the tags into blocks, such that the least amount of read requests
+**            is needed. Tags can be merged, if they are for the same data table of the
+**            same server, if their element addresses are no more than maxGap apart and
+**            if the resulting block does not exceed the maximum number of elements per
+**            read request. A block is read with the period of its fastest tag.
+** \param     cyclicCtx Pointer to the Modbus client cyclic polling context.
+**
+****************************************************************************************/
+static void TbxMbCyclicBuild(tTbxMbCyclicCtx * cyclicCtx)
+{
+  tTbxMbCyclicBlock * block = NULL;
+
+  /* Clear the rebuild request. Do this first to not miss tags that are added, while
+   * the rebuild is in progress.
+   */
+  TbxCriticalSectionEnter();
+  cyclicCtx->rebuild = TBX_FALSE;
+  TbxCriticalSectionExit();
+  /* Give all the current blocks back to the memory pool. */
+  void * listItem = TbxListGetFirstItem(cyclicCtx->blockList);
+  while (listItem != NULL)
+  {
+    TbxMemPoolRelease(listItem);
+    listItem = TbxListGetNextItem(cyclicCtx->blockList, listItem);
+  }
+  TbxListClear(cyclicCtx->blockList);
+  /* Iterate over the tags, which are sorted by node, table and element address. */
+  TbxCriticalSectionEnter();
+  tTbxMbCyclicTag * tag = TbxListGetFirstItem(cyclicCtx->tagList);
+  TbxCriticalSectionExit();
+  while (tag != NULL)
+  {
+    uint8_t merged = TBX_FALSE;
+    /* Can the tag be merged into the current block? */
+    if (block != NULL)
+    {
+      if ((tag->node == block->node) && (tag->table == block->table))
+      {
+        /* Determine the end of the block, should the tag be merged into it. */
+        uint32_t blockEnd = (uint32_t)block->addr + block->num;
+        uint32_t tagEnd = (uint32_t)tag->addr + tag->num;
+        uint32_t newEnd = (tagEnd > blockEnd) ? tagEnd : blockEnd;
+        /* Check the gap between the block and the tag and the block size limit. */
+        if ((tag->addr <= (blockEnd + cyclicCtx->maxGap)) &&
+            ((newEnd - block->addr) <= tbxMbCyclicReadNumMax[block->table]))
+        {
+          /* Merge the tag into the block. */
+          block->num = (uint16_t)(newEnd - block->addr);
+          if (tag->period < block->period)
+          {
+            block->period = tag->period;
+            block->lastMs = cyclicCtx->msCounter - block->period;
+          }
+          merged = TBX_TRUE;
+        }
+      }
+    }
+    /* Start a new block for the tag, if it could not be merged. */
+    if (merged == TBX_FALSE)
+    {
+      /* Allocate memory for the new block. */
+      block = TbxMemPoolAllocate(sizeof(tTbxMbCyclicBlock));
+      /* Automatically increase the memory pool, if it was too small. */
+      if (block == NULL)
+      {
+        /* No need to check the return value, because if it failed, the following
+         * allocation fails too, which is verified later on.
+         */
+        (void)TbxMemPoolCreate(1U, sizeof(tTbxMbCyclicBlock));
+        block = TbxMemPoolAllocate(sizeof(tTbxMbCyclicBlock));
+      }
+      /* Verify memory allocation of the block. */
+      TBX_ASSERT(block != NULL);
+      /* Only continue if the memory allocation succeeded. */
+      if (block != NULL)
+      {
+        /* Initialize the block such that it's due for reading right away. */
+        block->node = tag->node;
+        block->table = tag->table;
+        block->addr = tag->addr;
+        block->num = tag->num;
+        block->period = tag->period;
+        block->lastMs = cyclicCtx->msCounter - block->period;
+        /* Add the block to the list. */
+        if (TbxListInsertItemBack(cyclicCtx->blockList, block) != TBX_OK)
+        {
+          /* Could not add it, because the heap size is configured too small. In this
+           * case increase the heap size using configuration macro TBX_CONF_HEAP_SIZE.
+           */
+          TBX_ASSERT(TBX_FALSE);
+          TbxMemPoolRelease(block);
+          block = NULL;
+        }
+      }
+    }
+    /* Link the tag to the block that reads it. */
+    tag->block = block;
+    /* Move on to the next tag. */
+    TbxCriticalSectionEnter();
+    tag = TbxListGetNextItem(cyclicCtx->tagList, tag);
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxMbCyclicBuild ***/
+
+
+/************************************************************************************//**
+** \brief     Starts reading the next block that is due. In case multiple blocks are
+**            due, it starts reading the one with the earliest deadline.
+** \param     cyclicCtx Pointer to the Modbus client cyclic polling context.
+**
+****************************************************************************************/
+static void TbxMbCyclicReadNext(tTbxMbCyclicCtx * cyclicCtx)
+{
+  tTbxMbCyclicBlock * nextBlock = NULL;
+  uint32_t            nextOverdueMs = 0U;
+
+  /* Locate the block that is the longest overdue. */
+  tTbxMbCyclicBlock * block = TbxListGetFirstItem(cyclicCtx->blockList);
+  while (block != NULL)
+  {
+    /* Note that this calculation works, even if the millisecond counter overflowed. */
+    uint32_t elapsedMs = cyclicCtx->msCounter - block->lastMs;
+    /* Is the block due? */
+    if (elapsedMs >= block->period)
+    {
+      uint32_t overdueMs = elapsedMs - block->period;
+      if ((nextBlock == NULL) || (overdueMs > nextOverdueMs))
+      {
+        nextBlock = block;
+        nextOverdueMs = overdueMs;
+      }
+    }
+    block = TbxListGetNextItem(cyclicCtx->blockList, block);
+  }
+
+  /* Only continue if a block is due. */
+  if (nextBlock != NULL)
+  {
+    /* Prepare the read request PDU. */
+    cyclicCtx->txPdu[0] = tbxMbCyclicReadCode[nextBlock->table];
+    TbxMbCommonStoreUInt16BE(nextBlock->addr, &cyclicCtx->txPdu[1]);
+    TbxMbCommonStoreUInt16BE(nextBlock->num, &cyclicCtx->txPdu[3]);
+    cyclicCtx->pduLen = 5U;
+    /* Submit the read request. Note that this fails, if the client channel is busy with
+     * another request. Not a problem, because then it's automatically retried during
+     * the next call of the polling function.
+     */
+    TbxCriticalSectionEnter();
+    cyclicCtx->readBlock = nextBlock;
+    TbxCriticalSectionExit();
+    if (TbxMbClientCustomFunctionAsync(cyclicCtx->channel, nextBlock->node,
+                                       cyclicCtx->txPdu, cyclicCtx->rxPdu,
+                                       &cyclicCtx->pduLen, TbxMbCyclicReadDone,
+                                       cyclicCtx) == TBX_OK)
+    {
+      /* Schedule the next read of this block. Keep its phase, unless it fell behind by
+       * more than a period. In that case just schedule it relative to now.
+       */
+      if (nextOverdueMs < nextBlock->period)
+      {
+        nextBlock->lastMs += nextBlock->period;
+      }
+      else
+      {
+        nextBlock->lastMs = cyclicCtx->msCounter;
+      }
+    }
+    else
+    {
+      TbxCriticalSectionEnter();
+      cyclicCtx->readBlock = NULL;
+      TbxCriticalSectionExit();
+    }
+  }
+} /*** end of TbxMbCyclicReadNext ***/
+
+
+/************************************************************************************//**
+** \brief     Client request completion callback function for a block read. It writes
+**            the values of the block's elements to the shadow buffers of its tags.
+** \param     channel Handle to the Modbus client channel object that completed the
+**            request.
+** \param     result TBX_OK if the request completed successfully, TBX_ERROR otherwise.
+** \param     param Pointer to the Modbus client cyclic polling context.
+**
+****************************************************************************************/
+static void TbxMbCyclicReadDone(tTbxMbClient   channel,
+                                uint8_t        result,
+                                void         * param)
+{
+  TBX_UNUSED_ARG(channel);
+
+  /* Verify parameters. */
+  TBX_ASSERT(param != NULL);
+
+  /* Only continue with valid parameters. */
+  if (param != NULL)
+  {
+    /* Convert the parameter to the cyclic polling context structure. */
+    tTbxMbCyclicCtx * cyclicCtx = (tTbxMbCyclicCtx *)param;
+    /* Complete the block read. */
+    TbxCriticalSectionEnter();
+    tTbxMbCyclicBlock * block = cyclicCtx->readBlock;
+    uint8_t             releasedCopy = cyclicCtx->released;
+    cyclicCtx->readBlock = NULL;
+    TbxCriticalSectionExit();
+    /* Was the cyclic polling object released while the block was being read? */
+    if (releasedCopy == TBX_TRUE)
+    {
+      /* Now that the context is no longer needed, give it back to the memory pool. */
+      TbxMemPoolRelease(cyclicCtx);
+    }
+    /* Only continue if the block was read and its response is valid. */
+    else if ((block != NULL) && (result == TBX_OK))
+    {
+      if (TbxMbCyclicRespCheck(cyclicCtx, block) == TBX_OK)
+      {
+        /* Update the shadow buffer of all the tags in the block. */
+        TbxCriticalSectionEnter();
+        tTbxMbCyclicTag * tag = TbxListGetFirstItem(cyclicCtx->tagList);
+        TbxCriticalSectionExit();
+        while (tag != NULL)
+        {
+          if (tag->block == block)
+          {
+            TbxMbCyclicTagUpdate(cyclicCtx, tag);
+          }
+          TbxCriticalSectionEnter();
+          tag = TbxListGetNextItem(cyclicCtx->tagList, tag);
+          TbxCriticalSectionExit();
+        }
+      }
+    }
+    else
+    {
+      /* Block read failed. Keep the last known values in the shadow buffers. */
+    }
+  }
+} /*** end of TbxMbCyclicReadDone ***/
+
+
+/************************************************************************************//**
+** \brief     Checks that the response PDU is a valid response to the block read.
+** \param     cyclicCtx Pointer to the Modbus client cyclic polling context.
+** \param     block Pointer to the block that was read.
+** \return    TBX_OK if the response is valid, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbCyclicRespCheck(tTbxMbCyclicCtx   const * cyclicCtx,
+                                    tTbxMbCyclicBlock const * block)
+{
+  uint8_t  result = TBX_ERROR;
+  uint16_t byteCount;
+
+  /* Determine the expected byte count. */
+  if ((block->table == (uint8_t)TBX_MB_CYCLIC_COILS) ||
+      (block->table == (uint8_t)TBX_MB_CYCLIC_INPUTS))
+  {
+    byteCount = (block->num + 7U) / 8U;
+  }
+  else
+  {
+    byteCount = block->num * 2U;
+  }
+  /* Not an exception response and the expected byte count and length? */
+  if ((cyclicCtx->pduLen >= 2U) &&
+      (cyclicCtx->rxPdu[0] == tbxMbCyclicReadCode[block->table]) &&
+      (cyclicCtx->rxPdu[1] == byteCount) &&
+      (cyclicCtx->pduLen == (byteCount + 2U)))
+  {
+    result = TBX_OK;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbCyclicRespCheck ***/
+
+
+/************************************************************************************//**
+** \brief     Writes the values of the tag's elements from the response PDU to the
+**            tag's shadow buffer.
+** \param     cyclicCtx Pointer to the Modbus client cyclic polling context.
+** \param     tag Pointer to the tag. It should be part of the block that was read.
+**
+****************************************************************************************/
+static void TbxMbCyclicTagUpdate(tTbxMbCyclicCtx const * cyclicCtx,
+                                 tTbxMbCyclicTag       * tag)
+{
+  /* Determine the offset of the tag's elements in the response data. */
+  uint16_t offset = tag->addr - tag->block->addr;
+  uint8_t const * respData = &cyclicCtx->rxPdu[2];
+
+  /* Update the shadow buffer in a consistent manner. */
+  TbxCriticalSectionEnter();
+  /* Coils and discrete inputs are packed as bits in the response. */
+  if ((tag->table == (uint8_t)TBX_MB_CYCLIC_COILS) ||
+      (tag->table == (uint8_t)TBX_MB_CYCLIC_INPUTS))
+  {
+    uint8_t * bitData = (uint8_t *)tag->data;
+    for (uint16_t idx = 0U; idx < tag->num; idx++)
+    {
+      uint16_t bitIdx = offset + idx;
+      uint8_t  bitMask = (uint8_t)(1U << (bitIdx % 8U));
+      bitData[idx] = ((respData[bitIdx / 8U] & bitMask) != 0U) ? TBX_ON : TBX_OFF;
+    }
+  }
+  /* Registers are stored in the big endian format in the response. */
+  else
+  {
+    uint16_t * regData = (uint16_t *)tag->data;
+    for (uint16_t idx = 0U; idx < tag->num; idx++)
+    {
+      regData[idx] = TbxMbCommonExtractUInt16BE(&respData[(offset + idx) * 2U]);
+    }
+  }
+  TbxCriticalSectionExit();
+} /*** end of TbxMbCyclicTagUpdate ***/
+
+
+/************************************************************************************//**
+** \brief     Determines if a tag comes before another tag, when sorting them by node,
+**            table and element address.
+** \param     tag Pointer to the tag.
+** \param     other Pointer to the other tag.
+** \return    TBX_TRUE if the tag comes before the other tag, TBX_FALSE otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbCyclicTagIsBefore(tTbxMbCyclicTag const * tag,
+                                      tTbxMbCyclicTag const * other)
+{
+  uint8_t result = TBX_FALSE;
+
+  if (tag->node != other->node)
+  {
+    result = (tag->node < other->node) ? TBX_TRUE : TBX_FALSE;
+  }
+  else if (tag->table != other->table)
+  {
+    result = (tag->table < other->table) ? TBX_TRUE : TBX_FALSE;
+  }
+  else
+  {
+    result = (tag->addr < other->addr) ? TBX_TRUE : TBX_FALSE;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbCyclicTagIsBefore ***/
+
+
+/*********************************** end of tbxmb_cyclic.c *****************************/
@@ -0,0 +1,84 @@
+/************************************************************************************//**
+* \file         tbxmb_cyclic.h
+* \brief        Modbus client cyclic polling header file.
+* \internal
+*----------------------------------------------------------------------------------------
+*                          C O P Y R I G H T
+*----------------------------------------------------------------------------------------
+*   Copyright (c) 2023 by Feaser     www.feaser.com     All rights reserved
+*
+*----------------------------------------------------------------------------------------
+*                            L I C E N S E
+*----------------------------------------------------------------------------------------
+*
+* SPDX-License-Identifier: GPL-3.0-or-later
+*
+* This file is part of MicroTBX-Modbus. MicroTBX-Modbus is free software: you can
+* redistribute it and/or modify it under the terms of the GNU General Public License as
+* published by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* MicroTBX-Modbus is distributed in the hope that it will be useful, but WITHOUT ANY
+* WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+* PARTICULAR PURPOSE. See the GNU General Public License for more details.
+*
+* You have received a copy of the GNU General Public License along with MicroTBX-Modbus.
+* If not, see www.gnu.org/licenses/.
+*
+* \endinternal
+****************************************************************************************/
+#ifndef TBXMB_CYCLIC_H
+#define TBXMB_CYCLIC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************************
+* Type definitions
+****************************************************************************************/
+/** \brief Handle to a Modbus client cyclic polling object, in the format of an opaque
+ *         pointer.
+ */
+typedef void * tTbxMbCyclic;
+
+
+/** \brief Enumerated type with the Modbus data tables that can be polled cyclically. */
+typedef enum
+{
+  /* Coils data table. Read with function code 1. */
+  TBX_MB_CYCLIC_COILS = 0U,
+  /* Discrete inputs data table. Read with function code 2. */
+  TBX_MB_CYCLIC_INPUTS,
+  /* Holding registers data table. Read with function code 3. */
+  TBX_MB_CYCLIC_HOLDING_REGS,
+  /* Input registers data table. Read with function code 4. */
+  TBX_MB_CYCLIC_INPUT_REGS,
+  /* Extra entry to obtain the number of elements. */
+  TBX_MB_CYCLIC_NUM_TABLE
+} tTbxMbCyclicTable;
+
+
+/****************************************************************************************
+* Function prototypes
+****************************************************************************************/
+tTbxMbCyclic TbxMbCyclicCreate          (tTbxMbClient         channel,
+                                         uint16_t             maxGap);
+
+void         TbxMbCyclicFree            (tTbxMbCyclic         cyclic);
+
+uint8_t      TbxMbCyclicAddTag          (tTbxMbCyclic         cyclic,
+                                         uint8_t              node,
+                                         tTbxMbCyclicTable    table,
+                                         uint16_t             addr,
+                                         uint16_t             num,
+                                         uint16_t             period,
+                                         void               * data);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TBXMB_CYCLIC_H */
+/*********************************** end of tbxmb_cyclic.h *****************************/
@@ -0,0 +1,110 @@
+/************************************************************************************//**
+* \file         tbxmb_cyclic_private.h
+* \brief        Modbus client cyclic polling private header file.
+* \internal
+*----------------------------------------------------------------------------------------
+*                          C O P Y R I G H T
+*----------------------------------------------------------------------------------------
+*   Copyright (c) 2023 by Feaser     www.feaser.com     All rights reserved
+*
+*----------------------------------------------------------------------------------------
+*                            L I C E N S E
+*----------------------------------------------------------------------------------------
+*
+* SPDX-License-Identifier: GPL-3.0-or-later
+*
+* This file is part of MicroTBX-Modbus. MicroTBX-Modbus is free software: you can
+* redistribute it and/or modify it under the terms of the GNU General Public License as
+* published by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* MicroTBX-Modbus is distributed in the hope that it will be useful, but WITHOUT ANY
+* WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+* PARTICULAR PURPOSE. See the GNU General Public License for more details.
+*
+* You have received a copy of the GNU General Public License along with MicroTBX-Modbus.
+* If not, see www.gnu.org/licenses/.
+*
+* \endinternal
+****************************************************************************************/
+#ifndef TBXMB_CYCLIC_PRIVATE_H
+#define TBXMB_CYCLIC_PRIVATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************************
+* Type definitions
+****************************************************************************************/
+/** \brief Modbus client cyclic polling interface function to detect events in a
+ *         polling manner.
+ */
+typedef void (* tTbxMbCyclicPoll)   (void        * context);
+
+
+/** \brief Modbus client cyclic polling interface function for processing events. */
+typedef void (* tTbxMbCyclicProcess)(tTbxMbEvent * event);
+
+
+/** \brief Block of adjacent data table elements that is read with a single request. */
+typedef struct
+{
+  uint8_t              node;                     /**< Server node address.             */
+  uint8_t              table;                    /**< Data table (tTbxMbCyclicTable).  */
+  uint16_t             addr;                     /**< Start element address.           */
+  uint16_t             num;                      /**< Number of elements.              */
+  uint16_t             period;                   /**< Read period (ms).                */
+  uint32_t             lastMs;                   /**< Time (ms) of the last read.      */
+} tTbxMbCyclicBlock;
+
+
+/** \brief Tag that the application registered for cyclic polling. */
+typedef struct
+{
+  uint8_t              node;                     /**< Server node address.             */
+  uint8_t              table;                    /**< Data table (tTbxMbCyclicTable).  */
+  uint16_t             addr;                     /**< Start element address.           */
+  uint16_t             num;                      /**< Number of elements.              */
+  uint16_t             period;                   /**< Read period (ms).                */
+  void               * data;                     /**< Shadow buffer for the values.    */
+  tTbxMbCyclicBlock  * block;                    /**< Block that reads this tag.       */
+} tTbxMbCyclicTag;
+
+
+/** \brief Modbus client cyclic polling context that groups all its specific data. It's
+ *         what the tTbxMbCyclic opaque pointer points to.
+ */
+typedef struct
+{
+  /* Event interface methods. The following four entries must always be at the start
+   * and exactly match those in tTbxMbEventCtx. Think of it as the base that this struct
+   * derives from.
+   */
+  void               * instancePtr;              /**< Reserved for C++ wrapper.        */
+  tTbxMbCyclicPoll     pollFcn;                  /**< Event poll function.             */
+  tTbxMbCyclicProcess  processFcn;               /**< Event process function.          */
+  tTbxMbEventPoller    pollInfo;                 /**< Event poller information.        */
+  /* Private members. */
+  uint8_t              type;                     /**< Context type.                    */
+  tTbxMbClient         channel;                  /**< Client channel for the requests. */
+  uint16_t             maxGap;                   /**< Max unused elements in a block.  */
+  tTbxList           * tagList;                  /**< Tags sorted by node/table/addr.  */
+  tTbxList           * blockList;                /**< Blocks built from the tags.      */
+  uint8_t              rebuild;                  /**< Blocks rebuild needed flag.      */
+  uint8_t              released;                 /**< Released while reading flag.     */
+  tTbxMbCyclicBlock  * readBlock;                /**< Block that is being read.        */
+  uint32_t             msCounter;                /**< Free running millisecond counter.*/
+  uint16_t             msTime;                   /**< Last millisecond tick time.      */
+  uint8_t              txPdu[5];                 /**< Read request PDU.                */
+  uint8_t              rxPdu[TBX_MB_TP_PDU_MAX_LEN]; /**< Read response PDU.           */
+  uint8_t              pduLen;                   /**< Request/response PDU length.     */
+} tTbxMbCyclicCtx;
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TBXMB_CYCLIC_PRIVATE_H */
+/*********************************** end of tbxmb_cyclic_private.h *********************/
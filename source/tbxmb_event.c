@@ -37,6 +37,33 @@
 #include "tbxmb_osal_private.h"                  /* MicroTBX-Modbus OSAL private       */
 
 
+/****************************************************************************************
+* Macro definitions
+****************************************************************************************/
+#ifndef TBX_MB_EVENT_TASK_BUDGET
+/** \brief Maximum number of events that the event task processes, each time it runs.
+ *         Before it returns, the event task calls the poll functions. A larger value
+ *         lets the event task catch up faster on a burst of events. A smaller value
+ *         makes sure the poll functions are called more often. To override this
+ *         default configuration, you can add a macro with the same name, but with a
+ *         different value, to "tbx_conf.h".
+ */
+#define TBX_MB_EVENT_TASK_BUDGET       (8U)
+#endif
+
+
+/****************************************************************************************
+* Configuration check
+****************************************************************************************/
+#if (TBX_MB_EVENT_TASK_BUDGET == 0U)
+#error "TBX_MB_EVENT_TASK_BUDGET must be > 0."
+#endif
+
+#if (TBX_MB_EVENT_TASK_NUM == 0U)
+#error "TBX_MB_EVENT_TASK_NUM must be > 0."
+#endif
+
+
 /****************************************************************************************
 * Type definitions
 ****************************************************************************************/
@@ -55,15 +82,53 @@ typedef void (* tTbxMbEventProcess)(tTbxMbEvent * event);
  */
 typedef struct
 {
-  /* The following three entries must always be at the start and not change order. They
+  /* The following four entries must always be at the start and not change order. They
    * form the base that other context derive from.
    */
   void               * instancePtr;              /**< Reserved for C++ wrapper.        */
   tTbxMbEventPoll      pollFcn;                  /**< Event poll function.             */
   tTbxMbEventProcess   processFcn;               /**< Event process function.          */
+  tTbxMbEventPoller    pollInfo;                 /**< Event poller information.        */
 } tTbxMbEventCtx;
 
 
+/****************************************************************************************
+* Function prototypes
+****************************************************************************************/
+static void TbxMbEventProcess     (tTbxMbEvent    * event,
+                                   uint8_t          taskIdx);
+
+static void TbxMbEventPollerAdd   (tTbxMbEventCtx * eventCtx,
+                                   uint8_t          taskIdx);
+
+static void TbxMbEventPollerRemove(tTbxMbEventCtx * eventCtx,
+                                   uint8_t          taskIdx);
+
+static void TbxMbEventPollerDetach(tTbxMbEventCtx * eventCtx,
+                                   uint8_t          taskIdx);
+
+
+/****************************************************************************************
+* Local data declarations
+****************************************************************************************/
+/** \brief Contexts of which the event task should call the poll function. There is
+ *         a separate array for each event task.
+ */
+static tTbxMbEventCtx * eventPollers[TBX_MB_EVENT_TASK_NUM][TBX_MB_EVENT_QUEUE_SIZE];
+
+/** \brief Number of used entries in the eventPollers array, per event task. */
+static uint8_t          eventPollersCount[TBX_MB_EVENT_TASK_NUM];
+
+/** \brief Event task that newly created transport layer objects are assigned to. */
+static uint8_t          eventTaskSelected = 0U;
+
+/** \brief Processor core that each event task should be pinned to. */
+static uint8_t volatile eventTaskCore[TBX_MB_EVENT_TASK_NUM];
+
+/** \brief Flags to request an event task to pin itself to its processor core. */
+static uint8_t volatile eventTaskPinPending[TBX_MB_EVENT_TASK_NUM];
+
+
 /************************************************************************************//**
 ** \brief     Task function that drives the entire Modbus stack. It processes internally
 **            generated events. 
@@ -83,106 +148,477 @@ typedef struct
 **            For this reason it is recommended to use an RTOS in combination with a
 **            Modbus client.
 **
+**            Each call processes up to TBX_MB_EVENT_TASK_BUDGET pending events and then
+**            calls the poll function of each context that requested polling, once.
+**
+**            This function runs the first event task. Only use TbxMbEventTaskIndexed()
+**            instead, when configuring more than one event task.
+**
 ****************************************************************************************/
 void TbxMbEventTask(void)
 {
-  static tTbxList * pollerList = NULL;
-  static uint8_t    pollerListInitialized = TBX_FALSE;
-  const  uint16_t   defaultWaitTimeoutMs = 5000U;
-  static uint16_t   waitTimeoutMS = 5000U;
-  tTbxMbEvent       newEvent = { 0 };
-
-  /* Only initialize the event poller once, */
-  if (pollerListInitialized == TBX_FALSE)
+  TbxMbEventTaskIndexed(0U);
+} /*** end of TbxMbEventTask ***/
+
+
+/************************************************************************************//**
+** \brief     Task function that drives the Modbus objects, which are assigned to an
+**            event task, with TbxMbEventTaskSelect() or TbxMbEventTaskAssign(). Same as
+**            TbxMbEventTask(), but for the specified event task. Use this when the
+**            application configures more than one event task with
+**            TBX_MB_EVENT_TASK_NUM. Each event task has its own event queue. Call this
+**            function from a separate RTOS task for each event task, such that each one
+**            can run at its own priority.
+** \param     taskIdx Zero based index of the event task. Must be smaller than
+**            TBX_MB_EVENT_TASK_NUM.
+**
+****************************************************************************************/
+void TbxMbEventTaskIndexed(uint8_t taskIdx)
+{
+  const uint16_t defaultWaitTimeoutMs = 5000U;
+  uint16_t       waitTimeoutMs;
+  uint8_t        eventPending = TBX_TRUE;
+  tTbxMbEvent    newEvent = { 0 };
+
+  /* Verify parameters. */
+  TBX_ASSERT(taskIdx < TBX_MB_EVENT_TASK_NUM);
+
+  /* Only continue with valid parameters. */
+  if (taskIdx < TBX_MB_EVENT_TASK_NUM)
+  {
+    /* Should this event task pin itself to a processor core? This needs to happen from
+     * the task that runs the event task, so it's done here.
+     */
+    if (eventTaskPinPending[taskIdx] == TBX_TRUE)
+    {
+      eventTaskPinPending[taskIdx] = TBX_FALSE;
+      TbxMbOsalTaskPin(eventTaskCore[taskIdx]);
+    }
+    /* Set the event wait timeout. If the event poller array is not empty, keep the wait
+     * time short to make sure the poll functions get continuously called. Otherwise use
+     * the default wait time to not hog up CPU time unnecessarily.
+     */
+    waitTimeoutMs = (eventPollersCount[taskIdx] > 0U) ? 1U : defaultWaitTimeoutMs;
+
+    /* Process the pending events, up to the configured budget. This prevents events
+     * from piling up in the event queue, for example during a burst of bus traffic. The
+     * budget makes sure the poll functions still get called regularly.
+     */
+    for (uint8_t eventIdx = 0U;
+         (eventIdx < TBX_MB_EVENT_TASK_BUDGET) && (eventPending == TBX_TRUE);
+         eventIdx++)
+    {
+      /* Wait for a new event to be posted to the event queue. Note that that wait time
+       * only applies in case an RTOS is configured for the OSAL. Otherwise
+       * (TBX_MB_OPT_OSAL_NONE) this function returns immediately. Only the first event
+       * is waited for. The others are only processed if already pending.
+       */
+      eventPending = TbxMbOsalEventWait(&newEvent, taskIdx, waitTimeoutMs);
+      waitTimeoutMs = 0U;
+      /* Process the event, if one was pending. */
+      if (eventPending == TBX_TRUE)
+      {
+        TbxMbEventProcess(&newEvent, taskIdx);
+      }
+    }
+
+    /* Call the poll function of all contexts that requested polling. Note that the
+     * poller array changes while processing events, but also when the application
+     * frees a context. For this reason each entry is read in a critical section.
+     */
+    uint8_t pollerIdx = 0U;
+    tTbxMbEventCtx * eventPollCtx;
+    do
+    {
+      TbxCriticalSectionEnter();
+      eventPollCtx = (pollerIdx < eventPollersCount[taskIdx]) ?
+                     eventPollers[taskIdx][pollerIdx] : NULL;
+      TbxCriticalSectionExit();
+      /* Call its poll function if configured. */
+      if ((eventPollCtx != NULL) && (eventPollCtx->pollFcn != NULL))
+      {
+        eventPollCtx->pollFcn(eventPollCtx);
+      }
+      pollerIdx++;
+    }
+    while (eventPollCtx != NULL);
+  }
+} /*** end of TbxMbEventTaskIndexed ***/
+
+
+/************************************************************************************//**
+** \brief     Selects the event task that transport layer objects, which are created
+**            afterwards, are assigned to. This binds the transport layer object to the
+**            event task at create time. Its events are then posted to the event queue
+**            of this event task right from the start, including the events that are
+**            posted from an interrupt. Only needed when configuring more than one event
+**            task with TBX_MB_EVENT_TASK_NUM. By default, the first event task is
+**            selected.
+** \details   A client or server channel, created for a transport layer object,
+**            automatically inherits its event task. Example for binding a transport
+**            layer object and its server channel to the second event task:
+**              TbxMbEventTaskSelect(1U);
+**              tTbxMbTp transport = TbxMbRtuCreate(...);
+**              tTbxMbServer server = TbxMbServerCreate(transport);
+**              TbxMbEventTaskSelect(0U);
+** \param     taskIdx Zero based index of the event task. Must be smaller than
+**            TBX_MB_EVENT_TASK_NUM.
+**
+****************************************************************************************/
+void TbxMbEventTaskSelect(uint8_t taskIdx)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(taskIdx < TBX_MB_EVENT_TASK_NUM);
+
+  /* Only continue with valid parameters. */
+  if (taskIdx < TBX_MB_EVENT_TASK_NUM)
+  {
+    /* Store the event task index. */
+    eventTaskSelected = taskIdx;
+  }
+} /*** end of TbxMbEventTaskSelect ***/
+
+
+/************************************************************************************//**
+** \brief     Pins an event task to a processor core, on a multi-core microcontroller.
+**            The next time the event task runs, it requests the OSAL to only schedule
+**            the task that runs it, on the specified processor core. Together with
+**            TbxMbEventTaskSelect(), this makes it possible to service each Modbus
+**            object on the processor core of your choice.
+** \attention Whether this is supported depends on the OSAL. With FreeRTOS, it requires
+**            a symmetric multiprocessing (SMP) configuration with core affinity enabled.
+**            Otherwise the request is ignored.
+** \param     taskIdx Zero based index of the event task. Must be smaller than
+**            TBX_MB_EVENT_TASK_NUM.
+** \param     core Zero based index of the processor core.
+**
+****************************************************************************************/
+void TbxMbEventTaskPin(uint8_t taskIdx,
+                       uint8_t core)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(taskIdx < TBX_MB_EVENT_TASK_NUM);
+
+  /* Only continue with valid parameters. */
+  if (taskIdx < TBX_MB_EVENT_TASK_NUM)
   {
-    pollerListInitialized = TBX_TRUE;
-    /* Ceate the queue for storing context of which the pollFcn should be called. */
-    pollerList = TbxListCreate();
-    /* Verify that the queue creation succeeded. If this assertion fails, increase the
-     * heap size using configuration macro TBX_CONF_HEAP_SIZE.
+    /* Store the processor core, before flagging the pin request, such that the event
+     * task always sees the correct processor core.
      */
-    TBX_ASSERT(pollerList != NULL);
+    eventTaskCore[taskIdx] = core;
+    eventTaskPinPending[taskIdx] = TBX_TRUE;
   }
+} /*** end of TbxMbEventTaskPin ***/
 
-  /* Wait for a new event to be posted to the event queue. Note that that wait time only
-   * applies in case an RTOS is configured for the OSAL. Otherwise (TBX_MB_OPT_OSAL_NONE)
-   * this function returns immediately.
-   */
-  if (TbxMbOsalEventWait(&newEvent, waitTimeoutMS) == TBX_TRUE)
+
+/************************************************************************************//**
+** \brief     Assigns a Modbus object to an event task. The event task with this index
+**            then processes all its events and calls its poll function. Only needed
+**            when configuring more than one event task with TBX_MB_EVENT_TASK_NUM. By
+**            default, all objects are assigned to the first event task.
+** \details   Call this function for a transport layer object, right after creating
+**            it. A client or server channel, created afterwards for this transport
+**            layer object, automatically inherits the same event task. The same
+**            applies to the objects that build on a client channel or a transport
+**            layer, such as a cyclic polling or a gateway object. Alternatively, use
+**            TbxMbEventTaskSelect() to bind it to an event task at create time.
+** \param     object Handle to the Modbus object, such as a transport layer (tTbxMbTp),
+**            a client channel (tTbxMbClient) or a server channel (tTbxMbServer).
+** \param     taskIdx Zero based index of the event task. Must be smaller than
+**            TBX_MB_EVENT_TASK_NUM.
+**
+****************************************************************************************/
+void TbxMbEventTaskAssign(void    * object,
+                          uint8_t   taskIdx)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((object != NULL) && (taskIdx < TBX_MB_EVENT_TASK_NUM));
+
+  /* Only continue with valid parameters. */
+  if ((object != NULL) && (taskIdx < TBX_MB_EVENT_TASK_NUM))
   {
-    /* Check the opaque context pointer. */
-    TBX_ASSERT(newEvent.context != NULL);
-    /* Only continue with a valid opaque context pointer. */
-    if (newEvent.context != NULL)
+    /* Convert the opaque pointer to the event context structure. */
+    tTbxMbEventCtx * eventCtx = (tTbxMbEventCtx *)object;
+    /* The object should not yet have been added to the poller array of its current
+     * event task. If this assertion fails, assign the object right after creating it.
+     */
+    TBX_ASSERT(eventCtx->pollInfo.count == 0U);
+    /* Store the event task index. Events that were already posted to the event queue of
+     * the previous event task, are automatically forwarded.
+     */
+    eventCtx->pollInfo.task = taskIdx;
+  }
+} /*** end of TbxMbEventTaskAssign ***/
+
+
+/************************************************************************************//**
+** \brief     Obtains the index of the event task that the Modbus object is assigned to.
+**            The OSAL uses this to post the object's events to the event queue of this
+**            event task.
+** \param     context Opaque pointer to the Modbus object's context.
+** \return    Zero based index of the event task.
+**
+****************************************************************************************/
+uint8_t TbxMbEventTaskIdx(void const * context)
+{
+  uint8_t result = 0U;
+
+  /* Verify parameters. */
+  TBX_ASSERT(context != NULL);
+
+  /* Only continue with valid parameters. */
+  if (context != NULL)
+  {
+    /* Convert the opaque pointer to the event context structure. */
+    tTbxMbEventCtx const * eventCtx = (tTbxMbEventCtx const *)context;
+    /* Update the result. */
+    result = eventCtx->pollInfo.task;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbEventTaskIdx ***/
+
+
+/************************************************************************************//**
+** \brief     Obtains the index of the event task that newly created transport layer
+**            objects should be assigned to, as selected with TbxMbEventTaskSelect().
+** \return    Zero based index of the event task.
+**
+****************************************************************************************/
+uint8_t TbxMbEventTaskSelected(void)
+{
+  /* Give the result back to the caller. */
+  return eventTaskSelected;
+} /*** end of TbxMbEventTaskSelected ***/
+
+
+/************************************************************************************//**
+** \brief     Removes the context from the poller array of its event task right away,
+**            no matter how many start polling requests are pending. The Free()
+**            function of a Modbus object calls this, before it gives the context back
+**            to its memory pool. Otherwise the event task could still call the poll
+**            function of the context, after its memory was released. Start and stop
+**            polling requests of the context, which are still in the event queue, no
+**            longer affect the poller array afterwards.
+** \param     context Opaque pointer to the Modbus object's context.
+**
+****************************************************************************************/
+void TbxMbEventPollerRelease(void * context)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(context != NULL);
+
+  /* Only continue with valid parameters. */
+  if (context != NULL)
+  {
+    /* Convert the opaque pointer to the event context structure. */
+    tTbxMbEventCtx * eventCtx = (tTbxMbEventCtx *)context;
+    TbxCriticalSectionEnter();
+    /* Only continue if the context is in the poller array. */
+    if ((eventCtx->pollInfo.count > 0U) &&
+        (eventCtx->pollInfo.task < TBX_MB_EVENT_TASK_NUM))
     {
-      /* Filter on the event identifier. */
-      switch (newEvent.id)
+      /* Discard all its pending start polling requests and remove it. */
+      eventCtx->pollInfo.count = 0U;
+      TbxMbEventPollerDetach(eventCtx, eventCtx->pollInfo.task);
+    }
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxMbEventPollerRelease ***/
+
+
+/************************************************************************************//**
+** \brief     Processes a single event that was retrieved from the event queue.
+** \param     event Pointer to the event to process.
+** \param     taskIdx Zero based index of the event task that retrieved the event.
+**
+****************************************************************************************/
+static void TbxMbEventProcess(tTbxMbEvent * event,
+                              uint8_t       taskIdx)
+{
+  /* Check the opaque context pointer. */
+  TBX_ASSERT(event->context != NULL);
+
+  /* Only continue with a valid opaque context pointer. */
+  if (event->context != NULL)
+  {
+    /* Convert the opaque pointer to the event context structure. */
+    tTbxMbEventCtx * eventCtx = (tTbxMbEventCtx *)event->context;
+    /* Sanity check on the event task index of the context. */
+    TBX_ASSERT(eventCtx->pollInfo.task < TBX_MB_EVENT_TASK_NUM);
+    /* Drop the event if the context holds an invalid event task index. */
+    if (eventCtx->pollInfo.task >= TBX_MB_EVENT_TASK_NUM)
+    {
+      /* Nothing to do. */
+    }
+    /* Was the context assigned to another event task, after posting this event? */
+    else if (eventCtx->pollInfo.task != taskIdx)
+    {
+      /* Forward the event to the event queue of the event task that the context is now
+       * assigned to.
+       */
+      TbxMbOsalEventPost(event, TBX_FALSE);
+    }
+    /* Filter on the event identifier. */
+    else
+    {
+      switch (event->id)
       {
         case TBX_MB_EVENT_ID_START_POLLING:
         {
-          /* Poller list entries are allocated from a memory pool. This means that there
-           * is no need to worry about heap fragmentation. Just make sure to cap the
-           * maximum number of entries to prevent heap exhaustion.
-           */
-          TBX_ASSERT(TbxListGetSize(pollerList) <= TBX_MB_EVENT_QUEUE_SIZE);
-          /* Only continue if the current poller list size is not yet maxed out. */
-          if (TbxListGetSize(pollerList) <= TBX_MB_EVENT_QUEUE_SIZE)
-          {
-            /* Add the context at the end of the event poller list. */
-            uint8_t insertResult = TbxListInsertItemBack(pollerList, newEvent.context);
-            /* Check that the item could be added to the queue. If not, then the heaps size
-             * is configured too small. In this case increase the heap size using
-            * configuration macro TBX_CONF_HEAP_SIZE. 
-            */
-            TBX_ASSERT(insertResult == TBX_OK);
-          }
+          TbxMbEventPollerAdd(eventCtx, taskIdx);
         }
         break;
-      
+
         case TBX_MB_EVENT_ID_STOP_POLLING:
         {
-          /* Remove the context from the event poller list. */
-          TbxListRemoveItem(pollerList, newEvent.context);
+          TbxMbEventPollerRemove(eventCtx, taskIdx);
         }
         break;
 
         default:
         {
-          /* Convert the opaque pointer to the event context structure. */
-          tTbxMbEventCtx * eventCtx = (tTbxMbEventCtx *)newEvent.context;
           /* Pass the event on to the context's event processor. */
           if (eventCtx->processFcn != NULL)
           {
-            eventCtx->processFcn(&newEvent);
+            eventCtx->processFcn(event);
           }
         }
         break;
       }
     }
   }
+} /*** end of TbxMbEventProcess ***/
+
 
-  /* Iterate over the event poller list. */
-  void * listItem = TbxListGetFirstItem(pollerList);
-  while (listItem != NULL)
+/************************************************************************************//**
+** \brief     Registers a start polling request of the context. Start and stop polling
+**            requests are counted per context. The context is only added to the poller
+**            array upon its first pending start polling request. This way its poll
+**            function is called just once per event task run, no matter how many start
+**            polling requests are pending.
+** \param     eventCtx Pointer to the context that requested polling.
+** \param     taskIdx Zero based index of the event task that polls the context.
+**
+****************************************************************************************/
+static void TbxMbEventPollerAdd(tTbxMbEventCtx * eventCtx,
+                                uint8_t          taskIdx)
+{
+  tTbxMbEventCtx * * pollers = eventPollers[taskIdx];
+
+  /* Ignore the request of a context that no longer has a poll function. This happens
+   * when the application freed the context, after the request was posted.
+   */
+  if (eventCtx->pollFcn != NULL)
   {
-    /* Convert the opaque pointer to the event context structure. */
-    tTbxMbEventCtx * eventPollCtx = (tTbxMbEventCtx *)listItem;
-    /* Call its poll function if configured. */
-    if (eventPollCtx->pollFcn != NULL)
+    TbxCriticalSectionEnter();
+    /* Is this the first pending start polling request of the context? */
+    if (eventCtx->pollInfo.count == 0U)
     {
-      eventPollCtx->pollFcn(listItem);
+      /* Don't trust the poller information of a context that is not yet registered.
+       * Only add it, if it is not already in the poller array.
+       */
+      uint8_t found = TBX_FALSE;
+      for (uint8_t idx = 0U; idx < eventPollersCount[taskIdx]; idx++)
+      {
+        if (pollers[idx] == eventCtx)
+        {
+          eventCtx->pollInfo.idx = idx;
+          found = TBX_TRUE;
+          break;
+        }
+      }
+      /* Verify that the poller array is not yet full. If this assertion fails, a
+       * context likely forgot to post its stop polling event.
+       */
+      TBX_ASSERT((found == TBX_TRUE) ||
+                 (eventPollersCount[taskIdx] < TBX_MB_EVENT_QUEUE_SIZE));
+      /* Add the context at the end of the poller array, if not yet in there. */
+      if ((found == TBX_FALSE) && (eventPollersCount[taskIdx] < TBX_MB_EVENT_QUEUE_SIZE))
+      {
+        eventCtx->pollInfo.idx = eventPollersCount[taskIdx];
+        pollers[eventPollersCount[taskIdx]] = eventCtx;
+        eventPollersCount[taskIdx]++;
+        found = TBX_TRUE;
+      }
+      /* Register the request if the context is now in the poller array. */
+      if (found == TBX_TRUE)
+      {
+        eventCtx->pollInfo.count = 1U;
+      }
     }
-    /* Move on to the next item in the list. */
-    listItem = TbxListGetNextItem(pollerList, listItem);
+    /* The context is already in the poller array. Just count the request such that it
+     * needs a matching number of stop polling requests.
+     */
+    else
+    {
+      TBX_ASSERT(eventCtx->pollInfo.count < UINT8_MAX);
+      if (eventCtx->pollInfo.count < UINT8_MAX)
+      {
+        eventCtx->pollInfo.count++;
+      }
+    }
+    TbxCriticalSectionExit();
   }
+} /*** end of TbxMbEventPollerAdd ***/
+
 
-  /* Set the event wait timeout for the next call to this task function. If the event
-   * poller list is not empty, keep the wait time short to make sure the poll functions
-   * get continuously called. Otherwise go back to the default wait time to not hog up
-   * CPU time unnecessarily.
+/************************************************************************************//**
+** \brief     Registers a stop polling request of the context. Once it no longer has
+**            pending start polling requests, the context is removed from the poller
+**            array. This takes a constant amount of time, because the last entry in the
+**            array takes its place.
+** \param     eventCtx Pointer to the context that no longer needs polling.
+** \param     taskIdx Zero based index of the event task that polls the context.
+**
+****************************************************************************************/
+static void TbxMbEventPollerRemove(tTbxMbEventCtx * eventCtx,
+                                   uint8_t          taskIdx)
+{
+  TbxCriticalSectionEnter();
+  /* Only continue if the context has pending start polling requests. A context that
+   * is not registered, for example because it was freed in the meantime, is ignored.
    */
-  waitTimeoutMS = (TbxListGetSize(pollerList) > 0U) ? 1U : defaultWaitTimeoutMs;
-} /*** end of TbxMbEventTask ***/
+  if (eventCtx->pollInfo.count > 0U)
+  {
+    eventCtx->pollInfo.count--;
+    /* Was this the last pending start polling request of the context? */
+    if (eventCtx->pollInfo.count == 0U)
+    {
+      TbxMbEventPollerDetach(eventCtx, taskIdx);
+    }
+  }
+  TbxCriticalSectionExit();
+} /*** end of TbxMbEventPollerRemove ***/
+
+
+/************************************************************************************//**
+** \brief     Removes the context from the poller array. This takes a constant amount of
+**            time, because the last entry in the array takes its place. Should be
+**            called from a critical section.
+** \param     eventCtx Pointer to the context to remove.
+** \param     taskIdx Zero based index of the event task that polls the context.
+**
+****************************************************************************************/
+static void TbxMbEventPollerDetach(tTbxMbEventCtx * eventCtx,
+                                   uint8_t          taskIdx)
+{
+  tTbxMbEventCtx * * pollers   = eventPollers[taskIdx];
+  uint8_t            removeIdx = eventCtx->pollInfo.idx;
+
+  /* Sanity check on the index that the context stored. */
+  TBX_ASSERT((removeIdx < eventPollersCount[taskIdx]) &&
+             (pollers[removeIdx] == eventCtx));
+  /* Only continue with a valid index. */
+  if ((removeIdx < eventPollersCount[taskIdx]) && (pollers[removeIdx] == eventCtx))
+  {
+    /* Move the last entry in the poller array to the freed up location. */
+    eventPollersCount[taskIdx]--;
+    pollers[removeIdx] = pollers[eventPollersCount[taskIdx]];
+    pollers[removeIdx]->pollInfo.idx = removeIdx;
+    pollers[eventPollersCount[taskIdx]] = NULL;
+  }
+} /*** end of TbxMbEventPollerDetach ***/
 
 
 /*********************************** end of tbxmb_event.c ******************************/
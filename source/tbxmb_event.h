@@ -37,7 +37,17 @@ extern "C" {
 /****************************************************************************************
 * Function prototypes
 ****************************************************************************************/
-void TbxMbEventTask(void);
+void TbxMbEventTask       (void);
+
+void TbxMbEventTaskIndexed(uint8_t   taskIdx);
+
+void TbxMbEventTaskAssign (void    * object,
+                           uint8_t   taskIdx);
+
+void TbxMbEventTaskSelect (uint8_t   taskIdx);
+
+void TbxMbEventTaskPin    (uint8_t   taskIdx,
+                           uint8_t   core);
 
 
 #ifdef __cplusplus
@@ -48,6 +48,8 @@ typedef enum
   TBX_MB_EVENT_ID_PDU_RECEIVED,
   /* Transport layer completed transmission of a protocol data unit (PDU). */
   TBX_MB_EVENT_ID_PDU_TRANSMITTED,
+  /* Transport layer timer expired. */
+  TBX_MB_EVENT_ID_TIMER_EXPIRED,
   /* Extra entry to obtain the number of elements. */
   TBX_MB_EVENT_NUM_ID
 } tTbxMbEventId;
@@ -61,6 +63,25 @@ typedef struct
 } tTbxMbEvent;
 
 
+/** \brief Event task bookkeeping of a context that requested polling. */
+typedef struct
+{
+  uint8_t         count;                         /**< Pending start polling requests.  */
+  uint8_t         idx;                           /**< Index in the event task pollers. */
+  uint8_t         task;                          /**< Index of the assigned event task.*/
+} tTbxMbEventPoller;
+
+
+/****************************************************************************************
+* Function prototypes
+****************************************************************************************/
+uint8_t TbxMbEventTaskIdx     (void const * context);
+
+uint8_t TbxMbEventTaskSelected(void);
+
+void    TbxMbEventPollerRelease(void       * context);
+
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,817 @@
+/************************************************************************************//**
+* \file         tbxmb_gateway.c
+* \brief        Modbus TCP to RTU gateway source file.
+* \internal
+*----------------------------------------------------------------------------------------
+*                          C O P Y R I G H T
+*----------------------------------------------------------------------------------------
+*   Copyright (c) 2023 by Feaser     www.feaser.com     All rights reserved
+*
+*----------------------------------------------------------------------------------------
+*                            L I C E N S E
+*----------------------------------------------------------------------------------------
+*
+* SPDX-License-Identifier: GPL-3.0-or-later
+*
+* This file is part of MicroTBX-Modbus. MicroTBX-Modbus is free software: you can
+* redistribute it and/or modify it under the terms of the GNU General Public License as
+* published by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* MicroTBX-Modbus is distributed in the hope that it will be useful, but WITHOUT ANY
+* WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+* PARTICULAR PURPOSE. See the GNU General Public License for more details.
+*
+* You have received a copy of the GNU General Public License along with MicroTBX-Modbus.
+* If not, see www.gnu.org/licenses/.
+*
+* \endinternal
+****************************************************************************************/
+
+/****************************************************************************************
+* Include files
+****************************************************************************************/
+#include "microtbx.h"                            /* MicroTBX module                    */
+#include "microtbxmodbus.h"                      /* MicroTBX-Modbus module             */
+#include "tbxmb_event_private.h"                 /* MicroTBX-Modbus event private      */
+#include "tbxmb_osal_private.h"                  /* MicroTBX-Modbus OSAL private       */
+#include "tbxmb_tp_private.h"                    /* MicroTBX-Modbus TP private         */
+#include "tbxmb_tcp_private.h"                   /* MicroTBX-Modbus TCP private        */
+#include "tbxmb_gateway_private.h"               /* MicroTBX-Modbus gateway private    */
+
+
+/****************************************************************************************
+* Macro definitions
+****************************************************************************************/
+/** \brief Unique context type to identify a context as being a gateway object. */
+#define TBX_MB_GATEWAY_CONTEXT_TYPE     (72U)
+
+/** \brief Unique context type to identify a context as being a gateway RTU bus. */
+#define TBX_MB_GATEWAY_BUS_CONTEXT_TYPE (73U)
+
+
+/****************************************************************************************
+* Configuration check
+****************************************************************************************/
+#if ((TBX_MB_GATEWAY_BUS_MAX < 1U) || (TBX_MB_GATEWAY_BUS_MAX > 255U))
+#error "TBX_MB_GATEWAY_BUS_MAX must be in the range 1..255"
+#endif
+
+#if (TBX_MB_GATEWAY_QUEUE_SIZE > 255U)
+#error "TBX_MB_GATEWAY_QUEUE_SIZE must be in the range 0..255"
+#endif
+
+
+/****************************************************************************************
+* Function prototypes
+****************************************************************************************/
+static void    TbxMbGatewayProcessEvent   (tTbxMbEvent                   * event);
+
+static void    TbxMbGatewayBusProcessEvent(tTbxMbEvent                   * event);
+
+static void    TbxMbGatewayBusPoll        (void                          * context);
+
+static uint8_t TbxMbGatewayBusStart       (tTbxMbGatewayBus              * bus,
+                                           tTbxMbTcpReplyTo        const * replyTo,
+                                           uint8_t                 const * pdu,
+                                           uint8_t                         pduLen);
+
+static void    TbxMbGatewayBusNext        (tTbxMbGatewayBus              * bus);
+
+static void    TbxMbGatewayExcpReply      (tTbxMbTpCtx                   * tcpCtx,
+                                           tTbxMbTcpReplyTo        const * replyTo,
+                                           uint8_t                         code,
+                                           uint8_t                         excpCode);
+
+
+/************************************************************************************//**
+** \brief     Creates a Modbus TCP to RTU gateway object. It behaves as a Modbus TCP
+**            server, yet instead of serving the requests itself, it forwards them to
+**            the Modbus RTU bus, that you assigned to the request's unit identifier
+**            with TbxMbGatewayAddBus(). Once received, it passes the response back to
+**            the Modbus TCP client. The gateway runs entirely in the event task.
+** \param     transport Handle to a previously created Modbus TCP transport layer object,
+**            configured as a server, to assign to the gateway.
+** \return    Handle to the newly created Modbus gateway object if successful, NULL
+**            otherwise.
+**
+****************************************************************************************/
+tTbxMbGateway TbxMbGatewayCreate(tTbxMbTp transport)
+{
+  tTbxMbGateway result = NULL;
+
+  /* Verify parameters. */
+  TBX_ASSERT(transport != NULL);
+
+  /* Only continue with valid parameters. */
+  if (transport != NULL)
+  {
+    /* Allocate memory for the new gateway context. */
+    tTbxMbGatewayCtx * newGatewayCtx = TbxMemPoolAllocate(sizeof(tTbxMbGatewayCtx));
+    /* Automatically increase the memory pool, if it was too small. */
+    if (newGatewayCtx == NULL)
+    {
+      /* No need to check the return value, because if it failed, the following
+       * allocation fails too, which is verified later on.
+       */
+      (void)TbxMemPoolCreate(1U, sizeof(tTbxMbGatewayCtx));
+      newGatewayCtx = TbxMemPoolAllocate(sizeof(tTbxMbGatewayCtx));
+    }
+    /* Verify memory allocation of the gateway context. */
+    TBX_ASSERT(newGatewayCtx != NULL);
+    /* Only continue if the memory allocation succeeded. */
+    if (newGatewayCtx != NULL)
+    {
+      /* Convert the TP channel pointer to the context structure. */
+      tTbxMbTpCtx * tpCtx = (tTbxMbTpCtx *)transport;
+      /* Sanity check on the transport layer's interface function. That way there is
+       * no need to do it later on, making it more run-time efficient. Also check that
+       * it's not already linked to another channel.
+       */
+      TBX_ASSERT((tpCtx->transmitFcn != NULL) && (tpCtx->receptionDoneFcn != NULL) &&
+                 (tpCtx->getRxPacketFcn != NULL) && (tpCtx->getTxPacketFcn != NULL) &&
+                 (tpCtx->channelCtx == NULL));
+      /* Initialize the gateway context. Start by crosslinking the transport layer. The
+       * gateway is a server channel for it.
+       */
+      newGatewayCtx->type = TBX_MB_GATEWAY_CONTEXT_TYPE;
+      newGatewayCtx->instancePtr = NULL;
+      newGatewayCtx->pollFcn = NULL;
+      newGatewayCtx->processFcn = TbxMbGatewayProcessEvent;
+      newGatewayCtx->pollInfo.count = 0U;
+      newGatewayCtx->pollInfo.task = tpCtx->pollInfo.task;
+      for (uint8_t busIdx = 0U; busIdx < TBX_MB_GATEWAY_BUS_MAX; busIdx++)
+      {
+        newGatewayCtx->bus[busIdx] = NULL;
+      }
+      newGatewayCtx->tpCtx = tpCtx;
+      newGatewayCtx->tpCtx->channelCtx = newGatewayCtx;
+      newGatewayCtx->tpCtx->isClient = TBX_FALSE;
+      /* Update the result. */
+      result = newGatewayCtx;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbGatewayCreate ****/
+
+
+/************************************************************************************//**
+** \brief     Releases a Modbus gateway object, previously created with
+**            TbxMbGatewayCreate(). The RTU transport layers of its buses are no longer
+**            linked afterwards. Requests that were still in progress are dropped.
+** \param     gateway Handle to the Modbus gateway object to release.
+**
+****************************************************************************************/
+void TbxMbGatewayFree(tTbxMbGateway gateway)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(gateway != NULL);
+
+  /* Only continue with valid parameters. */
+  if (gateway != NULL)
+  {
+    /* Convert the gateway pointer to the context structure. */
+    tTbxMbGatewayCtx * gatewayCtx = (tTbxMbGatewayCtx *)gateway;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(gatewayCtx->type == TBX_MB_GATEWAY_CONTEXT_TYPE);
+    /* Release the buses. */
+    for (uint8_t busIdx = 0U; busIdx < TBX_MB_GATEWAY_BUS_MAX; busIdx++)
+    {
+      TbxCriticalSectionEnter();
+      tTbxMbGatewayBus * bus = gatewayCtx->bus[busIdx];
+      gatewayCtx->bus[busIdx] = NULL;
+      TbxCriticalSectionExit();
+      if (bus != NULL)
+      {
+        /* Remove crosslink between the bus and the transport layer. */
+        TbxCriticalSectionEnter();
+        bus->tpCtx->channelCtx = NULL;
+        bus->tpCtx = NULL;
+        bus->tcpCtx = NULL;
+        /* Invalidate the context to protect it from accidentally being used
+         * afterwards.
+         */
+        bus->type = 0U;
+        bus->pollFcn = NULL;
+        bus->processFcn = NULL;
+        TbxCriticalSectionExit();
+        /* Remove the bus context from the poller array of its event task right away,
+         * such that its poll function is no longer called after releasing it.
+         */
+        TbxMbEventPollerRelease(bus);
+        /* Give the bus context back to the memory pool. */
+        TbxMemPoolRelease(bus);
+      }
+    }
+    /* Remove crosslink between the gateway and the transport layer. */
+    TbxCriticalSectionEnter();
+    gatewayCtx->tpCtx->channelCtx = NULL;
+    gatewayCtx->tpCtx = NULL;
+    /* Invalidate the context to protect it from accidentally being used afterwards. */
+    gatewayCtx->type = 0U;
+    gatewayCtx->pollFcn = NULL;
+    gatewayCtx->processFcn = NULL;
+    TbxCriticalSectionExit();
+    /* Remove the context from the poller array of its event task right away, such
+     * that its poll function is no longer called after releasing it.
+     */
+    TbxMbEventPollerRelease(gatewayCtx);
+    /* Give the gateway context back to the memory pool. */
+    TbxMemPoolRelease(gatewayCtx);
+  }
+} /*** end of TbxMbGatewayFree ***/
+
+
+/************************************************************************************//**
+** \brief     Adds a Modbus RTU bus to the gateway. The gateway forwards requests with a
+**            unit identifier in the range nodeMin..nodeMax to this bus. Each bus has
+**            its own request queue, so a slow server on one bus does not hold up the
+**            requests for the other buses.
+** \param     gateway Handle to the Modbus gateway object.
+** \param     transport Handle to a previously created Modbus RTU transport layer object,
+**            to assign to the bus. Its node address parameter is don't care.
+** \param     nodeMin First node address of the servers on this bus.
+** \param     nodeMax Last node address of the servers on this bus. The node address
+**            range cannot overlap with the one of another bus.
+** \param     responseTimeout Maximum time in milliseconds to wait for a response from
+**            a server on this bus, after sending a request. When it expires, the gateway
+**            responds with exception code 11 - Gateway target device failed to respond.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbGatewayAddBus(tTbxMbGateway gateway,
+                           tTbxMbTp      transport,
+                           uint8_t       nodeMin,
+                           uint8_t       nodeMax,
+                           uint16_t      responseTimeout)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify parameters. */
+  TBX_ASSERT((gateway != NULL) && (transport != NULL) &&
+             (nodeMin >= TBX_MB_TP_NODE_ADDR_MIN) &&
+             (nodeMax <= TBX_MB_TP_NODE_ADDR_MAX) &&
+             (nodeMin <= nodeMax) && (responseTimeout > 0U));
+
+  /* Only continue with valid parameters. */
+  if ((gateway != NULL) && (transport != NULL) &&
+      (nodeMin >= TBX_MB_TP_NODE_ADDR_MIN) && (nodeMax <= TBX_MB_TP_NODE_ADDR_MAX) &&
+      (nodeMin <= nodeMax) && (responseTimeout > 0U))
+  {
+    /* Convert the gateway pointer to the context structure. */
+    tTbxMbGatewayCtx * gatewayCtx = (tTbxMbGatewayCtx *)gateway;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(gatewayCtx->type == TBX_MB_GATEWAY_CONTEXT_TYPE);
+    /* Locate a free bus slot and make sure the node address range does not overlap
+     * with the one of an already added bus.
+     */
+    uint8_t freeIdx = TBX_MB_GATEWAY_BUS_MAX;
+    uint8_t overlap = TBX_FALSE;
+    TbxCriticalSectionEnter();
+    for (uint8_t busIdx = 0U; busIdx < TBX_MB_GATEWAY_BUS_MAX; busIdx++)
+    {
+      tTbxMbGatewayBus const * bus = gatewayCtx->bus[busIdx];
+      if (bus == NULL)
+      {
+        if (freeIdx == TBX_MB_GATEWAY_BUS_MAX)
+        {
+          freeIdx = busIdx;
+        }
+      }
+      else if ((nodeMin <= bus->nodeMax) && (nodeMax >= bus->nodeMin))
+      {
+        overlap = TBX_TRUE;
+      }
+      else
+      {
+        /* Bus slot in use, yet for another node address range. */
+      }
+    }
+    TbxCriticalSectionExit();
+    /* Verify that there is space for another bus. If this assertion fails, increase the
+     * number of buses using configuration macro TBX_MB_GATEWAY_BUS_MAX.
+     */
+    TBX_ASSERT((freeIdx < TBX_MB_GATEWAY_BUS_MAX) && (overlap == TBX_FALSE));
+    /* Only continue with a free bus slot and a unique node address range. */
+    if ((freeIdx < TBX_MB_GATEWAY_BUS_MAX) && (overlap == TBX_FALSE))
+    {
+      /* Allocate memory for the new bus context. */
+      tTbxMbGatewayBus * newBus = TbxMemPoolAllocate(sizeof(tTbxMbGatewayBus));
+      /* Automatically increase the memory pool, if it was too small. */
+      if (newBus == NULL)
+      {
+        /* No need to check the return value, because if it failed, the following
+         * allocation fails too, which is verified later on.
+         */
+        (void)TbxMemPoolCreate(1U, sizeof(tTbxMbGatewayBus));
+        newBus = TbxMemPoolAllocate(sizeof(tTbxMbGatewayBus));
+      }
+      /* Verify memory allocation of the bus context. */
+      TBX_ASSERT(newBus != NULL);
+      /* Only continue if the memory allocation succeeded. */
+      if (newBus != NULL)
+      {
+        /* Convert the TP channel pointer to the context structure. */
+        tTbxMbTpCtx * tpCtx = (tTbxMbTpCtx *)transport;
+        /* Sanity check on the transport layer's interface function. Also check that
+         * it's not already linked to another channel.
+         */
+        TBX_ASSERT((tpCtx->transmitFcn != NULL) && (tpCtx->receptionDoneFcn != NULL) &&
+                   (tpCtx->getRxPacketFcn != NULL) && (tpCtx->getTxPacketFcn != NULL) &&
+                   (tpCtx->channelCtx == NULL));
+        /* The bus acts as a client, so it cannot work with a compact transport layer
+         * that shares one packet buffer for reception and transmission.
+         */
+        TBX_ASSERT(tpCtx->rxPacket != tpCtx->txPacket);
+        /* The gateway relays between its own transport layer and the one of the bus.
+         * Both should therefore be assigned to the same event task.
+         */
+        TBX_ASSERT(tpCtx->pollInfo.task == gatewayCtx->pollInfo.task);
+        /* Initialize the bus context. Start by crosslinking the transport layer. The
+         * bus is a client channel for it.
+         */
+        newBus->type = TBX_MB_GATEWAY_BUS_CONTEXT_TYPE;
+        newBus->instancePtr = NULL;
+        newBus->pollFcn = TbxMbGatewayBusPoll;
+        newBus->processFcn = TbxMbGatewayBusProcessEvent;
+        newBus->pollInfo.count = 0U;
+        newBus->pollInfo.task = gatewayCtx->pollInfo.task;
+        newBus->tcpCtx = gatewayCtx->tpCtx;
+        newBus->nodeMin = nodeMin;
+        newBus->nodeMax = nodeMax;
+        newBus->responseTimeout = responseTimeout;
+        newBus->busy = TBX_FALSE;
+        newBus->reqCode = 0U;
+        newBus->waitMs = 0U;
+        newBus->msTime = 0U;
+#if (TBX_MB_GATEWAY_QUEUE_SIZE > 0U)
+        newBus->queueIdx = 0U;
+        newBus->queueCount = 0U;
+#endif
+        newBus->tpCtx = tpCtx;
+        newBus->tpCtx->channelCtx = newBus;
+        newBus->tpCtx->isClient = TBX_TRUE;
+        /* Add the bus to the gateway, which makes it the route for its node address
+         * range.
+         */
+        TbxCriticalSectionEnter();
+        gatewayCtx->bus[freeIdx] = newBus;
+        TbxCriticalSectionExit();
+        /* Update the result. */
+        result = TBX_OK;
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbGatewayAddBus ***/
+
+
+/************************************************************************************//**
+** \brief     Event processing function that is automatically called when an event for
+**            this gateway object was received in TbxMbEventTask(). These are the events
+**            of the TCP transport layer.
+** \param     event Pointer to the event to process. Note that the event->context points
+**            to the handle of the Modbus gateway object.
+**
+****************************************************************************************/
+static void TbxMbGatewayProcessEvent(tTbxMbEvent * event)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(event != NULL);
+
+  /* Only continue with valid parameters. */
+  if (event != NULL)
+  {
+    /* Sanity check the context. */
+    TBX_ASSERT(event->context != NULL);
+    /* Convert the event context to the gateway context structure. */
+    tTbxMbGatewayCtx * gatewayCtx = (tTbxMbGatewayCtx *)event->context;
+    /* Make sure the context is valid. */
+    TBX_ASSERT(gatewayCtx != NULL);
+    /* Only continue with a valid context. */
+    if (gatewayCtx != NULL)
+    {
+      /* Sanity check on the context type. */
+      TBX_ASSERT(gatewayCtx->type == TBX_MB_GATEWAY_CONTEXT_TYPE);
+      /* Filter on the event identifier. */
+      switch (event->id)
+      {
+        case TBX_MB_EVENT_ID_PDU_RECEIVED:
+        {
+          uint8_t          excpCode = 0U;
+          uint8_t          reqCode  = 0U;
+          tTbxMbTcpReplyTo replyTo;
+          /* Obtain read access to the newly received packet and the information for
+           * responding to it later on.
+           */
+          tTbxMbTpCtx    * tcpCtx    = gatewayCtx->tpCtx;
+          tTbxMbTpPacket * rxPacket  = tcpCtx->getRxPacketFcn(tcpCtx);
+          uint8_t          replyToOk = TbxMbTcpGetReplyTo(tcpCtx, &replyTo);
+          /* Since we're requested to process a newly received PDU, these should always
+           * succeed. Sanity check anyways, just in case.
+           */
+          TBX_ASSERT((rxPacket != NULL) && (replyToOk == TBX_OK));
+          /* Only continue with packet access. */
+          if ((rxPacket != NULL) && (replyToOk == TBX_OK))
+          {
+            reqCode = rxPacket->pdu.code;
+            /* Locate the bus with the servers for this unit identifier. Broadcast
+             * requests are not forwarded, because the TCP client could not tell if
+             * they actually reached the bus.
+             */
+            tTbxMbGatewayBus * bus = NULL;
+            if (rxPacket->node != TBX_MB_TP_NODE_ADDR_BROADCAST)
+            {
+              TbxCriticalSectionEnter();
+              for (uint8_t busIdx = 0U; busIdx < TBX_MB_GATEWAY_BUS_MAX; busIdx++)
+              {
+                tTbxMbGatewayBus * listBus = gatewayCtx->bus[busIdx];
+                if ((listBus != NULL) && (rxPacket->node >= listBus->nodeMin) &&
+                    (rxPacket->node <= listBus->nodeMax))
+                {
+                  bus = listBus;
+                  break;
+                }
+              }
+              TbxCriticalSectionExit();
+            }
+            /* No route to the server? */
+            if (bus == NULL)
+            {
+              excpCode = TBX_MB_EC0A_GATEWAY_PATH_UNAVAILABLE;
+            }
+            /* Bus ready for the next request? */
+            else if (bus->busy == TBX_FALSE)
+            {
+              /* Forward the request to the bus right away. */
+              if (TbxMbGatewayBusStart(bus, &replyTo, &rxPacket->pdu.code,
+                                       rxPacket->dataLen + 1U) != TBX_OK)
+              {
+                excpCode = TBX_MB_EC0B_GATEWAY_TARGET_FAILED;
+              }
+            }
+            /* Bus still waits for the response to another request. */
+            else
+            {
+#if (TBX_MB_GATEWAY_QUEUE_SIZE > 0U)
+              /* Add the request to the end of the bus's queue, if there is still space
+               * in the queue.
+               */
+              if (bus->queueCount < TBX_MB_GATEWAY_QUEUE_SIZE)
+              {
+                uint16_t queueIdx = ((uint16_t)bus->queueIdx + bus->queueCount) %
+                                    TBX_MB_GATEWAY_QUEUE_SIZE;
+                tTbxMbGatewayReq * req = &bus->queue[queueIdx];
+                req->replyTo = replyTo;
+                req->pduLen = rxPacket->dataLen + 1U;
+                req->pdu[0] = rxPacket->pdu.code;
+                for (uint8_t idx = 0U; idx < rxPacket->dataLen; idx++)
+                {
+                  req->pdu[idx + 1U] = rxPacket->pdu.data[idx];
+                }
+                bus->queueCount++;
+              }
+              else
+#endif
+              {
+                excpCode = TBX_MB_EC06_SERVER_DEVICE_BUSY;
+              }
+            }
+          }
+          /* Inform the transport layer that were done with the rx packet and no longer
+           * need access to it. It can then process requests of other connections, while
+           * the buses handle the forwarded ones.
+           */
+          tcpCtx->receptionDoneFcn(tcpCtx);
+          /* Respond with an exception, if the request could not be forwarded. Note that
+           * this should only be done after calling receptionDoneFcn().
+           */
+          if (excpCode != 0U)
+          {
+            TbxMbGatewayExcpReply(tcpCtx, &replyTo, reqCode, excpCode);
+          }
+        }
+        break;
+
+        case TBX_MB_EVENT_ID_PDU_TRANSMITTED:
+        {
+          /* At this point no additional event handling is needed on the gateway upon
+           * PDU transmission completion.
+           */
+        }
+        break;
+
+        default:
+        {
+          /* An unsupported event was dispatched to us. Should not happen. */
+          TBX_ASSERT(TBX_FALSE);
+        }
+        break;
+      }
+    }
+  }
+} /*** end of TbxMbGatewayProcessEvent ***/
+
+
+/************************************************************************************//**
+** \brief     Event processing function that is automatically called when an event for
+**            a bus of this gateway object was received in TbxMbEventTask(). These are
+**            the events of the bus's RTU transport layer.
+** \param     event Pointer to the event to process. Note that the event->context points
+**            to the bus context.
+**
+****************************************************************************************/
+static void TbxMbGatewayBusProcessEvent(tTbxMbEvent * event)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(event != NULL);
+
+  /* Only continue with valid parameters. */
+  if (event != NULL)
+  {
+    /* Sanity check the context. */
+    TBX_ASSERT(event->context != NULL);
+    /* Convert the event context to the bus context structure. */
+    tTbxMbGatewayBus * bus = (tTbxMbGatewayBus *)event->context;
+    /* Make sure the context is valid. */
+    TBX_ASSERT(bus != NULL);
+    /* Only continue with a valid context. */
+    if (bus != NULL)
+    {
+      /* Sanity check on the context type. */
+      TBX_ASSERT(bus->type == TBX_MB_GATEWAY_BUS_CONTEXT_TYPE);
+      /* Filter on the event identifier. */
+      switch (event->id)
+      {
+        case TBX_MB_EVENT_ID_PDU_RECEIVED:
+        {
+          uint8_t forwarded = TBX_FALSE;
+          /* Obtain read access to the newly received packet. */
+          tTbxMbTpPacket * rxPacket = bus->tpCtx->getRxPacketFcn(bus->tpCtx);
+          /* Only continue with packet access. */
+          if (rxPacket != NULL)
+          {
+            /* Is this the response to the request in progress? */
+            if ((bus->busy == TBX_TRUE) && (rxPacket->node == bus->replyTo.node))
+            {
+              /* Forward the response PDU as is, to the TCP client. */
+              tTbxMbTpPacket * txPacket = bus->tcpCtx->getTxPacketFcn(bus->tcpCtx);
+              if (txPacket != NULL)
+              {
+                txPacket->pdu.code = rxPacket->pdu.code;
+                txPacket->dataLen = rxPacket->dataLen;
+                for (uint8_t idx = 0U; idx < rxPacket->dataLen; idx++)
+                {
+                  txPacket->pdu.data[idx] = rxPacket->pdu.data[idx];
+                }
+                forwarded = TBX_TRUE;
+              }
+            }
+          }
+          /* Inform the transport layer that were done with the rx packet and no longer
+           * need access to it.
+           */
+          bus->tpCtx->receptionDoneFcn(bus->tpCtx);
+          /* Complete the request in progress, if this was its response. */
+          if (forwarded == TBX_TRUE)
+          {
+            (void)TbxMbTcpTransmitReply(bus->tcpCtx, &bus->replyTo);
+            TbxMbGatewayBusNext(bus);
+          }
+        }
+        break;
+
+        case TBX_MB_EVENT_ID_PDU_TRANSMITTED:
+        {
+          /* Transmission of the request completed. Restart the wait timer for the
+           * response reception.
+           */
+          if (bus->busy == TBX_TRUE)
+          {
+            bus->waitMs = bus->responseTimeout;
+            bus->msTime = TbxMbPortTimerCount();
+          }
+        }
+        break;
+
+        default:
+        {
+          /* An unsupported event was dispatched to us. Should not happen. */
+          TBX_ASSERT(TBX_FALSE);
+        }
+        break;
+      }
+    }
+  }
+} /*** end of TbxMbGatewayBusProcessEvent ***/
+
+
+/************************************************************************************//**
+** \brief     Event polling function that is automatically called during each call of
+**            TbxMbEventTask(), if activated. Use the TBX_MB_EVENT_ID_START_POLLING and
+**            TBX_MB_EVENT_ID_STOP_POLLING events to activate and deactivate. Activated
+**            while a request is in progress on the bus, to detect its timeout.
+** \param     context Pointer to the bus context.
+**
+****************************************************************************************/
+static void TbxMbGatewayBusPoll(void * context)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(context != NULL);
+
+  /* Only continue with valid parameters. */
+  if (context != NULL)
+  {
+    /* Convert the context pointer to the bus context structure. */
+    tTbxMbGatewayBus * bus = (tTbxMbGatewayBus *)context;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(bus->type == TBX_MB_GATEWAY_BUS_CONTEXT_TYPE);
+    /* Only continue if a request is in progress. */
+    if (bus->busy == TBX_TRUE)
+    {
+      /* Get the number of ticks that elapsed since the last millisecond detection. Note
+       * that this calculation works, even if the 20 kHz timer counter overflowed.
+       */
+      uint16_t deltaTicks = TbxMbPortTimerCount() - bus->msTime;
+      /* Determine how many milliseconds passed since the last one was detected. */
+      uint16_t deltaMs = deltaTicks / 20U;
+      /* Did one or more milliseconds pass? */
+      if (deltaMs > 0U)
+      {
+        /* Update the last millisecond detection tick time. Needed for the detection of
+         * the next millisecond. Note that this calculation works, even if the msTime
+         * element overflows.
+         */
+        bus->msTime += (deltaMs * 20U);
+        /* Subtract the elapsed milliseconds from the remaining wait time, with
+         * underflow protection.
+         */
+        if (bus->waitMs > deltaMs)
+        {
+          bus->waitMs -= deltaMs;
+        }
+        else
+        {
+          bus->waitMs = 0U;
+        }
+        /* Wait time passed? */
+        if (bus->waitMs == 0U)
+        {
+          /* The server did not respond in time. Inform the TCP client and continue
+           * with the next request.
+           */
+          TbxMbGatewayExcpReply(bus->tcpCtx, &bus->replyTo, bus->reqCode,
+                                TBX_MB_EC0B_GATEWAY_TARGET_FAILED);
+          TbxMbGatewayBusNext(bus);
+        }
+      }
+    }
+  }
+} /*** end of TbxMbGatewayBusPoll ***/
+
+
+/************************************************************************************//**
+** \brief     Helper function to forward a request to the bus. It copies the request PDU
+**            as is, into the RTU transport layer's transmit packet and starts its
+**            transmission. The bus should not have another request in progress.
+** \param     bus Pointer to the bus context.
+** \param     replyTo Pointer to the reply information of the request.
+** \param     pdu Pointer to the request PDU, starting with the function code.
+** \param     pduLen Length of the request PDU.
+** \return    TBX_OK if the request transmission started, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbGatewayBusStart(tTbxMbGatewayBus       * bus,
+                                    tTbxMbTcpReplyTo const * replyTo,
+                                    uint8_t          const * pdu,
+                                    uint8_t                  pduLen)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* A response to an earlier request that timed out, might have come in after all. In
+   * this case the transport layer still holds on to it. Release it, because it would
+   * otherwise block the transmission of this request.
+   */
+  if (bus->tpCtx->getRxPacketFcn(bus->tpCtx) != NULL)
+  {
+    bus->tpCtx->receptionDoneFcn(bus->tpCtx);
+  }
+  /* Obtain write access to the transmit packet. */
+  tTbxMbTpPacket * txPacket = bus->tpCtx->getTxPacketFcn(bus->tpCtx);
+  /* Only continue with packet access and a valid PDU length. */
+  if ((txPacket != NULL) && (pduLen > 0U))
+  {
+    /* Copy the request PDU as is. The RTU transport layer adds the node address and
+     * the CRC16 around it.
+     */
+    txPacket->node = replyTo->node;
+    txPacket->pdu.code = pdu[0];
+    txPacket->dataLen = pduLen - 1U;
+    for (uint8_t idx = 0U; idx < txPacket->dataLen; idx++)
+    {
+      txPacket->pdu.data[idx] = pdu[idx + 1U];
+    }
+    /* Store the information needed for processing the request's response. */
+    bus->replyTo = *replyTo;
+    bus->reqCode = pdu[0];
+    bus->busy = TBX_TRUE;
+    /* Start the wait timer for the request packet transmit completion. The response
+     * timeout can be re-used for this because a packet transmission won't take longer
+     * than a packet reception, since it uses the same communication interface.
+     */
+    bus->waitMs = bus->responseTimeout;
+    bus->msTime = TbxMbPortTimerCount();
+    /* Instruct the event task to start calling our polling function, for detecting
+     * a timeout.
+     */
+    tTbxMbEvent newEvent;
+    newEvent.context = bus;
+    newEvent.id = TBX_MB_EVENT_ID_START_POLLING;
+    TbxMbOsalEventPost(&newEvent, TBX_FALSE);
+    /* Request the transport layer to transmit the request packet and update the
+     * result accordingly.
+     */
+    result = bus->tpCtx->transmitFcn(bus->tpCtx);
+    /* Release the bus again, if the transmission could not be started. */
+    if (result != TBX_OK)
+    {
+      bus->busy = TBX_FALSE;
+      newEvent.id = TBX_MB_EVENT_ID_STOP_POLLING;
+      TbxMbOsalEventPost(&newEvent, TBX_FALSE);
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbGatewayBusStart ***/
+
+
+/************************************************************************************//**
+** \brief     Helper function to complete the request in progress on the bus and to
+**            continue with the next queued request, if any.
+** \param     bus Pointer to the bus context.
+**
+****************************************************************************************/
+static void TbxMbGatewayBusNext(tTbxMbGatewayBus * bus)
+{
+  /* Release the bus and instruct the event task to stop calling our polling function.
+   * Starting the next request activates it again.
+   */
+  bus->busy = TBX_FALSE;
+  tTbxMbEvent newEvent;
+  newEvent.context = bus;
+  newEvent.id = TBX_MB_EVENT_ID_STOP_POLLING;
+  TbxMbOsalEventPost(&newEvent, TBX_FALSE);
+#if (TBX_MB_GATEWAY_QUEUE_SIZE > 0U)
+  /* Start the next queued request right away. This keeps the time that the bus sits
+   * idle between requests as short as possible. Continue with the one after it, in
+   * case it could not be started.
+   */
+  while ((bus->busy == TBX_FALSE) && (bus->queueCount > 0U))
+  {
+    /* Take the request from the front of the queue. */
+    tTbxMbGatewayReq const * req = &bus->queue[bus->queueIdx];
+    bus->queueIdx = (uint8_t)(((uint16_t)bus->queueIdx + 1U) % TBX_MB_GATEWAY_QUEUE_SIZE);
+    bus->queueCount--;
+    /* Start it or inform the TCP client, if this failed. Note that the queue entry
+     * stays valid, because only the event task adds requests to the queue.
+     */
+    if (TbxMbGatewayBusStart(bus, &req->replyTo, req->pdu, req->pduLen) != TBX_OK)
+    {
+      TbxMbGatewayExcpReply(bus->tcpCtx, &req->replyTo, req->pdu[0],
+                            TBX_MB_EC0B_GATEWAY_TARGET_FAILED);
+    }
+  }
+#endif
+} /*** end of TbxMbGatewayBusNext ***/
+
+
+/************************************************************************************//**
+** \brief     Helper function to respond to a request of a TCP client with an exception.
+** \param     tcpCtx Pointer to the TCP transport layer context.
+** \param     replyTo Pointer to the reply information of the request.
+** \param     code Function code of the request.
+** \param     excpCode Exception code to respond with.
+**
+****************************************************************************************/
+static void TbxMbGatewayExcpReply(tTbxMbTpCtx            * tcpCtx,
+                                  tTbxMbTcpReplyTo const * replyTo,
+                                  uint8_t                  code,
+                                  uint8_t                  excpCode)
+{
+  /* Obtain write access to the transmit packet. */
+  tTbxMbTpPacket * txPacket = tcpCtx->getTxPacketFcn(tcpCtx);
+  /* Only continue with packet access. */
+  if (txPacket != NULL)
+  {
+    /* Prepare the exception response and transmit it. */
+    txPacket->pdu.code = code | TBX_MB_FC_EXCEPTION_MASK;
+    txPacket->pdu.data[0] = excpCode;
+    txPacket->dataLen = 1U;
+    (void)TbxMbTcpTransmitReply(tcpCtx, replyTo);
+  }
+} /*** end of TbxMbGatewayExcpReply ***/
+
+
+/*********************************** end of tbxmb_gateway.c *****************************/
@@ -0,0 +1,140 @@
+/************************************************************************************//**
+* \file         tbxmb_gateway_private.h
+* \brief        Modbus TCP to RTU gateway private header file.
+* \internal
+*----------------------------------------------------------------------------------------
+*                          C O P Y R I G H T
+*----------------------------------------------------------------------------------------
+*   Copyright (c) 2023 by Feaser     www.feaser.com     All rights reserved
+*
+*----------------------------------------------------------------------------------------
+*                            L I C E N S E
+*----------------------------------------------------------------------------------------
+*
+* SPDX-License-Identifier: GPL-3.0-or-later
+*
+* This file is part of MicroTBX-Modbus. MicroTBX-Modbus is free software: you can
+* redistribute it and/or modify it under the terms of the GNU General Public License as
+* published by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* MicroTBX-Modbus is distributed in the hope that it will be useful, but WITHOUT ANY
+* WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+* PARTICULAR PURPOSE. See the GNU General Public License for more details.
+*
+* You have received a copy of the GNU General Public License along with MicroTBX-Modbus.
+* If not, see www.gnu.org/licenses/.
+*
+* \endinternal
+****************************************************************************************/
+#ifndef TBXMB_GATEWAY_PRIVATE_H
+#define TBXMB_GATEWAY_PRIVATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************************
+* Configuration macros
+****************************************************************************************/
+#ifndef TBX_MB_GATEWAY_BUS_MAX
+/** \brief Maximum number of RTU buses that can be added to a gateway. To override this
+ *         default configuration, you can add a macro with the same name, but with a
+ *         different value, to "tbx_conf.h".
+ */
+#define TBX_MB_GATEWAY_BUS_MAX             (4U)
+#endif
+
+
+#ifndef TBX_MB_GATEWAY_QUEUE_SIZE
+/** \brief Configure the maximum number of requests that can be queued per RTU bus,
+ *         while the bus still waits for the response to another request. When the queue
+ *         is full, the gateway responds with exception code 06 - Server device busy. A
+ *         value of 0 disables the queue. You can override this configuration by adding
+ *         a macro with the same name, but a different value, to "tbx_conf.h".
+ */
+#define TBX_MB_GATEWAY_QUEUE_SIZE          (4U)
+#endif
+
+
+/****************************************************************************************
+* Type definitions
+****************************************************************************************/
+/** \brief Modbus gateway interface function to detect events in a polling manner. */
+typedef void (* tTbxMbGatewayPoll)   (void        * context);
+
+
+/** \brief Modbus gateway interface function for processing events. */
+typedef void (* tTbxMbGatewayProcess)(tTbxMbEvent * event);
+
+
+/** \brief Request that waits in the queue of an RTU bus. */
+typedef struct
+{
+  tTbxMbTcpReplyTo     replyTo;                  /**< Where to send the response to.   */
+  uint8_t              pdu[TBX_MB_TP_PDU_MAX_LEN]; /**< Request PDU.                   */
+  uint8_t              pduLen;                   /**< Request PDU length.              */
+} tTbxMbGatewayReq;
+
+
+/** \brief Modbus gateway RTU bus context. The gateway forwards requests for the bus's
+ *         node address range to the RTU transport layer. For this transport layer, the
+ *         bus context is the linked client channel.
+ */
+typedef struct
+{
+  /* Event interface methods. The following four entries must always be at the start
+   * and exactly match those in tTbxMbEventCtx. Think of it as the base that this struct
+   * derives from.
+   */
+  void               * instancePtr;              /**< Reserved for C++ wrapper.        */
+  tTbxMbGatewayPoll    pollFcn;                  /**< Event poll function.             */
+  tTbxMbGatewayProcess processFcn;               /**< Event process function.          */
+  tTbxMbEventPoller    pollInfo;                 /**< Event poller information.        */
+  /* Private members. */
+  uint8_t              type;                     /**< Context type.                    */
+  tTbxMbTpCtx        * tpCtx;                    /**< RTU transport layer context.     */
+  tTbxMbTpCtx        * tcpCtx;                   /**< TCP transport layer context.     */
+  uint8_t              nodeMin;                  /**< First node address on the bus.   */
+  uint8_t              nodeMax;                  /**< Last node address on the bus.    */
+  uint16_t             responseTimeout;          /**< Max response wait time (ms).     */
+  uint8_t              busy;                     /**< Request in progress flag.        */
+  tTbxMbTcpReplyTo     replyTo;                  /**< Reply info of the request.       */
+  uint8_t              reqCode;                  /**< Function code of the request.    */
+  uint16_t             waitMs;                   /**< Remaining response wait time.    */
+  uint16_t             msTime;                   /**< Last millisecond tick time.      */
+#if (TBX_MB_GATEWAY_QUEUE_SIZE > 0U)
+  tTbxMbGatewayReq     queue[TBX_MB_GATEWAY_QUEUE_SIZE]; /**< Request queue.           */
+  uint8_t              queueIdx;                 /**< Index of the oldest request.     */
+  uint8_t              queueCount;               /**< Number of queued requests.       */
+#endif
+} tTbxMbGatewayBus;
+
+
+/** \brief Modbus gateway context that groups all its specific data. It's what the
+ *         tTbxMbGateway opaque pointer points to. For the TCP transport layer, the
+ *         gateway context is the linked server channel.
+ */
+typedef struct
+{
+  /* Event interface methods. The following four entries must always be at the start
+   * and exactly match those in tTbxMbEventCtx. Think of it as the base that this struct
+   * derives from.
+   */
+  void               * instancePtr;              /**< Reserved for C++ wrapper.        */
+  tTbxMbGatewayPoll    pollFcn;                  /**< Event poll function.             */
+  tTbxMbGatewayProcess processFcn;               /**< Event process function.          */
+  tTbxMbEventPoller    pollInfo;                 /**< Event poller information.        */
+  /* Private members. */
+  uint8_t              type;                     /**< Context type.                    */
+  tTbxMbTpCtx        * tpCtx;                    /**< TCP transport layer context.     */
+  tTbxMbGatewayBus   * bus[TBX_MB_GATEWAY_BUS_MAX]; /**< RTU buses.                    */
+} tTbxMbGatewayCtx;
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TBXMB_GATEWAY_PRIVATE_H */
+/*********************************** end of tbxmb_gateway_private.h *********************/
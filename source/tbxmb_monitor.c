@@ -0,0 +1,418 @@
+/************************************************************************************//**
+* \file         tbxmb_monitor.c
+* \brief        Modbus RTU bus monitor source file.
+* \internal
+*----------------------------------------------------------------------------------------
+*                          C O P Y R I G H T
+*----------------------------------------------------------------------------------------
+*   Copyright (c) 2023 by Feaser     www.feaser.com     All rights reserved
+*
+*----------------------------------------------------------------------------------------
+*                            L I C E N S E
+*----------------------------------------------------------------------------------------
+*
+* SPDX-License-Identifier: GPL-3.0-or-later
+*
+* This file is part of MicroTBX-Modbus. MicroTBX-Modbus is free software: you can
+* redistribute it and/or modify it under the terms of the GNU General Public License as
+* published by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* MicroTBX-Modbus is distributed in the hope that it will be useful, but WITHOUT ANY
+* WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+* PARTICULAR PURPOSE. See the GNU General Public License for more details.
+*
+* You have received a copy of the GNU General Public License along with MicroTBX-Modbus.
+* If not, see www.gnu.org/licenses/.
+*
+* \endinternal
+****************************************************************************************/
+
+/****************************************************************************************
+* Include files
+****************************************************************************************/
+#include "microtbx.h"                            /* MicroTBX module                    */
+#include "microtbxmodbus.h"                      /* MicroTBX-Modbus module             */
+#include "tbxmb_event_private.h"                 /* MicroTBX-Modbus event private      */
+#include "tbxmb_osal_private.h"                  /* MicroTBX-Modbus OSAL private       */
+#include "tbxmb_tp_private.h"                    /* MicroTBX-Modbus TP private         */
+#include "tbxmb_monitor_private.h"               /* MicroTBX-Modbus monitor private    */
+
+
+/****************************************************************************************
+* Macro definitions
+****************************************************************************************/
+/** \brief Unique context type to identify a context as being a bus monitor object. */
+#define TBX_MB_MONITOR_CONTEXT_TYPE    (91U)
+
+/** \brief Duration of one 50 us timer tick in microseconds. */
+#define TBX_MB_MONITOR_TICK_US         (50U)
+
+
+/****************************************************************************************
+* Configuration check
+****************************************************************************************/
+#if ((TBX_MB_MONITOR_BUF_SIZE < 1U) || (TBX_MB_MONITOR_BUF_SIZE > 255U))
+#error "TBX_MB_MONITOR_BUF_SIZE must be in the range 1..255"
+#endif
+
+
+/****************************************************************************************
+* Function prototypes
+****************************************************************************************/
+static void TbxMbMonitorPoll        (tTbxMbMonitor            monitor);
+
+static void TbxMbMonitorProcessEvent(tTbxMbEvent            * event);
+
+static void TbxMbMonitorTimeUpdate  (tTbxMbMonitorCtx       * monitorCtx);
+
+static void TbxMbMonitorStore       (tTbxMbMonitorCtx       * monitorCtx,
+                                     tTbxMbTpPacket   const * rxPacket);
+
+
+/************************************************************************************//**
+** \brief     Creates a passive Modbus RTU bus monitor object. It receives all frames on
+**            the bus, regardless of their node address, and never transmits. It decodes
+**            the frames into requests and their responses and passes them on to the
+**            callback function, together with their timestamps.
+** \details   Received frames are first stored in a ring buffer. This releases the
+**            transport layer right away, such that it's ready for the next frame. The
+**            callback function is called from the event task. Frames that no longer
+**            fit in the ring buffer are dropped.
+** \param     transport Handle to a previously created RTU transport layer object. It
+**            should not be linked to a server or client channel.
+** \param     callback Pointer to the callback function for processing the frames.
+** \return    Handle to the newly created Modbus RTU bus monitor object if successful,
+**            NULL otherwise.
+**
+****************************************************************************************/
+tTbxMbMonitor TbxMbMonitorCreate(tTbxMbTp              transport,
+                                 tTbxMbMonitorCallback callback)
+{
+  tTbxMbMonitor result = NULL;
+
+  /* Verify parameters. */
+  TBX_ASSERT((transport != NULL) && (callback != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((transport != NULL) && (callback != NULL))
+  {
+    /* Allocate memory for the new bus monitor context. */
+    tTbxMbMonitorCtx * newMonitorCtx = TbxMemPoolAllocate(sizeof(tTbxMbMonitorCtx));
+    /* Automatically increase the memory pool, if it was too small. */
+    if (newMonitorCtx == NULL)
+    {
+      /* No need to check the return value, because if it failed, the following
+       * allocation fails too, which is verified later on.
+       */
+      (void)TbxMemPoolCreate(1U, sizeof(tTbxMbMonitorCtx));
+      newMonitorCtx = TbxMemPoolAllocate(sizeof(tTbxMbMonitorCtx));
+    }
+    /* Verify memory allocation of the bus monitor context. */
+    TBX_ASSERT(newMonitorCtx != NULL);
+    /* Only continue if the memory allocation succeeded. */
+    if (newMonitorCtx != NULL)
+    {
+      /* Convert the TP channel pointer to the context structure. */
+      tTbxMbTpCtx * tpCtx = (tTbxMbTpCtx *)transport;
+      /* Sanity check on the transport layer's interface function. That way there is 
+       * no need to do it later on, making it more run-time efficient. Also check that
+       * it's not already linked to another channel.
+       */
+      TBX_ASSERT((tpCtx->receptionDoneFcn != NULL) && (tpCtx->getRxPacketFcn != NULL) &&
+                 (tpCtx->channelCtx == NULL));
+      /* Initialize the bus monitor context. */
+      newMonitorCtx->type = TBX_MB_MONITOR_CONTEXT_TYPE;
+      newMonitorCtx->instancePtr = NULL;
+      newMonitorCtx->pollFcn = TbxMbMonitorPoll;
+      newMonitorCtx->processFcn = TbxMbMonitorProcessEvent;
+      newMonitorCtx->pollInfo.count = 0U;
+      newMonitorCtx->pollInfo.task = tpCtx->pollInfo.task;
+      newMonitorCtx->callback = callback;
+      newMonitorCtx->timeTicks = 0U;
+      newMonitorCtx->timeCount = TbxMbPortTimerCount();
+      newMonitorCtx->reqPending = TBX_FALSE;
+      newMonitorCtx->bufHead = 0U;
+      newMonitorCtx->bufCount = 0U;
+      newMonitorCtx->dropped = 0U;
+      /* Crosslink the transport layer and switch it to passive bus monitoring. */
+      newMonitorCtx->tpCtx = tpCtx;
+      TbxCriticalSectionEnter();
+      newMonitorCtx->tpCtx->isClient = TBX_FALSE;
+      newMonitorCtx->tpCtx->isMonitor = TBX_TRUE;
+      newMonitorCtx->tpCtx->channelCtx = newMonitorCtx;
+      TbxCriticalSectionExit();
+      /* Instruct the event task to start calling our polling function. */
+      tTbxMbEvent newEvent;
+      newEvent.context = newMonitorCtx;
+      newEvent.id = TBX_MB_EVENT_ID_START_POLLING;
+      TbxMbOsalEventPost(&newEvent, TBX_FALSE);
+      /* Update the result. */
+      result = newMonitorCtx;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbMonitorCreate ****/
+
+
+/************************************************************************************//**
+** \brief     Releases a Modbus RTU bus monitor object, previously created with
+**            TbxMbMonitorCreate(). Frames still in the ring buffer are discarded.
+** \param     monitor Handle to the Modbus RTU bus monitor object to release.
+**
+****************************************************************************************/
+void TbxMbMonitorFree(tTbxMbMonitor monitor)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(monitor != NULL);
+
+  /* Only continue with valid parameters. */
+  if (monitor != NULL)
+  {
+    /* Convert the bus monitor pointer to the context structure. */
+    tTbxMbMonitorCtx * monitorCtx = (tTbxMbMonitorCtx *)monitor;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(monitorCtx->type == TBX_MB_MONITOR_CONTEXT_TYPE);
+    /* Remove crosslink between the bus monitor and the transport layer. */
+    TbxCriticalSectionEnter();
+    monitorCtx->tpCtx->isMonitor = TBX_FALSE;
+    monitorCtx->tpCtx->channelCtx = NULL;
+    monitorCtx->tpCtx = NULL;
+    /* Invalidate the context to protect it from accidentally being used afterwards. */
+    monitorCtx->type = 0U;
+    monitorCtx->pollFcn = NULL;
+    monitorCtx->processFcn = NULL;
+    TbxCriticalSectionExit();
+    /* Remove the context from the poller array of its event task right away, such
+     * that its poll function is no longer called after releasing it.
+     */
+    TbxMbEventPollerRelease(monitorCtx);
+    /* Give the bus monitor context back to the memory pool. */
+    TbxMemPoolRelease(monitorCtx);
+  }
+} /*** end of TbxMbMonitorFree ***/
+
+
+/************************************************************************************//**
+** \brief     Obtains the total number of frames that the bus monitor dropped, because
+**            they no longer fit in its ring buffer. If this happens, increase the ring
+**            buffer size with configuration macro TBX_MB_MONITOR_BUF_SIZE or speed up the
+**            callback function.
+** \param     monitor Handle to the Modbus RTU bus monitor object.
+** \return    Total number of dropped frames.
+**
+****************************************************************************************/
+uint32_t TbxMbMonitorGetDropped(tTbxMbMonitor monitor)
+{
+  uint32_t result = 0U;
+
+  /* Verify parameters. */
+  TBX_ASSERT(monitor != NULL);
+
+  /* Only continue with valid parameters. */
+  if (monitor != NULL)
+  {
+    /* Convert the bus monitor pointer to the context structure. */
+    tTbxMbMonitorCtx * monitorCtx = (tTbxMbMonitorCtx *)monitor;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(monitorCtx->type == TBX_MB_MONITOR_CONTEXT_TYPE);
+    /* Read out the number of dropped frames. */
+    TbxCriticalSectionEnter();
+    result = monitorCtx->dropped;
+    TbxCriticalSectionExit();
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbMonitorGetDropped ***/
+
+
+/************************************************************************************//**
+** \brief     Event polling function that is automatically called during each call of
+**            TbxMbEventTask(), if activated. Use the TBX_MB_EVENT_ID_START_POLLING and
+**            TBX_MB_EVENT_ID_STOP_POLLING events to activate and deactivate. It keeps
+**            track of time and passes the buffered frames on to the callback function.
+** \param     monitor Handle to the Modbus RTU bus monitor object.
+**
+****************************************************************************************/
+static void TbxMbMonitorPoll(tTbxMbMonitor monitor)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(monitor != NULL);
+
+  /* Only continue with valid parameters. */
+  if (monitor != NULL)
+  {
+    /* Convert the bus monitor pointer to the context structure. */
+    tTbxMbMonitorCtx * monitorCtx = (tTbxMbMonitorCtx *)monitor;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(monitorCtx->type == TBX_MB_MONITOR_CONTEXT_TYPE);
+    /* Keep the free running 32-bit tick counter up-to-date. */
+    TbxMbMonitorTimeUpdate(monitorCtx);
+    /* Pass all buffered frames on to the callback function, oldest first. Note that
+     * the ring buffer is only accessed from the event task, so no critical sections
+     * are needed.
+     */
+    while (monitorCtx->bufCount > 0U)
+    {
+      tTbxMbMonitorEntry const * entry = &monitorCtx->buf[monitorCtx->bufHead];
+      tTbxMbMonitorFrame         frame;
+      /* Convert the timestamp to microseconds. It intentionally wraps around. Because
+       * 2^32 ticks is a multiple of 2^32 us, it also wraps cleanly when the tick
+       * counter itself does.
+       */
+      frame.timeUs = entry->timeTicks * TBX_MB_MONITOR_TICK_US;
+      frame.responseUs = entry->responseTicks * TBX_MB_MONITOR_TICK_US;
+      frame.type = (tTbxMbMonitorFrameType)entry->type;
+      frame.node = entry->node;
+      frame.code = entry->code;
+      frame.dataLen = entry->dataLen;
+      frame.data = entry->data;
+      monitorCtx->callback(monitorCtx, &frame);
+      /* Remove the frame from the ring buffer. */
+      monitorCtx->bufHead++;
+      if (monitorCtx->bufHead >= TBX_MB_MONITOR_BUF_SIZE)
+      {
+        monitorCtx->bufHead = 0U;
+      }
+      monitorCtx->bufCount--;
+    }
+  }
+} /*** end of TbxMbMonitorPoll ***/
+
+
+/************************************************************************************//**
+** \brief     Event processing function that is automatically called when an event for
+**            this bus monitor object was received in TbxMbEventTask().
+** \param     event Pointer to the event to process. Note that the event->context points
+**            to the handle of the Modbus RTU bus monitor object.
+**
+****************************************************************************************/
+static void TbxMbMonitorProcessEvent(tTbxMbEvent * event)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(event != NULL);
+
+  /* Only continue with valid parameters. */
+  if (event != NULL)
+  {
+    /* Sanity check the context. */
+    TBX_ASSERT(event->context != NULL);
+    /* Convert the event context to the bus monitor context structure. */
+    tTbxMbMonitorCtx * monitorCtx = (tTbxMbMonitorCtx *)event->context;
+    /* Make sure the context is valid. */
+    TBX_ASSERT(monitorCtx != NULL);
+    /* Only continue with a valid context and a newly received frame. */
+    if ((monitorCtx != NULL) && (event->id == TBX_MB_EVENT_ID_PDU_RECEIVED))
+    {
+      /* Sanity check on the context type. */
+      TBX_ASSERT(monitorCtx->type == TBX_MB_MONITOR_CONTEXT_TYPE);
+      /* Obtain read access to the newly received packet. */
+      tTbxMbTpPacket * rxPacket = monitorCtx->tpCtx->getRxPacketFcn(monitorCtx->tpCtx);
+      /* Copy the frame to the ring buffer, if there is access to it. */
+      if (rxPacket != NULL)
+      {
+        TbxMbMonitorStore(monitorCtx, rxPacket);
+      }
+      /* Inform the transport layer that were done with the rx packet and no longer
+       * need access to it. This makes it ready for the next frame right away.
+       */
+      monitorCtx->tpCtx->receptionDoneFcn(monitorCtx->tpCtx);
+    }
+  }
+} /*** end of TbxMbMonitorProcessEvent ***/
+
+
+/************************************************************************************//**
+** \brief     Updates the free running 32-bit tick counter, based on the 16-bit 20 kHz
+**            timer counter. Needs to be called at least once every 3.2 seconds, which
+**            the event task does through the polling function.
+** \param     monitorCtx Pointer to the bus monitor context.
+**
+****************************************************************************************/
+static void TbxMbMonitorTimeUpdate(tTbxMbMonitorCtx * monitorCtx)
+{
+  uint16_t currentCount = TbxMbPortTimerCount();
+
+  /* Note that this calculation works, even if the timer counter overflowed. */
+  monitorCtx->timeTicks += (uint16_t)(currentCount - monitorCtx->timeCount);
+  monitorCtx->timeCount = currentCount;
+} /*** end of TbxMbMonitorTimeUpdate ***/
+
+
+/************************************************************************************//**
+** \brief     Decodes a newly received frame and stores it in the ring buffer. A unicast
+**            frame counts as the response to the pending request, if it comes from the
+**            same node and has the same function code, with or without the exception
+**            bit. Any other unicast frame counts as a new request.
+** \param     monitorCtx Pointer to the bus monitor context.
+** \param     rxPacket Pointer to the received packet.
+**
+****************************************************************************************/
+static void TbxMbMonitorStore(tTbxMbMonitorCtx       * monitorCtx,
+                              tTbxMbTpPacket   const * rxPacket)
+{
+  uint8_t  frameType;
+  uint32_t responseTicks = 0U;
+
+  /* Determine the timestamp of the frame end, based on when its last byte was received.
+   * Note that the transport layer doesn't update it while we have access to the
+   * reception packet.
+   */
+  TbxMbMonitorTimeUpdate(monitorCtx);
+  uint32_t frameTicks = monitorCtx->timeTicks -
+                        (uint16_t)(monitorCtx->timeCount - monitorCtx->tpCtx->rxTime);
+  /* Decode the frame type. */
+  if (rxPacket->node == TBX_MB_TP_NODE_ADDR_BROADCAST)
+  {
+    frameType = (uint8_t)TBX_MB_MONITOR_FRAME_BROADCAST;
+    monitorCtx->reqPending = TBX_FALSE;
+  }
+  else if ((monitorCtx->reqPending == TBX_TRUE) &&
+           (rxPacket->node == monitorCtx->reqNode) &&
+           ((rxPacket->pdu.code & 0x7FU) == monitorCtx->reqCode))
+  {
+    frameType = (uint8_t)TBX_MB_MONITOR_FRAME_RESPONSE;
+    responseTicks = frameTicks - monitorCtx->reqTicks;
+    monitorCtx->reqPending = TBX_FALSE;
+  }
+  else
+  {
+    frameType = (uint8_t)TBX_MB_MONITOR_FRAME_REQUEST;
+    monitorCtx->reqPending = TBX_TRUE;
+    monitorCtx->reqNode = rxPacket->node;
+    monitorCtx->reqCode = rxPacket->pdu.code;
+    monitorCtx->reqTicks = frameTicks;
+  }
+  /* Drop the frame if the ring buffer is full. */
+  if (monitorCtx->bufCount >= TBX_MB_MONITOR_BUF_SIZE)
+  {
+    TbxCriticalSectionEnter();
+    monitorCtx->dropped++;
+    TbxCriticalSectionExit();
+  }
+  /* Store the frame at the end of the ring buffer. */
+  else
+  {
+    uint16_t entryIdx = (uint16_t)monitorCtx->bufHead + monitorCtx->bufCount;
+    if (entryIdx >= TBX_MB_MONITOR_BUF_SIZE)
+    {
+      entryIdx -= TBX_MB_MONITOR_BUF_SIZE;
+    }
+    tTbxMbMonitorEntry * entry = &monitorCtx->buf[entryIdx];
+    entry->timeTicks = frameTicks;
+    entry->responseTicks = responseTicks;
+    entry->type = frameType;
+    entry->node = rxPacket->node;
+    entry->code = rxPacket->pdu.code;
+    entry->dataLen = rxPacket->dataLen;
+    for (uint8_t idx = 0U; idx < rxPacket->dataLen; idx++)
+    {
+      entry->data[idx] = rxPacket->pdu.data[idx];
+    }
+    monitorCtx->bufCount++;
+  }
+} /*** end of TbxMbMonitorStore ***/
+
+
+/*********************************** end of tbxmb_monitor.c *****************************/
@@ -0,0 +1,98 @@
+/************************************************************************************//**
+* \file         tbxmb_monitor.h
+* \brief        Modbus RTU bus monitor header file.
+* \internal
+*----------------------------------------------------------------------------------------
+*                          C O P Y R I G H T
+*----------------------------------------------------------------------------------------
+*   Copyright (c) 2023 by Feaser     www.feaser.com     All rights reserved
+*
+*----------------------------------------------------------------------------------------
+*                            L I C E N S E
+*----------------------------------------------------------------------------------------
+*
+* SPDX-License-Identifier: GPL-3.0-or-later
+*
+* This file is part of MicroTBX-Modbus. MicroTBX-Modbus is free software: you can
+* redistribute it and/or modify it under the terms of the GNU General Public License as
+* published by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* MicroTBX-Modbus is distributed in the hope that it will be useful, but WITHOUT ANY
+* WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+* PARTICULAR PURPOSE. See the GNU General Public License for more details.
+*
+* You have received a copy of the GNU General Public License along with MicroTBX-Modbus.
+* If not, see www.gnu.org/licenses/.
+*
+* \endinternal
+****************************************************************************************/
+#ifndef TBXMB_MONITOR_H
+#define TBXMB_MONITOR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************************
+* Type definitions
+****************************************************************************************/
+/** \brief Handle to a Modbus RTU bus monitor object, in the format of an opaque
+ *         pointer.
+ */
+typedef void * tTbxMbMonitor;
+
+
+/** \brief Enumerated type with the types of frames that the bus monitor decodes. */
+typedef enum
+{
+  /* Request frame from a client to a server. */
+  TBX_MB_MONITOR_FRAME_REQUEST = 0U,
+  /* Response frame from a server to the preceding request. */
+  TBX_MB_MONITOR_FRAME_RESPONSE,
+  /* Broadcast request frame from a client to all servers. */
+  TBX_MB_MONITOR_FRAME_BROADCAST,
+  /* Extra entry to obtain the number of elements. */
+  TBX_MB_MONITOR_NUM_FRAME
+} tTbxMbMonitorFrameType;
+
+
+/** \brief Frame that the bus monitor received and decoded. Note that the timestamp
+ *         is a free running 32-bit microsecond counter, which wraps around every
+ *         2^32 us, so about every 71.6 minutes. Subtracting two timestamps as uint32_t
+ *         still gives the correct time between two frames, up to this period.
+ */
+typedef struct
+{
+  uint32_t               timeUs;                 /**< Frame end timestamp (us), wraps. */
+  uint32_t               responseUs;             /**< Response time (us), if response. */
+  tTbxMbMonitorFrameType type;                   /**< Frame type.                      */
+  uint8_t                node;                   /**< Server node address.             */
+  uint8_t                code;                   /**< Function code.                   */
+  uint8_t                dataLen;                /**< Number of PDU data bytes.        */
+  uint8_t        const * data;                   /**< PDU data bytes.                  */
+} tTbxMbMonitorFrame;
+
+
+/** \brief Modbus RTU bus monitor callback function for processing a received frame. */
+typedef void (* tTbxMbMonitorCallback)(tTbxMbMonitor              monitor,
+                                       tTbxMbMonitorFrame const * frame);
+
+
+/****************************************************************************************
+* Function prototypes
+****************************************************************************************/
+tTbxMbMonitor TbxMbMonitorCreate    (tTbxMbTp               transport,
+                                     tTbxMbMonitorCallback  callback);
+
+void          TbxMbMonitorFree      (tTbxMbMonitor          monitor);
+
+uint32_t      TbxMbMonitorGetDropped(tTbxMbMonitor          monitor);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TBXMB_MONITOR_H */
+/*********************************** end of tbxmb_monitor.h ****************************/
@@ -0,0 +1,111 @@
+/************************************************************************************//**
+* \file         tbxmb_monitor_private.h
+* \brief        Modbus RTU bus monitor private header file.
+* \internal
+*----------------------------------------------------------------------------------------
+*                          C O P Y R I G H T
+*----------------------------------------------------------------------------------------
+*   Copyright (c) 2023 by Feaser     www.feaser.com     All rights reserved
+*
+*----------------------------------------------------------------------------------------
+*                            L I C E N S E
+*----------------------------------------------------------------------------------------
+*
+* SPDX-License-Identifier: GPL-3.0-or-later
+*
+* This file is part of MicroTBX-Modbus. MicroTBX-Modbus is free software: you can
+* redistribute it and/or modify it under the terms of the GNU General Public License as
+* published by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* MicroTBX-Modbus is distributed in the hope that it will be useful, but WITHOUT ANY
+* WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+* PARTICULAR PURPOSE. See the GNU General Public License for more details.
+*
+* You have received a copy of the GNU General Public License along with MicroTBX-Modbus.
+* If not, see www.gnu.org/licenses/.
+*
+* \endinternal
+****************************************************************************************/
+#ifndef TBXMB_MONITOR_PRIVATE_H
+#define TBXMB_MONITOR_PRIVATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************************
+* Macro definitions
+****************************************************************************************/
+#ifndef TBX_MB_MONITOR_BUF_SIZE
+/** \brief Configure the number of received frames that the ring buffer of a bus monitor
+ *         can hold, until their callback processed them. Frames that don't fit are
+ *         dropped. To override this default configuration, you can add a macro with the
+ *         same name, but with a different value, to "tbx_conf.h".
+ */
+#define TBX_MB_MONITOR_BUF_SIZE        (8U)
+#endif
+
+
+/****************************************************************************************
+* Type definitions
+****************************************************************************************/
+/** \brief Modbus RTU bus monitor interface function to detect events in a polling
+ *         manner.
+ */
+typedef void (* tTbxMbMonitorPoll)   (void        * context);
+
+
+/** \brief Modbus RTU bus monitor interface function for processing events. */
+typedef void (* tTbxMbMonitorProcess)(tTbxMbEvent * event);
+
+
+/** \brief Received frame, as stored in the ring buffer of the bus monitor. */
+typedef struct
+{
+  uint32_t             timeTicks;                /**< Frame end timestamp (50us ticks).*/
+  uint32_t             responseTicks;            /**< Response time (50us ticks).      */
+  uint8_t              type;                     /**< Type (tTbxMbMonitorFrameType).   */
+  uint8_t              node;                     /**< Server node address.             */
+  uint8_t              code;                     /**< Function code.                   */
+  uint8_t              dataLen;                  /**< Number of PDU data bytes.        */
+  uint8_t              data[TBX_MB_TP_PDU_DATA_LEN_MAX]; /**< PDU data bytes.          */
+} tTbxMbMonitorEntry;
+
+
+/** \brief Modbus RTU bus monitor context that groups all its specific data. It's what
+ *         the tTbxMbMonitor opaque pointer points to.
+ */
+typedef struct
+{
+  /* Event interface methods. The following four entries must always be at the start
+   * and exactly match those in tTbxMbEventCtx. Think of it as the base that this struct
+   * derives from.
+   */
+  void                  * instancePtr;           /**< Reserved for C++ wrapper.        */
+  tTbxMbMonitorPoll       pollFcn;               /**< Event poll function.             */
+  tTbxMbMonitorProcess    processFcn;            /**< Event process function.          */
+  tTbxMbEventPoller       pollInfo;              /**< Event poller information.        */
+  /* Private members. */
+  uint8_t                 type;                  /**< Context type.                    */
+  tTbxMbTpCtx           * tpCtx;                 /**< Transport layer context.         */
+  tTbxMbMonitorCallback   callback;              /**< Frame processing callback.       */
+  uint32_t                timeTicks;             /**< Free running 32-bit tick counter.*/
+  uint16_t                timeCount;             /**< Last 20 kHz timer counter value. */
+  uint8_t                 reqPending;            /**< Request awaits response flag.    */
+  uint8_t                 reqNode;               /**< Node of the pending request.     */
+  uint8_t                 reqCode;               /**< Code of the pending request.     */
+  uint32_t                reqTicks;              /**< Time of the pending request.     */
+  tTbxMbMonitorEntry      buf[TBX_MB_MONITOR_BUF_SIZE]; /**< Frame ring buffer.        */
+  uint8_t                 bufHead;               /**< Index of the oldest frame.       */
+  uint8_t                 bufCount;              /**< Number of buffered frames.       */
+  uint32_t                dropped;               /**< Number of dropped frames.        */
+} tTbxMbMonitorCtx;
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TBXMB_MONITOR_PRIVATE_H */
+/*********************************** end of tbxmb_monitor_private.h ********************/
@@ -47,6 +47,17 @@ extern "C" {
                                    (uint8_t)TBX_MB_UART_NUM_PORT)
 #endif
 
+#ifndef TBX_MB_EVENT_TASK_NUM
+/** \brief Configure the number of event tasks. By default, one event task, which runs
+ *         TbxMbEventTask(), processes the events of all Modbus objects. With an RTOS,
+ *         you can configure more event tasks. Each one has its own event queue and runs
+ *         TbxMbEventTaskIndexed() from a separate RTOS task, at its own priority. To
+ *         override this default configuration, you can add a macro with the same name,
+ *         but a different value, to "tbx_conf.h".
+ */
+#define TBX_MB_EVENT_TASK_NUM     (1U)
+#endif
+
 
 /****************************************************************************************
 * Type definitions
@@ -67,8 +78,12 @@ void          TbxMbOsalEventPost(tTbxMbEvent const * event,
                                  uint8_t             fromIsr);
 
 uint8_t       TbxMbOsalEventWait(tTbxMbEvent       * event, 
+                                 uint8_t             taskIdx,
                                  uint16_t            timeoutMs);
 
+/* Modbus OSAL task API. */
+void          TbxMbOsalTaskPin  (uint8_t             core);
+
 /* Modbus OSAL semaphore API. */
 tTbxMbOsalSem TbxMbOsalSemCreate(void);
 
@@ -48,9 +48,51 @@ uint8_t  TbxMbPortUartTransmit (tTbxMbUartPort             port,
                                 uint8_t            const * data, 
                                 uint16_t                   len);
 
+/* UART hardware port functions for direct data reception. Only needed when
+ * TBX_MB_UART_RX_DMA_ENABLE is configured to a value > 0.
+ */
+void     TbxMbPortUartReceiveStart(tTbxMbUartPort          port,
+                                   uint8_t               * data,
+                                   uint16_t                len);
+
+void     TbxMbPortUartReceiveStop (tTbxMbUartPort          port);
+
+/* UART hardware port functions for the one-shot timer. Only needed when
+ * TBX_MB_UART_TIMER_ENABLE is configured to a value > 0.
+ */
+void     TbxMbPortUartTimerStart  (tTbxMbUartPort          port,
+                                   uint16_t                ticks);
+
+void     TbxMbPortUartTimerStop   (tTbxMbUartPort          port);
+
 /* Timer hardware port functions. */
 uint16_t TbxMbPortTimerCount(void);
 
+/* CRC hardware port functions. Only needed when TBX_MB_RTU_CRC_METHOD is configured to
+ * TBX_MB_RTU_CRC_METHOD_PORT.
+ */
+uint16_t TbxMbPortCrcUpdate    (uint16_t                   crc,
+                                uint8_t            const * data,
+                                uint16_t                   len);
+
+/* TCP/IP port functions. Only needed when using the Modbus TCP transport layer. */
+tTbxMbTcpSock TbxMbPortTcpServerOpen  (uint16_t                   port);
+
+tTbxMbTcpSock TbxMbPortTcpServerAccept(tTbxMbTcpSock              serverSock);
+
+tTbxMbTcpSock TbxMbPortTcpConnect     (char               const * ipAddress,
+                                       uint16_t                   port);
+
+uint8_t       TbxMbPortTcpTransmit    (tTbxMbTcpSock              sock,
+                                       uint8_t            const * data,
+                                       uint16_t                   len);
+
+uint8_t       TbxMbPortTcpReceive     (tTbxMbTcpSock              sock,
+                                       uint8_t                  * data,
+                                       uint16_t                 * len);
+
+void          TbxMbPortTcpClose       (tTbxMbTcpSock              sock);
+
 #ifdef __cplusplus
 }
 #endif
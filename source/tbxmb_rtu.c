@@ -61,6 +61,94 @@
 #define TBX_MB_RTU_T1_5_TIMEOUT_ENABLE      (0U)
 #endif
 
+#ifndef TBX_MB_RTU_EARLY_FRAME_END_ENABLE
+/** \brief The Modbus RTU protocol marks the end of a packet with a 3.5 character idle
+ *         time on the bus. For most function codes, the length of the packet can be
+ *         predicted once its first few bytes are received. When enabled, the CRC16 is
+ *         calculated while the bytes are received and a packet is considered complete,
+ *         as soon as its predicted length is reached with a valid CRC16. This lowers
+ *         the latency of packet processing with up to 3.5 character times, which is 
+ *         about 4 ms at 9600 bits/sec. Disabled by default for the following reasons:
+ *         - It moves the CRC16 calculation to the UART reception interrupt.
+ *         - A packet that is transmitted right after a packet that ended early, still
+ *           waits for the remainder of the 3.5 character idle time that the protocol
+ *           requires between packets. Only the processing of the packet starts early.
+ *
+ *         To override this default configuration, you can add a macro with the same
+ *         name, but with a different value, to "tbx_conf.h".
+ */
+#define TBX_MB_RTU_EARLY_FRAME_END_ENABLE   (0U)
+#endif
+
+#ifndef TBX_MB_RTU_CRC_METHOD
+/** \brief Selects how the CRC16 checksum of the Modbus RTU packets is calculated. The
+ *         following methods are supported:
+ *         - TBX_MB_RTU_CRC_METHOD_TABLE: Software calculation with one 256 entry lookup
+ *           table, processing one byte at a time. Needs 512 bytes of ROM. This is the
+ *           default, because it offers a good trade off between ROM usage and run-time
+ *           performance.
+ *         - TBX_MB_RTU_CRC_METHOD_SLICING4: Software calculation with four 256 entry
+ *           lookup tables, processing four bytes at a time. Needs 2 kB of ROM. Worth it
+ *           on faster microcontrollers with an instruction and data cache.
+ *         - TBX_MB_RTU_CRC_METHOD_PORT: Calculation by the hardware CRC peripheral of
+ *           your microcontroller, with the help of port function TbxMbPortCrcUpdate().
+ *
+ *         To override this default configuration, you can add a macro with the same
+ *         name, but with a different value, to "tbx_conf.h".
+ */
+#define TBX_MB_RTU_CRC_METHOD               (TBX_MB_RTU_CRC_METHOD_TABLE)
+#endif
+
+#ifndef TBX_MB_RTU_T1_5_FIXED_US
+/** \brief The Modbus RTU protocol fixes the 1.5 character time to 750 us, for baudrates
+ *         greater than 19200 bits/sec. To override this default configuration, for
+ *         example to relax the timing on a high-speed link with devices that all agree
+ *         on it, you can add a macro with the same name, but with a different value in
+ *         microseconds, to "tbx_conf.h". Range can be 1..32000.
+ */
+#define TBX_MB_RTU_T1_5_FIXED_US            (750U)
+#endif
+
+#ifndef TBX_MB_RTU_T3_5_FIXED_US
+/** \brief The Modbus RTU protocol fixes the 3.5 character time to 1750 us, for baudrates
+ *         greater than 19200 bits/sec. This idle time marks the end of a packet. To
+ *         override this default configuration, you can add a macro with the same name,
+ *         but with a different value in microseconds, to "tbx_conf.h". Range can be
+ *         1..32000.
+ */
+#define TBX_MB_RTU_T3_5_FIXED_US            (1750U)
+#endif
+
+#ifndef TBX_MB_RTU_SCALED_TIMING_ENABLE
+/** \brief When this configuration macro is > 0, the 1.5 and 3.5 character times scale
+ *         with the baudrate, also for baudrates greater than 19200 bits/sec. At 921600
+ *         bits/sec, the 3.5 character time is then about 42 us, instead of the fixed
+ *         TBX_MB_RTU_T3_5_FIXED_US. This no longer complies with the Modbus RTU protocol,
+ *         so only enable it if all devices on the network support it. To override this
+ *         default configuration, you can add a macro with the same name, but with a
+ *         value of 1 (enable), to "tbx_conf.h".
+ */
+#define TBX_MB_RTU_SCALED_TIMING_ENABLE     (0U)
+#endif
+
+/** \brief Initial value of the CRC16 checksum calculation. */
+#define TBX_MB_RTU_CRC_INIT                 (0xFFFFU)
+
+/** \brief Value of the CRC16 checksum, when calculated over all ADU bytes, including the
+ *         CRC16 itself, of a packet that is not corrupted.
+ */
+#define TBX_MB_RTU_CRC_RESIDUE              (0x0000U)
+
+/** \brief Expected ADU reception packet length value for when the length is not yet
+ *         known, because not enough bytes were received so far.
+ */
+#define TBX_MB_RTU_ADU_LEN_PENDING          (0U)
+
+/** \brief Expected ADU reception packet length value for when the length cannot be
+ *         predicted. The 3.5 character idle time then marks the end of the packet.
+ */
+#define TBX_MB_RTU_ADU_LEN_UNKNOWN          (0xFFFFU)
+
 /** \brief Unique context type to identify a context as being an RTU transport layer. */
 #define TBX_MB_RTU_CONTEXT_TYPE             (84U)
 
@@ -80,13 +168,52 @@
 #define TBX_MB_RTU_STATE_VALIDATION         (4U)
 
 
+/****************************************************************************************
+* Configuration check
+****************************************************************************************/
+#if ((TBX_MB_RTU_CRC_METHOD != TBX_MB_RTU_CRC_METHOD_TABLE) && \
+     (TBX_MB_RTU_CRC_METHOD != TBX_MB_RTU_CRC_METHOD_SLICING4) && \
+     (TBX_MB_RTU_CRC_METHOD != TBX_MB_RTU_CRC_METHOD_PORT))
+#error "TBX_MB_RTU_CRC_METHOD is not configured to a supported value."
+#endif
+
+#if ((TBX_MB_RTU_T1_5_TIMEOUT_ENABLE > 0U) && (TBX_MB_UART_RX_DMA_ENABLE > 0U))
+#error "TBX_MB_RTU_T1_5_TIMEOUT_ENABLE cannot be combined with TBX_MB_UART_RX_DMA_ENABLE."
+#endif
+
+#if ((TBX_MB_RTU_T1_5_FIXED_US < 1U) || (TBX_MB_RTU_T1_5_FIXED_US > 32000U))
+#error "TBX_MB_RTU_T1_5_FIXED_US must be in the range 1..32000"
+#endif
+
+#if ((TBX_MB_RTU_T3_5_FIXED_US < 1U) || (TBX_MB_RTU_T3_5_FIXED_US > 32000U))
+#error "TBX_MB_RTU_T3_5_FIXED_US must be in the range 1..32000"
+#endif
+
+
 /****************************************************************************************
 * Function prototypes
 ****************************************************************************************/
+static tTbxMbTp         TbxMbRtuInit            (tTbxMbTpCtx          * newTpCtx,
+                                                 tTbxMbTpPacket       * txPacket,
+                                                 tTbxMbTpPacket       * rxPacket,
+                                                 uint8_t                isStatic,
+                                                 uint8_t                nodeAddr, 
+                                                 tTbxMbUartPort         port, 
+                                                 tTbxMbUartBaudrate     baudrate,
+                                                 tTbxMbUartStopbits     stopbits,
+                                                 tTbxMbUartParity       parity);
+
 static void             TbxMbRtuPoll            (tTbxMbTp               transport);
 
+static void             TbxMbRtuProcessEvent    (tTbxMbEvent          * event);
+
+static void             TbxMbRtuStateUpdate     (tTbxMbTp               transport,
+                                                 uint8_t                timerExpired);
+
 static uint8_t          TbxMbRtuTransmit        (tTbxMbTp               transport);
 
+static uint8_t          TbxMbRtuTransmitStart   (tTbxMbTpCtx          * tpCtx);
+
 static void             TbxMbRtuReceptionDone   (tTbxMbTp               transport);
 
 static tTbxMbTpPacket * TbxMbRtuGetRxPacket     (tTbxMbTp               transport);
@@ -100,10 +227,40 @@ static void             TbxMbRtuTransmitComplete(tTbxMbUartPort         port);
 static void             TbxMbRtuDataReceived    (tTbxMbUartPort         port, 
                                                  uint8_t        const * data, 
                                                  uint8_t                len);
+
+static void             TbxMbRtuReceiveProgress (tTbxMbUartPort         port,
+                                                 uint16_t               len);
+
+static void             TbxMbRtuTimerExpired    (tTbxMbUartPort         port);
+
+static uint16_t         TbxMbRtuCharTicks       (uint32_t               baudBps,
+                                                 uint8_t                halfChars,
+                                                 uint16_t               fixedUs,
+                                                 uint32_t               tickFreq);
+
+static void             TbxMbRtuIdleTimeStart   (tTbxMbTpCtx volatile * tpCtx,
+                                                 uint8_t                fromIsr);
+
+static void             TbxMbRtuIdleTimeStop    (tTbxMbTpCtx volatile * tpCtx);
+
+#if (TBX_MB_UART_TIMER_ENABLE > 0U)
+static void             TbxMbRtuRxTimerRestart  (tTbxMbTpCtx volatile * tpCtx);
+#endif
+
+#if (TBX_MB_UART_RX_DMA_ENABLE > 0U)
+static void             TbxMbRtuRxDmaStart      (tTbxMbTpCtx volatile * tpCtx);
+#endif
                                                  
-static uint16_t         TbxMbRtuCalculatCrc     (uint8_t        const * data, 
+#if (TBX_MB_RTU_EARLY_FRAME_END_ENABLE > 0U)
+static void             TbxMbRtuRxFrameEndCheck (tTbxMbTpCtx volatile * tpCtx,
+                                                 uint8_t        const * data,
                                                  uint16_t               len);
 
+static uint16_t         TbxMbRtuAduLenPredict   (uint8_t const volatile * aduPtr,
+                                                 uint16_t                 len,
+                                                 uint8_t                  isClient);
+#endif
+
 
 /****************************************************************************************
 * Local data declarations
@@ -137,130 +294,124 @@ tTbxMbTp TbxMbRtuCreate(uint8_t            nodeAddr,
 {
   tTbxMbTp result = NULL;
 
-  /* Make sure the OSAL event module is initialized. The application will always first
-   * create a transport layer object before a channel object. Consequently, this is the
-   * best place to do the OSAL module initialization.
-   */
-  TbxMbOsalEventInit();
+  /* Allocate memory for the new transport layer storage. */
+  tTbxMbTpStorage * newStorage = TbxMemPoolAllocate(sizeof(tTbxMbTpStorage));
+  /* Automatically increase the memory pool, if it was too small. */
+  if (newStorage == NULL)
+  {
+    /* No need to check the return value, because if it failed, the following
+     * allocation fails too, which is verified later on.
+     */
+    (void)TbxMemPoolCreate(1U, sizeof(tTbxMbTpStorage));
+    newStorage = TbxMemPoolAllocate(sizeof(tTbxMbTpStorage));      
+  }
+  /* Verify memory allocation of the transport layer storage. */
+  TBX_ASSERT(newStorage != NULL);
+  /* Only continue if the memory allocation succeeded. */
+  if (newStorage != NULL)
+  {
+    /* Initialize the transport context with separate reception and transmit packets. */
+    result = TbxMbRtuInit(&newStorage->ctx, &newStorage->txPacket, &newStorage->rxPacket,
+                          TBX_FALSE, nodeAddr, port, baudrate, stopbits, parity);
+    /* Give the storage back to the memory pool, if the initialization failed. */
+    if (result == NULL)
+    {
+      TbxMemPoolRelease(newStorage);
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbRtuCreate ***/  
+
+
+/************************************************************************************//**
+** \brief     Creates a Modbus RTU transport layer object in storage that the caller
+**            provides, instead of allocating it from a memory pool. This makes it
+**            possible to place the object in a specific RAM section, such as
+**            tightly-coupled memory. The storage must remain valid until the object is
+**            released with TbxMbRtuFree().
+** \param     storage Pointer to the storage for the transport layer object.
+** \param     nodeAddr The address of the node. Can be in the range 1..247 for a server
+**            node. Set it to 0 for the client.
+** \param     port The serial port to use.
+** \param     baudrate The desired communication speed.
+** \param     stopbits Number of stop bits at the end of a character.
+** \param     parity Parity bit type to use.
+** \return    Handle to the newly created RTU transport layer object if successful, NULL
+**            otherwise.
+**
+****************************************************************************************/
+tTbxMbTp TbxMbRtuCreateStatic(tTbxMbTpStorage  * storage,
+                              uint8_t            nodeAddr, 
+                              tTbxMbUartPort     port, 
+                              tTbxMbUartBaudrate baudrate,
+                              tTbxMbUartStopbits stopbits,
+                              tTbxMbUartParity   parity)
+{
+  tTbxMbTp result = NULL;
 
   /* Verify parameters. */
-  TBX_ASSERT((nodeAddr <= TBX_MB_TP_NODE_ADDR_MAX) &&
-             (port < TBX_MB_UART_NUM_PORT) && 
-             (baudrate < TBX_MB_UART_NUM_BAUDRATE) &&
-             (stopbits < TBX_MB_UART_NUM_STOPBITS) &&
-             (parity < TBX_MB_UART_NUM_PARITY));
+  TBX_ASSERT(storage != NULL);
 
   /* Only continue with valid parameters. */
-  if ((nodeAddr <= TBX_MB_TP_NODE_ADDR_MAX) &&
-      (port < TBX_MB_UART_NUM_PORT) && 
-      (baudrate < TBX_MB_UART_NUM_BAUDRATE) &&
-      (stopbits < TBX_MB_UART_NUM_STOPBITS) &&
-      (parity < TBX_MB_UART_NUM_PARITY))
+  if (storage != NULL)
   {
-    /* Allocate memory for the new transport context. */
-    tTbxMbTpCtx * newTpCtx = TbxMemPoolAllocate(sizeof(tTbxMbTpCtx));
-    /* Automatically increase the memory pool, if it was too small. */
-    if (newTpCtx == NULL)
-    {
-      /* No need to check the return value, because if it failed, the following
-       * allocation fails too, which is verified later on.
-       */
-      (void)TbxMemPoolCreate(1U, sizeof(tTbxMbTpCtx));
-      newTpCtx = TbxMemPoolAllocate(sizeof(tTbxMbTpCtx));      
-    }
-    /* Verify memory allocation of the transport context. */
-    TBX_ASSERT(newTpCtx != NULL);
-    /* Only continue if the memory allocation succeeded. */
-    if (newTpCtx != NULL)
-    {
-      /* Initialize the transport context. */
-      newTpCtx->type = TBX_MB_RTU_CONTEXT_TYPE;
-      newTpCtx->instancePtr = NULL;
-      newTpCtx->pollFcn = TbxMbRtuPoll;
-      newTpCtx->processFcn = NULL;
-      newTpCtx->transmitFcn = TbxMbRtuTransmit;
-      newTpCtx->receptionDoneFcn = TbxMbRtuReceptionDone;
-      newTpCtx->getRxPacketFcn = TbxMbRtuGetRxPacket;
-      newTpCtx->getTxPacketFcn = TbxMbRtuGetTxPacket;
-      newTpCtx->nodeAddr = nodeAddr;
-      newTpCtx->port = port;
-      newTpCtx->state = TBX_MB_RTU_STATE_INIT;
-      newTpCtx->rxTime = TbxMbPortTimerCount();
-      newTpCtx->initStateExitSem = TbxMbOsalSemCreate();
-      newTpCtx->diagInfo.busMsgCnt = 0U;
-      newTpCtx->diagInfo.busCommErrCnt = 0U;
-      newTpCtx->diagInfo.busExcpErrCnt = 0U;
-      newTpCtx->diagInfo.srvMsgCnt = 0U;
-      newTpCtx->diagInfo.srvNoRespCnt = 0U;
-      /* Store the transport context in the lookup table. */
-      tbxMbRtuCtx[port] = newTpCtx;
-      /* Initialize the port. Note the RTU always uses 8 databits. */
-      TbxMbUartInit(port, baudrate, TBX_MB_UART_8_DATABITS, stopbits, parity,
-                    TbxMbRtuTransmitComplete, TbxMbRtuDataReceived);
-      /* Determine the 1.5 and 3.5 character times in units of 50us ticks. If the
-       * baudrate is greater than 19200, then these are fixed to 750us and 1750us,
-       * respectively. Make sure to add one extra to adjust for timer resolution
-       * inaccuracy.
-       */
-      if (baudrate > TBX_MB_UART_19200BPS)
-      {
-        newTpCtx->t1_5Ticks = 16U;                         /* 750us / 50us ticks.      */
-        newTpCtx->t3_5Ticks = 36U;                         /* 1750us / 50us ticks      */
-      }
-      /* Need to calculate the 1.5 and 3.5 character times. */
-      else
-      {
-        /* On RTU, one character equals 11 bits: start-bit, 8 data-bits, parity-bit and
-         * stop-bit. In case no parity is used, 2 stop-bits are required by the protocol.
-         * This means that the number of characters per seconds equals the baudrate
-         * divided by 11. The character time in seconds is the reciprocal of that.
-         * Multiply by 10^6 to get the charater time in microseconds:
-         *
-         * tCharMicros = 11 * 1000000 / baudrate.
-         *
-         * The 1.5 and 3.5 character times in microseconds:
-         *
-         * t1_5CharMicros = 11 * 1000000 * 1.5 / baudrate = 16500000 / baudrate
-         * t3_5CharMicros = 11 * 1000000 * 3.5 / baudrate = 38500000 / baudrate
-         * 
-         * This module uses ticks of a 20 kHz timer as a time unit. Each tick is 50us:
-         * 
-         * t1_5CharTicks = (16500000 / 50) / baudrate = 330000 / baudrate
-         * t3_5CharTicks = (38500000 / 50) / baudrate = 770000 / baudrate
-         * 
-         */
-        const uint16_t baudrateLookup[] =
-        {
-          1200,                                            /* TBX_MB_UART_1200BPS      */
-          2400,                                            /* TBX_MB_UART_2400BPS      */
-          4800,                                            /* TBX_MB_UART_4800BPS      */
-          9600,                                            /* TBX_MB_UART_9600BPS      */
-          19200                                            /* TBX_MB_UART_19200BPS     */
-        };
-        /* The following calculation does integer roundup (A + (B-1)) / B and adds one
-         * extra to adjust for timer resolution inaccuracy.
-         */
-        uint16_t baudBps = baudrateLookup[baudrate];
-        newTpCtx->t1_5Ticks = (uint16_t)(((330000UL + (baudBps - 1UL)) / baudBps) + 1U);
-        newTpCtx->t3_5Ticks = (uint16_t)(((770000UL + (baudBps - 1UL)) / baudBps) + 1U);
-      }
-      /* Instruct the event task to call our polling function to be able to determine
-       * when it's time to transition from INIT to IDLE.
-       */
-      tTbxMbEvent newEvent = {.context = newTpCtx, .id = TBX_MB_EVENT_ID_START_POLLING};
-      TbxMbOsalEventPost(&newEvent, TBX_FALSE);
-      /* Update the result. */
-      result = newTpCtx;
-    }
+    /* Initialize the transport context with separate reception and transmit packets. */
+    result = TbxMbRtuInit(&storage->ctx, &storage->txPacket, &storage->rxPacket,
+                          TBX_TRUE, nodeAddr, port, baudrate, stopbits, parity);
   }
   /* Give the result back to the caller. */
   return result;
-} /*** end of TbxMbRtuCreate ***/  
+} /*** end of TbxMbRtuCreateStatic ***/  
+
+
+/************************************************************************************//**
+** \brief     Creates a Modbus RTU transport layer object in storage that the caller
+**            provides, with one packet buffer that is shared for reception and
+**            transmission. This roughly halves the RAM needed for the object. It works
+**            because a server only builds its response after it is done with the
+**            reception of the request. Therefore only link it to a server channel or a
+**            bus monitor and never to a client channel. The storage must remain valid
+**            until the object is released with TbxMbRtuFree().
+** \param     storage Pointer to the storage for the transport layer object.
+** \param     nodeAddr The address of the server node. Can be in the range 1..247.
+** \param     port The serial port to use.
+** \param     baudrate The desired communication speed.
+** \param     stopbits Number of stop bits at the end of a character.
+** \param     parity Parity bit type to use.
+** \return    Handle to the newly created RTU transport layer object if successful, NULL
+**            otherwise.
+**
+****************************************************************************************/
+tTbxMbTp TbxMbRtuCreateCompact(tTbxMbTpCompactStorage * storage,
+                               uint8_t                  nodeAddr, 
+                               tTbxMbUartPort           port, 
+                               tTbxMbUartBaudrate       baudrate,
+                               tTbxMbUartStopbits       stopbits,
+                               tTbxMbUartParity         parity)
+{
+  tTbxMbTp result = NULL;
+
+  /* Verify parameters. */
+  TBX_ASSERT(storage != NULL);
+
+  /* Only continue with valid parameters. */
+  if (storage != NULL)
+  {
+    /* Initialize the transport context with one shared packet for reception and
+     * transmission.
+     */
+    result = TbxMbRtuInit(&storage->ctx, &storage->packet, &storage->packet,
+                          TBX_TRUE, nodeAddr, port, baudrate, stopbits, parity);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbRtuCreateCompact ***/  
 
 
 /************************************************************************************//**
 ** \brief     Releases a Modbus RTU transport layer object, previously created with 
-**            TbxMbRtuCreate().
+**            TbxMbRtuCreate(), TbxMbRtuCreateStatic() or TbxMbRtuCreateCompact().
 ** \param     transport Handle to RTU transport layer object to release.
 **
 ****************************************************************************************/
@@ -278,6 +429,14 @@ void TbxMbRtuFree(tTbxMbTp transport)
     TBX_ASSERT(tpCtx->type == TBX_MB_RTU_CONTEXT_TYPE);
     /* Release the semaphore used for syncing to the INIT to IDLE state transition. */
     TbxMbOsalSemFree(tpCtx->initStateExitSem);
+    #if (TBX_MB_UART_RX_DMA_ENABLE > 0U)
+    /* Stop the data reception, such that no more bytes are written to the ADU. */
+    TbxMbUartReceiveStop(tpCtx->port);
+    #endif
+    #if (TBX_MB_UART_TIMER_ENABLE > 0U)
+    /* Stop the timer, such that its expiration is no longer signalled. */
+    TbxMbUartTimerStop(tpCtx->port);
+    #endif
     TbxCriticalSectionEnter();
     /* Remove the channel from the lookup table. */
     tbxMbRtuCtx[tpCtx->port] = NULL;
@@ -286,12 +445,140 @@ void TbxMbRtuFree(tTbxMbTp transport)
     tpCtx->pollFcn = NULL;
     tpCtx->processFcn = NULL;
     TbxCriticalSectionExit();
-    /* Give the transport layer context back to the memory pool. */
-    TbxMemPoolRelease(tpCtx);
+    /* Remove the context from the poller array of its event task right away, such
+     * that its poll function is no longer called after releasing it.
+     */
+    TbxMbEventPollerRelease(tpCtx);
+    /* Give the transport layer context back to the memory pool, unless it is located
+     * in storage that the caller provided.
+     */
+    if (tpCtx->isStatic == TBX_FALSE)
+    {
+      TbxMemPoolRelease(tpCtx);
+    }
   }
 } /*** end of TbxMbRtuFree ***/
 
 
+/************************************************************************************//**
+** \brief     Initializes a Modbus RTU transport layer object in the specified context
+**            and starts its communication.
+** \param     newTpCtx Pointer to the transport layer context to initialize.
+** \param     txPacket Pointer to the transmit packet buffer.
+** \param     rxPacket Pointer to the reception packet buffer. Can be the same as
+**            txPacket, for a compact server transport layer.
+** \param     isStatic TBX_TRUE if the caller provided the storage, TBX_FALSE if it was
+**            allocated from a memory pool.
+** \param     nodeAddr The address of the node.
+** \param     port The serial port to use.
+** \param     baudrate The desired communication speed.
+** \param     stopbits Number of stop bits at the end of a character.
+** \param     parity Parity bit type to use.
+** \return    Handle to the initialized RTU transport layer object if successful, NULL
+**            otherwise.
+**
+****************************************************************************************/
+static tTbxMbTp TbxMbRtuInit(tTbxMbTpCtx      * newTpCtx,
+                             tTbxMbTpPacket   * txPacket,
+                             tTbxMbTpPacket   * rxPacket,
+                             uint8_t            isStatic,
+                             uint8_t            nodeAddr, 
+                             tTbxMbUartPort     port, 
+                             tTbxMbUartBaudrate baudrate,
+                             tTbxMbUartStopbits stopbits,
+                             tTbxMbUartParity   parity)
+{
+  tTbxMbTp result = NULL;
+
+  /* Make sure the OSAL event module is initialized. The application will always first
+   * create a transport layer object before a channel object. Consequently, this is the
+   * best place to do the OSAL module initialization.
+   */
+  TbxMbOsalEventInit();
+
+  /* Verify parameters. */
+  TBX_ASSERT((newTpCtx != NULL) && (txPacket != NULL) && (rxPacket != NULL) &&
+             (nodeAddr <= TBX_MB_TP_NODE_ADDR_MAX) &&
+             (port < TBX_MB_UART_NUM_PORT) && 
+             (baudrate < TBX_MB_UART_NUM_BAUDRATE) &&
+             (TbxMbUartBaudrateBps(baudrate) > 0U) &&
+             (stopbits < TBX_MB_UART_NUM_STOPBITS) &&
+             (parity < TBX_MB_UART_NUM_PARITY));
+
+  /* Only continue with valid parameters. */
+  if ((newTpCtx != NULL) && (txPacket != NULL) && (rxPacket != NULL) &&
+      (nodeAddr <= TBX_MB_TP_NODE_ADDR_MAX) &&
+      (port < TBX_MB_UART_NUM_PORT) && 
+      (baudrate < TBX_MB_UART_NUM_BAUDRATE) &&
+      (TbxMbUartBaudrateBps(baudrate) > 0U) &&
+      (stopbits < TBX_MB_UART_NUM_STOPBITS) &&
+      (parity < TBX_MB_UART_NUM_PARITY))
+  {
+    /* Initialize the transport context. */
+    newTpCtx->type = TBX_MB_RTU_CONTEXT_TYPE;
+    newTpCtx->instancePtr = NULL;
+    newTpCtx->pollFcn = TbxMbRtuPoll;
+    newTpCtx->processFcn = TbxMbRtuProcessEvent;
+    newTpCtx->pollInfo.count = 0U;
+    newTpCtx->pollInfo.task = TbxMbEventTaskSelected();
+    newTpCtx->transmitFcn = TbxMbRtuTransmit;
+    newTpCtx->receptionDoneFcn = TbxMbRtuReceptionDone;
+    newTpCtx->getRxPacketFcn = TbxMbRtuGetRxPacket;
+    newTpCtx->getTxPacketFcn = TbxMbRtuGetTxPacket;
+    newTpCtx->nodeAddr = nodeAddr;
+    newTpCtx->port = port;
+    newTpCtx->state = TBX_MB_RTU_STATE_INIT;
+    newTpCtx->rxTime = TbxMbPortTimerCount();
+    newTpCtx->rxAduDone = TBX_FALSE;
+    newTpCtx->rxAduLen = TBX_MB_RTU_ADU_LEN_PENDING;
+    newTpCtx->rxCrc = TBX_MB_RTU_CRC_INIT;
+    newTpCtx->txPending = TBX_FALSE;
+    newTpCtx->initStateExitSem = TbxMbOsalSemCreate();
+    newTpCtx->diagInfo.busMsgCnt = 0U;
+    newTpCtx->diagInfo.busCommErrCnt = 0U;
+    newTpCtx->diagInfo.busExcpErrCnt = 0U;
+    newTpCtx->diagInfo.srvMsgCnt = 0U;
+    newTpCtx->diagInfo.srvNoRespCnt = 0U;
+    newTpCtx->isMonitor = TBX_FALSE;
+    newTpCtx->isStatic = isStatic;
+    newTpCtx->txPacket = txPacket;
+    newTpCtx->rxPacket = rxPacket;
+    TbxMbTraceReset(newTpCtx);
+    /* Store the transport context in the lookup table. */
+    tbxMbRtuCtx[port] = newTpCtx;
+    /* Initialize the port. Note the RTU always uses 8 databits. */
+    TbxMbUartInit(port, baudrate, TBX_MB_UART_8_DATABITS, stopbits, parity,
+                  TbxMbRtuTransmitComplete, TbxMbRtuDataReceived,
+                  TbxMbRtuReceiveProgress, TbxMbRtuTimerExpired);
+    #if (TBX_MB_UART_RX_DMA_ENABLE > 0U)
+    /* Start the data reception. Bytes received in the INIT state are ignored, but
+     * they do restart the 3.5 character idle time detection.
+     */
+    TbxMbRtuRxDmaStart(newTpCtx);
+    #endif
+    /* Precompute the 1.5 and 3.5 character times in ticks of the 20 kHz timer. */
+    uint32_t baudBps = TbxMbUartBaudrateBps(baudrate);
+    newTpCtx->t1_5Ticks = TbxMbRtuCharTicks(baudBps, 3U, TBX_MB_RTU_T1_5_FIXED_US,
+                                            20000UL);
+    newTpCtx->t3_5Ticks = TbxMbRtuCharTicks(baudBps, 7U, TBX_MB_RTU_T3_5_FIXED_US,
+                                            20000UL);
+    #if (TBX_MB_UART_TIMER_ENABLE > 0U)
+    /* The one-shot timer can run at a higher frequency, for a finer resolution. */
+    newTpCtx->t3_5TimerTicks = TbxMbRtuCharTicks(baudBps, 7U, TBX_MB_RTU_T3_5_FIXED_US,
+                                                 TBX_MB_UART_TIMER_FREQ);
+    #endif
+    /* Start the detection of the 3.5 character idle time to be able to determine
+     * when it's time to transition from INIT to IDLE.
+     */
+    TbxMbRtuIdleTimeStart(newTpCtx, TBX_FALSE);
+    /* Update the result. */
+    result = newTpCtx;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbRtuInit ***/
+
+
 /************************************************************************************//**
 ** \brief     Event polling function that is automatically called during each call of
 **            TbxMbEventTask(), if activated. Use the TBX_MB_EVENT_ID_START_POLLING and
@@ -300,6 +587,70 @@ void TbxMbRtuFree(tTbxMbTp transport)
 **
 ****************************************************************************************/
 static void TbxMbRtuPoll(tTbxMbTp transport)
+{
+  /* Perform the state transitions that depend on the elapsed time, by comparing the
+   * free running counter value of the timer.
+   */
+  TbxMbRtuStateUpdate(transport, TBX_FALSE);
+} /*** end of TbxMbRtuPoll ***/
+
+
+/************************************************************************************//**
+** \brief     Event processing function that is automatically called when an event for
+**            this transport layer object was received in TbxMbEventTask().
+** \param     event Pointer to the event to process. Note that the event->context points
+**            to the handle of the RTU transport layer object.
+**
+****************************************************************************************/
+static void TbxMbRtuProcessEvent(tTbxMbEvent * event)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(event != NULL);
+
+  /* Only continue with valid parameters. */
+  if (event != NULL)
+  {
+    /* Sanity check the context. */
+    TBX_ASSERT(event->context != NULL);
+    /* Only continue with a valid context. */
+    if (event->context != NULL)
+    {
+      /* Filter on the event identifier. */
+      switch (event->id)
+      {
+        case TBX_MB_EVENT_ID_TIMER_EXPIRED:
+        {
+          /* Perform the state transitions that depend on the elapsed time. The
+           * expiration of the timer already signals that the 3.5 character idle time
+           * elapsed.
+           */
+          TbxMbRtuStateUpdate(event->context, TBX_TRUE);
+        }
+        break;
+
+        default:
+        {
+          /* An unsupported event was dispatched to us. Should not happen. */
+          TBX_ASSERT(TBX_FALSE);
+        }
+        break;
+      }
+    }
+  }
+} /*** end of TbxMbRtuProcessEvent ***/
+
+
+/************************************************************************************//**
+** \brief     Performs the state transitions that depend on the 3.5 character idle time
+**            on the serial line.
+** \param     transport Handle to RTU transport layer object.
+** \param     timerExpired TBX_TRUE if the one-shot timer signalled the end of the 3.5
+**            character idle time, TBX_FALSE to determine this by comparing the free
+**            running counter value of the timer.
+**
+****************************************************************************************/
+static void TbxMbRtuStateUpdate(tTbxMbTp transport,
+                                uint8_t  timerExpired)
 {
   /* Verify parameters. */
   TBX_ASSERT(transport != NULL);
@@ -327,14 +678,20 @@ static void TbxMbRtuPoll(tTbxMbTp transport)
          * overflowed.
          */
         uint16_t deltaTicks = TbxMbPortTimerCount() - rxTimeCopy;
-        /* Did 3.5 character times elapse since the last byte reception? */
-        if (deltaTicks >= tpCtx->t3_5Ticks)
+        /* Check if the reception path already detected the end of the packet, based on
+         * its predicted length and CRC16.
+         */
+        TbxCriticalSectionEnter();
+        uint8_t rxAduDoneCpy = tpCtx->rxAduDone;
+        TbxCriticalSectionExit();
+        /* Did 3.5 character times elapse since the last byte reception or was the end of
+         * the packet already detected?
+         */
+        if ((timerExpired == TBX_TRUE) || (deltaTicks >= tpCtx->t3_5Ticks) || 
+            (rxAduDoneCpy == TBX_TRUE))
         {
-          /* Instruct the event task to stop calling our polling function. */
-          tTbxMbEvent newEvent;
-          newEvent.context = tpCtx;
-          newEvent.id = TBX_MB_EVENT_ID_STOP_POLLING;
-          TbxMbOsalEventPost(&newEvent, TBX_FALSE);
+          /* Stop the detection of the 3.5 character idle time. */
+          TbxMbRtuIdleTimeStop(tpCtx);
           /* Is the newly received frame still in the OK state? */
           TbxCriticalSectionEnter();
           uint8_t rxAduOkayCpy = tpCtx->rxAduOkay;
@@ -348,6 +705,10 @@ static void TbxMbRtuPoll(tTbxMbTp transport)
             TbxCriticalSectionEnter();
             tpCtx->state = TBX_MB_RTU_STATE_VALIDATION;
             TbxCriticalSectionExit();
+            #if (TBX_MB_UART_RX_DMA_ENABLE > 0U)
+            /* Stop the data reception, such that the ADU is no longer written to. */
+            TbxMbUartReceiveStop(tpCtx->port);
+            #endif
             /* Packet reception complete. Set the PDU data length field. At this point 
              * rxAduWrIdx holds to total received bytes in the ADU. The PDU data length
              * is that one, minus:
@@ -359,16 +720,20 @@ static void TbxMbRtuPoll(tTbxMbTp transport)
              * a transition back to IDLE state is made. Consequenty, there is no need for
              * critical sections when accessing the .rxXyz elements of the TP context. 
              */
-            tpCtx->rxPacket.dataLen = tpCtx->rxAduWrIdx - 4U;
+            tpCtx->rxPacket->dataLen = tpCtx->rxAduWrIdx - 4U;
             /* Also store the node address in the packet's node element. That's were 
              * channels expect it. It's in the first byte of the ADU and the ADU starts
              * at one byte before the PDU, which is the last byte of head[].
              */
-            tpCtx->rxPacket.node = tpCtx->rxPacket.head[TBX_MB_TP_ADU_HEAD_LEN_MAX-1U];
+            tpCtx->rxPacket->node = tpCtx->rxPacket->head[TBX_MB_TP_ADU_HEAD_LEN_MAX-1U];
             /* Validate the newly received packet. */
             if (TbxMbRtuValidate(tpCtx) != TBX_OK)
             {
               /* Discard the newly received frame by transitioning back to IDLE. */
+              #if (TBX_MB_UART_RX_DMA_ENABLE > 0U)
+              /* Restart the data reception at the start of the ADU. */
+              TbxMbRtuRxDmaStart(tpCtx);
+              #endif
               TbxCriticalSectionEnter();
               tpCtx->state = TBX_MB_RTU_STATE_IDLE;
               TbxCriticalSectionExit();
@@ -376,6 +741,10 @@ static void TbxMbRtuPoll(tTbxMbTp transport)
             /* Newly received packet is valid. */
             else
             {
+              #if (TBX_MB_TRACE_ENABLE > 0U)
+              /* Timestamp the reception end of the packet. */
+              TbxMbTraceMark(tpCtx, TBX_MB_TRACE_POINT_RX_END);
+              #endif
               /* Post an event to the linked channel for further processing of the PDU.*/
               tTbxMbEvent pduRxEvent;
               pduRxEvent.context = tpCtx->channelCtx;
@@ -389,6 +758,10 @@ static void TbxMbRtuPoll(tTbxMbTp transport)
           else
           {
             /* Discard the newly received frame by transitioning back to IDLE. */
+            #if (TBX_MB_UART_RX_DMA_ENABLE > 0U)
+            /* Restart the data reception at the start of the ADU. */
+            TbxMbRtuRxDmaStart(tpCtx);
+            #endif
             TbxCriticalSectionEnter();
             tpCtx->state = TBX_MB_RTU_STATE_IDLE;
             TbxCriticalSectionExit();
@@ -407,21 +780,58 @@ static void TbxMbRtuPoll(tTbxMbTp transport)
          * overflowed.
          */
         uint16_t deltaTicks = TbxMbPortTimerCount() - txDoneTimeCopy;
+        TbxCriticalSectionEnter();
+        uint8_t txPendingCopy = tpCtx->txPending;
+        TbxCriticalSectionExit();
+        /* Is the start of the transmission still pending? In this case txDoneTime holds
+         * the end of the previous packet, which ended early. After t3_5 it's time to
+         * actually start the transmission.
+         */
+        if (txPendingCopy == TBX_TRUE)
+        {
+          if ((timerExpired == TBX_TRUE) || (deltaTicks >= tpCtx->t3_5Ticks))
+          {
+            /* Stop the detection of the 3.5 character idle time. */
+            TbxMbRtuIdleTimeStop(tpCtx);
+            TbxCriticalSectionEnter();
+            tpCtx->txPending = TBX_FALSE;
+            TbxCriticalSectionExit();
+            /* Start the transmission of the already prepared ADU. */
+            if (TbxMbRtuTransmitStart(tpCtx) != TBX_OK)
+            {
+              /* Increment the total number of not sent responses. */
+              tpCtx->diagInfo.srvNoRespCnt++;
+              #if (TBX_MB_UART_RX_DMA_ENABLE > 0U)
+              /* A compact server transport layer did not restart the data reception
+               * upon completion of the request reception. Restart it now, because no
+               * response transmission was started.
+               */
+              if ( (tpCtx->rxPacket == tpCtx->txPacket) && 
+                   (tpCtx->isMonitor == TBX_FALSE) )
+              {
+                TbxMbRtuRxDmaStart(tpCtx);
+              }
+              #endif
+            }
+          }
+        }
         /* After t3_5 it's time to transition to the IDLE state. */
-        if (deltaTicks >= tpCtx->t3_5Ticks)
+        else if ((timerExpired == TBX_TRUE) || (deltaTicks >= tpCtx->t3_5Ticks))
         {
           /* Transition back to the IDLE state. */
+          #if (TBX_MB_UART_RX_DMA_ENABLE > 0U)
+          /* Restart the data reception at the start of the ADU. */
+          TbxMbRtuRxDmaStart(tpCtx);
+          #endif
           TbxCriticalSectionEnter();
           tpCtx->state = TBX_MB_RTU_STATE_IDLE;
           TbxCriticalSectionExit();
-          /* Instruct the event task to stop calling our polling function. */
-          tTbxMbEvent newEvent;
-          newEvent.context = tpCtx;
-          newEvent.id = TBX_MB_EVENT_ID_STOP_POLLING;
-          TbxMbOsalEventPost(&newEvent, TBX_FALSE);
+          /* Stop the detection of the 3.5 character idle time. */
+          TbxMbRtuIdleTimeStop(tpCtx);
           /* Post an event to the linked channel for inform them that the PDU
-           * transmission completed. Note that it's okay to reuse the event local.
+           * transmission completed.
            */
+          tTbxMbEvent newEvent;
           newEvent.context = tpCtx->channelCtx;
           newEvent.id = TBX_MB_EVENT_ID_PDU_TRANSMITTED;
           TbxMbOsalEventPost(&newEvent, TBX_FALSE);
@@ -440,17 +850,18 @@ static void TbxMbRtuPoll(tTbxMbTp transport)
          */
         uint16_t deltaTicks = TbxMbPortTimerCount() - rxTimeCopy;
         /* After t3_5 it's time to transition to the IDLE state. */
-        if (deltaTicks >= tpCtx->t3_5Ticks)
+        if ((timerExpired == TBX_TRUE) || (deltaTicks >= tpCtx->t3_5Ticks))
         {
           /* Transition to the IDLE state. */
+          #if (TBX_MB_UART_RX_DMA_ENABLE > 0U)
+          /* Restart the data reception at the start of the ADU. */
+          TbxMbRtuRxDmaStart(tpCtx);
+          #endif
           TbxCriticalSectionEnter();
           tpCtx->state = TBX_MB_RTU_STATE_IDLE;
           TbxCriticalSectionExit();
-          /* Instruct the event task to stop calling our polling function. */
-          tTbxMbEvent newEvent;
-          newEvent.context = tpCtx;
-          newEvent.id = TBX_MB_EVENT_ID_STOP_POLLING;
-          TbxMbOsalEventPost(&newEvent, TBX_FALSE);
+          /* Stop the detection of the 3.5 character idle time. */
+          TbxMbRtuIdleTimeStop(tpCtx);
           /* Give the semaphore to sync the transmit function to this event. This is 
            * needed for an RTU client, when transmit it called before being in the INIt
            * state.
@@ -467,7 +878,7 @@ static void TbxMbRtuPoll(tTbxMbTp transport)
       break;
     }
   }
-} /*** end of TbxMbRtuPoll ***/
+} /*** end of TbxMbRtuStateUpdate ***/
 
 
 /************************************************************************************//**
@@ -493,7 +904,7 @@ static uint8_t TbxMbRtuTransmit(tTbxMbTp transport)
     TBX_ASSERT(tpCtx->type == TBX_MB_RTU_CONTEXT_TYPE);
     /* Are we requested to transmit an exception response? */
     TbxCriticalSectionEnter();
-    uint8_t codeCopy = tpCtx->txPacket.pdu.code;
+    uint8_t codeCopy = tpCtx->txPacket->pdu.code;
     TbxCriticalSectionExit();
     if ((codeCopy & TBX_MB_FC_EXCEPTION_MASK) == TBX_MB_FC_EXCEPTION_MASK)
     {
@@ -546,7 +957,7 @@ static uint8_t TbxMbRtuTransmit(tTbxMbTp transport)
        * does not require a response.
        */
       if ( (tpCtx->isClient == TBX_FALSE) && 
-           (tpCtx->txPacket.node == TBX_MB_TP_NODE_ADDR_BROADCAST) )
+           (tpCtx->txPacket->node == TBX_MB_TP_NODE_ADDR_BROADCAST) )
       {
         /* To bypass the actual response transmission, simply update the result to
          * indicate success and keep the okayToTransmit set to its default TBX_FALSE.
@@ -576,29 +987,69 @@ static uint8_t TbxMbRtuTransmit(tTbxMbTp transport)
        * - Packet data (dataLen bytes)
        * - CRC16 (2 bytes)
        */
-      uint8_t * aduPtr = &tpCtx->txPacket.head[TBX_MB_TP_ADU_HEAD_LEN_MAX-1U];
-      uint16_t  aduLen = tpCtx->txPacket.dataLen + 4U;
+      uint8_t * aduPtr = &tpCtx->txPacket->head[TBX_MB_TP_ADU_HEAD_LEN_MAX-1U];
+      uint16_t  aduLen = tpCtx->txPacket->dataLen + 4U;
       /* Populate the ADU head. For RTU it is the address field right in front of the
        * PDU. For client->server transfers the address field is the servers's node
        * address (unicast) or 0 (broadcast) and the client channel will have stored it in
        * the txPacket.node element. For server-client transfers it always the servers's
        * node address as stored when creating the RTU transport layer context.
        */
-      aduPtr[0] = (tpCtx->isClient == TBX_TRUE) ? tpCtx->txPacket.node : tpCtx->nodeAddr;
+      aduPtr[0] = (tpCtx->isClient == TBX_TRUE) ? tpCtx->txPacket->node : tpCtx->nodeAddr;
       /* Populate the ADU tail. For RTU it is the CRC16 right after the PDU's data. */
-      uint16_t adu_crc = TbxMbRtuCalculatCrc(aduPtr, aduLen - 2U);
+      uint16_t adu_crc = TbxMbRtuCrcUpdate(TBX_MB_RTU_CRC_INIT, aduPtr, aduLen - 2U);
       aduPtr[aduLen - 2U] = (uint8_t)adu_crc;                         /* CRC16 low.  */
       aduPtr[aduLen - 1U] = (uint8_t)(adu_crc >> 8U);                 /* CRC16 high. */
-      /* Pass ADU transmit request on to the UART module. */
-      result = TbxMbUartTransmit(tpCtx->port, aduPtr, aduLen);
-      /* Transition back to the IDLE state, because the transmission could not be
-       * started. The unlocks access to txPacket for a possible future transmission.
+      uint8_t txDeferred = TBX_FALSE;
+      #if (TBX_MB_RTU_EARLY_FRAME_END_ENABLE > 0U)
+      /* With the early end of packet detection, the last received packet could have
+       * been processed before the 3.5 character idle time, that the protocol requires
+       * between packets, expired. For example when a client transmits its next request
+       * right after receiving a response. In this case defer the start of the
+       * transmission to the detection of the remainder of the 3.5 character idle time.
+       * This way the event task doesn't need to busy wait. Only do this once for each
+       * packet that ended early.
        */
-      if (result != TBX_OK)
+      TbxCriticalSectionEnter();
+      uint8_t  rxAduDoneCpy = tpCtx->rxAduDone;
+      uint16_t rxTimeCopy = tpCtx->rxTime;
+      tpCtx->rxAduDone = TBX_FALSE;
+      TbxCriticalSectionExit();
+      if (rxAduDoneCpy == TBX_TRUE)
       {
-        TbxCriticalSectionEnter();
-        tpCtx->state = TBX_MB_RTU_STATE_IDLE;
-        TbxCriticalSectionExit();
+        /* Note that this calculation works, even if the timer counter overflowed. */
+        uint16_t deltaTicks = TbxMbPortTimerCount() - rxTimeCopy;
+        /* Remainder of the 3.5 character idle time still to wait for? */
+        if (deltaTicks < tpCtx->t3_5Ticks)
+        {
+          /* Flag the transmission start as pending. While pending, txDoneTime holds
+           * the end of the packet that ended early.
+           */
+          TbxCriticalSectionEnter();
+          tpCtx->txDoneTime = rxTimeCopy;
+          tpCtx->txPending = TBX_TRUE;
+          TbxCriticalSectionExit();
+          #if (TBX_MB_UART_TIMER_ENABLE > 0U)
+          /* Start the one-shot timer, which expires after the remainder of the 3.5
+           * character idle time. Convert the remaining 20 kHz ticks to the one-shot
+           * timer frequency, rounded up and at least one tick.
+           */
+          uint32_t remainingTicks = (((uint32_t)(tpCtx->t3_5Ticks - deltaTicks) *
+                                      TBX_MB_UART_TIMER_FREQ) + 19999UL) / 20000UL;
+          TbxMbUartTimerStart(tpCtx->port, (uint16_t)remainingTicks);
+          #else
+          /* Start the detection of the remainder of the 3.5 character idle time. */
+          TbxMbRtuIdleTimeStart(tpCtx, TBX_FALSE);
+          #endif
+          txDeferred = TBX_TRUE;
+          result = TBX_OK;
+        }
+      }
+      #endif
+      /* Start the transmission right away, unless its start was deferred. */
+      if (txDeferred == TBX_FALSE)
+      {
+        result = TbxMbRtuTransmitStart(tpCtx);
       }
     }
     /* Problem detected that prevented the response from being sent? */
@@ -607,6 +1058,17 @@ static uint8_t TbxMbRtuTransmit(tTbxMbTp transport)
       /* Increment the total number of not sent responses. */
       tpCtx->diagInfo.srvNoRespCnt++;
     }
+    #if (TBX_MB_UART_RX_DMA_ENABLE > 0U)
+    /* A compact server transport layer did not restart the data reception upon
+     * completion of the request reception. If no response transmission was started,
+     * restart it now. Otherwise it's restarted upon completion of the transmission.
+     */
+    if ( (tpCtx->rxPacket == tpCtx->txPacket) && (tpCtx->isMonitor == TBX_FALSE) &&
+         ((okayToTransmit == TBX_FALSE) || (result != TBX_OK)) )
+    {
+      TbxMbRtuRxDmaStart(tpCtx);
+    }
+    #endif
   }
   /* Give the result back to the caller. */
   return result;
@@ -614,31 +1076,74 @@ static uint8_t TbxMbRtuTransmit(tTbxMbTp transport)
 
 
 /************************************************************************************//**
-** \brief     Signals that the caller is done with processing a reception PDU. Should be
-**            called by a channel after receiving the TBX_MB_EVENT_ID_PDU_RECEIVED event
-**            and no longer needing access to the PDU stored in the transport layer
-**            context.
-** \param     transport Handle to RTU transport layer object.
+** \brief     Starts the transmission of the ADU, which is already prepared in the
+**            transmit packet. Should only be called in the TRANSMISSION state.
+** \param     tpCtx Pointer to the RTU transport layer context.
+** \return    TBX_OK if successful, TBX_ERROR otherwise. 
 **
 ****************************************************************************************/
-static void TbxMbRtuReceptionDone(tTbxMbTp transport)
+static uint8_t TbxMbRtuTransmitStart(tTbxMbTpCtx * tpCtx)
 {
+  uint8_t result = TBX_ERROR;
+
   /* Verify parameters. */
-  TBX_ASSERT(transport != NULL);
+  TBX_ASSERT(tpCtx != NULL);
 
   /* Only continue with valid parameters. */
-  if (transport != NULL)
+  if (tpCtx != NULL)
   {
-    /* Convert the TP channel pointer to the context structure. */
-    tTbxMbTpCtx * tpCtx = (tTbxMbTpCtx *)transport;
-    /* Sanity check on the context type. */
-    TBX_ASSERT(tpCtx->type == TBX_MB_RTU_CONTEXT_TYPE);
-    /* This function should only be called in the VALIDATION state. Verify this. */
-    TbxCriticalSectionEnter();
-    uint8_t currentState = tpCtx->state;
-    TbxCriticalSectionExit();
-    TBX_ASSERT(currentState == TBX_MB_RTU_STATE_VALIDATION);
-    /* Only continue in the VALIDATION state. Note that in the VALIDATION state, the data
+    /* The ADU starts at one byte before the PDU, which is the last byte of head[]. The
+     * ADU's length is the node address, function code, packet data and CRC16.
+     */
+    uint8_t * aduPtr = &tpCtx->txPacket->head[TBX_MB_TP_ADU_HEAD_LEN_MAX-1U];
+    uint16_t  aduLen = tpCtx->txPacket->dataLen + 4U;
+    #if (TBX_MB_TRACE_ENABLE > 0U)
+    /* Timestamp the transmission start of the packet. */
+    TbxMbTraceMark(tpCtx, TBX_MB_TRACE_POINT_TX_START);
+    #endif
+    /* Pass ADU transmit request on to the UART module. */
+    result = TbxMbUartTransmit(tpCtx->port, aduPtr, aduLen);
+    /* Transition back to the IDLE state, because the transmission could not be
+     * started. The unlocks access to txPacket for a possible future transmission.
+     */
+    if (result != TBX_OK)
+    {
+      TbxCriticalSectionEnter();
+      tpCtx->state = TBX_MB_RTU_STATE_IDLE;
+      TbxCriticalSectionExit();
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbRtuTransmitStart ***/
+
+
+/************************************************************************************//**
+** \brief     Signals that the caller is done with processing a reception PDU. Should be
+**            called by a channel after receiving the TBX_MB_EVENT_ID_PDU_RECEIVED event
+**            and no longer needing access to the PDU stored in the transport layer
+**            context.
+** \param     transport Handle to RTU transport layer object.
+**
+****************************************************************************************/
+static void TbxMbRtuReceptionDone(tTbxMbTp transport)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(transport != NULL);
+
+  /* Only continue with valid parameters. */
+  if (transport != NULL)
+  {
+    /* Convert the TP channel pointer to the context structure. */
+    tTbxMbTpCtx * tpCtx = (tTbxMbTpCtx *)transport;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(tpCtx->type == TBX_MB_RTU_CONTEXT_TYPE);
+    /* This function should only be called in the VALIDATION state. Verify this. */
+    TbxCriticalSectionEnter();
+    uint8_t currentState = tpCtx->state;
+    TbxCriticalSectionExit();
+    TBX_ASSERT(currentState == TBX_MB_RTU_STATE_VALIDATION);
+    /* Only continue in the VALIDATION state. Note that in the VALIDATION state, the data
      * reception path is locked until a transition back to IDLE state is made, which is
      * handled by this function.
      */
@@ -647,6 +1152,16 @@ static void TbxMbRtuReceptionDone(tTbxMbTp transport)
       /* Transistion back to the IDLE state to unlock the data reception path, allowing
        * the reception of new packets.
        */
+      #if (TBX_MB_UART_RX_DMA_ENABLE > 0U)
+      /* Restart the data reception at the start of the ADU. Not for a compact server
+       * transport layer, because its response is about to be transmitted from the same
+       * packet buffer. TbxMbRtuTransmit() takes care of the restart in this case.
+       */
+      if ( (tpCtx->rxPacket != tpCtx->txPacket) || (tpCtx->isMonitor == TBX_TRUE) )
+      {
+        TbxMbRtuRxDmaStart(tpCtx);
+      }
+      #endif
       TbxCriticalSectionEnter();
       tpCtx->state = TBX_MB_RTU_STATE_IDLE;
       TbxCriticalSectionExit();
@@ -687,7 +1202,7 @@ static tTbxMbTpPacket * TbxMbRtuGetRxPacket(tTbxMbTp transport)
     if (currentState == TBX_MB_RTU_STATE_VALIDATION)
     {
       /* Update the result. */
-      result = &tpCtx->rxPacket;
+      result = tpCtx->rxPacket;
     }
   }
   /* Give the result back to the caller. */
@@ -729,7 +1244,7 @@ static tTbxMbTpPacket * TbxMbRtuGetTxPacket(tTbxMbTp transport)
     if (currentState != TBX_MB_RTU_STATE_TRANSMISSION)
     {
       /* Update the result. */
-      result = &tpCtx->txPacket;
+      result = tpCtx->txPacket;
     }
   }
   /* Give the result back to the caller. */
@@ -774,23 +1289,33 @@ static uint8_t TbxMbRtuValidate(tTbxMbTp transport)
        * CRC.
        */
       tpCtx->diagInfo.busMsgCnt++;
+#if (TBX_MB_RTU_EARLY_FRAME_END_ENABLE > 0U)
+      /* The CRC16 was already calculated during the reception, over all ADU bytes. This
+       * includes the CRC16 stored in the ADU packet itself, so the result should equal
+       * the residue value.
+       */
+      uint16_t packetCrc = TBX_MB_RTU_CRC_RESIDUE;
+      uint16_t calcCrc = tpCtx->rxCrc;
+#else
       /* The ADU for an RTU packet starts at one byte before the PDU, which is the last
        * byte of head[]. Get the pointer of where the ADU starts in the rxPacket.
        */
-      uint8_t * aduPtr = &tpCtx->rxPacket.head[TBX_MB_TP_ADU_HEAD_LEN_MAX-1U];
+      uint8_t * aduPtr = &tpCtx->rxPacket->head[TBX_MB_TP_ADU_HEAD_LEN_MAX-1U];
       /* The CRC16 is stored in the 2 bytes after the PDU data bytes:
        * - Node address (1 byte)
        * - Function code (1 byte)
        * - Packet data (dataLen bytes)
        * - CRC16 (2 bytes)
        */
-      uint8_t const * crcPtr = &aduPtr[2U + tpCtx->rxPacket.dataLen];
+      uint8_t const * crcPtr = &aduPtr[2U + tpCtx->rxPacket->dataLen];
       /* Read out the CRC16 stored in the ADU packet. */
       uint16_t packetCrc = crcPtr[0] | (uint16_t)(crcPtr[1] << 8U);
       /* Calculate the CRC16 based on the packet contents. It's calculated over the
        * entire ADU data, just excluding the last two byte with the CRC16.
        */
-      uint16_t calcCrc = TbxMbRtuCalculatCrc(aduPtr, tpCtx->rxPacket.dataLen + 2U);
+      uint16_t calcCrc = TbxMbRtuCrcUpdate(TBX_MB_RTU_CRC_INIT, aduPtr, 
+                                           tpCtx->rxPacket->dataLen + 2U);
+#endif
       /* Are the two CRC16s a mismatch? */
       if (packetCrc != calcCrc)
       {
@@ -800,14 +1325,22 @@ static uint8_t TbxMbRtuValidate(tTbxMbTp transport)
       /* CRC16 check passed. */
       else
       {
+        /* A passive bus monitor processes all frames, regardless of their node
+         * address.
+         */
+        if (tpCtx->isMonitor == TBX_TRUE)
+        {
+          /* Packet is valid. Update the result accordingly. */
+          result = TBX_OK;
+        }
         /* Continue checking if the ADU is addressed to us. This check is different for a
          * server and a client. Start with the server case.
          */
-        if (tpCtx->isClient == TBX_FALSE)
+        else if (tpCtx->isClient == TBX_FALSE)
         {
           /* Only process frames that are addressed to us (unicast or broadcast). */
-          if ((tpCtx->rxPacket.node == tpCtx->nodeAddr) ||
-              (tpCtx->rxPacket.node == TBX_MB_TP_NODE_ADDR_BROADCAST))
+          if ((tpCtx->rxPacket->node == tpCtx->nodeAddr) ||
+              (tpCtx->rxPacket->node == TBX_MB_TP_NODE_ADDR_BROADCAST))
           {
             /* Increment the total number of received packets with a correct CRC, that
              * were addressed to us. Either via unicast of broadcast.
@@ -819,7 +1352,7 @@ static uint8_t TbxMbRtuValidate(tTbxMbTp transport)
              * for a critical section, because we are guaranteed not in the IDLE or
              * TRANSMISSION states.
              */
-            tpCtx->txPacket.node = tpCtx->rxPacket.node;
+            tpCtx->txPacket->node = tpCtx->rxPacket->node;
             /* Packet is valid. Update the result accordingly. */
             result = TBX_OK;
           }
@@ -828,8 +1361,8 @@ static uint8_t TbxMbRtuValidate(tTbxMbTp transport)
         else
         {
           /* Only process frames that are send from a valid server. */
-          if ( (tpCtx->rxPacket.node >= TBX_MB_TP_NODE_ADDR_MIN) ||
-               (tpCtx->rxPacket.node <= TBX_MB_TP_NODE_ADDR_MAX) )
+          if ( (tpCtx->rxPacket->node >= TBX_MB_TP_NODE_ADDR_MIN) ||
+               (tpCtx->rxPacket->node <= TBX_MB_TP_NODE_ADDR_MAX) )
           {
             /* Packet is valid. Update the result accordingly. */
             result = TBX_OK;
@@ -888,14 +1421,14 @@ static void TbxMbRtuTransmitComplete(tTbxMbUartPort port)
         TbxCriticalSectionEnter();
         tpCtx->txDoneTime = TbxMbPortTimerCount();
         TbxCriticalSectionExit();
-        /* Instruct the event task to start calling our polling function. Needed to
-         * detect the 3.5 character timeout, after which we can transition back to the
-         * IDLE state.
+        #if (TBX_MB_TRACE_ENABLE > 0U)
+        /* Timestamp the transmission completion of the packet. */
+        TbxMbTraceMark(tpCtx, TBX_MB_TRACE_POINT_TX_DONE);
+        #endif
+        /* Start the detection of the 3.5 character idle time, after which we can
+         * transition back to the IDLE state.
          */
-        tTbxMbEvent newEvent;
-        newEvent.context = (void *)tpCtx;
-        newEvent.id = TBX_MB_EVENT_ID_START_POLLING;
-        TbxMbOsalEventPost(&newEvent, TBX_TRUE);
+        TbxMbRtuIdleTimeStart(tpCtx, TBX_TRUE);
       }
     }
   }
@@ -954,7 +1487,7 @@ static void TbxMbRtuDataReceived(tTbxMbUartPort         port,
       /* The ADU for an RTU packet starts at one byte before the PDU, which is the last
        * byte of head[]. Get the pointer of where the ADU starts in the rxPacket.
        */
-      uint8_t volatile * aduPtr = &tpCtx->rxPacket.head[TBX_MB_TP_ADU_HEAD_LEN_MAX-1U];
+      uint8_t volatile * aduPtr = &tpCtx->rxPacket->head[TBX_MB_TP_ADU_HEAD_LEN_MAX-1U];
       /* Get copy of the state so the we can exit the critical section. */
       uint8_t stateCopy = tpCtx->state;
       TbxCriticalSectionExit();
@@ -1001,12 +1534,24 @@ static void TbxMbRtuDataReceived(tTbxMbUartPort         port,
           }
           /* Update the write indexer into the ADU reception packet. */
           tpCtx->rxAduWrIdx += len;
+          #if (TBX_MB_RTU_EARLY_FRAME_END_ENABLE > 0U)
+          /* Check if this completed the packet. */
+          TbxMbRtuRxFrameEndCheck(tpCtx, data, len);
+          #endif
         }
         TbxCriticalSectionExit();
+        #if (TBX_MB_UART_TIMER_ENABLE > 0U)
+        /* Restart the detection of the 3.5 character idle time. */
+        TbxMbRtuRxTimerRestart(tpCtx);
+        #endif
       }
       /* Are we in the IDLE state? */
       else if (stateCopy == TBX_MB_RTU_STATE_IDLE)
       {
+        #if (TBX_MB_TRACE_ENABLE > 0U)
+        /* Timestamp the reception start of the packet. */
+        TbxMbTraceMark(tpCtx, TBX_MB_TRACE_POINT_RX_START);
+        #endif
         TbxCriticalSectionEnter();
         /* Transition to the RECEIVING state. */
         tpCtx->state = TBX_MB_RTU_STATE_RECEPTION;
@@ -1024,15 +1569,33 @@ static void TbxMbRtuDataReceived(tTbxMbUartPort         port,
         tpCtx->rxAduWrIdx = len;
         /* Initialize frame OK/NOK flag to okay so far. */
         tpCtx->rxAduOkay = TBX_TRUE;
+        /* Initialize the early end of packet detection. */
+        tpCtx->rxAduDone = TBX_FALSE;
+        #if (TBX_MB_RTU_EARLY_FRAME_END_ENABLE > 0U)
+        tpCtx->rxAduLen = TBX_MB_RTU_ADU_LEN_PENDING;
+        tpCtx->rxCrc = TBX_MB_RTU_CRC_INIT;
+        /* Check if this already completed the packet. */
+        TbxMbRtuRxFrameEndCheck(tpCtx, data, len);
+        #endif
         TbxCriticalSectionExit();
-        /* Instruct the event task to call our polling function to be able to determine
-         * when the 3.5 character idle time occurred, which marks the end of the packet.
+        /* Start the detection of the 3.5 character idle time, which marks the end of
+         * the packet.
          */
-        tTbxMbEvent newEvent;
-        newEvent.context = (void *)tpCtx;
-        newEvent.id = TBX_MB_EVENT_ID_START_POLLING;
-        TbxMbOsalEventPost(&newEvent, TBX_TRUE);
+        #if (TBX_MB_UART_TIMER_ENABLE > 0U)
+        TbxMbRtuRxTimerRestart(tpCtx);
+        #else
+        TbxMbRtuIdleTimeStart(tpCtx, TBX_TRUE);
+        #endif
       }
+      #if (TBX_MB_UART_TIMER_ENABLE > 0U)
+      /* Are we in the INIT state? Each received byte restarts the detection of the 3.5
+       * character idle time, after which it's time to transition to IDLE.
+       */
+      else if (stateCopy == TBX_MB_RTU_STATE_INIT)
+      {
+        TbxMbRtuIdleTimeStart(tpCtx, TBX_TRUE);
+      }
+      #endif
       else
       {
         /* Nothing left to do, but MISRA requires this terminating else statement. */
@@ -1043,16 +1606,798 @@ static void TbxMbRtuDataReceived(tTbxMbUartPort         port,
 
 
 /************************************************************************************//**
-** \brief     Calculates the Modbus RTU defined CRC16 checksum over the bytes in the
-**            specified data array.
+** \brief     Event function to signal the progress of the data reception, which was
+**            started with TbxMbUartReceiveStart(), to this module. Only used when
+**            TBX_MB_UART_RX_DMA_ENABLE is configured to a value > 0. The received bytes
+**            are already stored in the ADU of the reception packet.
+** \attention This function should be called by the UART module upon detection of an
+**            idle line or a receiver timeout. Typically from an interrupt.
+** \param     port The serial port that the data reception progressed on.
+** \param     len Total number of bytes received so far, starting at the beginning of
+**            the ADU.
+**
+****************************************************************************************/
+static void TbxMbRtuReceiveProgress(tTbxMbUartPort port,
+                                    uint16_t       len)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((port < TBX_MB_UART_NUM_PORT) && 
+             (len > 0U));
+
+  /* Only continue with valid parameters. */
+  if ((port < TBX_MB_UART_NUM_PORT) && 
+      (len > 0U))
+  {
+    /* Obtain transport layer context linked to UART port of this event. */
+    tTbxMbTpCtx volatile * tpCtx = tbxMbRtuCtx[port];
+    /* Verify transport layer context. */
+    TBX_ASSERT(tpCtx != NULL)
+    /* Only continue with a valid transport layer context. Note that there is no need
+     * to also check the transport layer type, because only RTU types are stored in the
+     * tbxMbRtuCtx[] array.
+     */
+    if (tpCtx != NULL)
+    {
+      /* Get current time in RTU timer ticks. */
+      uint16_t currentTime = TbxMbPortTimerCount();
+      TbxCriticalSectionEnter();
+      /* Store the reception timestamp. */
+      tpCtx->rxTime = currentTime;
+      /* Get copy of the state so the we can exit the critical section. */
+      uint8_t stateCopy = tpCtx->state;
+      TbxCriticalSectionExit();
+      /* Are we in the RECEPTION state? Make sure to check this one first, as it will 
+       * happen the most.
+       */
+      if (stateCopy == TBX_MB_RTU_STATE_RECEPTION)
+      {
+        TbxCriticalSectionEnter();
+        /* Only process the bytes that were not yet reported earlier. */
+        if (len > tpCtx->rxAduWrIdx)
+        {
+          #if (TBX_MB_RTU_EARLY_FRAME_END_ENABLE > 0U)
+          uint16_t oldWrIdx = tpCtx->rxAduWrIdx;
+          #endif
+          /* Update the write indexer into the ADU reception packet. */
+          tpCtx->rxAduWrIdx = len;
+          /* Check if the received data still fits. Note that an ADU on RTU can have
+           * max 256 bytes, which is also the size of the reception buffer.
+           */
+          if (len > 256U)
+          {
+            /* Flag frame as not okay (NOK). */
+            tpCtx->rxAduOkay = TBX_FALSE;
+          }
+          #if (TBX_MB_RTU_EARLY_FRAME_END_ENABLE > 0U)
+          else
+          {
+            /* Check if this completed the packet. The cast removes the volatile
+             * qualifier. This is okay, because the reception buffer is not modified
+             * while checking the ADU bytes that were already received.
+             */
+            uint8_t const * aduPtr = 
+              (uint8_t const *)&tpCtx->rxPacket->head[TBX_MB_TP_ADU_HEAD_LEN_MAX-1U];
+            TbxMbRtuRxFrameEndCheck(tpCtx, &aduPtr[oldWrIdx], 
+                                    (uint16_t)(len - oldWrIdx));
+          }
+          #endif
+        }
+        TbxCriticalSectionExit();
+        #if (TBX_MB_UART_TIMER_ENABLE > 0U)
+        /* Restart the detection of the 3.5 character idle time. */
+        TbxMbRtuRxTimerRestart(tpCtx);
+        #endif
+      }
+      /* Are we in the IDLE state? */
+      else if (stateCopy == TBX_MB_RTU_STATE_IDLE)
+      {
+        #if (TBX_MB_TRACE_ENABLE > 0U)
+        /* Timestamp the reception start of the packet. */
+        TbxMbTraceMark(tpCtx, TBX_MB_TRACE_POINT_RX_START);
+        #endif
+        TbxCriticalSectionEnter();
+        /* Transition to the RECEIVING state. */
+        tpCtx->state = TBX_MB_RTU_STATE_RECEPTION;
+        /* Initialize the write indexer into the ADU reception packet, while taking into
+         * account the bytes that were already received.
+         */
+        tpCtx->rxAduWrIdx = len;
+        /* Initialize frame OK/NOK flag to okay so far. */
+        tpCtx->rxAduOkay = (len <= 256U) ? TBX_TRUE : TBX_FALSE;
+        /* Initialize the early end of packet detection. */
+        tpCtx->rxAduDone = TBX_FALSE;
+        #if (TBX_MB_RTU_EARLY_FRAME_END_ENABLE > 0U)
+        tpCtx->rxAduLen = TBX_MB_RTU_ADU_LEN_PENDING;
+        tpCtx->rxCrc = TBX_MB_RTU_CRC_INIT;
+        if (tpCtx->rxAduOkay == TBX_TRUE)
+        {
+          /* Check if this already completed the packet. The cast removes the volatile
+           * qualifier. This is okay, because the reception buffer is not modified while
+           * checking the ADU bytes that were already received.
+           */
+          TbxMbRtuRxFrameEndCheck(tpCtx,
+            (uint8_t const *)&tpCtx->rxPacket->head[TBX_MB_TP_ADU_HEAD_LEN_MAX-1U], len);
+        }
+        #endif
+        TbxCriticalSectionExit();
+        /* Start the detection of the 3.5 character idle time, which marks the end of
+         * the packet.
+         */
+        #if (TBX_MB_UART_TIMER_ENABLE > 0U)
+        TbxMbRtuRxTimerRestart(tpCtx);
+        #else
+        TbxMbRtuIdleTimeStart(tpCtx, TBX_TRUE);
+        #endif
+      }
+      #if (TBX_MB_UART_TIMER_ENABLE > 0U)
+      /* Are we in the INIT state? Each received byte restarts the detection of the 3.5
+       * character idle time, after which it's time to transition to IDLE.
+       */
+      else if (stateCopy == TBX_MB_RTU_STATE_INIT)
+      {
+        TbxMbRtuIdleTimeStart(tpCtx, TBX_TRUE);
+      }
+      #endif
+      else
+      {
+        /* Nothing left to do, but MISRA requires this terminating else statement. */
+      }
+    }
+  }
+} /*** end of TbxMbRtuReceiveProgress ***/
+
+
+/************************************************************************************//**
+** \brief     Event function to signal the expiration of the one-shot timer to this
+**            module. Only used when TBX_MB_UART_TIMER_ENABLE is configured to a value
+**            > 0.
+** \attention This function should be called by the UART module. Typically from an
+**            interrupt.
+** \param     port The serial port that the timer expired for.
+**
+****************************************************************************************/
+static void TbxMbRtuTimerExpired(tTbxMbUartPort port)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(port < TBX_MB_UART_NUM_PORT);
+
+  /* Only continue with valid parameters. */
+  if (port < TBX_MB_UART_NUM_PORT)
+  {
+    /* Obtain transport layer context linked to UART port of this event. */
+    tTbxMbTpCtx volatile * tpCtx = tbxMbRtuCtx[port];
+    /* Verify transport layer context. */
+    TBX_ASSERT(tpCtx != NULL)
+    /* Only continue with a valid transport layer context. Note that there is no need
+     * to also check the transport layer type, because only RTU types are stored in the
+     * tbxMbRtuCtx[] array.
+     */
+    if (tpCtx != NULL)
+    {
+      /* Instruct the event task to perform the state transitions that depend on the 
+       * 3.5 character idle time.
+       */
+      tTbxMbEvent newEvent;
+      newEvent.context = (void *)tpCtx;
+      newEvent.id = TBX_MB_EVENT_ID_TIMER_EXPIRED;
+      TbxMbOsalEventPost(&newEvent, TBX_TRUE);
+    }
+  }
+} /*** end of TbxMbRtuTimerExpired ***/
+
+
+/************************************************************************************//**
+** \brief     Calculates the 1.5 or 3.5 character time in timer ticks.
+** \details   On RTU, one character equals 11 bits: start-bit, 8 data-bits, parity-bit
+**            and stop-bit. In case no parity is used, 2 stop-bits are required by the
+**            protocol. The character time in seconds is therefore 11 / baudrate. The
+**            number of timer ticks for a number of half characters is:
+**
+**            ticks = 11 * halfChars * tickFreq / (2 * baudrate)
+**
+**            For baudrates greater than 19200 bits/sec, the protocol specifies fixed
+**            times instead, unless TBX_MB_RTU_SCALED_TIMING_ENABLE is enabled. The
+**            number of timer ticks is then:
+**
+**            ticks = fixedUs * tickFreq / 1000000
+**
+**            Both calculations do integer roundup and add one extra tick to adjust for
+**            the timer resolution inaccuracy.
+** \param     baudBps Communication speed in bits per second.
+** \param     halfChars Number of half characters. 3 for t1_5 and 7 for t3_5.
+** \param     fixedUs Fixed time in microseconds for baudrates greater than 19200.
+** \param     tickFreq Frequency of the timer in Hz.
+** \return    Character time in timer ticks.
+**
+****************************************************************************************/
+static uint16_t TbxMbRtuCharTicks(uint32_t baudBps,
+                                  uint8_t  halfChars,
+                                  uint16_t fixedUs,
+                                  uint32_t tickFreq)
+{
+  /* Start out with the character time calculation. */
+  uint32_t numerator = 11UL * halfChars * tickFreq;
+  uint32_t denominator = 2UL * baudBps;
+
+  #if (TBX_MB_RTU_SCALED_TIMING_ENABLE == 0U)
+  /* Use the fixed time for baudrates greater than 19200 bits/sec. */
+  if (baudBps > 19200UL)
+  {
+    /* Note that the timer frequency is a multiple of 1000. */
+    numerator = fixedUs * (tickFreq / 1000UL);
+    denominator = 1000UL;
+  }
+  #else
+  TBX_UNUSED_ARG(fixedUs);
+  #endif
+  /* Do integer roundup (A + (B-1)) / B and add one extra tick. Give the result back to
+   * the caller.
+   */
+  return (uint16_t)(((numerator + (denominator - 1UL)) / denominator) + 1UL);
+} /*** end of TbxMbRtuCharTicks ***/
+
+
+/************************************************************************************//**
+** \brief     Starts the detection of the 3.5 character idle time on the serial line. By
+**            default, this instructs the event task to start calling our polling
+**            function, which compares the free running counter value of the timer.
+**            When TBX_MB_UART_TIMER_ENABLE is configured to a value > 0, it (re)starts
+**            the one-shot timer instead.
+** \param     tpCtx Pointer to the RTU transport layer context.
+** \param     fromIsr TBX_TRUE when calling this function from an interrupt, TBX_FALSE
+**            otherwise.
+**
+****************************************************************************************/
+static void TbxMbRtuIdleTimeStart(tTbxMbTpCtx volatile * tpCtx,
+                                  uint8_t                fromIsr)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(tpCtx != NULL);
+
+  /* Only continue with valid parameters. */
+  if (tpCtx != NULL)
+  {
+    #if (TBX_MB_UART_TIMER_ENABLE > 0U)
+    TBX_UNUSED_ARG(fromIsr);
+    /* Start the one-shot timer, which expires after the 3.5 character idle time. */
+    TbxMbUartTimerStart(tpCtx->port, tpCtx->t3_5TimerTicks);
+    #else
+    /* Instruct the event task to start calling our polling function. */
+    tTbxMbEvent newEvent;
+    newEvent.context = (void *)tpCtx;
+    newEvent.id = TBX_MB_EVENT_ID_START_POLLING;
+    TbxMbOsalEventPost(&newEvent, fromIsr);
+    #endif
+  }
+} /*** end of TbxMbRtuIdleTimeStart ***/
+
+
+/************************************************************************************//**
+** \brief     Stops the detection of the 3.5 character idle time on the serial line.
+**            Should only be called from the event task.
+** \param     tpCtx Pointer to the RTU transport layer context.
+**
+****************************************************************************************/
+static void TbxMbRtuIdleTimeStop(tTbxMbTpCtx volatile * tpCtx)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(tpCtx != NULL);
+
+  /* Only continue with valid parameters. */
+  if (tpCtx != NULL)
+  {
+    #if (TBX_MB_UART_TIMER_ENABLE > 0U)
+    /* Stop the one-shot timer. It most likely already expired, but not in case the end
+     * of the packet was detected early.
+     */
+    TbxMbUartTimerStop(tpCtx->port);
+    #else
+    /* Instruct the event task to stop calling our polling function. */
+    tTbxMbEvent newEvent;
+    newEvent.context = (void *)tpCtx;
+    newEvent.id = TBX_MB_EVENT_ID_STOP_POLLING;
+    TbxMbOsalEventPost(&newEvent, TBX_FALSE);
+    #endif
+  }
+} /*** end of TbxMbRtuIdleTimeStop ***/
+
+
+#if (TBX_MB_UART_TIMER_ENABLE > 0U)
+/************************************************************************************//**
+** \brief     Restarts the detection of the 3.5 character idle time, after receiving
+**            new data in the RECEPTION state. In case the early end of packet detection
+**            already detected the end of the packet, there is no need to wait for the 
+**            idle time. The event task is then instructed right away to process the 
+**            packet.
+** \attention This function should be called from the reception path, typically at
+**            interrupt level.
+** \param     tpCtx Pointer to the RTU transport layer context.
+**
+****************************************************************************************/
+static void TbxMbRtuRxTimerRestart(tTbxMbTpCtx volatile * tpCtx)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(tpCtx != NULL);
+
+  /* Only continue with valid parameters. */
+  if (tpCtx != NULL)
+  {
+    TbxCriticalSectionEnter();
+    uint8_t rxAduDoneCpy = tpCtx->rxAduDone;
+    TbxCriticalSectionExit();
+    /* End of the packet not yet detected? */
+    if (rxAduDoneCpy == TBX_FALSE)
+    {
+      /* Restart the one-shot timer, which expires after the 3.5 character idle time. */
+      TbxMbUartTimerStart(tpCtx->port, tpCtx->t3_5TimerTicks);
+    }
+    else
+    {
+      /* Stop the one-shot timer and instruct the event task to process the packet. */
+      TbxMbUartTimerStop(tpCtx->port);
+      tTbxMbEvent newEvent;
+      newEvent.context = (void *)tpCtx;
+      newEvent.id = TBX_MB_EVENT_ID_TIMER_EXPIRED;
+      TbxMbOsalEventPost(&newEvent, TBX_TRUE);
+    }
+  }
+} /*** end of TbxMbRtuRxTimerRestart ***/
+#endif
+
+
+#if (TBX_MB_UART_RX_DMA_ENABLE > 0U)
+/************************************************************************************//**
+** \brief     Starts the data reception directly into the ADU of the reception packet.
+**            The reception always starts at the beginning of the ADU, which makes it
+**            possible to receive the packet without copying its bytes.
+** \param     tpCtx Pointer to the RTU transport layer context.
+**
+****************************************************************************************/
+static void TbxMbRtuRxDmaStart(tTbxMbTpCtx volatile * tpCtx)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(tpCtx != NULL);
+
+  /* Only continue with valid parameters. */
+  if (tpCtx != NULL)
+  {
+    /* The ADU for an RTU packet starts at one byte before the PDU, which is the last
+     * byte of head[]. It can have max 256 bytes:
+     * - Node address (1 byte)
+     * - Function code (1 byte)
+     * - Packet data (max 252 bytes)
+     * - CRC16 (2 bytes)
+     * The reception packet is only written by the reception hardware from now on,
+     * until the next transition to the VALIDATION state.
+     */
+    TbxMbUartReceiveStart(tpCtx->port,
+                          &tpCtx->rxPacket->head[TBX_MB_TP_ADU_HEAD_LEN_MAX-1U], 256U);
+  }
+} /*** end of TbxMbRtuRxDmaStart ***/
+#endif
+
+
+#if (TBX_MB_RTU_EARLY_FRAME_END_ENABLE > 0U)
+/************************************************************************************//**
+** \brief     Adds the newly received bytes to the running CRC16 of the ADU reception
+**            packet and checks if these bytes completed the packet. This is the case if
+**            the predicted packet length is reached and the CRC16 is valid.
+** \attention This function should be called from TbxMbRtuDataReceived() or
+**            TbxMbRtuReceiveProgress(), after the received bytes were appended to the
+**            ADU and from within a critical section.
+** \param     tpCtx Pointer to the RTU transport layer context.
+** \param     data Byte array with newly received data.
+** \param     len Number of newly received bytes.
+**
+****************************************************************************************/
+static void TbxMbRtuRxFrameEndCheck(tTbxMbTpCtx volatile * tpCtx,
+                                    uint8_t        const * data,
+                                    uint16_t               len)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((tpCtx != NULL) && (data != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((tpCtx != NULL) && (data != NULL))
+  {
+    /* Add the newly received bytes to the running CRC16. */
+    tpCtx->rxCrc = TbxMbRtuCrcUpdate(tpCtx->rxCrc, data, len);
+    /* Attempt to predict the packet length, if not yet done so successfully. */
+    if (tpCtx->rxAduLen == TBX_MB_RTU_ADU_LEN_PENDING)
+    {
+      /* A passive bus monitor doesn't know if the packet is a request or a response.
+       * The 3.5 character idle time then marks the end of the packet, as usual.
+       */
+      if (tpCtx->isMonitor == TBX_TRUE)
+      {
+        tpCtx->rxAduLen = TBX_MB_RTU_ADU_LEN_UNKNOWN;
+      }
+      else
+      {
+        tpCtx->rxAduLen = TbxMbRtuAduLenPredict(
+                            &tpCtx->rxPacket->head[TBX_MB_TP_ADU_HEAD_LEN_MAX-1U],
+                            tpCtx->rxAduWrIdx, tpCtx->isClient);
+      }
+    }
+    /* Packet complete? Note that a mismatch with the predicted length is no reason to
+     * flag the packet as not okay (NOK). It's just that the 3.5 character idle time then
+     * marks the end of the packet, as usual.
+     */
+    if ((tpCtx->rxAduWrIdx == tpCtx->rxAduLen) && 
+        (tpCtx->rxCrc == TBX_MB_RTU_CRC_RESIDUE))
+    {
+      tpCtx->rxAduDone = TBX_TRUE;
+    }
+  }
+} /*** end of TbxMbRtuRxFrameEndCheck ***/
+
+
+/************************************************************************************//**
+** \brief     Predicts the total length of an ADU reception packet, based on its function
+**            code and, for function codes with a variable length, its byte count field.
+**            Only the function codes defined in the Modbus application protocol, for
+**            which the length can be determined from the first bytes, are supported.
+** \param     aduPtr Pointer to the start of the ADU reception packet.
+** \param     len Number of ADU bytes received so far.
+** \param     isClient TBX_TRUE if the packet is a response received by a client,
+**            TBX_FALSE if it is a request received by a server.
+** \return    Predicted packet length, including node address and CRC16.
+**            TBX_MB_RTU_ADU_LEN_PENDING if more bytes are needed for the prediction or
+**            TBX_MB_RTU_ADU_LEN_UNKNOWN if the length cannot be predicted.
+**
+****************************************************************************************/
+static uint16_t TbxMbRtuAduLenPredict(uint8_t const volatile * aduPtr,
+                                      uint16_t                 len,
+                                      uint8_t                  isClient)
+{
+  uint16_t result = TBX_MB_RTU_ADU_LEN_UNKNOWN;
+  /* Index of the byte count field in the ADU. Zero if the length is fixed. */
+  uint8_t  cntIdx = 0U;
+  /* Packet length, excluding the number of bytes set by the byte count field. */
+  uint16_t baseLen = 0U;
+
+  /* Verify parameters. */
+  TBX_ASSERT(aduPtr != NULL);
+
+  /* Only continue with valid parameters. The function code is in the second byte. */
+  if (aduPtr != NULL)
+  {
+    /* Function code not yet received? */
+    if (len < 2U)
+    {
+      result = TBX_MB_RTU_ADU_LEN_PENDING;
+    }
+    /* Predict the length of a request, as received by a server. */
+    else if (isClient == TBX_FALSE)
+    {
+      switch (aduPtr[1])
+      {
+        case TBX_MB_FC01_READ_COILS:
+        case TBX_MB_FC02_READ_DISCRETE_INPUTS:
+        case TBX_MB_FC03_READ_HOLDING_REGISTERS:
+        case TBX_MB_FC04_READ_INPUT_REGISTERS:
+        case TBX_MB_FC05_WRITE_SINGLE_COIL:
+        case TBX_MB_FC06_WRITE_SINGLE_REGISTER:
+        {
+          /* Node, code, address (2), quantity or value (2) and CRC16 (2). */
+          baseLen = 8U;
+        }
+        break;
+
+        case TBX_MB_FC15_WRITE_MULTIPLE_COILS:
+        case TBX_MB_FC16_WRITE_MULTIPLE_REGISTERS:
+        {
+          /* Node, code, address (2), quantity (2), byte count and CRC16 (2). */
+          baseLen = 9U;
+          cntIdx = 6U;
+        }
+        break;
+
+        case TBX_MB_FC22_MASK_WRITE_REGISTER:
+        {
+          /* Node, code, address (2), AND mask (2), OR mask (2) and CRC16 (2). */
+          baseLen = 10U;
+        }
+        break;
+
+        case TBX_MB_FC23_READ_WRITE_MULTIPLE_REGISTERS:
+        {
+          /* Node, code, read address (2), read quantity (2), write address (2), write
+           * quantity (2), byte count and CRC16 (2).
+           */
+          baseLen = 13U;
+          cntIdx = 10U;
+        }
+        break;
+
+        case TBX_MB_FC20_READ_FILE_RECORD:
+        case TBX_MB_FC21_WRITE_FILE_RECORD:
+        {
+          /* Node, code, byte count and CRC16 (2). */
+          baseLen = 5U;
+          cntIdx = 2U;
+        }
+        break;
+
+        default:
+        {
+          /* Function code not supported. Keep the length unknown. */
+        }
+        break;
+      }
+    }
+    /* Predict the length of a response, as received by a client. */
+    else
+    {
+      /* Exception response? */
+      if ((aduPtr[1] & TBX_MB_FC_EXCEPTION_MASK) == TBX_MB_FC_EXCEPTION_MASK)
+      {
+        /* Node, code, exception code and CRC16 (2). */
+        baseLen = 5U;
+      }
+      else
+      {
+        switch (aduPtr[1])
+        {
+          case TBX_MB_FC01_READ_COILS:
+          case TBX_MB_FC02_READ_DISCRETE_INPUTS:
+          case TBX_MB_FC03_READ_HOLDING_REGISTERS:
+          case TBX_MB_FC04_READ_INPUT_REGISTERS:
+          case TBX_MB_FC20_READ_FILE_RECORD:
+          case TBX_MB_FC21_WRITE_FILE_RECORD:
+          case TBX_MB_FC23_READ_WRITE_MULTIPLE_REGISTERS:
+          {
+            /* Node, code, byte count and CRC16 (2). */
+            baseLen = 5U;
+            cntIdx = 2U;
+          }
+          break;
+
+          case TBX_MB_FC05_WRITE_SINGLE_COIL:
+          case TBX_MB_FC06_WRITE_SINGLE_REGISTER:
+          case TBX_MB_FC15_WRITE_MULTIPLE_COILS:
+          case TBX_MB_FC16_WRITE_MULTIPLE_REGISTERS:
+          {
+            /* Node, code, address (2), quantity or value (2) and CRC16 (2). */
+            baseLen = 8U;
+          }
+          break;
+
+          case TBX_MB_FC22_MASK_WRITE_REGISTER:
+          {
+            /* Node, code, address (2), AND mask (2), OR mask (2) and CRC16 (2). */
+            baseLen = 10U;
+          }
+          break;
+
+          default:
+          {
+            /* Function code not supported. Keep the length unknown. */
+          }
+          break;
+        }
+      }
+    }
+    /* Function code supported? */
+    if (baseLen > 0U)
+    {
+      /* Fixed packet length? */
+      if (cntIdx == 0U)
+      {
+        result = baseLen;
+      }
+      /* Byte count field not yet received? */
+      else if (len <= cntIdx)
+      {
+        result = TBX_MB_RTU_ADU_LEN_PENDING;
+      }
+      /* Add the byte count. Keep the length unknown if it exceeds the max ADU length. */
+      else if ((baseLen + aduPtr[cntIdx]) <= 256U)
+      {
+        result = baseLen + aduPtr[cntIdx];
+      }
+      else
+      {
+        /* Nothing left to do, but MISRA requires this terminating else statement. */
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbRtuAduLenPredict ***/
+#endif
+
+
+/************************************************************************************//**
+** \brief     Updates the Modbus RTU defined CRC16 checksum with the bytes in the
+**            specified data array. Start with TBX_MB_RTU_CRC_INIT as the CRC16 value,
+**            when calculating the checksum over a new packet. Thanks to this approach,
+**            the checksum can be calculated in one go, or incrementally in several
+**            smaller steps, for example while packet bytes are still being received.
+**            Not static, such that the benchmark program can measure its throughput.
+** \param     crc Current CRC16 checksum value.
 ** \param     data Pointer to the byte array with data.
 ** \param     len Number of data bytes to include in the CRC16 calculation.
-** \return    The calculated CRC16 checksum value.
+** \return    The updated CRC16 checksum value.
 **
 ****************************************************************************************/
-static uint16_t TbxMbRtuCalculatCrc(uint8_t  const * data, 
-                                    uint16_t         len)
+uint16_t TbxMbRtuCrcUpdate(uint16_t         crc,
+                           uint8_t  const * data, 
+                           uint16_t         len)
 {
+  uint16_t result = crc;
+
+#if (TBX_MB_RTU_CRC_METHOD == TBX_MB_RTU_CRC_METHOD_PORT)
+  /* Pass the calculation on to the CRC hardware peripheral. */
+  result = TbxMbPortCrcUpdate(crc, data, len);
+#elif (TBX_MB_RTU_CRC_METHOD == TBX_MB_RTU_CRC_METHOD_SLICING4)
+  /* Lookup tables for slicing-by-4 CRC16 calculation. The first one is the same as the
+   * one for the byte-wise calculation. Each next one holds the values of the previous
+   * one, shifted by one more byte. Made static to lower the stack load.
+   */
+  static const uint16_t tbxMbRtuCrcTable[4][256] =
+  {
+    {
+      0x0000, 0xC0C1, 0xC181, 0x0140, 0xC301, 0x03C0, 0x0280, 0xC241,
+      0xC601, 0x06C0, 0x0780, 0xC741, 0x0500, 0xC5C1, 0xC481, 0x0440,
+      0xCC01, 0x0CC0, 0x0D80, 0xCD41, 0x0F00, 0xCFC1, 0xCE81, 0x0E40,
+      0x0A00, 0xCAC1, 0xCB81, 0x0B40, 0xC901, 0x09C0, 0x0880, 0xC841,
+      0xD801, 0x18C0, 0x1980, 0xD941, 0x1B00, 0xDBC1, 0xDA81, 0x1A40,
+      0x1E00, 0xDEC1, 0xDF81, 0x1F40, 0xDD01, 0x1DC0, 0x1C80, 0xDC41,
+      0x1400, 0xD4C1, 0xD581, 0x1540, 0xD701, 0x17C0, 0x1680, 0xD641,
+      0xD201, 0x12C0, 0x1380, 0xD341, 0x1100, 0xD1C1, 0xD081, 0x1040,
+      0xF001, 0x30C0, 0x3180, 0xF141, 0x3300, 0xF3C1, 0xF281, 0x3240,
+      0x3600, 0xF6C1, 0xF781, 0x3740, 0xF501, 0x35C0, 0x3480, 0xF441,
+      0x3C00, 0xFCC1, 0xFD81, 0x3D40, 0xFF01, 0x3FC0, 0x3E80, 0xFE41,
+      0xFA01, 0x3AC0, 0x3B80, 0xFB41, 0x3900, 0xF9C1, 0xF881, 0x3840,
+      0x2800, 0xE8C1, 0xE981, 0x2940, 0xEB01, 0x2BC0, 0x2A80, 0xEA41,
+      0xEE01, 0x2EC0, 0x2F80, 0xEF41, 0x2D00, 0xEDC1, 0xEC81, 0x2C40,
+      0xE401, 0x24C0, 0x2580, 0xE541, 0x2700, 0xE7C1, 0xE681, 0x2640,
+      0x2200, 0xE2C1, 0xE381, 0x2340, 0xE101, 0x21C0, 0x2080, 0xE041,
+      0xA001, 0x60C0, 0x6180, 0xA141, 0x6300, 0xA3C1, 0xA281, 0x6240,
+      0x6600, 0xA6C1, 0xA781, 0x6740, 0xA501, 0x65C0, 0x6480, 0xA441,
+      0x6C00, 0xACC1, 0xAD81, 0x6D40, 0xAF01, 0x6FC0, 0x6E80, 0xAE41,
+      0xAA01, 0x6AC0, 0x6B80, 0xAB41, 0x6900, 0xA9C1, 0xA881, 0x6840,
+      0x7800, 0xB8C1, 0xB981, 0x7940, 0xBB01, 0x7BC0, 0x7A80, 0xBA41,
+      0xBE01, 0x7EC0, 0x7F80, 0xBF41, 0x7D00, 0xBDC1, 0xBC81, 0x7C40,
+      0xB401, 0x74C0, 0x7580, 0xB541, 0x7700, 0xB7C1, 0xB681, 0x7640,
+      0x7200, 0xB2C1, 0xB381, 0x7340, 0xB101, 0x71C0, 0x7080, 0xB041,
+      0x5000, 0x90C1, 0x9181, 0x5140, 0x9301, 0x53C0, 0x5280, 0x9241,
+      0x9601, 0x56C0, 0x5780, 0x9741, 0x5500, 0x95C1, 0x9481, 0x5440,
+      0x9C01, 0x5CC0, 0x5D80, 0x9D41, 0x5F00, 0x9FC1, 0x9E81, 0x5E40,
+      0x5A00, 0x9AC1, 0x9B81, 0x5B40, 0x9901, 0x59C0, 0x5880, 0x9841,
+      0x8801, 0x48C0, 0x4980, 0x8941, 0x4B00, 0x8BC1, 0x8A81, 0x4A40,
+      0x4E00, 0x8EC1, 0x8F81, 0x4F40, 0x8D01, 0x4DC0, 0x4C80, 0x8C41,
+      0x4400, 0x84C1, 0x8581, 0x4540, 0x8701, 0x47C0, 0x4680, 0x8641,
+      0x8201, 0x42C0, 0x4380, 0x8341, 0x4100, 0x81C1, 0x8081, 0x4040
+    },
+    {
+      0x0000, 0x9001, 0x6001, 0xF000, 0xC002, 0x5003, 0xA003, 0x3002,
+      0xC007, 0x5006, 0xA006, 0x3007, 0x0005, 0x9004, 0x6004, 0xF005,
+      0xC00D, 0x500C, 0xA00C, 0x300D, 0x000F, 0x900E, 0x600E, 0xF00F,
+      0x000A, 0x900B, 0x600B, 0xF00A, 0xC008, 0x5009, 0xA009, 0x3008,
+      0xC019, 0x5018, 0xA018, 0x3019, 0x001B, 0x901A, 0x601A, 0xF01B,
+      0x001E, 0x901F, 0x601F, 0xF01E, 0xC01C, 0x501D, 0xA01D, 0x301C,
+      0x0014, 0x9015, 0x6015, 0xF014, 0xC016, 0x5017, 0xA017, 0x3016,
+      0xC013, 0x5012, 0xA012, 0x3013, 0x0011, 0x9010, 0x6010, 0xF011,
+      0xC031, 0x5030, 0xA030, 0x3031, 0x0033, 0x9032, 0x6032, 0xF033,
+      0x0036, 0x9037, 0x6037, 0xF036, 0xC034, 0x5035, 0xA035, 0x3034,
+      0x003C, 0x903D, 0x603D, 0xF03C, 0xC03E, 0x503F, 0xA03F, 0x303E,
+      0xC03B, 0x503A, 0xA03A, 0x303B, 0x0039, 0x9038, 0x6038, 0xF039,
+      0x0028, 0x9029, 0x6029, 0xF028, 0xC02A, 0x502B, 0xA02B, 0x302A,
+      0xC02F, 0x502E, 0xA02E, 0x302F, 0x002D, 0x902C, 0x602C, 0xF02D,
+      0xC025, 0x5024, 0xA024, 0x3025, 0x0027, 0x9026, 0x6026, 0xF027,
+      0x0022, 0x9023, 0x6023, 0xF022, 0xC020, 0x5021, 0xA021, 0x3020,
+      0xC061, 0x5060, 0xA060, 0x3061, 0x0063, 0x9062, 0x6062, 0xF063,
+      0x0066, 0x9067, 0x6067, 0xF066, 0xC064, 0x5065, 0xA065, 0x3064,
+      0x006C, 0x906D, 0x606D, 0xF06C, 0xC06E, 0x506F, 0xA06F, 0x306E,
+      0xC06B, 0x506A, 0xA06A, 0x306B, 0x0069, 0x9068, 0x6068, 0xF069,
+      0x0078, 0x9079, 0x6079, 0xF078, 0xC07A, 0x507B, 0xA07B, 0x307A,
+      0xC07F, 0x507E, 0xA07E, 0x307F, 0x007D, 0x907C, 0x607C, 0xF07D,
+      0xC075, 0x5074, 0xA074, 0x3075, 0x0077, 0x9076, 0x6076, 0xF077,
+      0x0072, 0x9073, 0x6073, 0xF072, 0xC070, 0x5071, 0xA071, 0x3070,
+      0x0050, 0x9051, 0x6051, 0xF050, 0xC052, 0x5053, 0xA053, 0x3052,
+      0xC057, 0x5056, 0xA056, 0x3057, 0x0055, 0x9054, 0x6054, 0xF055,
+      0xC05D, 0x505C, 0xA05C, 0x305D, 0x005F, 0x905E, 0x605E, 0xF05F,
+      0x005A, 0x905B, 0x605B, 0xF05A, 0xC058, 0x5059, 0xA059, 0x3058,
+      0xC049, 0x5048, 0xA048, 0x3049, 0x004B, 0x904A, 0x604A, 0xF04B,
+      0x004E, 0x904F, 0x604F, 0xF04E, 0xC04C, 0x504D, 0xA04D, 0x304C,
+      0x0044, 0x9045, 0x6045, 0xF044, 0xC046, 0x5047, 0xA047, 0x3046,
+      0xC043, 0x5042, 0xA042, 0x3043, 0x0041, 0x9040, 0x6040, 0xF041
+    },
+    {
+      0x0000, 0xC051, 0xC0A1, 0x00F0, 0xC141, 0x0110, 0x01E0, 0xC1B1,
+      0xC281, 0x02D0, 0x0220, 0xC271, 0x03C0, 0xC391, 0xC361, 0x0330,
+      0xC501, 0x0550, 0x05A0, 0xC5F1, 0x0440, 0xC411, 0xC4E1, 0x04B0,
+      0x0780, 0xC7D1, 0xC721, 0x0770, 0xC6C1, 0x0690, 0x0660, 0xC631,
+      0xCA01, 0x0A50, 0x0AA0, 0xCAF1, 0x0B40, 0xCB11, 0xCBE1, 0x0BB0,
+      0x0880, 0xC8D1, 0xC821, 0x0870, 0xC9C1, 0x0990, 0x0960, 0xC931,
+      0x0F00, 0xCF51, 0xCFA1, 0x0FF0, 0xCE41, 0x0E10, 0x0EE0, 0xCEB1,
+      0xCD81, 0x0DD0, 0x0D20, 0xCD71, 0x0CC0, 0xCC91, 0xCC61, 0x0C30,
+      0xD401, 0x1450, 0x14A0, 0xD4F1, 0x1540, 0xD511, 0xD5E1, 0x15B0,
+      0x1680, 0xD6D1, 0xD621, 0x1670, 0xD7C1, 0x1790, 0x1760, 0xD731,
+      0x1100, 0xD151, 0xD1A1, 0x11F0, 0xD041, 0x1010, 0x10E0, 0xD0B1,
+      0xD381, 0x13D0, 0x1320, 0xD371, 0x12C0, 0xD291, 0xD261, 0x1230,
+      0x1E00, 0xDE51, 0xDEA1, 0x1EF0, 0xDF41, 0x1F10, 0x1FE0, 0xDFB1,
+      0xDC81, 0x1CD0, 0x1C20, 0xDC71, 0x1DC0, 0xDD91, 0xDD61, 0x1D30,
+      0xDB01, 0x1B50, 0x1BA0, 0xDBF1, 0x1A40, 0xDA11, 0xDAE1, 0x1AB0,
+      0x1980, 0xD9D1, 0xD921, 0x1970, 0xD8C1, 0x1890, 0x1860, 0xD831,
+      0xE801, 0x2850, 0x28A0, 0xE8F1, 0x2940, 0xE911, 0xE9E1, 0x29B0,
+      0x2A80, 0xEAD1, 0xEA21, 0x2A70, 0xEBC1, 0x2B90, 0x2B60, 0xEB31,
+      0x2D00, 0xED51, 0xEDA1, 0x2DF0, 0xEC41, 0x2C10, 0x2CE0, 0xECB1,
+      0xEF81, 0x2FD0, 0x2F20, 0xEF71, 0x2EC0, 0xEE91, 0xEE61, 0x2E30,
+      0x2200, 0xE251, 0xE2A1, 0x22F0, 0xE341, 0x2310, 0x23E0, 0xE3B1,
+      0xE081, 0x20D0, 0x2020, 0xE071, 0x21C0, 0xE191, 0xE161, 0x2130,
+      0xE701, 0x2750, 0x27A0, 0xE7F1, 0x2640, 0xE611, 0xE6E1, 0x26B0,
+      0x2580, 0xE5D1, 0xE521, 0x2570, 0xE4C1, 0x2490, 0x2460, 0xE431,
+      0x3C00, 0xFC51, 0xFCA1, 0x3CF0, 0xFD41, 0x3D10, 0x3DE0, 0xFDB1,
+      0xFE81, 0x3ED0, 0x3E20, 0xFE71, 0x3FC0, 0xFF91, 0xFF61, 0x3F30,
+      0xF901, 0x3950, 0x39A0, 0xF9F1, 0x3840, 0xF811, 0xF8E1, 0x38B0,
+      0x3B80, 0xFBD1, 0xFB21, 0x3B70, 0xFAC1, 0x3A90, 0x3A60, 0xFA31,
+      0xF601, 0x3650, 0x36A0, 0xF6F1, 0x3740, 0xF711, 0xF7E1, 0x37B0,
+      0x3480, 0xF4D1, 0xF421, 0x3470, 0xF5C1, 0x3590, 0x3560, 0xF531,
+      0x3300, 0xF351, 0xF3A1, 0x33F0, 0xF241, 0x3210, 0x32E0, 0xF2B1,
+      0xF181, 0x31D0, 0x3120, 0xF171, 0x30C0, 0xF091, 0xF061, 0x3030
+    },
+    {
+      0x0000, 0xFC01, 0xB801, 0x4400, 0x3001, 0xCC00, 0x8800, 0x7401,
+      0x6002, 0x9C03, 0xD803, 0x2402, 0x5003, 0xAC02, 0xE802, 0x1403,
+      0xC004, 0x3C05, 0x7805, 0x8404, 0xF005, 0x0C04, 0x4804, 0xB405,
+      0xA006, 0x5C07, 0x1807, 0xE406, 0x9007, 0x6C06, 0x2806, 0xD407,
+      0xC00B, 0x3C0A, 0x780A, 0x840B, 0xF00A, 0x0C0B, 0x480B, 0xB40A,
+      0xA009, 0x5C08, 0x1808, 0xE409, 0x9008, 0x6C09, 0x2809, 0xD408,
+      0x000F, 0xFC0E, 0xB80E, 0x440F, 0x300E, 0xCC0F, 0x880F, 0x740E,
+      0x600D, 0x9C0C, 0xD80C, 0x240D, 0x500C, 0xAC0D, 0xE80D, 0x140C,
+      0xC015, 0x3C14, 0x7814, 0x8415, 0xF014, 0x0C15, 0x4815, 0xB414,
+      0xA017, 0x5C16, 0x1816, 0xE417, 0x9016, 0x6C17, 0x2817, 0xD416,
+      0x0011, 0xFC10, 0xB810, 0x4411, 0x3010, 0xCC11, 0x8811, 0x7410,
+      0x6013, 0x9C12, 0xD812, 0x2413, 0x5012, 0xAC13, 0xE813, 0x1412,
+      0x001E, 0xFC1F, 0xB81F, 0x441E, 0x301F, 0xCC1E, 0x881E, 0x741F,
+      0x601C, 0x9C1D, 0xD81D, 0x241C, 0x501D, 0xAC1C, 0xE81C, 0x141D,
+      0xC01A, 0x3C1B, 0x781B, 0x841A, 0xF01B, 0x0C1A, 0x481A, 0xB41B,
+      0xA018, 0x5C19, 0x1819, 0xE418, 0x9019, 0x6C18, 0x2818, 0xD419,
+      0xC029, 0x3C28, 0x7828, 0x8429, 0xF028, 0x0C29, 0x4829, 0xB428,
+      0xA02B, 0x5C2A, 0x182A, 0xE42B, 0x902A, 0x6C2B, 0x282B, 0xD42A,
+      0x002D, 0xFC2C, 0xB82C, 0x442D, 0x302C, 0xCC2D, 0x882D, 0x742C,
+      0x602F, 0x9C2E, 0xD82E, 0x242F, 0x502E, 0xAC2F, 0xE82F, 0x142E,
+      0x0022, 0xFC23, 0xB823, 0x4422, 0x3023, 0xCC22, 0x8822, 0x7423,
+      0x6020, 0x9C21, 0xD821, 0x2420, 0x5021, 0xAC20, 0xE820, 0x1421,
+      0xC026, 0x3C27, 0x7827, 0x8426, 0xF027, 0x0C26, 0x4826, 0xB427,
+      0xA024, 0x5C25, 0x1825, 0xE424, 0x9025, 0x6C24, 0x2824, 0xD425,
+      0x003C, 0xFC3D, 0xB83D, 0x443C, 0x303D, 0xCC3C, 0x883C, 0x743D,
+      0x603E, 0x9C3F, 0xD83F, 0x243E, 0x503F, 0xAC3E, 0xE83E, 0x143F,
+      0xC038, 0x3C39, 0x7839, 0x8438, 0xF039, 0x0C38, 0x4838, 0xB439,
+      0xA03A, 0x5C3B, 0x183B, 0xE43A, 0x903B, 0x6C3A, 0x283A, 0xD43B,
+      0xC037, 0x3C36, 0x7836, 0x8437, 0xF036, 0x0C37, 0x4837, 0xB436,
+      0xA035, 0x5C34, 0x1834, 0xE435, 0x9034, 0x6C35, 0x2835, 0xD434,
+      0x0033, 0xFC32, 0xB832, 0x4433, 0x3032, 0xCC33, 0x8833, 0x7432,
+      0x6031, 0x9C30, 0xD830, 0x2431, 0x5030, 0xAC31, 0xE831, 0x1430
+    }
+  };
+  uint16_t byteIdx = 0U;
+
+  /* Process four data bytes at a time, for as long as possible. */
+  while ((byteIdx + 4U) <= len)
+  {
+    /* Fold the first two data bytes into the CRC16 value. */
+    uint16_t value = result ^ (uint16_t)(data[byteIdx] | 
+                                         (uint16_t)(data[byteIdx + 1U] << 8U));
+    /* Look up the contribution of all four bytes. */
+    result = tbxMbRtuCrcTable[3][value & 0xFFU] ^ 
+             tbxMbRtuCrcTable[2][value >> 8U] ^
+             tbxMbRtuCrcTable[1][data[byteIdx + 2U]] ^ 
+             tbxMbRtuCrcTable[0][data[byteIdx + 3U]];
+    byteIdx += 4U;
+  }
+  /* Process the remaining data bytes one at a time. */
+  for (; byteIdx < len; byteIdx++)
+  {
+    /* Calculate the index into the CRC lookup table. */
+    uint8_t tableIdx = (uint8_t)(data[byteIdx] ^ result);
+    result >>= 8;
+    result ^= tbxMbRtuCrcTable[0][tableIdx];
+  }
+#else
   /* Lookup table for fast CRC16 calculation. Made static to lower the stack load. */
   static const uint16_t tbxMbRtuCrcTable[] =
   {
@@ -1089,22 +2434,19 @@ static uint16_t TbxMbRtuCalculatCrc(uint8_t  const * data,
     0x4400, 0x84C1, 0x8581, 0x4540, 0x8701, 0x47C0, 0x4680, 0x8641,
     0x8201, 0x42C0, 0x4380, 0x8341, 0x4100, 0x81C1, 0x8081, 0x4040
   };
-  uint16_t result = 0U;
-  uint16_t crc = 0xFFFFU;
 
   /* Loop over all the data bytes. */
   for (uint16_t byteIdx = 0; byteIdx < len; byteIdx++)
   {
     /* Calculate the index into the CRC lookup table. */
-    uint8_t tableIdx = data[byteIdx] ^ crc;
-    crc >>= 8;
-    crc ^= tbxMbRtuCrcTable[tableIdx];
+    uint8_t tableIdx = data[byteIdx] ^ result;
+    result >>= 8;
+    result ^= tbxMbRtuCrcTable[tableIdx];
   }
-  /* Update the result. */
-  result = crc;
+#endif
   /* Give the result back to the caller. */
   return result;
-} /*** end of TbxMbRtuCalculatCrc ***/
+} /*** end of TbxMbRtuCrcUpdate ***/
 
 
 /*********************************** end of tbxmb_rtu.c ********************************/
@@ -34,16 +34,47 @@
 extern "C" {
 #endif
 
+/****************************************************************************************
+* Macro definitions
+****************************************************************************************/
+/** \brief CRC16 calculation method with a byte-wise lookup table. */
+#define TBX_MB_RTU_CRC_METHOD_TABLE         (0U)
+
+/** \brief CRC16 calculation method with four lookup tables, processing four bytes at a
+ *         time (slicing-by-4).
+ */
+#define TBX_MB_RTU_CRC_METHOD_SLICING4      (1U)
+
+/** \brief CRC16 calculation method with the help of a hardware CRC peripheral, through
+ *         port function TbxMbPortCrcUpdate().
+ */
+#define TBX_MB_RTU_CRC_METHOD_PORT          (2U)
+
+
 /****************************************************************************************
 * Function prototypes
 ****************************************************************************************/
-tTbxMbTp TbxMbRtuCreate(uint8_t            nodeAddr, 
-                        tTbxMbUartPort     serialPort, 
-                        tTbxMbUartBaudrate baudrate, 
-                        tTbxMbUartStopbits stopbits,
-                        tTbxMbUartParity   parity);
+tTbxMbTp TbxMbRtuCreate       (uint8_t                  nodeAddr, 
+                               tTbxMbUartPort           serialPort, 
+                               tTbxMbUartBaudrate       baudrate, 
+                               tTbxMbUartStopbits       stopbits,
+                               tTbxMbUartParity         parity);
+
+tTbxMbTp TbxMbRtuCreateStatic (tTbxMbTpStorage        * storage,
+                               uint8_t                  nodeAddr, 
+                               tTbxMbUartPort           serialPort, 
+                               tTbxMbUartBaudrate       baudrate, 
+                               tTbxMbUartStopbits       stopbits,
+                               tTbxMbUartParity         parity);
+
+tTbxMbTp TbxMbRtuCreateCompact(tTbxMbTpCompactStorage * storage,
+                               uint8_t                  nodeAddr, 
+                               tTbxMbUartPort           serialPort, 
+                               tTbxMbUartBaudrate       baudrate, 
+                               tTbxMbUartStopbits       stopbits,
+                               tTbxMbUartParity         parity);
 
-void     TbxMbRtuFree  (tTbxMbTp           transport);
+void     TbxMbRtuFree         (tTbxMbTp                 transport);
 
 #ifdef __cplusplus
 }
@@ -46,46 +46,281 @@
 #define TBX_MB_SERVER_CONTEXT_TYPE     (37U)
 
 
+/****************************************************************************************
+* Configuration check
+****************************************************************************************/
+#if (TBX_MB_SERVER_CACHE_SIZE > 255U)
+#error "TBX_MB_SERVER_CACHE_SIZE must be in the range 0..255"
+#endif
+
+#if ((TBX_MB_SERVER_CACHE_VALIDITY_MS < 1U) || (TBX_MB_SERVER_CACHE_VALIDITY_MS > 65535U))
+#error "TBX_MB_SERVER_CACHE_VALIDITY_MS must be in the range 1..65535"
+#endif
+
+#if (TBX_MB_SERVER_SHADOW_FLUSH_MS > 65535U)
+#error "TBX_MB_SERVER_SHADOW_FLUSH_MS must be in the range 0..65535"
+#endif
+
+
 /****************************************************************************************
 * Function prototypes
 ****************************************************************************************/
+static void TbxMbServerInit                  (tTbxMbServerCtx       * newServerCtx,
+                                              tTbxMbTp                transport,
+                                              uint8_t                 isStatic);
+
 static void TbxMbServerProcessEvent          (tTbxMbEvent           * event);
 
+static tTbxMbServerFcEntry const * TbxMbServerFcLookup(uint8_t code);
+
+static uint8_t TbxMbServerFcSupported        (tTbxMbServerCtx const * context,
+                                              uint8_t                 code);
+
+#if (TBX_MB_SERVER_FC01_ENABLE > 0U)
 static void TbxMbServerFC01ReadCoils         (tTbxMbServerCtx       * context,
                                               tTbxMbTpPacket  const * rxPacket,
                                               tTbxMbTpPacket        * txPacket);
+#endif
 
+#if (TBX_MB_SERVER_FC02_ENABLE > 0U)
 static void TbxMbServerFC02ReadInputs        (tTbxMbServerCtx       * context,
                                               tTbxMbTpPacket  const * rxPacket,
                                               tTbxMbTpPacket        * txPacket);
+#endif
 
+#if (TBX_MB_SERVER_FC03_ENABLE > 0U)
 static void TbxMbServerFC03ReadHoldingRegs   (tTbxMbServerCtx       * context,
                                               tTbxMbTpPacket  const * rxPacket,
                                               tTbxMbTpPacket        * txPacket);
+#endif
 
+#if (TBX_MB_SERVER_FC04_ENABLE > 0U)
 static void TbxMbServerFC04ReadInputRegs     (tTbxMbServerCtx       * context,
                                               tTbxMbTpPacket  const * rxPacket,
                                               tTbxMbTpPacket        * txPacket);
+#endif
 
+#if (TBX_MB_SERVER_FC05_ENABLE > 0U)
 static void TbxMbServerFC05WriteSingleCoil   (tTbxMbServerCtx       * context,
                                               tTbxMbTpPacket  const * rxPacket,
                                               tTbxMbTpPacket        * txPacket);
+#endif
 
+#if (TBX_MB_SERVER_FC06_ENABLE > 0U)
 static void TbxMbServerFC06WriteSingleReg    (tTbxMbServerCtx       * context,
                                               tTbxMbTpPacket  const * rxPacket,
                                               tTbxMbTpPacket        * txPacket);
+#endif
 
+#if (TBX_MB_SERVER_FC08_ENABLE > 0U)
 static void TbxMbServerFC08Diagnostics       (tTbxMbServerCtx       * context,
                                               tTbxMbTpPacket  const * rxPacket,
                                               tTbxMbTpPacket        * txPacket);
+#endif
 
+#if (TBX_MB_SERVER_FC15_ENABLE > 0U)
 static void TbxMbServerFC15WriteMultipleCoils(tTbxMbServerCtx       * context,
                                               tTbxMbTpPacket  const * rxPacket,
                                               tTbxMbTpPacket        * txPacket);
+#endif
 
+#if (TBX_MB_SERVER_FC16_ENABLE > 0U)
 static void TbxMbServerFC16WriteMultipleRegs (tTbxMbServerCtx       * context,
                                               tTbxMbTpPacket  const * rxPacket,
                                               tTbxMbTpPacket        * txPacket);
+#endif
+
+#if (TBX_MB_SERVER_FC22_ENABLE > 0U)
+static void TbxMbServerFC22MaskWriteReg      (tTbxMbServerCtx       * context,
+                                              tTbxMbTpPacket  const * rxPacket,
+                                              tTbxMbTpPacket        * txPacket);
+#endif
+
+#if (TBX_MB_SERVER_FC23_ENABLE > 0U)
+static void TbxMbServerFC23ReadWriteRegs     (tTbxMbServerCtx       * context,
+                                              tTbxMbTpPacket  const * rxPacket,
+                                              tTbxMbTpPacket        * txPacket);
+#endif
+
+#if (TBX_MB_SERVER_FC20_ENABLE > 0U)
+static void TbxMbServerFC20ReadFileRecord    (tTbxMbServerCtx       * context,
+                                              tTbxMbTpPacket  const * rxPacket,
+                                              tTbxMbTpPacket        * txPacket);
+#endif
+
+#if (TBX_MB_SERVER_FC21_ENABLE > 0U)
+static void TbxMbServerFC21WriteFileRecord   (tTbxMbServerCtx       * context,
+                                              tTbxMbTpPacket  const * rxPacket,
+                                              tTbxMbTpPacket        * txPacket);
+#endif
+
+#if (TBX_MB_SERVER_FC43_ENABLE > 0U)
+static void TbxMbServerFC43ReadDeviceId      (tTbxMbServerCtx       * context,
+                                              tTbxMbTpPacket  const * rxPacket,
+                                              tTbxMbTpPacket        * txPacket);
+#endif
+
+static void TbxMbServerCustomFunction        (tTbxMbServerCtx       * context,
+                                              tTbxMbTpPacket  const * rxPacket,
+                                              tTbxMbTpPacket        * txPacket);
+
+static void TbxMbServerException             (tTbxMbTpPacket        * txPacket,
+                                              uint8_t                 exceptionCode);
+
+#if ((TBX_MB_SERVER_FC01_ENABLE > 0U) || (TBX_MB_SERVER_FC02_ENABLE > 0U) || \
+     (TBX_MB_SERVER_FC03_ENABLE > 0U) || (TBX_MB_SERVER_FC04_ENABLE > 0U) || \
+     (TBX_MB_SERVER_FC05_ENABLE > 0U) || (TBX_MB_SERVER_FC06_ENABLE > 0U) || \
+     (TBX_MB_SERVER_FC15_ENABLE > 0U) || (TBX_MB_SERVER_FC16_ENABLE > 0U) || \
+     (TBX_MB_SERVER_FC22_ENABLE > 0U) || (TBX_MB_SERVER_FC23_ENABLE > 0U))
+static void TbxMbServerResultException       (tTbxMbTpPacket        * txPacket,
+                                              tTbxMbServerResult      srvResult);
+#endif
+
+#if ((TBX_MB_SERVER_FC20_ENABLE > 0U) || (TBX_MB_SERVER_FC21_ENABLE > 0U))
+static uint8_t TbxMbServerFileSubReqCheck    (uint8_t         const * subReq);
+#endif
+
+#if ((TBX_MB_SERVER_FC22_ENABLE > 0U) || (TBX_MB_SERVER_FC23_ENABLE > 0U))
+static tTbxMbServerResult TbxMbServerHoldingRegsRead(tTbxMbServerCtx * context,
+                                              uint16_t                addr,
+                                              uint8_t                 num,
+                                              uint8_t               * data);
+
+static tTbxMbServerResult TbxMbServerHoldingRegsWrite(tTbxMbServerCtx * context,
+                                              uint16_t                addr,
+                                              uint8_t                 num,
+                                              uint8_t         const * data);
+#endif
+
+#if ((TBX_MB_SERVER_FC01_ENABLE > 0U) || (TBX_MB_SERVER_FC02_ENABLE > 0U) || \
+     (TBX_MB_SERVER_FC03_ENABLE > 0U) || (TBX_MB_SERVER_FC04_ENABLE > 0U) || \
+     (TBX_MB_SERVER_FC05_ENABLE > 0U) || (TBX_MB_SERVER_FC06_ENABLE > 0U) || \
+     (TBX_MB_SERVER_FC15_ENABLE > 0U) || (TBX_MB_SERVER_FC16_ENABLE > 0U) || \
+     (TBX_MB_SERVER_FC22_ENABLE > 0U) || (TBX_MB_SERVER_FC23_ENABLE > 0U))
+static uint8_t TbxMbServerTableCovers        (uint16_t                tableAddr,
+                                              uint16_t                tableLen,
+                                              uint16_t                addr,
+                                              uint16_t                num);
+#endif
+
+#if ((TBX_MB_SERVER_FC01_ENABLE > 0U) || (TBX_MB_SERVER_FC02_ENABLE > 0U))
+static void TbxMbServerBitsRead              (uint8_t         const * table,
+                                              uint16_t                bitOffset,
+                                              uint16_t                num,
+                                              uint8_t               * bits);
+#endif
+
+#if ((TBX_MB_SERVER_FC05_ENABLE > 0U) || (TBX_MB_SERVER_FC15_ENABLE > 0U))
+static void TbxMbServerBitsWrite             (uint8_t               * table,
+                                              uint16_t                bitOffset,
+                                              uint16_t                num,
+                                              uint8_t         const * bits);
+#endif
+
+#if ((TBX_MB_SERVER_CACHE_SIZE > 0U) || (TBX_MB_SERVER_SHADOW_FLUSH_MS > 0U))
+static void TbxMbServerPoll                  (tTbxMbServer            channel);
+#endif
+
+#if ((TBX_MB_SERVER_FC06_ENABLE > 0U) || (TBX_MB_SERVER_FC16_ENABLE > 0U) || \
+     (TBX_MB_SERVER_FC22_ENABLE > 0U) || (TBX_MB_SERVER_FC23_ENABLE > 0U))
+static void TbxMbServerShadowMark            (tTbxMbServerCtx       * context,
+                                              uint16_t                addr,
+                                              uint16_t                num);
+#endif
+
+#if (TBX_MB_SERVER_SHADOW_FLUSH_MS > 0U)
+static void TbxMbServerShadowAge             (tTbxMbServerCtx       * context);
+
+static void TbxMbServerShadowFlush           (tTbxMbServerCtx       * context);
+#endif
+
+#if (TBX_MB_SERVER_CACHE_SIZE > 0U)
+static uint8_t TbxMbServerCacheLookup        (tTbxMbServerCtx       * context,
+                                              uint8_t                 code,
+                                              uint16_t                addr,
+                                              uint16_t                num,
+                                              tTbxMbTpPacket        * txPacket);
+
+static void TbxMbServerCacheStore            (tTbxMbServerCtx       * context,
+                                              uint8_t                 code,
+                                              uint16_t                addr,
+                                              uint16_t                num,
+                                              tTbxMbTpPacket  const * txPacket);
+
+static void TbxMbServerCacheAge              (tTbxMbServerCtx       * context);
+
+static void TbxMbServerCacheClear            (tTbxMbServerCtx       * context);
+#endif
+
+
+/****************************************************************************************
+* Local constant declarations
+****************************************************************************************/
+/** \brief Dispatch table with the function codes that the server supports by itself,
+ *         together with their handler and the allowed length range of the request PDU
+ *         data. The most common function codes come first, because the table is
+ *         searched from the start. It ends with an entry without a handler.
+ */
+static const tTbxMbServerFcEntry tbxMbServerFcTable[] =
+{
+#if (TBX_MB_SERVER_FC03_ENABLE > 0U)
+  { TBX_MB_FC03_READ_HOLDING_REGISTERS,        4U,  4U,
+    TbxMbServerFC03ReadHoldingRegs },
+#endif
+#if (TBX_MB_SERVER_FC04_ENABLE > 0U)
+  { TBX_MB_FC04_READ_INPUT_REGISTERS,          4U,  4U,
+    TbxMbServerFC04ReadInputRegs },
+#endif
+#if (TBX_MB_SERVER_FC16_ENABLE > 0U)
+  { TBX_MB_FC16_WRITE_MULTIPLE_REGISTERS,      7U,  TBX_MB_TP_PDU_DATA_LEN_MAX,
+    TbxMbServerFC16WriteMultipleRegs },
+#endif
+#if (TBX_MB_SERVER_FC06_ENABLE > 0U)
+  { TBX_MB_FC06_WRITE_SINGLE_REGISTER,         4U,  4U,
+    TbxMbServerFC06WriteSingleReg },
+#endif
+#if (TBX_MB_SERVER_FC01_ENABLE > 0U)
+  { TBX_MB_FC01_READ_COILS,                    4U,  4U,
+    TbxMbServerFC01ReadCoils },
+#endif
+#if (TBX_MB_SERVER_FC02_ENABLE > 0U)
+  { TBX_MB_FC02_READ_DISCRETE_INPUTS,          4U,  4U,
+    TbxMbServerFC02ReadInputs },
+#endif
+#if (TBX_MB_SERVER_FC05_ENABLE > 0U)
+  { TBX_MB_FC05_WRITE_SINGLE_COIL,             4U,  4U,
+    TbxMbServerFC05WriteSingleCoil },
+#endif
+#if (TBX_MB_SERVER_FC15_ENABLE > 0U)
+  { TBX_MB_FC15_WRITE_MULTIPLE_COILS,          6U,  TBX_MB_TP_PDU_DATA_LEN_MAX,
+    TbxMbServerFC15WriteMultipleCoils },
+#endif
+#if (TBX_MB_SERVER_FC23_ENABLE > 0U)
+  { TBX_MB_FC23_READ_WRITE_MULTIPLE_REGISTERS, 11U, TBX_MB_TP_PDU_DATA_LEN_MAX,
+    TbxMbServerFC23ReadWriteRegs },
+#endif
+#if (TBX_MB_SERVER_FC22_ENABLE > 0U)
+  { TBX_MB_FC22_MASK_WRITE_REGISTER,           6U,  6U,
+    TbxMbServerFC22MaskWriteReg },
+#endif
+#if (TBX_MB_SERVER_FC08_ENABLE > 0U)
+  { TBX_MB_FC08_DIAGNOSTICS,                   4U,  TBX_MB_TP_PDU_DATA_LEN_MAX,
+    TbxMbServerFC08Diagnostics },
+#endif
+#if (TBX_MB_SERVER_FC20_ENABLE > 0U)
+  { TBX_MB_FC20_READ_FILE_RECORD,              1U,  TBX_MB_TP_PDU_DATA_LEN_MAX,
+    TbxMbServerFC20ReadFileRecord },
+#endif
+#if (TBX_MB_SERVER_FC21_ENABLE > 0U)
+  { TBX_MB_FC21_WRITE_FILE_RECORD,             1U,  TBX_MB_TP_PDU_DATA_LEN_MAX,
+    TbxMbServerFC21WriteFileRecord },
+#endif
+#if (TBX_MB_SERVER_FC43_ENABLE > 0U)
+  { TBX_MB_FC43_ENCAPSULATED_INTERFACE,        1U,  TBX_MB_TP_PDU_DATA_LEN_MAX,
+    TbxMbServerFC43ReadDeviceId },
+#endif
+  { 0U, 0U, 0U, NULL }
+};
 
 
 /************************************************************************************//**
@@ -123,30 +358,8 @@ tTbxMbServer TbxMbServerCreate(tTbxMbTp transport)
     /* Only continue if the memory allocation succeeded. */
     if (newServerCtx != NULL)
     {
-      /* Convert the TP channel pointer to the context structure. */
-      tTbxMbTpCtx * tpCtx = (tTbxMbTpCtx *)transport;
-      /* Sanity check on the transport layer's interface function. That way there is 
-       * no need to do it later on, making it more run-time efficient. Also check that
-       * it's not already linked to another channel.
-       */
-      TBX_ASSERT((tpCtx->transmitFcn != NULL) && (tpCtx->receptionDoneFcn != NULL) &&
-                 (tpCtx->getRxPacketFcn != NULL) && (tpCtx->getTxPacketFcn != NULL) &&
-                 (tpCtx->channelCtx == NULL));              
-      /* Initialize the channel context. Start by crosslinking the transport layer. */
-      newServerCtx->type = TBX_MB_SERVER_CONTEXT_TYPE;
-      newServerCtx->instancePtr = NULL;
-      newServerCtx->pollFcn = NULL;
-      newServerCtx->processFcn = TbxMbServerProcessEvent;
-      newServerCtx->readInputFcn = NULL;
-      newServerCtx->readCoilFcn = NULL;
-      newServerCtx->writeCoilFcn = NULL;
-      newServerCtx->readInputRegFcn = NULL;
-      newServerCtx->readHoldingRegFcn = NULL;
-      newServerCtx->writeHoldingRegFcn = NULL;
-      newServerCtx->customFunctionFcn = NULL;
-      newServerCtx->tpCtx = tpCtx;
-      newServerCtx->tpCtx->channelCtx = newServerCtx;
-      newServerCtx->tpCtx->isClient = TBX_FALSE;
+      /* Initialize the channel context. */
+      TbxMbServerInit(newServerCtx, transport, TBX_FALSE);
       /* Update the result. */
       result = newServerCtx;
     }
@@ -156,9 +369,43 @@ tTbxMbServer TbxMbServerCreate(tTbxMbTp transport)
 } /*** end of TbxMbServerCreate ****/
 
 
+/************************************************************************************//**
+** \brief     Creates a Modbus server channel object in storage that the caller
+**            provides, instead of allocating it from a memory pool. Afterwards, it
+**            assigns the specified Modbus transport layer to the channel for packet
+**            transmission and reception. The storage must remain valid until the
+**            object is released with TbxMbServerFree().
+** \param     storage Pointer to the storage for the server channel object.
+** \param     transport Handle to a previously created Modbus transport layer object to
+**            assign to the channel.
+** \return    Handle to the newly created Modbus server channel object if successful,
+**            NULL otherwise.
+**
+****************************************************************************************/
+tTbxMbServer TbxMbServerCreateStatic(tTbxMbServerStorage * storage,
+                                     tTbxMbTp              transport)
+{
+  tTbxMbServer result = NULL;
+
+  /* Verify parameters. */
+  TBX_ASSERT((storage != NULL) && (transport != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((storage != NULL) && (transport != NULL))
+  {
+    /* Initialize the channel context. */
+    TbxMbServerInit(&storage->ctx, transport, TBX_TRUE);
+    /* Update the result. */
+    result = &storage->ctx;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerCreateStatic ****/
+
+
 /************************************************************************************//**
 ** \brief     Releases a Modbus server channel object, previously created with
-**            TbxMbServerCreate().
+**            TbxMbServerCreate() or TbxMbServerCreateStatic().
 ** \param     channel Handle to the Modbus server channel object to release.
 **
 ****************************************************************************************/
@@ -174,6 +421,12 @@ void TbxMbServerFree(tTbxMbServer channel)
     tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
     /* Sanity check on the context type. */
     TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+#if (TBX_MB_SERVER_SHADOW_FLUSH_MS > 0U)
+    /* Flush the holding registers that clients changed, but that were not yet flushed.
+     * This way the application doesn't lose these changes.
+     */
+    TbxMbServerShadowFlush(serverCtx);
+#endif
     /* Remove crosslink between the channel and the transport layer. */
     TbxCriticalSectionEnter();
     serverCtx->tpCtx->channelCtx = NULL;
@@ -183,12 +436,114 @@ void TbxMbServerFree(tTbxMbServer channel)
     serverCtx->pollFcn = NULL;
     serverCtx->processFcn = NULL;
     TbxCriticalSectionExit();
-    /* Give the channel context back to the memory pool. */
-    TbxMemPoolRelease(serverCtx);
+    /* Remove the context from the poller array of its event task right away, such
+     * that its poll function is no longer called after releasing it.
+     */
+    TbxMbEventPollerRelease(serverCtx);
+    /* Give the channel context back to the memory pool, unless it is located in
+     * storage that the caller provided.
+     */
+    if (serverCtx->isStatic == TBX_FALSE)
+    {
+      TbxMemPoolRelease(serverCtx);
+    }
   }
 } /*** end of TbxMbServerFree ***/
 
 
+/************************************************************************************//**
+** \brief     Initializes a Modbus server channel object in the specified context and
+**            assigns the specified Modbus transport layer to the channel.
+** \param     newServerCtx Pointer to the server channel context to initialize.
+** \param     transport Handle to a previously created Modbus transport layer object to
+**            assign to the channel.
+** \param     isStatic TBX_TRUE if the caller provided the storage, TBX_FALSE if it was
+**            allocated from a memory pool.
+**
+****************************************************************************************/
+static void TbxMbServerInit(tTbxMbServerCtx * newServerCtx,
+                            tTbxMbTp          transport,
+                            uint8_t           isStatic)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((newServerCtx != NULL) && (transport != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((newServerCtx != NULL) && (transport != NULL))
+  {
+    /* Convert the TP channel pointer to the context structure. */
+    tTbxMbTpCtx * tpCtx = (tTbxMbTpCtx *)transport;
+    /* Sanity check on the transport layer's interface function. That way there is 
+     * no need to do it later on, making it more run-time efficient. Also check that
+     * it's not already linked to another channel.
+     */
+    TBX_ASSERT((tpCtx->transmitFcn != NULL) && (tpCtx->receptionDoneFcn != NULL) &&
+               (tpCtx->getRxPacketFcn != NULL) && (tpCtx->getTxPacketFcn != NULL) &&
+               (tpCtx->channelCtx == NULL));              
+    /* Initialize the channel context. Start by crosslinking the transport layer. */
+    newServerCtx->type = TBX_MB_SERVER_CONTEXT_TYPE;
+    newServerCtx->isStatic = isStatic;
+    newServerCtx->instancePtr = NULL;
+#if ((TBX_MB_SERVER_CACHE_SIZE > 0U) || (TBX_MB_SERVER_SHADOW_FLUSH_MS > 0U))
+    newServerCtx->pollFcn = TbxMbServerPoll;
+#else
+    newServerCtx->pollFcn = NULL;
+#endif
+    newServerCtx->processFcn = TbxMbServerProcessEvent;
+    newServerCtx->pollInfo.count = 0U;
+    newServerCtx->pollInfo.task = tpCtx->pollInfo.task;
+    newServerCtx->readInputFcn = NULL;
+    newServerCtx->readCoilFcn = NULL;
+    newServerCtx->writeCoilFcn = NULL;
+    newServerCtx->readInputRegFcn = NULL;
+    newServerCtx->readHoldingRegFcn = NULL;
+    newServerCtx->writeHoldingRegFcn = NULL;
+    newServerCtx->customFunctionFcn = NULL;
+    newServerCtx->readInputsFcn = NULL;
+    newServerCtx->readCoilsFcn = NULL;
+    newServerCtx->writeCoilsFcn = NULL;
+    newServerCtx->readInputRegsFcn = NULL;
+    newServerCtx->readHoldingRegsFcn = NULL;
+    newServerCtx->writeHoldingRegsFcn = NULL;
+    newServerCtx->readFileRecordFcn = NULL;
+    newServerCtx->writeFileRecordFcn = NULL;
+    newServerCtx->readDeviceIdFcn = NULL;
+    newServerCtx->flushHoldingRegsFcn = NULL;
+    newServerCtx->inputTable.data = NULL;
+    newServerCtx->inputTable.baseAddr = 0U;
+    newServerCtx->inputTable.numElements = 0U;
+    newServerCtx->coilTable.data = NULL;
+    newServerCtx->coilTable.baseAddr = 0U;
+    newServerCtx->coilTable.numElements = 0U;
+    newServerCtx->inputRegTable.data = NULL;
+    newServerCtx->inputRegTable.baseAddr = 0U;
+    newServerCtx->inputRegTable.numElements = 0U;
+    newServerCtx->holdingRegTable.data = NULL;
+    newServerCtx->holdingRegTable.baseAddr = 0U;
+    newServerCtx->holdingRegTable.numElements = 0U;
+#if (TBX_MB_SERVER_CACHE_SIZE > 0U)
+    for (uint8_t idx = 0U; idx < TBX_MB_SERVER_CACHE_SIZE; idx++)
+    {
+      newServerCtx->cache[idx].dataLen = 0U;
+    }
+    newServerCtx->cacheCount = 0U;
+    newServerCtx->cacheInvalidate = TBX_FALSE;
+    newServerCtx->cacheMsTime = 0U;
+#endif
+#if (TBX_MB_SERVER_SHADOW_FLUSH_MS > 0U)
+    newServerCtx->shadowDirty = TBX_FALSE;
+    newServerCtx->shadowFirst = 0U;
+    newServerCtx->shadowLast = 0U;
+    newServerCtx->shadowAgeMs = 0U;
+    newServerCtx->shadowMsTime = 0U;
+#endif
+    newServerCtx->tpCtx = tpCtx;
+    newServerCtx->tpCtx->channelCtx = newServerCtx;
+    newServerCtx->tpCtx->isClient = TBX_FALSE;
+  }
+} /*** end of TbxMbServerInit ***/
+
+
 /************************************************************************************//**
 ** \brief     Registers the callback function that this server calls, whenever a client
 **            requests the reading of a specific discrete input.
@@ -388,305 +743,2113 @@ void TbxMbServerSetCallbackCustomFunction(tTbxMbServer               channel,
 
 
 /************************************************************************************//**
-** \brief     Event processing function that is automatically called when an event for
-**            this server channel object was received in TbxMbEventTask().
-** \param     event Pointer to the event to process. Note that the event->context points
-**            to the handle of the Modbus server channel object.
+** \brief     Registers the callback function that this server calls, whenever a client
+**            requests the reading of a range of discrete inputs. It takes precedence
+**            over the callback registered with TbxMbServerSetCallbackReadInput(),
+**            because it processes all the requested data elements with just one function
+**            call.
+** \param     channel Handle to the Modbus server channel object.
+** \param     callback Pointer to the callback function.
 **
 ****************************************************************************************/
-static void TbxMbServerProcessEvent(tTbxMbEvent * event)
+void TbxMbServerSetCallbackReadInputs(tTbxMbServer           channel,
+                                      tTbxMbServerReadInputs callback)
 {
   /* Verify parameters. */
-  TBX_ASSERT(event != NULL);
+  TBX_ASSERT((channel != NULL) && (callback != NULL));
 
   /* Only continue with valid parameters. */
-  if (event != NULL)
+  if ((channel != NULL) && (callback != NULL))
   {
-    /* Sanity check the context. */
-    TBX_ASSERT(event->context != NULL);
-    /* Convert the event context to the server channel context structure. */
-    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)event->context;
-    /* Make sure the context is valid. */
-    TBX_ASSERT(serverCtx != NULL);
-    /* Only continue with a valid context. */
-    if (serverCtx != NULL)
-    {
-      /* Sanity check on the context type. */
-      TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
-      /* Filter on the event identifier. */
-      switch (event->id)
-      {
-        case TBX_MB_EVENT_ID_PDU_RECEIVED:
-        {
-          uint8_t okayToSendResponse = TBX_FALSE;
-          /* Obtain read access to the newly received packet and write access to the
-           * response packet. 
-           */
-          tTbxMbTpPacket * rxPacket = serverCtx->tpCtx->getRxPacketFcn(serverCtx->tpCtx);
-          tTbxMbTpPacket * txPacket = serverCtx->tpCtx->getTxPacketFcn(serverCtx->tpCtx);
-          /* Since we're requested to process a newly received PDU, these packet accesses
-           * should always succeed. Sanity check anyways, just in case.
-           */
-          TBX_ASSERT((rxPacket != NULL) && (txPacket != NULL));
-          /* Only continue with packet access. */
-          if ((rxPacket != NULL) && (txPacket != NULL))
-          {
-            /* Update flag that we can actually send a response, now that we know we 
-             * have access to txPacket.
-             */
-            okayToSendResponse = TBX_TRUE;
-            /* Prepare the response packet function code. */
-            txPacket->pdu.code = rxPacket->pdu.code;
-            /* Filter on the function code. */
-            switch (rxPacket->pdu.code)
-            {
-              /* ---------------- FC01 - Read Coils ---------------------------------- */
-              case TBX_MB_FC01_READ_COILS:
-              {
-                TbxMbServerFC01ReadCoils(serverCtx, rxPacket, txPacket);
-              }
-              break;
-
-              /* ---------------- FC02 - Read Discrete Inputs ------------------------ */
-              case TBX_MB_FC02_READ_DISCRETE_INPUTS:
-              {
-                TbxMbServerFC02ReadInputs(serverCtx, rxPacket, txPacket);
-              }
-              break;
-
-              /* ---------------- FC03 - Read Holding Registers ---------------------- */
-              case TBX_MB_FC03_READ_HOLDING_REGISTERS:
-              {
-                TbxMbServerFC03ReadHoldingRegs(serverCtx, rxPacket, txPacket);
-              }
-              break;
-
-              /* ---------------- FC04 - Read Input Registers ------------------------ */
-              case TBX_MB_FC04_READ_INPUT_REGISTERS:
-              {
-                TbxMbServerFC04ReadInputRegs(serverCtx, rxPacket, txPacket);
-              }
-              break;
-
-              /* ---------------- FC05 - Write Single Coil --------------------------- */
-              case TBX_MB_FC05_WRITE_SINGLE_COIL:
-              {
-                TbxMbServerFC05WriteSingleCoil(serverCtx, rxPacket, txPacket);
-              }
-              break;
-
-              /* ---------------- FC06 - Write Single Register ----------------------- */
-              case TBX_MB_FC06_WRITE_SINGLE_REGISTER:
-              {
-                TbxMbServerFC06WriteSingleReg(serverCtx, rxPacket, txPacket);
-              }
-              break;
-
-              /* ---------------- FC08 - Diagnostics --------------------------------- */
-              case TBX_MB_FC08_DIAGNOSTICS:
-              {
-                TbxMbServerFC08Diagnostics(serverCtx, rxPacket, txPacket);
-              }
-              break;
-
-              /* ---------------- FC15 - Write Multiple Coils ------------------------ */
-              case TBX_MB_FC15_WRITE_MULTIPLE_COILS:
-              {
-                TbxMbServerFC15WriteMultipleCoils(serverCtx, rxPacket, txPacket);
-              }
-              break;
-
-              /* ---------------- FC16 - Write Multiple Registers -------------------- */
-              case TBX_MB_FC16_WRITE_MULTIPLE_REGISTERS:
-              {
-                TbxMbServerFC16WriteMultipleRegs(serverCtx, rxPacket, txPacket);
-              }
-              break;
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Store the callback function pointer. */
+    TbxCriticalSectionEnter();
+    serverCtx->readInputsFcn = callback;
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxMbServerSetCallbackReadInputs ***/
 
-              /* ---------------- Unsupported function code -------------------------- */
-              default:
-              {
-                uint8_t handled = TBX_FALSE;
 
-                /* Is a custom function code callback configured? */
-                if (serverCtx->customFunctionFcn != NULL)
-                {
-                  /* Prepare callback parameters. */
-                  uint8_t const * rxPdu  = &rxPacket->pdu.code;
-                  uint8_t       * txPdu  = &txPacket->pdu.code;
-                  uint8_t         pduLen = rxPacket->dataLen + 1U;
-                  /* Call the custom function code callback. */
-                  handled = serverCtx->customFunctionFcn(serverCtx, rxPdu, txPdu, 
-                                                         &pduLen);
-                  /* Did the callback process the PDU and prepare a response? */
-                  if (handled == TBX_TRUE)
-                  {
-                    /* Set the response data length. */
-                    txPacket->dataLen = pduLen - 1U;
-                  }
-                }
-                /* Did the custom function code callback not handle the PDU? */
-                if (handled == TBX_FALSE)
-                {
-                  /* This function code is currently not supported. */
-                  txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-                  txPacket->pdu.data[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
-                  txPacket->dataLen = 1U;
-                }
-              }
-              break;
-            }
-          }
-          /* Inform the transport layer that were done with the rx packet and no longer
-           * need access to it.
-           */
-          serverCtx->tpCtx->receptionDoneFcn(serverCtx->tpCtx);
-          /* Request the transport layer to transmit the response. Note that
-           * transmitFcn() should only be called after calling receptionDoneFcn().
-           */
-          if (okayToSendResponse == TBX_TRUE)
-          {
-            (void)serverCtx->tpCtx->transmitFcn(serverCtx->tpCtx);
-          }
-        }
-        break;
-      
-        case TBX_MB_EVENT_ID_PDU_TRANSMITTED:
-        {
-          /* At this point no additional event handling is needed on this channel upon
-           * PDU transmission completion.
-           */
-        }
-        break;
+/************************************************************************************//**
+** \brief     Registers the callback function that this server calls, whenever a client
+**            requests the reading of a range of coils. It takes precedence over the
+**            callback registered with TbxMbServerSetCallbackReadCoil(), because it
+**            processes all the requested data elements with just one function call.
+** \param     channel Handle to the Modbus server channel object.
+** \param     callback Pointer to the callback function.
+**
+****************************************************************************************/
+void TbxMbServerSetCallbackReadCoils(tTbxMbServer          channel,
+                                     tTbxMbServerReadCoils callback)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (callback != NULL));
 
-        default:
-        {
-          /* An unsupported event was dispatched to us. Should not happen. */
-          TBX_ASSERT(TBX_FALSE);
-        }
-        break;
-      }
-    }
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (callback != NULL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Store the callback function pointer. */
+    TbxCriticalSectionEnter();
+    serverCtx->readCoilsFcn = callback;
+    TbxCriticalSectionExit();
   }
-} /*** end of TbxMbServerProcessEvent ***/
+} /*** end of TbxMbServerSetCallbackReadCoils ***/
 
 
 /************************************************************************************//**
-** \brief     Handles a newly received PDU for function code 1 - Read Coils.
-** \details   Note that this function is called at a time that txPacket->code is already
-**            prepared. Also note that txPacket->node should not be touched here.
-** \param     context Pointer to the Modbus server channel context.
-** \param     rxPacket Received PDU packet with MUX access.
-** \param     txPacket Storage for the PDU response packet with MUX access.
+** \brief     Registers the callback function that this server calls, whenever a client
+**            requests the writing of a range of coils. It takes precedence over the
+**            callback registered with TbxMbServerSetCallbackWriteCoil(), because it
+**            processes all the requested data elements with just one function call.
+** \param     channel Handle to the Modbus server channel object.
+** \param     callback Pointer to the callback function.
 **
 ****************************************************************************************/
-static void TbxMbServerFC01ReadCoils(tTbxMbServerCtx       * context,
-                                     tTbxMbTpPacket  const * rxPacket,
-                                     tTbxMbTpPacket        * txPacket)
+void TbxMbServerSetCallbackWriteCoils(tTbxMbServer           channel,
+                                      tTbxMbServerWriteCoils callback)
 {
   /* Verify parameters. */
-  TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
+  TBX_ASSERT((channel != NULL) && (callback != NULL));
 
   /* Only continue with valid parameters. */
-  if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
+  if ((channel != NULL) && (callback != NULL))
   {
-    /* Read out request packet parameters. */
-    uint16_t startAddr = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
-    uint16_t numCoils  = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Store the callback function pointer. */
+    TbxCriticalSectionEnter();
+    serverCtx->writeCoilsFcn = callback;
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxMbServerSetCallbackWriteCoils ***/
 
-    /* Check if a callback function was registered. */
-    if (context->readCoilFcn == NULL)
-    {
+
+/************************************************************************************//**
+** \brief     Registers the callback function that this server calls, whenever a client
+**            requests the reading of a range of input registers. It takes precedence
+**            over the callback registered with TbxMbServerSetCallbackReadInputReg(),
+**            because it processes all the requested data elements with just one function
+**            call.
+** \param     channel Handle to the Modbus server channel object.
+** \param     callback Pointer to the callback function.
+**
+****************************************************************************************/
+void TbxMbServerSetCallbackReadInputRegs(tTbxMbServer              channel,
+                                         tTbxMbServerReadInputRegs callback)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (callback != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (callback != NULL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Store the callback function pointer. */
+    TbxCriticalSectionEnter();
+    serverCtx->readInputRegsFcn = callback;
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxMbServerSetCallbackReadInputRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Registers the callback function that this server calls, whenever a client
+**            requests the reading of a range of holding registers. It takes precedence
+**            over the callback registered with TbxMbServerSetCallbackReadHoldingReg(),
+**            because it processes all the requested data elements with just one function
+**            call.
+** \param     channel Handle to the Modbus server channel object.
+** \param     callback Pointer to the callback function.
+**
+****************************************************************************************/
+void TbxMbServerSetCallbackReadHoldingRegs(tTbxMbServer                channel,
+                                           tTbxMbServerReadHoldingRegs callback)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (callback != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (callback != NULL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Store the callback function pointer. */
+    TbxCriticalSectionEnter();
+    serverCtx->readHoldingRegsFcn = callback;
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxMbServerSetCallbackReadHoldingRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Registers the callback function that this server calls, whenever a client
+**            requests the writing of a range of holding registers. It takes precedence
+**            over the callback registered with TbxMbServerSetCallbackWriteHoldingReg(),
+**            because it processes all the requested data elements with just one function
+**            call.
+** \param     channel Handle to the Modbus server channel object.
+** \param     callback Pointer to the callback function.
+**
+****************************************************************************************/
+void TbxMbServerSetCallbackWriteHoldingRegs(tTbxMbServer                 channel,
+                                            tTbxMbServerWriteHoldingRegs callback)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (callback != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (callback != NULL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Store the callback function pointer. */
+    TbxCriticalSectionEnter();
+    serverCtx->writeHoldingRegsFcn = callback;
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxMbServerSetCallbackWriteHoldingRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Registers the callback function that this server calls, whenever a client
+**            requests the reading of one or more records of a file.
+** \param     channel Handle to the Modbus server channel object.
+** \param     callback Pointer to the callback function.
+**
+****************************************************************************************/
+void TbxMbServerSetCallbackReadFileRecord(tTbxMbServer               channel,
+                                          tTbxMbServerReadFileRecord callback)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (callback != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (callback != NULL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Store the callback function pointer. */
+    TbxCriticalSectionEnter();
+    serverCtx->readFileRecordFcn = callback;
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxMbServerSetCallbackReadFileRecord ***/
+
+
+/************************************************************************************//**
+** \brief     Registers the callback function that this server calls, whenever a client
+**            requests the writing of one or more records of a file.
+** \param     channel Handle to the Modbus server channel object.
+** \param     callback Pointer to the callback function.
+**
+****************************************************************************************/
+void TbxMbServerSetCallbackWriteFileRecord(tTbxMbServer                channel,
+                                           tTbxMbServerWriteFileRecord callback)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (callback != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (callback != NULL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Store the callback function pointer. */
+    TbxCriticalSectionEnter();
+    serverCtx->writeFileRecordFcn = callback;
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxMbServerSetCallbackWriteFileRecord ***/
+
+
+/************************************************************************************//**
+** \brief     Registers the callback function that this server calls, whenever a client
+**            requests the reading of device identification objects, with function code
+**            43 and MEI type 14. Requests with other MEI types are still passed on to
+**            the custom function code callback, if any.
+** \param     channel Handle to the Modbus server channel object.
+** \param     callback Pointer to the callback function.
+**
+****************************************************************************************/
+void TbxMbServerSetCallbackReadDeviceId(tTbxMbServer             channel,
+                                        tTbxMbServerReadDeviceId callback)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (callback != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (callback != NULL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Store the callback function pointer. */
+    TbxCriticalSectionEnter();
+    serverCtx->readDeviceIdFcn = callback;
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxMbServerSetCallbackReadDeviceId ***/
+
+
+/************************************************************************************//**
+** \brief     Attaches an application owned data table with discrete inputs to the
+**            server. Requests for discrete inputs located within the data table are
+**            served directly from this table, without calling a callback function.
+**            Requests for discrete inputs outside of the data table are still passed on
+**            to the registered callback function, if any.
+** \attention The server reads from the data table from the context of
+**            TbxMbEventTask(). If the application accesses the same data table from a
+**            different context, it is responsible for protecting this access.
+** \param     channel Handle to the Modbus server channel object.
+** \param     baseAddr Address of the first element in the data table (0..65535).
+** \param     numElements Number of elements in the data table.
+** \param     inputs Byte array with the packed input bits. The input at
+**            baseAddr is stored in bit 0 of inputs[0], the one at baseAddr + 1 in bit 1
+**            of inputs[0], etc.
+**
+****************************************************************************************/
+void TbxMbServerSetTableInputs(tTbxMbServer   channel,
+                               uint16_t       baseAddr,
+                               uint16_t       numElements,
+                               uint8_t      * inputs)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (numElements > 0U) && (inputs != NULL) &&
+             (((uint32_t)baseAddr + numElements) <= 65536UL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (numElements > 0U) && (inputs != NULL) &&
+      (((uint32_t)baseAddr + numElements) <= 65536UL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Store the data table information. */
+    TbxCriticalSectionEnter();
+    serverCtx->inputTable.data = inputs;
+    serverCtx->inputTable.baseAddr = baseAddr;
+    serverCtx->inputTable.numElements = numElements;
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxMbServerSetTableInputs ***/
+
+
+/************************************************************************************//**
+** \brief     Attaches an application owned data table with coils to the server. Requests
+**            for coils located within the data table are served directly from this
+**            table, without calling a callback function. Requests for coils outside of
+**            the data table are still passed on to the registered callback function, if
+**            any.
+** \attention The server reads from and writes to the data table from the context of
+**            TbxMbEventTask(). If the application accesses the same data table from a
+**            different context, it is responsible for protecting this access.
+** \param     channel Handle to the Modbus server channel object.
+** \param     baseAddr Address of the first element in the data table (0..65535).
+** \param     numElements Number of elements in the data table.
+** \param     coils Byte array with the packed coil bits. The coil at
+**            baseAddr is stored in bit 0 of coils[0], the one at baseAddr + 1 in bit 1
+**            of coils[0], etc.
+**
+****************************************************************************************/
+void TbxMbServerSetTableCoils(tTbxMbServer   channel,
+                              uint16_t       baseAddr,
+                              uint16_t       numElements,
+                              uint8_t      * coils)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (numElements > 0U) && (coils != NULL) &&
+             (((uint32_t)baseAddr + numElements) <= 65536UL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (numElements > 0U) && (coils != NULL) &&
+      (((uint32_t)baseAddr + numElements) <= 65536UL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Store the data table information. */
+    TbxCriticalSectionEnter();
+    serverCtx->coilTable.data = coils;
+    serverCtx->coilTable.baseAddr = baseAddr;
+    serverCtx->coilTable.numElements = numElements;
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxMbServerSetTableCoils ***/
+
+
+/************************************************************************************//**
+** \brief     Attaches an application owned data table with input registers to the
+**            server. Requests for input registers located within the data table are
+**            served directly from this table, without calling a callback function.
+**            Requests for input registers outside of the data table are still passed on
+**            to the registered callback function, if any.
+** \attention The server reads from the data table from the context of
+**            TbxMbEventTask(). If the application accesses the same data table from a
+**            different context, it is responsible for protecting this access.
+** \param     channel Handle to the Modbus server channel object.
+** \param     baseAddr Address of the first element in the data table (0..65535).
+** \param     numElements Number of elements in the data table.
+** \param     inputRegs Array with the input register values, in your CPUs
+**            native endianess.
+**
+****************************************************************************************/
+void TbxMbServerSetTableInputRegs(tTbxMbServer   channel,
+                                  uint16_t       baseAddr,
+                                  uint16_t       numElements,
+                                  uint16_t     * inputRegs)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (numElements > 0U) && (inputRegs != NULL) &&
+             (((uint32_t)baseAddr + numElements) <= 65536UL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (numElements > 0U) && (inputRegs != NULL) &&
+      (((uint32_t)baseAddr + numElements) <= 65536UL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Store the data table information. */
+    TbxCriticalSectionEnter();
+    serverCtx->inputRegTable.data = inputRegs;
+    serverCtx->inputRegTable.baseAddr = baseAddr;
+    serverCtx->inputRegTable.numElements = numElements;
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxMbServerSetTableInputRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Attaches an application owned data table with holding registers to the
+**            server. Requests for holding registers located within the data table are
+**            served directly from this table, without calling a callback function.
+**            Requests for holding registers outside of the data table are still passed
+**            on to the registered callback function, if any.
+** \attention The server reads from and writes to the data table from the context of
+**            TbxMbEventTask(). If the application accesses the same data table from a
+**            different context, it is responsible for protecting this access.
+** \param     channel Handle to the Modbus server channel object.
+** \param     baseAddr Address of the first element in the data table (0..65535).
+** \param     numElements Number of elements in the data table.
+** \param     holdingRegs Array with the holding register values, in your CPUs
+**            native endianess.
+**
+****************************************************************************************/
+void TbxMbServerSetTableHoldingRegs(tTbxMbServer   channel,
+                                    uint16_t       baseAddr,
+                                    uint16_t       numElements,
+                                    uint16_t     * holdingRegs)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (numElements > 0U) && (holdingRegs != NULL) &&
+             (((uint32_t)baseAddr + numElements) <= 65536UL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (numElements > 0U) && (holdingRegs != NULL) &&
+      (((uint32_t)baseAddr + numElements) <= 65536UL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Store the data table information. */
+    TbxCriticalSectionEnter();
+    serverCtx->holdingRegTable.data = holdingRegs;
+    serverCtx->holdingRegTable.baseAddr = baseAddr;
+    serverCtx->holdingRegTable.numElements = numElements;
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxMbServerSetTableHoldingRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Registers the callback function that this server calls, after clients
+**            changed holding registers in the data table, attached with
+**            TbxMbServerSetTableHoldingRegs(). With TBX_MB_SERVER_SHADOW_FLUSH_MS set
+**            to a value larger than 0, the server responds to write requests right
+**            away and defers the callback. It then passes the changes of consecutive
+**            write requests on to the callback as one range of holding registers. This
+**            makes it a good fit for persisting the data table in EEPROM or flash.
+** \attention The server calls the callback from the context of TbxMbEventTask().
+** \param     channel Handle to the Modbus server channel object.
+** \param     callback Pointer to the callback function.
+**
+****************************************************************************************/
+void TbxMbServerSetCallbackFlushHoldingRegs(tTbxMbServer                 channel,
+                                            tTbxMbServerFlushHoldingRegs callback)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (callback != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (callback != NULL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Store the callback function pointer. */
+    TbxCriticalSectionEnter();
+    serverCtx->flushHoldingRegsFcn = callback;
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxMbServerSetCallbackFlushHoldingRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Discards all responses that this server cached, such that the next read
+**            requests are processed with the data tables and callback functions again.
+**            Call this function after the application changed the data, for example in
+**            one of its data tables. Note that write requests from a client already
+**            discard the cached responses automatically. The cache is only available if
+**            enabled with TBX_MB_SERVER_CACHE_SIZE. Otherwise this function does nothing.
+** \param     channel Handle to the Modbus server channel object.
+**
+****************************************************************************************/
+void TbxMbServerInvalidateCache(tTbxMbServer channel)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(channel != NULL);
+
+  /* Only continue with valid parameters. */
+  if (channel != NULL)
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+#if (TBX_MB_SERVER_CACHE_SIZE > 0U)
+    /* Only the event task accesses the cache. Request it to discard its contents,
+     * before it processes the next request.
+     */
+    TbxCriticalSectionEnter();
+    serverCtx->cacheInvalidate = TBX_TRUE;
+    TbxCriticalSectionExit();
+#endif
+  }
+} /*** end of TbxMbServerInvalidateCache ***/
+
+
+/************************************************************************************//**
+** \brief     Event processing function that is automatically called when an event for
+**            this server channel object was received in TbxMbEventTask().
+** \param     event Pointer to the event to process. Note that the event->context points
+**            to the handle of the Modbus server channel object.
+**
+****************************************************************************************/
+static void TbxMbServerProcessEvent(tTbxMbEvent * event)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(event != NULL);
+
+  /* Only continue with valid parameters. */
+  if (event != NULL)
+  {
+    /* Sanity check the context. */
+    TBX_ASSERT(event->context != NULL);
+    /* Convert the event context to the server channel context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)event->context;
+    /* Make sure the context is valid. */
+    TBX_ASSERT(serverCtx != NULL);
+    /* Only continue with a valid context. */
+    if (serverCtx != NULL)
+    {
+      /* Sanity check on the context type. */
+      TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+      /* Filter on the event identifier. */
+      switch (event->id)
+      {
+        case TBX_MB_EVENT_ID_PDU_RECEIVED:
+        {
+          uint8_t okayToSendResponse = TBX_FALSE;
+#if (TBX_MB_TRACE_ENABLE > 0U)
+          /* Timestamp the processing start of the request. */
+          TbxMbTraceMark(serverCtx->tpCtx, TBX_MB_TRACE_POINT_DISPATCH);
+#endif
+          /* Obtain read access to the newly received packet and write access to the
+           * response packet. 
+           */
+          tTbxMbTpPacket * rxPacket = serverCtx->tpCtx->getRxPacketFcn(serverCtx->tpCtx);
+          tTbxMbTpPacket * txPacket = serverCtx->tpCtx->getTxPacketFcn(serverCtx->tpCtx);
+          /* Since we're requested to process a newly received PDU, these packet accesses
+           * should always succeed. Sanity check anyways, just in case.
+           */
+          TBX_ASSERT((rxPacket != NULL) && (txPacket != NULL));
+          /* Only continue with packet access. */
+          if ((rxPacket != NULL) && (txPacket != NULL))
+          {
+            /* Read out the function code of the request. Note that a compact transport
+             * layer shares one packet buffer for reception and transmission. The
+             * function code handlers therefore read the request parameters they need,
+             * before building the response in its place.
+             */
+            uint8_t reqCode = rxPacket->pdu.code;
+            /* Update flag that we can actually send a response, now that we know we 
+             * have access to txPacket.
+             */
+            okayToSendResponse = TBX_TRUE;
+            /* Prepare the response packet function code. */
+            txPacket->pdu.code = reqCode;
+            /* Look up the function code in the dispatch table. */
+            tTbxMbServerFcEntry const * fcEntry = TbxMbServerFcLookup(reqCode);
+            /* Not a function code that the server supports by itself? */
+            if (fcEntry == NULL)
+            {
+              /* Leave it to the custom function code callback. */
+              TbxMbServerCustomFunction(serverCtx, rxPacket, txPacket);
+            }
+            /* Check if the application made no data available for the function code. */
+            else if (TbxMbServerFcSupported(serverCtx, reqCode) == TBX_FALSE)
+            {
+              /* Prepare exception response. */
+              TbxMbServerException(txPacket, TBX_MB_EC01_ILLEGAL_FUNCTION);
+            }
+            /* Check if the request has an invalid length. */
+            else if ((rxPacket->dataLen < fcEntry->minLen) ||
+                     (rxPacket->dataLen > fcEntry->maxLen))
+            {
+              /* Prepare exception response. */
+              TbxMbServerException(txPacket, TBX_MB_EC03_ILLEGAL_DATA_VALUE);
+            }
+            /* All is good for further processing. */
+            else
+            {
+              uint8_t cacheHit = TBX_FALSE;
+#if (TBX_MB_SERVER_CACHE_SIZE > 0U)
+              uint16_t reqAddr = 0U;
+              uint16_t reqNum  = 0U;
+              /* Attempt to answer a request that reads data (function codes 1, 2, 3
+               * and 4) with a cached response. The dispatch table already verified
+               * that such a request holds just the start address and number of
+               * elements.
+               */
+              if (reqCode <= TBX_MB_FC04_READ_INPUT_REGISTERS)
+              {
+                reqAddr = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
+                reqNum  = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
+                cacheHit = TbxMbServerCacheLookup(serverCtx, reqCode, reqAddr, reqNum,
+                                                  txPacket);
+              }
+#endif
+              /* Process the request, if no cached response is available. */
+              if (cacheHit == TBX_FALSE)
+              {
+                fcEntry->handler(serverCtx, rxPacket, txPacket);
+#if (TBX_MB_SERVER_CACHE_SIZE > 0U)
+                /* Cache the response for repeated identical requests that read data. */
+                if (reqCode <= TBX_MB_FC04_READ_INPUT_REGISTERS)
+                {
+                  TbxMbServerCacheStore(serverCtx, reqCode, reqAddr, reqNum, txPacket);
+                }
+#endif
+              }
+            }
+#if (TBX_MB_SERVER_CACHE_SIZE > 0U)
+            /* All requests, other than the reading of data, might change the data. In
+             * this case the cached responses are no longer valid.
+             */
+            if ((reqCode < TBX_MB_FC01_READ_COILS) ||
+                (reqCode > TBX_MB_FC04_READ_INPUT_REGISTERS))
+            {
+              TbxMbServerCacheClear(serverCtx);
+            }
+#endif
+#if (TBX_MB_TRACE_ENABLE > 0U)
+            /* Timestamp the processing completion of the request. */
+            TbxMbTraceMark(serverCtx->tpCtx, TBX_MB_TRACE_POINT_PROCESSED);
+#endif
+          }
+          /* Inform the transport layer that were done with the rx packet and no longer
+           * need access to it.
+           */
+          serverCtx->tpCtx->receptionDoneFcn(serverCtx->tpCtx);
+          /* Request the transport layer to transmit the response. Note that
+           * transmitFcn() should only be called after calling receptionDoneFcn().
+           */
+          if (okayToSendResponse == TBX_TRUE)
+          {
+            (void)serverCtx->tpCtx->transmitFcn(serverCtx->tpCtx);
+          }
+        }
+        break;
+      
+        case TBX_MB_EVENT_ID_PDU_TRANSMITTED:
+        {
+          /* At this point no additional event handling is needed on this channel upon
+           * PDU transmission completion.
+           */
+        }
+        break;
+
+        default:
+        {
+          /* An unsupported event was dispatched to us. Should not happen. */
+          TBX_ASSERT(TBX_FALSE);
+        }
+        break;
+      }
+    }
+  }
+} /*** end of TbxMbServerProcessEvent ***/
+
+
+/************************************************************************************//**
+** \brief     Looks up a function code in the dispatch table.
+** \param     code Function code of the request.
+** \return    Pointer to the dispatch table entry of the function code, or NULL if the
+**            server doesn't support the function code by itself.
+**
+****************************************************************************************/
+static tTbxMbServerFcEntry const * TbxMbServerFcLookup(uint8_t code)
+{
+  tTbxMbServerFcEntry const * result = NULL;
+  uint8_t                     idx    = 0U;
+
+  /* Loop through the dispatch table entries, until the one without a handler. */
+  while (tbxMbServerFcTable[idx].handler != NULL)
+  {
+    /* Is this the entry of the function code? */
+    if (tbxMbServerFcTable[idx].code == code)
+    {
+      /* Update the result and stop looping. */
+      result = &tbxMbServerFcTable[idx];
+      break;
+    }
+    idx++;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerFcLookup ***/
+
+
+/************************************************************************************//**
+** \brief     Determines if the application made data available for a function code in
+**            the dispatch table, by attaching a data table or registering a callback
+**            function. If not, the request is answered with an illegal function
+**            exception, before its length or contents are checked.
+** \param     context Pointer to the Modbus server channel context.
+** \param     code Function code of the request.
+** \return    TBX_TRUE if the function code is supported, TBX_FALSE otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbServerFcSupported(tTbxMbServerCtx const * context,
+                                      uint8_t                 code)
+{
+  uint8_t result = TBX_TRUE;
+
+  /* Verify parameters. */
+  TBX_ASSERT(context != NULL);
+
+  /* Only continue with valid parameters. */
+  if (context != NULL)
+  {
+    /* Filter on the function code. */
+    switch (code)
+    {
+#if (TBX_MB_SERVER_FC01_ENABLE > 0U)
+      case TBX_MB_FC01_READ_COILS:
+      {
+        if ((context->coilTable.data == NULL) && (context->readCoilFcn == NULL) &&
+            (context->readCoilsFcn == NULL))
+        {
+          result = TBX_FALSE;
+        }
+      }
+      break;
+#endif
+
+#if (TBX_MB_SERVER_FC02_ENABLE > 0U)
+      case TBX_MB_FC02_READ_DISCRETE_INPUTS:
+      {
+        if ((context->inputTable.data == NULL) && (context->readInputFcn == NULL) &&
+            (context->readInputsFcn == NULL))
+        {
+          result = TBX_FALSE;
+        }
+      }
+      break;
+#endif
+
+#if (TBX_MB_SERVER_FC03_ENABLE > 0U)
+      case TBX_MB_FC03_READ_HOLDING_REGISTERS:
+      {
+        if ((context->holdingRegTable.data == NULL) &&
+            (context->readHoldingRegFcn == NULL) && (context->readHoldingRegsFcn == NULL))
+        {
+          result = TBX_FALSE;
+        }
+      }
+      break;
+#endif
+
+#if (TBX_MB_SERVER_FC04_ENABLE > 0U)
+      case TBX_MB_FC04_READ_INPUT_REGISTERS:
+      {
+        if ((context->inputRegTable.data == NULL) && (context->readInputRegFcn == NULL) &&
+            (context->readInputRegsFcn == NULL))
+        {
+          result = TBX_FALSE;
+        }
+      }
+      break;
+#endif
+
+#if (TBX_MB_SERVER_FC05_ENABLE > 0U)
+      case TBX_MB_FC05_WRITE_SINGLE_COIL:
+#endif
+#if (TBX_MB_SERVER_FC15_ENABLE > 0U)
+      case TBX_MB_FC15_WRITE_MULTIPLE_COILS:
+#endif
+#if ((TBX_MB_SERVER_FC05_ENABLE > 0U) || (TBX_MB_SERVER_FC15_ENABLE > 0U))
+      {
+        if ((context->coilTable.data == NULL) && (context->writeCoilFcn == NULL) &&
+            (context->writeCoilsFcn == NULL))
+        {
+          result = TBX_FALSE;
+        }
+      }
+      break;
+#endif
+
+#if (TBX_MB_SERVER_FC06_ENABLE > 0U)
+      case TBX_MB_FC06_WRITE_SINGLE_REGISTER:
+#endif
+#if (TBX_MB_SERVER_FC16_ENABLE > 0U)
+      case TBX_MB_FC16_WRITE_MULTIPLE_REGISTERS:
+#endif
+#if ((TBX_MB_SERVER_FC06_ENABLE > 0U) || (TBX_MB_SERVER_FC16_ENABLE > 0U))
+      {
+        if ((context->holdingRegTable.data == NULL) &&
+            (context->writeHoldingRegFcn == NULL) &&
+            (context->writeHoldingRegsFcn == NULL))
+        {
+          result = TBX_FALSE;
+        }
+      }
+      break;
+#endif
+
+#if (TBX_MB_SERVER_FC22_ENABLE > 0U)
+      case TBX_MB_FC22_MASK_WRITE_REGISTER:
+#endif
+#if (TBX_MB_SERVER_FC23_ENABLE > 0U)
+      case TBX_MB_FC23_READ_WRITE_MULTIPLE_REGISTERS:
+#endif
+#if ((TBX_MB_SERVER_FC22_ENABLE > 0U) || (TBX_MB_SERVER_FC23_ENABLE > 0U))
+      {
+        /* Both reading and writing of the holding registers is needed. */
+        if ((context->holdingRegTable.data == NULL) &&
+            (((context->readHoldingRegFcn == NULL) &&
+              (context->readHoldingRegsFcn == NULL)) ||
+             ((context->writeHoldingRegFcn == NULL) &&
+              (context->writeHoldingRegsFcn == NULL))))
+        {
+          result = TBX_FALSE;
+        }
+      }
+      break;
+#endif
+
+#if (TBX_MB_SERVER_FC20_ENABLE > 0U)
+      case TBX_MB_FC20_READ_FILE_RECORD:
+      {
+        if (context->readFileRecordFcn == NULL)
+        {
+          result = TBX_FALSE;
+        }
+      }
+      break;
+#endif
+
+#if (TBX_MB_SERVER_FC21_ENABLE > 0U)
+      case TBX_MB_FC21_WRITE_FILE_RECORD:
+      {
+        if (context->writeFileRecordFcn == NULL)
+        {
+          result = TBX_FALSE;
+        }
+      }
+      break;
+#endif
+
+      default:
+      {
+        /* The diagnostics and device identification function codes are always
+         * supported. Their handlers check the sub-function code themselves.
+         */
+      }
+      break;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerFcSupported ***/
+
+
+#if ((TBX_MB_SERVER_CACHE_SIZE > 0U) || (TBX_MB_SERVER_SHADOW_FLUSH_MS > 0U))
+/************************************************************************************//**
+** \brief     Event polling function that is automatically called during each call of
+**            TbxMbEventTask(), while responses are cached or changed holding registers
+**            await their flush. It ages the cached responses and discards the ones that
+**            are no longer valid. It also flushes the changed holding registers, once
+**            their flush time arrived.
+** \param     channel Handle to the Modbus server channel object that triggered the
+**            event.
+**
+****************************************************************************************/
+static void TbxMbServerPoll(tTbxMbServer channel)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(channel != NULL);
+
+  /* Only continue with valid parameters. */
+  if (channel != NULL)
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+#if (TBX_MB_SERVER_CACHE_SIZE > 0U)
+    /* Age the cached responses. */
+    TbxMbServerCacheAge(serverCtx);
+#endif
+#if (TBX_MB_SERVER_SHADOW_FLUSH_MS > 0U)
+    /* Age the changed holding registers and flush them when it's time. */
+    TbxMbServerShadowAge(serverCtx);
+#endif
+  }
+} /*** end of TbxMbServerPoll ***/
+#endif
+
+
+#if (TBX_MB_SERVER_FC01_ENABLE > 0U)
+/************************************************************************************//**
+** \brief     Handles a newly received PDU for function code 1 - Read Coils.
+** \details   Note that this function is called at a time that txPacket->code is already
+**            prepared. Also note that txPacket->node should not be touched here.
+** \param     context Pointer to the Modbus server channel context.
+** \param     rxPacket Received PDU packet with MUX access.
+** \param     txPacket Storage for the PDU response packet with MUX access.
+**
+****************************************************************************************/
+static void TbxMbServerFC01ReadCoils(tTbxMbServerCtx       * context,
+                                     tTbxMbTpPacket  const * rxPacket,
+                                     tTbxMbTpPacket        * txPacket)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
+  {
+    /* Read out request packet parameters. */
+    uint16_t startAddr = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
+    uint16_t numCoils  = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
+
+    /* Check if the quantity of coils is invalid. */
+    if ((numCoils < 1U) || (numCoils > 2000U))
+    {
+      /* Prepare exception response. */
+      TbxMbServerException(txPacket, TBX_MB_EC03_ILLEGAL_DATA_VALUE);
+    }
+    /* All is good for further processing. */
+    else
+    {
+      /* Determine the number of bytes needed to hold all the coil bits. The cast to
+       * U8 is okay, because we know that numCoils is <= 2000.
+       */
+      uint8_t numBytes = (uint8_t)(numCoils / 8U);
+      if ((numCoils % 8U) != 0U)
+      {
+        numBytes++;
+      }
+      /* Store byte count in the response and prepare the data length. */
+      txPacket->pdu.data[0] = numBytes;
+      txPacket->dataLen = txPacket->pdu.data[0] + 1U;
+      /* Are all the requested coils located in the attached data table? */
+      if (TbxMbServerTableCovers(context->coilTable.baseAddr, 
+                                 context->coilTable.numElements, startAddr, 
+                                 numCoils) == TBX_TRUE)
+      {
+        /* Copy the coil bits directly from the data table to the response. */
+        TbxMbServerBitsRead(context->coilTable.data, 
+                            startAddr - context->coilTable.baseAddr, numCoils,
+                            &txPacket->pdu.data[1]);
+      }
+      /* Is the callback for reading a range of coils registered? */
+      else if (context->readCoilsFcn != NULL)
+      {
+        tTbxMbServerResult srvResult;
+        /* Initialize byte array pointer for writing the coil bits in the response and
+         * initialize all its bytes to all zero (coils OFF) bits.
+         */
+        uint8_t * coilData = &txPacket->pdu.data[1];
+        for (uint8_t byteIdx = 0U; byteIdx < numBytes; byteIdx++)
+        {
+          coilData[byteIdx] = 0U;
+        }
+        /* Obtain all the coil values with a single call. */
+        srvResult = context->readCoilsFcn(context, startAddr, numCoils, coilData);
+        /* Exception reported? */
+        if (srvResult != TBX_MB_SERVER_OK)
+        {
+          /* Prepare exception response. */
+          TbxMbServerResultException(txPacket, srvResult);
+        }
+      }
+      /* Fall back to reading the coils one at a time. */
+      else if (context->readCoilFcn != NULL)
+      {
+        /* Prepare loop indices that aid with storing the coil bits. */
+        uint8_t   bitIdx  = 0U;
+        uint8_t   byteIdx = 0U;
+        /* Initialize byte array pointer for writing the coil bits in the response and
+         * already initialize the first byte to all zero (coils OFF) bits.
+         */
+        uint8_t * coilData = &txPacket->pdu.data[1];
+        coilData[0] = 0U;
+        /* Loop through all the coils. */
+        for (uint16_t idx = 0U; idx < numCoils; idx++)
+        {
+          uint8_t            coilValue = TBX_OFF;
+          tTbxMbServerResult srvResult;
+          /* Obtain coil value. */
+          srvResult = context->readCoilFcn(context, startAddr + idx, &coilValue);
+          /* No exception reported? */
+          if (srvResult == TBX_MB_SERVER_OK)
+          {
+            /* Store the coil value in the response. Note that the coil bits in a byte are
+             * initialized to all zeroes, so only update if a coil is in the ON state.
+             */
+            if (coilValue != TBX_OFF)
+            {
+              coilData[byteIdx] |= (1U << bitIdx);
+            }
+            /* Update the bit index. */
+            bitIdx++;
+            /* Time to move to the next byte? */
+            if (bitIdx == 8U)
+            {
+              /* Reset the bit index, increment the byte index and initialize the byte to
+               * all zero (coils OFF) bits.
+               */
+              bitIdx = 0U;
+              byteIdx++;
+              coilData[byteIdx] = 0U;
+            }
+          }
+          /* Exception detected. */
+          else
+          {
+            /* Prepare exception response. */
+            TbxMbServerResultException(txPacket, srvResult);
+            /* Stop looping. */
+            break;
+          }
+        }
+      }
+      /* Requested coils are not available. */
+      else
+      {
+        /* Prepare exception response. */
+        TbxMbServerException(txPacket, TBX_MB_EC02_ILLEGAL_DATA_ADDRESS);
+      }
+    }
+  }
+} /*** end of TbxMbServerFC01ReadCoils ***/
+#endif
+
+
+#if (TBX_MB_SERVER_FC02_ENABLE > 0U)
+/************************************************************************************//**
+** \brief     Handles a newly received PDU for function code 2 - Read Discrete Inputs.
+** \details   Note that this function is called at a time that txPacket->code is already
+**            prepared. Also note that txPacket->node should not be touched here.
+** \param     context Pointer to the Modbus server channel context.
+** \param     rxPacket Received PDU packet with MUX access.
+** \param     txPacket Storage for the PDU response packet with MUX access.
+**
+****************************************************************************************/
+static void TbxMbServerFC02ReadInputs(tTbxMbServerCtx       * context,
+                                      tTbxMbTpPacket  const * rxPacket,
+                                      tTbxMbTpPacket        * txPacket)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
+  {
+    /* Read out request packet parameters. */
+    uint16_t startAddr = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
+    uint16_t numInputs = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
+
+    /* Check if the quantity of inputs is invalid. */
+    if ((numInputs < 1U) || (numInputs > 2000U))
+    {
+      /* Prepare exception response. */
+      TbxMbServerException(txPacket, TBX_MB_EC03_ILLEGAL_DATA_VALUE);
+    }
+    /* All is good for further processing. */
+    else
+    {
+      /* Determine the number of bytes needed to hold all the input bits. The cast to
+       * U8 is okay, because we know that numInputs is <= 2000.
+       */
+      uint8_t numBytes = (uint8_t)(numInputs / 8U);
+      if ((numInputs % 8U) != 0U)
+      {
+        numBytes++;
+      }
+      /* Store byte count in the response and prepare the data length. */
+      txPacket->pdu.data[0] = numBytes;
+      txPacket->dataLen = txPacket->pdu.data[0] + 1U;
+      /* Are all the requested inputs located in the attached data table? */
+      if (TbxMbServerTableCovers(context->inputTable.baseAddr, 
+                                 context->inputTable.numElements, startAddr, 
+                                 numInputs) == TBX_TRUE)
+      {
+        /* Copy the input bits directly from the data table to the response. */
+        TbxMbServerBitsRead(context->inputTable.data, 
+                            startAddr - context->inputTable.baseAddr, numInputs,
+                            &txPacket->pdu.data[1]);
+      }
+      /* Is the callback for reading a range of inputs registered? */
+      else if (context->readInputsFcn != NULL)
+      {
+        tTbxMbServerResult srvResult;
+        /* Initialize byte array pointer for writing the input bits in the response and
+         * initialize all its bytes to all zero (input OFF) bits.
+         */
+        uint8_t * inputData = &txPacket->pdu.data[1];
+        for (uint8_t byteIdx = 0U; byteIdx < numBytes; byteIdx++)
+        {
+          inputData[byteIdx] = 0U;
+        }
+        /* Obtain all the input values with a single call. */
+        srvResult = context->readInputsFcn(context, startAddr, numInputs, inputData);
+        /* Exception reported? */
+        if (srvResult != TBX_MB_SERVER_OK)
+        {
+          /* Prepare exception response. */
+          TbxMbServerResultException(txPacket, srvResult);
+        }
+      }
+      /* Fall back to reading the inputs one at a time. */
+      else if (context->readInputFcn != NULL)
+      {
+        /* Prepare loop indices that aid with storing the input bits. */
+        uint8_t   bitIdx  = 0U;
+        uint8_t   byteIdx = 0U;
+        /* Initialize byte array pointer for writing the input bits in the response and
+         * already initialize the first byte to all zero (input OFF) bits.
+         */
+        uint8_t * inputData = &txPacket->pdu.data[1];
+        inputData[0] = 0U;
+        /* Loop through all the inputs. */
+        for (uint16_t idx = 0U; idx < numInputs; idx++)
+        {
+          uint8_t            inputValue = TBX_OFF;
+          tTbxMbServerResult srvResult;
+          /* Obtain input value. */
+          srvResult = context->readInputFcn(context, startAddr + idx, &inputValue);
+          /* No exception reported? */
+          if (srvResult == TBX_MB_SERVER_OK)
+          {
+            /* Store the input value in the response. Note that the input bits in a byte
+             * are initialized to all zeroes, so only update if an input is in the ON
+             * state.
+             */
+            if (inputValue != TBX_OFF)
+            {
+              inputData[byteIdx] |= (1U << bitIdx);
+            }
+            /* Update the bit index. */
+            bitIdx++;
+            /* Time to move to the next byte? */
+            if (bitIdx == 8U)
+            {
+              /* Reset the bit index, increment the byte index and initialize the byte to
+               * all zero (input OFF) bits.
+               */
+              bitIdx = 0U;
+              byteIdx++;
+              inputData[byteIdx] = 0U;
+            }
+          }
+          /* Exception detected. */
+          else
+          {
+            /* Prepare exception response. */
+            TbxMbServerResultException(txPacket, srvResult);
+            /* Stop looping. */
+            break;
+          }
+        }
+      }
+      /* Requested inputs are not available. */
+      else
+      {
+        /* Prepare exception response. */
+        TbxMbServerException(txPacket, TBX_MB_EC02_ILLEGAL_DATA_ADDRESS);
+      }
+    }
+  }
+} /*** end of TbxMbServerFC02ReadInputs ***/
+#endif
+
+
+#if (TBX_MB_SERVER_FC03_ENABLE > 0U)
+/************************************************************************************//**
+** \brief     Handles a newly received PDU for function code 3 - Read Holding Registers.
+** \details   Note that this function is called at a time that txPacket->code is already
+**            prepared. Also note that txPacket->node should not be touched here.
+** \param     context Pointer to the Modbus server channel context.
+** \param     rxPacket Received PDU packet with MUX access.
+** \param     txPacket Storage for the PDU response packet with MUX access.
+**
+****************************************************************************************/
+static void TbxMbServerFC03ReadHoldingRegs(tTbxMbServerCtx       * context,
+                                           tTbxMbTpPacket  const * rxPacket,
+                                           tTbxMbTpPacket        * txPacket)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
+  {
+    /* Read out request packet parameters. */
+    uint16_t startAddr = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
+    uint16_t numRegs   = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
+
+    /* Check if the quantity of registers is invalid. */
+    if ((numRegs < 1U) || (numRegs > 125U))
+    {
+      /* Prepare exception response. */
+      TbxMbServerException(txPacket, TBX_MB_EC03_ILLEGAL_DATA_VALUE);
+    }
+    /* All is good for further processing. */
+    else
+    {
+      /* Store byte count in the response and prepare the data length. */
+      txPacket->pdu.data[0] = 2U * numRegs;
+      txPacket->dataLen = txPacket->pdu.data[0] + 1U;
+      /* Are all the requested registers located in the attached data table? */
+      if (TbxMbServerTableCovers(context->holdingRegTable.baseAddr, 
+                                 context->holdingRegTable.numElements, startAddr, 
+                                 numRegs) == TBX_TRUE)
+      {
+        /* Copy the register values directly from the data table to the response. */
+        uint16_t const * regValues = &context->holdingRegTable.data[startAddr - 
+                                                      context->holdingRegTable.baseAddr];
+        for (uint8_t idx = 0U; idx < numRegs; idx++)
+        {
+          TbxMbCommonStoreUInt16BE(regValues[idx], 
+                                   &txPacket->pdu.data[1U + (idx * 2U)]);
+        }
+      }
+      /* Is the callback for reading a range of holding registers registered? */
+      else if (context->readHoldingRegsFcn != NULL)
+      {
+        uint16_t           regValues[125U];
+        tTbxMbServerResult srvResult;
+        /* Obtain all the register values with a single call. The cast to U8 is okay,
+         * because we know that numRegs is <= 125.
+         */
+        srvResult = context->readHoldingRegsFcn(context, startAddr, (uint8_t)numRegs,
+                                                regValues);
+        /* No exception reported? */
+        if (srvResult == TBX_MB_SERVER_OK)
+        {
+          /* Store the register values in the response. */
+          for (uint8_t idx = 0U; idx < numRegs; idx++)
+          {
+            TbxMbCommonStoreUInt16BE(regValues[idx], 
+                                     &txPacket->pdu.data[1U + (idx * 2U)]);
+          }
+        }
+        /* Exception detected. */
+        else
+        {
+          /* Prepare exception response. */
+          TbxMbServerResultException(txPacket, srvResult);
+        }
+      }
+      /* Fall back to reading the registers one at a time. */
+      else if (context->readHoldingRegFcn != NULL)
+      {
+        /* Loop through all the registers. */
+        for (uint8_t idx = 0U; idx < numRegs; idx++)
+        {
+          uint16_t           regValue = 0U;
+          tTbxMbServerResult srvResult;
+          /* Obtain register value. */
+          srvResult = context->readHoldingRegFcn(context, startAddr + idx, &regValue);
+          /* No exception reported? */
+          if (srvResult == TBX_MB_SERVER_OK)
+          {
+            /* Store the register value in the response. */
+            TbxMbCommonStoreUInt16BE(regValue, &txPacket->pdu.data[1U + (idx * 2U)]);
+          }
+          /* Exception detected. */
+          else
+          {
+            /* Prepare exception response. */
+            TbxMbServerResultException(txPacket, srvResult);
+            /* Stop looping. */
+            break;
+          }
+        }
+      }
+      /* Requested registers are not available. */
+      else
+      {
+        /* Prepare exception response. */
+        TbxMbServerException(txPacket, TBX_MB_EC02_ILLEGAL_DATA_ADDRESS);
+      }
+    }
+  }
+} /*** end of TbxMbServerFC03ReadHoldingRegs ***/
+#endif
+
+
+#if (TBX_MB_SERVER_FC04_ENABLE > 0U)
+/************************************************************************************//**
+** \brief     Handles a newly received PDU for function code 4 - Read Input Registers.
+** \details   Note that this function is called at a time that txPacket->code is already
+**            prepared. Also note that txPacket->node should not be touched here.
+** \param     context Pointer to the Modbus server channel context.
+** \param     rxPacket Received PDU packet with MUX access.
+** \param     txPacket Storage for the PDU response packet with MUX access.
+**
+****************************************************************************************/
+static void TbxMbServerFC04ReadInputRegs(tTbxMbServerCtx       * context,
+                                        tTbxMbTpPacket  const * rxPacket,
+                                        tTbxMbTpPacket        * txPacket)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
+  {
+    /* Read out request packet parameters. */
+    uint16_t startAddr = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
+    uint16_t numRegs   = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
+
+    /* Check if the quantity of registers is invalid. */
+    if ((numRegs < 1U) || (numRegs > 125U))
+    {
+      /* Prepare exception response. */
+      TbxMbServerException(txPacket, TBX_MB_EC03_ILLEGAL_DATA_VALUE);
+    }
+    /* All is good for further processing. */
+    else
+    {
+      /* Store byte count in the response and prepare the data length. */
+      txPacket->pdu.data[0] = 2U * numRegs;
+      txPacket->dataLen = txPacket->pdu.data[0] + 1U;
+      /* Are all the requested registers located in the attached data table? */
+      if (TbxMbServerTableCovers(context->inputRegTable.baseAddr, 
+                                 context->inputRegTable.numElements, startAddr, 
+                                 numRegs) == TBX_TRUE)
+      {
+        /* Copy the register values directly from the data table to the response. */
+        uint16_t const * regValues = &context->inputRegTable.data[startAddr - 
+                                                      context->inputRegTable.baseAddr];
+        for (uint8_t idx = 0U; idx < numRegs; idx++)
+        {
+          TbxMbCommonStoreUInt16BE(regValues[idx], 
+                                   &txPacket->pdu.data[1U + (idx * 2U)]);
+        }
+      }
+      /* Is the callback for reading a range of input registers registered? */
+      else if (context->readInputRegsFcn != NULL)
+      {
+        uint16_t           regValues[125U];
+        tTbxMbServerResult srvResult;
+        /* Obtain all the register values with a single call. The cast to U8 is okay,
+         * because we know that numRegs is <= 125.
+         */
+        srvResult = context->readInputRegsFcn(context, startAddr, (uint8_t)numRegs,
+                                              regValues);
+        /* No exception reported? */
+        if (srvResult == TBX_MB_SERVER_OK)
+        {
+          /* Store the register values in the response. */
+          for (uint8_t idx = 0U; idx < numRegs; idx++)
+          {
+            TbxMbCommonStoreUInt16BE(regValues[idx], 
+                                     &txPacket->pdu.data[1U + (idx * 2U)]);
+          }
+        }
+        /* Exception detected. */
+        else
+        {
+          /* Prepare exception response. */
+          TbxMbServerResultException(txPacket, srvResult);
+        }
+      }
+      /* Fall back to reading the registers one at a time. */
+      else if (context->readInputRegFcn != NULL)
+      {
+        /* Loop through all the registers. */
+        for (uint8_t idx = 0U; idx < numRegs; idx++)
+        {
+          uint16_t           regValue = 0U;
+          tTbxMbServerResult srvResult;
+          /* Obtain register value. */
+          srvResult = context->readInputRegFcn(context, startAddr + idx, &regValue);
+          /* No exception reported? */
+          if (srvResult == TBX_MB_SERVER_OK)
+          {
+            /* Store the register value in the response. */
+            TbxMbCommonStoreUInt16BE(regValue, &txPacket->pdu.data[1U + (idx * 2U)]);
+          }
+          /* Exception detected. */
+          else
+          {
+            /* Prepare exception response. */
+            TbxMbServerResultException(txPacket, srvResult);
+            /* Stop looping. */
+            break;
+          }
+        }
+      }
+      /* Requested registers are not available. */
+      else
+      {
+        /* Prepare exception response. */
+        TbxMbServerException(txPacket, TBX_MB_EC02_ILLEGAL_DATA_ADDRESS);
+      }
+    }
+  }
+} /*** end of TbxMbServerFC04ReadInputRegs ***/
+#endif
+
+
+#if (TBX_MB_SERVER_FC05_ENABLE > 0U)
+/************************************************************************************//**
+** \brief     Handles a newly received PDU for function code 5 - Write Single Coil.
+** \details   Note that this function is called at a time that txPacket->code is already
+**            prepared. Also note that txPacket->node should not be touched here.
+** \param     context Pointer to the Modbus server channel context.
+** \param     rxPacket Received PDU packet with MUX access.
+** \param     txPacket Storage for the PDU response packet with MUX access.
+**
+****************************************************************************************/
+static void TbxMbServerFC05WriteSingleCoil(tTbxMbServerCtx       * context,
+                                           tTbxMbTpPacket  const * rxPacket,
+                                           tTbxMbTpPacket        * txPacket)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
+  {
+    /* Read out request packet parameters. */
+    uint16_t startAddr   = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
+    uint16_t outputValue = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
+
+    /* Check if the output value is invalid. */
+    if ((outputValue != 0x0000U) && (outputValue != 0xFF00U))
+    {
+      /* Prepare exception response. */
+      TbxMbServerException(txPacket, TBX_MB_EC03_ILLEGAL_DATA_VALUE);
+    }
+    /* All is good for further processing. */
+    else
+    {
+      /* Prepare the response and its data length. It's the same as the request. */
+      txPacket->pdu.data[0U] = rxPacket->pdu.data[0U];
+      txPacket->pdu.data[1U] = rxPacket->pdu.data[1U];
+      txPacket->pdu.data[2U] = rxPacket->pdu.data[2U];
+      txPacket->pdu.data[3U] = rxPacket->pdu.data[3U];
+      txPacket->dataLen = 4U;
+      /* Write the coil value. */
+      tTbxMbServerResult srvResult = TBX_MB_SERVER_OK;
+      uint8_t            coilBits  = (outputValue == 0x0000U) ? 0x00U : 0x01U;
+      /* Is the coil located in the attached data table? */
+      if (TbxMbServerTableCovers(context->coilTable.baseAddr, 
+                                 context->coilTable.numElements, startAddr, 
+                                 1U) == TBX_TRUE)
+      {
+        /* Write the coil bit directly to the data table. */
+        TbxMbServerBitsWrite(context->coilTable.data, 
+                             startAddr - context->coilTable.baseAddr, 1U, &coilBits);
+      }
+      /* Is the callback for writing a single coil registered? */
+      else if (context->writeCoilFcn != NULL)
+      {
+        uint8_t coilValue = (outputValue == 0x0000U) ? TBX_OFF : TBX_ON;
+        srvResult = context->writeCoilFcn(context, startAddr, coilValue);
+      }
+      /* Is the callback for writing a range of coils registered? */
+      else if (context->writeCoilsFcn != NULL)
+      {
+        srvResult = context->writeCoilsFcn(context, startAddr, 1U, &coilBits);
+      }
+      /* Requested coil is not available. */
+      else
+      {
+        srvResult = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+      }
+      /* Exception reported? */
+      if (srvResult != TBX_MB_SERVER_OK)
+      {
+        /* Prepare exception response. */
+        TbxMbServerResultException(txPacket, srvResult);
+      }
+    }
+  }
+} /*** end of TbxMbServerFC05WriteSingleCoil ***/
+#endif
+
+
+#if (TBX_MB_SERVER_FC06_ENABLE > 0U)
+/************************************************************************************//**
+** \brief     Handles a newly received PDU for function code 6 - Write Single Register.
+** \details   Note that this function is called at a time that txPacket->code is already
+**            prepared. Also note that txPacket->node should not be touched here.
+** \param     context Pointer to the Modbus server channel context.
+** \param     rxPacket Received PDU packet with MUX access.
+** \param     txPacket Storage for the PDU response packet with MUX access.
+**
+****************************************************************************************/
+static void TbxMbServerFC06WriteSingleReg(tTbxMbServerCtx       * context,
+                                          tTbxMbTpPacket  const * rxPacket,
+                                          tTbxMbTpPacket        * txPacket)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
+  {
+    /* Read out request packet parameters. */
+    uint16_t regAddr  = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
+    uint16_t regValue = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
+
+    /* Prepare the response and its data length. It's the same as the request. */
+    txPacket->pdu.data[0U] = rxPacket->pdu.data[0U];
+    txPacket->pdu.data[1U] = rxPacket->pdu.data[1U];
+    txPacket->pdu.data[2U] = rxPacket->pdu.data[2U];
+    txPacket->pdu.data[3U] = rxPacket->pdu.data[3U];
+    txPacket->dataLen = 4U;
+    /* Write the register value. */
+    tTbxMbServerResult srvResult = TBX_MB_SERVER_OK;
+    /* Is the register located in the attached data table? */
+    if (TbxMbServerTableCovers(context->holdingRegTable.baseAddr, 
+                               context->holdingRegTable.numElements, regAddr, 
+                               1U) == TBX_TRUE)
+    {
+      /* Write the register value directly to the data table. */
+      context->holdingRegTable.data[regAddr - context->holdingRegTable.baseAddr] = 
+        regValue;
+      /* Register the change for the flush callback. */
+      TbxMbServerShadowMark(context, regAddr, 1U);
+    }
+    /* Is the callback for writing a single holding register registered? */
+    else if (context->writeHoldingRegFcn != NULL)
+    {
+      srvResult = context->writeHoldingRegFcn(context, regAddr, regValue);
+    }
+    /* Is the callback for writing a range of holding registers registered? */
+    else if (context->writeHoldingRegsFcn != NULL)
+    {
+      srvResult = context->writeHoldingRegsFcn(context, regAddr, 1U, &regValue);
+    }
+    /* Requested register is not available. */
+    else
+    {
+      srvResult = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+    }
+    /* Exception reported? */
+    if (srvResult != TBX_MB_SERVER_OK)
+    {
+      /* Prepare exception response. */
+      TbxMbServerResultException(txPacket, srvResult);
+    }
+  }
+} /*** end of TbxMbServerFC06WriteSingleReg ***/
+#endif
+
+
+#if (TBX_MB_SERVER_FC08_ENABLE > 0U)
+/************************************************************************************//**
+** \brief     Handles a newly received PDU for function code 8 - Diagnostics.
+** \details   Note that this function is called at a time that txPacket->code is already
+**            prepared. Also note that txPacket->node should not be touched here.
+** \param     context Pointer to the Modbus server channel context.
+** \param     rxPacket Received PDU packet with MUX access.
+** \param     txPacket Storage for the PDU response packet with MUX access.
+**
+****************************************************************************************/
+static void TbxMbServerFC08Diagnostics(tTbxMbServerCtx       * context,
+                                       tTbxMbTpPacket  const * rxPacket,
+                                       tTbxMbTpPacket        * txPacket)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
+  {
+    /* Read out request packet parameters. */
+    uint16_t subCode   = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
+    uint16_t dataField = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
+    uint8_t  dataLen   = rxPacket->dataLen;
+    /* Prepare the most common response. It's typically the sub-function code echoed,
+     * together with a 16-bit unsigned value.
+     */
+    txPacket->pdu.data[0U] = rxPacket->pdu.data[0U];
+    txPacket->pdu.data[1U] = rxPacket->pdu.data[1U];
+    txPacket->dataLen = 4U;
+
+    /* Filter on the received sub-function code. */
+    switch (subCode)
+    {
+      case TBX_MB_DIAG_SC_QUERY_DATA:
+      {
+        /* Echo the received data back. */
+        for (uint8_t idx = 0U; idx < dataLen; idx++)
+        {
+         txPacket->pdu.data[idx] = rxPacket->pdu.data[idx];
+        }
+        txPacket->dataLen = dataLen;
+      }
+      break;
+
+      case TBX_MB_DIAG_SC_CLEAR_COUNTERS:
+      {
+        /* Data field not valid? */
+        if (dataField != 0x0000U)
+        {
+          /* Prepare exception response. */
+          TbxMbServerException(txPacket, TBX_MB_EC03_ILLEGAL_DATA_VALUE);
+        }
+        /* All is good for further processing. */        
+        else
+        {
+          /* Clear the diagnostic counters. */
+          context->tpCtx->diagInfo.busMsgCnt     = 0U;
+          context->tpCtx->diagInfo.busCommErrCnt = 0U;
+          context->tpCtx->diagInfo.busExcpErrCnt = 0U;
+          context->tpCtx->diagInfo.srvMsgCnt     = 0U;
+          context->tpCtx->diagInfo.srvNoRespCnt  = 0U;
+          /* Echo the request data field. */
+          TbxMbCommonStoreUInt16BE(dataField, &txPacket->pdu.data[2U]);
+        }
+      }
+      break;
+
+      case TBX_MB_DIAG_SC_BUS_MESSAGE_COUNT:
+      {
+        /* Data field not valid? */
+        if (dataField != 0x0000U)
+        {
+          /* Prepare exception response. */
+          TbxMbServerException(txPacket, TBX_MB_EC03_ILLEGAL_DATA_VALUE);
+        }
+        /* All is good for further processing. */        
+        else
+        {
+          /* Store he bus message count. */
+          TbxMbCommonStoreUInt16BE(context->tpCtx->diagInfo.busMsgCnt, 
+                                   &txPacket->pdu.data[2U]);
+        }
+      }
+      break;
+
+      case TBX_MB_DIAG_SC_BUS_COMM_ERROR_COUNT:
+      {
+        /* Data field not valid? */
+        if (dataField != 0x0000U)
+        {
+          /* Prepare exception response. */
+          TbxMbServerException(txPacket, TBX_MB_EC03_ILLEGAL_DATA_VALUE);
+        }
+        /* All is good for further processing. */        
+        else
+        {
+          /* Store he bus message count. */
+          TbxMbCommonStoreUInt16BE(context->tpCtx->diagInfo.busCommErrCnt, 
+                                   &txPacket->pdu.data[2U]);
+        }
+      }
+      break;
+
+      case TBX_MB_DIAG_SC_BUS_EXCEPTION_ERROR_COUNT:
+      {
+        /* Data field not valid? */
+        if (dataField != 0x0000U)
+        {
+          /* Prepare exception response. */
+          TbxMbServerException(txPacket, TBX_MB_EC03_ILLEGAL_DATA_VALUE);
+        }
+        /* All is good for further processing. */        
+        else
+        {
+          /* Store he bus message count. */
+          TbxMbCommonStoreUInt16BE(context->tpCtx->diagInfo.busExcpErrCnt, 
+                                   &txPacket->pdu.data[2U]);
+        }
+      }
+      break;
+
+      case TBX_MB_DIAG_SC_SERVER_MESSAGE_COUNT:
+      {
+        /* Data field not valid? */
+        if (dataField != 0x0000U)
+        {
+          /* Prepare exception response. */
+          TbxMbServerException(txPacket, TBX_MB_EC03_ILLEGAL_DATA_VALUE);
+        }
+        /* All is good for further processing. */        
+        else
+        {
+          /* Store he bus message count. */
+          TbxMbCommonStoreUInt16BE(context->tpCtx->diagInfo.srvMsgCnt, 
+                                   &txPacket->pdu.data[2U]);
+        }
+      }
+      break;
+
+      case TBX_MB_DIAG_SC_SERVER_NO_RESPONSE_COUNT:
+      {
+        /* Data field not valid? */
+        if (dataField != 0x0000U)
+        {
+          /* Prepare exception response. */
+          TbxMbServerException(txPacket, TBX_MB_EC03_ILLEGAL_DATA_VALUE);
+        }
+        /* All is good for further processing. */        
+        else
+        {
+          /* Store he bus message count. */
+          TbxMbCommonStoreUInt16BE(context->tpCtx->diagInfo.srvNoRespCnt, 
+                                   &txPacket->pdu.data[2U]);
+        }
+      }
+      break;
+
+      default:
+      {
+        /* Unsupported sub-function code. Prepare exception response. */
+        TbxMbServerException(txPacket, TBX_MB_EC01_ILLEGAL_FUNCTION);
+      }
+      break;
+    }
+  }
+} /*** end of TbxMbServerFC08Diagnostics ***/
+#endif
+
+
+#if (TBX_MB_SERVER_FC15_ENABLE > 0U)
+/************************************************************************************//**
+** \brief     Handles a newly received PDU for function code 15 - Write Multiple Coils.
+** \details   Note that this function is called at a time that txPacket->code is already
+**            prepared. Also note that txPacket->node should not be touched here.
+** \param     context Pointer to the Modbus server channel context.
+** \param     rxPacket Received PDU packet with MUX access.
+** \param     txPacket Storage for the PDU response packet with MUX access.
+**
+****************************************************************************************/
+static void TbxMbServerFC15WriteMultipleCoils(tTbxMbServerCtx       * context,
+                                              tTbxMbTpPacket  const * rxPacket,
+                                              tTbxMbTpPacket        * txPacket)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
+  {
+    /* Read out request packet parameters. */
+    uint16_t startAddr = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
+    uint16_t numCoils  = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
+    uint8_t  byteCnt   = rxPacket->pdu.data[4];
+    /* Determine the number of bytes needed to hold all the coil bits. Make it U16 
+     * because the range validity of numCoils is not yet checked.
+     */
+    uint16_t numBytes = (uint16_t)(numCoils / 8U);
+    if ((numCoils % 8U) != 0U)
+    {
+      numBytes++;
+    }
+    /* Check if the quantity of coils is invalid. */
+    if (((numCoils < 1U) || (numCoils > 1968U)))
+    {
+      /* Prepare exception response. */
+      TbxMbServerException(txPacket, TBX_MB_EC03_ILLEGAL_DATA_VALUE);
+    }
+    /* Check if the quantity of bytes is invalid or doesn't match the request length. */
+    else if ((numBytes != byteCnt) || (rxPacket->dataLen != (byteCnt + 5U)))
+    {
+      /* Prepare exception response. */
+      TbxMbServerException(txPacket, TBX_MB_EC03_ILLEGAL_DATA_VALUE);
+    }
+    /* All is good for further processing. */
+    else
+    {
+      /* Prepare the response and its data length. It's mostly the same as the request.*/
+      txPacket->pdu.data[0U] = rxPacket->pdu.data[0U];
+      txPacket->pdu.data[1U] = rxPacket->pdu.data[1U];
+      txPacket->pdu.data[2U] = rxPacket->pdu.data[2U];
+      txPacket->pdu.data[3U] = rxPacket->pdu.data[3U];
+      txPacket->dataLen = 4U;
+      /* Are all the requested coils located in the attached data table? */
+      if (TbxMbServerTableCovers(context->coilTable.baseAddr, 
+                                 context->coilTable.numElements, startAddr, 
+                                 numCoils) == TBX_TRUE)
+      {
+        /* Copy the coil bits from the request directly to the data table. */
+        TbxMbServerBitsWrite(context->coilTable.data, 
+                             startAddr - context->coilTable.baseAddr, numCoils,
+                             &rxPacket->pdu.data[5]);
+      }
+      /* Is the callback for writing a range of coils registered? */
+      else if (context->writeCoilsFcn != NULL)
+      {
+        tTbxMbServerResult srvResult;
+        /* Write all the coil values with a single call. The coil bits in the request
+         * are already in the format that the callback expects.
+         */
+        srvResult = context->writeCoilsFcn(context, startAddr, numCoils, 
+                                           &rxPacket->pdu.data[5]);
+        /* Exception reported? */
+        if (srvResult != TBX_MB_SERVER_OK)
+        {
+          /* Prepare exception response. */
+          TbxMbServerResultException(txPacket, srvResult);
+        }
+      }
+      /* Fall back to writing the coils one at a time. */
+      else if (context->writeCoilFcn != NULL)
+      {
+        /* Prepare loop indices that aid with writing the coil bits. */
+        uint8_t         bitIdx  = 0U;
+        uint8_t         byteIdx = 0U;
+        /* Initialize byte array pointer for reading the coil bits from the request. */
+        uint8_t const * coilData = &rxPacket->pdu.data[5];
+        /* Loop through all the coils. */
+        for (uint16_t idx = 0U; idx < numCoils; idx++)
+        {
+          uint8_t            coilValue = TBX_OFF;
+          tTbxMbServerResult srvResult;
+          /* Extract the requested coil value. */
+          if ((coilData[byteIdx] & (1U << bitIdx)) != 0U)
+          {
+            coilValue = TBX_ON;
+          }
+          /* Write the coil value. */
+          srvResult = context->writeCoilFcn(context, startAddr + idx, coilValue);
+          /* Exception reported? */
+          if (srvResult != TBX_MB_SERVER_OK)
+          {
+            /* Prepare exception response. */
+            TbxMbServerResultException(txPacket, srvResult);
+            /* Stop looping. */
+            break;
+          }
+          /* Update the bit index. */
+          bitIdx++;
+          /* Time to move to the next byte? */
+          if (bitIdx == 8U)
+          {
+            /* Reset the bit index and increment the byte index. */
+            bitIdx = 0U;
+            byteIdx++;
+          }
+        }
+      }
+      /* Requested coils are not available. */
+      else
+      {
+        /* Prepare exception response. */
+        TbxMbServerException(txPacket, TBX_MB_EC02_ILLEGAL_DATA_ADDRESS);
+      }
+    }
+  }
+} /*** end of TbxMbServerFC15WriteMultipleCoils ***/
+#endif
+
+
+#if (TBX_MB_SERVER_FC16_ENABLE > 0U)
+/************************************************************************************//**
+** \brief     Handles a newly received PDU for function code 16 - Write Multiple
+**            Registers.
+** \details   Note that this function is called at a time that txPacket->code is already
+**            prepared. Also note that txPacket->node should not be touched here.
+** \param     context Pointer to the Modbus server channel context.
+** \param     rxPacket Received PDU packet with MUX access.
+** \param     txPacket Storage for the PDU response packet with MUX access.
+**
+****************************************************************************************/
+static void TbxMbServerFC16WriteMultipleRegs(tTbxMbServerCtx       * context,
+                                             tTbxMbTpPacket  const * rxPacket,
+                                             tTbxMbTpPacket        * txPacket)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
+  {
+    /* Read out request packet parameters. */
+    uint16_t startAddr = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
+    uint16_t numRegs   = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
+    uint8_t  byteCnt   = rxPacket->pdu.data[4];
+
+    /* Check if the quantity of registers is invalid. */
+    if (((numRegs < 1U) || (numRegs > 123U)) || (byteCnt != (numRegs * 2U)) ||
+        (rxPacket->dataLen != (byteCnt + 5U)))
+    {
+      /* Prepare exception response. */
+      TbxMbServerException(txPacket, TBX_MB_EC03_ILLEGAL_DATA_VALUE);
+    }
+    /* All is good for further processing. */
+    else
+    {
+      /* Prepare the response and its data length. It's mostly the same as the request.*/
+      txPacket->pdu.data[0U] = rxPacket->pdu.data[0U];
+      txPacket->pdu.data[1U] = rxPacket->pdu.data[1U];
+      txPacket->pdu.data[2U] = rxPacket->pdu.data[2U];
+      txPacket->pdu.data[3U] = rxPacket->pdu.data[3U];
+      txPacket->dataLen = 4U;
+      /* Are all the requested registers located in the attached data table? */
+      if (TbxMbServerTableCovers(context->holdingRegTable.baseAddr, 
+                                 context->holdingRegTable.numElements, startAddr, 
+                                 numRegs) == TBX_TRUE)
+      {
+        /* Copy the register values from the request directly to the data table. */
+        uint16_t * regValues = &context->holdingRegTable.data[startAddr - 
+                                                   context->holdingRegTable.baseAddr];
+        for (uint8_t idx = 0U; idx < numRegs; idx++)
+        {
+          regValues[idx] = TbxMbCommonExtractUInt16BE(
+                             &rxPacket->pdu.data[5U + (idx * 2U)]);
+        }
+        /* Register the changes for the flush callback. */
+        TbxMbServerShadowMark(context, startAddr, numRegs);
+      }
+      /* Is the callback for writing a range of holding registers registered? */
+      else if (context->writeHoldingRegsFcn != NULL)
+      {
+        uint16_t           regValues[123U];
+        tTbxMbServerResult srvResult;
+        /* Extract the requested register values. */
+        for (uint8_t idx = 0U; idx < numRegs; idx++)
+        {
+          regValues[idx] = TbxMbCommonExtractUInt16BE(
+                             &rxPacket->pdu.data[5U + (idx * 2U)]);
+        }
+        /* Write all the register values with a single call. The cast to U8 is okay,
+         * because we know that numRegs is <= 123.
+         */
+        srvResult = context->writeHoldingRegsFcn(context, startAddr, (uint8_t)numRegs,
+                                                 regValues);
+        /* Exception reported? */
+        if (srvResult != TBX_MB_SERVER_OK)
+        {
+          /* Prepare exception response. */
+          TbxMbServerResultException(txPacket, srvResult);
+        }
+      }
+      /* Fall back to writing the registers one at a time. */
+      else if (context->writeHoldingRegFcn != NULL)
+      {
+        /* Loop through all the registers. */
+        for (uint8_t idx = 0U; idx < numRegs; idx++)
+        {
+          uint16_t           regValue;
+          tTbxMbServerResult srvResult;
+          /* Extract the requested register value. */
+          regValue = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[5U + (idx * 2U)]);
+          /* Write the register value. */
+          srvResult = context->writeHoldingRegFcn(context, startAddr + idx, regValue);
+          /* Exception reported? */
+          if (srvResult != TBX_MB_SERVER_OK)
+          {
+            /* Prepare exception response. */
+            TbxMbServerResultException(txPacket, srvResult);
+            /* Stop looping. */
+            break;
+          }
+        }
+      }
+      /* Requested registers are not available. */
+      else
+      {
+        /* Prepare exception response. */
+        TbxMbServerException(txPacket, TBX_MB_EC02_ILLEGAL_DATA_ADDRESS);
+      }
+    }
+  }
+} /*** end of TbxMbServerFC16WriteMultipleRegs ***/
+#endif
+
+
+#if (TBX_MB_SERVER_FC22_ENABLE > 0U)
+/************************************************************************************//**
+** \brief     Handles a newly received PDU for function code 22 - Mask Write Register.
+** \details   Note that this function is called at a time that txPacket->code is already
+**            prepared. Also note that txPacket->node should not be touched here.
+** \param     context Pointer to the Modbus server channel context.
+** \param     rxPacket Received PDU packet with MUX access.
+** \param     txPacket Storage for the PDU response packet with MUX access.
+**
+****************************************************************************************/
+static void TbxMbServerFC22MaskWriteReg(tTbxMbServerCtx       * context,
+                                        tTbxMbTpPacket  const * rxPacket,
+                                        tTbxMbTpPacket        * txPacket)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
+  {
+    /* Read out request packet parameters. */
+    uint16_t refAddr = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
+    uint16_t andMask = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
+    uint16_t orMask  = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[4]);
+
+    uint8_t            regData[2U];
+    tTbxMbServerResult srvResult;
+    /* Read the current register value. */
+    srvResult = TbxMbServerHoldingRegsRead(context, refAddr, 1U, regData);
+    /* No exception reported? */
+    if (srvResult == TBX_MB_SERVER_OK)
+    {
+      /* Modify the register value, as specified by the protocol, and write it. */
+      uint16_t regValue = TbxMbCommonExtractUInt16BE(regData);
+      regValue = (regValue & andMask) | (orMask & (uint16_t)~andMask);
+      TbxMbCommonStoreUInt16BE(regValue, regData);
+      srvResult = TbxMbServerHoldingRegsWrite(context, refAddr, 1U, regData);
+    }
+    /* No exception reported? */
+    if (srvResult == TBX_MB_SERVER_OK)
+    {
+      /* The response is an echo of the request. */
+      for (uint8_t idx = 0U; idx < 6U; idx++)
+      {
+        txPacket->pdu.data[idx] = rxPacket->pdu.data[idx];
+      }
+      txPacket->dataLen = 6U;
+    }
+    /* Exception detected. */
+    else
+    {
       /* Prepare exception response. */
-      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-      txPacket->pdu.data[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
-      txPacket->dataLen = 1U;
+      TbxMbServerResultException(txPacket, srvResult);
     }
-    /* Check if the quantity of coils is invalid. */
-    else if ((numCoils < 1U) || (numCoils > 2000U))
+  }
+} /*** end of TbxMbServerFC22MaskWriteReg ***/
+#endif
+
+
+#if (TBX_MB_SERVER_FC23_ENABLE > 0U)
+/************************************************************************************//**
+** \brief     Handles a newly received PDU for function code 23 - Read/Write Multiple
+**            Registers. As specified by the protocol, the write operation is performed
+**            before the read operation.
+** \details   Note that this function is called at a time that txPacket->code is already
+**            prepared. Also note that txPacket->node should not be touched here.
+** \param     context Pointer to the Modbus server channel context.
+** \param     rxPacket Received PDU packet with MUX access.
+** \param     txPacket Storage for the PDU response packet with MUX access.
+**
+****************************************************************************************/
+static void TbxMbServerFC23ReadWriteRegs(tTbxMbServerCtx       * context,
+                                         tTbxMbTpPacket  const * rxPacket,
+                                         tTbxMbTpPacket        * txPacket)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
+  {
+    /* Read out request packet parameters. */
+    uint16_t readAddr  = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
+    uint16_t readNum   = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
+    uint16_t writeAddr = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[4]);
+    uint16_t writeNum  = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[6]);
+    uint8_t  byteCnt   = rxPacket->pdu.data[8];
+
+    /* Check if the quantity of registers to read or to write is invalid. */
+    if (((readNum < 1U) || (readNum > 125U)) ||
+        ((writeNum < 1U) || (writeNum > 121U)) || (byteCnt != (writeNum * 2U)) ||
+        (rxPacket->dataLen != (byteCnt + 9U)))
     {
       /* Prepare exception response. */
-      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-      txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
-      txPacket->dataLen = 1U;
+      TbxMbServerException(txPacket, TBX_MB_EC03_ILLEGAL_DATA_VALUE);
     }
     /* All is good for further processing. */
     else
     {
-      /* Determine the number of bytes needed to hold all the coil bits. The cast to
-       * U8 is okay, because we know that numCoils is <= 2000.
+      tTbxMbServerResult srvResult;
+      /* First write the register values from the request. The casts to U8 are okay,
+       * because we know that writeNum is <= 121 and readNum is <= 125.
        */
-      uint8_t numBytes = (uint8_t)(numCoils / 8U);
-      if ((numCoils % 8U) != 0U)
+      srvResult = TbxMbServerHoldingRegsWrite(context, writeAddr, (uint8_t)writeNum,
+                                              &rxPacket->pdu.data[9]);
+      /* No exception reported? */
+      if (srvResult == TBX_MB_SERVER_OK)
       {
-        numBytes++;
+        /* Next, read the register values directly into the response. */
+        srvResult = TbxMbServerHoldingRegsRead(context, readAddr, (uint8_t)readNum,
+                                               &txPacket->pdu.data[1]);
       }
-      /* Store byte count in the response and prepare the data length. */
-      txPacket->pdu.data[0] = numBytes;
-      txPacket->dataLen = txPacket->pdu.data[0] + 1U;
-      /* Prepare loop indices that aid with storing the coil bits. */
-      uint8_t   bitIdx  = 0U;
-      uint8_t   byteIdx = 0U;
-      /* Initialize byte array pointer for writing the coil bits in the response and
-       * already initialize the first byte to all zero (coils OFF) bits.
-       */
-      uint8_t * coilData = &txPacket->pdu.data[1];
-      coilData[0] = 0U;
-      /* Loop through all the coils. */
-      for (uint16_t idx = 0U; idx < numCoils; idx++)
+      /* No exception reported? */
+      if (srvResult == TBX_MB_SERVER_OK)
       {
-        uint8_t            coilValue = TBX_OFF;
-        tTbxMbServerResult srvResult;
-        /* Obtain coil value. */
-        srvResult = context->readCoilFcn(context, startAddr + idx, &coilValue);
-        /* No exception reported? */
-        if (srvResult == TBX_MB_SERVER_OK)
-        {
-          /* Store the coil value in the response. Note that the coil bits in a byte are
-           * initialized to all zeroes, so only update if a coil is in the ON state.
-           */
-          if (coilValue != TBX_OFF)
-          {
-            coilData[byteIdx] |= (1U << bitIdx);
-          }
-          /* Update the bit index. */
-          bitIdx++;
-          /* Time to move to the next byte? */
-          if (bitIdx == 8U)
-          {
-            /* Reset the bit index, increment the byte index and initialize the byte to
-             * all zero (coils OFF) bits.
-             */
-            bitIdx = 0U;
-            byteIdx++;
-            coilData[byteIdx] = 0U;
-          }
-        }
-        /* Exception detected. */
-        else
-        {
-          /* Prepare exception response. */
-          txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-          if (srvResult == TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR)
-          {
-            txPacket->pdu.data[0] = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
-          }
-          else
-          {
-            txPacket->pdu.data[0] = TBX_MB_EC04_SERVER_DEVICE_FAILURE;
-          }
-          txPacket->dataLen = 1U;
-          /* Stop looping. */
-          break;
-        }
+        /* Store byte count in the response and prepare the data length. */
+        txPacket->pdu.data[0] = (uint8_t)(readNum * 2U);
+        txPacket->dataLen = txPacket->pdu.data[0] + 1U;
+      }
+      /* Exception detected. */
+      else
+      {
+        /* Prepare exception response. */
+        TbxMbServerResultException(txPacket, srvResult);
       }
     }
   }
-} /*** end of TbxMbServerFC01ReadCoils ***/
+} /*** end of TbxMbServerFC23ReadWriteRegs ***/
+#endif
 
 
+#if (TBX_MB_SERVER_FC20_ENABLE > 0U)
 /************************************************************************************//**
-** \brief     Handles a newly received PDU for function code 2 - Read Discrete Inputs.
+** \brief     Handles a newly received PDU for function code 20 - Read File Record.
 ** \details   Note that this function is called at a time that txPacket->code is already
 **            prepared. Also note that txPacket->node should not be touched here.
 ** \param     context Pointer to the Modbus server channel context.
@@ -694,9 +2857,9 @@ static void TbxMbServerFC01ReadCoils(tTbxMbServerCtx       * context,
 ** \param     txPacket Storage for the PDU response packet with MUX access.
 **
 ****************************************************************************************/
-static void TbxMbServerFC02ReadInputs(tTbxMbServerCtx       * context,
-                                      tTbxMbTpPacket  const * rxPacket,
-                                      tTbxMbTpPacket        * txPacket)
+static void TbxMbServerFC20ReadFileRecord(tTbxMbServerCtx       * context,
+                                          tTbxMbTpPacket  const * rxPacket,
+                                          tTbxMbTpPacket        * txPacket)
 {
   /* Verify parameters. */
   TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
@@ -705,103 +2868,120 @@ static void TbxMbServerFC02ReadInputs(tTbxMbServerCtx       * context,
   if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
   {
     /* Read out request packet parameters. */
-    uint16_t startAddr = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
-    uint16_t numInputs = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
+    uint8_t  byteCnt       = rxPacket->pdu.data[0];
+    uint8_t  exceptionCode = 0U;
+    /* Response data length. Starts with the response data length byte. */
+    uint16_t respLen       = 1U;
 
-    /* Check if a callback function was registered. */
-    if (context->readInputFcn == NULL)
+    /* Check if the byte count is invalid. Each sub-request is 7 bytes. */
+    if ((byteCnt < 7U) || (byteCnt > 0xF5U) || ((byteCnt % 7U) != 0U) ||
+        (rxPacket->dataLen != (byteCnt + 1U)))
     {
-      /* Prepare exception response. */
-      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-      txPacket->pdu.data[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
-      txPacket->dataLen = 1U;
+      exceptionCode = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
     }
-    /* Check if the quantity of inputs is invalid. */
-    else if ((numInputs < 1U) || (numInputs > 2000U))
+    /* Check all the sub-requests, before calling the callback function. */
+    else
     {
-      /* Prepare exception response. */
-      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-      txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
-      txPacket->dataLen = 1U;
+      for (uint8_t offset = 1U; offset <= byteCnt; offset += 7U)
+      {
+        uint8_t const * subReq = &rxPacket->pdu.data[offset];
+        /* Validate the sub-request. */
+        exceptionCode = TbxMbServerFileSubReqCheck(subReq);
+        /* Add the sub-response length: length byte, reference type and the records. */
+        respLen += 2U + (TbxMbCommonExtractUInt16BE(&subReq[5]) * 2U);
+        /* Sub-request invalid or response too long? */
+        if ((exceptionCode == 0U) && (respLen > TBX_MB_TP_PDU_DATA_LEN_MAX))
+        {
+          exceptionCode = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
+        }
+        if (exceptionCode != 0U)
+        {
+          /* Stop looping. */
+          break;
+        }
+      }
     }
-    /* All is good for further processing. */
-    else
+    /* All is good for further processing? */
+    if (exceptionCode == 0U)
     {
-      /* Determine the number of bytes needed to hold all the input bits. The cast to
-       * U8 is okay, because we know that numInputs is <= 2000.
+      uint16_t        values[124U];
+      uint8_t         reqDataCopy[0xF6U];
+      uint8_t const * reqData = &rxPacket->pdu.data[0];
+      uint8_t       * subResp = &txPacket->pdu.data[1];
+      /* A compact transport layer shares one packet buffer for the request and the
+       * response. The sub-responses would then overwrite the sub-requests that are
+       * not yet processed, so work with a copy of the sub-requests in this case.
        */
-      uint8_t numBytes = (uint8_t)(numInputs / 8U);
-      if ((numInputs % 8U) != 0U)
+      if (rxPacket == txPacket)
       {
-        numBytes++;
+        for (uint8_t idx = 0U; idx <= byteCnt; idx++)
+        {
+          reqDataCopy[idx] = rxPacket->pdu.data[idx];
+        }
+        reqData = &reqDataCopy[0];
       }
-      /* Store byte count in the response and prepare the data length. */
-      txPacket->pdu.data[0] = numBytes;
-      txPacket->dataLen = txPacket->pdu.data[0] + 1U;
-      /* Prepare loop indices that aid with storing the input bits. */
-      uint8_t   bitIdx  = 0U;
-      uint8_t   byteIdx = 0U;
-      /* Initialize byte array pointer for writing the input bits in the response and
-       * already initialize the first byte to all zero (input OFF) bits.
+      /* Process the sub-requests one at a time. The callback function reads just the
+       * requested records and they are stored in the response right away. Note that
+       * respLen already guarantees that all sub-responses fit in the response.
        */
-      uint8_t * inputData = &txPacket->pdu.data[1];
-      inputData[0] = 0U;
-      /* Loop through all the inputs. */
-      for (uint16_t idx = 0U; idx < numInputs; idx++)
+      for (uint8_t offset = 1U; offset <= byteCnt; offset += 7U)
       {
-        uint8_t            inputValue = TBX_OFF;
+        uint8_t const * subReq = &reqData[offset];
         tTbxMbServerResult srvResult;
-        /* Obtain input value. */
-        srvResult = context->readInputFcn(context, startAddr + idx, &inputValue);
-        /* No exception reported? */
-        if (srvResult == TBX_MB_SERVER_OK)
-        {
-          /* Store the input value in the response. Note that the input bits in a byte
-           * are initialized to all zeroes, so only update if an input is in the ON
-           * state.
-           */
-          if (inputValue != TBX_OFF)
-          {
-            inputData[byteIdx] |= (1U << bitIdx);
-          }
-          /* Update the bit index. */
-          bitIdx++;
-          /* Time to move to the next byte? */
-          if (bitIdx == 8U)
-          {
-            /* Reset the bit index, increment the byte index and initialize the byte to
-             * all zero (input OFF) bits.
-             */
-            bitIdx = 0U;
-            byteIdx++;
-            inputData[byteIdx] = 0U;
-          }
-        }
-        /* Exception detected. */
-        else
+        /* Read out the sub-request parameters. The cast to U8 is okay, because
+         * respLen already verified that num is <= 124.
+         */
+        uint16_t file   = TbxMbCommonExtractUInt16BE(&subReq[1]);
+        uint16_t record = TbxMbCommonExtractUInt16BE(&subReq[3]);
+        uint8_t  num    = (uint8_t)TbxMbCommonExtractUInt16BE(&subReq[5]);
+        /* Obtain the record values. */
+        srvResult = context->readFileRecordFcn(context, file, record, num, values);
+        /* Exception reported? */
+        if (srvResult != TBX_MB_SERVER_OK)
         {
-          /* Prepare exception response. */
-          txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
           if (srvResult == TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR)
           {
-            txPacket->pdu.data[0] = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
+            exceptionCode = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
           }
           else
           {
-            txPacket->pdu.data[0] = TBX_MB_EC04_SERVER_DEVICE_FAILURE;
+            exceptionCode = TBX_MB_EC04_SERVER_DEVICE_FAILURE;
           }
-          txPacket->dataLen = 1U;
           /* Stop looping. */
           break;
         }
+        /* Store the sub-response: its length, reference type and record values. */
+        subResp[0] = (num * 2U) + 1U;
+        subResp[1] = TBX_MB_FILE_REF_TYPE;
+        for (uint8_t idx = 0U; idx < num; idx++)
+        {
+          TbxMbCommonStoreUInt16BE(values[idx], &subResp[2U + (idx * 2U)]);
+        }
+        subResp = &subResp[2U + (num * 2U)];
       }
     }
+    /* Exception detected? */
+    if (exceptionCode != 0U)
+    {
+      /* Prepare exception response. */
+      TbxMbServerException(txPacket, exceptionCode);
+    }
+    else
+    {
+      /* Store the response data length and prepare the data length. The cast to U8 is
+       * okay, because respLen is <= TBX_MB_TP_PDU_DATA_LEN_MAX.
+       */
+      txPacket->pdu.data[0] = (uint8_t)(respLen - 1U);
+      txPacket->dataLen = (uint8_t)respLen;
+    }
   }
-} /*** end of TbxMbServerFC02ReadInputs ***/
+} /*** end of TbxMbServerFC20ReadFileRecord ***/
+#endif
 
 
+#if (TBX_MB_SERVER_FC21_ENABLE > 0U)
 /************************************************************************************//**
-** \brief     Handles a newly received PDU for function code 3 - Read Holding Registers.
+** \brief     Handles a newly received PDU for function code 21 - Write File Record.
 ** \details   Note that this function is called at a time that txPacket->code is already
 **            prepared. Also note that txPacket->node should not be touched here.
 ** \param     context Pointer to the Modbus server channel context.
@@ -809,7 +2989,7 @@ static void TbxMbServerFC02ReadInputs(tTbxMbServerCtx       * context,
 ** \param     txPacket Storage for the PDU response packet with MUX access.
 **
 ****************************************************************************************/
-static void TbxMbServerFC03ReadHoldingRegs(tTbxMbServerCtx       * context,
+static void TbxMbServerFC21WriteFileRecord(tTbxMbServerCtx       * context,
                                            tTbxMbTpPacket  const * rxPacket,
                                            tTbxMbTpPacket        * txPacket)
 {
@@ -820,69 +3000,285 @@ static void TbxMbServerFC03ReadHoldingRegs(tTbxMbServerCtx       * context,
   if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
   {
     /* Read out request packet parameters. */
-    uint16_t startAddr = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
-    uint16_t numRegs   = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
+    uint8_t  byteCnt       = rxPacket->pdu.data[0];
+    uint8_t  exceptionCode = 0U;
 
-    /* Check if a callback function was registered. */
-    if (context->readHoldingRegFcn == NULL)
+    /* Check if the byte count is invalid. A sub-request is at least 9 bytes. */
+    if ((byteCnt < 9U) || (byteCnt > 0xFBU) || (rxPacket->dataLen != (byteCnt + 1U)))
     {
-      /* Prepare exception response. */
-      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-      txPacket->pdu.data[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
-      txPacket->dataLen = 1U;
+      exceptionCode = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
     }
-    /* Check if the quantity of registers is invalid. */
-    else if ((numRegs < 1U) || (numRegs > 125U))
+    /* Check all the sub-requests, before calling the callback function. */
+    else
     {
-      /* Prepare exception response. */
-      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-      txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
-      txPacket->dataLen = 1U;
+      uint16_t offset = 1U;
+      while (offset <= byteCnt)
+      {
+        uint8_t const * subReq = &rxPacket->pdu.data[offset];
+        /* Validate the sub-request header, if completely present. */
+        if ((offset + 7U) > (byteCnt + 1U))
+        {
+          exceptionCode = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
+        }
+        else
+        {
+          exceptionCode = TbxMbServerFileSubReqCheck(subReq);
+          /* Skip the sub-request header and its record values. */
+          offset += 7U + (TbxMbCommonExtractUInt16BE(&subReq[5]) * 2U);
+          /* Sub-request record values not completely present? */
+          if ((exceptionCode == 0U) && (offset > (byteCnt + 1U)))
+          {
+            exceptionCode = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
+          }
+        }
+        if (exceptionCode != 0U)
+        {
+          /* Stop looping. */
+          break;
+        }
+      }
     }
-    /* All is good for further processing. */
-    else
+    /* All is good for further processing? */
+    if (exceptionCode == 0U)
     {
-      /* Store byte count in the response and prepare the data length. */
-      txPacket->pdu.data[0] = 2U * numRegs;
-      txPacket->dataLen = txPacket->pdu.data[0] + 1U;
-      /* Loop through all the registers. */
-      for (uint8_t idx = 0U; idx < numRegs; idx++)
+      uint16_t values[122U];
+      uint16_t offset = 1U;
+      /* Process the sub-requests one at a time. */
+      while (offset <= byteCnt)
       {
-        uint16_t           regValue = 0U;
+        uint8_t const * subReq = &rxPacket->pdu.data[offset];
         tTbxMbServerResult srvResult;
-        /* Obtain register value. */
-        srvResult = context->readHoldingRegFcn(context, startAddr + idx, &regValue);
-        /* No exception reported? */
-        if (srvResult == TBX_MB_SERVER_OK)
+        /* Read out the sub-request parameters. The cast to U8 is okay, because the
+         * byte count already limits num to <= 122.
+         */
+        uint16_t file   = TbxMbCommonExtractUInt16BE(&subReq[1]);
+        uint16_t record = TbxMbCommonExtractUInt16BE(&subReq[3]);
+        uint8_t  num    = (uint8_t)TbxMbCommonExtractUInt16BE(&subReq[5]);
+        /* Extract the record values. */
+        for (uint8_t idx = 0U; idx < num; idx++)
         {
-          /* Store the register value in the response. */
-          TbxMbCommonStoreUInt16BE(regValue, &txPacket->pdu.data[1U + (idx * 2U)]);
+          values[idx] = TbxMbCommonExtractUInt16BE(&subReq[7U + (idx * 2U)]);
         }
-        /* Exception detected. */
-        else
+        /* Write the record values. */
+        srvResult = context->writeFileRecordFcn(context, file, record, num, values);
+        /* Exception reported? */
+        if (srvResult != TBX_MB_SERVER_OK)
         {
-          /* Prepare exception response. */
-          txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
           if (srvResult == TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR)
           {
-            txPacket->pdu.data[0] = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
+            exceptionCode = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
           }
           else
           {
-            txPacket->pdu.data[0] = TBX_MB_EC04_SERVER_DEVICE_FAILURE;
+            exceptionCode = TBX_MB_EC04_SERVER_DEVICE_FAILURE;
           }
-          txPacket->dataLen = 1U;
           /* Stop looping. */
           break;
         }
+        /* Continue with the next sub-request. */
+        offset += 7U + (num * 2U);
+      }
+    }
+    /* Exception detected? */
+    if (exceptionCode != 0U)
+    {
+      /* Prepare exception response. */
+      TbxMbServerException(txPacket, exceptionCode);
+    }
+    else
+    {
+      /* The response is an echo of the request. */
+      for (uint8_t idx = 0U; idx < rxPacket->dataLen; idx++)
+      {
+        txPacket->pdu.data[idx] = rxPacket->pdu.data[idx];
       }
+      txPacket->dataLen = rxPacket->dataLen;
     }
   }
-} /*** end of TbxMbServerFC03ReadHoldingRegs ***/
+} /*** end of TbxMbServerFC21WriteFileRecord ***/
+#endif
+
+
+#if (TBX_MB_SERVER_FC43_ENABLE > 0U)
+/************************************************************************************//**
+** \brief     Handles a newly received PDU for function code 43 - Encapsulated Interface
+**            Transport, with MEI type 14 - Read Device Identification. The objects are
+**            streamed directly from the callback function into the response. If not all
+**            objects fit, the response reports "more follows", such that the client
+**            continues with the next object in its next request. Requests that it
+**            doesn't handle, are passed on to the custom function code callback.
+** \details   Note that this function is called at a time that txPacket->code is already
+**            prepared. Also note that txPacket->node should not be touched here.
+** \param     context Pointer to the Modbus server channel context.
+** \param     rxPacket Received PDU packet with MUX access.
+** \param     txPacket Storage for the PDU response packet with MUX access.
+**
+****************************************************************************************/
+static void TbxMbServerFC43ReadDeviceId(tTbxMbServerCtx       * context,
+                                        tTbxMbTpPacket  const * rxPacket,
+                                        tTbxMbTpPacket        * txPacket)
+{
+  uint8_t handled = TBX_FALSE;
+
+  /* Verify parameters. */
+  TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
+  {
+    /* Set pointer to where the objects start in the response. */
+    uint8_t * objPtr = &txPacket->pdu.data[6];
+
+    /* Only handle read device identification, if a callback function was registered
+     * that provides at least the mandatory vendor name object. Checking just the
+     * availability of an object is done with a zero maximum length.
+     */
+    if ((rxPacket->pdu.data[0] == TBX_MB_MEI_READ_DEVICE_ID) &&
+        (context->readDeviceIdFcn != NULL) &&
+        (context->readDeviceIdFcn(context, TBX_MB_DEVID_OBJ_VENDOR_NAME,
+                                  objPtr, 0U) > 0U))
+    {
+      /* Read out request packet parameters. */
+      uint8_t readDevIdCode = rxPacket->pdu.data[1];
+      uint8_t objectId      = rxPacket->pdu.data[2];
+
+      /* Update the flag. */
+      handled = TBX_TRUE;
+      /* Check if the request is invalid. */
+      if ((readDevIdCode < TBX_MB_DEVID_CODE_BASIC) ||
+          (readDevIdCode > TBX_MB_DEVID_CODE_INDIVIDUAL) || (rxPacket->dataLen != 3U))
+      {
+        /* Prepare exception response. */
+        TbxMbServerException(txPacket, TBX_MB_EC03_ILLEGAL_DATA_VALUE);
+      }
+      /* Check if the requested individual object is not available. */
+      else if ((readDevIdCode == TBX_MB_DEVID_CODE_INDIVIDUAL) &&
+               (context->readDeviceIdFcn(context, objectId, objPtr, 0U) == 0U))
+      {
+        /* Prepare exception response. */
+        TbxMbServerException(txPacket, TBX_MB_EC02_ILLEGAL_DATA_ADDRESS);
+      }
+      /* All is good for further processing. */
+      else
+      {
+        /* Last object of the requested category, for stream access. */
+        uint8_t lastId      = 0xFFU;
+        uint8_t conformity  = 0x81U;
+        uint8_t moreFollows = 0x00U;
+        uint8_t nextId      = 0x00U;
+        uint8_t numObjects  = 0U;
+        /* Space left for the objects in the response. */
+        uint8_t space       = TBX_MB_TP_PDU_DATA_LEN_MAX - 6U;
+
+        /* Determine the conformity level, with support for individual access. It
+         * depends on the availability of the first regular and extended objects.
+         */
+        if (context->readDeviceIdFcn(context, TBX_MB_DEVID_OBJ_EXTENDED_FIRST,
+                                     objPtr, 0U) > 0U)
+        {
+          conformity = 0x83U;
+        }
+        else if (context->readDeviceIdFcn(context, TBX_MB_DEVID_OBJ_VENDOR_URL,
+                                          objPtr, 0U) > 0U)
+        {
+          conformity = 0x82U;
+        }
+        else
+        {
+          /* Basic conformity level. Already set. */
+        }
+        /* Determine the last object of the requested category. */
+        if (readDevIdCode == TBX_MB_DEVID_CODE_BASIC)
+        {
+          lastId = TBX_MB_DEVID_OBJ_REVISION;
+        }
+        else if (readDevIdCode == TBX_MB_DEVID_CODE_REGULAR)
+        {
+          lastId = TBX_MB_DEVID_OBJ_EXTENDED_FIRST - 1U;
+        }
+        else if (readDevIdCode == TBX_MB_DEVID_CODE_INDIVIDUAL)
+        {
+          lastId = objectId;
+        }
+        else
+        {
+          /* Extended stream access. Already set. */
+        }
+        /* As specified by the protocol, a stream access restarts with the first
+         * object, if the requested object is not available.
+         */
+        if ((objectId > lastId) ||
+            (context->readDeviceIdFcn(context, objectId, objPtr, 0U) == 0U))
+        {
+          objectId = TBX_MB_DEVID_OBJ_VENDOR_NAME;
+        }
+        /* Loop through the objects of the requested category. A U16 loop index is
+         * used, such that the loop also terminates for object 0xFF.
+         */
+        for (uint16_t id = objectId; id <= lastId; id++)
+        {
+          /* Each object starts with its identifier and length. */
+          uint8_t maxLen = (space > 2U) ? (space - 2U) : 0U;
+          /* Have the callback write the object's value directly into the response. */
+          uint8_t objLen = context->readDeviceIdFcn(context, (uint8_t)id, &objPtr[2],
+                                                    maxLen);
+          /* Object available? */
+          if (objLen > 0U)
+          {
+            /* Object doesn't fit in the response anymore? */
+            if (objLen > maxLen)
+            {
+              /* Is it the first object in the response? In this case it won't fit in
+               * the next response either. Send it truncated.
+               */
+              if (numObjects == 0U)
+              {
+                objLen = maxLen;
+              }
+              /* Have the client read it with the next request, for stream access. */
+              else
+              {
+                moreFollows = 0xFFU;
+                nextId = (uint8_t)id;
+                /* Stop looping. */
+                break;
+              }
+            }
+            /* Store the object's identifier and length. Its value is already stored. */
+            objPtr[0] = (uint8_t)id;
+            objPtr[1] = objLen;
+            objPtr = &objPtr[2U + objLen];
+            space -= 2U + objLen;
+            numObjects++;
+          }
+        }
+        /* Store the response header and prepare the data length. */
+        txPacket->pdu.data[0] = TBX_MB_MEI_READ_DEVICE_ID;
+        txPacket->pdu.data[1] = readDevIdCode;
+        txPacket->pdu.data[2] = conformity;
+        txPacket->pdu.data[3] = moreFollows;
+        txPacket->pdu.data[4] = nextId;
+        txPacket->pdu.data[5] = numObjects;
+        txPacket->dataLen = TBX_MB_TP_PDU_DATA_LEN_MAX - space;
+      }
+    }
+    /* Leave the other MEI types, and read device identification without a registered
+     * callback, to the custom function code callback.
+     */
+    if (handled == TBX_FALSE)
+    {
+      TbxMbServerCustomFunction(context, rxPacket, txPacket);
+    }
+  }
+} /*** end of TbxMbServerFC43ReadDeviceId ***/
+#endif
 
 
 /************************************************************************************//**
-** \brief     Handles a newly received PDU for function code 4 - Read Input Registers.
+** \brief     Handles a newly received PDU for a function code that the server does not
+**            support by itself. It passes the PDU on to the custom function code
+**            callback, if registered. Otherwise, it responds with an illegal function
+**            exception.
 ** \details   Note that this function is called at a time that txPacket->code is already
 **            prepared. Also note that txPacket->node should not be touched here.
 ** \param     context Pointer to the Modbus server channel context.
@@ -890,9 +3286,9 @@ static void TbxMbServerFC03ReadHoldingRegs(tTbxMbServerCtx       * context,
 ** \param     txPacket Storage for the PDU response packet with MUX access.
 **
 ****************************************************************************************/
-static void TbxMbServerFC04ReadInputRegs(tTbxMbServerCtx       * context,
-                                        tTbxMbTpPacket  const * rxPacket,
-                                        tTbxMbTpPacket        * txPacket)
+static void TbxMbServerCustomFunction(tTbxMbServerCtx       * context,
+                                      tTbxMbTpPacket  const * rxPacket,
+                                      tTbxMbTpPacket        * txPacket)
 {
   /* Verify parameters. */
   TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
@@ -900,577 +3296,818 @@ static void TbxMbServerFC04ReadInputRegs(tTbxMbServerCtx       * context,
   /* Only continue with valid parameters. */
   if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
   {
-    /* Read out request packet parameters. */
-    uint16_t startAddr = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
-    uint16_t numRegs   = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
+    uint8_t handled = TBX_FALSE;
 
-    /* Check if a callback function was registered. */
-    if (context->readInputRegFcn == NULL)
-    {
-      /* Prepare exception response. */
-      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-      txPacket->pdu.data[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
-      txPacket->dataLen = 1U;
-    }
-    /* Check if the quantity of registers is invalid. */
-    else if ((numRegs < 1U) || (numRegs > 125U))
-    {
-      /* Prepare exception response. */
-      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-      txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
-      txPacket->dataLen = 1U;
-    }
-    /* All is good for further processing. */
-    else
+    /* Is a custom function code callback configured? */
+    if (context->customFunctionFcn != NULL)
     {
-      /* Store byte count in the response and prepare the data length. */
-      txPacket->pdu.data[0] = 2U * numRegs;
-      txPacket->dataLen = txPacket->pdu.data[0] + 1U;
-      /* Loop through all the registers. */
-      for (uint8_t idx = 0U; idx < numRegs; idx++)
+      /* Prepare callback parameters. */
+      uint8_t const * rxPdu  = &rxPacket->pdu.code;
+      uint8_t       * txPdu  = &txPacket->pdu.code;
+      uint8_t         pduLen = rxPacket->dataLen + 1U;
+      /* A compact transport layer shares one packet buffer for the request and the
+       * response. The callback might build the response while still reading the
+       * request, so pass it a copy of the request in this case.
+       */
+      tTbxMbTpPdu     rxPduCopy;
+      if (rxPacket == txPacket)
       {
-        uint16_t           regValue = 0U;
-        tTbxMbServerResult srvResult;
-        /* Obtain register value. */
-        srvResult = context->readInputRegFcn(context, startAddr + idx, &regValue);
-        /* No exception reported? */
-        if (srvResult == TBX_MB_SERVER_OK)
-        {
-          /* Store the register value in the response. */
-          TbxMbCommonStoreUInt16BE(regValue, &txPacket->pdu.data[1U + (idx * 2U)]);
-        }
-        /* Exception detected. */
-        else
-        {
-          /* Prepare exception response. */
-          txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-          if (srvResult == TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR)
-          {
-            txPacket->pdu.data[0] = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
-          }
-          else
-          {
-            txPacket->pdu.data[0] = TBX_MB_EC04_SERVER_DEVICE_FAILURE;
-          }
-          txPacket->dataLen = 1U;
-          /* Stop looping. */
-          break;
-        }
+        rxPduCopy = rxPacket->pdu;
+        rxPdu = &rxPduCopy.code;
+      }
+      /* Call the custom function code callback. */
+      handled = context->customFunctionFcn(context, rxPdu, txPdu, &pduLen);
+      /* Did the callback process the PDU and prepare a response? */
+      if (handled == TBX_TRUE)
+      {
+        /* Set the response data length. */
+        txPacket->dataLen = pduLen - 1U;
       }
     }
+    /* Did the custom function code callback not handle the PDU? */
+    if (handled == TBX_FALSE)
+    {
+      /* This function code is currently not supported. */
+      TbxMbServerException(txPacket, TBX_MB_EC01_ILLEGAL_FUNCTION);
+    }
   }
-} /*** end of TbxMbServerFC04ReadInputRegs ***/
+} /*** end of TbxMbServerCustomFunction ***/
 
 
 /************************************************************************************//**
-** \brief     Handles a newly received PDU for function code 5 - Write Single Coil.
+** \brief     Prepares an exception response to the request.
 ** \details   Note that this function is called at a time that txPacket->code is already
 **            prepared. Also note that txPacket->node should not be touched here.
-** \param     context Pointer to the Modbus server channel context.
-** \param     rxPacket Received PDU packet with MUX access.
 ** \param     txPacket Storage for the PDU response packet with MUX access.
+** \param     exceptionCode Exception code (TBX_MB_ECxx_xxx) to respond with.
 **
 ****************************************************************************************/
-static void TbxMbServerFC05WriteSingleCoil(tTbxMbServerCtx       * context,
-                                           tTbxMbTpPacket  const * rxPacket,
-                                           tTbxMbTpPacket        * txPacket)
+static void TbxMbServerException(tTbxMbTpPacket * txPacket,
+                                 uint8_t          exceptionCode)
+{
+  txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
+  txPacket->pdu.data[0] = exceptionCode;
+  txPacket->dataLen = 1U;
+} /*** end of TbxMbServerException ***/
+
+
+#if ((TBX_MB_SERVER_FC01_ENABLE > 0U) || (TBX_MB_SERVER_FC02_ENABLE > 0U) || \
+     (TBX_MB_SERVER_FC03_ENABLE > 0U) || (TBX_MB_SERVER_FC04_ENABLE > 0U) || \
+     (TBX_MB_SERVER_FC05_ENABLE > 0U) || (TBX_MB_SERVER_FC06_ENABLE > 0U) || \
+     (TBX_MB_SERVER_FC15_ENABLE > 0U) || (TBX_MB_SERVER_FC16_ENABLE > 0U) || \
+     (TBX_MB_SERVER_FC22_ENABLE > 0U) || (TBX_MB_SERVER_FC23_ENABLE > 0U))
+/************************************************************************************//**
+** \brief     Prepares an exception response to the request, for the exception that an
+**            application callback function reported.
+** \details   Note that this function is called at a time that txPacket->code is already
+**            prepared. Also note that txPacket->node should not be touched here.
+** \param     txPacket Storage for the PDU response packet with MUX access.
+** \param     srvResult Result that the application callback function reported.
+**
+****************************************************************************************/
+static void TbxMbServerResultException(tTbxMbTpPacket     * txPacket,
+                                       tTbxMbServerResult   srvResult)
+{
+  if (srvResult == TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR)
+  {
+    TbxMbServerException(txPacket, TBX_MB_EC02_ILLEGAL_DATA_ADDRESS);
+  }
+  else
+  {
+    TbxMbServerException(txPacket, TBX_MB_EC04_SERVER_DEVICE_FAILURE);
+  }
+} /*** end of TbxMbServerResultException ***/
+#endif
+
+
+#if ((TBX_MB_SERVER_FC20_ENABLE > 0U) || (TBX_MB_SERVER_FC21_ENABLE > 0U))
+/************************************************************************************//**
+** \brief     Validates a sub-request of a read or write file record request.
+** \param     subReq Pointer to the sub-request, starting with its reference type.
+** \return    0 if the sub-request is valid, the exception code to respond with
+**            otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbServerFileSubReqCheck(uint8_t const * subReq)
 {
+  uint8_t result = TBX_MB_EC04_SERVER_DEVICE_FAILURE;
+
   /* Verify parameters. */
-  TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
+  TBX_ASSERT(subReq != NULL);
 
   /* Only continue with valid parameters. */
-  if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
+  if (subReq != NULL)
   {
-    /* Read out request packet parameters. */
-    uint16_t startAddr   = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
-    uint16_t outputValue = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
+    /* Read out the sub-request parameters. */
+    uint16_t file   = TbxMbCommonExtractUInt16BE(&subReq[1]);
+    uint16_t record = TbxMbCommonExtractUInt16BE(&subReq[3]);
+    uint16_t num    = TbxMbCommonExtractUInt16BE(&subReq[5]);
 
-    /* Check if a callback function was registered. */
-    if (context->writeCoilFcn == NULL)
+    /* Check the reference type and the file number. Also check that all records are
+     * in the range 0..9999, as specified by the protocol. Using U32 to prevent
+     * overflow issues.
+     */
+    if ((subReq[0] != TBX_MB_FILE_REF_TYPE) || (file == 0U) ||
+        (((uint32_t)record + num) > 10000U))
     {
-      /* Prepare exception response. */
-      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-      txPacket->pdu.data[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
-      txPacket->dataLen = 1U;
+      result = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
     }
-    /* Check if the output value is invalid. */
-    else if ((outputValue != 0x0000U) && (outputValue != 0xFF00U))
+    /* Check the number of records. */
+    else if (num == 0U)
     {
-      /* Prepare exception response. */
-      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-      txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
-      txPacket->dataLen = 1U;
+      result = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
     }
-    /* All is good for further processing. */
+    /* Sub-request is valid. */
     else
     {
-      /* Prepare the response and its data length. It's the same as the request. */
-      txPacket->pdu.data[0U] = rxPacket->pdu.data[0U];
-      txPacket->pdu.data[1U] = rxPacket->pdu.data[1U];
-      txPacket->pdu.data[2U] = rxPacket->pdu.data[2U];
-      txPacket->pdu.data[3U] = rxPacket->pdu.data[3U];
-      txPacket->dataLen = 4U;
-      /* Write the coil value. */
-      tTbxMbServerResult srvResult;
-      uint8_t            coilValue = (outputValue == 0x0000U) ? TBX_OFF : TBX_ON;
-      srvResult = context->writeCoilFcn(context, startAddr, coilValue);
-      /* Exception reported? */
-      if (srvResult != TBX_MB_SERVER_OK)
-      {
-        /* Prepare exception response. */
-        txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-        if (srvResult == TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR)
-        {
-          txPacket->pdu.data[0] = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
-        }
-        else
-        {
-          txPacket->pdu.data[0] = TBX_MB_EC04_SERVER_DEVICE_FAILURE;
-        }
-        txPacket->dataLen = 1U;
-      }
+      result = 0U;
     }
   }
-} /*** end of TbxMbServerFC05WriteSingleCoil ***/
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerFileSubReqCheck ***/
+#endif
 
 
+#if ((TBX_MB_SERVER_FC22_ENABLE > 0U) || (TBX_MB_SERVER_FC23_ENABLE > 0U))
 /************************************************************************************//**
-** \brief     Handles a newly received PDU for function code 6 - Write Single Register.
-** \details   Note that this function is called at a time that txPacket->code is already
-**            prepared. Also note that txPacket->node should not be touched here.
+** \brief     Reads a range of holding registers and stores their values in the big
+**            endian format of a Modbus packet. It reads from the attached data table,
+**            if it covers all the registers. Otherwise it calls the callback for reading
+**            a range of holding registers or, as a fall back, the one for reading a
+**            single holding register.
 ** \param     context Pointer to the Modbus server channel context.
-** \param     rxPacket Received PDU packet with MUX access.
-** \param     txPacket Storage for the PDU response packet with MUX access.
+** \param     addr Address of the first holding register.
+** \param     num Number of holding registers to read (1..125).
+** \param     data Byte array where the register values are stored.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+**            or more registers are not available, TBX_MB_SERVER_ERR_DEVICE_FAILURE
+**            otherwise.
 **
 ****************************************************************************************/
-static void TbxMbServerFC06WriteSingleReg(tTbxMbServerCtx       * context,
-                                          tTbxMbTpPacket  const * rxPacket,
-                                          tTbxMbTpPacket        * txPacket)
+static tTbxMbServerResult TbxMbServerHoldingRegsRead(tTbxMbServerCtx * context,
+                                                     uint16_t          addr,
+                                                     uint8_t           num,
+                                                     uint8_t         * data)
 {
+  tTbxMbServerResult result = TBX_MB_SERVER_ERR_DEVICE_FAILURE;
+
   /* Verify parameters. */
-  TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
+  TBX_ASSERT((context != NULL) && (num >= 1U) && (num <= 125U) && (data != NULL));
 
   /* Only continue with valid parameters. */
-  if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
+  if ((context != NULL) && (num >= 1U) && (num <= 125U) && (data != NULL))
   {
-    /* Read out request packet parameters. */
-    uint16_t regAddr  = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
-    uint16_t regValue = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
-
-    /* Check if a callback function was registered. */
-    if (context->writeHoldingRegFcn == NULL)
+    /* Are all the requested registers located in the attached data table? */
+    if (TbxMbServerTableCovers(context->holdingRegTable.baseAddr,
+                               context->holdingRegTable.numElements, addr,
+                               num) == TBX_TRUE)
     {
-      /* Prepare exception response. */
-      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-      txPacket->pdu.data[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
-      txPacket->dataLen = 1U;
+      /* Copy the register values directly from the data table. */
+      uint16_t const * regValues = &context->holdingRegTable.data[addr -
+                                                    context->holdingRegTable.baseAddr];
+      for (uint8_t idx = 0U; idx < num; idx++)
+      {
+        TbxMbCommonStoreUInt16BE(regValues[idx], &data[idx * 2U]);
+      }
+      result = TBX_MB_SERVER_OK;
     }
-    /* All is good for further processing. */
-    else
+    /* Is the callback for reading a range of holding registers registered? */
+    else if (context->readHoldingRegsFcn != NULL)
     {
-      /* Prepare the response and its data length. It's the same as the request. */
-      txPacket->pdu.data[0U] = rxPacket->pdu.data[0U];
-      txPacket->pdu.data[1U] = rxPacket->pdu.data[1U];
-      txPacket->pdu.data[2U] = rxPacket->pdu.data[2U];
-      txPacket->pdu.data[3U] = rxPacket->pdu.data[3U];
-      txPacket->dataLen = 4U;
-      /* Write the register value. */
-      tTbxMbServerResult srvResult;
-      srvResult = context->writeHoldingRegFcn(context, regAddr, regValue);
-      /* Exception reported? */
-      if (srvResult != TBX_MB_SERVER_OK)
+      uint16_t regValues[125U];
+      /* Obtain all the register values with a single call. */
+      result = context->readHoldingRegsFcn(context, addr, num, regValues);
+      /* No exception reported? */
+      if (result == TBX_MB_SERVER_OK)
       {
-        /* Prepare exception response. */
-        txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-        if (srvResult == TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR)
+        /* Store the register values. */
+        for (uint8_t idx = 0U; idx < num; idx++)
         {
-          txPacket->pdu.data[0] = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
+          TbxMbCommonStoreUInt16BE(regValues[idx], &data[idx * 2U]);
         }
-        else
+      }
+    }
+    /* Fall back to reading the registers one at a time. */
+    else if (context->readHoldingRegFcn != NULL)
+    {
+      /* Loop through all the registers. */
+      for (uint8_t idx = 0U; idx < num; idx++)
+      {
+        uint16_t regValue = 0U;
+        /* Obtain register value. */
+        result = context->readHoldingRegFcn(context, addr + idx, &regValue);
+        /* Exception reported? */
+        if (result != TBX_MB_SERVER_OK)
         {
-          txPacket->pdu.data[0] = TBX_MB_EC04_SERVER_DEVICE_FAILURE;
+          /* Stop looping. */
+          break;
         }
-        txPacket->dataLen = 1U;
+        /* Store the register value. */
+        TbxMbCommonStoreUInt16BE(regValue, &data[idx * 2U]);
       }
     }
+    /* Requested registers are not available. */
+    else
+    {
+      result = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+    }
   }
-} /*** end of TbxMbServerFC06WriteSingleReg ***/
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerHoldingRegsRead ***/
 
 
 /************************************************************************************//**
-** \brief     Handles a newly received PDU for function code 8 - Diagnostics.
-** \details   Note that this function is called at a time that txPacket->code is already
-**            prepared. Also note that txPacket->node should not be touched here.
+** \brief     Writes a range of holding registers with values, stored in the big endian
+**            format of a Modbus packet. It writes to the attached data table, if it
+**            covers all the registers. Otherwise it calls the callback for writing a
+**            range of holding registers or, as a fall back, the one for writing a single
+**            holding register.
 ** \param     context Pointer to the Modbus server channel context.
-** \param     rxPacket Received PDU packet with MUX access.
-** \param     txPacket Storage for the PDU response packet with MUX access.
+** \param     addr Address of the first holding register.
+** \param     num Number of holding registers to write (1..123).
+** \param     data Byte array with the register values.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+**            or more registers are not available, TBX_MB_SERVER_ERR_DEVICE_FAILURE
+**            otherwise.
 **
 ****************************************************************************************/
-static void TbxMbServerFC08Diagnostics(tTbxMbServerCtx       * context,
-                                       tTbxMbTpPacket  const * rxPacket,
-                                       tTbxMbTpPacket        * txPacket)
+static tTbxMbServerResult TbxMbServerHoldingRegsWrite(tTbxMbServerCtx       * context,
+                                                      uint16_t                addr,
+                                                      uint8_t                 num,
+                                                      uint8_t         const * data)
 {
+  tTbxMbServerResult result = TBX_MB_SERVER_ERR_DEVICE_FAILURE;
+
   /* Verify parameters. */
-  TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
+  TBX_ASSERT((context != NULL) && (num >= 1U) && (num <= 123U) && (data != NULL));
 
   /* Only continue with valid parameters. */
-  if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
+  if ((context != NULL) && (num >= 1U) && (num <= 123U) && (data != NULL))
   {
-    /* Read out request packet parameters. */
-    uint16_t subCode   = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
-    uint16_t dataField = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
-    /* Prepare the most common response. It's typically the sub-function code echoed,
-     * together with a 16-bit unsigned value.
-     */
-    txPacket->pdu.data[0U] = rxPacket->pdu.data[0U];
-    txPacket->pdu.data[1U] = rxPacket->pdu.data[1U];
-    txPacket->dataLen = 4U;
-
-    /* Filter on the received sub-function code. */
-    switch (subCode)
+    /* Are all the requested registers located in the attached data table? */
+    if (TbxMbServerTableCovers(context->holdingRegTable.baseAddr,
+                               context->holdingRegTable.numElements, addr,
+                               num) == TBX_TRUE)
     {
-      case TBX_MB_DIAG_SC_QUERY_DATA:
-      {
-        /* Echo the received data back. */
-        for (uint8_t idx = 0U; idx < rxPacket->dataLen; idx++)
-        {
-         txPacket->pdu.data[idx] = rxPacket->pdu.data[idx];
-        }
-        txPacket->dataLen = rxPacket->dataLen;
-      }
-      break;
-
-      case TBX_MB_DIAG_SC_CLEAR_COUNTERS:
-      {
-        /* Data field not valid? */
-        if (dataField != 0x0000U)
-        {
-          /* Prepare exception response. */
-          txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-          txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
-          txPacket->dataLen = 1U;
-        }
-        /* All is good for further processing. */        
-        else
-        {
-          /* Clear the diagnostic counters. */
-          context->tpCtx->diagInfo.busMsgCnt     = 0U;
-          context->tpCtx->diagInfo.busCommErrCnt = 0U;
-          context->tpCtx->diagInfo.busExcpErrCnt = 0U;
-          context->tpCtx->diagInfo.srvMsgCnt     = 0U;
-          context->tpCtx->diagInfo.srvNoRespCnt  = 0U;
-          /* Echo the request data field. */
-          TbxMbCommonStoreUInt16BE(dataField, &txPacket->pdu.data[2U]);
-        }
-      }
-      break;
-
-      case TBX_MB_DIAG_SC_BUS_MESSAGE_COUNT:
-      {
-        /* Data field not valid? */
-        if (dataField != 0x0000U)
-        {
-          /* Prepare exception response. */
-          txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-          txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
-          txPacket->dataLen = 1U;
-        }
-        /* All is good for further processing. */        
-        else
-        {
-          /* Store he bus message count. */
-          TbxMbCommonStoreUInt16BE(context->tpCtx->diagInfo.busMsgCnt, 
-                                   &txPacket->pdu.data[2U]);
-        }
-      }
-      break;
-
-      case TBX_MB_DIAG_SC_BUS_COMM_ERROR_COUNT:
+      /* Copy the register values directly to the data table. */
+      uint16_t * regValues = &context->holdingRegTable.data[addr -
+                                                 context->holdingRegTable.baseAddr];
+      for (uint8_t idx = 0U; idx < num; idx++)
       {
-        /* Data field not valid? */
-        if (dataField != 0x0000U)
-        {
-          /* Prepare exception response. */
-          txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-          txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
-          txPacket->dataLen = 1U;
-        }
-        /* All is good for further processing. */        
-        else
-        {
-          /* Store he bus message count. */
-          TbxMbCommonStoreUInt16BE(context->tpCtx->diagInfo.busCommErrCnt, 
-                                   &txPacket->pdu.data[2U]);
-        }
+        regValues[idx] = TbxMbCommonExtractUInt16BE(&data[idx * 2U]);
       }
-      break;
-
-      case TBX_MB_DIAG_SC_BUS_EXCEPTION_ERROR_COUNT:
+      /* Register the changes for the flush callback. */
+      TbxMbServerShadowMark(context, addr, num);
+      result = TBX_MB_SERVER_OK;
+    }
+    /* Is the callback for writing a range of holding registers registered? */
+    else if (context->writeHoldingRegsFcn != NULL)
+    {
+      uint16_t regValues[123U];
+      /* Extract the register values. */
+      for (uint8_t idx = 0U; idx < num; idx++)
       {
-        /* Data field not valid? */
-        if (dataField != 0x0000U)
-        {
-          /* Prepare exception response. */
-          txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-          txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
-          txPacket->dataLen = 1U;
-        }
-        /* All is good for further processing. */        
-        else
-        {
-          /* Store he bus message count. */
-          TbxMbCommonStoreUInt16BE(context->tpCtx->diagInfo.busExcpErrCnt, 
-                                   &txPacket->pdu.data[2U]);
-        }
+        regValues[idx] = TbxMbCommonExtractUInt16BE(&data[idx * 2U]);
       }
-      break;
-
-      case TBX_MB_DIAG_SC_SERVER_MESSAGE_COUNT:
+      /* Write all the register values with a single call. */
+      result = context->writeHoldingRegsFcn(context, addr, num, regValues);
+    }
+    /* Fall back to writing the registers one at a time. */
+    else if (context->writeHoldingRegFcn != NULL)
+    {
+      /* Loop through all the registers. */
+      for (uint8_t idx = 0U; idx < num; idx++)
       {
-        /* Data field not valid? */
-        if (dataField != 0x0000U)
-        {
-          /* Prepare exception response. */
-          txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-          txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
-          txPacket->dataLen = 1U;
-        }
-        /* All is good for further processing. */        
-        else
+        /* Write the register value. */
+        uint16_t regValue = TbxMbCommonExtractUInt16BE(&data[idx * 2U]);
+        result = context->writeHoldingRegFcn(context, addr + idx, regValue);
+        /* Exception reported? */
+        if (result != TBX_MB_SERVER_OK)
         {
-          /* Store he bus message count. */
-          TbxMbCommonStoreUInt16BE(context->tpCtx->diagInfo.srvMsgCnt, 
-                                   &txPacket->pdu.data[2U]);
+          /* Stop looping. */
+          break;
         }
       }
-      break;
+    }
+    /* Requested registers are not available. */
+    else
+    {
+      result = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerHoldingRegsWrite ***/
+#endif
 
-      case TBX_MB_DIAG_SC_SERVER_NO_RESPONSE_COUNT:
+
+#if ((TBX_MB_SERVER_FC01_ENABLE > 0U) || (TBX_MB_SERVER_FC02_ENABLE > 0U) || \
+     (TBX_MB_SERVER_FC03_ENABLE > 0U) || (TBX_MB_SERVER_FC04_ENABLE > 0U) || \
+     (TBX_MB_SERVER_FC05_ENABLE > 0U) || (TBX_MB_SERVER_FC06_ENABLE > 0U) || \
+     (TBX_MB_SERVER_FC15_ENABLE > 0U) || (TBX_MB_SERVER_FC16_ENABLE > 0U) || \
+     (TBX_MB_SERVER_FC22_ENABLE > 0U) || (TBX_MB_SERVER_FC23_ENABLE > 0U))
+/************************************************************************************//**
+** \brief     Determines if a range of data elements is completely located inside a data
+**            table.
+** \param     tableAddr Address of the first element in the data table.
+** \param     tableLen Number of elements in the data table. Zero if no data table is
+**            attached.
+** \param     addr Address of the first requested data element.
+** \param     num Number of requested data elements.
+** \return    TBX_TRUE if all the requested data elements are located in the data table,
+**            TBX_FALSE otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbServerTableCovers(uint16_t tableAddr,
+                                      uint16_t tableLen,
+                                      uint16_t addr,
+                                      uint16_t num)
+{
+  uint8_t result = TBX_FALSE;
+
+  /* Perform the range check. Using U32 to prevent overflow issues. */
+  if ( (tableLen > 0U) && (addr >= tableAddr) &&
+       (((uint32_t)addr + num) <= ((uint32_t)tableAddr + tableLen)) )
+  {
+    /* Update the result. */
+    result = TBX_TRUE;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerTableCovers ***/
+#endif
+
+
+#if ((TBX_MB_SERVER_FC01_ENABLE > 0U) || (TBX_MB_SERVER_FC02_ENABLE > 0U))
+/************************************************************************************//**
+** \brief     Copies a range of packed bits from a data table to a byte array, such that
+**            the first bit ends up in bit 0 of bits[0]. This is the packed bits format
+**            that the Modbus protocol uses. Unused bits in the last byte are cleared.
+** \param     table Byte array with the packed bits of the data table.
+** \param     bitOffset Offset of the first bit to copy, relative to the start of the
+**            data table.
+** \param     num Number of bits to copy.
+** \param     bits Byte array to copy the bits to.
+**
+****************************************************************************************/
+static void TbxMbServerBitsRead(uint8_t  const * table,
+                                uint16_t         bitOffset,
+                                uint16_t         num,
+                                uint8_t        * bits)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((table != NULL) && (num > 0U) && (bits != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((table != NULL) && (num > 0U) && (bits != NULL))
+  {
+    uint16_t         numBytes = (num + 7U) / 8U;
+    uint8_t          shift    = (uint8_t)(bitOffset % 8U);
+    uint8_t  const * srcPtr   = &table[bitOffset / 8U];
+    /* Index of the last data table byte that holds requested bits. Needed to prevent
+     * reading past the end of the data table.
+     */
+    uint16_t         lastIdx  = (uint16_t)(((uint16_t)shift + num - 1U) / 8U);
+
+    /* Copy the bits one byte at a time. */
+    for (uint16_t idx = 0U; idx < numBytes; idx++)
+    {
+      uint16_t value = (uint16_t)srcPtr[idx] >> shift;
+      /* Get the remaining bits from the next byte, if needed. */
+      if ((shift > 0U) && ((idx + 1U) <= lastIdx))
       {
-        /* Data field not valid? */
-        if (dataField != 0x0000U)
-        {
-          /* Prepare exception response. */
-          txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-          txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
-          txPacket->dataLen = 1U;
-        }
-        /* All is good for further processing. */        
-        else
-        {
-          /* Store he bus message count. */
-          TbxMbCommonStoreUInt16BE(context->tpCtx->diagInfo.srvNoRespCnt, 
-                                   &txPacket->pdu.data[2U]);
-        }
+        value |= (uint16_t)srcPtr[idx + 1U] << (8U - shift);
       }
-      break;
+      bits[idx] = (uint8_t)value;
+    }
+    /* Clear the unused bits in the last byte. */
+    if ((num % 8U) != 0U)
+    {
+      bits[numBytes - 1U] &= (uint8_t)((1U << (num % 8U)) - 1U);
+    }
+  }
+} /*** end of TbxMbServerBitsRead ***/
+#endif
 
-      default:
+
+#if ((TBX_MB_SERVER_FC05_ENABLE > 0U) || (TBX_MB_SERVER_FC15_ENABLE > 0U))
+/************************************************************************************//**
+** \brief     Copies a range of packed bits from a byte array to a data table. The first
+**            bit is located in bit 0 of bits[0]. This is the packed bits format that the
+**            Modbus protocol uses. Bits in the data table outside of the range are not
+**            touched.
+** \param     table Byte array with the packed bits of the data table.
+** \param     bitOffset Offset of the first bit to write, relative to the start of the
+**            data table.
+** \param     num Number of bits to copy.
+** \param     bits Byte array to copy the bits from.
+**
+****************************************************************************************/
+static void TbxMbServerBitsWrite(uint8_t        * table,
+                                 uint16_t         bitOffset,
+                                 uint16_t         num,
+                                 uint8_t  const * bits)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((table != NULL) && (num > 0U) && (bits != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((table != NULL) && (num > 0U) && (bits != NULL))
+  {
+    uint16_t   numBytes = (num + 7U) / 8U;
+    uint8_t    shift    = (uint8_t)(bitOffset % 8U);
+    uint8_t  * dstPtr   = &table[bitOffset / 8U];
+
+    /* Copy the bits one byte at a time. */
+    for (uint16_t idx = 0U; idx < numBytes; idx++)
+    {
+      uint8_t  numBits = 8U;
+      /* Last byte with less than 8 bits to copy? */
+      if ((idx == (numBytes - 1U)) && ((num % 8U) != 0U))
       {
-        /* Unsupported sub-function code. Prepare exception response. */
-        txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-        txPacket->pdu.data[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
-        txPacket->dataLen = 1U;
+        numBits = (uint8_t)(num % 8U);
+      }
+      /* Construct the mask and the bits, aligned to the position in the data table.
+       * Note that these can span two bytes in the data table.
+       */
+      uint16_t mask  = (uint16_t)(((1U << numBits) - 1U) << shift);
+      uint16_t value = (uint16_t)((uint16_t)bits[idx] << shift) & mask;
+      /* Update the bits in the data table. */
+      dstPtr[idx] &= (uint8_t)~(uint8_t)mask;
+      dstPtr[idx] |= (uint8_t)value;
+      /* Do the bits continue in the next byte of the data table? */
+      if ((mask & 0xFF00U) != 0U)
+      {
+        dstPtr[idx + 1U] &= (uint8_t)~(uint8_t)(mask >> 8U);
+        dstPtr[idx + 1U] |= (uint8_t)(value >> 8U);
       }
-      break;
     }
   }
-} /*** end of TbxMbServerFC08Diagnostics ***/
+} /*** end of TbxMbServerBitsWrite ***/
+#endif
 
 
+#if (TBX_MB_SERVER_CACHE_SIZE > 0U)
 /************************************************************************************//**
-** \brief     Handles a newly received PDU for function code 15 - Write Multiple Coils.
-** \details   Note that this function is called at a time that txPacket->code is already
-**            prepared. Also note that txPacket->node should not be touched here.
+** \brief     Helper function to answer a read request with a cached response. This is
+**            possible if an earlier identical request, with the same function code,
+**            start address and number of elements, was processed successfully and the
+**            validity window of its response did not yet pass.
 ** \param     context Pointer to the Modbus server channel context.
-** \param     rxPacket Received PDU packet with MUX access.
+** \param     code Function code of the request.
+** \param     addr Start address of the request.
+** \param     num Number of elements of the request.
 ** \param     txPacket Storage for the PDU response packet with MUX access.
+** \return    TBX_TRUE if the response was copied from the cache, TBX_FALSE otherwise.
 **
 ****************************************************************************************/
-static void TbxMbServerFC15WriteMultipleCoils(tTbxMbServerCtx       * context,
-                                              tTbxMbTpPacket  const * rxPacket,
-                                              tTbxMbTpPacket        * txPacket)
+static uint8_t TbxMbServerCacheLookup(tTbxMbServerCtx       * context,
+                                      uint8_t                 code,
+                                      uint16_t                addr,
+                                      uint16_t                num,
+                                      tTbxMbTpPacket        * txPacket)
 {
-  /* Verify parameters. */
-  TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
+  uint8_t result = TBX_FALSE;
 
-  /* Only continue with valid parameters. */
-  if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
+  /* First discard the responses that are no longer valid. */
+  TbxMbServerCacheAge(context);
+  /* Only continue if responses are cached. */
+  if (context->cacheCount > 0U)
   {
-    /* Read out request packet parameters. */
-    uint16_t startAddr = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
-    uint16_t numCoils  = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
-    uint8_t  byteCnt   = rxPacket->pdu.data[4];
-    /* Determine the number of bytes needed to hold all the coil bits. Make it U16 
-     * because the range validity of numCoils is not yet checked.
-     */
-    uint16_t numBytes = (uint16_t)(numCoils / 8U);
-    if ((numCoils % 8U) != 0U)
+    /* Loop through the cache entries, in search of a matching response. */
+    for (uint8_t idx = 0U; idx < TBX_MB_SERVER_CACHE_SIZE; idx++)
     {
-      numBytes++;
+      tTbxMbServerCacheEntry const * entry = &context->cache[idx];
+      /* Does this cache entry hold the response to an identical request? */
+      if ((entry->dataLen > 0U) && (entry->code == code) &&
+          (entry->addr == addr) && (entry->num == num))
+      {
+        /* Copy the cached response. */
+        for (uint8_t byteIdx = 0U; byteIdx < entry->dataLen; byteIdx++)
+        {
+          txPacket->pdu.data[byteIdx] = entry->data[byteIdx];
+        }
+        txPacket->dataLen = entry->dataLen;
+        /* Update the result and stop looping. */
+        result = TBX_TRUE;
+        break;
+      }
     }
-    /* Check if a callback function was registered. */
-    if (context->writeCoilFcn == NULL)
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerCacheLookup ***/
+
+
+/************************************************************************************//**
+** \brief     Helper function to store the response to a read request in the cache. Only
+**            a successful response is stored. If all cache entries are in use, the one
+**            with the oldest response is reused.
+** \param     context Pointer to the Modbus server channel context.
+** \param     code Function code of the request.
+** \param     addr Start address of the request.
+** \param     num Number of elements of the request.
+** \param     txPacket PDU response packet with MUX access.
+**
+****************************************************************************************/
+static void TbxMbServerCacheStore(tTbxMbServerCtx       * context,
+                                  uint8_t                 code,
+                                  uint16_t                addr,
+                                  uint16_t                num,
+                                  tTbxMbTpPacket  const * txPacket)
+{
+  /* Only store successful responses. An exception response has a different function
+   * code than the request.
+   */
+  if ((txPacket->pdu.code == code) && (txPacket->dataLen > 0U))
+  {
+    tTbxMbServerCacheEntry * entry = &context->cache[0];
+    /* Find a free cache entry or, if there is none, the one with the oldest response. */
+    for (uint8_t idx = 0U; idx < TBX_MB_SERVER_CACHE_SIZE; idx++)
     {
-      /* Prepare exception response. */
-      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-      txPacket->pdu.data[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
-      txPacket->dataLen = 1U;
+      /* Free cache entry? */
+      if (context->cache[idx].dataLen == 0U)
+      {
+        /* Use this one and stop looping. */
+        entry = &context->cache[idx];
+        break;
+      }
+      /* Older response than the one found so far? */
+      if (context->cache[idx].ageMs > entry->ageMs)
+      {
+        entry = &context->cache[idx];
+      }
     }
-    /* Check if the quantity of coils is invalid. */
-    else if (((numCoils < 1U) || (numCoils > 1968U)))
+    /* Update the number of cached responses, if a free cache entry is used. */
+    if (entry->dataLen == 0U)
     {
-      /* Prepare exception response. */
-      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-      txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
-      txPacket->dataLen = 1U;
+      context->cacheCount++;
+      /* First cached response? */
+      if (context->cacheCount == 1U)
+      {
+        /* Start the aging from now on. */
+        context->cacheMsTime = TbxMbPortTimerCount();
+        /* Instruct the event task to start calling our polling function, for aging the
+         * cached responses.
+         */
+        tTbxMbEvent newEvent;
+        newEvent.context = context;
+        newEvent.id = TBX_MB_EVENT_ID_START_POLLING;
+        TbxMbOsalEventPost(&newEvent, TBX_FALSE);
+      }
     }
-    /* Check if the quantity of bytes is invalid. */
-    else if (numBytes != byteCnt)
+    /* Store the response. */
+    entry->code = code;
+    entry->addr = addr;
+    entry->num  = num;
+    entry->ageMs = 0U;
+    for (uint8_t byteIdx = 0U; byteIdx < txPacket->dataLen; byteIdx++)
     {
-      /* Prepare exception response. */
-      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-      txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
-      txPacket->dataLen = 1U;
+      entry->data[byteIdx] = txPacket->pdu.data[byteIdx];
     }
-    /* All is good for further processing. */
-    else
+    entry->dataLen = txPacket->dataLen;
+  }
+} /*** end of TbxMbServerCacheStore ***/
+
+
+/************************************************************************************//**
+** \brief     Helper function to age the cached responses. It discards the responses
+**            whose validity window passed. It also discards all cached responses, in
+**            case the application requested this with TbxMbServerInvalidateCache().
+** \param     context Pointer to the Modbus server channel context.
+**
+****************************************************************************************/
+static void TbxMbServerCacheAge(tTbxMbServerCtx * context)
+{
+  /* Get and reset the invalidate cache request flag. */
+  TbxCriticalSectionEnter();
+  uint8_t invalidate = context->cacheInvalidate;
+  context->cacheInvalidate = TBX_FALSE;
+  TbxCriticalSectionExit();
+  /* Did the application request to discard all cached responses? */
+  if (invalidate == TBX_TRUE)
+  {
+    TbxMbServerCacheClear(context);
+  }
+  /* Only continue if responses are cached. */
+  if (context->cacheCount > 0U)
+  {
+    /* Get the number of ticks that elapsed since the last millisecond detection. Note
+     * that this calculation works, even if the 20 kHz timer counter overflowed.
+     */
+    uint16_t deltaTicks = TbxMbPortTimerCount() - context->cacheMsTime;
+    /* Determine how many milliseconds passed since the last one was detected. */
+    uint16_t deltaMs = deltaTicks / 20U;
+    /* Did one or more milliseconds pass? */
+    if (deltaMs > 0U)
     {
-      /* Prepare the response and its data length. It's mostly the same as the request.*/
-      txPacket->pdu.data[0U] = rxPacket->pdu.data[0U];
-      txPacket->pdu.data[1U] = rxPacket->pdu.data[1U];
-      txPacket->pdu.data[2U] = rxPacket->pdu.data[2U];
-      txPacket->pdu.data[3U] = rxPacket->pdu.data[3U];
-      txPacket->dataLen = 4U;
-      /* Prepare loop indices that aid with writing the coil bits. */
-      uint8_t         bitIdx  = 0U;
-      uint8_t         byteIdx = 0U;
-      /* Initialize byte array pointer for reading the coil bits from the request. */
-      uint8_t const * coilData = &rxPacket->pdu.data[5];
-      /* Loop through all the coils. */
-      for (uint16_t idx = 0U; idx < numCoils; idx++)
-      {
-        uint8_t            coilValue = TBX_OFF;
-        tTbxMbServerResult srvResult;
-        /* Extract the requested coil value. */
-        if ((coilData[byteIdx] & (1U << bitIdx)) != 0U)
-        {
-          coilValue = TBX_ON;
-        }
-        /* Write the coil value. */
-        srvResult = context->writeCoilFcn(context, startAddr + idx, coilValue);
-        /* Exception reported? */
-        if (srvResult != TBX_MB_SERVER_OK)
+      /* Update the last millisecond detection tick time. Needed for the detection of
+       * the next millisecond. Note that this calculation works, even if the
+       * cacheMsTime element overflows.
+       */
+      context->cacheMsTime += (deltaMs * 20U);
+      /* Age the cached responses. */
+      for (uint8_t idx = 0U; idx < TBX_MB_SERVER_CACHE_SIZE; idx++)
+      {
+        tTbxMbServerCacheEntry * entry = &context->cache[idx];
+        /* Only age cache entries that are in use. */
+        if (entry->dataLen > 0U)
         {
-          /* Prepare exception response. */
-          txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-          if (srvResult == TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR)
+          /* Validity window passed? Written such that it cannot overflow. */
+          if (deltaMs >= (TBX_MB_SERVER_CACHE_VALIDITY_MS - entry->ageMs))
           {
-            txPacket->pdu.data[0] = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
+            /* Discard the response. */
+            entry->dataLen = 0U;
+            context->cacheCount--;
           }
           else
           {
-            txPacket->pdu.data[0] = TBX_MB_EC04_SERVER_DEVICE_FAILURE;
+            entry->ageMs += deltaMs;
           }
-          txPacket->dataLen = 1U;
-          /* Stop looping. */
-          break;
-        }
-        /* Update the bit index. */
-        bitIdx++;
-        /* Time to move to the next byte? */
-        if (bitIdx == 8U)
-        {
-          /* Reset the bit index and increment the byte index. */
-          bitIdx = 0U;
-          byteIdx++;
         }
       }
+      /* All cached responses discarded? */
+      if (context->cacheCount == 0U)
+      {
+        /* Instruct the event task to stop calling our polling function. */
+        tTbxMbEvent newEvent;
+        newEvent.context = context;
+        newEvent.id = TBX_MB_EVENT_ID_STOP_POLLING;
+        TbxMbOsalEventPost(&newEvent, TBX_FALSE);
+      }
     }
   }
-} /*** end of TbxMbServerFC15WriteMultipleCoils ***/
+} /*** end of TbxMbServerCacheAge ***/
 
 
 /************************************************************************************//**
-** \brief     Handles a newly received PDU for function code 16 - Write Multiple
-**            Registers.
-** \details   Note that this function is called at a time that txPacket->code is already
-**            prepared. Also note that txPacket->node should not be touched here.
+** \brief     Helper function to discard all cached responses.
 ** \param     context Pointer to the Modbus server channel context.
-** \param     rxPacket Received PDU packet with MUX access.
-** \param     txPacket Storage for the PDU response packet with MUX access.
 **
 ****************************************************************************************/
-static void TbxMbServerFC16WriteMultipleRegs(tTbxMbServerCtx       * context,
-                                             tTbxMbTpPacket  const * rxPacket,
-                                             tTbxMbTpPacket        * txPacket)
+static void TbxMbServerCacheClear(tTbxMbServerCtx * context)
 {
-  /* Verify parameters. */
-  TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
-
-  /* Only continue with valid parameters. */
-  if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
+  /* Only continue if responses are cached. */
+  if (context->cacheCount > 0U)
   {
-    /* Read out request packet parameters. */
-    uint16_t startAddr = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
-    uint16_t numRegs   = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
-    uint8_t  byteCnt   = rxPacket->pdu.data[4];
-
-    /* Check if a callback function was registered. */
-    if (context->writeHoldingRegFcn == NULL)
+    /* Discard all cached responses. */
+    for (uint8_t idx = 0U; idx < TBX_MB_SERVER_CACHE_SIZE; idx++)
     {
-      /* Prepare exception response. */
-      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-      txPacket->pdu.data[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
-      txPacket->dataLen = 1U;
+      context->cache[idx].dataLen = 0U;
     }
-    /* Check if the quantity of registers is invalid. */
-    else if (((numRegs < 1U) || (numRegs > 123U)) || (byteCnt != (numRegs * 2U)))
+    context->cacheCount = 0U;
+    /* Instruct the event task to stop calling our polling function. */
+    tTbxMbEvent newEvent;
+    newEvent.context = context;
+    newEvent.id = TBX_MB_EVENT_ID_STOP_POLLING;
+    TbxMbOsalEventPost(&newEvent, TBX_FALSE);
+  }
+} /*** end of TbxMbServerCacheClear ***/
+#endif
+
+
+#if ((TBX_MB_SERVER_FC06_ENABLE > 0U) || (TBX_MB_SERVER_FC16_ENABLE > 0U) || \
+     (TBX_MB_SERVER_FC22_ENABLE > 0U) || (TBX_MB_SERVER_FC23_ENABLE > 0U))
+/************************************************************************************//**
+** \brief     Helper function to register that a client changed a range of holding
+**            registers in the attached data table. If TBX_MB_SERVER_SHADOW_FLUSH_MS is
+**            0, it calls the flush callback right away. Otherwise it merges the range
+**            with the ones of previous write requests, for flushing them later on.
+** \param     context Pointer to the Modbus server channel context.
+** \param     addr Address of the first changed holding register.
+** \param     num Number of changed holding registers. The range must be located in the
+**            attached data table.
+**
+****************************************************************************************/
+static void TbxMbServerShadowMark(tTbxMbServerCtx * context,
+                                  uint16_t          addr,
+                                  uint16_t          num)
+{
+  /* Only continue if the application wants to be informed about the changes. */
+  if (context->flushHoldingRegsFcn != NULL)
+  {
+#if (TBX_MB_SERVER_SHADOW_FLUSH_MS > 0U)
+    /* Determine the address of the last changed holding register. */
+    uint16_t lastAddr = addr + (num - 1U);
+    /* First change since the last flush? */
+    if (context->shadowDirty == TBX_FALSE)
     {
-      /* Prepare exception response. */
-      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-      txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
-      txPacket->dataLen = 1U;
+      /* Store the range and start the aging from now on. */
+      context->shadowFirst = addr;
+      context->shadowLast = lastAddr;
+      context->shadowAgeMs = 0U;
+      context->shadowMsTime = TbxMbPortTimerCount();
+      context->shadowDirty = TBX_TRUE;
+      /* Instruct the event task to start calling our polling function, for flushing
+       * the changes when it's time.
+       */
+      tTbxMbEvent newEvent;
+      newEvent.context = context;
+      newEvent.id = TBX_MB_EVENT_ID_START_POLLING;
+      TbxMbOsalEventPost(&newEvent, TBX_FALSE);
     }
-    /* All is good for further processing. */
+    /* Merge the range with the one of the previous changes. */
     else
     {
-      /* Prepare the response and its data length. It's mostly the same as the request.*/
-      txPacket->pdu.data[0U] = rxPacket->pdu.data[0U];
-      txPacket->pdu.data[1U] = rxPacket->pdu.data[1U];
-      txPacket->pdu.data[2U] = rxPacket->pdu.data[2U];
-      txPacket->pdu.data[3U] = rxPacket->pdu.data[3U];
-      txPacket->dataLen = 4U;
-      /* Loop through all the registers. */
-      for (uint8_t idx = 0U; idx < numRegs; idx++)
+      if (addr < context->shadowFirst)
       {
-        uint16_t           regValue;
-        tTbxMbServerResult srvResult;
-        /* Extract the requested register value. */
-        regValue = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[5U + (idx * 2U)]);
-        /* Write the register value. */
-        srvResult = context->writeHoldingRegFcn(context, startAddr + idx, regValue);
-        /* Exception reported? */
-        if (srvResult != TBX_MB_SERVER_OK)
-        {
-          /* Prepare exception response. */
-          txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-          if (srvResult == TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR)
-          {
-            txPacket->pdu.data[0] = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
-          }
-          else
-          {
-            txPacket->pdu.data[0] = TBX_MB_EC04_SERVER_DEVICE_FAILURE;
-          }
-          txPacket->dataLen = 1U;
-          /* Stop looping. */
-          break;
-        }
+        context->shadowFirst = addr;
+      }
+      if (lastAddr > context->shadowLast)
+      {
+        context->shadowLast = lastAddr;
       }
     }
+#else
+    /* Flush the changes right away. */
+    context->flushHoldingRegsFcn(context, addr, num,
+                                 &context->holdingRegTable.data[addr -
+                                                    context->holdingRegTable.baseAddr]);
+#endif
   }
-} /*** end of TbxMbServerFC16WriteMultipleRegs ***/
+} /*** end of TbxMbServerShadowMark ***/
+#endif
+
+
+#if (TBX_MB_SERVER_SHADOW_FLUSH_MS > 0U)
+/************************************************************************************//**
+** \brief     Helper function to age the changed holding registers. It flushes them,
+**            once TBX_MB_SERVER_SHADOW_FLUSH_MS milliseconds passed since the first
+**            change.
+** \param     context Pointer to the Modbus server channel context.
+**
+****************************************************************************************/
+static void TbxMbServerShadowAge(tTbxMbServerCtx * context)
+{
+  /* Only continue if there are changes that await their flush. */
+  if (context->shadowDirty == TBX_TRUE)
+  {
+    /* Get the number of ticks that elapsed since the last millisecond detection. Note
+     * that this calculation works, even if the 20 kHz timer counter overflowed.
+     */
+    uint16_t deltaTicks = TbxMbPortTimerCount() - context->shadowMsTime;
+    /* Determine how many milliseconds passed since the last one was detected. */
+    uint16_t deltaMs = deltaTicks / 20U;
+    /* Did one or more milliseconds pass? */
+    if (deltaMs > 0U)
+    {
+      /* Update the last millisecond detection tick time. Needed for the detection of
+       * the next millisecond. Note that this calculation works, even if the
+       * shadowMsTime element overflows.
+       */
+      context->shadowMsTime += (deltaMs * 20U);
+      /* Flush time arrived? Written such that it cannot overflow. */
+      if (deltaMs >= (TBX_MB_SERVER_SHADOW_FLUSH_MS - context->shadowAgeMs))
+      {
+        TbxMbServerShadowFlush(context);
+      }
+      else
+      {
+        context->shadowAgeMs += deltaMs;
+      }
+    }
+  }
+} /*** end of TbxMbServerShadowAge ***/
+
+
+/************************************************************************************//**
+** \brief     Helper function to flush the changed holding registers right away. It
+**            passes the merged range of all changes since the last flush on to the
+**            flush callback.
+** \param     context Pointer to the Modbus server channel context.
+**
+****************************************************************************************/
+static void TbxMbServerShadowFlush(tTbxMbServerCtx * context)
+{
+  /* Only continue if there are changes that await their flush. */
+  if (context->shadowDirty == TBX_TRUE)
+  {
+    uint16_t numRegs = (context->shadowLast - context->shadowFirst) + 1U;
+    /* Reset the changes and instruct the event task to stop calling our polling
+     * function.
+     */
+    context->shadowDirty = TBX_FALSE;
+    tTbxMbEvent newEvent;
+    newEvent.context = context;
+    newEvent.id = TBX_MB_EVENT_ID_STOP_POLLING;
+    TbxMbOsalEventPost(&newEvent, TBX_FALSE);
+    /* Only call the flush callback if the range is still located in the attached data
+     * table. The application could have attached a different one in the meantime.
+     */
+    if ((context->flushHoldingRegsFcn != NULL) &&
+        (TbxMbServerTableCovers(context->holdingRegTable.baseAddr,
+                                context->holdingRegTable.numElements,
+                                context->shadowFirst, numRegs) == TBX_TRUE))
+    {
+      context->flushHoldingRegsFcn(context, context->shadowFirst, numRegs,
+                                   &context->holdingRegTable.data[context->shadowFirst -
+                                                    context->holdingRegTable.baseAddr]);
+    }
+  }
+} /*** end of TbxMbServerShadowFlush ***/
+#endif
 
 
 /*********************************** end of tbxmb_server.c *****************************/
@@ -43,6 +43,12 @@ extern "C" {
 typedef void * tTbxMbServer;
 
 
+/** \brief Caller provided storage for a Modbus server channel object. Include
+ *         tbxmb_storage.h to be able to allocate it.
+ */
+typedef struct tTbxMbServerStorageTag tTbxMbServerStorage;
+
+
 /** \brief Enumerated type with all supported return values for the callbacks. */
 typedef enum
 {
@@ -162,6 +168,244 @@ typedef tTbxMbServerResult (* tTbxMbServerWriteHoldingReg) (tTbxMbServer    chan
                                                             uint16_t        value);
 
 
+/** \brief   Modbus server callback function for reading a range of discrete inputs in
+ *           one go. When registered, the server prefers it over the per-element
+ *           tTbxMbServerReadInput callback.
+ *  \details The input values must be written to "values" as packed bits, in the same
+ *           format as the Modbus protocol uses: the input at "addr" goes in bit 0 of
+ *           values[0], the input at "addr + 1" in bit 1 of values[0], etc. The bytes
+ *           are already cleared to all zeroes upon calling the callback, so only the
+ *           bits of inputs in the ON state need to be set.
+ *           Note that the elements are specified by their zero-based address in the
+ *           range 0 - 65535, not their element number (1 - 65536).
+ *  \param   channel Handle to the Modbus server channel object that triggered the 
+ *           callback.
+ *  \param   addr Start element address (0..65535).
+ *  \param   num Number of elements to read (1..2000).
+ *  \param   values Byte array to write the packed input bits to.
+ *  \return  TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+ *           or more of the data element addresses are not supported by this server,
+ *           TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+ */
+typedef tTbxMbServerResult (* tTbxMbServerReadInputs)      (tTbxMbServer     channel, 
+                                                            uint16_t         addr, 
+                                                            uint16_t         num, 
+                                                            uint8_t        * values);
+
+
+/** \brief   Modbus server callback function for reading a range of coils in one go.
+ *           When registered, the server prefers it over the per-element
+ *           tTbxMbServerReadCoil callback.
+ *  \details The coil values must be written to "values" as packed bits, in the same
+ *           format as the Modbus protocol uses: the coil at "addr" goes in bit 0 of
+ *           values[0], the coil at "addr + 1" in bit 1 of values[0], etc. The bytes are
+ *           already cleared to all zeroes upon calling the callback, so only the bits
+ *           of coils in the ON state need to be set.
+ *           Note that the elements are specified by their zero-based address in the
+ *           range 0 - 65535, not their element number (1 - 65536).
+ *  \param   channel Handle to the Modbus server channel object that triggered the 
+ *           callback.
+ *  \param   addr Start element address (0..65535).
+ *  \param   num Number of elements to read (1..2000).
+ *  \param   values Byte array to write the packed coil bits to.
+ *  \return  TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+ *           or more of the data element addresses are not supported by this server,
+ *           TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+ */
+typedef tTbxMbServerResult (* tTbxMbServerReadCoils)       (tTbxMbServer     channel, 
+                                                            uint16_t         addr, 
+                                                            uint16_t         num, 
+                                                            uint8_t        * values);
+
+
+/** \brief   Modbus server callback function for writing a range of coils in one go.
+ *           When registered, the server prefers it over the per-element
+ *           tTbxMbServerWriteCoil callback.
+ *  \details The coil values in "values" are packed bits, in the same format as the
+ *           Modbus protocol uses: the coil at "addr" is in bit 0 of values[0], the coil
+ *           at "addr + 1" in bit 1 of values[0], etc. A bit value of 1 means ON.
+ *           Note that the elements are specified by their zero-based address in the
+ *           range 0 - 65535, not their element number (1 - 65536).
+ *  \param   channel Handle to the Modbus server channel object that triggered the 
+ *           callback.
+ *  \param   addr Start element address (0..65535).
+ *  \param   num Number of elements to write (1..1968).
+ *  \param   values Byte array with the packed coil bits.
+ *  \return  TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+ *           or more of the data element addresses are not supported by this server,
+ *           TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+ */
+typedef tTbxMbServerResult (* tTbxMbServerWriteCoils)      (tTbxMbServer     channel, 
+                                                            uint16_t         addr, 
+                                                            uint16_t         num, 
+                                                            uint8_t  const * values);
+
+
+/** \brief   Modbus server callback function for reading a range of input registers in
+ *           one go. When registered, the server prefers it over the per-element
+ *           tTbxMbServerReadInputReg callback.
+ *  \details Write the values of the input registers in your CPUs native endianess. The
+ *           MicroTBX-Modbus stack will automatically convert them to the big endianess
+ *           that the Modbus protocol requires.
+ *           Note that the elements are specified by their zero-based address in the
+ *           range 0 - 65535, not their element number (1 - 65536).
+ *  \param   channel Handle to the Modbus server channel object that triggered the 
+ *           callback.
+ *  \param   addr Start element address (0..65535).
+ *  \param   num Number of elements to read (1..125).
+ *  \param   values Array to write the values of the input registers to.
+ *  \return  TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+ *           or more of the data element addresses are not supported by this server,
+ *           TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+ */
+typedef tTbxMbServerResult (* tTbxMbServerReadInputRegs)   (tTbxMbServer     channel, 
+                                                            uint16_t         addr, 
+                                                            uint8_t          num, 
+                                                            uint16_t       * values);
+
+
+/** \brief   Modbus server callback function for reading a range of holding registers
+ *           in one go. When registered, the server prefers it over the per-element
+ *           tTbxMbServerReadHoldingReg callback.
+ *  \details Write the values of the holding registers in your CPUs native endianess.
+ *           The MicroTBX-Modbus stack will automatically convert them to the big
+ *           endianess that the Modbus protocol requires.
+ *           Note that the elements are specified by their zero-based address in the
+ *           range 0 - 65535, not their element number (1 - 65536).
+ *  \param   channel Handle to the Modbus server channel object that triggered the 
+ *           callback.
+ *  \param   addr Start element address (0..65535).
+ *  \param   num Number of elements to read (1..125).
+ *  \param   values Array to write the values of the holding registers to.
+ *  \return  TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+ *           or more of the data element addresses are not supported by this server,
+ *           TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+ */
+typedef tTbxMbServerResult (* tTbxMbServerReadHoldingRegs) (tTbxMbServer     channel, 
+                                                            uint16_t         addr, 
+                                                            uint8_t          num, 
+                                                            uint16_t       * values);
+
+
+/** \brief   Modbus server callback function for writing a range of holding registers
+ *           in one go. When registered, the server prefers it over the per-element
+ *           tTbxMbServerWriteHoldingReg callback.
+ *  \details The values of the holding registers are already in your CPUs native
+ *           endianess.
+ *           Note that the elements are specified by their zero-based address in the
+ *           range 0 - 65535, not their element number (1 - 65536).
+ *  \param   channel Handle to the Modbus server channel object that triggered the 
+ *           callback.
+ *  \param   addr Start element address (0..65535).
+ *  \param   num Number of elements to write (1..123).
+ *  \param   values Array with the values of the holding registers.
+ *  \return  TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+ *           or more of the data element addresses are not supported by this server,
+ *           TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+ */
+typedef tTbxMbServerResult (* tTbxMbServerWriteHoldingRegs)(tTbxMbServer     channel, 
+                                                            uint16_t         addr, 
+                                                            uint8_t          num, 
+                                                            uint16_t const * values);
+
+
+/** \brief   Modbus server callback function for flushing holding registers that
+ *           clients changed in the data table, attached with
+ *           TbxMbServerSetTableHoldingRegs().
+ *  \details The server already wrote the new values to the data table and responded to
+ *           the client. This callback is the place where the application persists the
+ *           changed holding registers, for example in EEPROM or flash. If
+ *           TBX_MB_SERVER_SHADOW_FLUSH_MS is 0, the server calls it for each write
+ *           request, before the response is sent. Otherwise, the server collects the
+ *           changes of consecutive write requests and calls it once, at most
+ *           TBX_MB_SERVER_SHADOW_FLUSH_MS milliseconds after the first change. The range
+ *           then spans from the lowest to the highest changed address, so it can
+ *           include unchanged holding registers.
+ *           Note that the elements are specified by their zero-based address in the
+ *           range 0 - 65535, not their element number (1 - 65536).
+ *  \param   channel Handle to the Modbus server channel object that triggered the 
+ *           callback.
+ *  \param   addr Start element address (0..65535).
+ *  \param   num Number of changed elements.
+ *  \param   values Array with the values of the holding registers, located in the data
+ *           table.
+ */
+typedef void               (* tTbxMbServerFlushHoldingRegs)(tTbxMbServer     channel, 
+                                                            uint16_t         addr, 
+                                                            uint16_t         num, 
+                                                            uint16_t const * values);
+
+
+/** \brief   Modbus server callback function for reading a record of a file. A file
+ *           is an array of records, where each record is a 16-bit register.
+ *  \details Store the values of the records in your CPUs native endianess. The
+ *           MicroTBX-Modbus stack will automatically convert these to the big endianess
+ *           that the Modbus protocol requires. The server calls this function once for
+ *           each sub-request of a request, and stores the values in the response right
+ *           away. This way the application only needs to provide the requested part of
+ *           the file.
+ *  \param   channel Handle to the Modbus server channel object that triggered the 
+ *           callback.
+ *  \param   file File number (1..65535).
+ *  \param   record Start record number (0..9999).
+ *  \param   num Number of records to read (1..124).
+ *  \param   values Array where to store the values of the records.
+ *  \return  TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if the
+ *           file or one or more of the records are not supported by this server,
+ *           TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+ */
+typedef tTbxMbServerResult (* tTbxMbServerReadFileRecord)  (tTbxMbServer     channel, 
+                                                            uint16_t         file, 
+                                                            uint16_t         record, 
+                                                            uint8_t          num, 
+                                                            uint16_t       * values);
+
+
+/** \brief   Modbus server callback function for writing a record of a file. A file
+ *           is an array of records, where each record is a 16-bit register.
+ *  \details The values of the records are already in your CPUs native endianess. The
+ *           server calls this function once for each sub-request of a request.
+ *  \param   channel Handle to the Modbus server channel object that triggered the 
+ *           callback.
+ *  \param   file File number (1..65535).
+ *  \param   record Start record number (0..9999).
+ *  \param   num Number of records to write (1..122).
+ *  \param   values Array with the values of the records.
+ *  \return  TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if the
+ *           file or one or more of the records are not supported by this server,
+ *           TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+ */
+typedef tTbxMbServerResult (* tTbxMbServerWriteFileRecord) (tTbxMbServer     channel, 
+                                                            uint16_t         file, 
+                                                            uint16_t         record, 
+                                                            uint8_t          num, 
+                                                            uint16_t const * values);
+
+
+/** \brief   Modbus server callback function for reading a device identification
+ *           object, such as the vendor name or the product code.
+ *  \details The server calls this function for each object that goes into the
+ *           response, with "data" pointing directly into the response packet. Write at
+ *           most "maxLen" bytes of the object's value to "data" and return the total
+ *           length of the object's value. If the object doesn't fit anymore, the server
+ *           reports it with "more follows" in the response, such that the client reads
+ *           it with its next request. Note that "maxLen" can be zero, when the server
+ *           just checks if an object is available. The basic objects 0x00..0x02
+ *           (TBX_MB_DEVID_OBJ_xxx) are mandatory.
+ *  \param   channel Handle to the Modbus server channel object that triggered the 
+ *           callback.
+ *  \param   objectId Identifier of the object (0x00..0xFF).
+ *  \param   data Byte array for writing the object's value.
+ *  \param   maxLen Maximum number of bytes to write to "data".
+ *  \return  Total length of the object's value in bytes, or 0 if the object is not
+ *           available.
+ */
+typedef uint8_t            (* tTbxMbServerReadDeviceId)    (tTbxMbServer    channel,
+                                                            uint8_t         objectId,
+                                                            uint8_t       * data,
+                                                            uint8_t         maxLen);
+
+
 /** \brief   Modbus server callback function for implementing custom function code
  *           handling. Thanks to this functionality, the user can support Modbus function
  *           codes that are either currently not supported or user defined extensions.
@@ -169,7 +413,10 @@ typedef tTbxMbServerResult (* tTbxMbServerWriteHoldingReg) (tTbxMbServer    chan
  *           PDU. The first byte (i.e. rxPdu[0]) contains the function code, followed by
  *           its data bytes. Upon calling the callback, the "len" parameter contains the
  *           length of "rxPdu". When preparing the response, you can write the length
- *           of the "txPdu" response to "len" as well.
+ *           of the "txPdu" response to "len" as well. Both pointers point directly to
+ *           the PDUs of the transport layer's packets. This way the PDUs can be parsed
+ *           and built in place, without copying. The response PDU can be up to
+ *           TBX_MB_TP_PDU_MAX_LEN bytes.
  *  \param   channel Handle to the Modbus server channel object that triggered the 
  *           callback.
  *  \param   rxPdu Pointer to a byte array for reading the received PDU.
@@ -189,6 +436,9 @@ typedef uint8_t            (* tTbxMbServerCustomFunction)  (tTbxMbServer    chan
 ****************************************************************************************/
 tTbxMbServer TbxMbServerCreate                    (tTbxMbTp                   transport);
 
+tTbxMbServer TbxMbServerCreateStatic              (tTbxMbServerStorage      * storage,
+                                                   tTbxMbTp                   transport);
+
 void         TbxMbServerFree                      (tTbxMbServer                channel);
 
 void         TbxMbServerSetCallbackReadInput      (tTbxMbServer                channel,
@@ -212,6 +462,58 @@ void         TbxMbServerSetCallbackWriteHoldingReg(tTbxMbServer                c
 void         TbxMbServerSetCallbackCustomFunction (tTbxMbServer                channel,
                                                    tTbxMbServerCustomFunction  callback);
 
+void         TbxMbServerSetCallbackReadInputs     (tTbxMbServer                 channel,
+                                                   tTbxMbServerReadInputs       callback);
+
+void         TbxMbServerSetCallbackReadCoils      (tTbxMbServer                 channel,
+                                                   tTbxMbServerReadCoils        callback);
+
+void         TbxMbServerSetCallbackWriteCoils     (tTbxMbServer                 channel,
+                                                   tTbxMbServerWriteCoils       callback);
+
+void         TbxMbServerSetCallbackReadInputRegs  (tTbxMbServer                 channel,
+                                                   tTbxMbServerReadInputRegs    callback);
+
+void         TbxMbServerSetCallbackReadHoldingRegs(tTbxMbServer                 channel,
+                                                   tTbxMbServerReadHoldingRegs  callback);
+
+void         TbxMbServerSetCallbackWriteHoldingRegs(tTbxMbServer                channel,
+                                                    tTbxMbServerWriteHoldingRegs callback);
+
+void         TbxMbServerSetCallbackReadFileRecord (tTbxMbServer                 channel,
+                                                   tTbxMbServerReadFileRecord   callback);
+
+void         TbxMbServerSetCallbackWriteFileRecord(tTbxMbServer                 channel,
+                                                   tTbxMbServerWriteFileRecord  callback);
+
+void         TbxMbServerSetCallbackReadDeviceId   (tTbxMbServer                 channel,
+                                                   tTbxMbServerReadDeviceId     callback);
+
+void         TbxMbServerSetTableInputs            (tTbxMbServer   channel,
+                                                   uint16_t       baseAddr,
+                                                   uint16_t       numElements,
+                                                   uint8_t      * inputs);
+
+void         TbxMbServerSetTableCoils             (tTbxMbServer   channel,
+                                                   uint16_t       baseAddr,
+                                                   uint16_t       numElements,
+                                                   uint8_t      * coils);
+
+void         TbxMbServerSetTableInputRegs         (tTbxMbServer   channel,
+                                                   uint16_t       baseAddr,
+                                                   uint16_t       numElements,
+                                                   uint16_t     * inputRegs);
+
+void         TbxMbServerSetTableHoldingRegs       (tTbxMbServer   channel,
+                                                   uint16_t       baseAddr,
+                                                   uint16_t       numElements,
+                                                   uint16_t     * holdingRegs);
+
+void         TbxMbServerSetCallbackFlushHoldingRegs(tTbxMbServer                channel,
+                                                    tTbxMbServerFlushHoldingRegs callback);
+
+void         TbxMbServerInvalidateCache           (tTbxMbServer   channel);
+
 
 #ifdef __cplusplus
 }
@@ -34,6 +34,121 @@
 extern "C" {
 #endif
 
+/****************************************************************************************
+* Macro definitions
+****************************************************************************************/
+#ifndef TBX_MB_SERVER_CACHE_SIZE
+/** \brief Configure the number of responses to read requests (function codes 1, 2, 3
+ *         and 4) that each server channel caches. A repeated identical read request is
+ *         then answered with the cached response, without calling the callback
+ *         functions. Each entry needs about 260 bytes of RAM in the server channel
+ *         object. The default value of 0 disables the cache. You can override this
+ *         configuration by adding a macro with the same name, but a different value, to
+ *         "tbx_conf.h".
+ */
+#define TBX_MB_SERVER_CACHE_SIZE           (0U)
+#endif
+
+#ifndef TBX_MB_SERVER_CACHE_VALIDITY_MS
+/** \brief Configure the time in milliseconds that a cached response stays valid. You
+ *         can override this configuration by adding a macro with the same name, but a
+ *         different value, to "tbx_conf.h".
+ */
+#define TBX_MB_SERVER_CACHE_VALIDITY_MS    (50U)
+#endif
+
+#ifndef TBX_MB_SERVER_SHADOW_FLUSH_MS
+/** \brief Configure the maximum time in milliseconds that the server defers the flush
+ *         callback, after a client changed holding registers in the attached data
+ *         table. The server collects the changes of all write requests in this time
+ *         window and flushes them with a single callback. This way the server responds
+ *         to write requests right away, while the application persists the changes
+ *         later on. The default value of 0 calls the flush callback for each write
+ *         request, before the server responds. You can override this configuration by
+ *         adding a macro with the same name, but a different value, to "tbx_conf.h".
+ */
+#define TBX_MB_SERVER_SHADOW_FLUSH_MS      (0U)
+#endif
+
+
+/* The server channel supports the following function codes by itself. To save code
+ * size, the support for the ones that your application doesn't need can be removed,
+ * by adding a macro with the same name, but with a value of 0, to "tbx_conf.h". A
+ * request with such a function code is then passed on to the custom function code
+ * callback, if registered. Otherwise, the server responds with exception code 01 -
+ * Illegal function.
+ */
+#ifndef TBX_MB_SERVER_FC01_ENABLE
+/** \brief Enable support for function code 01 - Read Coils. */
+#define TBX_MB_SERVER_FC01_ENABLE          (1U)
+#endif
+
+#ifndef TBX_MB_SERVER_FC02_ENABLE
+/** \brief Enable support for function code 02 - Read Discrete Inputs. */
+#define TBX_MB_SERVER_FC02_ENABLE          (1U)
+#endif
+
+#ifndef TBX_MB_SERVER_FC03_ENABLE
+/** \brief Enable support for function code 03 - Read Holding Registers. */
+#define TBX_MB_SERVER_FC03_ENABLE          (1U)
+#endif
+
+#ifndef TBX_MB_SERVER_FC04_ENABLE
+/** \brief Enable support for function code 04 - Read Input Registers. */
+#define TBX_MB_SERVER_FC04_ENABLE          (1U)
+#endif
+
+#ifndef TBX_MB_SERVER_FC05_ENABLE
+/** \brief Enable support for function code 05 - Write Single Coil. */
+#define TBX_MB_SERVER_FC05_ENABLE          (1U)
+#endif
+
+#ifndef TBX_MB_SERVER_FC06_ENABLE
+/** \brief Enable support for function code 06 - Write Single Register. */
+#define TBX_MB_SERVER_FC06_ENABLE          (1U)
+#endif
+
+#ifndef TBX_MB_SERVER_FC08_ENABLE
+/** \brief Enable support for function code 08 - Diagnostics. */
+#define TBX_MB_SERVER_FC08_ENABLE          (1U)
+#endif
+
+#ifndef TBX_MB_SERVER_FC15_ENABLE
+/** \brief Enable support for function code 15 - Write Multiple Coils. */
+#define TBX_MB_SERVER_FC15_ENABLE          (1U)
+#endif
+
+#ifndef TBX_MB_SERVER_FC16_ENABLE
+/** \brief Enable support for function code 16 - Write Multiple Registers. */
+#define TBX_MB_SERVER_FC16_ENABLE          (1U)
+#endif
+
+#ifndef TBX_MB_SERVER_FC20_ENABLE
+/** \brief Enable support for function code 20 - Read File Record. */
+#define TBX_MB_SERVER_FC20_ENABLE          (1U)
+#endif
+
+#ifndef TBX_MB_SERVER_FC21_ENABLE
+/** \brief Enable support for function code 21 - Write File Record. */
+#define TBX_MB_SERVER_FC21_ENABLE          (1U)
+#endif
+
+#ifndef TBX_MB_SERVER_FC22_ENABLE
+/** \brief Enable support for function code 22 - Mask Write Register. */
+#define TBX_MB_SERVER_FC22_ENABLE          (1U)
+#endif
+
+#ifndef TBX_MB_SERVER_FC23_ENABLE
+/** \brief Enable support for function code 23 - Read/Write Multiple Registers. */
+#define TBX_MB_SERVER_FC23_ENABLE          (1U)
+#endif
+
+#ifndef TBX_MB_SERVER_FC43_ENABLE
+/** \brief Enable support for function code 43 - Encapsulated Interface Transport. */
+#define TBX_MB_SERVER_FC43_ENABLE          (1U)
+#endif
+
+
 /****************************************************************************************
 * Type definitions
 ****************************************************************************************/
@@ -47,21 +162,55 @@ typedef void (* tTbxMbServerPoll)   (void        * context);
 typedef void (* tTbxMbServerProcess)(tTbxMbEvent * event);
 
 
+/** \brief Application owned data table with packed bits (discrete inputs or coils). */
+typedef struct
+{
+  uint8_t                     * data;               /**< Packed bits array.            */
+  uint16_t                      baseAddr;           /**< Address of the first element. */
+  uint16_t                      numElements;        /**< Number of elements (bits).    */
+} tTbxMbServerBitTable;
+
+
+/** \brief Application owned data table with 16-bit registers. */
+typedef struct
+{
+  uint16_t                    * data;               /**< Register values array.        */
+  uint16_t                      baseAddr;           /**< Address of the first element. */
+  uint16_t                      numElements;        /**< Number of elements.           */
+} tTbxMbServerRegTable;
+
+
+#if (TBX_MB_SERVER_CACHE_SIZE > 0U)
+/** \brief Cached response to a read request. */
+typedef struct
+{
+  uint8_t                       code;               /**< Request function code.        */
+  uint8_t                       dataLen;            /**< Response data length. 0=free. */
+  uint16_t                      addr;               /**< Request start address.        */
+  uint16_t                      num;                /**< Request number of elements.   */
+  uint16_t                      ageMs;              /**< Response age (ms).            */
+  uint8_t                       data[TBX_MB_TP_PDU_DATA_LEN_MAX]; /**< Response data.  */
+} tTbxMbServerCacheEntry;
+#endif
+
+
 /** \brief Modbus server channel layer context that groups all channel specific data. 
  *         It's what the tTbxMbServer opaque pointer points to.
  */
 typedef struct
 {
-  /* Event interface methods. The following three entries must always be at the start
+  /* Event interface methods. The following four entries must always be at the start
    * and exactly match those in tTbxMbEventCtx. Think of it as the base that this struct
    * derives from. 
    */
   void                       * instancePtr;         /**< Reserved for C++ wrapper.     */
   tTbxMbServerPoll              pollFcn;            /**< Event poll function.          */
   tTbxMbServerProcess           processFcn;         /**< Event process function.       */
+  tTbxMbEventPoller             pollInfo;           /**< Event poller information.     */
   /* Private members. */
   uint8_t                       type;               /**< Context type.                 */
   tTbxMbTpCtx                 * tpCtx;              /**< Assigned transport layer ctx. */
+  uint8_t                       isStatic;           /**< Caller provided storage flag. */
   tTbxMbServerReadInput         readInputFcn;       /**< Read discrete input callback. */
   tTbxMbServerReadCoil          readCoilFcn;        /**< Read coil callback.           */
   tTbxMbServerWriteCoil         writeCoilFcn;       /**< Write coil callback.          */
@@ -69,9 +218,59 @@ typedef struct
   tTbxMbServerReadHoldingReg    readHoldingRegFcn;  /**< Read holding register cb.     */
   tTbxMbServerWriteHoldingReg   writeHoldingRegFcn; /**< Write holding register cb.    */
   tTbxMbServerCustomFunction    customFunctionFcn;  /**< Custom function code callback.*/  
+  tTbxMbServerReadInputs        readInputsFcn;      /**< Read discrete inputs callback.*/
+  tTbxMbServerReadCoils         readCoilsFcn;       /**< Read coils callback.          */
+  tTbxMbServerWriteCoils        writeCoilsFcn;      /**< Write coils callback.         */
+  tTbxMbServerReadInputRegs     readInputRegsFcn;   /**< Read input registers callback.*/
+  tTbxMbServerReadHoldingRegs   readHoldingRegsFcn; /**< Read holding registers cb.    */
+  tTbxMbServerWriteHoldingRegs  writeHoldingRegsFcn;/**< Write holding registers cb.   */
+  tTbxMbServerReadFileRecord    readFileRecordFcn;  /**< Read file record callback.    */
+  tTbxMbServerWriteFileRecord   writeFileRecordFcn; /**< Write file record callback.   */
+  tTbxMbServerReadDeviceId      readDeviceIdFcn;    /**< Read device ID object cb.     */
+  tTbxMbServerFlushHoldingRegs  flushHoldingRegsFcn;/**< Flush holding registers cb.   */
+  tTbxMbServerBitTable          inputTable;         /**< Discrete inputs data table.   */
+  tTbxMbServerBitTable          coilTable;          /**< Coils data table.             */
+  tTbxMbServerRegTable          inputRegTable;      /**< Input registers data table.   */
+  tTbxMbServerRegTable          holdingRegTable;    /**< Holding registers data table. */
+#if (TBX_MB_SERVER_CACHE_SIZE > 0U)
+  tTbxMbServerCacheEntry        cache[TBX_MB_SERVER_CACHE_SIZE]; /**< Response cache.  */
+  uint8_t                       cacheCount;         /**< Number of cached responses.   */
+  uint8_t                       cacheInvalidate;    /**< Invalidate cache request flag.*/
+  uint16_t                      cacheMsTime;        /**< Cache last millisecond time.  */
+#endif
+#if (TBX_MB_SERVER_SHADOW_FLUSH_MS > 0U)
+  uint8_t                       shadowDirty;        /**< Unflushed changes flag.       */
+  uint16_t                      shadowFirst;        /**< First changed address.        */
+  uint16_t                      shadowLast;         /**< Last changed address.         */
+  uint16_t                      shadowAgeMs;        /**< Age of the first change (ms). */
+  uint16_t                      shadowMsTime;       /**< Shadow last millisecond time. */
+#endif
 } tTbxMbServerCtx;
 
 
+/** \brief Function code handler that processes a request and prepares its response. */
+typedef void (* tTbxMbServerFcHandler)(tTbxMbServerCtx       * context,
+                                       tTbxMbTpPacket  const * rxPacket,
+                                       tTbxMbTpPacket        * txPacket);
+
+
+/** \brief Dispatch table entry of a function code that the server supports by itself. */
+typedef struct
+{
+  uint8_t                       code;               /**< Function code.                */
+  uint8_t                       minLen;             /**< Min request PDU data length.  */
+  uint8_t                       maxLen;             /**< Max request PDU data length.  */
+  tTbxMbServerFcHandler         handler;            /**< Function code handler.        */
+} tTbxMbServerFcEntry;
+
+
+/** \brief Caller provided storage for a Modbus server channel object. */
+struct tTbxMbServerStorageTag
+{
+  tTbxMbServerCtx               ctx;                /**< Server channel context.       */
+};
+
+
 #ifdef __cplusplus
 }
 #endif
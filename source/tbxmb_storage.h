@@ -0,0 +1,50 @@
+/************************************************************************************//**
+* \file         tbxmb_storage.h
+* \brief        Modbus caller provided storage header file.
+* \internal
+*----------------------------------------------------------------------------------------
+*                          C O P Y R I G H T
+*----------------------------------------------------------------------------------------
+*   Copyright (c) 2023 by Feaser     www.feaser.com     All rights reserved
+*
+*----------------------------------------------------------------------------------------
+*                            L I C E N S E
+*----------------------------------------------------------------------------------------
+*
+* SPDX-License-Identifier: GPL-3.0-or-later
+*
+* This file is part of MicroTBX-Modbus. MicroTBX-Modbus is free software: you can
+* redistribute it and/or modify it under the terms of the GNU General Public License as
+* published by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* MicroTBX-Modbus is distributed in the hope that it will be useful, but WITHOUT ANY
+* WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+* PARTICULAR PURPOSE. See the GNU General Public License for more details.
+*
+* You have received a copy of the GNU General Public License along with MicroTBX-Modbus.
+* If not, see www.gnu.org/licenses/.
+*
+* \endinternal
+****************************************************************************************/
+#ifndef TBXMB_STORAGE_H
+#define TBXMB_STORAGE_H
+
+/****************************************************************************************
+* Include files
+****************************************************************************************/
+/* The storage types for the static create functions, such as TbxMbRtuCreateStatic(),
+ * TbxMbServerCreateStatic() and TbxMbClientCreateStatic() need the complete
+ * definitions of the object contexts. Only include this header file in the source file
+ * that defines the storage, and after "microtbx.h" and "microtbxmodbus.h". Note that
+ * the application should never access the storage members directly.
+ */
+#include "tbxmb_event_private.h"                 /* MicroTBX-Modbus event private      */
+#include "tbxmb_osal_private.h"                  /* MicroTBX-Modbus OSAL private       */
+#include "tbxmb_tp_private.h"                    /* MicroTBX-Modbus TP private         */
+#include "tbxmb_server_private.h"                /* MicroTBX-Modbus server private     */
+#include "tbxmb_client_private.h"                /* MicroTBX-Modbus client private     */
+
+
+#endif /* TBXMB_STORAGE_H */
+/*********************************** end of tbxmb_storage.h ****************************/
@@ -0,0 +1,1168 @@
+/************************************************************************************//**
+* \file         tbxmb_tcp.c
+* \brief        Modbus TCP transport layer source file.
+* \internal
+*----------------------------------------------------------------------------------------
+*                          C O P Y R I G H T
+*----------------------------------------------------------------------------------------
+*   Copyright (c) 2023 by Feaser     www.feaser.com     All rights reserved
+*
+*----------------------------------------------------------------------------------------
+*                            L I C E N S E
+*----------------------------------------------------------------------------------------
+*
+* SPDX-License-Identifier: GPL-3.0-or-later
+*
+* This file is part of MicroTBX-Modbus. MicroTBX-Modbus is free software: you can
+* redistribute it and/or modify it under the terms of the GNU General Public License as
+* published by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* MicroTBX-Modbus is distributed in the hope that it will be useful, but WITHOUT ANY
+* WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+* PARTICULAR PURPOSE. See the GNU General Public License for more details.
+*
+* You have received a copy of the GNU General Public License along with MicroTBX-Modbus.
+* If not, see www.gnu.org/licenses/.
+*
+* \endinternal
+****************************************************************************************/
+
+/****************************************************************************************
+* Include files
+****************************************************************************************/
+#include "microtbx.h"                            /* MicroTBX module                    */
+#include "microtbxmodbus.h"                      /* MicroTBX-Modbus module             */
+#include "tbxmb_event_private.h"                 /* MicroTBX-Modbus event private      */
+#include "tbxmb_osal_private.h"                  /* MicroTBX-Modbus OSAL private       */
+#include "tbxmb_tp_private.h"                    /* MicroTBX-Modbus TP private         */
+#include "tbxmb_tcp_private.h"                   /* MicroTBX-Modbus TCP private        */
+
+
+/****************************************************************************************
+* Macro definitions
+****************************************************************************************/
+#ifndef TBX_MB_TCP_RX_TIMEOUT_MS
+/** \brief Maximum time in milliseconds between the reception of the first and the last
+ *         byte of a Modbus TCP packet. With TCP/IP, a packet can arrive in multiple
+ *         segments. If the remainder of the packet does not arrive within this time,
+ *         the connection is closed, because it's then no longer possible to find the
+ *         start of the next packet in the data stream. Should be < 3000, because of
+ *         the 16-bit resolution of the 20 kHz timer. To override this default
+ *         configuration, you can add a macro with the same name, but with a different
+ *         value, to "tbx_conf.h".
+ */
+#define TBX_MB_TCP_RX_TIMEOUT_MS            (1000U)
+#endif
+
+/** \brief Length of the MBAP header that goes in front of the PDU in a Modbus TCP ADU.
+ *         It consists of the transaction identifier (2 bytes), protocol identifier
+ *         (2 bytes), length (2 bytes) and unit identifier (1 byte).
+ */
+#define TBX_MB_TCP_MBAP_LEN                 (7U)
+
+/** \brief Value of the MBAP header's protocol identifier for the Modbus protocol. */
+#define TBX_MB_TCP_PROTOCOL_ID              (0U)
+
+/** \brief Minimum value of the MBAP header's length field. It includes the unit
+ *         identifier and the PDU's function code.
+ */
+#define TBX_MB_TCP_MBAP_LEN_FIELD_MIN       (2U)
+
+/** \brief Maximum value of the MBAP header's length field. It includes the unit
+ *         identifier and the entire PDU.
+ */
+#define TBX_MB_TCP_MBAP_LEN_FIELD_MAX       (1U + TBX_MB_TP_PDU_MAX_LEN)
+
+/** \brief Unique context type to identify a context as being a TCP transport layer. */
+#define TBX_MB_TCP_CONTEXT_TYPE             (66U)
+
+/** \brief Idle state. No reception packet is passed on to the channel. */
+#define TBX_MB_TCP_STATE_IDLE               (1U)
+
+/** \brief Validating a newly received PDU state. The reception packet of connection
+ *         tcpRxConn is passed on to the channel.
+ */
+#define TBX_MB_TCP_STATE_VALIDATION         (4U)
+
+
+/****************************************************************************************
+* Configuration check
+****************************************************************************************/
+#if ((TBX_MB_TCP_CONN_MAX < 1U) || (TBX_MB_TCP_CONN_MAX > 255U))
+#error "TBX_MB_TCP_CONN_MAX must be in the range 1..255."
+#endif
+
+#if ((TBX_MB_TCP_RX_TIMEOUT_MS < 1U) || (TBX_MB_TCP_RX_TIMEOUT_MS >= 3000U))
+#error "TBX_MB_TCP_RX_TIMEOUT_MS must be in the range 1..2999."
+#endif
+
+
+/****************************************************************************************
+* Function prototypes
+****************************************************************************************/
+static void             TbxMbTcpPoll            (tTbxMbTp               transport);
+
+static uint8_t          TbxMbTcpTransmit        (tTbxMbTp               transport);
+
+static void             TbxMbTcpReceptionDone   (tTbxMbTp               transport);
+
+static tTbxMbTpPacket * TbxMbTcpGetRxPacket     (tTbxMbTp               transport);
+
+static tTbxMbTpPacket * TbxMbTcpGetTxPacket     (tTbxMbTp               transport);
+
+static uint8_t          TbxMbTcpSend            (tTbxMbTpCtx          * tpCtx,
+                                                 tTbxMbTcpSock          sock,
+                                                 uint16_t               transId);
+
+static uint8_t          TbxMbTcpValidate        (tTbxMbTpCtx          * tpCtx,
+                                                 tTbxMbTcpConn        * conn);
+
+static void             TbxMbTcpAccept          (tTbxMbTpCtx          * tpCtx);
+
+static void             TbxMbTcpReceive         (tTbxMbTpCtx          * tpCtx,
+                                                 uint8_t                connIdx);
+
+static void             TbxMbTcpDispatch        (tTbxMbTpCtx          * tpCtx);
+
+static void             TbxMbTcpConnLost        (tTbxMbTpCtx          * tpCtx,
+                                                 uint8_t                connIdx);
+
+static tTbxMbTcpConn  * TbxMbTcpConnCreate      (tTbxMbTcpSock          sock);
+
+static void             TbxMbTcpConnFree        (tTbxMbTcpConn        * conn);
+
+
+/************************************************************************************//**
+** \brief     Creates a Modbus TCP transport layer object.
+** \details   For a server, set ipAddress to NULL. The transport layer then listens for
+**            connection requests on the specified TCP port and accepts up to 
+**            TBX_MB_TCP_CONN_MAX client connections at the same time. Each connection
+**            has its own reception packet buffer, so packets are received on all
+**            connections at the same time. The server channel processes them in turn.
+**
+**            For a client, set ipAddress to the IP address of the server, to connect
+**            to on the specified TCP port. The transport layer automatically attempts
+**            to reconnect with the next packet transmission, after the connection was
+**            lost.
+** \param     ipAddress The IP address of the server to connect to (client) or NULL to
+**            accept connections from clients (server). The string is not copied, so it
+**            should stay valid, until the transport layer object is released. Its format
+**            is TCP/IP stack dependent, for example "192.168.0.10".
+** \param     port The TCP port number. Typically 502 for Modbus TCP.
+** \return    Handle to the newly created TCP transport layer object if successful, NULL
+**            otherwise.
+**
+****************************************************************************************/
+tTbxMbTp TbxMbTcpCreate(char     const * ipAddress,
+                        uint16_t         port)
+{
+  tTbxMbTp result = NULL;
+
+  /* Make sure the OSAL event module is initialized. The application will always first
+   * create a transport layer object before a channel object. Consequently, this is the
+   * best place to do the OSAL module initialization.
+   */
+  TbxMbOsalEventInit();
+
+  /* Verify parameters. */
+  TBX_ASSERT(port > 0U);
+
+  /* Only continue with valid parameters. */
+  if (port > 0U)
+  {
+    /* Allocate memory for the new transport layer storage. */
+    tTbxMbTpStorage * newStorage = TbxMemPoolAllocate(sizeof(tTbxMbTpStorage));
+    /* Automatically increase the memory pool, if it was too small. */
+    if (newStorage == NULL)
+    {
+      /* No need to check the return value, because if it failed, the following
+       * allocation fails too, which is verified later on.
+       */
+      (void)TbxMemPoolCreate(1U, sizeof(tTbxMbTpStorage));
+      newStorage = TbxMemPoolAllocate(sizeof(tTbxMbTpStorage));      
+    }
+    /* Verify memory allocation of the transport layer storage. */
+    TBX_ASSERT(newStorage != NULL);
+    /* Only continue if the memory allocation succeeded. */
+    if (newStorage != NULL)
+    {
+      /* The transport context is located at the start of the storage. */
+      tTbxMbTpCtx * newTpCtx = &newStorage->ctx;
+      /* Initialize the transport context. */
+      newTpCtx->type = TBX_MB_TCP_CONTEXT_TYPE;
+      newTpCtx->instancePtr = NULL;
+      newTpCtx->pollFcn = TbxMbTcpPoll;
+      newTpCtx->processFcn = NULL;
+      newTpCtx->pollInfo.count = 0U;
+      newTpCtx->pollInfo.task = TbxMbEventTaskSelected();
+      newTpCtx->transmitFcn = TbxMbTcpTransmit;
+      newTpCtx->receptionDoneFcn = TbxMbTcpReceptionDone;
+      newTpCtx->getRxPacketFcn = TbxMbTcpGetRxPacket;
+      newTpCtx->getTxPacketFcn = TbxMbTcpGetTxPacket;
+      newTpCtx->nodeAddr = TBX_MB_TP_NODE_ADDR_BROADCAST;
+      newTpCtx->state = TBX_MB_TCP_STATE_IDLE;
+      newTpCtx->isClient = (ipAddress != NULL) ? TBX_TRUE : TBX_FALSE;
+      newTpCtx->tcpIpAddress = ipAddress;
+      newTpCtx->tcpPort = port;
+      newTpCtx->tcpTransId = 0U;
+      newTpCtx->tcpConnSerial = 0U;
+      newTpCtx->tcpListenSock = NULL;
+      newTpCtx->tcpRxConn = 0U;
+      newTpCtx->tcpTxConn = 0U;
+      for (uint8_t connIdx = 0U; connIdx < TBX_MB_TCP_CONN_MAX; connIdx++)
+      {
+        newTpCtx->tcpConn[connIdx] = NULL;
+      }
+      newTpCtx->diagInfo.busMsgCnt = 0U;
+      newTpCtx->diagInfo.busCommErrCnt = 0U;
+      newTpCtx->diagInfo.busExcpErrCnt = 0U;
+      newTpCtx->diagInfo.srvMsgCnt = 0U;
+      newTpCtx->diagInfo.srvNoRespCnt = 0U;
+      newTpCtx->isMonitor = TBX_FALSE;
+      newTpCtx->isStatic = TBX_FALSE;
+      newTpCtx->txPacket = &newStorage->txPacket;
+      newTpCtx->rxPacket = &newStorage->rxPacket;
+      TbxMbTraceReset(newTpCtx);
+      uint8_t initOkay = TBX_FALSE;
+      /* Start listening for connection requests, when used by a server. */
+      if (ipAddress == NULL)
+      {
+        newTpCtx->tcpListenSock = TbxMbPortTcpServerOpen(port);
+        if (newTpCtx->tcpListenSock != NULL)
+        {
+          initOkay = TBX_TRUE;
+        }
+      }
+      /* Start connecting to the server, when used by a client. Note that there is no
+       * need to verify the socket here. If connecting failed, a reconnect is attempted
+       * upon the next packet transmission. A client always uses the first connection.
+       */
+      else
+      {
+        newTpCtx->tcpConn[0] = TbxMbTcpConnCreate(NULL);
+        if (newTpCtx->tcpConn[0] != NULL)
+        {
+          newTpCtx->tcpConn[0]->sock = TbxMbPortTcpConnect(ipAddress, port);
+          initOkay = TBX_TRUE;
+        }
+      }
+      /* Could the listen socket or the connection context not be created? */
+      if (initOkay == TBX_FALSE)
+      {
+        /* Invalidate the context and give it back to the memory pool. */
+        newTpCtx->type = 0U;
+        newTpCtx->pollFcn = NULL;
+        TbxMemPoolRelease(newStorage);
+      }
+      else
+      {
+        /* Instruct the event task to call our polling function. With TCP/IP it's needed
+         * all the time, for accepting connections and for detecting newly received
+         * data.
+         */
+        tTbxMbEvent newEvent = {.context = newTpCtx, .id = TBX_MB_EVENT_ID_START_POLLING};
+        TbxMbOsalEventPost(&newEvent, TBX_FALSE);
+        /* Update the result. */
+        result = newTpCtx;
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbTcpCreate ***/  
+
+
+/************************************************************************************//**
+** \brief     Releases a Modbus TCP transport layer object, previously created with 
+**            TbxMbTcpCreate(). It closes all its connections.
+** \param     transport Handle to TCP transport layer object to release.
+**
+****************************************************************************************/
+void TbxMbTcpFree(tTbxMbTp transport)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(transport != NULL);
+
+  /* Only continue with valid parameters. */
+  if (transport != NULL)
+  {
+    /* Convert the TP channel pointer to the context structure. */
+    tTbxMbTpCtx * tpCtx = (tTbxMbTpCtx *)transport;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(tpCtx->type == TBX_MB_TCP_CONTEXT_TYPE);
+    TbxCriticalSectionEnter();
+    /* Invalidate the context to protect it from accidentally being used afterwards. */
+    tpCtx->type = 0U;
+    tpCtx->pollFcn = NULL;
+    tpCtx->processFcn = NULL;
+    TbxCriticalSectionExit();
+    /* Remove the context from the poller array of its event task right away, such
+     * that its poll function is no longer called after releasing it.
+     */
+    TbxMbEventPollerRelease(tpCtx);
+    /* Close all connections and the listen socket. */
+    for (uint8_t connIdx = 0U; connIdx < TBX_MB_TCP_CONN_MAX; connIdx++)
+    {
+      if (tpCtx->tcpConn[connIdx] != NULL)
+      {
+        if (tpCtx->tcpConn[connIdx]->sock != NULL)
+        {
+          TbxMbPortTcpClose(tpCtx->tcpConn[connIdx]->sock);
+        }
+        TbxMbTcpConnFree(tpCtx->tcpConn[connIdx]);
+        tpCtx->tcpConn[connIdx] = NULL;
+      }
+    }
+    if (tpCtx->tcpListenSock != NULL)
+    {
+      TbxMbPortTcpClose(tpCtx->tcpListenSock);
+      tpCtx->tcpListenSock = NULL;
+    }
+    /* Give the transport layer context back to the memory pool. */
+    TbxMemPoolRelease(tpCtx);
+  }
+} /*** end of TbxMbTcpFree ***/
+
+
+/************************************************************************************//**
+** \brief     Event polling function that is automatically called during each call of
+**            TbxMbEventTask(), if activated. Use the TBX_MB_EVENT_ID_START_POLLING and
+**            TBX_MB_EVENT_ID_STOP_POLLING events to activate and deactivate.
+** \details   The socket layer is accessed in a non-blocking manner. Each connection
+**            reads just one packet at a time. The other data stays buffered in the 
+**            TCP/IP stack, until the channel is done processing the packet. This makes
+**            it possible for a client to pipeline its requests.
+** \param     transport Handle to TCP transport layer object.
+**
+****************************************************************************************/
+static void TbxMbTcpPoll(tTbxMbTp transport)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(transport != NULL);
+
+  /* Only continue with valid parameters. */
+  if (transport != NULL)
+  {
+    /* Convert the TP channel pointer to the context structure. */
+    tTbxMbTpCtx * tpCtx = (tTbxMbTpCtx *)transport;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(tpCtx->type == TBX_MB_TCP_CONTEXT_TYPE);
+    /* Accept new connection requests, when used by a server. */
+    if (tpCtx->isClient == TBX_FALSE)
+    {
+      TbxMbTcpAccept(tpCtx);
+    }
+    /* Read newly received data from all connections that do not yet hold a complete
+     * packet.
+     */
+    for (uint8_t connIdx = 0U; connIdx < TBX_MB_TCP_CONN_MAX; connIdx++)
+    {
+      tTbxMbTcpConn * conn = tpCtx->tcpConn[connIdx];
+      uint8_t         connOkay = TBX_FALSE;
+      if (conn != NULL)
+      {
+        TbxCriticalSectionEnter();
+        if ((conn->sock != NULL) && (conn->lost == TBX_FALSE) && 
+            (conn->rxAduDone == TBX_FALSE))
+        {
+          connOkay = TBX_TRUE;
+        }
+        TbxCriticalSectionExit();
+      }
+      if (connOkay == TBX_TRUE)
+      {
+        TbxMbTcpReceive(tpCtx, connIdx);
+      }
+    }
+    /* Pass the next complete packet on to the channel, if possible. */
+    TbxMbTcpDispatch(tpCtx);
+  }
+} /*** end of TbxMbTcpPoll ***/
+
+
+/************************************************************************************//**
+** \brief     Starts the transmission of a communication packet, stored in the transport
+**            layer object.
+** \details   The packet is handed over to the TCP/IP stack right away. Consequently
+**            the transmit packet is accessible again, the moment this function returns.
+** \param     transport Handle to TCP transport layer object.
+** \return    TBX_OK if successful, TBX_ERROR otherwise. 
+**
+****************************************************************************************/
+static uint8_t TbxMbTcpTransmit(tTbxMbTp transport)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify parameters. */
+  TBX_ASSERT(transport != NULL);
+
+  /* Only continue with valid parameters. */
+  if (transport != NULL)
+  {
+    /* Convert the TP channel pointer to the context structure. */
+    tTbxMbTpCtx * tpCtx = (tTbxMbTpCtx *)transport;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(tpCtx->type == TBX_MB_TCP_CONTEXT_TYPE);
+    tTbxMbTcpSock sock = NULL;
+    uint16_t      transId = 0U;
+    /* A client always uses its one connection to the server. */
+    if (tpCtx->isClient == TBX_TRUE)
+    {
+      tTbxMbTcpConn * conn = tpCtx->tcpConn[0];
+      /* Is a reconnect needed, because the connection failed or was lost? Note that
+       * the polling function no longer accesses the socket in this case, meaning that
+       * it's safe to close it here.
+       */
+      TbxCriticalSectionEnter();
+      uint8_t reconnect = ((conn->sock == NULL) || 
+                           (conn->lost == TBX_TRUE)) ? TBX_TRUE : TBX_FALSE;
+      TbxCriticalSectionExit();
+      if (reconnect == TBX_TRUE)
+      {
+        if (conn->sock != NULL)
+        {
+          TbxMbPortTcpClose(conn->sock);
+        }
+        sock = TbxMbPortTcpConnect(tpCtx->tcpIpAddress, tpCtx->tcpPort);
+        TbxCriticalSectionEnter();
+        conn->rxAduWrIdx = 0U;
+        conn->rxAduLen = TBX_MB_TCP_MBAP_LEN;
+        conn->sock = sock;
+        conn->lost = TBX_FALSE;
+        TbxCriticalSectionExit();
+      }
+      sock = conn->sock;
+      /* Each request gets a new transaction identifier, such that its response can be
+       * matched to it.
+       */
+      TbxCriticalSectionEnter();
+      tpCtx->tcpTransId++;
+      transId = tpCtx->tcpTransId;
+      TbxCriticalSectionExit();
+    }
+    /* A server responds on the connection that the request came in on and echoes its
+     * transaction identifier.
+     */
+    else
+    {
+      tTbxMbTcpConn * conn = tpCtx->tcpConn[tpCtx->tcpTxConn];
+      if (conn != NULL)
+      {
+        sock = conn->sock;
+        transId = conn->transId;
+      }
+    }
+    /* Transmit the packet and update the result accordingly. */
+    result = TbxMbTcpSend(tpCtx, sock, transId);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbTcpTransmit ***/
+
+
+/************************************************************************************//**
+** \brief     Obtains the information needed to later on transmit a response to the
+**            request in the reception packet, using TbxMbTcpTransmitReply(). Can be
+**            called by a channel that is linked to a TCP server, when processing the
+**            TBX_MB_EVENT_ID_PDU_RECEIVED event. This way the channel can respond after
+**            it called receptionDoneFcn(). For example once a gateway received the
+**            response from the actual server.
+** \param     transport Handle to TCP transport layer object.
+** \param     replyTo Pointer to where the information is stored.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbTcpGetReplyTo(tTbxMbTp           transport,
+                           tTbxMbTcpReplyTo * replyTo)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify parameters. */
+  TBX_ASSERT((transport != NULL) && (replyTo != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((transport != NULL) && (replyTo != NULL))
+  {
+    /* Convert the TP channel pointer to the context structure. */
+    tTbxMbTpCtx * tpCtx = (tTbxMbTpCtx *)transport;
+    /* Only continue if this is a TCP server, which currently gives its channel access to
+     * a reception packet.
+     */
+    TbxCriticalSectionEnter();
+    uint8_t currentState = tpCtx->state;
+    TbxCriticalSectionExit();
+    if ((tpCtx->type == TBX_MB_TCP_CONTEXT_TYPE) && (tpCtx->isClient == TBX_FALSE) &&
+        (currentState == TBX_MB_TCP_STATE_VALIDATION))
+    {
+      tTbxMbTcpConn * conn = tpCtx->tcpConn[tpCtx->tcpRxConn];
+      replyTo->connIdx = tpCtx->tcpRxConn;
+      replyTo->connSerial = conn->serial;
+      replyTo->transId = conn->transId;
+      replyTo->node = conn->rxPacket.node;
+      /* Update the result. */
+      result = TBX_OK;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbTcpGetReplyTo ***/
+
+
+/************************************************************************************//**
+** \brief     Transmits the packet, stored in the transport layer object, as the response
+**            to an earlier request. Use TbxMbTcpGetReplyTo() to obtain the replyTo
+**            information, while processing the request. The caller should have prepared
+**            the transmit packet beforehand, with the exception of its node element.
+**            That one is set by this function. Nothing is transmitted if the connection
+**            of the request was closed in the meantime.
+** \param     transport Handle to TCP transport layer object.
+** \param     replyTo Pointer to the reply information of the request.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbTcpTransmitReply(tTbxMbTp                 transport,
+                              tTbxMbTcpReplyTo const * replyTo)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify parameters. */
+  TBX_ASSERT((transport != NULL) && (replyTo != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((transport != NULL) && (replyTo != NULL))
+  {
+    /* Convert the TP channel pointer to the context structure. */
+    tTbxMbTpCtx * tpCtx = (tTbxMbTpCtx *)transport;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(tpCtx->type == TBX_MB_TCP_CONTEXT_TYPE);
+    tTbxMbTcpSock sock = NULL;
+    /* Only respond if the connection of the request is still open. Its slot might have
+     * been reused by a new connection, which is detected by its serial number.
+     */
+    if (replyTo->connIdx < TBX_MB_TCP_CONN_MAX)
+    {
+      tTbxMbTcpConn * conn = tpCtx->tcpConn[replyTo->connIdx];
+      if ((conn != NULL) && (conn->serial == replyTo->connSerial))
+      {
+        sock = conn->sock;
+      }
+    }
+    /* Transmit the packet and update the result accordingly. */
+    tpCtx->txPacket->node = replyTo->node;
+    result = TbxMbTcpSend(tpCtx, sock, replyTo->transId);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbTcpTransmitReply ***/
+
+
+/************************************************************************************//**
+** \brief     Transmits the packet, stored in the transport layer object, by adding the
+**            MBAP header and handing it over to the TCP/IP stack.
+** \param     tpCtx Pointer to the TCP transport layer context.
+** \param     sock Handle to the socket of the connection. Can be NULL, in which case the
+**            transmission fails.
+** \param     transId Transaction identifier for the MBAP header.
+** \return    TBX_OK if successful, TBX_ERROR otherwise. 
+**
+****************************************************************************************/
+static uint8_t TbxMbTcpSend(tTbxMbTpCtx   * tpCtx,
+                            tTbxMbTcpSock   sock,
+                            uint16_t        transId)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify parameters. */
+  TBX_ASSERT(tpCtx != NULL);
+
+  /* Only continue with valid parameters. */
+  if (tpCtx != NULL)
+  {
+    /* Are we requested to transmit an exception response? */
+    if ((tpCtx->txPacket->pdu.code & TBX_MB_FC_EXCEPTION_MASK) == 
+        TBX_MB_FC_EXCEPTION_MASK)
+    {
+      /* Increment the total number of exception responses. */
+      tpCtx->diagInfo.busExcpErrCnt++;
+    }
+    /* Only continue with a valid connection. */
+    if (sock != NULL)
+    {
+      /* Populate the MBAP header. The ADU starts at the MBAP header, right in front of
+       * the PDU. The MBAP length field counts the unit identifier, the function code
+       * and the packet data bytes. A server echoes the unit identifier of the request. 
+       * It was already stored in txPacket.node for us, when the request was passed on
+       * to the server channel.
+       */
+      uint8_t * aduPtr = &tpCtx->txPacket->head[TBX_MB_TP_ADU_HEAD_LEN_MAX - 
+                                               TBX_MB_TCP_MBAP_LEN];
+      uint16_t  aduLen = tpCtx->txPacket->dataLen + TBX_MB_TCP_MBAP_LEN + 1U;
+      TbxMbCommonStoreUInt16BE(transId, &aduPtr[0]);
+      TbxMbCommonStoreUInt16BE(TBX_MB_TCP_PROTOCOL_ID, &aduPtr[2]);
+      TbxMbCommonStoreUInt16BE((uint16_t)(tpCtx->txPacket->dataLen + 2U), &aduPtr[4]);
+      aduPtr[6] = tpCtx->txPacket->node;
+#if (TBX_MB_TRACE_ENABLE > 0U)
+      /* Timestamp the transmission start of the packet. */
+      TbxMbTraceMark(tpCtx, TBX_MB_TRACE_POINT_TX_START);
+#endif
+      /* Pass ADU transmit request on to the TCP/IP stack. */
+      result = TbxMbPortTcpTransmit(sock, aduPtr, aduLen);
+    }
+    /* Problem detected that prevented the response from being sent? */
+    if (result == TBX_ERROR)
+    {
+      /* Increment the total number of not sent responses. */
+      tpCtx->diagInfo.srvNoRespCnt++;
+    }
+    /* Packet handed over to the TCP/IP stack. */
+    else
+    {
+#if (TBX_MB_TRACE_ENABLE > 0U)
+      /* Timestamp the transmission completion of the packet. The TCP/IP stack
+       * completes it in the background, so this is when it was handed over.
+       */
+      TbxMbTraceMark(tpCtx, TBX_MB_TRACE_POINT_TX_DONE);
+#endif
+      /* Post an event to the linked channel for inform them that the PDU transmission
+       * completed.
+       */
+      tTbxMbEvent newEvent;
+      newEvent.context = tpCtx->channelCtx;
+      newEvent.id = TBX_MB_EVENT_ID_PDU_TRANSMITTED;
+      TbxMbOsalEventPost(&newEvent, TBX_FALSE);
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbTcpSend ***/
+
+
+/************************************************************************************//**
+** \brief     Signals that the caller is done with processing a reception PDU. Should be
+**            called by a channel after receiving the TBX_MB_EVENT_ID_PDU_RECEIVED event
+**            and no longer needing access to the PDU stored in the transport layer
+**            context.
+** \param     transport Handle to TCP transport layer object.
+**
+****************************************************************************************/
+static void TbxMbTcpReceptionDone(tTbxMbTp transport)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(transport != NULL);
+
+  /* Only continue with valid parameters. */
+  if (transport != NULL)
+  {
+    /* Convert the TP channel pointer to the context structure. */
+    tTbxMbTpCtx * tpCtx = (tTbxMbTpCtx *)transport;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(tpCtx->type == TBX_MB_TCP_CONTEXT_TYPE);
+    /* This function should only be called in the VALIDATION state. Verify this. */
+    TbxCriticalSectionEnter();
+    uint8_t currentState = tpCtx->state;
+    TbxCriticalSectionExit();
+    TBX_ASSERT(currentState == TBX_MB_TCP_STATE_VALIDATION);
+    /* Only continue in the VALIDATION state. */
+    if (currentState == TBX_MB_TCP_STATE_VALIDATION)
+    {
+      /* A server's response goes to the connection of the request. Note that the next
+       * packet is passed on to the channel by the polling function, so after the 
+       * channel transmitted its response.
+       */
+      tpCtx->tcpTxConn = tpCtx->tcpRxConn;
+      /* Unlock the reception path of the connection, allowing the reception of its next
+       * packet. Afterwards transition back to the IDLE state.
+       */
+      tTbxMbTcpConn * conn = tpCtx->tcpConn[tpCtx->tcpRxConn];
+      TbxCriticalSectionEnter();
+      conn->rxAduWrIdx = 0U;
+      conn->rxAduLen = TBX_MB_TCP_MBAP_LEN;
+      conn->rxAduDone = TBX_FALSE;
+      tpCtx->state = TBX_MB_TCP_STATE_IDLE;
+      TbxCriticalSectionExit();
+    }
+  }
+} /*** end of TbxMbTcpReceptionDone ****/
+
+
+/************************************************************************************//**
+** \brief     Interface function to be called by a channel to obtain read access to the 
+**            reception packet. Returns NULL is the packet is currently not accessible.
+**            Can be called when processing the TBX_MB_EVENT_ID_PDU_RECEIVED event.
+** \param     transport Handle to TCP transport layer object.
+** \return    Pointer to the packet or NULL if currently not accessible.
+**
+****************************************************************************************/
+static tTbxMbTpPacket * TbxMbTcpGetRxPacket(tTbxMbTp transport)
+{
+  tTbxMbTpPacket * result = NULL;
+
+  /* Verify parameters. */
+  TBX_ASSERT(transport != NULL);
+
+  /* Only continue with valid parameters. */
+  if (transport != NULL)
+  {
+    /* Convert the TP channel pointer to the context structure. */
+    tTbxMbTpCtx * tpCtx = (tTbxMbTpCtx *)transport;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(tpCtx->type == TBX_MB_TCP_CONTEXT_TYPE);
+    /* Access to the reception packet by a channel is only allowed in the VALIDATION
+     * state. In this state the reception path of the connection is locked until a
+     * transition back to IDLE state is made. This happens once the channel called
+     * receptionDoneFcn().
+     */
+    TbxCriticalSectionEnter();
+    uint8_t currentState = tpCtx->state;
+    TbxCriticalSectionExit();
+    if (currentState == TBX_MB_TCP_STATE_VALIDATION)
+    {
+      /* Update the result. */
+      result = &tpCtx->tcpConn[tpCtx->tcpRxConn]->rxPacket;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbTcpGetRxPacket ***/
+
+
+/************************************************************************************//**
+** \brief     Interface function to be called by a channel to obtain write access to the
+**            transmission packet. Returns NULL is the packet is currently not
+**            accessible. Can by called to prepare the transmit packet before calling the
+**            transport layer's transmitFcn().
+** \param     transport Handle to TCP transport layer object.
+** \return    Pointer to the packet or NULL if currently not accessible.
+**
+****************************************************************************************/
+static tTbxMbTpPacket * TbxMbTcpGetTxPacket(tTbxMbTp transport)
+{
+  tTbxMbTpPacket * result = NULL;
+
+  /* Verify parameters. */
+  TBX_ASSERT(transport != NULL);
+
+  /* Only continue with valid parameters. */
+  if (transport != NULL)
+  {
+    /* Convert the TP channel pointer to the context structure. */
+    tTbxMbTpCtx * tpCtx = (tTbxMbTpCtx *)transport;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(tpCtx->type == TBX_MB_TCP_CONTEXT_TYPE);
+    /* The transmit function hands the packet over to the TCP/IP stack right away.
+     * Consequently, the transmission packet is always accessible and one is enough
+     * for all connections.
+     */
+    result = tpCtx->txPacket;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbTcpGetTxPacket ***/
+
+
+/************************************************************************************//**
+** \brief     Validates a newly received communication packet, stored in the reception
+**            packet buffer of the connection.
+** \param     tpCtx Pointer to the TCP transport layer context.
+** \param     conn Pointer to the connection context.
+** \return    TBX_OK if successful, TBX_ERROR otherwise. 
+**
+****************************************************************************************/
+static uint8_t TbxMbTcpValidate(tTbxMbTpCtx   * tpCtx,
+                                tTbxMbTcpConn * conn)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify parameters. */
+  TBX_ASSERT((tpCtx != NULL) && (conn != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((tpCtx != NULL) && (conn != NULL))
+  {
+    /* Increment the total number of received packets. */
+    tpCtx->diagInfo.busMsgCnt++;
+    /* The ADU for a TCP packet starts at the MBAP header, right in front of the PDU. */
+    uint8_t const * aduPtr = &conn->rxPacket.head[TBX_MB_TP_ADU_HEAD_LEN_MAX - 
+                                                  TBX_MB_TCP_MBAP_LEN];
+    conn->transId = TbxMbCommonExtractUInt16BE(&aduPtr[0]);
+    /* Linked to a server channel? TCP/IP has no broadcast and the unit identifier is
+     * only meaningful to a gateway. A server therefore processes all requests.
+     */
+    if (tpCtx->isClient == TBX_FALSE)
+    {
+      /* Increment the total number of received packets that were addressed to us. */
+      tpCtx->diagInfo.srvMsgCnt++;
+      /* Packet is valid. Update the result accordingly. */
+      result = TBX_OK;
+    }
+    /* Linked to a client channel. */
+    else
+    {
+      /* Only process the response to the last request. A response to an earlier
+       * request, for example one that came in after its timeout, is discarded.
+       */
+      TbxCriticalSectionEnter();
+      uint16_t transIdCopy = tpCtx->tcpTransId;
+      TbxCriticalSectionExit();
+      if (conn->transId == transIdCopy)
+      {
+        /* Packet is valid. Update the result accordingly. */
+        result = TBX_OK;
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbTcpValidate ***/
+
+
+/************************************************************************************//**
+** \brief     Accepts new connection requests from clients, as long as the maximum
+**            number of connections is not yet reached.
+** \param     tpCtx Pointer to the TCP transport layer context.
+**
+****************************************************************************************/
+static void TbxMbTcpAccept(tTbxMbTpCtx * tpCtx)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(tpCtx != NULL);
+
+  /* Only continue with valid parameters. */
+  if (tpCtx != NULL)
+  {
+    /* Look for a free connection slot. */
+    for (uint8_t connIdx = 0U; connIdx < TBX_MB_TCP_CONN_MAX; connIdx++)
+    {
+      if (tpCtx->tcpConn[connIdx] == NULL)
+      {
+        /* Accept a pending connection request, if any. No need to look for more free
+         * slots, if there was no pending connection request.
+         */
+        tTbxMbTcpSock sock = TbxMbPortTcpServerAccept(tpCtx->tcpListenSock);
+        if (sock == NULL)
+        {
+          break;
+        }
+        /* Create a context for the new connection and store it in the free slot. */
+        tpCtx->tcpConn[connIdx] = TbxMbTcpConnCreate(sock);
+        /* Refuse the connection, if its context could not be created. */
+        if (tpCtx->tcpConn[connIdx] == NULL)
+        {
+          TbxMbPortTcpClose(sock);
+          break;
+        }
+        /* Give the connection a serial number, to distinguish it from earlier
+         * connections that used the same slot.
+         */
+        tpCtx->tcpConnSerial++;
+        tpCtx->tcpConn[connIdx]->serial = tpCtx->tcpConnSerial;
+      }
+    }
+  }
+} /*** end of TbxMbTcpAccept ***/
+
+
+/************************************************************************************//**
+** \brief     Reads newly received packet data from the connection. It reads no more
+**            data than needed to complete the packet. The MBAP header determines the
+**            packet length. Once the packet is complete and valid, it's marked as done,
+**            such that it can be passed on to the channel.
+** \param     tpCtx Pointer to the TCP transport layer context.
+** \param     connIdx Index of the connection in tcpConn[].
+**
+****************************************************************************************/
+static void TbxMbTcpReceive(tTbxMbTpCtx * tpCtx,
+                            uint8_t       connIdx)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((tpCtx != NULL) && (connIdx < TBX_MB_TCP_CONN_MAX));
+
+  /* Only continue with valid parameters. */
+  if ((tpCtx != NULL) && (connIdx < TBX_MB_TCP_CONN_MAX))
+  {
+    tTbxMbTcpConn * conn = tpCtx->tcpConn[connIdx];
+    /* The ADU for a TCP packet starts at the MBAP header, right in front of the PDU. */
+    uint8_t       * aduPtr = &conn->rxPacket.head[TBX_MB_TP_ADU_HEAD_LEN_MAX - 
+                                                  TBX_MB_TCP_MBAP_LEN];
+    uint8_t         keepReading = TBX_TRUE;
+    uint8_t         connLost = TBX_FALSE;
+
+    while (keepReading == TBX_TRUE)
+    {
+      /* Attempt to read the remaining bytes of the MBAP header or the PDU. */
+      uint16_t len = conn->rxAduLen - conn->rxAduWrIdx;
+      if (TbxMbPortTcpReceive(conn->sock, &aduPtr[conn->rxAduWrIdx], &len) != TBX_OK)
+      {
+        /* Connection was closed by the other side or broke. */
+        connLost = TBX_TRUE;
+        keepReading = TBX_FALSE;
+      }
+      /* No more data currently available? */
+      else if (len == 0U)
+      {
+        keepReading = TBX_FALSE;
+      }
+      /* Newly received data. */
+      else
+      {
+        conn->rxAduWrIdx += len;
+        conn->rxTime = TbxMbPortTimerCount();
+        /* Just completed the reception of the MBAP header? */
+        if (conn->rxAduWrIdx == TBX_MB_TCP_MBAP_LEN)
+        {
+          uint16_t protocolId = TbxMbCommonExtractUInt16BE(&aduPtr[2]);
+          uint16_t lenField = TbxMbCommonExtractUInt16BE(&aduPtr[4]);
+          /* Is the MBAP header invalid? */
+          if ((protocolId != TBX_MB_TCP_PROTOCOL_ID) ||
+              (lenField < TBX_MB_TCP_MBAP_LEN_FIELD_MIN) ||
+              (lenField > TBX_MB_TCP_MBAP_LEN_FIELD_MAX))
+          {
+            /* Increment the total number of corrupted packets. Not possible to resync
+             * to the start of the next packet, so drop the connection.
+             */
+            tpCtx->diagInfo.busCommErrCnt++;
+            connLost = TBX_TRUE;
+            keepReading = TBX_FALSE;
+          }
+          else
+          {
+            /* The length field counts the unit identifier, which is already received
+             * as part of the MBAP header.
+             */
+            conn->rxAduLen = (TBX_MB_TCP_MBAP_LEN - 1U) + lenField;
+          }
+        }
+        /* Just completed the reception of the entire packet? */
+        else if (conn->rxAduWrIdx == conn->rxAduLen)
+        {
+          keepReading = TBX_FALSE;
+          /* Set the PDU data length field. It's the total ADU length, minus the MBAP
+           * header and the function code. Also store the unit identifier in the
+           * packet's node element. That's were channels expect it.
+           */
+          conn->rxPacket.dataLen = (uint8_t)(conn->rxAduLen - TBX_MB_TCP_MBAP_LEN - 1U);
+          conn->rxPacket.node = aduPtr[6];
+          /* Validate the newly received packet. */
+          if (TbxMbTcpValidate(tpCtx, conn) != TBX_OK)
+          {
+            /* Discard the newly received packet. */
+            conn->rxAduWrIdx = 0U;
+            conn->rxAduLen = TBX_MB_TCP_MBAP_LEN;
+          }
+          /* Newly received packet is valid. */
+          else
+          {
+            /* Lock the reception path of the connection, until the channel is done
+             * processing the packet.
+             */
+            TbxCriticalSectionEnter();
+            conn->rxAduDone = TBX_TRUE;
+            TbxCriticalSectionExit();
+          }
+        }
+        else
+        {
+          /* Packet not yet complete. Continue reading. */
+        }
+      }
+    }
+    /* Still waiting for the remainder of a partially received packet? */
+    if ((connLost == TBX_FALSE) && (conn->rxAduWrIdx > 0U) && 
+        (conn->rxAduDone == TBX_FALSE))
+    {
+      /* Calculate the number of time ticks that elapsed since the reception of the
+       * last data. Note that this calculation works, even if the timer counter
+       * overflowed.
+       */
+      uint16_t deltaTicks = TbxMbPortTimerCount() - conn->rxTime;
+      /* Did the remainder of the packet not arrive in time? */
+      if (deltaTicks >= (uint16_t)(TBX_MB_TCP_RX_TIMEOUT_MS * 20U))
+      {
+        /* Increment the total number of corrupted packets. Not possible to resync to
+         * the start of the next packet, so drop the connection.
+         */
+        tpCtx->diagInfo.busCommErrCnt++;
+        connLost = TBX_TRUE;
+      }
+    }
+    /* Handle the loss of the connection. */
+    if (connLost == TBX_TRUE)
+    {
+      TbxMbTcpConnLost(tpCtx, connIdx);
+    }
+  }
+} /*** end of TbxMbTcpReceive ***/
+
+
+/************************************************************************************//**
+** \brief     Passes the next complete packet on to the channel, as long as the channel
+**            is not still processing a packet. The connections are served in turn,
+**            starting with the one after the connection of the last packet. This way
+**            one connection cannot starve the others.
+** \param     tpCtx Pointer to the TCP transport layer context.
+**
+****************************************************************************************/
+static void TbxMbTcpDispatch(tTbxMbTpCtx * tpCtx)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(tpCtx != NULL);
+
+  /* Only continue with valid parameters. */
+  if (tpCtx != NULL)
+  {
+    TbxCriticalSectionEnter();
+    uint8_t currentState = tpCtx->state;
+    TbxCriticalSectionExit();
+    /* Only continue if the channel currently has no access to a reception packet. */
+    if (currentState == TBX_MB_TCP_STATE_IDLE)
+    {
+      for (uint8_t idx = 0U; idx < TBX_MB_TCP_CONN_MAX; idx++)
+      {
+        uint8_t connIdx = (uint8_t)((tpCtx->tcpRxConn + 1U + idx) % TBX_MB_TCP_CONN_MAX);
+        tTbxMbTcpConn * conn = tpCtx->tcpConn[connIdx];
+        uint8_t rxAduDoneCopy = TBX_FALSE;
+        if (conn != NULL)
+        {
+          TbxCriticalSectionEnter();
+          rxAduDoneCopy = conn->rxAduDone;
+          TbxCriticalSectionExit();
+        }
+        /* Does this connection hold a complete packet? */
+        if (rxAduDoneCopy == TBX_TRUE)
+        {
+          /* Set the unit identifier in the txPacket node element, for a server. It's
+           * echoed in the response. No need for a critical section, because on a server
+           * only the event task accesses the txPacket.
+           */
+          if (tpCtx->isClient == TBX_FALSE)
+          {
+            tpCtx->txPacket->node = conn->rxPacket.node;
+          }
+          /* Transition to the VALIDATION state, which gives the channel access to the
+           * reception packet of this connection.
+           */
+          TbxCriticalSectionEnter();
+          tpCtx->tcpRxConn = connIdx;
+          tpCtx->state = TBX_MB_TCP_STATE_VALIDATION;
+          TbxCriticalSectionExit();
+#if (TBX_MB_TRACE_ENABLE > 0U)
+          /* Timestamp the reception end of the packet. */
+          TbxMbTraceMark(tpCtx, TBX_MB_TRACE_POINT_RX_END);
+#endif
+          /* Post an event to the linked channel for further processing of the PDU. */
+          tTbxMbEvent pduRxEvent;
+          pduRxEvent.context = tpCtx->channelCtx;
+          pduRxEvent.id = TBX_MB_EVENT_ID_PDU_RECEIVED;
+          TbxMbOsalEventPost(&pduRxEvent, TBX_FALSE);
+          break;
+        }
+      }
+    }
+  }
+} /*** end of TbxMbTcpDispatch ***/
+
+
+/************************************************************************************//**
+** \brief     Handles the situation where a connection got closed by the other side,
+**            broke, or needs to be dropped, because of a protocol error. A partially
+**            received packet is discarded.
+** \param     tpCtx Pointer to the TCP transport layer context.
+** \param     connIdx Index of the connection in tcpConn[].
+**
+****************************************************************************************/
+static void TbxMbTcpConnLost(tTbxMbTpCtx * tpCtx,
+                             uint8_t       connIdx)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((tpCtx != NULL) && (connIdx < TBX_MB_TCP_CONN_MAX));
+
+  /* Only continue with valid parameters. */
+  if ((tpCtx != NULL) && (connIdx < TBX_MB_TCP_CONN_MAX))
+  {
+    tTbxMbTcpConn * conn = tpCtx->tcpConn[connIdx];
+    /* A server closes the connection right away, which frees up its slot for a new
+     * connection.
+     */
+    if (tpCtx->isClient == TBX_FALSE)
+    {
+      TbxMbPortTcpClose(conn->sock);
+      TbxMbTcpConnFree(conn);
+      tpCtx->tcpConn[connIdx] = NULL;
+    }
+    /* A client leaves it to the transmit function to close the connection and to
+     * reconnect. It can be called from a different task.
+     */
+    else
+    {
+      TbxCriticalSectionEnter();
+      conn->rxAduWrIdx = 0U;
+      conn->rxAduLen = TBX_MB_TCP_MBAP_LEN;
+      conn->lost = TBX_TRUE;
+      TbxCriticalSectionExit();
+    }
+  }
+} /*** end of TbxMbTcpConnLost ***/
+
+
+/************************************************************************************//**
+** \brief     Creates a new connection context.
+** \param     sock Handle to the socket of the connection.
+** \return    Pointer to the newly created connection context if successful, NULL
+**            otherwise.
+**
+****************************************************************************************/
+static tTbxMbTcpConn * TbxMbTcpConnCreate(tTbxMbTcpSock sock)
+{
+  /* Allocate memory for the new connection context. */
+  tTbxMbTcpConn * result = TbxMemPoolAllocate(sizeof(tTbxMbTcpConn));
+  /* Automatically increase the memory pool, if it was too small. */
+  if (result == NULL)
+  {
+    /* No need to check the return value, because if it failed, the following
+     * allocation fails too, which is verified later on.
+     */
+    (void)TbxMemPoolCreate(1U, sizeof(tTbxMbTcpConn));
+    result = TbxMemPoolAllocate(sizeof(tTbxMbTcpConn));
+  }
+  /* Verify memory allocation of the connection context. */
+  TBX_ASSERT(result != NULL);
+  /* Only continue if the memory allocation succeeded. */
+  if (result != NULL)
+  {
+    /* Initialize the connection context. */
+    result->sock = sock;
+    result->rxTime = TbxMbPortTimerCount();
+    result->rxAduWrIdx = 0U;
+    result->rxAduLen = TBX_MB_TCP_MBAP_LEN;
+    result->transId = 0U;
+    result->serial = 0U;
+    result->rxAduDone = TBX_FALSE;
+    result->lost = TBX_FALSE;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbTcpConnCreate ***/
+
+
+/************************************************************************************//**
+** \brief     Releases a connection context, previously created with 
+**            TbxMbTcpConnCreate(). Note that it does not close the socket.
+** \param     conn Pointer to the connection context to release.
+**
+****************************************************************************************/
+static void TbxMbTcpConnFree(tTbxMbTcpConn * conn)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(conn != NULL);
+
+  /* Only continue with valid parameters. */
+  if (conn != NULL)
+  {
+    /* Give the connection context back to the memory pool. */
+    TbxMemPoolRelease(conn);
+  }
+} /*** end of TbxMbTcpConnFree ***/
+
+
+/*********************************** end of tbxmb_tcp.c ********************************/
@@ -0,0 +1,59 @@
+/************************************************************************************//**
+* \file         tbxmb_tcp.h
+* \brief        Modbus TCP transport layer header file.
+* \internal
+*----------------------------------------------------------------------------------------
+*                          C O P Y R I G H T
+*----------------------------------------------------------------------------------------
+*   Copyright (c) 2023 by Feaser     www.feaser.com     All rights reserved
+*
+*----------------------------------------------------------------------------------------
+*                            L I C E N S E
+*----------------------------------------------------------------------------------------
+*
+* SPDX-License-Identifier: GPL-3.0-or-later
+*
+* This file is part of MicroTBX-Modbus. MicroTBX-Modbus is free software: you can
+* redistribute it and/or modify it under the terms of the GNU General Public License as
+* published by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* MicroTBX-Modbus is distributed in the hope that it will be useful, but WITHOUT ANY
+* WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+* PARTICULAR PURPOSE. See the GNU General Public License for more details.
+*
+* You have received a copy of the GNU General Public License along with MicroTBX-Modbus.
+* If not, see www.gnu.org/licenses/.
+*
+* \endinternal
+****************************************************************************************/
+#ifndef TBXMB_TCP_H
+#define TBXMB_TCP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************************
+* Type definitions
+****************************************************************************************/
+/** \brief Handle to a TCP/IP socket, in the format of an opaque pointer. The actual
+ *         meaning of the socket is TCP/IP stack dependent and left to the port.
+ */
+typedef void * tTbxMbTcpSock;
+
+
+/****************************************************************************************
+* Function prototypes
+****************************************************************************************/
+tTbxMbTp TbxMbTcpCreate(char     const * ipAddress,
+                        uint16_t         port);
+
+void     TbxMbTcpFree  (tTbxMbTp         transport);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TBXMB_TCP_H */
+/*********************************** end of tbxmb_tcp.h ********************************/
@@ -0,0 +1,67 @@
+/************************************************************************************//**
+* \file         tbxmb_tcp_private.h
+* \brief        Modbus TCP transport layer private header file.
+* \internal
+*----------------------------------------------------------------------------------------
+*                          C O P Y R I G H T
+*----------------------------------------------------------------------------------------
+*   Copyright (c) 2023 by Feaser     www.feaser.com     All rights reserved
+*
+*----------------------------------------------------------------------------------------
+*                            L I C E N S E
+*----------------------------------------------------------------------------------------
+*
+* SPDX-License-Identifier: GPL-3.0-or-later
+*
+* This file is part of MicroTBX-Modbus. MicroTBX-Modbus is free software: you can
+* redistribute it and/or modify it under the terms of the GNU General Public License as
+* published by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* MicroTBX-Modbus is distributed in the hope that it will be useful, but WITHOUT ANY
+* WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+* PARTICULAR PURPOSE. See the GNU General Public License for more details.
+*
+* You have received a copy of the GNU General Public License along with MicroTBX-Modbus.
+* If not, see www.gnu.org/licenses/.
+*
+* \endinternal
+****************************************************************************************/
+#ifndef TBXMB_TCP_PRIVATE_H
+#define TBXMB_TCP_PRIVATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************************
+* Type definitions
+****************************************************************************************/
+/** \brief Information for transmitting a response to a request, that a TCP server
+ *         received earlier on.
+ */
+typedef struct
+{
+  uint8_t              connIdx;                  /**< Connection slot index.           */
+  uint8_t              node;                     /**< Unit identifier of the request.  */
+  uint16_t             connSerial;               /**< Connection serial number.        */
+  uint16_t             transId;                  /**< Request transaction ID.          */
+} tTbxMbTcpReplyTo;
+
+
+/****************************************************************************************
+* Function prototypes
+****************************************************************************************/
+uint8_t TbxMbTcpGetReplyTo   (tTbxMbTp                 transport,
+                              tTbxMbTcpReplyTo       * replyTo);
+
+uint8_t TbxMbTcpTransmitReply(tTbxMbTp                 transport,
+                              tTbxMbTcpReplyTo const * replyTo);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TBXMB_TCP_PRIVATE_H */
+/*********************************** end of tbxmb_tcp_private.h *************************/
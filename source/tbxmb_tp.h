@@ -66,6 +66,19 @@ extern "C" {
 typedef void * tTbxMbTp;
 
 
+/** \brief Caller provided storage for a transport layer object with separate reception
+ *         and transmit packet buffers. Include tbxmb_storage.h to be able to allocate it.
+ */
+typedef struct tTbxMbTpStorageTag tTbxMbTpStorage;
+
+
+/** \brief Caller provided storage for a server transport layer object that shares one
+ *         packet buffer for reception and transmission. Include tbxmb_storage.h to be
+ *         able to allocate it.
+ */
+typedef struct tTbxMbTpCompactStorageTag tTbxMbTpCompactStorage;
+
+
 #ifdef __cplusplus
 }
 #endif
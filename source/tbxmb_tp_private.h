@@ -54,6 +54,84 @@ extern "C" {
                                         TBX_MB_TP_PDU_MAX_LEN + \
                                         TBX_MB_TP_ADU_TAIL_LEN_MAX)
 
+/** \brief Size of the buffer for the characters that the ASCII transport layer
+ *         transmits. An ASCII packet needs about twice as many characters as its ADU
+ *         has bytes. To keep RAM requirements low, the ADU is encoded and transmitted
+ *         in parts that fit in this buffer.
+ */
+#define TBX_MB_TP_ASCII_TX_BUF_LEN     (64U)
+
+#ifndef TBX_MB_TCP_CONN_MAX
+/** \brief Maximum number of client connections that a Modbus TCP server accepts at the
+ *         same time. Each connection needs one socket of your TCP/IP stack and a
+ *         connection context with its own reception packet buffer. Note that
+ *         a Modbus TCP client always uses just one connection. To override this default
+ *         configuration, you can add a macro with the same name, but with a different
+ *         value, to "tbx_conf.h".
+ */
+#define TBX_MB_TCP_CONN_MAX            (4U)
+#endif
+
+#ifndef TBX_MB_TRACE_ENABLE
+/** \brief Configure the tracing of the packet processing latency per transport layer.
+ *         It timestamps the key points of the packet processing, with the 50 us
+ *         resolution of TbxMbPortTimerCount(), and aggregates the latencies of the
+ *         segments in between. The default value of 0 disables the tracing. To override
+ *         this default configuration, you can add a macro with the same name, but with
+ *         a value of 1 (enable), to "tbx_conf.h".
+ */
+#define TBX_MB_TRACE_ENABLE            (0U)
+#endif
+
+#ifndef TBX_MB_TRACE_CODE_MAX
+/** \brief Configure the number of function codes per transport layer, for which the
+ *         server turnaround latency is traced separately. To override this default
+ *         configuration, you can add a macro with the same name, but with a different
+ *         value, to "tbx_conf.h".
+ */
+#define TBX_MB_TRACE_CODE_MAX          (8U)
+#endif
+
+#ifndef TBX_MB_TRACE_HIST_BINS
+/** \brief Configure the number of bins in the histogram of the server turnaround
+ *         latency. The last bin counts all latencies that don't fit in the other bins.
+ *         To override this default configuration, you can add a macro with the same
+ *         name, but with a different value, to "tbx_conf.h".
+ */
+#define TBX_MB_TRACE_HIST_BINS         (10U)
+#endif
+
+#ifndef TBX_MB_TRACE_HIST_BIN_US
+/** \brief Configure the width of each bin in the histogram of the server turnaround
+ *         latency, in microseconds. Must be a multiple of 50. To override this default
+ *         configuration, you can add a macro with the same name, but with a different
+ *         value, to "tbx_conf.h".
+ */
+#define TBX_MB_TRACE_HIST_BIN_US       (500U)
+#endif
+
+/* Trace points of the packet processing. */
+/** \brief First byte of a packet received. */
+#define TBX_MB_TRACE_POINT_RX_START    (0U)
+
+/** \brief End of a valid packet detected. */
+#define TBX_MB_TRACE_POINT_RX_END      (1U)
+
+/** \brief Channel started processing the received packet. */
+#define TBX_MB_TRACE_POINT_DISPATCH    (2U)
+
+/** \brief Channel completed processing the received packet. */
+#define TBX_MB_TRACE_POINT_PROCESSED   (3U)
+
+/** \brief Packet transmission started. */
+#define TBX_MB_TRACE_POINT_TX_START    (4U)
+
+/** \brief Packet transmission completed. */
+#define TBX_MB_TRACE_POINT_TX_DONE     (5U)
+
+/** \brief Number of trace points. */
+#define TBX_MB_TRACE_NUM_POINT         (6U)
+
 
 /****************************************************************************************
 * Type definitions
@@ -93,6 +171,38 @@ typedef struct
 } tTbxMbTpDiagInfo;
 
 
+#if (TBX_MB_TRACE_ENABLE > 0U)
+/** \brief Aggregated latency of a traced segment, in 50 us timer ticks. */
+typedef struct
+{
+  uint32_t    count;                                   /**< Number of measurements.    */
+  uint32_t    sumTicks;                                /**< Sum of all latencies.      */
+  uint16_t    minTicks;                                /**< Minimum latency.           */
+  uint16_t    maxTicks;                                /**< Maximum latency.           */
+} tTbxMbTraceData;
+
+
+/** \brief Aggregated server turnaround latency of a function code. */
+typedef struct
+{
+  uint8_t         code;                                /**< Function code.             */
+  tTbxMbTraceData data;                                /**< Turnaround latency.        */
+} tTbxMbTraceCode;
+
+
+/** \brief Type for grouping all latency tracing related information together. */
+typedef struct
+{
+  uint16_t        stamp[TBX_MB_TRACE_NUM_POINT];       /**< Trace point timestamps.    */
+  uint8_t         valid;                               /**< Valid timestamps bit mask. */
+  tTbxMbTraceData seg[TBX_MB_TRACE_NUM_SEG];           /**< Latency per segment.       */
+  tTbxMbTraceCode code[TBX_MB_TRACE_CODE_MAX];         /**< Latency per function code. */
+  uint8_t         codeCount;                           /**< Number of traced codes.    */
+  uint32_t        hist[TBX_MB_TRACE_HIST_BINS];        /**< Turnaround histogram.      */
+} tTbxMbTraceInfo;
+#endif
+
+
 /** \brief Transport layer interface function to detect events in a polling manner. */
 typedef void (* tTbxMbTpPoll)                   (void        * context);
 
@@ -132,6 +242,24 @@ typedef tTbxMbTpPacket * (* tTbxMbTpGetRxPacket)(tTbxMbTp      transport);
 typedef tTbxMbTpPacket * (* tTbxMbTpGetTxPacket)(tTbxMbTp      transport);
 
 
+/** \brief Type for grouping all information of a Modbus TCP connection together. Each
+ *         connection has its own reception packet buffer. This way packets can be
+ *         received on all connections at the same time.
+ */
+typedef struct
+{
+  tTbxMbTcpSock           sock;                  /**< Connection socket.               */
+  tTbxMbTpPacket          rxPacket;              /**< Reception packet buffer.         */
+  uint16_t                rxTime;                /**< Last Rx data timestamp.          */
+  uint16_t                rxAduWrIdx;            /**< ADU Rx packet write index.       */
+  uint16_t                rxAduLen;              /**< Expected ADU Rx packet length.   */
+  uint16_t                transId;               /**< Rx packet transaction ID.        */
+  uint16_t                serial;                /**< Connection serial number.        */
+  uint8_t                 rxAduDone;             /**< ADU Rx packet complete flag.     */
+  uint8_t                 lost;                  /**< Connection lost (client only).   */
+} tTbxMbTcpConn;
+
+
 /** \brief   Modbus transport layer context that groups all transport layer specific
  *           data. It's what the tTbxMbTransport opaque pointer points to.
  *  \details For both simplicity and run-time efficiency, this type packs information for
@@ -148,31 +276,52 @@ typedef tTbxMbTpPacket * (* tTbxMbTpGetTxPacket)(tTbxMbTp      transport);
  */
 typedef struct
 {
-  /* Event interface methods. The following three entries must always be at the start
+  /* Event interface methods. The following four entries must always be at the start
    * and exactly match those in tTbxMbEventCtx. Think of it as the base that this struct
    * derives from. 
    */
   void                  * instancePtr;           /**< Reserved for C++ wrapper.        */
   tTbxMbTpPoll            pollFcn;               /**< Event poll function.             */
   tTbxMbTpProcess         processFcn;            /**< Event process function.          */
+  tTbxMbEventPoller       pollInfo;              /**< Event poller information.        */
   /* Private members. */
   uint8_t                 type;                  /**< Context type.                    */
   uint8_t                 nodeAddr;              /**< Node address (RTU/ASCII only).   */
   tTbxMbUartPort          port;                  /**< UART port (RTU/ASCII only)     . */
-  tTbxMbTpPacket          txPacket;              /**< Transmit packet buffer.          */
+  tTbxMbTpPacket        * txPacket;              /**< Transmit packet buffer.          */
   uint16_t                txDoneTime;            /**< Tx packet done timestamp.        */
-  tTbxMbTpPacket          rxPacket;              /**< Reception packet buffer.         */
+  uint8_t                 txPending;             /**< Deferred Tx start flag (RTU).    */
+  tTbxMbTpPacket        * rxPacket;              /**< Reception packet buffer.         */
   uint16_t                rxTime;                /**< Last Rx byte timestamp.          */
   uint16_t                rxAduWrIdx;            /**< ADU Rx packet write index.       */
   uint8_t                 rxAduOkay;             /**< ADU Rx packet OK/NOK flag.       */
+  uint8_t                 rxAduDone;             /**< ADU Rx packet complete flag.     */
+  uint16_t                rxAduLen;              /**< Expected ADU Rx packet length.   */
+  uint16_t                rxCrc;                 /**< ADU Rx packet running CRC/LRC.   */
   uint16_t                t1_5Ticks;             /**< 1.5 character time in 50us ticks.*/
   uint16_t                t3_5Ticks;             /**< 3.5 character time in 50us ticks.*/
+  uint16_t                t3_5TimerTicks;        /**< 3.5 char. time in one-shot ticks.*/
   uint8_t                 state;                 /**< Communication state.             */
   uint8_t                 isClient;              /**< Info about the channel context.  */
+  uint8_t                 isMonitor;             /**< Passive bus monitor flag.        */
+  uint8_t                 isStatic;              /**< Caller provided storage flag.    */
   tTbxMbOsalSem           initStateExitSem;      /**< Exit INIT state semaphore.       */
+  uint8_t                 asciiTxBuf[TBX_MB_TP_ASCII_TX_BUF_LEN]; /**< ASCII Tx chars. */
+  uint16_t                asciiTxIdx;            /**< Next Tx ADU byte (ASCII only).   */
+  char            const * tcpIpAddress;          /**< Server IP address (TCP client).  */
+  uint16_t                tcpPort;               /**< TCP port number (TCP only).      */
+  uint16_t                tcpTransId;            /**< MBAP transaction ID (TCP only).  */
+  uint16_t                tcpConnSerial;         /**< Last connection serial (TCP).    */
+  tTbxMbTcpSock           tcpListenSock;         /**< Listen socket (TCP server).      */
+  tTbxMbTcpConn         * tcpConn[TBX_MB_TCP_CONN_MAX]; /**< Connections (TCP only).  */
+  uint8_t                 tcpRxConn;             /**< Rx packet connection (TCP only). */
+  uint8_t                 tcpTxConn;             /**< Tx packet connection (TCP only). */
   /* Public methods and members. */
   void                  * channelCtx;            /**< Assigned channel context.        */
   tTbxMbTpDiagInfo        diagInfo;              /**< Diagnostics information.         */ 
+#if (TBX_MB_TRACE_ENABLE > 0U)
+  tTbxMbTraceInfo         trace;                 /**< Latency tracing information.     */
+#endif
   tTbxMbTpTransmit        transmitFcn;           /**< Packet transmit function.        */
   tTbxMbTpReceptionDone   receptionDoneFcn;      /**< Rx packet processing done fcn.   */
   tTbxMbTpGetRxPacket     getRxPacketFcn;        /**< Obtain Rx packet access function.*/
@@ -180,6 +329,42 @@ typedef struct
 } tTbxMbTpCtx;
 
 
+/** \brief   Transport layer storage with separate reception and transmit packet buffers.
+ *  \details The transport layer create functions allocate this storage from a memory
+ *           pool. The static create functions use the storage that the caller provides.
+ */
+struct tTbxMbTpStorageTag
+{
+  tTbxMbTpCtx             ctx;                   /**< Transport layer context.         */
+  tTbxMbTpPacket          txPacket;              /**< Transmit packet buffer.          */
+  tTbxMbTpPacket          rxPacket;              /**< Reception packet buffer.         */
+};
+
+
+/** \brief   Transport layer storage with one packet buffer that is shared for reception
+ *           and transmission. Only suitable for a server channel or bus monitor, because
+ *           those only build a response after the reception of a request is done.
+ */
+struct tTbxMbTpCompactStorageTag
+{
+  tTbxMbTpCtx             ctx;                   /**< Transport layer context.         */
+  tTbxMbTpPacket          packet;                /**< Shared Rx/Tx packet buffer.      */
+};
+
+
+/****************************************************************************************
+* Function prototypes
+****************************************************************************************/
+#if (TBX_MB_TRACE_ENABLE > 0U)
+void TbxMbTraceMark(tTbxMbTpCtx volatile * tpCtx,
+                    uint8_t                point);
+#endif
+
+uint16_t TbxMbRtuCrcUpdate(uint16_t               crc,
+                           uint8_t        const * data,
+                           uint16_t               len);
+
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,444 @@
+/************************************************************************************//**
+* \file         tbxmb_trace.c
+* \brief        Modbus packet processing latency tracing source file.
+* \internal
+*----------------------------------------------------------------------------------------
+*                          C O P Y R I G H T
+*----------------------------------------------------------------------------------------
+*   Copyright (c) 2023 by Feaser     www.feaser.com     All rights reserved
+*
+*----------------------------------------------------------------------------------------
+*                            L I C E N S E
+*----------------------------------------------------------------------------------------
+*
+* SPDX-License-Identifier: GPL-3.0-or-later
+*
+* This file is part of MicroTBX-Modbus. MicroTBX-Modbus is free software: you can
+* redistribute it and/or modify it under the terms of the GNU General Public License as
+* published by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* MicroTBX-Modbus is distributed in the hope that it will be useful, but WITHOUT ANY
+* WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+* PARTICULAR PURPOSE. See the GNU General Public License for more details.
+*
+* You have received a copy of the GNU General Public License along with MicroTBX-Modbus.
+* If not, see www.gnu.org/licenses/.
+*
+* \endinternal
+****************************************************************************************/
+
+/****************************************************************************************
+* Include files
+****************************************************************************************/
+#include "microtbx.h"                            /* MicroTBX module                    */
+#include "microtbxmodbus.h"                      /* MicroTBX-Modbus module             */
+#include "tbxmb_event_private.h"                 /* MicroTBX-Modbus event private      */
+#include "tbxmb_osal_private.h"                  /* MicroTBX-Modbus OSAL private       */
+#include "tbxmb_tp_private.h"                    /* MicroTBX-Modbus TP private         */
+
+
+/****************************************************************************************
+* Macro definitions
+****************************************************************************************/
+/** \brief Width of each histogram bin in 50 us timer ticks. */
+#define TBX_MB_TRACE_HIST_BIN_TICKS    (TBX_MB_TRACE_HIST_BIN_US / 50U)
+
+/** \brief Duration of one 50 us timer tick in microseconds. */
+#define TBX_MB_TRACE_TICK_US           (50U)
+
+
+/****************************************************************************************
+* Configuration check
+****************************************************************************************/
+#if (TBX_MB_TRACE_CODE_MAX < 1U) || (TBX_MB_TRACE_CODE_MAX > 127U)
+#error "TBX_MB_TRACE_CODE_MAX must be in the range 1..127"
+#endif
+
+#if (TBX_MB_TRACE_HIST_BINS < 1U) || (TBX_MB_TRACE_HIST_BINS > 255U)
+#error "TBX_MB_TRACE_HIST_BINS must be in the range 1..255"
+#endif
+
+#if (TBX_MB_TRACE_HIST_BIN_US < 50U) || ((TBX_MB_TRACE_HIST_BIN_US % 50U) != 0U)
+#error "TBX_MB_TRACE_HIST_BIN_US must be a multiple of 50"
+#endif
+
+
+#if (TBX_MB_TRACE_ENABLE > 0U)
+/****************************************************************************************
+* Function prototypes
+****************************************************************************************/
+static void TbxMbTraceUpdate (tTbxMbTraceData volatile * data,
+                              uint16_t                   ticks);
+
+static void TbxMbTraceConvert(tTbxMbTraceData    const * data,
+                              tTbxMbTraceStats         * stats);
+
+
+/****************************************************************************************
+* Local constant declarations
+****************************************************************************************/
+/** \brief Trace point at which each segment starts. */
+static const uint8_t tbxMbTraceSegStart[TBX_MB_TRACE_NUM_SEG] =
+{
+  TBX_MB_TRACE_POINT_RX_START,                   /* TBX_MB_TRACE_SEG_RECEPTION         */
+  TBX_MB_TRACE_POINT_RX_END,                     /* TBX_MB_TRACE_SEG_DISPATCH          */
+  TBX_MB_TRACE_POINT_DISPATCH,                   /* TBX_MB_TRACE_SEG_PROCESSING        */
+  TBX_MB_TRACE_POINT_PROCESSED,                  /* TBX_MB_TRACE_SEG_TX_START          */
+  TBX_MB_TRACE_POINT_TX_START,                   /* TBX_MB_TRACE_SEG_TRANSMISSION      */
+  TBX_MB_TRACE_POINT_RX_END                      /* TBX_MB_TRACE_SEG_TURNAROUND        */
+};
+
+
+/** \brief Trace point at which each segment ends. */
+static const uint8_t tbxMbTraceSegEnd[TBX_MB_TRACE_NUM_SEG] =
+{
+  TBX_MB_TRACE_POINT_RX_END,                     /* TBX_MB_TRACE_SEG_RECEPTION         */
+  TBX_MB_TRACE_POINT_DISPATCH,                   /* TBX_MB_TRACE_SEG_DISPATCH          */
+  TBX_MB_TRACE_POINT_PROCESSED,                  /* TBX_MB_TRACE_SEG_PROCESSING        */
+  TBX_MB_TRACE_POINT_TX_START,                   /* TBX_MB_TRACE_SEG_TX_START          */
+  TBX_MB_TRACE_POINT_TX_DONE,                    /* TBX_MB_TRACE_SEG_TRANSMISSION      */
+  TBX_MB_TRACE_POINT_TX_START                    /* TBX_MB_TRACE_SEG_TURNAROUND        */
+};
+#endif
+
+
+/************************************************************************************//**
+** \brief     Obtains the latency statistics of a traced segment of the packet
+**            processing on the specified transport layer. Only available if the
+**            configuration macro TBX_MB_TRACE_ENABLE is set to a value > 0.
+** \param     transport Handle to the transport layer object.
+** \param     segment The traced segment.
+** \param     stats Pointer to where the statistics are written to.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbTraceGetStats(tTbxMbTp             transport,
+                           tTbxMbTraceSegment   segment,
+                           tTbxMbTraceStats   * stats)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify parameters. */
+  TBX_ASSERT((transport != NULL) && (segment < TBX_MB_TRACE_NUM_SEG) &&
+             (stats != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((transport != NULL) && (segment < TBX_MB_TRACE_NUM_SEG) && (stats != NULL))
+  {
+#if (TBX_MB_TRACE_ENABLE > 0U)
+    /* Convert the TP channel pointer to the context structure. */
+    tTbxMbTpCtx * tpCtx = (tTbxMbTpCtx *)transport;
+    /* Copy the aggregated latency of the segment. */
+    TbxCriticalSectionEnter();
+    tTbxMbTraceData dataCopy = tpCtx->trace.seg[segment];
+    TbxCriticalSectionExit();
+    /* Convert it to the statistics. */
+    TbxMbTraceConvert(&dataCopy, stats);
+    result = TBX_OK;
+#endif
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbTraceGetStats ***/
+
+
+/************************************************************************************//**
+** \brief     Obtains the statistics of the server turnaround latency for the specified
+**            function code on the specified transport layer. The turnaround latency of
+**            up to TBX_MB_TRACE_CODE_MAX different function codes is traced. Only
+**            available if the configuration macro TBX_MB_TRACE_ENABLE is set to a
+**            value > 0.
+** \param     transport Handle to the transport layer object.
+** \param     code The function code.
+** \param     stats Pointer to where the statistics are written to.
+** \return    TBX_OK if successful, TBX_ERROR if the function code is not traced.
+**
+****************************************************************************************/
+uint8_t TbxMbTraceGetCodeStats(tTbxMbTp             transport,
+                               uint8_t              code,
+                               tTbxMbTraceStats   * stats)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify parameters. */
+  TBX_ASSERT((transport != NULL) && (stats != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((transport != NULL) && (stats != NULL))
+  {
+#if (TBX_MB_TRACE_ENABLE > 0U)
+    /* Convert the TP channel pointer to the context structure. */
+    tTbxMbTpCtx * tpCtx = (tTbxMbTpCtx *)transport;
+    tTbxMbTraceData dataCopy = { 0 };
+    /* Look up the function code and copy its aggregated turnaround latency. */
+    TbxCriticalSectionEnter();
+    for (uint8_t idx = 0U; idx < tpCtx->trace.codeCount; idx++)
+    {
+      if (tpCtx->trace.code[idx].code == code)
+      {
+        dataCopy = tpCtx->trace.code[idx].data;
+        result = TBX_OK;
+        break;
+      }
+    }
+    TbxCriticalSectionExit();
+    /* Convert it to the statistics, if found. */
+    if (result == TBX_OK)
+    {
+      TbxMbTraceConvert(&dataCopy, stats);
+    }
+#else
+    TBX_UNUSED_ARG(code);
+#endif
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbTraceGetCodeStats ***/
+
+
+/************************************************************************************//**
+** \brief     Obtains the histogram of the server turnaround latency on the specified
+**            transport layer. Each bin holds the number of measurements of which the
+**            latency falls in its TBX_MB_TRACE_HIST_BIN_US wide range. The last bin
+**            also counts all larger latencies. Only available if the configuration macro
+**            TBX_MB_TRACE_ENABLE is set to a value > 0.
+** \param     transport Handle to the transport layer object.
+** \param     bins Pointer to array where the bins are written to.
+** \param     num Number of elements in the array. At most TBX_MB_TRACE_HIST_BINS are
+**            written.
+** \return    Number of bins written to the array.
+**
+****************************************************************************************/
+uint8_t TbxMbTraceGetHistogram(tTbxMbTp             transport,
+                               uint32_t           * bins,
+                               uint8_t              num)
+{
+  uint8_t result = 0U;
+
+  /* Verify parameters. */
+  TBX_ASSERT((transport != NULL) && (bins != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((transport != NULL) && (bins != NULL))
+  {
+#if (TBX_MB_TRACE_ENABLE > 0U)
+    /* Convert the TP channel pointer to the context structure. */
+    tTbxMbTpCtx * tpCtx = (tTbxMbTpCtx *)transport;
+    /* Determine the number of bins to copy. */
+    result = (num < TBX_MB_TRACE_HIST_BINS) ? num : (uint8_t)TBX_MB_TRACE_HIST_BINS;
+    /* Copy the bins. */
+    TbxCriticalSectionEnter();
+    for (uint8_t idx = 0U; idx < result; idx++)
+    {
+      bins[idx] = tpCtx->trace.hist[idx];
+    }
+    TbxCriticalSectionExit();
+#else
+    TBX_UNUSED_ARG(num);
+#endif
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbTraceGetHistogram ***/
+
+
+/************************************************************************************//**
+** \brief     Resets the traced latencies of the packet processing on the specified
+**            transport layer. Only available if the configuration macro
+**            TBX_MB_TRACE_ENABLE is set to a value > 0.
+** \param     transport Handle to the transport layer object.
+**
+****************************************************************************************/
+void TbxMbTraceReset(tTbxMbTp transport)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(transport != NULL);
+
+  /* Only continue with valid parameters. */
+  if (transport != NULL)
+  {
+#if (TBX_MB_TRACE_ENABLE > 0U)
+    /* Convert the TP channel pointer to the context structure. */
+    tTbxMbTpCtx * tpCtx = (tTbxMbTpCtx *)transport;
+    const tTbxMbTraceData emptyData = { 0 };
+    TbxCriticalSectionEnter();
+    /* Invalidate the timestamps of the trace in progress, if any. */
+    tpCtx->trace.valid = 0U;
+    /* Reset the aggregated latencies. */
+    for (uint8_t idx = 0U; idx < (uint8_t)TBX_MB_TRACE_NUM_SEG; idx++)
+    {
+      tpCtx->trace.seg[idx] = emptyData;
+    }
+    tpCtx->trace.codeCount = 0U;
+    for (uint8_t idx = 0U; idx < TBX_MB_TRACE_HIST_BINS; idx++)
+    {
+      tpCtx->trace.hist[idx] = 0U;
+    }
+    TbxCriticalSectionExit();
+#endif
+  }
+} /*** end of TbxMbTraceReset ***/
+
+
+#if (TBX_MB_TRACE_ENABLE > 0U)
+/************************************************************************************//**
+** \brief     Timestamps a trace point of the packet processing on the transport layer.
+**            It updates the aggregated latency of each segment that ends at this trace
+**            point. Can be called from an interrupt.
+** \details   A new trace starts when the first byte of a packet is received and ends
+**            when the transmission of a packet completed. The server turnaround is only
+**            traced if the channel dispatched a received packet. This way a client's
+**            time between a response and its next request isn't mistaken for it.
+** \param     tpCtx Pointer to the transport layer context.
+** \param     point The trace point (TBX_MB_TRACE_POINT_xxx).
+**
+****************************************************************************************/
+void TbxMbTraceMark(tTbxMbTpCtx volatile * tpCtx,
+                    uint8_t                point)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((tpCtx != NULL) && (point < TBX_MB_TRACE_NUM_POINT));
+
+  /* Only continue with valid parameters. */
+  if ((tpCtx != NULL) && (point < TBX_MB_TRACE_NUM_POINT))
+  {
+    /* Get the current time in 50 us timer ticks. */
+    uint16_t currentTime = TbxMbPortTimerCount();
+    TbxCriticalSectionEnter();
+    tTbxMbTraceInfo volatile * trace = &tpCtx->trace;
+    /* The first byte of a packet starts a new trace. */
+    if (point == TBX_MB_TRACE_POINT_RX_START)
+    {
+      trace->valid = 0U;
+    }
+    /* The end of a packet invalidates the timestamps of the packet processing that
+     * followed the previous one. These are stale in case it wasn't responded to.
+     */
+    else if (point == TBX_MB_TRACE_POINT_RX_END)
+    {
+      trace->valid &= (uint8_t)(1U << TBX_MB_TRACE_POINT_RX_START);
+    }
+    else
+    {
+      /* Nothing to invalidate at the other trace points. */
+    }
+    /* Store the timestamp of the trace point. */
+    trace->stamp[point] = currentTime;
+    trace->valid |= (uint8_t)(1U << point);
+    /* Update the aggregated latency of each segment that ends at this trace point and
+     * of which the start was timestamped.
+     */
+    for (uint8_t seg = 0U; seg < (uint8_t)TBX_MB_TRACE_NUM_SEG; seg++)
+    {
+      uint8_t startPoint = tbxMbTraceSegStart[seg];
+      if ((tbxMbTraceSegEnd[seg] == point) &&
+          ((trace->valid & (uint8_t)(1U << startPoint)) != 0U))
+      {
+        /* Only trace the server turnaround if the received packet was dispatched. */
+        if ((seg != (uint8_t)TBX_MB_TRACE_SEG_TURNAROUND) ||
+            ((trace->valid & (uint8_t)(1U << TBX_MB_TRACE_POINT_DISPATCH)) != 0U))
+        {
+          /* Note that this calculation works, even if the timer counter overflowed. */
+          uint16_t ticks = currentTime - trace->stamp[startPoint];
+          TbxMbTraceUpdate(&trace->seg[seg], ticks);
+          /* Additional processing for the server turnaround. */
+          if (seg == (uint8_t)TBX_MB_TRACE_SEG_TURNAROUND)
+          {
+            /* Update the function code specific turnaround latency. Exception responses
+             * count towards the function code of the request.
+             */
+            uint8_t code = tpCtx->txPacket->pdu.code & 0x7FU;
+            uint8_t codeIdx = 0U;
+            while ((codeIdx < trace->codeCount) && (trace->code[codeIdx].code != code))
+            {
+              codeIdx++;
+            }
+            /* Start tracing the function code, if not yet traced and still possible. */
+            if ((codeIdx == trace->codeCount) && (codeIdx < TBX_MB_TRACE_CODE_MAX))
+            {
+              trace->code[codeIdx].code = code;
+              trace->code[codeIdx].data.count = 0U;
+              trace->code[codeIdx].data.sumTicks = 0U;
+              trace->codeCount++;
+            }
+            if (codeIdx < trace->codeCount)
+            {
+              TbxMbTraceUpdate(&trace->code[codeIdx].data, ticks);
+            }
+            /* Update the histogram. */
+            uint16_t binIdx = ticks / TBX_MB_TRACE_HIST_BIN_TICKS;
+            if (binIdx >= TBX_MB_TRACE_HIST_BINS)
+            {
+              binIdx = TBX_MB_TRACE_HIST_BINS - 1U;
+            }
+            trace->hist[binIdx]++;
+          }
+        }
+      }
+    }
+    /* The completion of a packet transmission ends the trace. */
+    if (point == TBX_MB_TRACE_POINT_TX_DONE)
+    {
+      trace->valid = 0U;
+    }
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxMbTraceMark ***/
+
+
+/************************************************************************************//**
+** \brief     Adds a latency measurement to the aggregated latency. Once the sum of all
+**            latencies would overflow, new measurements are no longer added. Should be
+**            called from a critical section.
+** \param     data Pointer to the aggregated latency.
+** \param     ticks The measured latency in 50 us timer ticks.
+**
+****************************************************************************************/
+static void TbxMbTraceUpdate(tTbxMbTraceData volatile * data,
+                             uint16_t                   ticks)
+{
+  /* Only add the measurement if the sum won't overflow. */
+  if (data->sumTicks <= (0xFFFFFFFFUL - ticks))
+  {
+    /* Update the minimum and maximum latencies. */
+    if ((data->count == 0U) || (ticks < data->minTicks))
+    {
+      data->minTicks = ticks;
+    }
+    if ((data->count == 0U) || (ticks > data->maxTicks))
+    {
+      data->maxTicks = ticks;
+    }
+    /* Update the sum and the number of measurements. */
+    data->sumTicks += ticks;
+    data->count++;
+  }
+} /*** end of TbxMbTraceUpdate ***/
+
+
+/************************************************************************************//**
+** \brief     Converts the aggregated latency to the latency statistics in microseconds.
+** \param     data Pointer to the aggregated latency.
+** \param     stats Pointer to where the statistics are written to.
+**
+****************************************************************************************/
+static void TbxMbTraceConvert(tTbxMbTraceData  const * data,
+                              tTbxMbTraceStats       * stats)
+{
+  stats->count = data->count;
+  stats->minUs = 0U;
+  stats->avgUs = 0U;
+  stats->maxUs = 0U;
+  /* Only calculate the latencies if there are measurements. */
+  if (data->count > 0U)
+  {
+    stats->minUs = (uint32_t)data->minTicks * TBX_MB_TRACE_TICK_US;
+    stats->avgUs = (data->sumTicks / data->count) * TBX_MB_TRACE_TICK_US;
+    stats->maxUs = (uint32_t)data->maxTicks * TBX_MB_TRACE_TICK_US;
+  }
+} /*** end of TbxMbTraceConvert ***/
+#endif
+
+
+/*********************************** end of tbxmb_trace.c ******************************/
@@ -0,0 +1,95 @@
+/************************************************************************************//**
+* \file         tbxmb_trace.h
+* \brief        Modbus packet processing latency tracing header file.
+* \internal
+*----------------------------------------------------------------------------------------
+*                          C O P Y R I G H T
+*----------------------------------------------------------------------------------------
+*   Copyright (c) 2023 by Feaser     www.feaser.com     All rights reserved
+*
+*----------------------------------------------------------------------------------------
+*                            L I C E N S E
+*----------------------------------------------------------------------------------------
+*
+* SPDX-License-Identifier: GPL-3.0-or-later
+*
+* This file is part of MicroTBX-Modbus. MicroTBX-Modbus is free software: you can
+* redistribute it and/or modify it under the terms of the GNU General Public License as
+* published by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* MicroTBX-Modbus is distributed in the hope that it will be useful, but WITHOUT ANY
+* WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+* PARTICULAR PURPOSE. See the GNU General Public License for more details.
+*
+* You have received a copy of the GNU General Public License along with MicroTBX-Modbus.
+* If not, see www.gnu.org/licenses/.
+*
+* \endinternal
+****************************************************************************************/
+#ifndef TBXMB_TRACE_H
+#define TBXMB_TRACE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************************
+* Type definitions
+****************************************************************************************/
+/** \brief Enumerated type with the traced segments of the packet processing. */
+typedef enum
+{
+  /* Reception of a packet, from its first byte until the detection of its end. */
+  TBX_MB_TRACE_SEG_RECEPTION = 0U,
+  /* From the detection of the packet's end until the channel starts processing it. */
+  TBX_MB_TRACE_SEG_DISPATCH,
+  /* Processing of the request by the server channel, including its callbacks. */
+  TBX_MB_TRACE_SEG_PROCESSING,
+  /* From the processing completion until the response transmission starts. */
+  TBX_MB_TRACE_SEG_TX_START,
+  /* Transmission of a packet, until its last byte was transmitted. */
+  TBX_MB_TRACE_SEG_TRANSMISSION,
+  /* Server turnaround, from the detection of the request's end until the response
+   * transmission starts.
+   */
+  TBX_MB_TRACE_SEG_TURNAROUND,
+  /* Extra entry to obtain the number of elements. */
+  TBX_MB_TRACE_NUM_SEG
+} tTbxMbTraceSegment;
+
+
+/** \brief Latency statistics of a traced segment. */
+typedef struct
+{
+  uint32_t             count;                    /**< Number of measurements.          */
+  uint32_t             minUs;                    /**< Minimum latency (us).            */
+  uint32_t             avgUs;                    /**< Average latency (us).            */
+  uint32_t             maxUs;                    /**< Maximum latency (us).            */
+} tTbxMbTraceStats;
+
+
+/****************************************************************************************
+* Function prototypes
+****************************************************************************************/
+uint8_t TbxMbTraceGetStats    (tTbxMbTp             transport,
+                               tTbxMbTraceSegment   segment,
+                               tTbxMbTraceStats   * stats);
+
+uint8_t TbxMbTraceGetCodeStats(tTbxMbTp             transport,
+                               uint8_t              code,
+                               tTbxMbTraceStats   * stats);
+
+uint8_t TbxMbTraceGetHistogram(tTbxMbTp             transport,
+                               uint32_t           * bins,
+                               uint8_t              num);
+
+void    TbxMbTraceReset       (tTbxMbTp             transport);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TBXMB_TRACE_H */
+/*********************************** end of tbxmb_trace.h ******************************/
@@ -36,6 +36,19 @@
 #include "tbxmb_uart_private.h"                  /* MicroTBX-Modbus UART private       */
 
 
+/****************************************************************************************
+* Configuration check
+****************************************************************************************/
+#if ((TBX_MB_UART_TIMER_FREQ < 20000UL) || (TBX_MB_UART_TIMER_FREQ > 2000000UL) || \
+     ((TBX_MB_UART_TIMER_FREQ % 1000UL) != 0UL))
+#error "TBX_MB_UART_TIMER_FREQ must be a multiple of 1000 in the range 20000..2000000"
+#endif
+
+#if ((TBX_MB_UART_CUSTOM_BAUDRATE > 0UL) && (TBX_MB_UART_CUSTOM_BAUDRATE < 1200UL))
+#error "TBX_MB_UART_CUSTOM_BAUDRATE must be 0 or at least 1200"
+#endif
+
+
 /****************************************************************************************
 * Type definitions
 ****************************************************************************************/
@@ -44,9 +57,32 @@ typedef struct
 {
   tTbxMbUartTransmitComplete transmitCompleteFcn;
   tTbxMbUartDataReceived     dataReceivedFcn;
+  tTbxMbUartReceiveProgress  receiveProgressFcn;
+  tTbxMbUartTimerExpired     timerExpiredFcn;
 } tTbxMbUartInfo;
 
 
+/****************************************************************************************
+* Local constant declarations
+****************************************************************************************/
+/** \brief Communication speed in bits per second for each supported baudrate. */
+static const uint32_t uartBaudrateBps[TBX_MB_UART_NUM_BAUDRATE] =
+{
+  1200UL,                                        /* TBX_MB_UART_1200BPS                */
+  2400UL,                                        /* TBX_MB_UART_2400BPS                */
+  4800UL,                                        /* TBX_MB_UART_4800BPS                */
+  9600UL,                                        /* TBX_MB_UART_9600BPS                */
+  19200UL,                                       /* TBX_MB_UART_19200BPS               */
+  38400UL,                                       /* TBX_MB_UART_38400BPS               */
+  57600UL,                                       /* TBX_MB_UART_57600BPS               */
+  115200UL,                                      /* TBX_MB_UART_115200BPS              */
+  230400UL,                                      /* TBX_MB_UART_230400BPS              */
+  460800UL,                                      /* TBX_MB_UART_460800BPS              */
+  921600UL,                                      /* TBX_MB_UART_921600BPS              */
+  TBX_MB_UART_CUSTOM_BAUDRATE                    /* TBX_MB_UART_CUSTOMBPS              */
+};
+
+
 /****************************************************************************************
 * Local data declarations
 ****************************************************************************************/
@@ -67,6 +103,10 @@ static volatile tTbxMbUartInfo uartInfo[TBX_MB_UART_NUM_PORT];
 **            function or NULL if not used.
 ** \param     dataReceivedFcn Transport layer specific new data received callback
 **            function or NULL if not used.
+** \param     receiveProgressFcn Transport layer specific reception progress callback
+**            function or NULL if not used.
+** \param     timerExpiredFcn Transport layer specific timer expired callback function
+**            or NULL if not used.
 **
 ****************************************************************************************/
 void TbxMbUartInit(tTbxMbUartPort             port, 
@@ -75,7 +115,9 @@ void TbxMbUartInit(tTbxMbUartPort             port,
                    tTbxMbUartStopbits         stopbits,
                    tTbxMbUartParity           parity,
                    tTbxMbUartTransmitComplete transmitCompleteFcn,
-                   tTbxMbUartDataReceived     dataReceivedFcn)
+                   tTbxMbUartDataReceived     dataReceivedFcn,
+                   tTbxMbUartReceiveProgress  receiveProgressFcn,
+                   tTbxMbUartTimerExpired     timerExpiredFcn)
 {
   /* Verify parameters. */
   TBX_ASSERT((port < TBX_MB_UART_NUM_PORT) && 
@@ -94,6 +136,8 @@ void TbxMbUartInit(tTbxMbUartPort             port,
     /* Store the specified callback functions. */
     uartInfo[port].transmitCompleteFcn = transmitCompleteFcn;
     uartInfo[port].dataReceivedFcn = dataReceivedFcn;
+    uartInfo[port].receiveProgressFcn = receiveProgressFcn;
+    uartInfo[port].timerExpiredFcn = timerExpiredFcn;
     /* Request the port module to perform the low-level UART initialization. */
     TbxMbPortUartInit(port, baudrate, databits, stopbits, parity);
   }
@@ -137,6 +181,108 @@ uint8_t TbxMbUartTransmit(tTbxMbUartPort         port,
 } /*** end of TbxMbUartTransmit ***/
 
 
+#if (TBX_MB_UART_RX_DMA_ENABLE > 0U)
+/************************************************************************************//**
+** \brief     Starts the reception of up to len bytes directly into the data array on the
+**            specified serial port. Restarts it at the start of the data array, in case
+**            a reception was already in progress. The port reports the number of bytes
+**            received so far, with TbxMbUartReceiveProgress().
+** \attention The port has write access to the data array, until the reception is
+**            restarted or stopped with TbxMbUartReceiveStop().
+** \param     port The serial port to start the data reception on.
+** \param     data Byte array for storing the received data.
+** \param     len Maximum number of bytes to receive.
+**
+****************************************************************************************/
+void TbxMbUartReceiveStart(tTbxMbUartPort   port,
+                           uint8_t        * data,
+                           uint16_t         len)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((port < TBX_MB_UART_NUM_PORT) && 
+             (data != NULL) &&
+             (len > 0U));
+
+  /* Only continue with valid parameters. */
+  if ((port < TBX_MB_UART_NUM_PORT) && 
+      (data != NULL) &&
+      (len > 0U))
+  {
+    /* Request the port module to start the low-level UART data reception. */
+    TbxMbPortUartReceiveStart(port, data, len);
+  }
+} /*** end of TbxMbUartReceiveStart ***/
+
+
+/************************************************************************************//**
+** \brief     Stops the reception that was started with TbxMbUartReceiveStart(). Bytes
+**            that are received afterwards, are dropped by the port.
+** \param     port The serial port to stop the data reception on.
+**
+****************************************************************************************/
+void TbxMbUartReceiveStop(tTbxMbUartPort port)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(port < TBX_MB_UART_NUM_PORT);
+
+  /* Only continue with valid parameters. */
+  if (port < TBX_MB_UART_NUM_PORT)
+  {
+    /* Request the port module to stop the low-level UART data reception. */
+    TbxMbPortUartReceiveStop(port);
+  }
+} /*** end of TbxMbUartReceiveStop ***/
+#endif
+
+
+#if (TBX_MB_UART_TIMER_ENABLE > 0U)
+/************************************************************************************//**
+** \brief     Starts the one-shot timer of the specified serial port. Restarts it, in case
+**            it was already running. The port signals its expiration with
+**            TbxMbUartTimerExpired().
+** \param     port The serial port to start the timer for.
+** \param     ticks Timer expiration time in ticks of the TBX_MB_UART_TIMER_FREQ
+**            frequency. By default, a tick is 50 microseconds.
+**
+****************************************************************************************/
+void TbxMbUartTimerStart(tTbxMbUartPort port,
+                         uint16_t       ticks)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((port < TBX_MB_UART_NUM_PORT) && 
+             (ticks > 0U));
+
+  /* Only continue with valid parameters. */
+  if ((port < TBX_MB_UART_NUM_PORT) && 
+      (ticks > 0U))
+  {
+    /* Request the port module to start the low-level one-shot timer. */
+    TbxMbPortUartTimerStart(port, ticks);
+  }
+} /*** end of TbxMbUartTimerStart ***/
+
+
+/************************************************************************************//**
+** \brief     Stops the one-shot timer of the specified serial port, such that its
+**            expiration is no longer signalled.
+** \param     port The serial port to stop the timer for.
+**
+****************************************************************************************/
+void TbxMbUartTimerStop(tTbxMbUartPort port)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(port < TBX_MB_UART_NUM_PORT);
+
+  /* Only continue with valid parameters. */
+  if (port < TBX_MB_UART_NUM_PORT)
+  {
+    /* Request the port module to stop the low-level one-shot timer. */
+    TbxMbPortUartTimerStop(port);
+  }
+} /*** end of TbxMbUartTimerStop ***/
+#endif
+
+
 /************************************************************************************//**
 ** \brief     Event function to signal to this module that the entire transfer, initiated
 **            by TbxMbUartTransmit, completed.
@@ -194,4 +340,85 @@ void TbxMbUartDataReceived(tTbxMbUartPort         port,
 } /*** end of TbxMbUartDataReceived ***/
 
 
+/************************************************************************************//**
+** \brief     Event function to signal the progress of the data reception, which was
+**            started with TbxMbPortUartReceiveStart(), to this module. Only used when
+**            TBX_MB_UART_RX_DMA_ENABLE is configured to a value > 0.
+** \attention This function should be called by the hardware specific UART port at
+**            interrupt level. Typically upon detection of an idle line or a receiver
+**            timeout, once the received bytes are actually stored in the data array.
+** \param     port The serial port that the data was received on.
+** \param     len Total number of bytes stored in the data array, since the reception
+**            was started.
+**
+****************************************************************************************/
+void TbxMbUartReceiveProgress(tTbxMbUartPort port, 
+                              uint16_t       len)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(port < TBX_MB_UART_NUM_PORT);
+
+  /* Only continue with valid parameters. */
+  if (port < TBX_MB_UART_NUM_PORT)
+  {
+    /* Pass the event on to the transport layer for further handling. */
+    if (uartInfo[port].receiveProgressFcn != NULL)
+    {
+      uartInfo[port].receiveProgressFcn(port, len);
+    }
+  }
+} /*** end of TbxMbUartReceiveProgress ***/
+
+
+/************************************************************************************//**
+** \brief     Event function to signal the expiration of the one-shot timer, which was
+**            started with TbxMbPortUartTimerStart(), to this module. Only used when
+**            TBX_MB_UART_TIMER_ENABLE is configured to a value > 0.
+** \attention This function should be called by the hardware specific UART port at
+**            interrupt level. Typically from the timer or receiver timeout interrupt.
+** \param     port The serial port that the timer expired for.
+**
+****************************************************************************************/
+void TbxMbUartTimerExpired(tTbxMbUartPort port)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(port < TBX_MB_UART_NUM_PORT);
+
+  /* Only continue with valid parameters. */
+  if (port < TBX_MB_UART_NUM_PORT)
+  {
+    /* Pass the event on to the transport layer for further handling. */
+    if (uartInfo[port].timerExpiredFcn != NULL)
+    {
+      uartInfo[port].timerExpiredFcn(port);
+    }
+  }
+} /*** end of TbxMbUartTimerExpired ***/
+
+
+/************************************************************************************//**
+** \brief     Obtains the communication speed in bits per second of the specified
+**            baudrate. Meant for the port, which can pass it on to the baudrate
+**            configuration of its UART peripheral.
+** \param     baudrate The communication speed.
+** \return    Communication speed in bits per second or 0 if not supported. 
+**
+****************************************************************************************/
+uint32_t TbxMbUartBaudrateBps(tTbxMbUartBaudrate baudrate)
+{
+  uint32_t result = 0U;
+
+  /* Verify parameters. */
+  TBX_ASSERT(baudrate < TBX_MB_UART_NUM_BAUDRATE);
+
+  /* Only continue with valid parameters. */
+  if (baudrate < TBX_MB_UART_NUM_BAUDRATE)
+  {
+    result = uartBaudrateBps[baudrate];
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbUartBaudrateBps ***/
+
+
 /*********************************** end of tbxmb_uart.c *******************************/
@@ -80,6 +80,14 @@ typedef enum
   TBX_MB_UART_57600BPS,
   /* Communication speed of 115200 bits per second. */
   TBX_MB_UART_115200BPS,
+  /* Communication speed of 230400 bits per second. */
+  TBX_MB_UART_230400BPS,
+  /* Communication speed of 460800 bits per second. */
+  TBX_MB_UART_460800BPS,
+  /* Communication speed of 921600 bits per second. */
+  TBX_MB_UART_921600BPS,
+  /* Communication speed configured with TBX_MB_UART_CUSTOM_BAUDRATE. */
+  TBX_MB_UART_CUSTOMBPS,
   /* Extra entry to obtain the number of elements. */
   TBX_MB_UART_NUM_BAUDRATE
 } tTbxMbUartBaudrate;
@@ -132,6 +140,13 @@ void TbxMbUartDataReceived    (tTbxMbUartPort         port,
                                uint8_t        const * data, 
                                uint8_t                len);
 
+void TbxMbUartReceiveProgress (tTbxMbUartPort         port, 
+                               uint16_t               len);
+
+void TbxMbUartTimerExpired    (tTbxMbUartPort         port);
+
+uint32_t TbxMbUartBaudrateBps (tTbxMbUartBaudrate     baudrate);
+
 
 #ifdef __cplusplus
 }
@@ -34,6 +34,62 @@
 extern "C" {
 #endif
 
+/****************************************************************************************
+* Configuration macros
+****************************************************************************************/
+#ifndef TBX_MB_UART_RX_DMA_ENABLE
+/** \brief By default, the port calls TbxMbUartDataReceived() for each received byte,
+ *         which copies it into the reception packet of the transport layer. When this
+ *         configuration macro is > 0, the port instead receives the data directly into
+ *         the reception packet, typically with the help of a DMA peripheral. It then
+ *         only calls TbxMbUartReceiveProgress() upon detection of an idle line or a
+ *         receiver timeout, which removes the per-byte interrupts and copying. Requires
+ *         port functions TbxMbPortUartReceiveStart() and TbxMbPortUartReceiveStop().
+ *         To override this default configuration, you can add a macro with the same
+ *         name, but with a value of 1 (enable), to "tbx_conf.h".
+ */
+#define TBX_MB_UART_RX_DMA_ENABLE          (0U)
+#endif
+
+#ifndef TBX_MB_UART_TIMER_ENABLE
+/** \brief By default, the transport layer detects the idle time on the serial line by
+ *         comparing the free running counter value of TbxMbPortTimerCount(), each time
+ *         the event task runs. The event task then cannot block for longer than 1 ms.
+ *         When this configuration macro is > 0, the transport layer instead starts a
+ *         one-shot timer per serial port, with TbxMbPortUartTimerStart(). The port
+ *         calls TbxMbUartTimerExpired() once it expires, which allows the event task to
+ *         block until a real event occurs. The timer can be a hardware timer or the
+ *         receiver timeout (RTO) feature of the UART. To override this default
+ *         configuration, you can add a macro with the same name, but with a value of 1
+ *         (enable), to "tbx_conf.h".
+ */
+#define TBX_MB_UART_TIMER_ENABLE           (0U)
+#endif
+
+#ifndef TBX_MB_UART_TIMER_FREQ
+/** \brief Frequency in Hz of the one-shot timer that TbxMbPortUartTimerStart() starts.
+ *         By default 20 kHz, so one tick is 50 us, the same as TbxMbPortTimerCount().
+ *         At baudrates above 115200 bits/sec, the 1.5 and 3.5 character times get
+ *         shorter than one such tick. Configure a higher frequency, such as 1 MHz, if
+ *         the port can run the one-shot timer with a finer resolution. It must be a
+ *         multiple of 1000, in the range 20000..2000000. Only used when 
+ *         TBX_MB_UART_TIMER_ENABLE is > 0. To override this default configuration, you
+ *         can add a macro with the same name, but with a different value, to
+ *         "tbx_conf.h".
+ */
+#define TBX_MB_UART_TIMER_FREQ             (20000UL)
+#endif
+
+#ifndef TBX_MB_UART_CUSTOM_BAUDRATE
+/** \brief Communication speed in bits per second for TBX_MB_UART_CUSTOMBPS. Meant for
+ *         baudrates that are not part of tTbxMbUartBaudrate. A value of 0 means that
+ *         TBX_MB_UART_CUSTOMBPS is not supported. Otherwise, it must be at least 1200.
+ *         To override this default configuration, you can add a macro with the same
+ *         name, but with a different value, to "tbx_conf.h".
+ */
+#define TBX_MB_UART_CUSTOM_BAUDRATE        (0UL)
+#endif
+
 
 /****************************************************************************************
 * Type definitions
@@ -50,6 +106,19 @@ typedef void (* tTbxMbUartDataReceived)    (tTbxMbUartPort         port,
                                             uint8_t                len);
 
 
+/** \brief Transport layer callback function to signal the progress of a reception,
+ *         that was started with TbxMbUartReceiveStart().
+ */
+typedef void (* tTbxMbUartReceiveProgress) (tTbxMbUartPort         port, 
+                                            uint16_t               len);
+
+
+/** \brief Transport layer callback function to signal the expiration of the timer,
+ *         that was started with TbxMbUartTimerStart().
+ */
+typedef void (* tTbxMbUartTimerExpired)    (tTbxMbUartPort         port);
+
+
 /****************************************************************************************
 * Function prototypes
 ****************************************************************************************/
@@ -64,12 +133,29 @@ void    TbxMbUartInit    (tTbxMbUartPort                     port,
                           tTbxMbUartStopbits                 stopbits,
                           tTbxMbUartParity                   parity,
                           tTbxMbUartTransmitComplete         transmitCompleteFcn,
-                          tTbxMbUartDataReceived             dataReceivedFcn);
+                          tTbxMbUartDataReceived             dataReceivedFcn,
+                          tTbxMbUartReceiveProgress          receiveProgressFcn,
+                          tTbxMbUartTimerExpired             timerExpiredFcn);
 
 uint8_t TbxMbUartTransmit(tTbxMbUartPort                     port, 
                           uint8_t                    const * data, 
                           uint16_t                           len);
 
+#if (TBX_MB_UART_RX_DMA_ENABLE > 0U)
+void    TbxMbUartReceiveStart(tTbxMbUartPort                 port,
+                              uint8_t                      * data,
+                              uint16_t                       len);
+
+void    TbxMbUartReceiveStop (tTbxMbUartPort                 port);
+#endif
+
+#if (TBX_MB_UART_TIMER_ENABLE > 0U)
+void    TbxMbUartTimerStart  (tTbxMbUartPort                 port,
+                              uint16_t                       ticks);
+
+void    TbxMbUartTimerStop   (tTbxMbUartPort                 port);
+#endif
+
 
 #ifdef __cplusplus
 }
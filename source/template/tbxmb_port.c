@@ -46,6 +46,8 @@
 ****************************************************************************************/
 void TbxMbPortUartTxInterrupt(tTbxMbUartPort port);
 void TbxMbPortUartRxInterrupt(tTbxMbUartPort port);
+void TbxMbPortUartIdleInterrupt(tTbxMbUartPort port);
+void TbxMbPortUartTimerInterrupt(tTbxMbUartPort port);
 
 
 /****************************************************************************************
@@ -61,6 +63,11 @@ static volatile struct
   uint16_t         totalLen;             /**< Total number of bytes to transmit.       */
 } transmitInfo[TBX_MB_UART_NUM_PORT];
 
+/** \brief Variable that holds the size of the DMA reception buffer for each serial port.
+ *         Only used when TBX_MB_UART_RX_DMA_ENABLE is configured to a value > 0.
+ */
+static volatile uint16_t receiveLen[TBX_MB_UART_NUM_PORT];
+
 
 /************************************************************************************//**
 ** \brief     Initializes the UART channel.
@@ -92,6 +99,7 @@ void TbxMbPortUartInit(tTbxMbUartPort     port,
    *   - Configure the UART Rx and Tx GPIO pins for UART communication.
    *   - Switch the RS485 transceiver to reception mode (DE/NRE pins), if used.
    *   - Configure the baudrate, number of databits, number of stopbits, and parity mode.
+   *     TbxMbUartBaudrateBps() converts the baudrate to bits per second.
    *   - Enable the UART transmitter and receiver.
    *   - Enable the receive data register full (RXNE) interrupt.
    */
@@ -142,6 +150,115 @@ uint8_t TbxMbPortUartTransmit(tTbxMbUartPort         port,
 } /*** end of TbxMbPortUartTransmit ***/
 
 
+/************************************************************************************//**
+** \brief     Starts the reception of up to len bytes into the data array on the
+**            specified serial port, typically with the help of a DMA peripheral. Only
+**            called when TBX_MB_UART_RX_DMA_ENABLE is configured to a value > 0 in
+**            "tbx_conf.h". Any reception that is still in progress should be aborted,
+**            such that the reception restarts at the beginning of the data array.
+** \attention This function has mutual exclusive access to the bytes in the data[] array,
+**            until the reception is restarted or TbxMbPortUartReceiveStop() is called.
+**            Upon detection of an idle line or a receiver timeout, call
+**            TbxMbUartReceiveProgress() with the total number of bytes received so far.
+** \param     port The serial port to start the data reception on.
+** \param     data Byte array to store the received data in.
+** \param     len Maximum number of bytes to receive.
+**
+****************************************************************************************/
+void TbxMbPortUartReceiveStart(tTbxMbUartPort   port,
+                               uint8_t        * data,
+                               uint16_t         len)
+{
+  TBX_UNUSED_ARG(data);
+
+  /* Store the size of the reception buffer. It's needed to determine the number of
+   * received bytes from the remaining transfer count of the DMA channel.
+   */
+  receiveLen[port] = len;
+
+  /* TODO ##Port 
+   * 
+   * - Disable the DMA channel of the UART reception, if still enabled.
+   * - Configure the DMA channel for a peripheral to memory transfer of "len" bytes from
+   *   the UART reception data register to the "data" array. No circular mode.
+   * - Enable the DMA channel and the UART reception DMA request.
+   * - Enable the idle line detection (IDLE) interrupt or, if supported by the UART
+   *   peripheral, the receiver timeout (RTO) interrupt. A receiver timeout of about 1.5
+   *   character times is preferred, because it lowers the latency.
+   */
+
+} /*** end of TbxMbPortUartReceiveStart ***/
+
+
+/************************************************************************************//**
+** \brief     Stops the reception that was started with TbxMbPortUartReceiveStart(), such
+**            that the data array is no longer written to. Only called when 
+**            TBX_MB_UART_RX_DMA_ENABLE is configured to a value > 0 in "tbx_conf.h".
+** \param     port The serial port to stop the data reception on.
+**
+****************************************************************************************/
+void TbxMbPortUartReceiveStop(tTbxMbUartPort port)
+{
+  TBX_UNUSED_ARG(port);
+
+  /* TODO ##Port 
+   * 
+   * - Disable the UART reception DMA request and the DMA channel.
+   * - Disable the idle line detection (IDLE) or receiver timeout (RTO) interrupt.
+   */
+
+} /*** end of TbxMbPortUartReceiveStop ***/
+
+
+/************************************************************************************//**
+** \brief     Starts the one-shot timer of the specified serial port, such that it
+**            expires after the specified number of ticks. Only called when
+**            TBX_MB_UART_TIMER_ENABLE is configured to a value > 0 in "tbx_conf.h".
+**            In case the timer is already running, it should be restarted. Note that
+**            this function is typically called at UART interrupt level.
+** \param     port The serial port to start the timer for.
+** \param     ticks Timer expiration time in ticks of the TBX_MB_UART_TIMER_FREQ
+**            frequency. By default, a tick is 50 microseconds.
+**
+****************************************************************************************/
+void TbxMbPortUartTimerStart(tTbxMbUartPort port,
+                             uint16_t       ticks)
+{
+  TBX_UNUSED_ARG(port);
+  TBX_UNUSED_ARG(ticks);
+
+  /* TODO ##Port 
+   * 
+   * - Stop the hardware timer that is dedicated to this serial port.
+   * - Reset its counter and configure it for a one-shot expiration after "ticks" times
+   *   the period of TBX_MB_UART_TIMER_FREQ (50 microseconds by default).
+   * - Clear its pending update interrupt flag and enable its update interrupt.
+   * - Start the hardware timer.
+   */
+
+} /*** end of TbxMbPortUartTimerStart ***/
+
+
+/************************************************************************************//**
+** \brief     Stops the one-shot timer of the specified serial port, such that its
+**            expiration is no longer signalled. Only called when 
+**            TBX_MB_UART_TIMER_ENABLE is configured to a value > 0 in "tbx_conf.h".
+** \param     port The serial port to stop the timer for.
+**
+****************************************************************************************/
+void TbxMbPortUartTimerStop(tTbxMbUartPort port)
+{
+  TBX_UNUSED_ARG(port);
+
+  /* TODO ##Port 
+   * 
+   * - Stop the hardware timer that is dedicated to this serial port.
+   * - Disable its update interrupt and clear its pending update interrupt flag.
+   */
+
+} /*** end of TbxMbPortUartTimerStop ***/
+
+
 /************************************************************************************//**
 ** \brief     Obtains the free running counter value of a timer that runs at 20 kHz.
 ** \details   The Modbus RTU communication makes use of 1.5 (T1_5) and 3.5 (T3_5)
@@ -189,6 +306,235 @@ uint16_t TbxMbPortTimerCount(void)
 } /*** end of TbxMbPortTimerCount ***/
 
 
+/************************************************************************************//**
+** \brief     Updates the Modbus RTU CRC16 checksum with the bytes in the specified data
+**            array, using the CRC hardware peripheral of the microcontroller. Only
+**            called when TBX_MB_RTU_CRC_METHOD is configured to
+**            TBX_MB_RTU_CRC_METHOD_PORT in "tbx_conf.h".
+**
+**            The CRC16 uses polynomial 0x8005, in its bit reflected form (0xA001). Both
+**            the input bytes and output value are reflected and there is no final XOR.
+**            The stack passes 0xFFFF as the initial value, when starting the checksum
+**            calculation of a new packet. Note that this function can be called from
+**            multiple channels. If the peripheral is also shared with other parts of your
+**            application, make sure to protect its access.
+** \param     crc Current CRC16 checksum value.
+** \param     data Pointer to the byte array with data.
+** \param     len Number of data bytes to include in the CRC16 calculation.
+** \return    The updated CRC16 checksum value.
+**
+****************************************************************************************/
+uint16_t TbxMbPortCrcUpdate(uint16_t         crc,
+                            uint8_t  const * data,
+                            uint16_t         len)
+{
+  uint16_t result = crc;
+
+  /* TODO ##Port 
+   * 
+   * Configure the CRC peripheral for a 16-bit polynomial of 0x8005 with reflected input
+   * and output, load it with the "crc" value and feed it the "len" bytes from "data".
+   * Afterwards read out the result from the peripheral.
+   * 
+   * The bitwise software implementation below serves as a reference for verifying the
+   * configuration of your CRC peripheral.
+   */
+  for (uint16_t byteIdx = 0U; byteIdx < len; byteIdx++)
+  {
+    result ^= data[byteIdx];
+    for (uint8_t bitIdx = 0U; bitIdx < 8U; bitIdx++)
+    {
+      if ((result & 0x0001U) != 0U)
+      {
+        result = (result >> 1U) ^ 0xA001U;
+      }
+      else
+      {
+        result >>= 1U;
+      }
+    }
+  }
+
+  return result;
+} /*** end of TbxMbPortCrcUpdate ***/
+
+
+/************************************************************************************//**
+** \brief     Opens a TCP/IP socket that listens for connection requests from Modbus TCP
+**            clients on the specified TCP port. Only called when using the Modbus TCP
+**            transport layer as a server.
+** \param     port The TCP port number to listen on. Typically 502 for Modbus TCP.
+** \return    Handle to the listen socket if successful, NULL otherwise.
+**
+****************************************************************************************/
+tTbxMbTcpSock TbxMbPortTcpServerOpen(uint16_t port)
+{
+  tTbxMbTcpSock result = NULL;
+
+  TBX_UNUSED_ARG(port);
+
+  /* TODO ##Port 
+   * 
+   * Perform the following steps to open the listen socket, for example with the lwIP
+   * socket API:
+   *   - Create a TCP/IP stream socket.
+   *   - Bind it to the TCP port on any local IP address.
+   *   - Configure it for non-blocking operation (O_NONBLOCK).
+   *   - Start listening for connection requests.
+   *   - Store the socket in result, for example by casting its descriptor or by
+   *     pointing to a static variable that holds its descriptor.
+   */
+
+  return result;
+} /*** end of TbxMbPortTcpServerOpen ***/
+
+
+/************************************************************************************//**
+** \brief     Accepts a pending connection request on the listen socket. This function
+**            should not block. Only called when using the Modbus TCP transport layer as
+**            a server.
+** \param     serverSock Handle to the listen socket, as obtained with
+**            TbxMbPortTcpServerOpen().
+** \return    Handle to the socket of the new connection if one was accepted, NULL if no
+**            connection request is pending.
+**
+****************************************************************************************/
+tTbxMbTcpSock TbxMbPortTcpServerAccept(tTbxMbTcpSock serverSock)
+{
+  tTbxMbTcpSock result = NULL;
+
+  TBX_UNUSED_ARG(serverSock);
+
+  /* TODO ##Port 
+   * 
+   * - Accept a pending connection request on the listen socket. Return NULL without 
+   *   waiting, if there is none.
+   * - Configure the new socket for non-blocking operation (O_NONBLOCK).
+   * - Optionally enable TCP keep-alive and disable the Nagle algorithm (TCP_NODELAY),
+   *   which lowers the response latency.
+   * - Store the new socket in result.
+   */
+
+  return result;
+} /*** end of TbxMbPortTcpServerAccept ***/
+
+
+/************************************************************************************//**
+** \brief     Starts connecting to a Modbus TCP server. This function should not block.
+**            Only called when using the Modbus TCP transport layer as a client.
+** \param     ipAddress The IP address of the server, as specified when calling
+**            TbxMbTcpCreate(). For example "192.168.0.10".
+** \param     port The TCP port number of the server. Typically 502 for Modbus TCP.
+** \return    Handle to the socket of the connection if successful, NULL otherwise.
+**
+****************************************************************************************/
+tTbxMbTcpSock TbxMbPortTcpConnect(char     const * ipAddress,
+                                  uint16_t         port)
+{
+  tTbxMbTcpSock result = NULL;
+
+  TBX_UNUSED_ARG(ipAddress);
+  TBX_UNUSED_ARG(port);
+
+  /* TODO ##Port 
+   * 
+   * - Create a TCP/IP stream socket.
+   * - Configure it for non-blocking operation (O_NONBLOCK).
+   * - Start connecting to the server. Do not wait for the connection to be established.
+   * - Optionally disable the Nagle algorithm (TCP_NODELAY), which lowers the latency.
+   * - Store the socket in result.
+   */
+
+  return result;
+} /*** end of TbxMbPortTcpConnect ***/
+
+
+/************************************************************************************//**
+** \brief     Transmits len bytes from the data array on the specified socket.
+** \attention The data[] array is only accessible until this function returns. The 
+**            data bytes should therefore be copied to the TCP/IP stack's send buffer
+**            or be transmitted, before returning. This function should not wait for
+**            the other side to acknowledge the data.
+** \param     sock Handle to the socket of the connection.
+** \param     data Byte array with data to transmit.
+** \param     len Number of bytes to transmit.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.  
+**
+****************************************************************************************/
+uint8_t TbxMbPortTcpTransmit(tTbxMbTcpSock         sock,
+                             uint8_t       const * data,
+                             uint16_t              len)
+{
+  uint8_t result = TBX_ERROR;
+
+  TBX_UNUSED_ARG(sock);
+  TBX_UNUSED_ARG(data);
+  TBX_UNUSED_ARG(len);
+
+  /* TODO ##Port 
+   * 
+   * - Send the len bytes from the data[] array on the socket.
+   * - Set result to TBX_OK, if all bytes were accepted by the TCP/IP stack.
+   */
+
+  return result;
+} /*** end of TbxMbPortTcpTransmit ***/
+
+
+/************************************************************************************//**
+** \brief     Reads newly received data from the specified socket. This function should
+**            not block.
+** \param     sock Handle to the socket of the connection.
+** \param     data Byte array for storing the received data.
+** \param     len Pointer to the maximum number of bytes to read. Upon return it should
+**            hold the number of bytes that were actually read. Set it to zero if no
+**            data is currently available.
+** \return    TBX_OK if successful, TBX_ERROR if the connection was closed by the other
+**            side or broke.
+**
+****************************************************************************************/
+uint8_t TbxMbPortTcpReceive(tTbxMbTcpSock   sock,
+                            uint8_t       * data,
+                            uint16_t      * len)
+{
+  uint8_t result = TBX_OK;
+
+  TBX_UNUSED_ARG(sock);
+  TBX_UNUSED_ARG(data);
+
+  /* TODO ##Port 
+   * 
+   * - Read at most *len bytes from the socket into the data[] array, without waiting.
+   *   Never read more than *len bytes. The remaining data should stay buffered in the
+   *   TCP/IP stack.
+   * - Store the number of bytes that were read in *len. Set it to 0 if no data is
+   *   available (EWOULDBLOCK).
+   * - Set result to TBX_ERROR if the other side closed the connection (the read returned
+   *   0) or another socket error occurred.
+   */
+  *len = 0U;
+
+  return result;
+} /*** end of TbxMbPortTcpReceive ***/
+
+
+/************************************************************************************//**
+** \brief     Closes the specified socket.
+** \param     sock Handle to the socket to close.
+**
+****************************************************************************************/
+void TbxMbPortTcpClose(tTbxMbTcpSock sock)
+{
+  TBX_UNUSED_ARG(sock);
+
+  /* TODO ##Port 
+   * 
+   * - Close the socket and release its resources.
+   */
+
+} /*** end of TbxMbPortTcpClose ***/
+
+
 /****************************************************************************************
 *            I N T E R R U P T   S E R V I C E   R O U T I N E S
 ****************************************************************************************/
@@ -277,4 +623,55 @@ void TbxMbPortUartRxInterrupt(tTbxMbUartPort port)
 } /*** end of TbxMbPortUartRxInterrupt ***/
 
 
+/************************************************************************************//**
+** \brief     UART idle line detection / receiver timeout interrupt handler. Should be
+**            called from your UART interrupt handler for the specified serial port. Only
+**            needed when TBX_MB_UART_RX_DMA_ENABLE is configured to a value > 0 in 
+**            "tbx_conf.h".
+** \param     port The serial port that generated the interrupt.
+**
+****************************************************************************************/
+void TbxMbPortUartIdleInterrupt(tTbxMbUartPort port)
+{
+  uint16_t remaining = receiveLen[port];
+
+  /* TODO ##Port 
+   * 
+   * - Clear the idle line detection (IDLE) or receiver timeout (RTO) flag.
+   * - Read the remaining transfer count of the UART reception DMA channel and store it
+   *   in remaining.
+   */
+
+  /* Only inform the Modbus UART module if data was actually received. */
+  if (remaining < receiveLen[port])
+  {
+    /* Inform the Modbus UART module about the total number of bytes received so far,
+     * since the reception was started.
+     */
+    TbxMbUartReceiveProgress(port, (uint16_t)(receiveLen[port] - remaining));
+  }
+} /*** end of TbxMbPortUartIdleInterrupt ***/
+
+
+/************************************************************************************//**
+** \brief     One-shot timer expiration interrupt handler. Should be called from the
+**            interrupt handler of the hardware timer that is dedicated to the specified
+**            serial port. Only needed when TBX_MB_UART_TIMER_ENABLE is configured to a
+**            value > 0 in "tbx_conf.h".
+** \param     port The serial port that the expired timer belongs to.
+**
+****************************************************************************************/
+void TbxMbPortUartTimerInterrupt(tTbxMbUartPort port)
+{
+  /* TODO ##Port 
+   * 
+   * - Stop the hardware timer, if it does not automatically stop in one-shot mode.
+   * - Clear its pending update interrupt flag.
+   */
+
+  /* Inform the Modbus UART module about the timer expiration. */
+  TbxMbUartTimerExpired(port);
+} /*** end of TbxMbPortUartTimerInterrupt ***/
+
+
 /*********************************** end of tbxmb_port.c *******************************/